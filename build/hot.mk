@@ -18,7 +18,10 @@ HOT_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Screen/Memory/Canvas.cpp \
 	$(ENGINE_SRC_DIR)/Waypoints/Waypoints.cpp \
+	$(ENGINE_SRC_DIR)/Waypoint/WaypointIndex.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/Airspaces.cpp \
+	$(ENGINE_SRC_DIR)/Airspace/AirspacesSnapshot.cpp \
+	$(ENGINE_SRC_DIR)/Airspace/AirspaceAltitudeIndex.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/MacCready.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlidePolar.cpp \
@@ -4,12 +4,14 @@ AIRSPACE_SOURCES = \
 	$(ENGINE_SRC_DIR)/Util/AircraftStateFilter.cpp \
 	$(AIRSPACE_SRC_DIR)/AirspacesTerrain.cpp \
 	$(AIRSPACE_SRC_DIR)/Airspace.cpp \
+	$(AIRSPACE_SRC_DIR)/AirspaceAltitudeIndex.cpp \
 	$(AIRSPACE_SRC_DIR)/AirspaceAltitude.cpp \
 	$(AIRSPACE_SRC_DIR)/AirspaceAircraftPerformance.cpp \
 	$(AIRSPACE_SRC_DIR)/AbstractAirspace.cpp \
 	$(AIRSPACE_SRC_DIR)/AirspaceCircle.cpp \
 	$(AIRSPACE_SRC_DIR)/AirspacePolygon.cpp \
 	$(AIRSPACE_SRC_DIR)/Airspaces.cpp \
+	$(AIRSPACE_SRC_DIR)/AirspacesSnapshot.cpp \
 	$(AIRSPACE_SRC_DIR)/AirspaceIntersectSort.cpp \
 	$(AIRSPACE_SRC_DIR)/SoonestAirspace.cpp \
 	$(AIRSPACE_SRC_DIR)/Predicate/AirspacePredicate.cpp \
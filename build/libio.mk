@@ -8,6 +8,7 @@ IO_SOURCES = \
 	$(IO_SRC_DIR)/BufferedOutputStream.cxx \
 	$(IO_SRC_DIR)/FileOutputStream.cxx \
 	$(IO_SRC_DIR)/GunzipReader.cxx \
+	$(IO_SRC_DIR)/GzipOutputStream.cxx \
 	$(IO_SRC_DIR)/ZlibError.cxx \
 	$(IO_SRC_DIR)/FileTransaction.cpp \
 	$(IO_SRC_DIR)/FileCache.cpp \
@@ -15,6 +16,7 @@ IO_SOURCES = \
 	$(IO_SRC_DIR)/ZipReader.cpp \
 	$(IO_SRC_DIR)/ConvertLineReader.cpp \
 	$(IO_SRC_DIR)/FileLineReader.cpp \
+	$(IO_SRC_DIR)/GunzipLineReader.cpp \
 	$(IO_SRC_DIR)/KeyValueFileReader.cpp \
 	$(IO_SRC_DIR)/KeyValueFileWriter.cpp \
 	$(IO_SRC_DIR)/ZipLineReader.cpp \
@@ -4,6 +4,8 @@ TERRAIN_SOURCES = \
 	$(SRC)/Terrain/RasterMap.cpp \
 	$(SRC)/Terrain/RasterTile.cpp \
 	$(SRC)/Terrain/RasterTileCache.cpp \
+	$(SRC)/Terrain/RasterTileStore.cpp \
+	$(SRC)/Terrain/Prefetch.cpp \
 	$(SRC)/Terrain/ZzipStream.cpp \
 	$(SRC)/Terrain/Loader.cpp \
 	$(SRC)/Terrain/WorldFile.cpp \
@@ -42,10 +42,12 @@ PYTHON_SOURCES = \
 	$(ENGINE_SRC_DIR)/Airspace/AbstractAirspace.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceAltitude.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/Airspace.cpp \
+	$(ENGINE_SRC_DIR)/Airspace/AirspaceAltitudeIndex.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceIntersectionVisitor.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceIntersectSort.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspacePolygon.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/Airspaces.cpp \
+	$(ENGINE_SRC_DIR)/Airspace/AirspacesSnapshot.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceSorter.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceAircraftPerformance.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/Predicate/AirspacePredicate.cpp \
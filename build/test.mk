@@ -93,14 +93,18 @@ TEST_NAMES = \
 	TestAngle TestARange \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM TestProfile \
+	TestBlackboardGroups \
 	TestAllocatedGrid \
 	TestRadixTree TestGeoBounds TestGeoClip \
-	TestLogger TestGRecord TestDriver TestClimbAvCalc \
+	TestLogger TestGRecord TestDriver TestNMEASentenceTable TestLineSplitter \
+	TestNMEALogWriter \
+	TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
+	TestOLCTriangle TestContestScoreBound \
 	TestMacCready TestOrderedTask TestAATPoint \
 	TestPlanes \
 	TestTaskPoint \
@@ -194,7 +198,7 @@ TEST_AIRSPACE_PARSER_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestAirspaceParser.cpp
 TEST_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
-TEST_AIRSPACE_PARSER_DEPENDS = IO OS AIRSPACE ZZIP GEO MATH UTIL
+TEST_AIRSPACE_PARSER_DEPENDS = IO OS THREAD AIRSPACE ZZIP GEO MATH UTIL
 $(eval $(call link-program,TestAirspaceParser,TEST_AIRSPACE_PARSER))
 
 TEST_DATE_TIME_SOURCES = \
@@ -598,6 +602,12 @@ TEST_VALIDITY_SOURCES = \
 	$(TEST_SRC_DIR)/TestValidity.cpp
 $(eval $(call link-program,TestValidity,TEST_VALIDITY))
 
+TEST_BLACKBOARD_GROUPS_SOURCES = \
+	$(SRC)/Blackboard/BlackboardGroups.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestBlackboardGroups.cpp
+$(eval $(call link-program,TestBlackboardGroups,TEST_BLACKBOARD_GROUPS))
+
 TEST_ALLOCATED_GRID_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestAllocatedGrid.cpp
@@ -613,6 +623,7 @@ $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 TEST_LOGGER_SOURCES = \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
+	$(SRC)/IGC/IGCWriterThread.cpp \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -623,9 +634,10 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/MD5.cpp \
 	$(SRC)/Version.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS THREAD GEO MATH UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
 TEST_GRECORD_SOURCES = \
@@ -675,6 +687,27 @@ TEST_DRIVER_SOURCES = \
 TEST_DRIVER_DEPENDS = DRIVER GEO MATH IO OS THREAD UTIL TIME
 $(eval $(call link-program,TestDriver,TEST_DRIVER))
 
+TEST_NMEA_SENTENCE_TABLE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEASentenceTable.cpp
+$(eval $(call link-program,TestNMEASentenceTable,TEST_NMEA_SENTENCE_TABLE))
+
+TEST_LINE_SPLITTER_SOURCES = \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLineSplitter.cpp
+TEST_LINE_SPLITTER_DEPENDS = UTIL
+$(eval $(call link-program,TestLineSplitter,TEST_LINE_SPLITTER))
+
+TEST_NMEA_LOG_WRITER_SOURCES = \
+	$(SRC)/Logger/NMEALogWriter.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEALogWriter.cpp
+TEST_NMEA_LOG_WRITER_DEPENDS = IO OS THREAD UTIL ZLIB
+$(eval $(call link-program,TestNMEALogWriter,TEST_NMEA_LOG_WRITER))
+
 TEST_WAY_POINT_FILE_SOURCES = \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -731,6 +764,13 @@ DEBUG_PROGRAM_NAMES = \
 	FlightPath \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkTerrainScan \
+	BenchmarkTerrainRender \
+	BenchmarkTrace \
+	BenchmarkOLCTriangle \
+	BenchmarkAirspacePolygon \
+	BenchmarkNMEA \
+	BenchmarkIGCWriter \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -904,6 +944,26 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_TERRAIN_SCAN_SOURCES = \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTerrainScan.cpp
+BENCHMARK_TERRAIN_SCAN_DEPENDS = TERRAIN GEO MATH IO OS ZZIP UTIL
+$(eval $(call link-program,BenchmarkTerrainScan,BENCHMARK_TERRAIN_SCAN))
+
+BENCHMARK_TERRAIN_RENDER_SOURCES = \
+	$(MORE_SCREEN_SOURCES) \
+	$(SRC)/Look/ButtonLook.cpp \
+	$(SRC)/Screen/Ramp.cpp \
+	$(SRC)/Renderer/GeoBitmapRenderer.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/Fonts.cpp \
+	$(TEST_SRC_DIR)/FakeAsset.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTerrainRender.cpp
+BENCHMARK_TERRAIN_RENDER_DEPENDS = TERRAIN FORM SCREEN EVENT RESOURCE ASYNC GEO MATH IO OS ZZIP THREAD UTIL
+$(eval $(call link-program,BenchmarkTerrainRender,BENCHMARK_TERRAIN_RENDER))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1010,7 +1070,7 @@ RUN_SL_TRACKING_SOURCES = \
 	$(SRC)/Tracking/SkyLines/Assemble.cpp \
 	$(TEST_SRC_DIR)/RunSkyLinesTracking.cpp
 RUN_SL_TRACKING_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_SL_TRACKING_DEPENDS = LIBNET OS GEO MATH UTIL TIME
+RUN_SL_TRACKING_DEPENDS = LIBNET OS GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunSkyLinesTracking,RUN_SL_TRACKING))
 
 RUN_LIVETRACK24_SOURCES = \
@@ -1023,7 +1083,7 @@ RUN_LIVETRACK24_SOURCES = \
 	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
 	$(TEST_SRC_DIR)/RunLiveTrack24.cpp
 RUN_LIVETRACK24_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_LIVETRACK24_DEPENDS = LIBNET GEO MATH UTIL TIME
+RUN_LIVETRACK24_DEPENDS = LIBNET GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunLiveTrack24,RUN_LIVETRACK24))
 
 RUN_REPOSITORY_PARSER_SOURCES = \
@@ -1217,7 +1277,7 @@ RUN_AIRSPACE_PARSER_SOURCES = \
 	$(TEST_SRC_DIR)/FakeLanguage.cpp \
 	$(TEST_SRC_DIR)/RunAirspaceParser.cpp
 RUN_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
-RUN_AIRSPACE_PARSER_DEPENDS = IO OS AIRSPACE ZZIP GEO MATH UTIL
+RUN_AIRSPACE_PARSER_DEPENDS = IO OS THREAD AIRSPACE ZZIP GEO MATH UTIL
 $(eval $(call link-program,RunAirspaceParser,RUN_AIRSPACE_PARSER))
 
 ENUMERATE_PORTS_SOURCES = \
@@ -1300,6 +1360,58 @@ RUN_DEVICE_DRIVER_SOURCES = \
 RUN_DEVICE_DRIVER_DEPENDS = DRIVER IO OS THREAD GEO MATH UTIL TIME
 $(eval $(call link-program,RunDeviceDriver,RUN_DEVICE_DRIVER))
 
+BENCHMARK_NMEA_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Device/Port/NullPort.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/Device/Util/NMEAReader.cpp \
+	$(SRC)/Device/Config.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/Generator.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Operation/ProxyOperationEnvironment.cpp \
+	$(SRC)/Operation/NoCancelOperationEnvironment.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeMessage.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNMEA.cpp
+BENCHMARK_NMEA_DEPENDS = DRIVER IO OS THREAD GEO MATH UTIL TIME
+$(eval $(call link-program,BenchmarkNMEA,BENCHMARK_NMEA))
+
+BENCHMARK_IGC_WRITER_SOURCES = \
+	$(SRC)/IGC/IGCFix.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/IGC/IGCWriter.cpp \
+	$(SRC)/IGC/IGCWriterThread.cpp \
+	$(SRC)/IGC/IGCString.cpp \
+	$(SRC)/IGC/Generator.cpp \
+	$(SRC)/Logger/GRecord.cpp \
+	$(SRC)/Logger/LoggerEPE.cpp \
+	$(SRC)/Logger/MD5.cpp \
+	$(SRC)/Version.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkIGCWriter.cpp
+BENCHMARK_IGC_WRITER_DEPENDS = IO OS THREAD GEO MATH UTIL TIME
+$(eval $(call link-program,BenchmarkIGCWriter,BENCHMARK_IGC_WRITER))
+
 RUN_DECLARE_SOURCES = \
 	$(SRC)/Device/Port/ConfiguredPort.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -1538,6 +1650,7 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
+	$(SRC)/IGC/IGCWriterThread.cpp \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Logger/LoggerFRecord.cpp \
@@ -1545,9 +1658,10 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/Logger/LoggerEPE.cpp \
 	$(SRC)/Logger/MD5.cpp \
 	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/RunIGCWriter.cpp
 RUN_IGC_WRITER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_IGC_WRITER_DEPENDS = GEO MATH UTIL TIME
+RUN_IGC_WRITER_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunIGCWriter,RUN_IGC_WRITER))
 
 RUN_FLIGHT_LOGGER_SOURCES = \
@@ -1557,7 +1671,7 @@ RUN_FLIGHT_LOGGER_SOURCES = \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/RunFlightLogger.cpp
 RUN_FLIGHT_LOGGER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_FLIGHT_LOGGER_DEPENDS = GEO MATH UTIL TIME
+RUN_FLIGHT_LOGGER_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunFlightLogger,RUN_FLIGHT_LOGGER))
 
 RUN_FLYING_COMPUTER_SOURCES = \
@@ -1566,7 +1680,7 @@ RUN_FLYING_COMPUTER_SOURCES = \
 	$(SRC)/Formatter/GeoPointFormatter.cpp \
 	$(TEST_SRC_DIR)/RunFlyingComputer.cpp
 RUN_FLYING_COMPUTER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_FLYING_COMPUTER_DEPENDS = GEO MATH UTIL TIME
+RUN_FLYING_COMPUTER_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunFlyingComputer,RUN_FLYING_COMPUTER))
 
 RUN_CIRCLING_WIND_SOURCES = \
@@ -1576,7 +1690,7 @@ RUN_CIRCLING_WIND_SOURCES = \
 	$(SRC)/Computer/Wind/CirclingWind.cpp \
 	$(TEST_SRC_DIR)/RunCirclingWind.cpp
 RUN_CIRCLING_WIND_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_CIRCLING_WIND_DEPENDS = GEO MATH UTIL TIME
+RUN_CIRCLING_WIND_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunCirclingWind,RUN_CIRCLING_WIND))
 
 RUN_WIND_EKF_SOURCES = \
@@ -1587,7 +1701,7 @@ RUN_WIND_EKF_SOURCES = \
 	$(SRC)/Formatter/TimeFormatter.cpp \
 	$(TEST_SRC_DIR)/RunWindEKF.cpp
 RUN_WIND_EKF_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_WIND_EKF_DEPENDS = GEO MATH UTIL TIME
+RUN_WIND_EKF_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunWindEKF,RUN_WIND_EKF))
 
 RUN_WIND_COMPUTER_SOURCES = \
@@ -1603,7 +1717,7 @@ RUN_WIND_COMPUTER_SOURCES = \
 	$(SRC)/Formatter/TimeFormatter.cpp \
 	$(TEST_SRC_DIR)/RunWindComputer.cpp
 RUN_WIND_COMPUTER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_WIND_COMPUTER_DEPENDS = GEO MATH UTIL TIME
+RUN_WIND_COMPUTER_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunWindComputer,RUN_WIND_COMPUTER))
 
 RUN_EXTERNAL_WIND_SOURCES = \
@@ -1611,7 +1725,7 @@ RUN_EXTERNAL_WIND_SOURCES = \
 	$(SRC)/Formatter/TimeFormatter.cpp \
 	$(TEST_SRC_DIR)/RunExternalWind.cpp
 RUN_EXTERNAL_WIND_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_EXTERNAL_WIND_DEPENDS = GEO MATH UTIL TIME
+RUN_EXTERNAL_WIND_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunExternalWind,RUN_EXTERNAL_WIND))
 
 RUN_TASK_SOURCES = \
@@ -1637,7 +1751,7 @@ RUN_TASK_SOURCES = \
 	$(TEST_SRC_DIR)/FakeTerrain.cpp \
 	$(TEST_SRC_DIR)/RunTask.cpp
 RUN_TASK_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_TASK_DEPENDS = TASK WAYPOINT GLIDE GEO MATH UTIL IO TIME
+RUN_TASK_DEPENDS = TASK WAYPOINT GLIDE GEO MATH UTIL IO THREAD TIME ZLIB
 $(eval $(call link-program,RunTask,RUN_TASK))
 
 RUN_TRACE_SOURCES = \
@@ -1650,9 +1764,23 @@ RUN_TRACE_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/RunTrace.cpp
 RUN_TRACE_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_TRACE_DEPENDS = UTIL GEO MATH TIME
+RUN_TRACE_DEPENDS = UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,RunTrace,RUN_TRACE))
 
+BENCHMARK_TRACE_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(ENGINE_SRC_DIR)/GlideSolvers/GlideSettings.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTrace.cpp
+BENCHMARK_TRACE_LDADD = $(DEBUG_REPLAY_LDADD)
+BENCHMARK_TRACE_DEPENDS = UTIL GEO MATH TIME ZLIB
+$(eval $(call link-program,BenchmarkTrace,BENCHMARK_TRACE))
+
+$(eval $(call link-harness-program,BenchmarkAirspacePolygon))
+
 RUN_OLC_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/IGC/IGCParser.cpp \
@@ -1664,9 +1792,47 @@ RUN_OLC_SOURCES = \
 	$(TEST_SRC_DIR)/ContestPrinting.cpp \
 	$(TEST_SRC_DIR)/RunOLCAnalysis.cpp
 RUN_OLC_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_OLC_DEPENDS = CONTEST UTIL GEO MATH TIME
+RUN_OLC_DEPENDS = CONTEST UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,RunOLCAnalysis,RUN_OLC))
 
+TEST_OLC_TRIANGLE_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestOLCTriangle.cpp
+TEST_OLC_TRIANGLE_LDADD = $(DEBUG_REPLAY_LDADD)
+TEST_OLC_TRIANGLE_DEPENDS = CONTEST UTIL GEO MATH TIME ZLIB
+$(eval $(call link-program,TestOLCTriangle,TEST_OLC_TRIANGLE))
+
+TEST_CONTEST_SCORE_BOUND_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestContestScoreBound.cpp
+TEST_CONTEST_SCORE_BOUND_LDADD = $(DEBUG_REPLAY_LDADD)
+TEST_CONTEST_SCORE_BOUND_DEPENDS = CONTEST UTIL GEO MATH TIME ZLIB
+$(eval $(call link-program,TestContestScoreBound,TEST_CONTEST_SCORE_BOUND))
+
+BENCHMARK_OLC_TRIANGLE_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkOLCTriangle.cpp
+BENCHMARK_OLC_TRIANGLE_LDADD = $(DEBUG_REPLAY_LDADD)
+BENCHMARK_OLC_TRIANGLE_DEPENDS = CONTEST UTIL GEO MATH TIME ZLIB
+$(eval $(call link-program,BenchmarkOLCTriangle,BENCHMARK_OLC_TRIANGLE))
+
 RUN_WAVE_COMPUTER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/WaveComputer.cpp \
@@ -1676,7 +1842,7 @@ RUN_WAVE_COMPUTER_SOURCES = \
 	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
 	$(TEST_SRC_DIR)/RunWaveComputer.cpp
 RUN_WAVE_COMPUTER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_WAVE_COMPUTER_DEPENDS = UTIL GEO MATH TIME
+RUN_WAVE_COMPUTER_DEPENDS = UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,RunWaveComputer,RUN_WAVE_COMPUTER))
 
 ANALYSE_FLIGHT_SOURCES = \
@@ -1698,7 +1864,7 @@ ANALYSE_FLIGHT_SOURCES = \
 	$(TEST_SRC_DIR)/FlightPhaseDetector.cpp \
 	$(TEST_SRC_DIR)/AnalyseFlight.cpp
 ANALYSE_FLIGHT_LDADD = $(DEBUG_REPLAY_LDADD)
-ANALYSE_FLIGHT_DEPENDS = CONTEST UTIL GEO MATH TIME
+ANALYSE_FLIGHT_DEPENDS = CONTEST UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,AnalyseFlight,ANALYSE_FLIGHT))
 
 FLIGHT_PATH_SOURCES = \
@@ -1711,7 +1877,7 @@ FLIGHT_PATH_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/FlightPath.cpp
 FLIGHT_PATH_LDADD = $(DEBUG_REPLAY_LDADD)
-FLIGHT_PATH_DEPENDS = UTIL GEO MATH TIME
+FLIGHT_PATH_DEPENDS = UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,FlightPath,FLIGHT_PATH))
 
 LOAD_IMAGE_SOURCES = \
@@ -2331,6 +2497,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/MapSettings.cpp \
 	$(SRC)/Blackboard/InterfaceBlackboard.cpp \
+	$(SRC)/Blackboard/BlackboardGroups.cpp \
 	$(SRC)/Engine/Navigation/TraceHistory.cpp \
 	$(SRC)/Airspace/ActivePredicate.cpp \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
@@ -2446,14 +2613,14 @@ PLAY_VARIO_SOURCES = \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/PlayVario.cpp
 PLAY_VARIO_LDADD = $(filter-out $(THREAD_LIBS),$(filter-out $(OS_LIBS),$(DEBUG_REPLAY_LDADD)))
-PLAY_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT ASYNC THREAD OS TIME UTIL
+PLAY_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT ASYNC THREAD OS TIME UTIL ZLIB
 $(eval $(call link-program,PlayVario,PLAY_VARIO))
 
 DUMP_VARIO_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(TEST_SRC_DIR)/DumpVario.cpp
 DUMP_VARIO_LDADD = $(DEBUG_REPLAY_LDADD)
-DUMP_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT UTIL OS TIME
+DUMP_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT UTIL OS TIME ZLIB
 $(eval $(call link-program,DumpVario,DUMP_VARIO))
 
 RUN_TASK_EDITOR_DIALOG_SOURCES = \
@@ -2626,7 +2793,7 @@ $(eval $(call link-program,DumpFlarmNet,DUMP_FLARM_NET))
 IGC2NMEA_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(TEST_SRC_DIR)/IGC2NMEA.cpp
-IGC2NMEA_DEPENDS = GEO MATH UTIL TIME
+IGC2NMEA_DEPENDS = GEO MATH UTIL TIME ZLIB
 IGC2NMEA_LDADD = $(DEBUG_REPLAY_LDADD)
 
 $(eval $(call link-program,IGC2NMEA,IGC2NMEA))
@@ -0,0 +1,17 @@
+#include <stddef.h>
+#include <stdint.h>
+asm(
+".p2align 3\n"
+".data\n"
+"COPYING_gz:\n"
+"_COPYING_gz:\n"
+".globl COPYING_gz\n"
+".globl _COPYING_gz\n"
+".incbin \"output/data/COPYING.gz\"\n"
+);
+extern const uint8_t COPYING_gz[];
+const uint8_t * const COPYING_gz_end
+    = COPYING_gz + 6846;
+const size_t COPYING_gz_size
+    = 6846;
+
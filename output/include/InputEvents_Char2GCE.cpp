@@ -0,0 +1,27 @@
+"gce_airspace_enter",
+"gce_airspace_leave",
+"gce_commport_restart",
+"gce_flarm_notraffic",
+"gce_flarm_traffic",
+"gce_flarm_newtraffic",
+"gce_flightmode_climb",
+"gce_flightmode_cruise",
+"gce_flightmode_finalglide",
+"gce_flightmode_finalglide_terrain",
+"gce_flightmode_finalglide_above",
+"gce_flightmode_finalglide_below",
+"gce_gps_connection_wait",
+"gce_gps_fix_wait",
+"gce_height_max",
+"gce_landing",
+"gce_startup_real",
+"gce_startup_simulator",
+"gce_takeoff",
+"gce_task_nextwaypoint",
+"gce_task_start",
+"gce_task_finish",
+"gce_team_pos_reached",
+"gce_arm_ready",
+"gce_polar_changed",
+"gce_alternate_changed",
+"gce_landable_unreachable",
@@ -0,0 +1,130 @@
+"ne_down_in_flap_pos",
+"ne_down_in_flap_zero",
+"ne_down_in_flap_neg",
+"ne_down_in_sc",
+"ne_down_in_gear_retracted",
+"ne_down_in_gear_extended",
+"ne_down_in_airbrakenotlocked",
+"ne_down_in_aux",
+"ne_down_in_ack",
+"ne_down_in_rep",
+"ne_down_in_circling_pda",
+"ne_down_in_circling_flarm",
+"ne_down_in_flying",
+"ne_down_in_notflying",
+"ne_down_in_pda_connected",
+"ne_down_in_velocity_manoeuvering",
+"ne_down_in_velocity_flap",
+"ne_down_in_velocity_airbrake",
+"ne_down_in_velocity_terrain",
+"ne_down_in_velocity_neverexceed",
+"ne_down_in_stall",
+"ne_down_in_airbrakelocked",
+"ne_down_in_takingoff",
+"ne_down_in_userswup",
+"ne_down_in_userswmiddle",
+"ne_down_in_userswdown",
+"ne_unused_0",
+"ne_unused_1",
+"ne_unused_2",
+"ne_unused_3",
+"ne_unused_4",
+"ne_unused_5",
+"ne_down_out_circling",
+"ne_down_out_velocity_manoeuvering",
+"ne_down_out_velocity_flap",
+"ne_down_out_velocity_airbrake",
+"ne_down_out_velocity_terrain",
+"ne_down_out_velocity_neverexceed",
+"ne_down_out_gear_landing",
+"ne_down_out_flap_landing",
+"ne_down_out_airbrake_takeoff",
+"ne_down_out_stall",
+"ne_unused_6",
+"ne_unused_7",
+"ne_unused_8",
+"ne_unused_9",
+"ne_unused_10",
+"ne_unused_11",
+"ne_unused_12",
+"ne_unused_13",
+"ne_unused_14",
+"ne_unused_15",
+"ne_unused_16",
+"ne_unused_17",
+"ne_unused_18",
+"ne_unused_19",
+"ne_unused_20",
+"ne_unused_21",
+"ne_unused_22",
+"ne_unused_23",
+"ne_unused_24",
+"ne_unused_25",
+"ne_unused_26",
+"ne_unused_27",
+"ne_up_in_flap_pos",
+"ne_up_in_flap_zero",
+"ne_up_in_flap_neg",
+"ne_up_in_sc",
+"ne_up_in_gear_retracted",
+"ne_up_in_gear_extended",
+"ne_up_in_airbrakenotlocked",
+"ne_up_in_aux",
+"ne_up_in_ack",
+"ne_up_in_rep",
+"ne_up_in_circling_pda",
+"ne_up_in_circling_flarm",
+"ne_up_in_flying",
+"ne_up_in_notflying",
+"ne_up_in_pda_connected",
+"ne_up_in_velocity_manoeuvering",
+"ne_up_in_velocity_flap",
+"ne_up_in_velocity_airbrake",
+"ne_up_in_velocity_terrain",
+"ne_up_in_velocity_neverexceed",
+"ne_up_in_stall",
+"ne_up_in_airbrakelocked",
+"ne_up_in_takingoff",
+"ne_up_in_userswup",
+"ne_up_in_userswmiddle",
+"ne_up_in_userswdown",
+"ne_unused_28",
+"ne_unused_29",
+"ne_unused_30",
+"ne_unused_31",
+"ne_unused_32",
+"ne_unused_33",
+"ne_up_out_circling",
+"ne_up_out_velocity_manoeuvering",
+"ne_up_out_velocity_flap",
+"ne_up_out_velocity_airbrake",
+"ne_up_out_velocity_terrain",
+"ne_up_out_velocity_neverexceed",
+"ne_up_out_gear_landing",
+"ne_up_out_flap_landing",
+"ne_up_out_airbrake_takeoff",
+"ne_up_out_stall",
+"ne_unused_34",
+"ne_unused_35",
+"ne_unused_36",
+"ne_unused_37",
+"ne_unused_38",
+"ne_unused_39",
+"ne_unused_40",
+"ne_unused_41",
+"ne_unused_42",
+"ne_unused_43",
+"ne_unused_44",
+"ne_unused_45",
+"ne_unused_46",
+"ne_unused_47",
+"ne_unused_48",
+"ne_unused_49",
+"ne_unused_50",
+"ne_unused_51",
+"ne_unused_52",
+"ne_unused_53",
+"ne_unused_54",
+"ne_unused_55",
+"ne_unused_56",
+"ne_unused_57",
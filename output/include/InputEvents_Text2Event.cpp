@@ -0,0 +1,69 @@
+{ _T("AbortTask"), &InputEvents::eventAbortTask },
+{ _T("AdjustForecastTemperature"), &InputEvents::eventAdjustForecastTemperature },
+{ _T("AdjustVarioFilter"), &InputEvents::eventAdjustVarioFilter },
+{ _T("AdjustWaypoint"), &InputEvents::eventAdjustWaypoint },
+{ _T("Analysis"), &InputEvents::eventAnalysis },
+{ _T("ArmAdvance"), &InputEvents::eventArmAdvance },
+{ _T("AudioDeadband"), &InputEvents::eventAudioDeadband },
+{ _T("Ballast"), &InputEvents::eventBallast },
+{ _T("Bugs"), &InputEvents::eventBugs },
+{ _T("Calculator"), &InputEvents::eventCalculator },
+{ _T("Checklist"), &InputEvents::eventChecklist },
+{ _T("ClearAirspaceWarnings"), &InputEvents::eventClearAirspaceWarnings },
+{ _T("ClearStatusMessages"), &InputEvents::eventClearStatusMessages },
+{ _T("Logger"), &InputEvents::eventLogger },
+{ _T("MacCready"), &InputEvents::eventMacCready },
+{ _T("MainMenu"), &InputEvents::eventMainMenu },
+{ _T("MarkLocation"), &InputEvents::eventMarkLocation },
+{ _T("Mode"), &InputEvents::eventMode },
+{ _T("NearestAirspaceDetails"), &InputEvents::eventNearestAirspaceDetails },
+{ _T("NearestWaypointDetails"), &InputEvents::eventNearestWaypointDetails },
+{ _T("NearestMapItems"), &InputEvents::eventNearestMapItems },
+{ _T("Null"), &InputEvents::eventNull },
+{ _T("Page"), &InputEvents::eventPage },
+{ _T("Pan"), &InputEvents::eventPan },
+{ _T("PlaySound"), &InputEvents::eventPlaySound },
+{ _T("ProfileLoad"), &InputEvents::eventProfileLoad },
+{ _T("ProfileSave"), &InputEvents::eventProfileSave },
+{ _T("RepeatStatusMessage"), &InputEvents::eventRepeatStatusMessage },
+{ _T("Run"), &InputEvents::eventRun },
+{ _T("ScreenModes"), &InputEvents::eventScreenModes },
+{ _T("Device"), &InputEvents::eventDevice },
+{ _T("SendNMEA"), &InputEvents::eventSendNMEA },
+{ _T("SendNMEAPort1"), &InputEvents::eventSendNMEAPort1 },
+{ _T("SendNMEAPort2"), &InputEvents::eventSendNMEAPort2 },
+{ _T("Setup"), &InputEvents::eventSetup },
+{ _T("SnailTrail"), &InputEvents::eventSnailTrail },
+{ _T("AirSpace"), &InputEvents::eventAirSpace },
+{ _T("Sounds"), &InputEvents::eventSounds },
+{ _T("Status"), &InputEvents::eventStatus },
+{ _T("StatusMessage"), &InputEvents::eventStatusMessage },
+{ _T("TaskLoad"), &InputEvents::eventTaskLoad },
+{ _T("TaskSave"), &InputEvents::eventTaskSave },
+{ _T("TaskTransition"), &InputEvents::eventTaskTransition },
+{ _T("TerrainTopography"), &InputEvents::eventTerrainTopography },
+{ _T("TerrainTopology"), &InputEvents::eventTerrainTopology },
+{ _T("WaypointDetails"), &InputEvents::eventWaypointDetails },
+{ _T("WaypointEditor"), &InputEvents::eventWaypointEditor },
+{ _T("Zoom"), &InputEvents::eventZoom },
+{ _T("Brightness"), &InputEvents::eventBrightness },
+{ _T("DeclutterLabels"), &InputEvents::eventDeclutterLabels },
+{ _T("Exit"), &InputEvents::eventExit },
+{ _T("FLARMRadar"), &InputEvents::eventFLARMRadar },
+{ _T("ThermalAssistant"), &InputEvents::eventThermalAssistant },
+{ _T("Beep"), &InputEvents::eventBeep },
+{ _T("UserDisplayModeForce"), &InputEvents::eventUserDisplayModeForce },
+{ _T("AirspaceDisplayMode"), &InputEvents::eventAirspaceDisplayMode },
+{ _T("AutoLogger"), &InputEvents::eventAutoLogger },
+{ _T("GotoLookup"), &InputEvents::eventGotoLookup },
+{ _T("AddWaypoint"), &InputEvents::eventAddWaypoint },
+{ _T("Orientation"), &InputEvents::eventOrientation },
+{ _T("Traffic"), &InputEvents::eventTraffic },
+{ _T("FlarmTraffic"), &InputEvents::eventFlarmTraffic },
+{ _T("FlarmDetails"), &InputEvents::eventFlarmDetails },
+{ _T("Credits"), &InputEvents::eventCredits },
+{ _T("Weather"), &InputEvents::eventWeather },
+{ _T("QuickMenu"), &InputEvents::eventQuickMenu },
+{ _T("FileManager"), &InputEvents::eventFileManager },
+{ _T("RunLuaFile"), &InputEvents::eventRunLuaFile },
+{ _T("ResetTask"), &InputEvents::eventResetTask },
@@ -0,0 +1,12353 @@
+const double SINETABLE[4096] = {  0.00000000000000000000e+00,
+  1.53398018628486654778e-03,
+  3.06795676296617823853e-03,
+  4.60192612044887407186e-03,
+  6.13588464915487945966e-03,
+  7.66982873953160268488e-03,
+  9.20375478206042658968e-03,
+  1.07376591672651983123e-02,
+  1.22715382857207337686e-02,
+  1.38053885280612995828e-02,
+  1.53392062849891114978e-02,
+  1.68729879472828241116e-02,
+  1.84067299058060344918e-02,
+  1.99404285515157528308e-02,
+  2.14740802754709234068e-02,
+  2.30076814688408883003e-02,
+  2.45412285229139048859e-02,
+  2.60747178291056182220e-02,
+  2.76081457789675577263e-02,
+  2.91415087641956407905e-02,
+  3.06748031766386451691e-02,
+  3.22080254083067091253e-02,
+  3.37411718513798072894e-02,
+  3.52742388982162716204e-02,
+  3.68072229413612603266e-02,
+  3.83401203735552198459e-02,
+  3.98729275877424335639e-02,
+  4.14056409770794664471e-02,
+  4.29382569349436513106e-02,
+  4.44707718549415889631e-02,
+  4.60031821309176622292e-02,
+  4.75354841569624320119e-02,
+  4.90676743274212415202e-02,
+  5.05997490369026053925e-02,
+  5.21317046802867514743e-02,
+  5.36635376527340585140e-02,
+  5.51952443496935701850e-02,
+  5.67268211669114813533e-02,
+  5.82582645004395896504e-02,
+  5.97895707466438025568e-02,
+  6.13207363022126097918e-02,
+  6.28517575641655418250e-02,
+  6.43826309298616977772e-02,
+  6.59133527970081484204e-02,
+  6.74439195636684918345e-02,
+  6.89743276282712841629e-02,
+  7.05045733896184911860e-02,
+  7.20346532468940647931e-02,
+  7.35645635996722696559e-02,
+  7.50943008479262458232e-02,
+  7.66238613920365296828e-02,
+  7.81532416327993806338e-02,
+  7.96824379714353575599e-02,
+  8.12114468095977704021e-02,
+  8.27402645493811317312e-02,
+  8.42688875933296083209e-02,
+  8.57973123444455282316e-02,
+  8.73255352061978185052e-02,
+  8.88535525825304289826e-02,
+  9.03813608778709226543e-02,
+  9.19089564971387745773e-02,
+  9.34363358457539205926e-02,
+  9.49634953296452366533e-02,
+  9.64904313552589348868e-02,
+  9.80171403295670290445e-02,
+  9.95436186600758693421e-02,
+  1.01069862754834455254e-01,
+  1.02595869022443025864e-01,
+  1.04121633872061414294e-01,
+  1.05647153713417540910e-01,
+  1.07172424956815878772e-01,
+  1.08697444013145849695e-01,
+  1.10222207293890275825e-01,
+  1.11746711211133928354e-01,
+  1.13270952177571784802e-01,
+  1.14794926606517605494e-01,
+  1.16318630911912385129e-01,
+  1.17842061508332707209e-01,
+  1.19365214810999181738e-01,
+  1.20888087235784993934e-01,
+  1.22410675199224217025e-01,
+  1.23932975118520291580e-01,
+  1.25454983411554449324e-01,
+  1.26976696496894192467e-01,
+  1.28498110793801606500e-01,
+  1.30019222722241895029e-01,
+  1.31540028702891720336e-01,
+  1.33060525157147779840e-01,
+  1.34580708507134994001e-01,
+  1.36100575175715110543e-01,
+  1.37620121586495058885e-01,
+  1.39139344163835304569e-01,
+  1.40658239332858425730e-01,
+  1.42176803519457356506e-01,
+  1.43695033150303852487e-01,
+  1.45212924652856956165e-01,
+  1.46730474455371351361e-01,
+  1.48247678986905717657e-01,
+  1.49764534677331306867e-01,
+  1.51281037957340103173e-01,
+  1.52797185258453399603e-01,
+  1.54312973013030180214e-01,
+  1.55828397654275419004e-01,
+  1.57343455616248517615e-01,
+  1.58858143333871798530e-01,
+  1.60372457242938748490e-01,
+  1.61886393780122400665e-01,
+  1.63399949382983911139e-01,
+  1.64913120489980691286e-01,
+  1.66425903540474956488e-01,
+  1.67938294974742136079e-01,
+  1.69450291233979005723e-01,
+  1.70961888760312374913e-01,
+  1.72473083996807219354e-01,
+  1.73983873387475174166e-01,
+  1.75494253377282860562e-01,
+  1.77004220412160295783e-01,
+  1.78513770939009164263e-01,
+  1.80022901405711255318e-01,
+  1.81531608261136817584e-01,
+  1.83039887955152885679e-01,
+  1.84547736938631606884e-01,
+  1.86055151663458762101e-01,
+  1.87562128582541814970e-01,
+  1.89068664149818516096e-01,
+  1.90574754820265174216e-01,
+  1.92080397049904955109e-01,
+  1.93585587295816208275e-01,
+  1.95090322016140932382e-01,
+  1.96594597670093018671e-01,
+  1.98098410717966466610e-01,
+  1.99601757621143960364e-01,
+  2.01104634842104973425e-01,
+  2.02607038844434261815e-01,
+  2.04108966092830135253e-01,
+  2.05610413053112617288e-01,
+  2.07111376192231994020e-01,
+  2.08611851978277029751e-01,
+  2.10111836880483238144e-01,
+  2.11611327369241292162e-01,
+  2.13110319916105184213e-01,
+  2.14608810993800691591e-01,
+  2.16106797076233508870e-01,
+  2.17604274638497741101e-01,
+  2.19101240156883980692e-01,
+  2.20597690108887800609e-01,
+  2.22093620973217914516e-01,
+  2.23589029229804475696e-01,
+  2.25083911359807403718e-01,
+  2.26578263845624683359e-01,
+  2.28072083170900469229e-01,
+  2.29565365820533717756e-01,
+  2.31058108280686069769e-01,
+  2.32550307038790260439e-01,
+  2.34041958583558556972e-01,
+  2.35533059404990724461e-01,
+  2.37023605994382519091e-01,
+  2.38513594844333820522e-01,
+  2.40003022448756986318e-01,
+  2.41491885302884928821e-01,
+  2.42980179903279580600e-01,
+  2.44467902747839943567e-01,
+  2.45955050335810471163e-01,
+  2.47441619167789256251e-01,
+  2.48927605745736219012e-01,
+  2.50413006572981378106e-01,
+  2.51897818154233177346e-01,
+  2.53382036995586479300e-01,
+  2.54865659604531002991e-01,
+  2.56348682489959400765e-01,
+  2.57831102162175640480e-01,
+  2.59312915132902888082e-01,
+  2.60794117915292278376e-01,
+  2.62274707023930464533e-01,
+  2.63754678974848333350e-01,
+  2.65234030285528832316e-01,
+  2.66712757474915518330e-01,
+  2.68190857063420440287e-01,
+  2.69668325572932410239e-01,
+  2.71145159526825441088e-01,
+  2.72621355449966518147e-01,
+  2.74096909868723981329e-01,
+  2.75571819310975796302e-01,
+  2.77046080306117659120e-01,
+  2.78519689385070934318e-01,
+  2.79992643080291148117e-01,
+  2.81464937925775982031e-01,
+  2.82936570457073488516e-01,
+  2.84407537211290029067e-01,
+  2.85877834727098878442e-01,
+  2.87347459544747940718e-01,
+  2.88816408206067964937e-01,
+  2.90284677254480927289e-01,
+  2.91752263235007969211e-01,
+  2.93219162694277390990e-01,
+  2.94685372180533144970e-01,
+  2.96150888243642718134e-01,
+  2.97615707435105181222e-01,
+  2.99079826308059570916e-01,
+  3.00543241417292661399e-01,
+  3.02005949319247346541e-01,
+  3.03467946572030633501e-01,
+  3.04929229735421858383e-01,
+  3.06389795370880457792e-01,
+  3.07849640041554517556e-01,
+  3.09308760312288433258e-01,
+  3.10767152749631236919e-01,
+  3.12224813921844757125e-01,
+  3.13681740398911390599e-01,
+  3.15137928752542428867e-01,
+  3.16593375556185996356e-01,
+  3.18048077385035155018e-01,
+  3.19502030816035953453e-01,
+  3.20955232427895642555e-01,
+  3.22407678801090336052e-01,
+  3.23859366517873448199e-01,
+  3.25310292162283576367e-01,
+  3.26760452320152550154e-01,
+  3.28209843579113313972e-01,
+  3.29658462528608364739e-01,
+  3.31106305759897356911e-01,
+  3.32553369866065318128e-01,
+  3.33999651442030531800e-01,
+  3.35445147084552863781e-01,
+  3.36889853392241367391e-01,
+  3.38333766965562554585e-01,
+  3.39776884406848334041e-01,
+  3.41219202320303949261e-01,
+  3.42660717312016083191e-01,
+  3.44101425989960574281e-01,
+  3.45541324964010854170e-01,
+  3.46980410845945552722e-01,
+  3.48418680249456547138e-01,
+  3.49856129790156955561e-01,
+  3.51292756085589241710e-01,
+  3.52728555755232930924e-01,
+  3.54163525420512659281e-01,
+  3.55597661704806278227e-01,
+  3.57030961233452515113e-01,
+  3.58463420633759133338e-01,
+  3.59895036535010814926e-01,
+  3.61325805568476932095e-01,
+  3.62755724367419984944e-01,
+  3.64184789567102762398e-01,
+  3.65612997804796779899e-01,
+  3.67040345719790217505e-01,
+  3.68466829953395413888e-01,
+  3.69892447148957304037e-01,
+  3.71317193951860802237e-01,
+  3.72741067009539128740e-01,
+  3.74164062971481414799e-01,
+  3.75586178489240751777e-01,
+  3.77007410216441851691e-01,
+  3.78427754808789207353e-01,
+  3.79847208924074863923e-01,
+  3.81265769222186190479e-01,
+  3.82683432365113651574e-01,
+  3.84100195016959022887e-01,
+  3.85516053843942940738e-01,
+  3.86931005514412729163e-01,
+  3.88345046698850504541e-01,
+  3.89758174069880780621e-01,
+  3.91170384302278240085e-01,
+  3.92581674072975950196e-01,
+  3.93992040061072579249e-01,
+  3.95401478947840889777e-01,
+  3.96809987416734955001e-01,
+  3.98217562153398318969e-01,
+  3.99624199845671657094e-01,
+  4.01029897183600547717e-01,
+  4.02434650859443410198e-01,
+  4.03838457567679165461e-01,
+  4.05241314005015007549e-01,
+  4.06643216870394230700e-01,
+  4.08044162865003945395e-01,
+  4.09444148692282960944e-01,
+  4.10843171057929334999e-01,
+  4.12241226669908367164e-01,
+  4.13638312238460092995e-01,
+  4.15034424476107277613e-01,
+  4.16429560097662909701e-01,
+  4.17823715820238084095e-01,
+  4.19216888363249828853e-01,
+  4.20609074448428488235e-01,
+  4.22000270799825716317e-01,
+  4.23390474143822137520e-01,
+  4.24779681209135007158e-01,
+  4.26167888726825871970e-01,
+  4.27555093430308397195e-01,
+  4.28941292055355860580e-01,
+  4.30326481340109090468e-01,
+  4.31710658025083793277e-01,
+  4.33093818853178547101e-01,
+  4.34475960569682351231e-01,
+  4.35857079922282231177e-01,
+  4.37237173661070899211e-01,
+  4.38616238538554525928e-01,
+  4.39994271309660178737e-01,
+  4.41371268731743704450e-01,
+  4.42747227564597167770e-01,
+  4.44122144570456345303e-01,
+  4.45496016514008941201e-01,
+  4.46868840162401470550e-01,
+  4.48240612285247252977e-01,
+  4.49611329654634017672e-01,
+  4.50980989045131397397e-01,
+  4.52349587233798422492e-01,
+  4.53717121000191514479e-01,
+  4.55083587126371535980e-01,
+  4.56448982396911728809e-01,
+  4.57813303598905096958e-01,
+  4.59176547521972011623e-01,
+  4.60538710958267982765e-01,
+  4.61899790702490764538e-01,
+  4.63259783551888293385e-01,
+  4.64618686306266015507e-01,
+  4.65976495767994436381e-01,
+  4.67333208742016781301e-01,
+  4.68688822035856322845e-01,
+  4.70043332459624096931e-01,
+  4.71396736826026174771e-01,
+  4.72749031950371378930e-01,
+  4.74100214650578666298e-01,
+  4.75450281747184566594e-01,
+  4.76799230063350898412e-01,
+  4.78147056424871874647e-01,
+  4.79493757660181929570e-01,
+  4.80839330600362990786e-01,
+  4.82183772079151751200e-01,
+  4.83527078932947773637e-01,
+  4.84869248000820263211e-01,
+  4.86210276124515616836e-01,
+  4.87550160148465250298e-01,
+  4.88888896919792481643e-01,
+  4.90226483288320580289e-01,
+  4.91562916106579372855e-01,
+  4.92898192229813625342e-01,
+  4.94232308515989315900e-01,
+  4.95565261825802239048e-01,
+  4.96897049022684278441e-01,
+  4.98227666972811678026e-01,
+  4.99557112545111703383e-01,
+  5.00885382611270690845e-01,
+  5.02212474045740764339e-01,
+  5.03538383725747551445e-01,
+  5.04863108531297677395e-01,
+  5.06186645345185426415e-01,
+  5.07508991053001068394e-01,
+  5.08830142543137298183e-01,
+  5.10150096706797118173e-01,
+  5.11468850438000721681e-01,
+  5.12786400633593486553e-01,
+  5.14102744193252192417e-01,
+  5.15417878019493458375e-01,
+  5.16731799017680515362e-01,
+  5.18044504096029978513e-01,
+  5.19355990165620284849e-01,
+  5.20666254140397910533e-01,
+  5.21975292937185253450e-01,
+  5.23283103475687294548e-01,
+  5.24589682678499924506e-01,
+  5.25895027471115716899e-01,
+  5.27199134781932476912e-01,
+  5.28502001542259569611e-01,
+  5.29803624686325802529e-01,
+  5.31104001151286198024e-01,
+  5.32403127877229209730e-01,
+  5.33701001807184272074e-01,
+  5.34997619887128572636e-01,
+  5.36292979065994601662e-01,
+  5.37587076295676924431e-01,
+  5.38879908531040063835e-01,
+  5.40171472729924495582e-01,
+  5.41461765853155196915e-01,
+  5.42750784864547641817e-01,
+  5.44038526730915683594e-01,
+  5.45324988422078216210e-01,
+  5.46610166910866723811e-01,
+  5.47894059173132164098e-01,
+  5.49176662187751740696e-01,
+  5.50457972936636896755e-01,
+  5.51737988404739532200e-01,
+  5.53016705580059664271e-01,
+  5.54294121453652310905e-01,
+  5.55570233019634485139e-01,
+  5.56845037275192411563e-01,
+  5.58118531220588520725e-01,
+  5.59390711859168443532e-01,
+  5.60661576197368449748e-01,
+  5.61931121244721887287e-01,
+  5.63199344013866620706e-01,
+  5.64466241520552025612e-01,
+  5.65731810783645872043e-01,
+  5.66996048825141318872e-01,
+  5.68258952670164241283e-01,
+  5.69520519346980003128e-01,
+  5.70780745887000118266e-01,
+  5.72039629324790022125e-01,
+  5.73297166698075177926e-01,
+  5.74553355047748737228e-01,
+  5.75808191417878312279e-01,
+  5.77061672855712526342e-01,
+  5.78313796411688674226e-01,
+  5.79564559139438939539e-01,
+  5.80813958095797833181e-01,
+  5.82061990340808743660e-01,
+  5.83308652937731597632e-01,
+  5.84553942953048633058e-01,
+  5.85797857456472281790e-01,
+  5.87040393520951386819e-01,
+  5.88281548222678862814e-01,
+  5.89521318641097469282e-01,
+  5.90759701858907804173e-01,
+  5.91996694962074632151e-01,
+  5.93232295039833434913e-01,
+  5.94466499184698182745e-01,
+  5.95699304492467107686e-01,
+  5.96930708062230253041e-01,
+  5.98160706996376134725e-01,
+  5.99389298400598513616e-01,
+  6.00616479383902834854e-01,
+  6.01842247058614110422e-01,
+  6.03066598540382248217e-01,
+  6.04289530948190045656e-01,
+  6.05511041404359628970e-01,
+  6.06731127034558559430e-01,
+  6.07949784967807826952e-01,
+  6.09167012336487401214e-01,
+  6.10382806276343670149e-01,
+  6.11597163926496212305e-01,
+  6.12810082429444014096e-01,
+  6.14021558931072797272e-01,
+  6.15231590580661236167e-01,
+  6.16440174530888063131e-01,
+  6.17647307937838507819e-01,
+  6.18852987961010847506e-01,
+  6.20057211763323734566e-01,
+  6.21259976511122191667e-01,
+  6.22461279374184606183e-01,
+  6.23661117525729280509e-01,
+  6.24859488142421093393e-01,
+  6.26056388404378272305e-01,
+  6.27251815495178832727e-01,
+  6.28445766601867572554e-01,
+  6.29638238914961845261e-01,
+  6.30829229628459442480e-01,
+  6.32018735939843923077e-01,
+  6.33206755050092162662e-01,
+  6.34393284163680459820e-01,
+  6.35578320488591086423e-01,
+  6.36761861236319282042e-01,
+  6.37943903621879138122e-01,
+  6.39124444863810925455e-01,
+  6.40303482184186756321e-01,
+  6.41481012808618356047e-01,
+  6.42657033966262059010e-01,
+  6.43831542889826802245e-01,
+  6.45004536815579232467e-01,
+  6.46176012983351588659e-01,
+  6.47345968636547475228e-01,
+  6.48514401022147746190e-01,
+  6.49681307390718609795e-01,
+  6.50846684996416291469e-01,
+  6.52010531096995027411e-01,
+  6.53172842953812282651e-01,
+  6.54333617831836078516e-01,
+  6.55492852999650876811e-01,
+  6.56650545729464685252e-01,
+  6.57806693297114275509e-01,
+  6.58961292982073065794e-01,
+  6.60114342067456116858e-01,
+  6.61265837840027903560e-01,
+  6.62415777590207532910e-01,
+  6.63564158612075516430e-01,
+  6.64710978203380653540e-01,
+  6.65856233665545471645e-01,
+  6.66999922303673331569e-01,
+  6.68142041426554311734e-01,
+  6.69282588346671980517e-01,
+  6.70421560380208947372e-01,
+  6.71558954847054412340e-01,
+  6.72694769070808828992e-01,
+  6.73829000378792009052e-01,
+  6.74961646102048007378e-01,
+  6.76092703575352005352e-01,
+  6.77222170137216528119e-01,
+  6.78350043129897550820e-01,
+  6.79476319899401159930e-01,
+  6.80600997795489104369e-01,
+  6.81724074171686011958e-01,
+  6.82845546385284274393e-01,
+  6.83965411797351596768e-01,
+  6.85083667772736548685e-01,
+  6.86200311680074781506e-01,
+  6.87315340891795356626e-01,
+  6.88428752784126740671e-01,
+  6.89540544737103244799e-01,
+  6.90650714134570908875e-01,
+  6.91759258364194162816e-01,
+  6.92866174817461044633e-01,
+  6.93971460889690416884e-01,
+  6.95075113980037295747e-01,
+  6.96177131491499401328e-01,
+  6.97277510830922930829e-01,
+  6.98376249409009330904e-01,
+  6.99473344640320293664e-01,
+  7.00568793943284862102e-01,
+  7.01662594740204981214e-01,
+  7.02754744457261826263e-01,
+  7.03845240524521464920e-01,
+  7.04934080375941407581e-01,
+  7.06021261449376380526e-01,
+  7.07106781186584099075e-01,
+  7.08190637033231928932e-01,
+  7.09272826438902215251e-01,
+  7.10353346857098943978e-01,
+  7.11432195745253070918e-01,
+  7.12509370564728961028e-01,
+  7.13584868780830272605e-01,
+  7.14658687862805730440e-01,
+  7.15730825283855343066e-01,
+  7.16801278521136175925e-01,
+  7.17870045055768457587e-01,
+  7.18937122372841130868e-01,
+  7.20002507961418403148e-01,
+  7.21066199314544853394e-01,
+  7.22128193929252093497e-01,
+  7.23188489306564208370e-01,
+  7.24247082951503640125e-01,
+  7.25303972373097516346e-01,
+  7.26359155084382757117e-01,
+  7.27412628602412625334e-01,
+  7.28464390448261944755e-01,
+  7.29514438147033872362e-01,
+  7.30562769227864339250e-01,
+  7.31609381223929378102e-01,
+  7.32654271672449675101e-01,
+  7.33697438114697120248e-01,
+  7.34738878096000358475e-01,
+  7.35778589165750451784e-01,
+  7.36816568877406763427e-01,
+  7.37852814788502842092e-01,
+  7.38887324460652084035e-01,
+  7.39920095459553062156e-01,
+  7.40951125354995965289e-01,
+  7.41980411720867927272e-01,
+  7.43007952135158578066e-01,
+  7.44033744179966149979e-01,
+  7.45057785441502917756e-01,
+  7.46080073510100749701e-01,
+  7.47100605980217102875e-01,
+  7.48119380450440463193e-01,
+  7.49136394523496229603e-01,
+  7.50151645806252043158e-01,
+  7.51165131909723338133e-01,
+  7.52176850449079670291e-01,
+  7.53186799043649379826e-01,
+  7.54194975316926141673e-01,
+  7.55201376896573517428e-01,
+  7.56206001414431505658e-01,
+  7.57208846506521537911e-01,
+  7.58209909813052251870e-01,
+  7.59209188978424931449e-01,
+  7.60206681651239390973e-01,
+  7.61202385484298749141e-01,
+  7.62196298134615868314e-01,
+  7.63188417263418239500e-01,
+  7.64178740536153644491e-01,
+  7.65167265622495929023e-01,
+  7.66153990196349776731e-01,
+  7.67138911935857370494e-01,
+  7.68122028523402278211e-01,
+  7.69103337645616558227e-01,
+  7.70082836993384867164e-01,
+  7.71060524261850677163e-01,
+  7.72036397150421382918e-01,
+  7.73010453362773852781e-01,
+  7.73982690606859757843e-01,
+  7.74953106594910789973e-01,
+  7.75921699043444546007e-01,
+  7.76888465673269301703e-01,
+  7.77853404209490006949e-01,
+  7.78816512381512837671e-01,
+  7.79777787923051413088e-01,
+  7.80737228572131347626e-01,
+  7.81694832071096246118e-01,
+  7.82650596166612588789e-01,
+  7.83604518609675060326e-01,
+  7.84556597155612100991e-01,
+  7.85506829564090791607e-01,
+  7.86455213599122626711e-01,
+  7.87401747029068177497e-01,
+  7.88346427626643087017e-01,
+  7.89289253168922400050e-01,
+  7.90230221437346891378e-01,
+  7.91169330217726951560e-01,
+  7.92106577300249137252e-01,
+  7.93041960479480390056e-01,
+  7.93975477554373920697e-01,
+  7.94907126328273649918e-01,
+  7.95836904608920203685e-01,
+  7.96764810208455465101e-01,
+  7.97690840943427792453e-01,
+  7.98614994634797570328e-01,
+  7.99537269107941650503e-01,
+  8.00457662192659458178e-01,
+  8.01376171723176877748e-01,
+  8.02292795538152359036e-01,
+  8.03207531480681469205e-01,
+  8.04120377398302332850e-01,
+  8.05031331143000183914e-01,
+  8.05940390571212805781e-01,
+  8.06847553543835749323e-01,
+  8.07752817926226773793e-01,
+  8.08656181588211508959e-01,
+  8.09557642404087673960e-01,
+  8.10457198252631294544e-01,
+  8.11354847017100144768e-01,
+  8.12250586585240408333e-01,
+  8.13144414849289898228e-01,
+  8.14036329705984718075e-01,
+  8.14926329056562925857e-01,
+  8.15814410806770085038e-01,
+  8.16700572866864149546e-01,
+  8.17584813151620015681e-01,
+  8.18467129580334962213e-01,
+  8.19347520076833202296e-01,
+  8.20225982569470879469e-01,
+  8.21102514991140841616e-01,
+  8.21977115279277747995e-01,
+  8.22849781375862510124e-01,
+  8.23720511227427509837e-01,
+  8.24589302785061373235e-01,
+  8.25456154004413633629e-01,
+  8.26321062845699505495e-01,
+  8.27184027273705102523e-01,
+  8.28045045257791767490e-01,
+  8.28904114771900846215e-01,
+  8.29761233794559016630e-01,
+  8.30616400308882174564e-01,
+  8.31469612302581206897e-01,
+  8.32320867767965544282e-01,
+  8.33170164701949045316e-01,
+  8.34017501106053993354e-01,
+  8.34862874986415870460e-01,
+  8.35706284353788353414e-01,
+  8.36547727223547754605e-01,
+  8.37387201615697684964e-01,
+  8.38224705554873716906e-01,
+  8.39060237070348380328e-01,
+  8.39893794196035159416e-01,
+  8.40725374970493710691e-01,
+  8.41554977436933970836e-01,
+  8.42382599643221485763e-01,
+  8.43208239641880963333e-01,
+  8.44031895490101935486e-01,
+  8.44853565249742533005e-01,
+  8.45673246987334481517e-01,
+  8.46490938774087431362e-01,
+  8.47306638685893731555e-01,
+  8.48120344803332537609e-01,
+  8.48932055211674918560e-01,
+  8.49741768000887742751e-01,
+  8.50549481265638673833e-01,
+  8.51355193105300389611e-01,
+  8.52158901623955022941e-01,
+  8.52960604930398713641e-01,
+  8.53760301138146493471e-01,
+  8.54557988365435616807e-01,
+  8.55353664735231000726e-01,
+  8.56147328375229443864e-01,
+  8.56938977417863623209e-01,
+  8.57728610000306979089e-01,
+  8.58516224264477600947e-01,
+  8.59301818357043223351e-01,
+  8.60085390429425000747e-01,
+  8.60866938637802059375e-01,
+  8.61646461143116049186e-01,
+  8.62423956111075251663e-01,
+  8.63199421712158798670e-01,
+  8.63972856121621335390e-01,
+  8.64744257519496906106e-01,
+  8.65513624090603617134e-01,
+  8.66280954024547522607e-01,
+  8.67046245515727065367e-01,
+  8.67809496763337628877e-01,
+  8.68570705971375200960e-01,
+  8.69329871348641147755e-01,
+  8.70086991108745655410e-01,
+  8.70842063470113170176e-01,
+  8.71595086655985284985e-01,
+  8.72346058894425735453e-01,
+  8.73094978418324174640e-01,
+  8.73841843465400835989e-01,
+  8.74586652278210086031e-01,
+  8.75329403104144754266e-01,
+  8.76070094195440463025e-01,
+  8.76808723809179513253e-01,
+  8.77545290207295103357e-01,
+  8.78279791656575214986e-01,
+  8.79012226428667164946e-01,
+  8.79742592800081157911e-01,
+  8.80470889052194394253e-01,
+  8.81197113471255621953e-01,
+  8.81921264348388578291e-01,
+  8.82643339979596319722e-01,
+  8.83363338665764996627e-01,
+  8.84081258712668405231e-01,
+  8.84797098430971096228e-01,
+  8.85510856136233259761e-01,
+  8.86222530148913834047e-01,
+  8.86932118794375390358e-01,
+  8.87639620402887130624e-01,
+  8.88345033309629439344e-01,
+  8.89048355854697547329e-01,
+  8.89749586383105750542e-01,
+  8.90448723244790851794e-01,
+  8.91145764794616046522e-01,
+  8.91840709392375474707e-01,
+  8.92533555402797440514e-01,
+  8.93224301195548076038e-01,
+  8.93912945145235893207e-01,
+  8.94599485631415225484e-01,
+  8.95283921038590113639e-01,
+  8.95966249756217636424e-01,
+  8.96646470178712573507e-01,
+  8.97324580705450625118e-01,
+  8.98000579740772186810e-01,
+  8.98674465693986013193e-01,
+  8.99346236979373769849e-01,
+  9.00015892016192364800e-01,
+  9.00683429228679055534e-01,
+  9.01348847046054002519e-01,
+  9.02012143902525154182e-01,
+  9.02673318237290689403e-01,
+  9.03332368494543680448e-01,
+  9.03989293123475090574e-01,
+  9.04644090578277881853e-01,
+  9.05296759318150456863e-01,
+  9.05947297807300100381e-01,
+  9.06595704514946865160e-01,
+  9.07241977915327346693e-01,
+  9.07886116487697680810e-01,
+  9.08528118716337429461e-01,
+  9.09167983090553688541e-01,
+  9.09805708104683530379e-01,
+  9.10441292258098444634e-01,
+  9.11074734055207335892e-01,
+  9.11706032005460853540e-01,
+  9.12335184623353723232e-01,
+  9.12962190428429076761e-01,
+  9.13587047945281671701e-01,
+  9.14209755703561444129e-01,
+  9.14830312237976839285e-01,
+  9.15448716088298475313e-01,
+  9.16064965799362251886e-01,
+  9.16679059921073235984e-01,
+  9.17290997008408437452e-01,
+  9.17900775621420805805e-01,
+  9.18508394325242560896e-01,
+  9.19113851690087968471e-01,
+  9.19717146291257559021e-01,
+  9.20318276709140681291e-01,
+  9.20917241529219499085e-01,
+  9.21514039342071988870e-01,
+  9.22108668743374937371e-01,
+  9.22701128333908382473e-01,
+  9.23291416719557389570e-01,
+  9.23879532511316492460e-01,
+  9.24465474325292246860e-01,
+  9.25049240782707116182e-01,
+  9.25630830509902247094e-01,
+  9.26210242138340800189e-01,
+  9.26787474304611058606e-01,
+  9.27362525650430313817e-01,
+  9.27935394822647086066e-01,
+  9.28506080473244677087e-01,
+  9.29074581259344833839e-01,
+  9.29640895843210190996e-01,
+  9.30205022892247934685e-01,
+  9.30766961079012467017e-01,
+  9.31326709081209180852e-01,
+  9.31884265581696791259e-01,
+  9.32439629268490999259e-01,
+  9.32992798834767378402e-01,
+  9.33543772978864594414e-01,
+  9.34092550404287291776e-01,
+  9.34639129819708980307e-01,
+  9.35183509938975809916e-01,
+  9.35725689481108457990e-01,
+  9.36265667170306348233e-01,
+  9.36803441735949538050e-01,
+  9.37339011912602826371e-01,
+  9.37872376440017641031e-01,
+  9.38403534063135813525e-01,
+  9.38932483532092132528e-01,
+  9.39459223602217452509e-01,
+  9.39983753034041469299e-01,
+  9.40506070593295717686e-01,
+  9.41026175050916569020e-01,
+  9.41544065183048006773e-01,
+  9.42059739771044513112e-01,
+  9.42573197601473955487e-01,
+  9.43084437466120473204e-01,
+  9.43593458161987252986e-01,
+  9.44100258491299526575e-01,
+  9.44604837261507013224e-01,
+  9.45107193285287250362e-01,
+  9.45607325380547925064e-01,
+  9.46105232370429871658e-01,
+  9.46600913083309958296e-01,
+  9.47094366352803529452e-01,
+  9.47585591017767403521e-01,
+  9.48074585922302315311e-01,
+  9.48561349915756357731e-01,
+  9.49045881852726536110e-01,
+  9.49528180593062542947e-01,
+  9.50008245001868756319e-01,
+  9.50486073949507348502e-01,
+  9.50961666311600728463e-01,
+  9.51435020969033873328e-01,
+  9.51906136807957659052e-01,
+  9.52375012719791191884e-01,
+  9.52841647601223917796e-01,
+  9.53306040354218953148e-01,
+  9.53768189886015305134e-01,
+  9.54228095109130647344e-01,
+  9.54685754941363207138e-01,
+  9.55141168305795429383e-01,
+  9.55594334130795752813e-01,
+  9.56045251350021052517e-01,
+  9.56493918902419637540e-01,
+  9.56940335732233249288e-01,
+  9.57384500789000170151e-01,
+  9.57826413027557110880e-01,
+  9.58266071408041764101e-01,
+  9.58703474895895579877e-01,
+  9.59138622461865875124e-01,
+  9.59571513082008387130e-01,
+  9.60002145737689605021e-01,
+  9.60430519415589434296e-01,
+  9.60856633107703195229e-01,
+  9.61280485811344065361e-01,
+  9.61702076529145855055e-01,
+  9.62121404269064894876e-01,
+  9.62538468044382367061e-01,
+  9.62953266873706859030e-01,
+  9.63365799780977027922e-01,
+  9.63776065795462710817e-01,
+  9.64184063951768588474e-01,
+  9.64589793289835295553e-01,
+  9.64993252854942862307e-01,
+  9.65394441697711824801e-01,
+  9.65793358874106000478e-01,
+  9.66190003445434819618e-01,
+  9.66584374478355212723e-01,
+  9.66976471044874164029e-01,
+  9.67366292222350487862e-01,
+  9.67753837093497271127e-01,
+  9.68139104746384093758e-01,
+  9.68522094274438916095e-01,
+  9.68902804776450410351e-01,
+  9.69281235356569847994e-01,
+  9.69657385124313764280e-01,
+  9.70031253194565179498e-01,
+  9.70402838687576596577e-01,
+  9.70772140728971333345e-01,
+  9.71139158449746076052e-01,
+  9.71503890986272544694e-01,
+  9.71866337480300046536e-01,
+  9.72226497078956919395e-01,
+  9.72584368934752752089e-01,
+  9.72939952205580493860e-01,
+  9.73293246054718452775e-01,
+  9.73644249650832072085e-01,
+  9.73992962167975928622e-01,
+  9.74339382785595731207e-01,
+  9.74683510688530541088e-01,
+  9.75025345067013882172e-01,
+  9.75364885116676516574e-01,
+  9.75702130038547998936e-01,
+  9.76037079039058452778e-01,
+  9.76369731330040457884e-01,
+  9.76700086128730937673e-01,
+  9.77028142657773379653e-01,
+  9.77353900145218945639e-01,
+  9.77677357824528803221e-01,
+  9.77998514934575791102e-01,
+  9.78317370719646195454e-01,
+  9.78633924429441637294e-01,
+  9.78948175319080515777e-01,
+  9.79260122649100228642e-01,
+  9.79569765685458615501e-01,
+  9.79877103699535623171e-01,
+  9.80182135968135304083e-01,
+  9.80484861773487148540e-01,
+  9.80785280403248083125e-01,
+  9.81083391150504247058e-01,
+  9.81379193313771991392e-01,
+  9.81672686197000432529e-01,
+  9.81963869109572451421e-01,
+  9.82252741366306469928e-01,
+  9.82539302287458227170e-01,
+  9.82823551198722111799e-01,
+  9.83105487431233049378e-01,
+  9.83385110321567834646e-01,
+  9.83662419211746796854e-01,
+  9.83937413449235243057e-01,
+  9.84210092386945345488e-01,
+  9.84480455383237029743e-01,
+  9.84748501801920195220e-01,
+  9.85014231012255714326e-01,
+  9.85277642388956986785e-01,
+  9.85538735312191715998e-01,
+  9.85797509167582908240e-01,
+  9.86053963346210871066e-01,
+  9.86308097244613879440e-01,
+  9.86559910264790618228e-01,
+  9.86809401814200515268e-01,
+  9.87056571305765961810e-01,
+  9.87301418157873089676e-01,
+  9.87543941794373880683e-01,
+  9.87784141644586721753e-01,
+  9.88022017143297959230e-01,
+  9.88257567730763786251e-01,
+  9.88490792852710797867e-01,
+  9.88721691960337767391e-01,
+  9.88950264510316867650e-01,
+  9.89176509964794670182e-01,
+  9.89400427791394032617e-01,
+  9.89622017463214320721e-01,
+  9.89841278458833850884e-01,
+  9.90058210262310334215e-01,
+  9.90272812363182208806e-01,
+  9.90485084256470083020e-01,
+  9.90695025442677512650e-01,
+  9.90902635427792777278e-01,
+  9.91107913723289435382e-01,
+  9.91310859846127878647e-01,
+  9.91511473318756220152e-01,
+  9.91709753669111737651e-01,
+  9.91905700430621428687e-01,
+  9.92099313142203675930e-01,
+  9.92290591348269135352e-01,
+  9.92479534598721624405e-01,
+  9.92666142448959565314e-01,
+  9.92850414459876540185e-01,
+  9.93032350197862623276e-01,
+  9.93211949234805713260e-01,
+  9.93389211148091644255e-01,
+  9.93564135520606184215e-01,
+  9.93736721940735368008e-01,
+  9.93906970002366607631e-01,
+  9.94074879304889913456e-01,
+  9.94240449453198227303e-01,
+  9.94403680057689309812e-01,
+  9.94564570734265518404e-01,
+  9.94723121104335694653e-01,
+  9.94879330794815386341e-01,
+  9.95033199438128290737e-01,
+  9.95184726672206365627e-01,
+  9.95333912140491605669e-01,
+  9.95480755491936153412e-01,
+  9.95625256381003409523e-01,
+  9.95767414467668698919e-01,
+  9.95907229417420492013e-01,
+  9.96044700901260626758e-01,
+  9.96179828595705418870e-01,
+  9.96312612182786438986e-01,
+  9.96443051350050845727e-01,
+  9.96571145790562940014e-01,
+  9.96696895202904054045e-01,
+  9.96820299291173550493e-01,
+  9.96941357764989821710e-01,
+  9.97060070339490511770e-01,
+  9.97176436735333515671e-01,
+  9.97290456678697423420e-01,
+  9.97402129901282408220e-01,
+  9.97511456140310448504e-01,
+  9.97618435138526327144e-01,
+  9.97723066644198297581e-01,
+  9.97825350411118194849e-01,
+  9.97925286198602434773e-01,
+  9.98022873771492458062e-01,
+  9.98118112900155285416e-01,
+  9.98211003360484072644e-01,
+  9.98301544933898665768e-01,
+  9.98389737407345823073e-01,
+  9.98475580573300214304e-01,
+  9.98559074229764642716e-01,
+  9.98640218180270378134e-01,
+  9.98719012233877934115e-01,
+  9.98795456205177289988e-01,
+  9.98869549914288334946e-01,
+  9.98941293186861423159e-01,
+  9.99010685854077817858e-01,
+  9.99077727752649691340e-01,
+  9.99142418724821124165e-01,
+  9.99204758618367883116e-01,
+  9.99264747286598309373e-01,
+  9.99322384588353207491e-01,
+  9.99377670388006400515e-01,
+  9.99430604555465174066e-01,
+  9.99481186966170276342e-01,
+  9.99529417501096251186e-01,
+  9.99575296046752215240e-01,
+  9.99618822495181413856e-01,
+  9.99659996743961887233e-01,
+  9.99698818696206692458e-01,
+  9.99735288260564014529e-01,
+  9.99769405351217499422e-01,
+  9.99801169887886254095e-01,
+  9.99830581795825290570e-01,
+  9.99857641005825525937e-01,
+  9.99882347454214115423e-01,
+  9.99904701082854230343e-01,
+  9.99924701839145835258e-01,
+  9.99942349676025021843e-01,
+  9.99957644551964786039e-01,
+  9.99970586430974917036e-01,
+  9.99981175282601775223e-01,
+  9.99989411081928847302e-01,
+  9.99995293809576524247e-01,
+  9.99998823451702101295e-01,
+  1.00000000000000000000e+00,
+  9.99998823451701768228e-01,
+  9.99995293809575858113e-01,
+  9.99989411081927848102e-01,
+  9.99981175282600553977e-01,
+  9.99970586430973362724e-01,
+  9.99957644551962898660e-01,
+  9.99942349676022801397e-01,
+  9.99924701839143281745e-01,
+  9.99904701082851454785e-01,
+  9.99882347454210895776e-01,
+  9.99857641005822084246e-01,
+  9.99830581795821515811e-01,
+  9.99801169887882146270e-01,
+  9.99769405351213058530e-01,
+  9.99735288260559351592e-01,
+  9.99698818696201585432e-01,
+  9.99659996743956447141e-01,
+  9.99618822495175640697e-01,
+  9.99575296046746220036e-01,
+  9.99529417501089922915e-01,
+  9.99481186966163615004e-01,
+  9.99430604555458179661e-01,
+  9.99377670387999184065e-01,
+  9.99322384588345546952e-01,
+  9.99264747286590426789e-01,
+  9.99204758618359667466e-01,
+  9.99142418724812575448e-01,
+  9.99077727752640809555e-01,
+  9.99010685854068603007e-01,
+  9.98941293186851986263e-01,
+  9.98869549914278564984e-01,
+  9.98795456205167186958e-01,
+  9.98719012233867498018e-01,
+  9.98640218180259608971e-01,
+  9.98559074229753540486e-01,
+  9.98475580573288890029e-01,
+  9.98389737407334054708e-01,
+  9.98301544933886564337e-01,
+  9.98211003360471749168e-01,
+  9.98118112900142628874e-01,
+  9.98022873771479468452e-01,
+  9.97925286198589112097e-01,
+  9.97825350411104539106e-01,
+  9.97723066644184308771e-01,
+  9.97618435138512116289e-01,
+  9.97511456140295793560e-01,
+  9.97402129901267531231e-01,
+  9.97290456678682213365e-01,
+  9.97176436735317972548e-01,
+  9.97060070339474635581e-01,
+  9.96941357764973612454e-01,
+  9.96820299291157008170e-01,
+  9.96696895202887178655e-01,
+  9.96571145790545842580e-01,
+  9.96443051350033415225e-01,
+  9.96312612182768675417e-01,
+  9.96179828595687433257e-01,
+  9.96044700901242308078e-01,
+  9.95907229417401840266e-01,
+  9.95767414467649714105e-01,
+  9.95625256380984091642e-01,
+  9.95480755491916502464e-01,
+  9.95333912140471732677e-01,
+  9.95184726672186159568e-01,
+  9.95033199438107640589e-01,
+  9.94879330794794514148e-01,
+  9.94723121104314489394e-01,
+  9.94564570734243980077e-01,
+  9.94403680057667438419e-01,
+  9.94240449453176133865e-01,
+  9.94074879304867375929e-01,
+  9.93906970002343848059e-01,
+  9.93736721940712275369e-01,
+  9.93564135520582758510e-01,
+  9.93389211148067885482e-01,
+  9.93211949234781621421e-01,
+  9.93032350197838309391e-01,
+  9.92850414459851782212e-01,
+  9.92666142448934585296e-01,
+  9.92479534598696311321e-01,
+  9.92290591348243489200e-01,
+  9.92099313142177696712e-01,
+  9.91905700430595116401e-01,
+  9.91709753669085203320e-01,
+  9.91511473318729352755e-01,
+  9.91310859846100678183e-01,
+  9.91107913723261901850e-01,
+  9.90902635427764910681e-01,
+  9.90695025442649312986e-01,
+  9.90485084256441550288e-01,
+  9.90272812363153454029e-01,
+  9.90058210262281246372e-01,
+  9.89841278458804429974e-01,
+  9.89622017463184566743e-01,
+  9.89400427791363945573e-01,
+  9.89176509964764361094e-01,
+  9.88950264510286225494e-01,
+  9.88721691960306792168e-01,
+  9.88490792852679489577e-01,
+  9.88257567730732144895e-01,
+  9.88022017143265984807e-01,
+  9.87784141644554414263e-01,
+  9.87543941794341351148e-01,
+  9.87301418157840227074e-01,
+  9.87056571305732766142e-01,
+  9.86809401814166986533e-01,
+  9.86559910264756756426e-01,
+  9.86308097244579795593e-01,
+  9.86053963346176343130e-01,
+  9.85797509167548158260e-01,
+  9.85538735312156632951e-01,
+  9.85277642388921570671e-01,
+  9.85014231012219965145e-01,
+  9.84748501801884223994e-01,
+  9.84480455383200725450e-01,
+  9.84210092386908708129e-01,
+  9.83937413449198383653e-01,
+  9.83662419211709493361e-01,
+  9.83385110321530198085e-01,
+  9.83105487431195190773e-01,
+  9.82823551198683920127e-01,
+  9.82539302287419702431e-01,
+  9.82252741366267612122e-01,
+  9.81963869109533371571e-01,
+  9.81672686196961019611e-01,
+  9.81379193313732245407e-01,
+  9.81083391150464168007e-01,
+  9.80785280403207782030e-01,
+  9.80484861773446403355e-01,
+  9.80182135968094336853e-01,
+  9.79877103699494322875e-01,
+  9.79569765685417093160e-01,
+  9.79260122649058373234e-01,
+  9.78948175319038327302e-01,
+  9.78633924429399004730e-01,
+  9.78317370719603340845e-01,
+  9.77998514934532603426e-01,
+  9.77677357824485282478e-01,
+  9.77353900145175202852e-01,
+  9.77028142657729303799e-01,
+  9.76700086128686528752e-01,
+  9.76369731329995715896e-01,
+  9.76037079039013377724e-01,
+  9.75702130038502701836e-01,
+  9.75364885116630886408e-01,
+  9.75025345066967918939e-01,
+  9.74683510688484244788e-01,
+  9.74339382785549212862e-01,
+  9.73992962167928966188e-01,
+  9.73644249650784887606e-01,
+  9.73293246054670935230e-01,
+  9.72939952205532643248e-01,
+  9.72584368934704568410e-01,
+  9.72226497078908513672e-01,
+  9.71866337480251307746e-01,
+  9.71503890986223472837e-01,
+  9.71139158449696671127e-01,
+  9.70772140728921706376e-01,
+  9.70402838687526636541e-01,
+  9.70031253194514886395e-01,
+  9.69657385124263249132e-01,
+  9.69281235356518999779e-01,
+  9.68902804776399229070e-01,
+  9.68522094274387401747e-01,
+  9.68139104746332357365e-01,
+  9.67753837093445201667e-01,
+  9.67366292222298085335e-01,
+  9.66976471044821428436e-01,
+  9.66584374478302255085e-01,
+  9.66190003445381417890e-01,
+  9.65793358874052376706e-01,
+  9.65394441697657867962e-01,
+  9.64993252854888683423e-01,
+  9.64589793289780783603e-01,
+  9.64184063951713632434e-01,
+  9.63776065795407532732e-01,
+  9.63365799780921516771e-01,
+  9.62953266873651125834e-01,
+  9.62538468044326189776e-01,
+  9.62121404269008495547e-01,
+  9.61702076529089122658e-01,
+  9.61280485811286999898e-01,
+  9.60856633107645796699e-01,
+  9.60430519415531813721e-01,
+  9.60002145737631651379e-01,
+  9.59571513081950100421e-01,
+  9.59138622461807366371e-01,
+  9.58703474895836738057e-01,
+  9.58266071407982589214e-01,
+  9.57826413027497602926e-01,
+  9.57384500788940440152e-01,
+  9.56940335732173186223e-01,
+  9.56493918902359241407e-01,
+  9.56045251349960323317e-01,
+  9.55594334130734801569e-01,
+  9.55141168305734256094e-01,
+  9.54685754941301589760e-01,
+  9.54228095109068696900e-01,
+  9.53768189885953243667e-01,
+  9.53306040354156447592e-01,
+  9.52841647601161079173e-01,
+  9.52375012719728131216e-01,
+  9.51906136807894376339e-01,
+  9.51435020968970146527e-01,
+  9.50961666311536668594e-01,
+  9.50486073949443177611e-01,
+  9.50008245001804141339e-01,
+  9.49528180592997594900e-01,
+  9.49045881852661366018e-01,
+  9.48561349915690854573e-01,
+  9.48074585922236590108e-01,
+  9.47585591017701234229e-01,
+  9.47094366352737138115e-01,
+  9.46600913083243233892e-01,
+  9.46105232370362814187e-01,
+  9.45607325380480534527e-01,
+  9.45107193285219637779e-01,
+  9.44604837261439067575e-01,
+  9.44100258491231247859e-01,
+  9.43593458161918752225e-01,
+  9.43084437466051639376e-01,
+  9.42573197601404788593e-01,
+  9.42059739770975124173e-01,
+  9.41544065182978284767e-01,
+  9.41026175050846624970e-01,
+  9.40506070593225440568e-01,
+  9.39983753033970859114e-01,
+  9.39459223602146620280e-01,
+  9.38932483532020967232e-01,
+  9.38403534063064315163e-01,
+  9.37872376439945809601e-01,
+  9.37339011912530772896e-01,
+  9.36803441735877151508e-01,
+  9.36265667170233628624e-01,
+  9.35725689481035516337e-01,
+  9.35183509938902535197e-01,
+  9.34639129819635483543e-01,
+  9.34092550404213350923e-01,
+  9.33543772978790431516e-01,
+  9.32992798834692882437e-01,
+  9.32439629268416170227e-01,
+  9.31884265581621629160e-01,
+  9.31326709081133907731e-01,
+  9.30766961078936860829e-01,
+  9.30205022892171995430e-01,
+  9.29640895843134029697e-01,
+  9.29074581259268339473e-01,
+  9.28506080473167849654e-01,
+  9.27935394822569925566e-01,
+  9.27362525650352931272e-01,
+  9.26787474304533454017e-01,
+  9.26210242138262751510e-01,
+  9.25630830509823865349e-01,
+  9.25049240782628623414e-01,
+  9.24465474325213421025e-01,
+  9.23879532511237222536e-01,
+  9.23291416719478008623e-01,
+  9.22701128333828668460e-01,
+  9.22108668743295001313e-01,
+  9.21514039341991497700e-01,
+  9.20917241529138896894e-01,
+  9.20318276709059746032e-01,
+  9.19717146291176290696e-01,
+  9.19113851690006478101e-01,
+  9.18508394325160737459e-01,
+  9.17900775621338760324e-01,
+  9.17290997008325947881e-01,
+  9.16679059920990524368e-01,
+  9.16064965799279318226e-01,
+  9.15448716088215208586e-01,
+  9.14830312237893239491e-01,
+  9.14209755703477622291e-01,
+  9.13587047945197516796e-01,
+  9.12962190428344588788e-01,
+  9.12335184623269013215e-01,
+  9.11706032005375921479e-01,
+  9.11074734055122181786e-01,
+  9.10441292258012735417e-01,
+  9.09805708104597710140e-01,
+  9.09167983090467535234e-01,
+  9.08528118716251054110e-01,
+  9.07886116487610861370e-01,
+  9.07241977915240305208e-01,
+  9.06595704514859490608e-01,
+  9.05947297807212503784e-01,
+  9.05296759318062638222e-01,
+  9.04644090578189730145e-01,
+  9.03989293123386716822e-01,
+  9.03332368494454862606e-01,
+  9.02673318237201649517e-01,
+  9.02012143902435781229e-01,
+  9.01348847045964518543e-01,
+  9.00683429228589127469e-01,
+  9.00015892016102214690e-01,
+  8.99346236979283286672e-01,
+  8.98674465693895307972e-01,
+  8.98000579740681037499e-01,
+  8.97324580705359253763e-01,
+  8.96646470178620980107e-01,
+  8.95966249756125820980e-01,
+  8.95283921038497965128e-01,
+  8.94599485631322854928e-01,
+  8.93912945145143189585e-01,
+  8.93224301195454928326e-01,
+  8.92533555402703959736e-01,
+  8.91840709392281882906e-01,
+  8.91145764794522343699e-01,
+  8.90448723244696704882e-01,
+  8.89749586383011381585e-01,
+  8.89048355854602845305e-01,
+  8.88345033309534404253e-01,
+  8.87639620402791762466e-01,
+  8.86932118794279689133e-01,
+  8.86222530148818132822e-01,
+  8.85510856136137114447e-01,
+  8.84797098430874728869e-01,
+  8.84081258712571704805e-01,
+  8.83363338665668074157e-01,
+  8.82643339979498953163e-01,
+  8.81921264348290989687e-01,
+  8.81197113471157700282e-01,
+  8.80470889052096361560e-01,
+  8.79742592799982792151e-01,
+  8.79012226428568577141e-01,
+  8.78279791656476294115e-01,
+  8.77545290207195849419e-01,
+  8.76808723809080037270e-01,
+  8.76070094195340653975e-01,
+  8.75329403104044834194e-01,
+  8.74586652278109832892e-01,
+  8.73841843465300360805e-01,
+  8.73094978418223366390e-01,
+  8.72346058894324483113e-01,
+  8.71595086655883699578e-01,
+  8.70842063470011362725e-01,
+  8.70086991108643625914e-01,
+  8.69329871348538896214e-01,
+  8.68570705971272727375e-01,
+  8.67809496763234822225e-01,
+  8.67046245515624036670e-01,
+  8.66280954024444049821e-01,
+  8.65513624090499922303e-01,
+  8.64744257519392878208e-01,
+  8.63972856121517196470e-01,
+  8.63199421712054437705e-01,
+  8.62423956110970557631e-01,
+  8.61646461143011022088e-01,
+  8.60866938637696699210e-01,
+  8.60085390429319307515e-01,
+  8.59301818356937308074e-01,
+  8.58516224264371685670e-01,
+  8.57728610000200730745e-01,
+  8.56938977417757041799e-01,
+  8.56147328375122529387e-01,
+  8.55353664735123864205e-01,
+  8.54557988365328036195e-01,
+  8.53760301138038690816e-01,
+  8.52960604930290688941e-01,
+  8.52158901623846776197e-01,
+  8.51355193105191809799e-01,
+  8.50549481265529871976e-01,
+  8.49741768000778718850e-01,
+  8.48932055211565561592e-01,
+  8.48120344803222847574e-01,
+  8.47306638685783708453e-01,
+  8.46490938773977408260e-01,
+  8.45673246987224125348e-01,
+  8.44853565249631843770e-01,
+  8.44031895489990913184e-01,
+  8.43208239641769718986e-01,
+  8.42382599643109908349e-01,
+  8.41554977436822171377e-01,
+  8.40725374970381689188e-01,
+  8.39893794195922915868e-01,
+  8.39060237070235803714e-01,
+  8.38224705554760918247e-01,
+  8.37387201615584553238e-01,
+  8.36547727223434289812e-01,
+  8.35706284353674666576e-01,
+  8.34862874986301850555e-01,
+  8.34017501105939862427e-01,
+  8.33170164701834692345e-01,
+  8.32320867767850858243e-01,
+  8.31469612302466187792e-01,
+  8.30616400308767044436e-01,
+  8.29761233794443442413e-01,
+  8.28904114771785049953e-01,
+  8.28045045257675860206e-01,
+  8.27184027273588973195e-01,
+  8.26321062845583043099e-01,
+  8.25456154004296838167e-01,
+  8.24589302784944355729e-01,
+  8.23720511227310159263e-01,
+  8.22849781375744826484e-01,
+  8.21977115279159731287e-01,
+  8.21102514991022935931e-01,
+  8.20225982569352640716e-01,
+  8.19347520076714630477e-01,
+  8.18467129580216057327e-01,
+  8.17584813151500777728e-01,
+  8.16700572866744689549e-01,
+  8.15814410806650402996e-01,
+  8.14926329056443132792e-01,
+  8.14036329705864591944e-01,
+  8.13144414849169550052e-01,
+  8.12250586585119616068e-01,
+  8.11354847016979241481e-01,
+  8.10457198252509947167e-01,
+  8.09557642403966215561e-01,
+  8.08656181588089939538e-01,
+  8.07752817926104982327e-01,
+  8.06847553543713624791e-01,
+  8.05940390571090348182e-01,
+  8.05031331142877393248e-01,
+  8.04120377398179320139e-01,
+  8.03207531480558123427e-01,
+  8.02292795538028680191e-01,
+  8.01376171723053198903e-01,
+  8.00457662192535446266e-01,
+  7.99537269107817416547e-01,
+  7.98614994634673003304e-01,
+  7.97690840943303003385e-01,
+  7.96764810208330342967e-01,
+  7.95836904608794859506e-01,
+  7.94907126328148305738e-01,
+  7.93975477554248243450e-01,
+  7.93041960479354379743e-01,
+  7.92106577300122793872e-01,
+  7.91169330217600386135e-01,
+  7.90230221437219992886e-01,
+  7.89289253168795279514e-01,
+  7.88346427626515855458e-01,
+  7.87401747028940723894e-01,
+  7.86455213598994840041e-01,
+  7.85506829563962782892e-01,
+  7.84556597155483759209e-01,
+  7.83604518609546496499e-01,
+  7.82650596166483691896e-01,
+  7.81694832070967127180e-01,
+  7.80737228572002117666e-01,
+  7.79777787922921850061e-01,
+  7.78816512381383052599e-01,
+  7.77853404209359999832e-01,
+  7.76888465673139072543e-01,
+  7.75921699043313872757e-01,
+  7.74953106594779894678e-01,
+  7.73982690606728862548e-01,
+  7.73010453362642735442e-01,
+  7.72036397150289932512e-01,
+  7.71060524261719004713e-01,
+  7.70082836993252861646e-01,
+  7.69103337645484219642e-01,
+  7.68122028523269717581e-01,
+  7.67138911935724476798e-01,
+  7.66153990196216994057e-01,
+  7.65167265622362702260e-01,
+  7.64178740536020195684e-01,
+  7.63188417263284568648e-01,
+  7.62196298134481864395e-01,
+  7.61202385484164523177e-01,
+  7.60206681651104831943e-01,
+  7.59209188978290483441e-01,
+  7.58209909812917359773e-01,
+  7.57208846506386423769e-01,
+  7.56206001414296058449e-01,
+  7.55201376896437848174e-01,
+  7.54194975316790139352e-01,
+  7.53186799043513266483e-01,
+  7.52176850448943445926e-01,
+  7.51165131909586891723e-01,
+  7.50151645806115263682e-01,
+  7.49136394523359228081e-01,
+  7.48119380450303239627e-01,
+  7.47100605980079435220e-01,
+  7.46080073509962860001e-01,
+  7.45057785441364694989e-01,
+  7.44033744179828038234e-01,
+  7.43007952135020244278e-01,
+  7.41980411720729260416e-01,
+  7.40951125354857076388e-01,
+  7.39920095459413840189e-01,
+  7.38887324460512529001e-01,
+  7.37852814788363065013e-01,
+  7.36816568877266986348e-01,
+  7.35778589165610341638e-01,
+  7.34738878095860026285e-01,
+  7.33697438114556566013e-01,
+  7.32654271672308787799e-01,
+  7.31609381223788268755e-01,
+  7.30562769227723007859e-01,
+  7.29514438146892429948e-01,
+  7.28464390448120391319e-01,
+  7.27412628602270627809e-01,
+  7.26359155084240648570e-01,
+  7.25303972372955074732e-01,
+  7.24247082951360976466e-01,
+  7.23188489306421211644e-01,
+  7.22128193929108763705e-01,
+  7.21066199314401634624e-01,
+  7.20002507961274851311e-01,
+  7.18937122372697356987e-01,
+  7.17870045055624350638e-01,
+  7.16801278520991846932e-01,
+  7.15730825283710792029e-01,
+  7.14658687862660846335e-01,
+  7.13584868780685499523e-01,
+  7.12509370564583854879e-01,
+  7.11432195745107742724e-01,
+  7.10353346856953393740e-01,
+  7.09272826438756331946e-01,
+  7.08190637033085712559e-01,
+  7.07106781186437660658e-01,
+  7.06021261449229942109e-01,
+  7.04934080375794858142e-01,
+  7.03845240524374582414e-01,
+  7.02754744457114610690e-01,
+  7.01662594740057543596e-01,
+  7.00568793943137091418e-01,
+  6.99473344640172300934e-01,
+  6.98376249408861116130e-01,
+  6.97277510830774827078e-01,
+  6.96177131491350964509e-01,
+  6.95075113979888525861e-01,
+  6.93971460889541424955e-01,
+  6.92866174817311830658e-01,
+  6.91759258364044615774e-01,
+  6.90650714134421139789e-01,
+  6.89540544736953475713e-01,
+  6.88428752783976749541e-01,
+  6.87315340891645143451e-01,
+  6.86200311679924346286e-01,
+  6.85083667772585891420e-01,
+  6.83965411797200606436e-01,
+  6.82845546385132950995e-01,
+  6.81724074171534355493e-01,
+  6.80600997795337669949e-01,
+  6.79476319899249392442e-01,
+  6.78350043129745561288e-01,
+  6.77222170137064205520e-01,
+  6.76092703575199460708e-01,
+  6.74961646101895240690e-01,
+  6.73829000378639020319e-01,
+  6.72694769070655951282e-01,
+  6.71558954846901090541e-01,
+  6.70421560380055514550e-01,
+  6.69282588346518214628e-01,
+  6.68142041426400434823e-01,
+  6.66999922303519121591e-01,
+  6.65856233665391039622e-01,
+  6.64710978203226221517e-01,
+  6.63564158611920862363e-01,
+  6.62415777590052545776e-01,
+  6.61265837839872694381e-01,
+  6.60114342067300685635e-01,
+  6.58961292981917301503e-01,
+  6.57806693296958289174e-01,
+  6.56650545729308365850e-01,
+  6.55492852999494779453e-01,
+  6.54333617831679648091e-01,
+  6.53172842953655630183e-01,
+  6.52010531096838152898e-01,
+  6.50846684996259194911e-01,
+  6.49681307390561180171e-01,
+  6.48514401021990205543e-01,
+  6.47345968636389823558e-01,
+  6.46176012983193825967e-01,
+  6.45004536815421247731e-01,
+  6.43831542889668373419e-01,
+  6.42657033966103519163e-01,
+  6.41481012808459483132e-01,
+  6.40303482184027772384e-01,
+  6.39124444863651941517e-01,
+  6.37943903621719932140e-01,
+  6.36761861236159854016e-01,
+  6.35578320488431436353e-01,
+  6.34393284163520476682e-01,
+  6.33206755049931957480e-01,
+  6.32018735939683495850e-01,
+  6.30829229628298682186e-01,
+  6.29638238914801307011e-01,
+  6.28445766601706701238e-01,
+  6.27251815495017850388e-01,
+  6.26056388404216956900e-01,
+  6.24859488142259444921e-01,
+  6.23661117525567409992e-01,
+  6.22461279374022513622e-01,
+  6.21259976510960210128e-01,
+  6.20057211763161530982e-01,
+  6.18852987960848421878e-01,
+  6.17647307937675749123e-01,
+  6.16440174530725082391e-01,
+  6.15231590580498033383e-01,
+  6.14021558930909372442e-01,
+  6.12810082429280367222e-01,
+  6.11597163926332676454e-01,
+  6.10382806276179912253e-01,
+  6.09167012336323310251e-01,
+  6.07949784967643513944e-01,
+  6.06731127034394135400e-01,
+  6.05511041404194871873e-01,
+  6.04289530948025066515e-01,
+  6.03066598540217269075e-01,
+  6.01842247058448909236e-01,
+  6.00616479383737522646e-01,
+  5.99389298400432868341e-01,
+  5.98160706996210267405e-01,
+  5.96930708062064163677e-01,
+  5.95699304492300796277e-01,
+  5.94466499184531982358e-01,
+  5.93232295039667012482e-01,
+  5.91996694961907876653e-01,
+  5.90759701858740937652e-01,
+  5.89521318640930269694e-01,
+  5.88281548222511441182e-01,
+  5.87040393520783854164e-01,
+  5.85797857456304416068e-01,
+  5.84553942952880878359e-01,
+  5.83308652937563620888e-01,
+  5.82061990340640655894e-01,
+  5.80813958095629301326e-01,
+  5.79564559139270296662e-01,
+  5.78313796411519809304e-01,
+  5.77061672855543439375e-01,
+  5.75808191417709336335e-01,
+  5.74553355047579539239e-01,
+  5.73297166697905646870e-01,
+  5.72039629324620269024e-01,
+  5.70780745886830254143e-01,
+  5.69520519346809805938e-01,
+  5.68258952669993933071e-01,
+  5.66996048824971121682e-01,
+  5.65731810783475341786e-01,
+  5.64466241520381384333e-01,
+  5.63199344013695757383e-01,
+  5.61931121244550801919e-01,
+  5.60661576197197142335e-01,
+  5.59390711858996914074e-01,
+  5.58118531220416658201e-01,
+  5.56845037275020660061e-01,
+  5.55570233019462511592e-01,
+  5.54294121453480115314e-01,
+  5.53016705579887246635e-01,
+  5.51737988404566892520e-01,
+  5.50457972936464035030e-01,
+  5.49176662187578656926e-01,
+  5.47894059172959191351e-01,
+  5.46610166910693640041e-01,
+  5.45324988421904910396e-01,
+  5.44038526730742044712e-01,
+  5.42750784864373780891e-01,
+  5.41461765852981113945e-01,
+  5.40171472729750301589e-01,
+  5.38879908530865536775e-01,
+  5.37587076295502730439e-01,
+  5.36292979065820074602e-01,
+  5.34997619886953823531e-01,
+  5.33701001807009300926e-01,
+  5.32403127877054016537e-01,
+  5.31104001151110782786e-01,
+  5.29803624686150165246e-01,
+  5.28502001542084154373e-01,
+  5.27199134781756728607e-01,
+  5.25895027470939746550e-01,
+  5.24589682678323732112e-01,
+  5.23283103475510991132e-01,
+  5.21975292937008616967e-01,
+  5.20666254140221163027e-01,
+  5.19355990165443648365e-01,
+  5.18044504095853231007e-01,
+  5.16731799017503434790e-01,
+  5.15417878019316266780e-01,
+  5.14102744193074778778e-01,
+  5.12786400633415739847e-01,
+  5.11468850437822863952e-01,
+  5.10150096706618927378e-01,
+  5.08830142542959329433e-01,
+  5.07508991052822877599e-01,
+  5.06186645345007013574e-01,
+  5.04863108531119042510e-01,
+  5.03538383725568805538e-01,
+  5.02212474045561685365e-01,
+  5.00885382611091500848e-01,
+  4.99557112544932679921e-01,
+  4.98227666972632377007e-01,
+  4.96897049022504755378e-01,
+  4.95565261825622493941e-01,
+  4.94232308515809404259e-01,
+  4.92898192229633436146e-01,
+  4.91562916106399072635e-01,
+  4.90226483288140391092e-01,
+  4.88888896919612181424e-01,
+  4.87550160148284672523e-01,
+  4.86210276124334872527e-01,
+  4.84869248000639296858e-01,
+  4.83527078932766640751e-01,
+  4.82183772078970396269e-01,
+  4.80839330600181358299e-01,
+  4.79493757660000519127e-01,
+  4.78147056424690297671e-01,
+  4.76799230063169099392e-01,
+  4.75450281747002601040e-01,
+  4.74100214650396423188e-01,
+  4.72749031950188969287e-01,
+  4.71396736825843543084e-01,
+  4.70043332459441631777e-01,
+  4.68688822035673691158e-01,
+  4.67333208741833927569e-01,
+  4.65976495767811360604e-01,
+  4.64618686306082773196e-01,
+  4.63259783551704884541e-01,
+  4.61899790702307133650e-01,
+  4.60538710958084129832e-01,
+  4.59176547521788380735e-01,
+  4.57813303598721188514e-01,
+  4.56448982396727653832e-01,
+  4.55083587126187294469e-01,
+  4.53717121000007050924e-01,
+  4.52349587233613792403e-01,
+  4.50980989044946545263e-01,
+  4.49611329654449387583e-01,
+  4.48240612285062456355e-01,
+  4.46868840162216451883e-01,
+  4.45496016513823756000e-01,
+  4.44122144570270938058e-01,
+  4.42747227564411482970e-01,
+  4.41371268731557908627e-01,
+  4.39994271309474549447e-01,
+  4.38616238538368730104e-01,
+  4.37237173660884881343e-01,
+  4.35857079922096046776e-01,
+  4.34475960569496000296e-01,
+  4.33093818852991974122e-01,
+  4.31710658024896998253e-01,
+  4.30326481339922128910e-01,
+  4.28941292055169121067e-01,
+  4.27555093430121435638e-01,
+  4.26167888726638743879e-01,
+  4.24779681208947657023e-01,
+  4.23390474143634620852e-01,
+  4.22000270799637977603e-01,
+  4.20609074448240582988e-01,
+  4.19216888363062145650e-01,
+  4.17823715820050234360e-01,
+  4.16429560097474837921e-01,
+  4.15034424475919039299e-01,
+  4.13638312238271688148e-01,
+  4.12241226669719795783e-01,
+  4.10843171057740597085e-01,
+  4.09444148692094389563e-01,
+  4.08044162864815207481e-01,
+  4.06643216870205270741e-01,
+  4.05241314004825881057e-01,
+  4.03838457567489872435e-01,
+  4.02434650859253950639e-01,
+  4.01029897183410866113e-01,
+  3.99624199845481808957e-01,
+  3.98217562153208692877e-01,
+  3.96809987416545162375e-01,
+  3.95401478947650930618e-01,
+  3.93992040060882453556e-01,
+  3.92581674072785602458e-01,
+  3.91170384302087725814e-01,
+  3.89758174069690044306e-01,
+  3.88345046698659990270e-01,
+  3.86931005514222048358e-01,
+  3.85516053843752093400e-01,
+  3.84100195016768009015e-01,
+  3.82683432364922471169e-01,
+  3.81265769221994843541e-01,
+  3.79847208923883350451e-01,
+  3.78427754808597915925e-01,
+  3.77007410216250338220e-01,
+  3.75586178489049071771e-01,
+  3.74164062971289568260e-01,
+  3.72741067009347115668e-01,
+  3.71317193951668622631e-01,
+  3.69892447148764957898e-01,
+  3.68466829953202901216e-01,
+  3.67040345719597926877e-01,
+  3.65612997804604378249e-01,
+  3.64184789566910138703e-01,
+  3.62755724367227194715e-01,
+  3.61325805568284030844e-01,
+  3.59895036534817636120e-01,
+  3.58463420633565787998e-01,
+  3.57030961233259391818e-01,
+  3.55597661704613043909e-01,
+  3.54163525420319258430e-01,
+  3.52728555755039363540e-01,
+  3.51292756085395507792e-01,
+  3.49856129789963055110e-01,
+  3.48418680249262480153e-01,
+  3.46980410845751319204e-01,
+  3.45541324963816842697e-01,
+  3.44101425989766396274e-01,
+  3.42660717311821683140e-01,
+  3.41219202320109438187e-01,
+  3.39776884406653656434e-01,
+  3.38333766965367710444e-01,
+  3.36889853392046356717e-01,
+  3.35445147084358130662e-01,
+  3.33999651441835632149e-01,
+  3.32553369865870251942e-01,
+  3.31106305759702124192e-01,
+  3.29658462528413020998e-01,
+  3.28209843578917803697e-01,
+  3.26760452319956817835e-01,
+  3.25310292162088121604e-01,
+  3.23859366517677826902e-01,
+  3.22407678800894548221e-01,
+  3.20955232427699688191e-01,
+  3.19502030815839888067e-01,
+  3.18048077384838923098e-01,
+  3.16593375555989597903e-01,
+  3.15137928752345863881e-01,
+  3.13681740398715158680e-01,
+  3.12224813921648358672e-01,
+  3.10767152749434671932e-01,
+  3.09308760312091646227e-01,
+  3.07849640041357563991e-01,
+  3.06389795370683393205e-01,
+  3.04929229735224627262e-01,
+  3.03467946571833679936e-01,
+  3.02005949319050226443e-01,
+  3.00543241417095374768e-01,
+  2.99079826307862173262e-01,
+  2.97615707434907672546e-01,
+  2.96150888243445042924e-01,
+  2.94685372180335303227e-01,
+  2.93219162694079771292e-01,
+  2.91752263234810182979e-01,
+  2.90284677254283030035e-01,
+  2.88816408205869901149e-01,
+  2.87347459544549710397e-01,
+  2.85877834726900537099e-01,
+  2.84407537211091576701e-01,
+  2.82936570456874814106e-01,
+  2.81464937925577640687e-01,
+  2.79992643080092695751e-01,
+  2.78519689384872315419e-01,
+  2.77046080305918873687e-01,
+  2.75571819310776899847e-01,
+  2.74096909868524862830e-01,
+  2.72621355449767233114e-01,
+  2.71145159526626489122e-01,
+  2.69668325572733347251e-01,
+  2.68190857063221155254e-01,
+  2.66712757474716122275e-01,
+  2.65234030285329325238e-01,
+  2.63754678974648659739e-01,
+  2.62274707023730679900e-01,
+  2.60794117915092327209e-01,
+  2.59312915132703269983e-01,
+  2.57831102161975800335e-01,
+  2.56348682489759449599e-01,
+  2.54865659604330885291e-01,
+  2.53382036995386250577e-01,
+  2.51897818154032837601e-01,
+  2.50413006572780927339e-01,
+  2.48927605745536018045e-01,
+  2.47441619167588916506e-01,
+  2.45955050335609992640e-01,
+  2.44467902747639326266e-01,
+  2.42980179903078824522e-01,
+  2.41491885302684033965e-01,
+  2.40003022448555952684e-01,
+  2.38513594844133119954e-01,
+  2.37023605994181651990e-01,
+  2.35533059404789718583e-01,
+  2.34041958583357412316e-01,
+  2.32550307038589004760e-01,
+  2.31058108280484675312e-01,
+  2.29565365820332212277e-01,
+  2.28072083170698852728e-01,
+  2.26578263845423316658e-01,
+  2.25083911359605925995e-01,
+  2.23589029229602859195e-01,
+  2.22093620973016186992e-01,
+  2.20597690108685934307e-01,
+  2.19101240156682003368e-01,
+  2.17604274638295597244e-01,
+  2.16106797076031698079e-01,
+  2.14608810993598742023e-01,
+  2.13110319915903123622e-01,
+  2.11611327369039092794e-01,
+  2.10111836880280927753e-01,
+  2.08611851978074580583e-01,
+  2.07111376192029406074e-01,
+  2.05610413052910334653e-01,
+  2.04108966092627741595e-01,
+  2.02607038844231757135e-01,
+  2.01104634841902329967e-01,
+  1.99601757620941178129e-01,
+  1.98098410717763573352e-01,
+  1.96594597669890014391e-01,
+  1.95090322015937817079e-01,
+  1.93585587295613398284e-01,
+  1.92080397049702006340e-01,
+  1.90574754820062114424e-01,
+  1.89068664149615345282e-01,
+  1.87562128582338505378e-01,
+  1.86055151663255341488e-01,
+  1.84547736938428103004e-01,
+  1.83039887954949659354e-01,
+  1.81531608260933480237e-01,
+  1.80022901405507806949e-01,
+  1.78513770938805604871e-01,
+  1.77004220411956625369e-01,
+  1.75494253377079079126e-01,
+  1.73983873387271253952e-01,
+  1.72473083996603188117e-01,
+  1.70961888760108676744e-01,
+  1.69450291233775196531e-01,
+  1.67938294974538215865e-01,
+  1.66425903540270953007e-01,
+  1.64913120489776549027e-01,
+  1.63399949382779630103e-01,
+  1.61886393779918036362e-01,
+  1.60372457242734689498e-01,
+  1.58858143333667656272e-01,
+  1.57343455616044264334e-01,
+  1.55828397654071054701e-01,
+  1.54312973012825704888e-01,
+  1.52797185258248813255e-01,
+  1.51281037957135405803e-01,
+  1.49764534677126942563e-01,
+  1.48247678986701270087e-01,
+  1.46730474455166765013e-01,
+  1.45212924652652286550e-01,
+  1.43695033150099071850e-01,
+  1.42176803519252464847e-01,
+  1.40658239332653450804e-01,
+  1.39139344163630218620e-01,
+  1.37620121586290278248e-01,
+  1.36100575175510246639e-01,
+  1.34580708506930019075e-01,
+  1.33060525156942693892e-01,
+  1.31540028702686551121e-01,
+  1.30019222722036587037e-01,
+  1.28498110793596215240e-01,
+  1.26976696496689162030e-01,
+  1.25454983411349335620e-01,
+  1.23932975118315052976e-01,
+  1.22410675199018881276e-01,
+  1.20888087235579574918e-01,
+  1.19365214810793665579e-01,
+  1.17842061508127080027e-01,
+  1.16318630911707104891e-01,
+  1.14794926606312228112e-01,
+  1.13270952177366296398e-01,
+  1.11746711210928356683e-01,
+  1.10222207293684620888e-01,
+  1.08697444012940083735e-01,
+  1.07172424956610029545e-01,
+  1.05647153713211594539e-01,
+  1.04121633871855814868e-01,
+  1.02595869022237329293e-01,
+  1.01069862754628675416e-01,
+  9.95436186598699923600e-02,
+  9.80171403293610687957e-02,
+  9.64904313550528636156e-02,
+  9.49634953294390821155e-02,
+  9.34363358455481268772e-02,
+  9.19089564969328837174e-02,
+  9.03813608776649485277e-02,
+  8.88535525823243715893e-02,
+  8.73255352059916500895e-02,
+  8.57973123442392904270e-02,
+  8.42688875931232872496e-02,
+  8.27402645491747135154e-02,
+  8.12114468093917130087e-02,
+  7.96824379712292168998e-02,
+  7.81532416325931567069e-02,
+  7.66238613918302224892e-02,
+  7.50943008477198553630e-02,
+  7.35645635994657820511e-02,
+  7.20346532466874939216e-02,
+  7.05045733894122950147e-02,
+  6.89743276280649908472e-02,
+  6.74439195634621291298e-02,
+  6.59133527968017024490e-02,
+  6.43826309296551685390e-02,
+  6.28517575639589431979e-02,
+  6.13207363020059209591e-02,
+  5.97895707464374814855e-02,
+  5.82582645002331922512e-02,
+  5.67268211667050006874e-02,
+  5.51952443494870131913e-02,
+  5.36635376525274182535e-02,
+  5.21317046800800348860e-02,
+  5.05997490366958194152e-02,
+  4.90676743272143792152e-02,
+  4.75354841567559374682e-02,
+  4.60031821307110844188e-02,
+  4.44707718547349487026e-02,
+  4.29382569347369277835e-02,
+  4.14056409768726665921e-02,
+  3.98729275875355643199e-02,
+  3.83401203733482812130e-02,
+  3.68072229411546825162e-02,
+  3.52742388980096313600e-02,
+  3.37411718511730907011e-02,
+  3.22080254080999231481e-02,
+  3.06748031764317932724e-02,
+  2.91415087639887195048e-02,
+  2.76081457787605670517e-02,
+  2.60747178288989987782e-02,
+  2.45412285227072195226e-02,
+  2.30076814686341335481e-02,
+  2.14740802752641027351e-02,
+  1.99404285513088662396e-02,
+  1.84067299055990785117e-02,
+  1.68729879470758056814e-02,
+  1.53392062847820271482e-02,
+  1.38053885278545951376e-02,
+  1.22715382855139651386e-02,
+  1.07376591670583654975e-02,
+  9.20375478185352785543e-03,
+  7.66982873932464236794e-03,
+  6.13588464894785756004e-03,
+  4.60192612024178972219e-03,
+  3.06795676275947682907e-03,
+  1.53398018607810398932e-03,
+  -2.06823107110214443987e-13,
+  -1.53398018649174966953e-03,
+  -3.06795676317312077455e-03,
+  -4.60192612065587515480e-03,
+  -6.13588464936193952320e-03,
+  -7.66982873973827677244e-03,
+  -9.20375478226715705576e-03,
+  -1.07376591674719877589e-02,
+  -1.22715382859275804611e-02,
+  -1.38053885282682017865e-02,
+  -1.53392062851960674780e-02,
+  -1.68729879474898390723e-02,
+  -1.84067299060131014943e-02,
+  -1.99404285517224312552e-02,
+  -2.14740802756776504034e-02,
+  -2.30076814690476708081e-02,
+  -2.45412285231207394354e-02,
+  -2.60747178293125048132e-02,
+  -2.76081457791744998287e-02,
+  -2.91415087644026349345e-02,
+  -3.06748031768452437962e-02,
+  -3.22080254085133563247e-02,
+  -3.37411718515865030610e-02,
+  -3.52742388984230229032e-02,
+  -3.68072229415680532427e-02,
+  -3.83401203737620613343e-02,
+  -3.98729275879493305634e-02,
+  -4.14056409772864050800e-02,
+  -4.29382569351501944266e-02,
+  -4.44707718551481806513e-02,
+  -4.60031821311242886119e-02,
+  -4.75354841571691139057e-02,
+  -4.90676743276279650474e-02,
+  -5.05997490371093774919e-02,
+  -5.21317046804935652071e-02,
+  -5.36635376529404697910e-02,
+  -5.51952443499000300342e-02,
+  -5.67268211671179828359e-02,
+  -5.82582645006461327664e-02,
+  -5.97895707468503873061e-02,
+  -6.13207363024192361745e-02,
+  -6.28517575643722098411e-02,
+  -6.43826309300679494596e-02,
+  -6.59133527972144417362e-02,
+  -6.74439195638748267836e-02,
+  -6.89743276284776607454e-02,
+  -7.05045733898249094018e-02,
+  -7.20346532471005107645e-02,
+  -7.35645635998787433829e-02,
+  -7.50943008481327750614e-02,
+  -7.66238613922426425873e-02,
+  -7.81532416330055351716e-02,
+  -7.96824379716415537311e-02,
+  -8.12114468098039943289e-02,
+  -8.27402645495873834136e-02,
+  -8.42688875935359016367e-02,
+  -8.57973123446518493029e-02,
+  -8.73255352064037232429e-02,
+  -8.88535525827363753537e-02,
+  -9.03813608780768967810e-02,
+  -9.19089564973447764595e-02,
+  -9.34363358459599641082e-02,
+  -9.49634953298513079245e-02,
+  -9.64904313554650339135e-02,
+  -9.80171403297727256154e-02,
+  -9.95436186602815797908e-02,
+  -1.01069862755040207336e-01,
+  -1.02595869022648791824e-01,
+  -1.04121633872267208010e-01,
+  -1.05647153713623376259e-01,
+  -1.07172424957021727998e-01,
+  -1.08697444013351726677e-01,
+  -1.10222207294095750352e-01,
+  -1.11746711211339416758e-01,
+  -1.13270952177777287084e-01,
+  -1.14794926606723149409e-01,
+  -1.16318630912117942922e-01,
+  -1.17842061508538278880e-01,
+  -1.19365214811204795042e-01,
+  -1.20888087235990177026e-01,
+  -1.22410675199429427873e-01,
+  -1.23932975118725516306e-01,
+  -1.25454983411759701806e-01,
+  -1.26976696497099444949e-01,
+  -1.28498110794006858981e-01,
+  -1.30019222722447175267e-01,
+  -1.31540028703097056084e-01,
+  -1.33060525157352671499e-01,
+  -1.34580708507339913416e-01,
+  -1.36100575175920057713e-01,
+  -1.37620121586700006056e-01,
+  -1.39139344164040279495e-01,
+  -1.40658239333063400656e-01,
+  -1.42176803519662331432e-01,
+  -1.43695033150508411079e-01,
+  -1.45212924653061542513e-01,
+  -1.46730474455575937709e-01,
+  -1.48247678987110331761e-01,
+  -1.49764534677535920970e-01,
+  -1.51281037957544745032e-01,
+  -1.52797185258658041462e-01,
+  -1.54312973013234405739e-01,
+  -1.55828397654479644530e-01,
+  -1.57343455616452770895e-01,
+  -1.58858143334076051811e-01,
+  -1.60372457243143001770e-01,
+  -1.61886393780326653946e-01,
+  -1.63399949383188164420e-01,
+  -1.64913120490184972322e-01,
+  -1.66425903540678821191e-01,
+  -1.67938294974945973026e-01,
+  -1.69450291234182870426e-01,
+  -1.70961888760516239616e-01,
+  -1.72473083997011084056e-01,
+  -1.73983873387679038869e-01,
+  -1.75494253377486753021e-01,
+  -1.77004220412363744153e-01,
+  -1.78513770939212584876e-01,
+  -1.80022901405914703687e-01,
+  -1.81531608261340265953e-01,
+  -1.83039887955356334048e-01,
+  -1.84547736938835083009e-01,
+  -1.86055151663662210471e-01,
+  -1.87562128582744819250e-01,
+  -1.89068664150021520376e-01,
+  -1.90574754820468178496e-01,
+  -1.92080397050107959389e-01,
+  -1.93585587296019212555e-01,
+  -1.95090322016343964417e-01,
+  -1.96594597670296022951e-01,
+  -1.98098410718169470890e-01,
+  -1.99601757621346492799e-01,
+  -2.01104634842307533615e-01,
+  -2.02607038844636849761e-01,
+  -2.04108966093032667688e-01,
+  -2.05610413053315149723e-01,
+  -2.07111376192434526455e-01,
+  -2.08611851978479562186e-01,
+  -2.10111836880685326490e-01,
+  -2.11611327369443380508e-01,
+  -2.13110319916307272559e-01,
+  -2.14608810994002752182e-01,
+  -2.16106797076435569460e-01,
+  -2.17604274638699773936e-01,
+  -2.19101240157086013527e-01,
+  -2.20597690109089833443e-01,
+  -2.22093620973419503262e-01,
+  -2.23589029230006036686e-01,
+  -2.25083911360008964708e-01,
+  -2.26578263845826188838e-01,
+  -2.28072083171102002463e-01,
+  -2.29565365820735250990e-01,
+  -2.31058108280887547492e-01,
+  -2.32550307038991321829e-01,
+  -2.34041958583759590606e-01,
+  -2.35533059405191730340e-01,
+  -2.37023605994583524970e-01,
+  -2.38513594844534826400e-01,
+  -2.40003022448957936685e-01,
+  -2.41491885303085879189e-01,
+  -2.42980179903480059123e-01,
+  -2.44467902748040422090e-01,
+  -2.45955050336010921930e-01,
+  -2.47441619167989707018e-01,
+  -2.48927605745936642023e-01,
+  -2.50413006573181773362e-01,
+  -2.51897818154433572602e-01,
+  -2.53382036995786819045e-01,
+  -2.54865659604730898646e-01,
+  -2.56348682490159296421e-01,
+  -2.57831102162375480624e-01,
+  -2.59312915133102728227e-01,
+  -2.60794117915492118520e-01,
+  -2.62274707024130304678e-01,
+  -2.63754678975048117984e-01,
+  -2.65234030285728172860e-01,
+  -2.66712757475114803363e-01,
+  -2.68190857063619669809e-01,
+  -2.69668325573131639761e-01,
+  -2.71145159527024615098e-01,
+  -2.72621355450165636647e-01,
+  -2.74096909868923099829e-01,
+  -2.75571819311174526224e-01,
+  -2.77046080306316333530e-01,
+  -2.78519689385269553217e-01,
+  -2.79992643080489767016e-01,
+  -2.81464937925974600930e-01,
+  -2.82936570457271996393e-01,
+  -2.84407537211488536943e-01,
+  -2.85877834727297330808e-01,
+  -2.87347459544945893484e-01,
+  -2.88816408206265917702e-01,
+  -2.90284677254678880054e-01,
+  -2.91752263235205810954e-01,
+  -2.93219162694475232733e-01,
+  -2.94685372180730986713e-01,
+  -2.96150888243840504366e-01,
+  -2.97615707435302578876e-01,
+  -2.99079826308256857548e-01,
+  -3.00543241417489892520e-01,
+  -3.02005949319444577661e-01,
+  -3.03467946572227809110e-01,
+  -3.04929229735618978481e-01,
+  -3.06389795371077577890e-01,
+  -3.07849640041751582142e-01,
+  -3.09308760312484998245e-01,
+  -3.10767152749827857416e-01,
+  -3.12224813922041322112e-01,
+  -3.13681740399107900075e-01,
+  -3.15137928752738882832e-01,
+  -3.16593375556382394809e-01,
+  -3.18048077385231497960e-01,
+  -3.19502030816231852306e-01,
+  -3.20955232428091430386e-01,
+  -3.22407678801286123882e-01,
+  -3.23859366518069180518e-01,
+  -3.25310292162479253175e-01,
+  -3.26760452320348171451e-01,
+  -3.28209843579308935269e-01,
+  -3.29658462528803541947e-01,
+  -3.31106305760092478607e-01,
+  -3.32553369866260328802e-01,
+  -3.33999651442225542475e-01,
+  -3.35445147084747818944e-01,
+  -3.36889853392436267043e-01,
+  -3.38333766965757398726e-01,
+  -3.39776884407043122671e-01,
+  -3.41219202320498293801e-01,
+  -3.42660717312210316710e-01,
+  -3.44101425990154807799e-01,
+  -3.45541324964205032177e-01,
+  -3.46980410846139675218e-01,
+  -3.48418680249650614122e-01,
+  -3.49856129790350967035e-01,
+  -3.51292756085782809095e-01,
+  -3.52728555755426387286e-01,
+  -3.54163525420706115643e-01,
+  -3.55597661704999623566e-01,
+  -3.57030961233645804942e-01,
+  -3.58463420633952367655e-01,
+  -3.59895036535203938222e-01,
+  -3.61325805568669722323e-01,
+  -3.62755724367612664150e-01,
+  -3.64184789567295386092e-01,
+  -3.65612997804989348083e-01,
+  -3.67040345719982674666e-01,
+  -3.68466829953587871049e-01,
+  -3.69892447149149650176e-01,
+  -3.71317193952053092865e-01,
+  -3.72741067009730975279e-01,
+  -3.74164062971673205826e-01,
+  -3.75586178489432431782e-01,
+  -3.77007410216633476185e-01,
+  -3.78427754808980831847e-01,
+  -3.79847208924266432906e-01,
+  -3.81265769222377648440e-01,
+  -3.82683432365304609934e-01,
+  -3.84100195017149925736e-01,
+  -3.85516053844133732564e-01,
+  -3.86931005514603465478e-01,
+  -3.88345046699041185345e-01,
+  -3.89758174070071350403e-01,
+  -3.91170384302468809867e-01,
+  -3.92581674073166020378e-01,
+  -3.93992040061262649431e-01,
+  -3.95401478948030848937e-01,
+  -3.96809987416924858650e-01,
+  -3.98217562153588167106e-01,
+  -3.99624199845861394209e-01,
+  -4.01029897183790229320e-01,
+  -4.02434650859632980779e-01,
+  -4.03838457567868291953e-01,
+  -4.05241314005204023019e-01,
+  -4.06643216870583190659e-01,
+  -4.08044162865192849843e-01,
+  -4.09444148692471754369e-01,
+  -4.10843171058118128425e-01,
+  -4.12241226670097049567e-01,
+  -4.13638312238648275798e-01,
+  -4.15034424476295404904e-01,
+  -4.16429560097850925970e-01,
+  -4.17823715820426044854e-01,
+  -4.19216888363437678588e-01,
+  -4.20609074448616282460e-01,
+  -4.22000270800013399519e-01,
+  -4.23390474144009765212e-01,
+  -4.24779681209322135249e-01,
+  -4.26167888727012944550e-01,
+  -4.27555093430495414264e-01,
+  -4.28941292055542822137e-01,
+  -4.30326481340295885492e-01,
+  -4.31710658025270532789e-01,
+  -4.33093818853365231103e-01,
+  -4.34475960569868535632e-01,
+  -4.35857079922468304556e-01,
+  -4.37237173661256917079e-01,
+  -4.38616238538740432773e-01,
+  -4.39994271309846030071e-01,
+  -4.41371268731929444762e-01,
+  -4.42747227564782797060e-01,
+  -4.44122144570641586014e-01,
+  -4.45496016514194070890e-01,
+  -4.46868840162586489217e-01,
+  -4.48240612285432216133e-01,
+  -4.49611329654818869805e-01,
+  -4.50980989045316138508e-01,
+  -4.52349587233983108092e-01,
+  -4.53717121000376089057e-01,
+  -4.55083587126555610958e-01,
+  -4.56448982397095692765e-01,
+  -4.57813303599088949891e-01,
+  -4.59176547522155864556e-01,
+  -4.60538710958451724675e-01,
+  -4.61899790702674395426e-01,
+  -4.63259783552071813251e-01,
+  -4.64618686306449035772e-01,
+  -4.65976495768177345624e-01,
+  -4.67333208742199579522e-01,
+  -4.68688822036039065555e-01,
+  -4.70043332459806728618e-01,
+  -4.71396736826208695437e-01,
+  -4.72749031950553844084e-01,
+  -4.74100214650760631852e-01,
+  -4.75450281747366476637e-01,
+  -4.76799230063532697432e-01,
+  -4.78147056425053562645e-01,
+  -4.79493757660363506545e-01,
+  -4.80839330600544401229e-01,
+  -4.82183772079333161642e-01,
+  -4.83527078933129128568e-01,
+  -4.84869248001001063031e-01,
+  -4.86210276124696305633e-01,
+  -4.87550160148645828073e-01,
+  -4.88888896919973003907e-01,
+  -4.90226483288500936020e-01,
+  -4.91562916106759673074e-01,
+  -4.92898192229993759028e-01,
+  -4.94232308516169005497e-01,
+  -4.95565261825981762112e-01,
+  -4.96897049022863745993e-01,
+  -4.98227666972991034555e-01,
+  -4.99557112545291004402e-01,
+  -5.00885382611449880841e-01,
+  -5.02212474045919843313e-01,
+  -5.03538383725926519396e-01,
+  -5.04863108531476090235e-01,
+  -5.06186645345363728232e-01,
+  -5.07508991053179259190e-01,
+  -5.08830142543315377957e-01,
+  -5.10150096706975086924e-01,
+  -5.11468850438178690432e-01,
+  -5.12786400633771233259e-01,
+  -5.14102744193429495034e-01,
+  -5.15417878019670760992e-01,
+  -5.16731799017857595935e-01,
+  -5.18044504096207059085e-01,
+  -5.19355990165797143376e-01,
+  -5.20666254140574658038e-01,
+  -5.21975292937361778911e-01,
+  -5.23283103475863486942e-01,
+  -5.24589682678675894856e-01,
+  -5.25895027471291576227e-01,
+  -5.27199134782108225217e-01,
+  -5.28502001542435317916e-01,
+  -5.29803624686501439811e-01,
+  -5.31104001151461613262e-01,
+  -5.32403127877404624968e-01,
+  -5.33701001807359132201e-01,
+  -5.34997619887303321740e-01,
+  -5.36292979066169239744e-01,
+  -5.37587076295851451491e-01,
+  -5.38879908531214368850e-01,
+  -5.40171472730098689574e-01,
+  -5.41461765853329279885e-01,
+  -5.42750784864721280698e-01,
+  -5.44038526731089211452e-01,
+  -5.45324988422251633047e-01,
+  -5.46610166911040029625e-01,
+  -5.47894059173305247867e-01,
+  -5.49176662187924713443e-01,
+  -5.50457972936809758480e-01,
+  -5.51737988404911949836e-01,
+  -5.53016705580231970885e-01,
+  -5.54294121453824395473e-01,
+  -5.55570233019806458685e-01,
+  -5.56845037275364274088e-01,
+  -5.58118531220760272227e-01,
+  -5.59390711859340084011e-01,
+  -5.60661576197539979205e-01,
+  -5.61931121244892972655e-01,
+  -5.63199344014037595052e-01,
+  -5.64466241520722777913e-01,
+  -5.65731810783816513322e-01,
+  -5.66996048825311849129e-01,
+  -5.68258952670334660517e-01,
+  -5.69520519347150200318e-01,
+  -5.70780745887169871366e-01,
+  -5.72039629324959553180e-01,
+  -5.73297166698244597960e-01,
+  -5.74553355047918157261e-01,
+  -5.75808191418047510268e-01,
+  -5.77061672855881613309e-01,
+  -5.78313796411857650170e-01,
+  -5.79564559139607693439e-01,
+  -5.80813958095966031969e-01,
+  -5.82061990340976942448e-01,
+  -5.83308652937899685398e-01,
+  -5.84553942953216498779e-01,
+  -5.85797857456640036489e-01,
+  -5.87040393521119030495e-01,
+  -5.88281548222846284446e-01,
+  -5.89521318641264446825e-01,
+  -5.90759701859074670693e-01,
+  -5.91996694962241276627e-01,
+  -5.93232295040000079389e-01,
+  -5.94466499184864605176e-01,
+  -5.95699304492633419095e-01,
+  -5.96930708062396453428e-01,
+  -5.98160706996541780001e-01,
+  -5.99389298400763936847e-01,
+  -6.00616479384068258085e-01,
+  -6.01842247058779200586e-01,
+  -6.03066598540547227358e-01,
+  -6.04289530948355024798e-01,
+  -6.05511041404524386067e-01,
+  -6.06731127034723316527e-01,
+  -6.07949784967972028937e-01,
+  -6.09167012336651381155e-01,
+  -6.10382806276507539067e-01,
+  -6.11597163926659859179e-01,
+  -6.12810082429607549948e-01,
+  -6.14021558931236222101e-01,
+  -6.15231590580824549974e-01,
+  -6.16440174531050821827e-01,
+  -6.17647307938001044469e-01,
+  -6.18852987961173273135e-01,
+  -6.20057211763486049172e-01,
+  -6.21259976511284395251e-01,
+  -6.22461279374346587723e-01,
+  -6.23661117525891151026e-01,
+  -6.24859488142582408798e-01,
+  -6.26056388404539476689e-01,
+  -6.27251815495339926088e-01,
+  -6.28445766602028443870e-01,
+  -6.29638238915122605555e-01,
+  -6.30829229628619980730e-01,
+  -6.32018735940004350304e-01,
+  -6.33206755050252478867e-01,
+  -6.34393284163840331935e-01,
+  -6.35578320488750847517e-01,
+  -6.36761861236478821091e-01,
+  -6.37943903622038455126e-01,
+  -6.39124444863970020414e-01,
+  -6.40303482184345851280e-01,
+  -6.41481012808777228962e-01,
+  -6.42657033966420487836e-01,
+  -6.43831542889984898004e-01,
+  -6.45004536815737328226e-01,
+  -6.46176012983509573395e-01,
+  -6.47345968636705126897e-01,
+  -6.48514401022305397859e-01,
+  -6.49681307390876039420e-01,
+  -6.50846684996573610071e-01,
+  -6.52010531097151790902e-01,
+  -6.53172842953968824098e-01,
+  -6.54333617831992508940e-01,
+  -6.55492852999807196213e-01,
+  -6.56650545729620671587e-01,
+  -6.57806693297270261844e-01,
+  -6.58961292982228719062e-01,
+  -6.60114342067611437059e-01,
+  -6.61265837840183001717e-01,
+  -6.62415777590362409022e-01,
+  -6.63564158612230281520e-01,
+  -6.64710978203535307607e-01,
+  -6.65856233665699903668e-01,
+  -6.66999922303827652570e-01,
+  -6.68142041426708188645e-01,
+  -6.69282588346825524361e-01,
+  -6.70421560380362491216e-01,
+  -6.71558954847207623118e-01,
+  -6.72694769070962039770e-01,
+  -6.73829000378944997784e-01,
+  -6.74961646102200774067e-01,
+  -6.76092703575504549995e-01,
+  -6.77222170137368628673e-01,
+  -6.78350043130049540352e-01,
+  -6.79476319899552927417e-01,
+  -6.80600997795640760835e-01,
+  -6.81724074171837335356e-01,
+  -6.82845546385435486769e-01,
+  -6.83965411797502698121e-01,
+  -6.85083667772887205949e-01,
+  -6.86200311680225216726e-01,
+  -6.87315340891945569801e-01,
+  -6.88428752784276842824e-01,
+  -6.89540544737253124907e-01,
+  -6.90650714134720677961e-01,
+  -6.91759258364343598835e-01,
+  -6.92866174817610036563e-01,
+  -6.93971460889839186770e-01,
+  -6.95075113980185954610e-01,
+  -6.96177131491647838146e-01,
+  -6.97277510831071367647e-01,
+  -6.98376249409157434656e-01,
+  -6.99473344640468286393e-01,
+  -7.00568793943432632787e-01,
+  -7.01662594740352307809e-01,
+  -7.02754744457408930813e-01,
+  -7.03845240524668458448e-01,
+  -7.04934080376088179065e-01,
+  -7.06021261449522929965e-01,
+  -7.07106781186730537492e-01,
+  -7.08190637033378145304e-01,
+  -7.09272826439047987535e-01,
+  -7.10353346857244494217e-01,
+  -7.11432195745398399112e-01,
+  -7.12509370564874178200e-01,
+  -7.13584868780975267732e-01,
+  -7.14658687862950503522e-01,
+  -7.15730825284000005126e-01,
+  -7.16801278521280615941e-01,
+  -7.17870045055912342491e-01,
+  -7.18937122372984904750e-01,
+  -7.20002507961561954986e-01,
+  -7.21066199314688183186e-01,
+  -7.22128193929395312267e-01,
+  -7.23188489306707205095e-01,
+  -7.24247082951646525828e-01,
+  -7.25303972373239846938e-01,
+  -7.26359155084524865664e-01,
+  -7.27412628602554511836e-01,
+  -7.28464390448403720235e-01,
+  -7.29514438147175425797e-01,
+  -7.30562769228005781663e-01,
+  -7.31609381224070598471e-01,
+  -7.32654271672590340359e-01,
+  -7.33697438114837674483e-01,
+  -7.34738878096140579643e-01,
+  -7.35778589165890450907e-01,
+  -7.36816568877546651528e-01,
+  -7.37852814788642619170e-01,
+  -7.38887324460791528047e-01,
+  -7.39920095459692395146e-01,
+  -7.40951125355134854189e-01,
+  -7.41980411721006594128e-01,
+  -7.43007952135297022878e-01,
+  -7.44033744180104483767e-01,
+  -7.45057785441640918478e-01,
+  -7.46080073510238528378e-01,
+  -7.47100605980354770530e-01,
+  -7.48119380450577686759e-01,
+  -7.49136394523633231124e-01,
+  -7.50151645806388711613e-01,
+  -7.51165131909859895565e-01,
+  -7.52176850449216005678e-01,
+  -7.53186799043785604191e-01,
+  -7.54194975317062032971e-01,
+  -7.55201376896708964637e-01,
+  -7.56206001414566730823e-01,
+  -7.57208846506656541031e-01,
+  -7.58209909813187143968e-01,
+  -7.59209188978559712524e-01,
+  -7.60206681651373838982e-01,
+  -7.61202385484433086127e-01,
+  -7.62196298134749983255e-01,
+  -7.63188417263552132397e-01,
+  -7.64178740536287315344e-01,
+  -7.65167265622629377830e-01,
+  -7.66153990196482559405e-01,
+  -7.67138911935989820101e-01,
+  -7.68122028523534616795e-01,
+  -7.69103337645748674767e-01,
+  -7.70082836993516761659e-01,
+  -7.71060524261982349614e-01,
+  -7.72036397150552833324e-01,
+  -7.73010453362905081143e-01,
+  -7.73982690606990764159e-01,
+  -7.74953106595041574245e-01,
+  -7.75921699043575108234e-01,
+  -7.76888465673399752909e-01,
+  -7.77853404209620125087e-01,
+  -7.78816512381642844787e-01,
+  -7.79777787923181198160e-01,
+  -7.80737228572260355541e-01,
+  -7.81694832071225031989e-01,
+  -7.82650596166741152615e-01,
+  -7.83604518609803513129e-01,
+  -7.84556597155740220728e-01,
+  -7.85506829564218800321e-01,
+  -7.86455213599250302359e-01,
+  -7.87401747029195742122e-01,
+  -7.88346427626770429598e-01,
+  -7.89289253169049520586e-01,
+  -7.90230221437473678847e-01,
+  -7.91169330217853628007e-01,
+  -7.92106577300375591655e-01,
+  -7.93041960479606622414e-01,
+  -7.93975477554499931010e-01,
+  -7.94907126328398994097e-01,
+  -7.95836904609045325820e-01,
+  -7.96764810208580254169e-01,
+  -7.97690840943552470499e-01,
+  -7.98614994634921915306e-01,
+  -7.99537269108065884460e-01,
+  -8.00457662192783359068e-01,
+  -8.01376171723300556593e-01,
+  -8.02292795538275926859e-01,
+  -8.03207531480804814983e-01,
+  -8.04120377398425456583e-01,
+  -8.05031331143123085603e-01,
+  -8.05940390571335485426e-01,
+  -8.06847553543958206923e-01,
+  -8.07752817926349120370e-01,
+  -8.08656181588332967358e-01,
+  -8.09557642404209021336e-01,
+  -8.10457198252752308854e-01,
+  -8.11354847017221048056e-01,
+  -8.12250586585360978553e-01,
+  -8.13144414849410357427e-01,
+  -8.14036329706104844206e-01,
+  -8.14926329056682940966e-01,
+  -8.15814410806889878103e-01,
+  -8.16700572866983609543e-01,
+  -8.17584813151739253634e-01,
+  -8.18467129580453978122e-01,
+  -8.19347520076951996160e-01,
+  -8.20225982569589451288e-01,
+  -8.21102514991258747301e-01,
+  -8.21977115279395320613e-01,
+  -8.22849781375979860698e-01,
+  -8.23720511227544749389e-01,
+  -8.24589302785178279720e-01,
+  -8.25456154004530318069e-01,
+  -8.26321062845816078912e-01,
+  -8.27184027273821453896e-01,
+  -8.28045045257907785796e-01,
+  -8.28904114772016753498e-01,
+  -8.29761233794674590847e-01,
+  -8.30616400308997526736e-01,
+  -8.31469612302696226003e-01,
+  -8.32320867768080452365e-01,
+  -8.33170164702063731355e-01,
+  -8.34017501106167902236e-01,
+  -8.34862874986529557297e-01,
+  -8.35706284353901818207e-01,
+  -8.36547727223660997353e-01,
+  -8.37387201615810594646e-01,
+  -8.38224705554986515565e-01,
+  -8.39060237070460845921e-01,
+  -8.39893794196147402964e-01,
+  -8.40725374970605732194e-01,
+  -8.41554977437045770294e-01,
+  -8.42382599643333063177e-01,
+  -8.43208239641992318703e-01,
+  -8.44031895490213068811e-01,
+  -8.44853565249853444286e-01,
+  -8.45673246987445170753e-01,
+  -8.46490938774197454464e-01,
+  -8.47306638686003421590e-01,
+  -8.48120344803442005599e-01,
+  -8.48932055211784164506e-01,
+  -8.49741768000996766652e-01,
+  -8.50549481265747364667e-01,
+  -8.51355193105408858401e-01,
+  -8.52158901624063269686e-01,
+  -8.52960604930506849364e-01,
+  -8.53760301138254296127e-01,
+  -8.54557988365543086395e-01,
+  -8.55353664735338359293e-01,
+  -8.56147328375336580386e-01,
+  -8.56938977417970537687e-01,
+  -8.57728610000413560499e-01,
+  -8.58516224264583516224e-01,
+  -8.59301818357148916583e-01,
+  -8.60085390429530360912e-01,
+  -8.60866938637907197496e-01,
+  -8.61646461143220965262e-01,
+  -8.62423956111179945694e-01,
+  -8.63199421712263270656e-01,
+  -8.63972856121725474310e-01,
+  -8.64744257519600934003e-01,
+  -8.65513624090707311964e-01,
+  -8.66280954024650884371e-01,
+  -8.67046245515830316108e-01,
+  -8.67809496763440657574e-01,
+  -8.68570705971478007612e-01,
+  -8.69329871348743066228e-01,
+  -8.70086991108847462861e-01,
+  -8.70842063470214644560e-01,
+  -8.71595086656086537324e-01,
+  -8.72346058894526654726e-01,
+  -8.73094978418424982891e-01,
+  -8.73841843465501422195e-01,
+  -8.74586652278310450193e-01,
+  -8.75329403104244896383e-01,
+  -8.76070094195540272075e-01,
+  -8.76808723809279100259e-01,
+  -8.77545290207394468318e-01,
+  -8.78279791656674357903e-01,
+  -8.79012226428765974795e-01,
+  -8.79742592800179634693e-01,
+  -8.80470889052292315924e-01,
+  -8.81197113471353210556e-01,
+  -8.81921264348485944851e-01,
+  -8.82643339979693353214e-01,
+  -8.83363338665861919097e-01,
+  -8.84081258712764994634e-01,
+  -8.84797098431067463586e-01,
+  -8.85510856136329294053e-01,
+  -8.86222530149009757316e-01,
+  -8.86932118794470980561e-01,
+  -8.87639620402982498781e-01,
+  -8.88345033309724474435e-01,
+  -8.89048355854792471398e-01,
+  -8.89749586383200341544e-01,
+  -8.90448723244885109729e-01,
+  -8.91145764794709749346e-01,
+  -8.91840709392468955485e-01,
+  -8.92533555402890588226e-01,
+  -8.93224301195641001705e-01,
+  -8.93912945145328596830e-01,
+  -8.94599485631507707062e-01,
+  -8.95283921038682262150e-01,
+  -8.95966249756309562891e-01,
+  -8.96646470178804277928e-01,
+  -8.97324580705541996473e-01,
+  -8.98000579740863225098e-01,
+  -8.98674465694076940459e-01,
+  -8.99346236979464364047e-01,
+  -9.00015892016282736954e-01,
+  -9.00683429228769094621e-01,
+  -9.01348847046143486494e-01,
+  -9.02012143902614305091e-01,
+  -9.02673318237379618267e-01,
+  -9.03332368494632387268e-01,
+  -9.03989293123563575350e-01,
+  -9.04644090578366033562e-01,
+  -9.05296759318238275505e-01,
+  -9.05947297807387696977e-01,
+  -9.06595704515034239712e-01,
+  -9.07241977915414388178e-01,
+  -9.07886116487784500251e-01,
+  -9.08528118716424026857e-01,
+  -9.09167983090639952870e-01,
+  -9.09805708104769572664e-01,
+  -9.10441292258183820785e-01,
+  -9.11074734055292601020e-01,
+  -9.11706032005545785601e-01,
+  -9.12335184623438322227e-01,
+  -9.12962190428513453710e-01,
+  -9.13587047945365715584e-01,
+  -9.14209755703645265967e-01,
+  -9.14830312238060439078e-01,
+  -9.15448716088381742040e-01,
+  -9.16064965799445296568e-01,
+  -9.16679059921155947599e-01,
+  -9.17290997008490927023e-01,
+  -9.17900775621503073332e-01,
+  -9.18508394325324495355e-01,
+  -9.19113851690169680886e-01,
+  -9.19717146291338605302e-01,
+  -9.20318276709221505527e-01,
+  -9.20917241529299990255e-01,
+  -9.21514039342152146972e-01,
+  -9.22108668743454984451e-01,
+  -9.22701128333988096486e-01,
+  -9.23291416719636881538e-01,
+  -9.23879532511395651362e-01,
+  -9.24465474325371183717e-01,
+  -9.25049240782785830994e-01,
+  -9.25630830509980628840e-01,
+  -9.26210242138418848867e-01,
+  -9.26787474304688996263e-01,
+  -9.27362525650507918407e-01,
+  -9.27935394822724357589e-01,
+  -9.28506080473321393498e-01,
+  -9.29074581259421217183e-01,
+  -9.29640895843286352296e-01,
+  -9.30205022892323762917e-01,
+  -9.30766961079088184228e-01,
+  -9.31326709081284453973e-01,
+  -9.31884265581771842335e-01,
+  -9.32439629268565717268e-01,
+  -9.32992798834841874367e-01,
+  -9.33543772978938868334e-01,
+  -9.34092550404361232630e-01,
+  -9.34639129819782699116e-01,
+  -9.35183509939049195658e-01,
+  -9.35725689481181621687e-01,
+  -9.36265667170379067841e-01,
+  -9.36803441736021813568e-01,
+  -9.37339011912674768823e-01,
+  -9.37872376440089361438e-01,
+  -9.38403534063207200866e-01,
+  -9.38932483532163297824e-01,
+  -9.39459223602288284738e-01,
+  -9.39983753034112079483e-01,
+  -9.40506070593365994803e-01,
+  -9.41026175050986624093e-01,
+  -9.41544065183117728779e-01,
+  -9.42059739771114013074e-01,
+  -9.42573197601543122381e-01,
+  -9.43084437466189418053e-01,
+  -9.43593458162055864769e-01,
+  -9.44100258491367583247e-01,
+  -9.44604837261574736829e-01,
+  -9.45107193285354751922e-01,
+  -9.45607325380615093557e-01,
+  -9.46105232370496818106e-01,
+  -9.46600913083376571677e-01,
+  -9.47094366352869920789e-01,
+  -9.47585591017833461791e-01,
+  -9.48074585922368151536e-01,
+  -9.48561349915821860890e-01,
+  -9.49045881852791817224e-01,
+  -9.49528180593127490994e-01,
+  -9.50008245001933482321e-01,
+  -9.50486073949571852459e-01,
+  -9.50961666311664788331e-01,
+  -9.51435020969097489107e-01,
+  -9.51906136808021052786e-01,
+  -9.52375012719854141530e-01,
+  -9.52841647601286645397e-01,
+  -9.53306040354281458704e-01,
+  -9.53768189886077477624e-01,
+  -9.54228095109192486767e-01,
+  -9.54685754941424824516e-01,
+  -9.55141168305856824716e-01,
+  -9.55594334130856704057e-01,
+  -9.56045251350081781716e-01,
+  -9.56493918902480033672e-01,
+  -9.56940335732293423376e-01,
+  -9.57384500789060011172e-01,
+  -9.57826413027616729856e-01,
+  -9.58266071408100827966e-01,
+  -9.58703474895954310675e-01,
+  -9.59138622461924272855e-01,
+  -9.59571513082066562816e-01,
+  -9.60002145737747558663e-01,
+  -9.60430519415647054871e-01,
+  -9.60856633107760482737e-01,
+  -9.61280485811401130825e-01,
+  -9.61702076529202587452e-01,
+  -9.62121404269121294206e-01,
+  -9.62538468044438433324e-01,
+  -9.62953266873762814271e-01,
+  -9.63365799781032539073e-01,
+  -9.63776065795517999923e-01,
+  -9.64184063951823544514e-01,
+  -9.64589793289889807504e-01,
+  -9.64993252854997041190e-01,
+  -9.65394441697765670618e-01,
+  -9.65793358874159624250e-01,
+  -9.66190003445488110323e-01,
+  -9.66584374478408281384e-01,
+  -9.66976471044926899623e-01,
+  -9.67366292222402890388e-01,
+  -9.67753837093549451609e-01,
+  -9.68139104746435941173e-01,
+  -9.68522094274490541466e-01,
+  -9.68902804776501702655e-01,
+  -9.69281235356620918253e-01,
+  -9.69657385124364390450e-01,
+  -9.70031253194615361579e-01,
+  -9.70402838687626445591e-01,
+  -9.70772140729020849292e-01,
+  -9.71139158449795258932e-01,
+  -9.71503890986321505530e-01,
+  -9.71866337480348785327e-01,
+  -9.72226497079005325119e-01,
+  -9.72584368934800824746e-01,
+  -9.72939952205628344473e-01,
+  -9.73293246054765970321e-01,
+  -9.73644249650879256563e-01,
+  -9.73992962168022891056e-01,
+  -9.74339382785642471596e-01,
+  -9.74683510688576837389e-01,
+  -9.75025345067059845405e-01,
+  -9.75364885116722035718e-01,
+  -9.75702130038593296035e-01,
+  -9.76037079039103416811e-01,
+  -9.76369731330085088850e-01,
+  -9.76700086128775346594e-01,
+  -9.77028142657817455508e-01,
+  -9.77353900145262688426e-01,
+  -9.77677357824572212941e-01,
+  -9.77998514934618978778e-01,
+  -9.78317370719689050063e-01,
+  -9.78633924429484158836e-01,
+  -9.78948175319122815274e-01,
+  -9.79260122649142306095e-01,
+  -9.79569765685500359886e-01,
+  -9.79877103699577034490e-01,
+  -9.80182135968176160290e-01,
+  -9.80484861773527782702e-01,
+  -9.80785280403288384221e-01,
+  -9.81083391150544215087e-01,
+  -9.81379193313811737376e-01,
+  -9.81672686197039845446e-01,
+  -9.81963869109611531272e-01,
+  -9.82252741366345327734e-01,
+  -9.82539302287496751909e-01,
+  -9.82823551198760303471e-01,
+  -9.83105487431270907983e-01,
+  -9.83385110321605471206e-01,
+  -9.83662419211784100348e-01,
+  -9.83937413449272213484e-01,
+  -9.84210092386981982848e-01,
+  -9.84480455383273334036e-01,
+  -9.84748501801956166446e-01,
+  -9.85014231012291352485e-01,
+  -9.85277642388992291878e-01,
+  -9.85538735312226688023e-01,
+  -9.85797509167617658221e-01,
+  -9.86053963346245287980e-01,
+  -9.86308097244648074309e-01,
+  -9.86559910264824369008e-01,
+  -9.86809401814234044004e-01,
+  -9.87056571305799157479e-01,
+  -9.87301418157906063300e-01,
+  -9.87543941794406521240e-01,
+  -9.87784141644618918221e-01,
+  -9.88022017143329822630e-01,
+  -9.88257567730795316585e-01,
+  -9.88490792852741995134e-01,
+  -9.88721691960368742613e-01,
+  -9.88950264510347509805e-01,
+  -9.89176509964825090293e-01,
+  -9.89400427791424008639e-01,
+  -9.89622017463244074698e-01,
+  -9.89841278458863271794e-01,
+  -9.90058210262339422059e-01,
+  -9.90272812363211074604e-01,
+  -9.90485084256498504729e-01,
+  -9.90695025442705712315e-01,
+  -9.90902635427820643876e-01,
+  -9.91107913723316968913e-01,
+  -9.91310859846155079111e-01,
+  -9.91511473318783087549e-01,
+  -9.91709753669138271981e-01,
+  -9.91905700430647629950e-01,
+  -9.92099313142229655149e-01,
+  -9.92290591348294781504e-01,
+  -9.92479534598746937490e-01,
+  -9.92666142448984545332e-01,
+  -9.92850414459901187136e-01,
+  -9.93032350197887048182e-01,
+  -9.93211949234829805100e-01,
+  -9.93389211148115403027e-01,
+  -9.93564135520629720943e-01,
+  -9.93736721940758571670e-01,
+  -9.93906970002389478225e-01,
+  -9.94074879304912339961e-01,
+  -9.94240449453220431764e-01,
+  -9.94403680057711070184e-01,
+  -9.94564570734287056730e-01,
+  -9.94723121104356899913e-01,
+  -9.94879330794836258534e-01,
+  -9.95033199438148829863e-01,
+  -9.95184726672226682709e-01,
+  -9.95333912140511589683e-01,
+  -9.95480755491955804359e-01,
+  -9.95625256381022727403e-01,
+  -9.95767414467687794755e-01,
+  -9.95907229417439254782e-01,
+  -9.96044700901279056460e-01,
+  -9.96179828595723515505e-01,
+  -9.96312612182804091532e-01,
+  -9.96443051350068276228e-01,
+  -9.96571145790580037449e-01,
+  -9.96696895202920818413e-01,
+  -9.96820299291189981794e-01,
+  -9.96941357765005919944e-01,
+  -9.97060070339506387960e-01,
+  -9.97176436735349058793e-01,
+  -9.97290456678712744498e-01,
+  -9.97402129901297285208e-01,
+  -9.97511456140324992425e-01,
+  -9.97618435138540649021e-01,
+  -9.97723066644212286391e-01,
+  -9.97825350411131850592e-01,
+  -9.97925286198615646427e-01,
+  -9.98022873771505447671e-01,
+  -9.98118112900167941959e-01,
+  -9.98211003360496507142e-01,
+  -9.98301544933910656177e-01,
+  -9.98389737407357591437e-01,
+  -9.98475580573311649601e-01,
+  -9.98559074229775744946e-01,
+  -9.98640218180281258320e-01,
+  -9.98719012233888481234e-01,
+  -9.98795456205187504040e-01,
+  -9.98869549914298215931e-01,
+  -9.98941293186870971077e-01,
+  -9.99010685854087032709e-01,
+  -9.99077727752658573124e-01,
+  -9.99142418724829672882e-01,
+  -9.99204758618376098767e-01,
+  -9.99264747286606302978e-01,
+  -9.99322384588360868030e-01,
+  -9.99377670388013727987e-01,
+  -9.99430604555472168471e-01,
+  -9.99481186966176937680e-01,
+  -9.99529417501102579457e-01,
+  -9.99575296046758210444e-01,
+  -9.99618822495187075994e-01,
+  -9.99659996743967327326e-01,
+  -9.99698818696211799484e-01,
+  -9.99735288260568788488e-01,
+  -9.99769405351221940315e-01,
+  -9.99801169887890361920e-01,
+  -9.99830581795829065328e-01,
+  -9.99857641005829078651e-01,
+  -9.99882347454217224048e-01,
+  -9.99904701082857116923e-01,
+  -9.99924701839148388771e-01,
+  -9.99942349676027242289e-01,
+  -9.99957644551966673419e-01,
+  -9.99970586430976471348e-01,
+  -9.99981175282602996468e-01,
+  -9.99989411081929846503e-01,
+  -9.99995293809577079358e-01,
+  -9.99998823451702434362e-01,
+  -1.00000000000000000000e+00,
+  -9.99998823451701435161e-01,
+  -9.99995293809575191979e-01,
+  -9.99989411081926959923e-01,
+  -9.99981175282599221710e-01,
+  -9.99970586430971697389e-01,
+  -9.99957644551961011281e-01,
+  -9.99942349676020580951e-01,
+  -9.99924701839140728232e-01,
+  -9.99904701082848568205e-01,
+  -9.99882347454207787152e-01,
+  -9.99857641005818531532e-01,
+  -9.99830581795817630031e-01,
+  -9.99801169887878038445e-01,
+  -9.99769405351208617638e-01,
+  -9.99735288260554577633e-01,
+  -9.99698818696196589428e-01,
+  -9.99659996743951118070e-01,
+  -9.99618822495169978559e-01,
+  -9.99575296046740113809e-01,
+  -9.99529417501083594644e-01,
+  -9.99481186966156953666e-01,
+  -9.99430604555451185256e-01,
+  -9.99377670387991856593e-01,
+  -9.99322384588337997435e-01,
+  -9.99264747286582433183e-01,
+  -9.99204758618351451815e-01,
+  -9.99142418724803915708e-01,
+  -9.99077727752631927771e-01,
+  -9.99010685854059388156e-01,
+  -9.98941293186842438345e-01,
+  -9.98869549914268683999e-01,
+  -9.98795456205156972906e-01,
+  -9.98719012233857061922e-01,
+  -9.98640218180248839808e-01,
+  -9.98559074229742438256e-01,
+  -9.98475580573277454732e-01,
+  -9.98389737407322397367e-01,
+  -9.98301544933874573928e-01,
+  -9.98211003360459425693e-01,
+  -9.98118112900129972331e-01,
+  -9.98022873771466478843e-01,
+  -9.97925286198575789420e-01,
+  -9.97825350411090883362e-01,
+  -9.97723066644170319961e-01,
+  -9.97618435138497794412e-01,
+  -9.97511456140281249638e-01,
+  -9.97402129901252654243e-01,
+  -9.97290456678667003310e-01,
+  -9.97176436735302429426e-01,
+  -9.97060070339458870414e-01,
+  -9.96941357764957514220e-01,
+  -9.96820299291140576869e-01,
+  -9.96696895202870414288e-01,
+  -9.96571145790528745145e-01,
+  -9.96443051350015984724e-01,
+  -9.96312612182750911849e-01,
+  -9.96179828595669336622e-01,
+  -9.96044700901223878375e-01,
+  -9.95907229417383077497e-01,
+  -9.95767414467630729291e-01,
+  -9.95625256380964773761e-01,
+  -9.95480755491896962539e-01,
+  -9.95333912140451748662e-01,
+  -9.95184726672165842487e-01,
+  -9.95033199438087101463e-01,
+  -9.94879330794773641955e-01,
+  -9.94723121104293173111e-01,
+  -9.94564570734222441750e-01,
+  -9.94403680057645567025e-01,
+  -9.94240449453153929404e-01,
+  -9.94074879304844838401e-01,
+  -9.93906970002320977464e-01,
+  -9.93736721940689071708e-01,
+  -9.93564135520559332804e-01,
+  -9.93389211148044126709e-01,
+  -9.93211949234757640603e-01,
+  -9.93032350197813884485e-01,
+  -9.92850414459827135261e-01,
+  -9.92666142448909605278e-01,
+  -9.92479534598670998236e-01,
+  -9.92290591348217843048e-01,
+  -9.92099313142151828515e-01,
+  -9.91905700430568915138e-01,
+  -9.91709753669058557968e-01,
+  -9.91511473318702485358e-01,
+  -9.91310859846073477719e-01,
+  -9.91107913723234368319e-01,
+  -9.90902635427737044083e-01,
+  -9.90695025442621113321e-01,
+  -9.90485084256413017556e-01,
+  -9.90272812363124699253e-01,
+  -9.90058210262252158529e-01,
+  -9.89841278458775120086e-01,
+  -9.89622017463154923789e-01,
+  -9.89400427791333969552e-01,
+  -9.89176509964734052005e-01,
+  -9.88950264510255472317e-01,
+  -9.88721691960275816946e-01,
+  -9.88490792852648181288e-01,
+  -9.88257567730700503539e-01,
+  -9.88022017143234121406e-01,
+  -9.87784141644522106773e-01,
+  -9.87543941794308710591e-01,
+  -9.87301418157807364473e-01,
+  -9.87056571305699459451e-01,
+  -9.86809401814133568820e-01,
+  -9.86559910264723005646e-01,
+  -9.86308097244545711746e-01,
+  -9.86053963346142037238e-01,
+  -9.85797509167513519301e-01,
+  -9.85538735312121549903e-01,
+  -9.85277642388886265579e-01,
+  -9.85014231012184326985e-01,
+  -9.84748501801848252768e-01,
+  -9.84480455383164421157e-01,
+  -9.84210092386872070769e-01,
+  -9.83937413449161302204e-01,
+  -9.83662419211672189867e-01,
+  -9.83385110321492672547e-01,
+  -9.83105487431157332168e-01,
+  -9.82823551198645839477e-01,
+  -9.82539302287381288714e-01,
+  -9.82252741366228865338e-01,
+  -9.81963869109494291720e-01,
+  -9.81672686196921606694e-01,
+  -9.81379193313692499423e-01,
+  -9.81083391150424088956e-01,
+  -9.80785280403167369911e-01,
+  -9.80484861773405769192e-01,
+  -9.80182135968053258601e-01,
+  -9.79877103699453022578e-01,
+  -9.79569765685375348774e-01,
+  -9.79260122649016406804e-01,
+  -9.78948175318996027805e-01,
+  -9.78633924429356594210e-01,
+  -9.78317370719560597259e-01,
+  -9.77998514934489526773e-01,
+  -9.77677357824441872758e-01,
+  -9.77353900145131460064e-01,
+  -9.77028142657685227945e-01,
+  -9.76700086128642230854e-01,
+  -9.76369731329950973908e-01,
+  -9.76037079038968413691e-01,
+  -9.75702130038457293715e-01,
+  -9.75364885116585256242e-01,
+  -9.75025345066921844683e-01,
+  -9.74683510688437948488e-01,
+  -9.74339382785502583495e-01,
+  -9.73992962167882003754e-01,
+  -9.73644249650737814150e-01,
+  -9.73293246054623528707e-01,
+  -9.72939952205484903658e-01,
+  -9.72584368934656495753e-01,
+  -9.72226497078860107948e-01,
+  -9.71866337480202568955e-01,
+  -9.71503890986174512001e-01,
+  -9.71139158449647266202e-01,
+  -9.70772140728871968385e-01,
+  -9.70402838687476565482e-01,
+  -9.70031253194464593292e-01,
+  -9.69657385124212511940e-01,
+  -9.69281235356468040543e-01,
+  -9.68902804776347936766e-01,
+  -9.68522094274335776376e-01,
+  -9.68139104746280620972e-01,
+  -9.67753837093393132207e-01,
+  -9.67366292222245682808e-01,
+  -9.66976471044768692842e-01,
+  -9.66584374478249186424e-01,
+  -9.66190003445328127185e-01,
+  -9.65793358873998752934e-01,
+  -9.65394441697603911123e-01,
+  -9.64993252854834393517e-01,
+  -9.64589793289726160630e-01,
+  -9.64184063951658676395e-01,
+  -9.63776065795352243626e-01,
+  -9.63365799780865894597e-01,
+  -9.62953266873595281616e-01,
+  -9.62538468044270234536e-01,
+  -9.62121404268952096217e-01,
+  -9.61702076529032501284e-01,
+  -9.61280485811230156479e-01,
+  -9.60856633107588620213e-01,
+  -9.60430519415474193146e-01,
+  -9.60002145737573808759e-01,
+  -9.59571513081891924735e-01,
+  -9.59138622461748746595e-01,
+  -9.58703474895777896236e-01,
+  -9.58266071407923414327e-01,
+  -9.57826413027438094971e-01,
+  -9.57384500788880599131e-01,
+  -9.56940335732113012135e-01,
+  -9.56493918902298734253e-01,
+  -9.56045251349899816162e-01,
+  -9.55594334130673961347e-01,
+  -9.55141168305673082806e-01,
+  -9.54685754941240194427e-01,
+  -9.54228095109006857477e-01,
+  -9.53768189885891071178e-01,
+  -9.53306040354094053058e-01,
+  -9.52841647601098351572e-01,
+  -9.52375012719664959526e-01,
+  -9.51906136807830871582e-01,
+  -9.51435020968906419725e-01,
+  -9.50961666311472608726e-01,
+  -9.50486073949378673653e-01,
+  -9.50008245001739526359e-01,
+  -9.49528180592932535831e-01,
+  -9.49045881852596195927e-01,
+  -9.48561349915625462437e-01,
+  -9.48074585922170864905e-01,
+  -9.47585591017635175959e-01,
+  -9.47094366352670746778e-01,
+  -9.46600913083176620511e-01,
+  -9.46105232370295867739e-01,
+  -9.45607325380413255012e-01,
+  -9.45107193285151914175e-01,
+  -9.44604837261371121926e-01,
+  -9.44100258491162969143e-01,
+  -9.43593458161850140442e-01,
+  -9.43084437465982694526e-01,
+  -9.42573197601335621698e-01,
+  -9.42059739770905513190e-01,
+  -9.41544065182908784806e-01,
+  -9.41026175050776680919e-01,
+  -9.40506070593155163451e-01,
+  -9.39983753033900359952e-01,
+  -9.39459223602075677029e-01,
+  -9.38932483531949801936e-01,
+  -9.38403534062992816800e-01,
+  -9.37872376439874089193e-01,
+  -9.37339011912458608400e-01,
+  -9.36803441735804764967e-01,
+  -9.36265667170160797994e-01,
+  -9.35725689480962463662e-01,
+  -9.35183509938829149455e-01,
+  -9.34639129819561764734e-01,
+  -9.34092550404139632114e-01,
+  -9.33543772978716379640e-01,
+  -9.32992798834618608517e-01,
+  -9.32439629268341563240e-01,
+  -9.31884265581546689106e-01,
+  -9.31326709081058523587e-01,
+  -9.30766961078861254641e-01,
+  -9.30205022892096056175e-01,
+  -9.29640895843057757375e-01,
+  -9.29074581259191734084e-01,
+  -9.28506080473090911198e-01,
+  -9.27935394822492654043e-01,
+  -9.27362525650275437705e-01,
+  -9.26787474304455627383e-01,
+  -9.26210242138184591809e-01,
+  -9.25630830509745816670e-01,
+  -9.25049240782550130646e-01,
+  -9.24465474325134595190e-01,
+  -9.23879532511158174657e-01,
+  -9.23291416719398516655e-01,
+  -9.22701128333748954446e-01,
+  -9.22108668743214954233e-01,
+  -9.21514039341911228576e-01,
+  -9.20917241529058183680e-01,
+  -9.20318276708978810774e-01,
+  -9.19717146291095022370e-01,
+  -9.19113851689924876709e-01,
+  -9.18508394325078803000e-01,
+  -9.17900775621256492798e-01,
+  -9.17290997008243458311e-01,
+  -9.16679059920908034798e-01,
+  -9.16064965799196495588e-01,
+  -9.15448716088132052882e-01,
+  -9.14830312237809861742e-01,
+  -9.14209755703393800452e-01,
+  -9.13587047945113472913e-01,
+  -9.12962190428260211839e-01,
+  -9.12335184623184303199e-01,
+  -9.11706032005290878395e-01,
+  -9.11074734055036805636e-01,
+  -9.10441292257927137221e-01,
+  -9.09805708104511667855e-01,
+  -9.09167983090381270905e-01,
+  -9.08528118716164456714e-01,
+  -9.07886116487523930907e-01,
+  -9.07241977915153485768e-01,
+  -9.06595704514772449123e-01,
+  -9.05947297807125018210e-01,
+  -9.05296759317974708559e-01,
+  -9.04644090578101689459e-01,
+  -9.03989293123298232047e-01,
+  -9.03332368494366155787e-01,
+  -9.02673318237112609630e-01,
+  -9.02012143902346408275e-01,
+  -9.01348847045874812522e-01,
+  -9.00683429228499088381e-01,
+  -9.00015892016011842536e-01,
+  -8.99346236979192692473e-01,
+  -8.98674465693804380706e-01,
+  -8.98000579740590221256e-01,
+  -8.97324580705268215475e-01,
+  -8.96646470178529497730e-01,
+  -8.95966249756034005536e-01,
+  -8.95283921038405816617e-01,
+  -8.94599485631230373350e-01,
+  -8.93912945145050485962e-01,
+  -8.93224301195362002659e-01,
+  -8.92533555402610701002e-01,
+  -8.91840709392188291105e-01,
+  -8.91145764794428307809e-01,
+  -8.90448723244602335924e-01,
+  -8.89749586382916790583e-01,
+  -8.89048355854508032259e-01,
+  -8.88345033309439147118e-01,
+  -8.87639620402696727375e-01,
+  -8.86932118794184431998e-01,
+  -8.86222530148722320575e-01,
+  -8.85510856136041080156e-01,
+  -8.84797098430778361511e-01,
+  -8.84081258712475004380e-01,
+  -8.83363338665571151687e-01,
+  -8.82643339979401808648e-01,
+  -8.81921264348193512106e-01,
+  -8.81197113471059889633e-01,
+  -8.80470889051998106822e-01,
+  -8.79742592799884204346e-01,
+  -8.79012226428469767292e-01,
+  -8.78279791656377262221e-01,
+  -8.77545290207096484458e-01,
+  -8.76808723808980783332e-01,
+  -8.76070094195241177992e-01,
+  -8.75329403103944803100e-01,
+  -8.74586652278009579753e-01,
+  -8.73841843465199774599e-01,
+  -8.73094978418122447117e-01,
+  -8.72346058894223341795e-01,
+  -8.71595086655782336216e-01,
+  -8.70842063469909666296e-01,
+  -8.70086991108541596418e-01,
+  -8.69329871348436422629e-01,
+  -8.68570705971170031745e-01,
+  -8.67809496763131904551e-01,
+  -8.67046245515520674907e-01,
+  -8.66280954024340577035e-01,
+  -8.65513624090396560540e-01,
+  -8.64744257519289294400e-01,
+  -8.63972856121413057551e-01,
+  -8.63199421711949965719e-01,
+  -8.62423956110865863600e-01,
+  -8.61646461142906106012e-01,
+  -8.60866938637591450068e-01,
+  -8.60085390429213836327e-01,
+  -8.59301818356831503820e-01,
+  -8.58516224264265326305e-01,
+  -8.57728610000094149335e-01,
+  -8.56938977417650238344e-01,
+  -8.56147328375015503887e-01,
+  -8.55353664735016394616e-01,
+  -8.54557988365220899674e-01,
+  -8.53760301137931221227e-01,
+  -8.52960604930182997307e-01,
+  -8.52158901623738529452e-01,
+  -8.51355193105083341010e-01,
+  -8.50549481265421070120e-01,
+  -8.49741768000669583927e-01,
+  -8.48932055211456204624e-01,
+  -8.48120344803113268561e-01,
+  -8.47306638685673907396e-01,
+  -8.46490938773867052092e-01,
+  -8.45673246987113547135e-01,
+  -8.44853565249521043512e-01,
+  -8.44031895489879779859e-01,
+  -8.43208239641658252594e-01,
+  -8.42382599642998664002e-01,
+  -8.41554977436710704986e-01,
+  -8.40725374970269778707e-01,
+  -8.39893794195810672321e-01,
+  -8.39060237070123338121e-01,
+  -8.38224705554648119588e-01,
+  -8.37387201615471532534e-01,
+  -8.36547727223321047063e-01,
+  -8.35706284353561090761e-01,
+  -8.34862874986188052695e-01,
+  -8.34017501105825509455e-01,
+  -8.33170164701720117328e-01,
+  -8.32320867767735950160e-01,
+  -8.31469612302351057664e-01,
+  -8.30616400308651581241e-01,
+  -8.29761233794328312285e-01,
+  -8.28904114771669586759e-01,
+  -8.28045045257559952923e-01,
+  -8.27184027273472732844e-01,
+  -8.26321062845466580704e-01,
+  -8.25456154004180042705e-01,
+  -8.24589302784827338222e-01,
+  -8.23720511227192919712e-01,
+  -8.22849781375627253865e-01,
+  -8.21977115279042047646e-01,
+  -8.21102514990904586156e-01,
+  -8.20225982569234068897e-01,
+  -8.19347520076595836613e-01,
+  -8.18467129580096930397e-01,
+  -8.17584813151381428753e-01,
+  -8.16700572866625562618e-01,
+  -8.15814410806531054021e-01,
+  -8.14926329056323228706e-01,
+  -8.14036329705744465812e-01,
+  -8.13144414849049201877e-01,
+  -8.12250586584999045847e-01,
+  -8.11354847016858338193e-01,
+  -8.10457198252388821835e-01,
+  -8.09557642403844757162e-01,
+  -8.08656181587967926028e-01,
+  -8.07752817925982746772e-01,
+  -8.06847553543591167191e-01,
+  -8.05940390570967668538e-01,
+  -8.05031331142754491559e-01,
+  -8.04120377398056529472e-01,
+  -8.03207531480435221738e-01,
+  -8.02292795537905556458e-01,
+  -8.01376171722929520058e-01,
+  -8.00457662192411545377e-01,
+  -7.99537269107693182590e-01,
+  -7.98614994634548547303e-01,
+  -7.97690840943178214317e-01,
+  -7.96764810208205331854e-01,
+  -7.95836904608669626349e-01,
+  -7.94907126328022517470e-01,
+  -7.93975477554122233137e-01,
+  -7.93041960479228147385e-01,
+  -7.92106577299996339470e-01,
+  -7.91169330217473598665e-01,
+  -7.90230221437093538484e-01,
+  -7.89289253168668603067e-01,
+  -7.88346427626388623899e-01,
+  -7.87401747028813270290e-01,
+  -7.86455213598867053371e-01,
+  -7.85506829563834774177e-01,
+  -7.84556597155355528450e-01,
+  -7.83604518609418043695e-01,
+  -7.82650596166355017047e-01,
+  -7.81694832070838119265e-01,
+  -7.80737228571872665661e-01,
+  -7.79777787922792176012e-01,
+  -7.78816512381253045483e-01,
+  -7.77853404209229659649e-01,
+  -7.76888465673008510315e-01,
+  -7.75921699043183754618e-01,
+  -7.74953106594649443473e-01,
+  -7.73982690606597856231e-01,
+  -7.73010453362511507081e-01,
+  -7.72036397150158482106e-01,
+  -7.71060524261587221240e-01,
+  -7.70082836993120967151e-01,
+  -7.69103337645352103102e-01,
+  -7.68122028523137267975e-01,
+  -7.67138911935591805147e-01,
+  -7.66153990196083767295e-01,
+  -7.65167265622229253452e-01,
+  -7.64178740535886524832e-01,
+  -7.63188417263150564729e-01,
+  -7.62196298134348304565e-01,
+  -7.61202385484030630280e-01,
+  -7.60206681650970717001e-01,
+  -7.59209188978155813388e-01,
+  -7.58209909812782578697e-01,
+  -7.57208846506251309627e-01,
+  -7.56206001414160722263e-01,
+  -7.55201376896302289943e-01,
+  -7.54194975316654359077e-01,
+  -7.53186799043377153140e-01,
+  -7.52176850448806888494e-01,
+  -7.51165131909450001224e-01,
+  -7.50151645805978151138e-01,
+  -7.49136394523221893493e-01,
+  -7.48119380450165682994e-01,
+  -7.47100605979942322676e-01,
+  -7.46080073509825414391e-01,
+  -7.45057785441227138357e-01,
+  -7.44033744179689926490e-01,
+  -7.43007952134881799466e-01,
+  -7.41980411720590593561e-01,
+  -7.40951125354718187488e-01,
+  -7.39920095459274729244e-01,
+  -7.38887324460373196011e-01,
+  -7.37852814788223509979e-01,
+  -7.36816568877126876203e-01,
+  -7.35778589165470009448e-01,
+  -7.34738878095719472050e-01,
+  -7.33697438114415678712e-01,
+  -7.32654271672167789475e-01,
+  -7.31609381223647603498e-01,
+  -7.30562769227582120557e-01,
+  -7.29514438146750987535e-01,
+  -7.28464390447978726861e-01,
+  -7.27412628602128741306e-01,
+  -7.26359155084098429001e-01,
+  -7.25303972372812744140e-01,
+  -7.24247082951218312807e-01,
+  -7.23188489306278325941e-01,
+  -7.22128193928965766979e-01,
+  -7.21066199314257971764e-01,
+  -7.20002507961131077430e-01,
+  -7.18937122372553361060e-01,
+  -7.17870045055480132667e-01,
+  -7.16801278520847406917e-01,
+  -7.15730825283566574058e-01,
+  -7.14658687862516517342e-01,
+  -7.13584868780540504396e-01,
+  -7.12509370564438748730e-01,
+  -7.11432195744962414530e-01,
+  -7.10353346856807732479e-01,
+  -7.09272826438610559663e-01,
+  -7.08190637032939718232e-01,
+  -7.07106781186291444286e-01,
+  -7.06021261449083170625e-01,
+  -7.04934080375647753591e-01,
+  -7.03845240524227366841e-01,
+  -7.02754744456967173072e-01,
+  -7.01662594739909883934e-01,
+  -7.00568793942989875845e-01,
+  -6.99473344640024863317e-01,
+  -6.98376249408713345446e-01,
+  -6.97277510830626612304e-01,
+  -6.96177131491202416669e-01,
+  -6.95075113979739866998e-01,
+  -6.93971460889392544047e-01,
+  -6.92866174817162616684e-01,
+  -6.91759258363895290778e-01,
+  -6.90650714134271592748e-01,
+  -6.89540544736803373560e-01,
+  -6.88428752783826425343e-01,
+  -6.87315340891494597209e-01,
+  -6.86200311679773578000e-01,
+  -6.85083667772434901089e-01,
+  -6.83965411797050060194e-01,
+  -6.82845546384982182708e-01,
+  -6.81724074171383365162e-01,
+  -6.80600997795186124506e-01,
+  -6.79476319899097624955e-01,
+  -6.78350043129593571756e-01,
+  -6.77222170136912104965e-01,
+  -6.76092703575047138109e-01,
+  -6.74961646101742696047e-01,
+  -6.73829000378486253631e-01,
+  -6.72694769070502518460e-01,
+  -6.71558954846747546696e-01,
+  -6.70421560379901748661e-01,
+  -6.69282588346364226695e-01,
+  -6.68142041426246224844e-01,
+  -6.66999922303365355702e-01,
+  -6.65856233665237051689e-01,
+  -6.64710978203071678472e-01,
+  -6.63564158611766097273e-01,
+  -6.62415777589897669664e-01,
+  -6.61265837839717596225e-01,
+  -6.60114342067145365434e-01,
+  -6.58961292981761759258e-01,
+  -6.57806693296802524884e-01,
+  -6.56650545729152379515e-01,
+  -6.55492852999338238007e-01,
+  -6.54333617831522884600e-01,
+  -6.53172842953498644647e-01,
+  -6.52010531096680945318e-01,
+  -6.50846684996101876308e-01,
+  -6.49681307390404305657e-01,
+  -6.48514401021833108985e-01,
+  -6.47345968636232282911e-01,
+  -6.46176012983036063275e-01,
+  -6.45004536815263151972e-01,
+  -6.43831542889510166638e-01,
+  -6.42657033965945090337e-01,
+  -6.41481012808300832262e-01,
+  -6.40303482183868899469e-01,
+  -6.39124444863492513491e-01,
+  -6.37943903621560282069e-01,
+  -6.36761861235999981901e-01,
+  -6.35578320488271453215e-01,
+  -6.34393284163360271499e-01,
+  -6.33206755049772307409e-01,
+  -6.32018735939523512712e-01,
+  -6.30829229628138588026e-01,
+  -6.29638238914640546717e-01,
+  -6.28445766601545829921e-01,
+  -6.27251815494856757027e-01,
+  -6.26056388404055641494e-01,
+  -6.24859488142098018493e-01,
+  -6.23661117525405761519e-01,
+  -6.22461279373860643105e-01,
+  -6.21259976510797784499e-01,
+  -6.20057211762998883309e-01,
+  -6.18852987960685552160e-01,
+  -6.17647307937512657361e-01,
+  -6.16440174530561879607e-01,
+  -6.15231590580335385710e-01,
+  -6.14021558930746502725e-01,
+  -6.12810082429117275460e-01,
+  -6.11597163926169029580e-01,
+  -6.10382806276016043334e-01,
+  -6.09167012336159330310e-01,
+  -6.07949784967479311959e-01,
+  -6.06731127034229711370e-01,
+  -6.05511041404030225799e-01,
+  -6.04289530947860309418e-01,
+  -6.03066598540051956867e-01,
+  -6.01842247058283374983e-01,
+  -6.00616479383571766348e-01,
+  -5.99389298400266889999e-01,
+  -5.98160706996044178041e-01,
+  -5.96930708061898629424e-01,
+  -5.95699304492135039979e-01,
+  -5.94466499184365670949e-01,
+  -5.93232295039500590050e-01,
+  -5.91996694961741232177e-01,
+  -5.90759701858574071132e-01,
+  -5.89521318640763181129e-01,
+  -5.88281548222344130572e-01,
+  -5.87040393520616432532e-01,
+  -5.85797857456136772392e-01,
+  -5.84553942952712790593e-01,
+  -5.83308652937395311078e-01,
+  -5.82061990340472124039e-01,
+  -5.80813958095460658448e-01,
+  -5.79564559139101320717e-01,
+  -5.78313796411351388471e-01,
+  -5.77061672855374907520e-01,
+  -5.75808191417540249368e-01,
+  -5.74553355047410230227e-01,
+  -5.73297166697736226837e-01,
+  -5.72039629324450626946e-01,
+  -5.70780745886660390020e-01,
+  -5.69520519346639830793e-01,
+  -5.68258952669823735881e-01,
+  -5.66996048824800369381e-01,
+  -5.65731810783304478463e-01,
+  -5.64466241520210298965e-01,
+  -5.63199344013524449970e-01,
+  -5.61931121244379272461e-01,
+  -5.60661576197026167989e-01,
+  -5.59390711858825828706e-01,
+  -5.58118531220245350788e-01,
+  -5.56845037274848908559e-01,
+  -5.55570233019290538046e-01,
+  -5.54294121453308030745e-01,
+  -5.53016705579714940022e-01,
+  -5.51737988404394363862e-01,
+  -5.50457972936291395349e-01,
+  -5.49176662187405795201e-01,
+  -5.47894059172785774514e-01,
+  -5.46610166910520112182e-01,
+  -5.45324988421731160493e-01,
+  -5.44038526730568183787e-01,
+  -5.42750784864199697921e-01,
+  -5.41461765852807586086e-01,
+  -5.40171472729576551686e-01,
+  -5.38879908530691675850e-01,
+  -5.37587076295328314401e-01,
+  -5.36292979065645547543e-01,
+  -5.34997619886779074427e-01,
+  -5.33701001806834440799e-01,
+  -5.32403127876879045388e-01,
+  -5.31104001150935589592e-01,
+  -5.29803624685974750008e-01,
+  -5.28502001541908184024e-01,
+  -5.27199134781580647235e-01,
+  -5.25895027470763443134e-01,
+  -5.24589682678147317674e-01,
+  -5.23283103475334354648e-01,
+  -5.21975292936832535595e-01,
+  -5.20666254140044970633e-01,
+  -5.19355990165266900860e-01,
+  -5.18044504095676261457e-01,
+  -5.16731799017326354218e-01,
+  -5.15417878019139075185e-01,
+  -5.14102744192897365139e-01,
+  -5.12786400633238215185e-01,
+  -5.11468850437645117246e-01,
+  -5.10150096706441069649e-01,
+  -5.08830142542780916592e-01,
+  -5.07508991052644242714e-01,
+  -5.06186645344828267667e-01,
+  -5.04863108530940074559e-01,
+  -5.03538383725389726564e-01,
+  -5.02212474045383272525e-01,
+  -5.00885382610912865964e-01,
+  -4.99557112544753489924e-01,
+  -4.98227666972453020477e-01,
+  -4.96897049022325287826e-01,
+  -4.95565261825442859855e-01,
+  -4.94232308515629603640e-01,
+  -4.92898192229453524504e-01,
+  -4.91562916106218994461e-01,
+  -4.90226483287959757806e-01,
+  -4.88888896919431381605e-01,
+  -4.87550160148103706170e-01,
+  -4.86210276124153739641e-01,
+  -4.84869248000457997438e-01,
+  -4.83527078932586007465e-01,
+  -4.82183772078789596449e-01,
+  -4.80839330600000391946e-01,
+  -4.79493757659818997663e-01,
+  -4.78147056424508609673e-01,
+  -4.76799230062987300371e-01,
+  -4.75450281746820635487e-01,
+  -4.74100214650214346612e-01,
+  -4.72749031950006670666e-01,
+  -4.71396736825661133441e-01,
+  -4.70043332459258667022e-01,
+  -4.68688822035490559870e-01,
+  -4.67333208741650685258e-01,
+  -4.65976495767628007272e-01,
+  -4.64618686305899197819e-01,
+  -4.63259783551521975298e-01,
+  -4.61899790702124113384e-01,
+  -4.60538710957900943033e-01,
+  -4.59176547521604638824e-01,
+  -4.57813303598537335581e-01,
+  -4.56448982396543634366e-01,
+  -4.55083587126003108470e-01,
+  -4.53717120999822753902e-01,
+  -4.52349587233429328847e-01,
+  -4.50980989044761915174e-01,
+  -4.49611329654264257893e-01,
+  -4.48240612284877160132e-01,
+  -4.46868840162031044638e-01,
+  -4.45496016513638182222e-01,
+  -4.44122144570085253257e-01,
+  -4.42747227564226464303e-01,
+  -4.41371268731372723426e-01,
+  -4.39994271309288864646e-01,
+  -4.38616238538182823259e-01,
+  -4.37237173660698918987e-01,
+  -4.35857079921909862374e-01,
+  -4.34475960569309704873e-01,
+  -4.33093818852805567676e-01,
+  -4.31710658024710480785e-01,
+  -4.30326481339735444909e-01,
+  -4.28941292054981881954e-01,
+  -4.27555093429934085503e-01,
+  -4.26167888726451227210e-01,
+  -4.24779681208760029332e-01,
+  -4.23390474143446826627e-01,
+  -4.22000270799450905024e-01,
+  -4.20609074448053343875e-01,
+  -4.19216888362874406937e-01,
+  -4.17823715819862329113e-01,
+  -4.16429560097286821652e-01,
+  -4.15034424475730856496e-01,
+  -4.13638312238083394323e-01,
+  -4.12241226669531335425e-01,
+  -4.10843171057552025704e-01,
+  -4.09444148691905318582e-01,
+  -4.08044162864625969966e-01,
+  -4.06643216870015922204e-01,
+  -4.05241314004636365986e-01,
+  -4.03838457567300246343e-01,
+  -4.02434650859064990680e-01,
+  -4.01029897183221795132e-01,
+  -3.99624199845292626954e-01,
+  -3.98217562153019011273e-01,
+  -3.96809987416355369749e-01,
+  -3.95401478947460971458e-01,
+  -3.93992040060692383374e-01,
+  -3.92581674072595365743e-01,
+  -3.91170384301897378077e-01,
+  -3.89758174069499585546e-01,
+  -3.88345046698469031909e-01,
+  -3.86931005514030923464e-01,
+  -3.85516053843560857484e-01,
+  -3.84100195016576662077e-01,
+  -3.82683432364730957698e-01,
+  -3.81265769221804051714e-01,
+  -3.79847208923692447602e-01,
+  -3.78427754808406513476e-01,
+  -3.77007410216058769237e-01,
+  -3.75586178488857391766e-01,
+  -3.74164062971097777233e-01,
+  -3.72741067009155213618e-01,
+  -3.71317193951476609559e-01,
+  -3.69892447148572778293e-01,
+  -3.68466829953010610588e-01,
+  -3.67040345719405136649e-01,
+  -3.65612997804411421487e-01,
+  -3.64184789566717070919e-01,
+  -3.62755724367034071420e-01,
+  -3.61325805568090741016e-01,
+  -3.59895036534625067937e-01,
+  -3.58463420633373108792e-01,
+  -3.57030961233066213012e-01,
+  -3.55597661704419698570e-01,
+  -3.54163525420125857579e-01,
+  -3.52728555754845796155e-01,
+  -3.51292756085201884897e-01,
+  -3.49856129789769321192e-01,
+  -3.48418680249068579702e-01,
+  -3.46980410845557307731e-01,
+  -3.45541324963622387134e-01,
+  -3.44101425989571774178e-01,
+  -3.42660717311627005532e-01,
+  -3.41219202319914649557e-01,
+  -3.39776884406458756782e-01,
+  -3.38333766965173532437e-01,
+  -3.36889853391852067688e-01,
+  -3.35445147084163286522e-01,
+  -3.33999651441640676985e-01,
+  -3.32553369865675185757e-01,
+  -3.31106305759507002495e-01,
+  -3.29658462528217732768e-01,
+  -3.28209843578722404445e-01,
+  -3.26760452319761307560e-01,
+  -3.25310292161892111729e-01,
+  -3.23859366517481761516e-01,
+  -3.22407678800698371813e-01,
+  -3.20955232427503400761e-01,
+  -3.19502030815643489614e-01,
+  -3.18048077384643246290e-01,
+  -3.16593375555793810072e-01,
+  -3.15137928752150020539e-01,
+  -3.13681740398518760227e-01,
+  -3.12224813921451849197e-01,
+  -3.10767152749238106946e-01,
+  -3.09308760311894970219e-01,
+  -3.07849640041160832471e-01,
+  -3.06389795370486495152e-01,
+  -3.04929229735027618187e-01,
+  -3.03467946571636226771e-01,
+  -3.02005949318852606744e-01,
+  -3.00543241416897699558e-01,
+  -2.99079826307664387031e-01,
+  -2.97615707434709775292e-01,
+  -2.96150888243247922826e-01,
+  -2.94685372180138072107e-01,
+  -2.93219162693882040571e-01,
+  -2.91752263234612341236e-01,
+  -2.90284677254085132780e-01,
+  -2.88816408205671892873e-01,
+  -2.87347459544351591099e-01,
+  -2.85877834726702362289e-01,
+  -2.84407537210893290869e-01,
+  -2.82936570456676472762e-01,
+  -2.81464937925378744232e-01,
+  -2.79992643079893688274e-01,
+  -2.78519689384673252430e-01,
+  -2.77046080305719699677e-01,
+  -2.75571819310577670326e-01,
+  -2.74096909868326410464e-01,
+  -2.72621355449568669727e-01,
+  -2.71145159526427426133e-01,
+  -2.69668325572534173240e-01,
+  -2.68190857063021925732e-01,
+  -2.66712757474516781731e-01,
+  -2.65234030285129929183e-01,
+  -2.63754678974449152662e-01,
+  -2.62274707023531117311e-01,
+  -2.60794117914892653598e-01,
+  -2.59312915132503096771e-01,
+  -2.57831102161775516102e-01,
+  -2.56348682489559109854e-01,
+  -2.54865659604130490035e-01,
+  -2.53382036995185744299e-01,
+  -2.51897818153833108479e-01,
+  -2.50413006572581087195e-01,
+  -2.48927605745335706056e-01,
+  -2.47441619167388521250e-01,
+  -2.45955050335409514117e-01,
+  -2.44467902747438764477e-01,
+  -2.42980179902878179465e-01,
+  -2.41491885302483333398e-01,
+  -2.40003022448355168850e-01,
+  -2.38513594843931836520e-01,
+  -2.37023605993980285289e-01,
+  -2.35533059404588296371e-01,
+  -2.34041958583155906837e-01,
+  -2.32550307038387416014e-01,
+  -2.31058108280283863722e-01,
+  -2.29565365820131345176e-01,
+  -2.28072083170497902360e-01,
+  -2.26578263845221866690e-01,
+  -2.25083911359404392760e-01,
+  -2.23589029229401270449e-01,
+  -2.22093620972814514980e-01,
+  -2.20597690108484206784e-01,
+  -2.19101240156480192578e-01,
+  -2.17604274638093730943e-01,
+  -2.16106797075829332178e-01,
+  -2.14608810993396292854e-01,
+  -2.13110319915700618942e-01,
+  -2.11611327368836532603e-01,
+  -2.10111836880078284295e-01,
+  -2.08611851977872742037e-01,
+  -2.07111376191827512017e-01,
+  -2.05610413052707940995e-01,
+  -2.04108966092425264671e-01,
+  -2.02607038844029224700e-01,
+  -2.01104634841699742021e-01,
+  -1.99601757620738506915e-01,
+  -1.98098410717560846628e-01,
+  -1.96594597669687204400e-01,
+  -1.95090322015734979333e-01,
+  -1.93585587295410060937e-01,
+  -1.92080397049498585726e-01,
+  -1.90574754819858638299e-01,
+  -1.89068664149411813646e-01,
+  -1.87562128582134918231e-01,
+  -1.86055151663052587008e-01,
+  -1.84547736938225265257e-01,
+  -1.83039887954746349763e-01,
+  -1.81531608260730115134e-01,
+  -1.80022901405304358580e-01,
+  -1.78513770938602100991e-01,
+  -1.77004220411753065978e-01,
+  -1.75494253376875464223e-01,
+  -1.73983873387067611294e-01,
+  -1.72473083996399462192e-01,
+  -1.70961888759904478974e-01,
+  -1.69450291233570943250e-01,
+  -1.67938294974333879317e-01,
+  -1.66425903540066560948e-01,
+  -1.64913120489572101457e-01,
+  -1.63399949382576042956e-01,
+  -1.61886393779714393704e-01,
+  -1.60372457242530547239e-01,
+  -1.58858143333463458502e-01,
+  -1.57343455615840038808e-01,
+  -1.55828397653866745909e-01,
+  -1.54312973012621368341e-01,
+  -1.52797185258044421197e-01,
+  -1.51281037956930958233e-01,
+  -1.49764534676922023149e-01,
+  -1.48247678986496295162e-01,
+  -1.46730474454961734576e-01,
+  -1.45212924652447200602e-01,
+  -1.43695033149893958146e-01,
+  -1.42176803519048183810e-01,
+  -1.40658239332449114256e-01,
+  -1.39139344163425854317e-01,
+  -1.37620121586085442100e-01,
+  -1.36100575175305354980e-01,
+  -1.34580708506725071905e-01,
+  -1.33060525156737718966e-01,
+  -1.31540028702481520684e-01,
+  -1.30019222721831528844e-01,
+  -1.28498110793391101536e-01,
+  -1.26976696496483548726e-01,
+  -1.25454983411143694561e-01,
+  -1.23932975118109384161e-01,
+  -1.22410675198813184705e-01,
+  -1.20888087235373822836e-01,
+  -1.19365214810588760042e-01,
+  -1.17842061507922132857e-01,
+  -1.16318630911501685876e-01,
+  -1.14794926606106781342e-01,
+  -1.13270952177160807994e-01,
+  -1.11746711210722826646e-01,
+  -1.10222207293479063095e-01,
+  -1.08697444012734484309e-01,
+  -1.07172424956404388485e-01,
+  -1.05647153713005925724e-01,
+  -1.04121633871649674208e-01,
+  -1.02595869022031160878e-01,
+  -1.01069862754422465367e-01,
+  -9.95436186596637545554e-02,
+  -9.80171403291548032355e-02,
+  -9.64904313548474584783e-02,
+  -9.49634953292336353448e-02,
+  -9.34363358453422082617e-02,
+  -9.19089564967269373463e-02,
+  -9.03813608774589605233e-02,
+  -8.88535525821183697071e-02,
+  -8.73255352057856204517e-02,
+  -8.57973123440332330336e-02,
+  -8.42688875929171882229e-02,
+  -8.27402645489686006108e-02,
+  -8.12114468091851282594e-02,
+  -7.96824379710226043949e-02,
+  -7.81532416323865164465e-02,
+  -7.66238613916235544732e-02,
+  -7.50943008475131734691e-02,
+  -7.35645635992599605801e-02,
+  -7.20346532464816585728e-02,
+  -7.05045733892059878212e-02,
+  -6.89743276278586697758e-02,
+  -6.74439195632557803028e-02,
+  -6.59133527965953258665e-02,
+  -6.43826309294487780788e-02,
+  -6.28517575637525249821e-02,
+  -6.13207363017994888654e-02,
+  -5.97895707462305844859e-02,
+  -5.82582645000262744350e-02,
+  -5.67268211664980689934e-02,
+  -5.51952443492800606806e-02,
+  -5.36635376523204518651e-02,
+  -5.21317046798739358593e-02,
+  -5.05997490364897065107e-02,
+  -4.90676743270082454940e-02,
+  -4.75354841565493457800e-02,
+  -4.60031821305044788528e-02,
+  -4.44707718545283292588e-02,
+  -4.29382569345302944619e-02,
+  -4.14056409766660263316e-02,
+  -3.98729275873289101817e-02,
+  -3.83401203731416062581e-02,
+  -3.68072229409475565332e-02,
+  -3.52742388978024914992e-02,
+  -3.37411718509659439014e-02,
+  -3.22080254078927624706e-02,
+  -3.06748031762246221865e-02,
+  -2.91415087637824296585e-02,
+  -2.76081457785542667971e-02,
+  -2.60747178286922474955e-02,
+  -2.45412285225004578315e-02,
+  -2.30076814684273649181e-02,
+  -2.14740802750573271662e-02,
+  -1.99404285511020837318e-02,
+  -1.84067299053922925345e-02,
+  -1.68729879468690127653e-02,
+  -1.53392062845752272932e-02,
+  -1.38053885276473477239e-02,
+  -1.22715382853067125207e-02,
+  -1.07376591668511094102e-02,
+  -9.20375478164627003341e-03,
+  -7.66982873911738194384e-03,
+  -6.13588464874148184491e-03,
+  -4.60192612003541313970e-03,
+  -3.06795676255265442264e-03,
+  -1.53398018587128114922e-03,
+};
+const short ISINETABLE[4096] = {  0,
+  2,
+  3,
+  5,
+  6,
+  8,
+  9,
+  11,
+  13,
+  14,
+  16,
+  17,
+  19,
+  20,
+  22,
+  24,
+  25,
+  27,
+  28,
+  30,
+  31,
+  33,
+  35,
+  36,
+  38,
+  39,
+  41,
+  42,
+  44,
+  46,
+  47,
+  49,
+  50,
+  52,
+  53,
+  55,
+  57,
+  58,
+  60,
+  61,
+  63,
+  64,
+  66,
+  67,
+  69,
+  71,
+  72,
+  74,
+  75,
+  77,
+  78,
+  80,
+  82,
+  83,
+  85,
+  86,
+  88,
+  89,
+  91,
+  93,
+  94,
+  96,
+  97,
+  99,
+  100,
+  102,
+  103,
+  105,
+  107,
+  108,
+  110,
+  111,
+  113,
+  114,
+  116,
+  118,
+  119,
+  121,
+  122,
+  124,
+  125,
+  127,
+  128,
+  130,
+  132,
+  133,
+  135,
+  136,
+  138,
+  139,
+  141,
+  142,
+  144,
+  146,
+  147,
+  149,
+  150,
+  152,
+  153,
+  155,
+  156,
+  158,
+  160,
+  161,
+  163,
+  164,
+  166,
+  167,
+  169,
+  170,
+  172,
+  174,
+  175,
+  177,
+  178,
+  180,
+  181,
+  183,
+  184,
+  186,
+  187,
+  189,
+  191,
+  192,
+  194,
+  195,
+  197,
+  198,
+  200,
+  201,
+  203,
+  204,
+  206,
+  207,
+  209,
+  211,
+  212,
+  214,
+  215,
+  217,
+  218,
+  220,
+  221,
+  223,
+  224,
+  226,
+  227,
+  229,
+  230,
+  232,
+  234,
+  235,
+  237,
+  238,
+  240,
+  241,
+  243,
+  244,
+  246,
+  247,
+  249,
+  250,
+  252,
+  253,
+  255,
+  256,
+  258,
+  259,
+  261,
+  263,
+  264,
+  266,
+  267,
+  269,
+  270,
+  272,
+  273,
+  275,
+  276,
+  278,
+  279,
+  281,
+  282,
+  284,
+  285,
+  287,
+  288,
+  290,
+  291,
+  293,
+  294,
+  296,
+  297,
+  299,
+  300,
+  302,
+  303,
+  305,
+  306,
+  308,
+  309,
+  311,
+  312,
+  314,
+  315,
+  317,
+  318,
+  320,
+  321,
+  323,
+  324,
+  326,
+  327,
+  329,
+  330,
+  332,
+  333,
+  335,
+  336,
+  338,
+  339,
+  341,
+  342,
+  343,
+  345,
+  346,
+  348,
+  349,
+  351,
+  352,
+  354,
+  355,
+  357,
+  358,
+  360,
+  361,
+  363,
+  364,
+  366,
+  367,
+  369,
+  370,
+  371,
+  373,
+  374,
+  376,
+  377,
+  379,
+  380,
+  382,
+  383,
+  385,
+  386,
+  388,
+  389,
+  390,
+  392,
+  393,
+  395,
+  396,
+  398,
+  399,
+  401,
+  402,
+  403,
+  405,
+  406,
+  408,
+  409,
+  411,
+  412,
+  414,
+  415,
+  416,
+  418,
+  419,
+  421,
+  422,
+  424,
+  425,
+  426,
+  428,
+  429,
+  431,
+  432,
+  434,
+  435,
+  436,
+  438,
+  439,
+  441,
+  442,
+  443,
+  445,
+  446,
+  448,
+  449,
+  451,
+  452,
+  453,
+  455,
+  456,
+  458,
+  459,
+  460,
+  462,
+  463,
+  465,
+  466,
+  467,
+  469,
+  470,
+  472,
+  473,
+  474,
+  476,
+  477,
+  479,
+  480,
+  481,
+  483,
+  484,
+  485,
+  487,
+  488,
+  490,
+  491,
+  492,
+  494,
+  495,
+  497,
+  498,
+  499,
+  501,
+  502,
+  503,
+  505,
+  506,
+  507,
+  509,
+  510,
+  512,
+  513,
+  514,
+  516,
+  517,
+  518,
+  520,
+  521,
+  522,
+  524,
+  525,
+  526,
+  528,
+  529,
+  530,
+  532,
+  533,
+  535,
+  536,
+  537,
+  539,
+  540,
+  541,
+  543,
+  544,
+  545,
+  547,
+  548,
+  549,
+  550,
+  552,
+  553,
+  554,
+  556,
+  557,
+  558,
+  560,
+  561,
+  562,
+  564,
+  565,
+  566,
+  568,
+  569,
+  570,
+  572,
+  573,
+  574,
+  575,
+  577,
+  578,
+  579,
+  581,
+  582,
+  583,
+  584,
+  586,
+  587,
+  588,
+  590,
+  591,
+  592,
+  593,
+  595,
+  596,
+  597,
+  599,
+  600,
+  601,
+  602,
+  604,
+  605,
+  606,
+  607,
+  609,
+  610,
+  611,
+  613,
+  614,
+  615,
+  616,
+  618,
+  619,
+  620,
+  621,
+  623,
+  624,
+  625,
+  626,
+  628,
+  629,
+  630,
+  631,
+  632,
+  634,
+  635,
+  636,
+  637,
+  639,
+  640,
+  641,
+  642,
+  644,
+  645,
+  646,
+  647,
+  648,
+  650,
+  651,
+  652,
+  653,
+  654,
+  656,
+  657,
+  658,
+  659,
+  660,
+  662,
+  663,
+  664,
+  665,
+  666,
+  668,
+  669,
+  670,
+  671,
+  672,
+  674,
+  675,
+  676,
+  677,
+  678,
+  679,
+  681,
+  682,
+  683,
+  684,
+  685,
+  687,
+  688,
+  689,
+  690,
+  691,
+  692,
+  693,
+  695,
+  696,
+  697,
+  698,
+  699,
+  700,
+  702,
+  703,
+  704,
+  705,
+  706,
+  707,
+  708,
+  709,
+  711,
+  712,
+  713,
+  714,
+  715,
+  716,
+  717,
+  719,
+  720,
+  721,
+  722,
+  723,
+  724,
+  725,
+  726,
+  727,
+  729,
+  730,
+  731,
+  732,
+  733,
+  734,
+  735,
+  736,
+  737,
+  738,
+  739,
+  741,
+  742,
+  743,
+  744,
+  745,
+  746,
+  747,
+  748,
+  749,
+  750,
+  751,
+  752,
+  753,
+  755,
+  756,
+  757,
+  758,
+  759,
+  760,
+  761,
+  762,
+  763,
+  764,
+  765,
+  766,
+  767,
+  768,
+  769,
+  770,
+  771,
+  772,
+  773,
+  774,
+  775,
+  776,
+  777,
+  778,
+  779,
+  780,
+  782,
+  783,
+  784,
+  785,
+  786,
+  787,
+  788,
+  789,
+  790,
+  791,
+  792,
+  793,
+  794,
+  795,
+  796,
+  797,
+  798,
+  798,
+  799,
+  800,
+  801,
+  802,
+  803,
+  804,
+  805,
+  806,
+  807,
+  808,
+  809,
+  810,
+  811,
+  812,
+  813,
+  814,
+  815,
+  816,
+  817,
+  818,
+  819,
+  820,
+  821,
+  822,
+  822,
+  823,
+  824,
+  825,
+  826,
+  827,
+  828,
+  829,
+  830,
+  831,
+  832,
+  833,
+  834,
+  834,
+  835,
+  836,
+  837,
+  838,
+  839,
+  840,
+  841,
+  842,
+  843,
+  843,
+  844,
+  845,
+  846,
+  847,
+  848,
+  849,
+  850,
+  851,
+  851,
+  852,
+  853,
+  854,
+  855,
+  856,
+  857,
+  857,
+  858,
+  859,
+  860,
+  861,
+  862,
+  863,
+  863,
+  864,
+  865,
+  866,
+  867,
+  868,
+  868,
+  869,
+  870,
+  871,
+  872,
+  873,
+  873,
+  874,
+  875,
+  876,
+  877,
+  878,
+  878,
+  879,
+  880,
+  881,
+  882,
+  882,
+  883,
+  884,
+  885,
+  885,
+  886,
+  887,
+  888,
+  889,
+  889,
+  890,
+  891,
+  892,
+  893,
+  893,
+  894,
+  895,
+  896,
+  896,
+  897,
+  898,
+  899,
+  899,
+  900,
+  901,
+  902,
+  902,
+  903,
+  904,
+  905,
+  905,
+  906,
+  907,
+  907,
+  908,
+  909,
+  910,
+  910,
+  911,
+  912,
+  913,
+  913,
+  914,
+  915,
+  915,
+  916,
+  917,
+  917,
+  918,
+  919,
+  920,
+  920,
+  921,
+  922,
+  922,
+  923,
+  924,
+  924,
+  925,
+  926,
+  926,
+  927,
+  928,
+  928,
+  929,
+  930,
+  930,
+  931,
+  932,
+  932,
+  933,
+  934,
+  934,
+  935,
+  936,
+  936,
+  937,
+  937,
+  938,
+  939,
+  939,
+  940,
+  941,
+  941,
+  942,
+  942,
+  943,
+  944,
+  944,
+  945,
+  945,
+  946,
+  947,
+  947,
+  948,
+  948,
+  949,
+  950,
+  950,
+  951,
+  951,
+  952,
+  953,
+  953,
+  954,
+  954,
+  955,
+  955,
+  956,
+  957,
+  957,
+  958,
+  958,
+  959,
+  959,
+  960,
+  960,
+  961,
+  961,
+  962,
+  963,
+  963,
+  964,
+  964,
+  965,
+  965,
+  966,
+  966,
+  967,
+  967,
+  968,
+  968,
+  969,
+  969,
+  970,
+  970,
+  971,
+  971,
+  972,
+  972,
+  973,
+  973,
+  974,
+  974,
+  975,
+  975,
+  976,
+  976,
+  977,
+  977,
+  978,
+  978,
+  979,
+  979,
+  979,
+  980,
+  980,
+  981,
+  981,
+  982,
+  982,
+  983,
+  983,
+  983,
+  984,
+  984,
+  985,
+  985,
+  986,
+  986,
+  986,
+  987,
+  987,
+  988,
+  988,
+  989,
+  989,
+  989,
+  990,
+  990,
+  991,
+  991,
+  991,
+  992,
+  992,
+  993,
+  993,
+  993,
+  994,
+  994,
+  994,
+  995,
+  995,
+  996,
+  996,
+  996,
+  997,
+  997,
+  997,
+  998,
+  998,
+  998,
+  999,
+  999,
+  999,
+  1000,
+  1000,
+  1000,
+  1001,
+  1001,
+  1001,
+  1002,
+  1002,
+  1002,
+  1003,
+  1003,
+  1003,
+  1004,
+  1004,
+  1004,
+  1005,
+  1005,
+  1005,
+  1006,
+  1006,
+  1006,
+  1006,
+  1007,
+  1007,
+  1007,
+  1008,
+  1008,
+  1008,
+  1008,
+  1009,
+  1009,
+  1009,
+  1009,
+  1010,
+  1010,
+  1010,
+  1010,
+  1011,
+  1011,
+  1011,
+  1011,
+  1012,
+  1012,
+  1012,
+  1012,
+  1013,
+  1013,
+  1013,
+  1013,
+  1014,
+  1014,
+  1014,
+  1014,
+  1014,
+  1015,
+  1015,
+  1015,
+  1015,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1017,
+  1017,
+  1017,
+  1017,
+  1017,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1017,
+  1017,
+  1017,
+  1017,
+  1017,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1015,
+  1015,
+  1015,
+  1015,
+  1014,
+  1014,
+  1014,
+  1014,
+  1014,
+  1013,
+  1013,
+  1013,
+  1013,
+  1012,
+  1012,
+  1012,
+  1012,
+  1011,
+  1011,
+  1011,
+  1011,
+  1010,
+  1010,
+  1010,
+  1010,
+  1009,
+  1009,
+  1009,
+  1009,
+  1008,
+  1008,
+  1008,
+  1008,
+  1007,
+  1007,
+  1007,
+  1006,
+  1006,
+  1006,
+  1006,
+  1005,
+  1005,
+  1005,
+  1004,
+  1004,
+  1004,
+  1003,
+  1003,
+  1003,
+  1002,
+  1002,
+  1002,
+  1001,
+  1001,
+  1001,
+  1000,
+  1000,
+  1000,
+  999,
+  999,
+  999,
+  998,
+  998,
+  998,
+  997,
+  997,
+  997,
+  996,
+  996,
+  996,
+  995,
+  995,
+  994,
+  994,
+  994,
+  993,
+  993,
+  993,
+  992,
+  992,
+  991,
+  991,
+  991,
+  990,
+  990,
+  989,
+  989,
+  989,
+  988,
+  988,
+  987,
+  987,
+  986,
+  986,
+  986,
+  985,
+  985,
+  984,
+  984,
+  983,
+  983,
+  983,
+  982,
+  982,
+  981,
+  981,
+  980,
+  980,
+  979,
+  979,
+  979,
+  978,
+  978,
+  977,
+  977,
+  976,
+  976,
+  975,
+  975,
+  974,
+  974,
+  973,
+  973,
+  972,
+  972,
+  971,
+  971,
+  970,
+  970,
+  969,
+  969,
+  968,
+  968,
+  967,
+  967,
+  966,
+  966,
+  965,
+  965,
+  964,
+  964,
+  963,
+  963,
+  962,
+  961,
+  961,
+  960,
+  960,
+  959,
+  959,
+  958,
+  958,
+  957,
+  957,
+  956,
+  955,
+  955,
+  954,
+  954,
+  953,
+  953,
+  952,
+  951,
+  951,
+  950,
+  950,
+  949,
+  948,
+  948,
+  947,
+  947,
+  946,
+  945,
+  945,
+  944,
+  944,
+  943,
+  942,
+  942,
+  941,
+  941,
+  940,
+  939,
+  939,
+  938,
+  937,
+  937,
+  936,
+  936,
+  935,
+  934,
+  934,
+  933,
+  932,
+  932,
+  931,
+  930,
+  930,
+  929,
+  928,
+  928,
+  927,
+  926,
+  926,
+  925,
+  924,
+  924,
+  923,
+  922,
+  922,
+  921,
+  920,
+  920,
+  919,
+  918,
+  917,
+  917,
+  916,
+  915,
+  915,
+  914,
+  913,
+  913,
+  912,
+  911,
+  910,
+  910,
+  909,
+  908,
+  907,
+  907,
+  906,
+  905,
+  905,
+  904,
+  903,
+  902,
+  902,
+  901,
+  900,
+  899,
+  899,
+  898,
+  897,
+  896,
+  896,
+  895,
+  894,
+  893,
+  893,
+  892,
+  891,
+  890,
+  889,
+  889,
+  888,
+  887,
+  886,
+  885,
+  885,
+  884,
+  883,
+  882,
+  882,
+  881,
+  880,
+  879,
+  878,
+  878,
+  877,
+  876,
+  875,
+  874,
+  873,
+  873,
+  872,
+  871,
+  870,
+  869,
+  868,
+  868,
+  867,
+  866,
+  865,
+  864,
+  863,
+  863,
+  862,
+  861,
+  860,
+  859,
+  858,
+  857,
+  857,
+  856,
+  855,
+  854,
+  853,
+  852,
+  851,
+  851,
+  850,
+  849,
+  848,
+  847,
+  846,
+  845,
+  844,
+  843,
+  843,
+  842,
+  841,
+  840,
+  839,
+  838,
+  837,
+  836,
+  835,
+  834,
+  834,
+  833,
+  832,
+  831,
+  830,
+  829,
+  828,
+  827,
+  826,
+  825,
+  824,
+  823,
+  822,
+  822,
+  821,
+  820,
+  819,
+  818,
+  817,
+  816,
+  815,
+  814,
+  813,
+  812,
+  811,
+  810,
+  809,
+  808,
+  807,
+  806,
+  805,
+  804,
+  803,
+  802,
+  801,
+  800,
+  799,
+  798,
+  798,
+  797,
+  796,
+  795,
+  794,
+  793,
+  792,
+  791,
+  790,
+  789,
+  788,
+  787,
+  786,
+  785,
+  784,
+  783,
+  782,
+  780,
+  779,
+  778,
+  777,
+  776,
+  775,
+  774,
+  773,
+  772,
+  771,
+  770,
+  769,
+  768,
+  767,
+  766,
+  765,
+  764,
+  763,
+  762,
+  761,
+  760,
+  759,
+  758,
+  757,
+  756,
+  755,
+  753,
+  752,
+  751,
+  750,
+  749,
+  748,
+  747,
+  746,
+  745,
+  744,
+  743,
+  742,
+  741,
+  739,
+  738,
+  737,
+  736,
+  735,
+  734,
+  733,
+  732,
+  731,
+  730,
+  729,
+  727,
+  726,
+  725,
+  724,
+  723,
+  722,
+  721,
+  720,
+  719,
+  717,
+  716,
+  715,
+  714,
+  713,
+  712,
+  711,
+  709,
+  708,
+  707,
+  706,
+  705,
+  704,
+  703,
+  702,
+  700,
+  699,
+  698,
+  697,
+  696,
+  695,
+  693,
+  692,
+  691,
+  690,
+  689,
+  688,
+  687,
+  685,
+  684,
+  683,
+  682,
+  681,
+  679,
+  678,
+  677,
+  676,
+  675,
+  674,
+  672,
+  671,
+  670,
+  669,
+  668,
+  666,
+  665,
+  664,
+  663,
+  662,
+  660,
+  659,
+  658,
+  657,
+  656,
+  654,
+  653,
+  652,
+  651,
+  650,
+  648,
+  647,
+  646,
+  645,
+  644,
+  642,
+  641,
+  640,
+  639,
+  637,
+  636,
+  635,
+  634,
+  632,
+  631,
+  630,
+  629,
+  628,
+  626,
+  625,
+  624,
+  623,
+  621,
+  620,
+  619,
+  618,
+  616,
+  615,
+  614,
+  613,
+  611,
+  610,
+  609,
+  607,
+  606,
+  605,
+  604,
+  602,
+  601,
+  600,
+  599,
+  597,
+  596,
+  595,
+  593,
+  592,
+  591,
+  590,
+  588,
+  587,
+  586,
+  584,
+  583,
+  582,
+  581,
+  579,
+  578,
+  577,
+  575,
+  574,
+  573,
+  572,
+  570,
+  569,
+  568,
+  566,
+  565,
+  564,
+  562,
+  561,
+  560,
+  558,
+  557,
+  556,
+  554,
+  553,
+  552,
+  550,
+  549,
+  548,
+  547,
+  545,
+  544,
+  543,
+  541,
+  540,
+  539,
+  537,
+  536,
+  535,
+  533,
+  532,
+  530,
+  529,
+  528,
+  526,
+  525,
+  524,
+  522,
+  521,
+  520,
+  518,
+  517,
+  516,
+  514,
+  513,
+  512,
+  510,
+  509,
+  507,
+  506,
+  505,
+  503,
+  502,
+  501,
+  499,
+  498,
+  497,
+  495,
+  494,
+  492,
+  491,
+  490,
+  488,
+  487,
+  485,
+  484,
+  483,
+  481,
+  480,
+  479,
+  477,
+  476,
+  474,
+  473,
+  472,
+  470,
+  469,
+  467,
+  466,
+  465,
+  463,
+  462,
+  460,
+  459,
+  458,
+  456,
+  455,
+  453,
+  452,
+  451,
+  449,
+  448,
+  446,
+  445,
+  443,
+  442,
+  441,
+  439,
+  438,
+  436,
+  435,
+  434,
+  432,
+  431,
+  429,
+  428,
+  426,
+  425,
+  424,
+  422,
+  421,
+  419,
+  418,
+  416,
+  415,
+  414,
+  412,
+  411,
+  409,
+  408,
+  406,
+  405,
+  403,
+  402,
+  401,
+  399,
+  398,
+  396,
+  395,
+  393,
+  392,
+  390,
+  389,
+  388,
+  386,
+  385,
+  383,
+  382,
+  380,
+  379,
+  377,
+  376,
+  374,
+  373,
+  371,
+  370,
+  369,
+  367,
+  366,
+  364,
+  363,
+  361,
+  360,
+  358,
+  357,
+  355,
+  354,
+  352,
+  351,
+  349,
+  348,
+  346,
+  345,
+  343,
+  342,
+  341,
+  339,
+  338,
+  336,
+  335,
+  333,
+  332,
+  330,
+  329,
+  327,
+  326,
+  324,
+  323,
+  321,
+  320,
+  318,
+  317,
+  315,
+  314,
+  312,
+  311,
+  309,
+  308,
+  306,
+  305,
+  303,
+  302,
+  300,
+  299,
+  297,
+  296,
+  294,
+  293,
+  291,
+  290,
+  288,
+  287,
+  285,
+  284,
+  282,
+  281,
+  279,
+  278,
+  276,
+  275,
+  273,
+  272,
+  270,
+  269,
+  267,
+  266,
+  264,
+  263,
+  261,
+  259,
+  258,
+  256,
+  255,
+  253,
+  252,
+  250,
+  249,
+  247,
+  246,
+  244,
+  243,
+  241,
+  240,
+  238,
+  237,
+  235,
+  234,
+  232,
+  230,
+  229,
+  227,
+  226,
+  224,
+  223,
+  221,
+  220,
+  218,
+  217,
+  215,
+  214,
+  212,
+  211,
+  209,
+  207,
+  206,
+  204,
+  203,
+  201,
+  200,
+  198,
+  197,
+  195,
+  194,
+  192,
+  191,
+  189,
+  187,
+  186,
+  184,
+  183,
+  181,
+  180,
+  178,
+  177,
+  175,
+  174,
+  172,
+  170,
+  169,
+  167,
+  166,
+  164,
+  163,
+  161,
+  160,
+  158,
+  156,
+  155,
+  153,
+  152,
+  150,
+  149,
+  147,
+  146,
+  144,
+  142,
+  141,
+  139,
+  138,
+  136,
+  135,
+  133,
+  132,
+  130,
+  128,
+  127,
+  125,
+  124,
+  122,
+  121,
+  119,
+  118,
+  116,
+  114,
+  113,
+  111,
+  110,
+  108,
+  107,
+  105,
+  103,
+  102,
+  100,
+  99,
+  97,
+  96,
+  94,
+  93,
+  91,
+  89,
+  88,
+  86,
+  85,
+  83,
+  82,
+  80,
+  78,
+  77,
+  75,
+  74,
+  72,
+  71,
+  69,
+  67,
+  66,
+  64,
+  63,
+  61,
+  60,
+  58,
+  57,
+  55,
+  53,
+  52,
+  50,
+  49,
+  47,
+  46,
+  44,
+  42,
+  41,
+  39,
+  38,
+  36,
+  35,
+  33,
+  31,
+  30,
+  28,
+  27,
+  25,
+  24,
+  22,
+  20,
+  19,
+  17,
+  16,
+  14,
+  13,
+  11,
+  9,
+  8,
+  6,
+  5,
+  3,
+  2,
+  0,
+  -2,
+  -3,
+  -5,
+  -6,
+  -8,
+  -9,
+  -11,
+  -13,
+  -14,
+  -16,
+  -17,
+  -19,
+  -20,
+  -22,
+  -24,
+  -25,
+  -27,
+  -28,
+  -30,
+  -31,
+  -33,
+  -35,
+  -36,
+  -38,
+  -39,
+  -41,
+  -42,
+  -44,
+  -46,
+  -47,
+  -49,
+  -50,
+  -52,
+  -53,
+  -55,
+  -57,
+  -58,
+  -60,
+  -61,
+  -63,
+  -64,
+  -66,
+  -67,
+  -69,
+  -71,
+  -72,
+  -74,
+  -75,
+  -77,
+  -78,
+  -80,
+  -82,
+  -83,
+  -85,
+  -86,
+  -88,
+  -89,
+  -91,
+  -93,
+  -94,
+  -96,
+  -97,
+  -99,
+  -100,
+  -102,
+  -103,
+  -105,
+  -107,
+  -108,
+  -110,
+  -111,
+  -113,
+  -114,
+  -116,
+  -118,
+  -119,
+  -121,
+  -122,
+  -124,
+  -125,
+  -127,
+  -128,
+  -130,
+  -132,
+  -133,
+  -135,
+  -136,
+  -138,
+  -139,
+  -141,
+  -142,
+  -144,
+  -146,
+  -147,
+  -149,
+  -150,
+  -152,
+  -153,
+  -155,
+  -156,
+  -158,
+  -160,
+  -161,
+  -163,
+  -164,
+  -166,
+  -167,
+  -169,
+  -170,
+  -172,
+  -174,
+  -175,
+  -177,
+  -178,
+  -180,
+  -181,
+  -183,
+  -184,
+  -186,
+  -187,
+  -189,
+  -191,
+  -192,
+  -194,
+  -195,
+  -197,
+  -198,
+  -200,
+  -201,
+  -203,
+  -204,
+  -206,
+  -207,
+  -209,
+  -211,
+  -212,
+  -214,
+  -215,
+  -217,
+  -218,
+  -220,
+  -221,
+  -223,
+  -224,
+  -226,
+  -227,
+  -229,
+  -230,
+  -232,
+  -234,
+  -235,
+  -237,
+  -238,
+  -240,
+  -241,
+  -243,
+  -244,
+  -246,
+  -247,
+  -249,
+  -250,
+  -252,
+  -253,
+  -255,
+  -256,
+  -258,
+  -259,
+  -261,
+  -263,
+  -264,
+  -266,
+  -267,
+  -269,
+  -270,
+  -272,
+  -273,
+  -275,
+  -276,
+  -278,
+  -279,
+  -281,
+  -282,
+  -284,
+  -285,
+  -287,
+  -288,
+  -290,
+  -291,
+  -293,
+  -294,
+  -296,
+  -297,
+  -299,
+  -300,
+  -302,
+  -303,
+  -305,
+  -306,
+  -308,
+  -309,
+  -311,
+  -312,
+  -314,
+  -315,
+  -317,
+  -318,
+  -320,
+  -321,
+  -323,
+  -324,
+  -326,
+  -327,
+  -329,
+  -330,
+  -332,
+  -333,
+  -335,
+  -336,
+  -338,
+  -339,
+  -341,
+  -342,
+  -343,
+  -345,
+  -346,
+  -348,
+  -349,
+  -351,
+  -352,
+  -354,
+  -355,
+  -357,
+  -358,
+  -360,
+  -361,
+  -363,
+  -364,
+  -366,
+  -367,
+  -369,
+  -370,
+  -371,
+  -373,
+  -374,
+  -376,
+  -377,
+  -379,
+  -380,
+  -382,
+  -383,
+  -385,
+  -386,
+  -388,
+  -389,
+  -390,
+  -392,
+  -393,
+  -395,
+  -396,
+  -398,
+  -399,
+  -401,
+  -402,
+  -403,
+  -405,
+  -406,
+  -408,
+  -409,
+  -411,
+  -412,
+  -414,
+  -415,
+  -416,
+  -418,
+  -419,
+  -421,
+  -422,
+  -424,
+  -425,
+  -426,
+  -428,
+  -429,
+  -431,
+  -432,
+  -434,
+  -435,
+  -436,
+  -438,
+  -439,
+  -441,
+  -442,
+  -443,
+  -445,
+  -446,
+  -448,
+  -449,
+  -451,
+  -452,
+  -453,
+  -455,
+  -456,
+  -458,
+  -459,
+  -460,
+  -462,
+  -463,
+  -465,
+  -466,
+  -467,
+  -469,
+  -470,
+  -472,
+  -473,
+  -474,
+  -476,
+  -477,
+  -479,
+  -480,
+  -481,
+  -483,
+  -484,
+  -485,
+  -487,
+  -488,
+  -490,
+  -491,
+  -492,
+  -494,
+  -495,
+  -497,
+  -498,
+  -499,
+  -501,
+  -502,
+  -503,
+  -505,
+  -506,
+  -507,
+  -509,
+  -510,
+  -512,
+  -513,
+  -514,
+  -516,
+  -517,
+  -518,
+  -520,
+  -521,
+  -522,
+  -524,
+  -525,
+  -526,
+  -528,
+  -529,
+  -530,
+  -532,
+  -533,
+  -535,
+  -536,
+  -537,
+  -539,
+  -540,
+  -541,
+  -543,
+  -544,
+  -545,
+  -547,
+  -548,
+  -549,
+  -550,
+  -552,
+  -553,
+  -554,
+  -556,
+  -557,
+  -558,
+  -560,
+  -561,
+  -562,
+  -564,
+  -565,
+  -566,
+  -568,
+  -569,
+  -570,
+  -572,
+  -573,
+  -574,
+  -575,
+  -577,
+  -578,
+  -579,
+  -581,
+  -582,
+  -583,
+  -584,
+  -586,
+  -587,
+  -588,
+  -590,
+  -591,
+  -592,
+  -593,
+  -595,
+  -596,
+  -597,
+  -599,
+  -600,
+  -601,
+  -602,
+  -604,
+  -605,
+  -606,
+  -607,
+  -609,
+  -610,
+  -611,
+  -613,
+  -614,
+  -615,
+  -616,
+  -618,
+  -619,
+  -620,
+  -621,
+  -623,
+  -624,
+  -625,
+  -626,
+  -628,
+  -629,
+  -630,
+  -631,
+  -632,
+  -634,
+  -635,
+  -636,
+  -637,
+  -639,
+  -640,
+  -641,
+  -642,
+  -644,
+  -645,
+  -646,
+  -647,
+  -648,
+  -650,
+  -651,
+  -652,
+  -653,
+  -654,
+  -656,
+  -657,
+  -658,
+  -659,
+  -660,
+  -662,
+  -663,
+  -664,
+  -665,
+  -666,
+  -668,
+  -669,
+  -670,
+  -671,
+  -672,
+  -674,
+  -675,
+  -676,
+  -677,
+  -678,
+  -679,
+  -681,
+  -682,
+  -683,
+  -684,
+  -685,
+  -687,
+  -688,
+  -689,
+  -690,
+  -691,
+  -692,
+  -693,
+  -695,
+  -696,
+  -697,
+  -698,
+  -699,
+  -700,
+  -702,
+  -703,
+  -704,
+  -705,
+  -706,
+  -707,
+  -708,
+  -709,
+  -711,
+  -712,
+  -713,
+  -714,
+  -715,
+  -716,
+  -717,
+  -719,
+  -720,
+  -721,
+  -722,
+  -723,
+  -724,
+  -725,
+  -726,
+  -727,
+  -729,
+  -730,
+  -731,
+  -732,
+  -733,
+  -734,
+  -735,
+  -736,
+  -737,
+  -738,
+  -739,
+  -741,
+  -742,
+  -743,
+  -744,
+  -745,
+  -746,
+  -747,
+  -748,
+  -749,
+  -750,
+  -751,
+  -752,
+  -753,
+  -755,
+  -756,
+  -757,
+  -758,
+  -759,
+  -760,
+  -761,
+  -762,
+  -763,
+  -764,
+  -765,
+  -766,
+  -767,
+  -768,
+  -769,
+  -770,
+  -771,
+  -772,
+  -773,
+  -774,
+  -775,
+  -776,
+  -777,
+  -778,
+  -779,
+  -780,
+  -782,
+  -783,
+  -784,
+  -785,
+  -786,
+  -787,
+  -788,
+  -789,
+  -790,
+  -791,
+  -792,
+  -793,
+  -794,
+  -795,
+  -796,
+  -797,
+  -798,
+  -798,
+  -799,
+  -800,
+  -801,
+  -802,
+  -803,
+  -804,
+  -805,
+  -806,
+  -807,
+  -808,
+  -809,
+  -810,
+  -811,
+  -812,
+  -813,
+  -814,
+  -815,
+  -816,
+  -817,
+  -818,
+  -819,
+  -820,
+  -821,
+  -822,
+  -822,
+  -823,
+  -824,
+  -825,
+  -826,
+  -827,
+  -828,
+  -829,
+  -830,
+  -831,
+  -832,
+  -833,
+  -834,
+  -834,
+  -835,
+  -836,
+  -837,
+  -838,
+  -839,
+  -840,
+  -841,
+  -842,
+  -843,
+  -843,
+  -844,
+  -845,
+  -846,
+  -847,
+  -848,
+  -849,
+  -850,
+  -851,
+  -851,
+  -852,
+  -853,
+  -854,
+  -855,
+  -856,
+  -857,
+  -857,
+  -858,
+  -859,
+  -860,
+  -861,
+  -862,
+  -863,
+  -863,
+  -864,
+  -865,
+  -866,
+  -867,
+  -868,
+  -868,
+  -869,
+  -870,
+  -871,
+  -872,
+  -873,
+  -873,
+  -874,
+  -875,
+  -876,
+  -877,
+  -878,
+  -878,
+  -879,
+  -880,
+  -881,
+  -882,
+  -882,
+  -883,
+  -884,
+  -885,
+  -885,
+  -886,
+  -887,
+  -888,
+  -889,
+  -889,
+  -890,
+  -891,
+  -892,
+  -893,
+  -893,
+  -894,
+  -895,
+  -896,
+  -896,
+  -897,
+  -898,
+  -899,
+  -899,
+  -900,
+  -901,
+  -902,
+  -902,
+  -903,
+  -904,
+  -905,
+  -905,
+  -906,
+  -907,
+  -907,
+  -908,
+  -909,
+  -910,
+  -910,
+  -911,
+  -912,
+  -913,
+  -913,
+  -914,
+  -915,
+  -915,
+  -916,
+  -917,
+  -917,
+  -918,
+  -919,
+  -920,
+  -920,
+  -921,
+  -922,
+  -922,
+  -923,
+  -924,
+  -924,
+  -925,
+  -926,
+  -926,
+  -927,
+  -928,
+  -928,
+  -929,
+  -930,
+  -930,
+  -931,
+  -932,
+  -932,
+  -933,
+  -934,
+  -934,
+  -935,
+  -936,
+  -936,
+  -937,
+  -937,
+  -938,
+  -939,
+  -939,
+  -940,
+  -941,
+  -941,
+  -942,
+  -942,
+  -943,
+  -944,
+  -944,
+  -945,
+  -945,
+  -946,
+  -947,
+  -947,
+  -948,
+  -948,
+  -949,
+  -950,
+  -950,
+  -951,
+  -951,
+  -952,
+  -953,
+  -953,
+  -954,
+  -954,
+  -955,
+  -955,
+  -956,
+  -957,
+  -957,
+  -958,
+  -958,
+  -959,
+  -959,
+  -960,
+  -960,
+  -961,
+  -961,
+  -962,
+  -963,
+  -963,
+  -964,
+  -964,
+  -965,
+  -965,
+  -966,
+  -966,
+  -967,
+  -967,
+  -968,
+  -968,
+  -969,
+  -969,
+  -970,
+  -970,
+  -971,
+  -971,
+  -972,
+  -972,
+  -973,
+  -973,
+  -974,
+  -974,
+  -975,
+  -975,
+  -976,
+  -976,
+  -977,
+  -977,
+  -978,
+  -978,
+  -979,
+  -979,
+  -979,
+  -980,
+  -980,
+  -981,
+  -981,
+  -982,
+  -982,
+  -983,
+  -983,
+  -983,
+  -984,
+  -984,
+  -985,
+  -985,
+  -986,
+  -986,
+  -986,
+  -987,
+  -987,
+  -988,
+  -988,
+  -989,
+  -989,
+  -989,
+  -990,
+  -990,
+  -991,
+  -991,
+  -991,
+  -992,
+  -992,
+  -993,
+  -993,
+  -993,
+  -994,
+  -994,
+  -994,
+  -995,
+  -995,
+  -996,
+  -996,
+  -996,
+  -997,
+  -997,
+  -997,
+  -998,
+  -998,
+  -998,
+  -999,
+  -999,
+  -999,
+  -1000,
+  -1000,
+  -1000,
+  -1001,
+  -1001,
+  -1001,
+  -1002,
+  -1002,
+  -1002,
+  -1003,
+  -1003,
+  -1003,
+  -1004,
+  -1004,
+  -1004,
+  -1005,
+  -1005,
+  -1005,
+  -1006,
+  -1006,
+  -1006,
+  -1006,
+  -1007,
+  -1007,
+  -1007,
+  -1008,
+  -1008,
+  -1008,
+  -1008,
+  -1009,
+  -1009,
+  -1009,
+  -1009,
+  -1010,
+  -1010,
+  -1010,
+  -1010,
+  -1011,
+  -1011,
+  -1011,
+  -1011,
+  -1012,
+  -1012,
+  -1012,
+  -1012,
+  -1013,
+  -1013,
+  -1013,
+  -1013,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1015,
+  -1015,
+  -1015,
+  -1015,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1015,
+  -1015,
+  -1015,
+  -1015,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1013,
+  -1013,
+  -1013,
+  -1013,
+  -1012,
+  -1012,
+  -1012,
+  -1012,
+  -1011,
+  -1011,
+  -1011,
+  -1011,
+  -1010,
+  -1010,
+  -1010,
+  -1010,
+  -1009,
+  -1009,
+  -1009,
+  -1009,
+  -1008,
+  -1008,
+  -1008,
+  -1008,
+  -1007,
+  -1007,
+  -1007,
+  -1006,
+  -1006,
+  -1006,
+  -1006,
+  -1005,
+  -1005,
+  -1005,
+  -1004,
+  -1004,
+  -1004,
+  -1003,
+  -1003,
+  -1003,
+  -1002,
+  -1002,
+  -1002,
+  -1001,
+  -1001,
+  -1001,
+  -1000,
+  -1000,
+  -1000,
+  -999,
+  -999,
+  -999,
+  -998,
+  -998,
+  -998,
+  -997,
+  -997,
+  -997,
+  -996,
+  -996,
+  -996,
+  -995,
+  -995,
+  -994,
+  -994,
+  -994,
+  -993,
+  -993,
+  -993,
+  -992,
+  -992,
+  -991,
+  -991,
+  -991,
+  -990,
+  -990,
+  -989,
+  -989,
+  -989,
+  -988,
+  -988,
+  -987,
+  -987,
+  -986,
+  -986,
+  -986,
+  -985,
+  -985,
+  -984,
+  -984,
+  -983,
+  -983,
+  -983,
+  -982,
+  -982,
+  -981,
+  -981,
+  -980,
+  -980,
+  -979,
+  -979,
+  -979,
+  -978,
+  -978,
+  -977,
+  -977,
+  -976,
+  -976,
+  -975,
+  -975,
+  -974,
+  -974,
+  -973,
+  -973,
+  -972,
+  -972,
+  -971,
+  -971,
+  -970,
+  -970,
+  -969,
+  -969,
+  -968,
+  -968,
+  -967,
+  -967,
+  -966,
+  -966,
+  -965,
+  -965,
+  -964,
+  -964,
+  -963,
+  -963,
+  -962,
+  -961,
+  -961,
+  -960,
+  -960,
+  -959,
+  -959,
+  -958,
+  -958,
+  -957,
+  -957,
+  -956,
+  -955,
+  -955,
+  -954,
+  -954,
+  -953,
+  -953,
+  -952,
+  -951,
+  -951,
+  -950,
+  -950,
+  -949,
+  -948,
+  -948,
+  -947,
+  -947,
+  -946,
+  -945,
+  -945,
+  -944,
+  -944,
+  -943,
+  -942,
+  -942,
+  -941,
+  -941,
+  -940,
+  -939,
+  -939,
+  -938,
+  -937,
+  -937,
+  -936,
+  -936,
+  -935,
+  -934,
+  -934,
+  -933,
+  -932,
+  -932,
+  -931,
+  -930,
+  -930,
+  -929,
+  -928,
+  -928,
+  -927,
+  -926,
+  -926,
+  -925,
+  -924,
+  -924,
+  -923,
+  -922,
+  -922,
+  -921,
+  -920,
+  -920,
+  -919,
+  -918,
+  -917,
+  -917,
+  -916,
+  -915,
+  -915,
+  -914,
+  -913,
+  -913,
+  -912,
+  -911,
+  -910,
+  -910,
+  -909,
+  -908,
+  -907,
+  -907,
+  -906,
+  -905,
+  -905,
+  -904,
+  -903,
+  -902,
+  -902,
+  -901,
+  -900,
+  -899,
+  -899,
+  -898,
+  -897,
+  -896,
+  -896,
+  -895,
+  -894,
+  -893,
+  -893,
+  -892,
+  -891,
+  -890,
+  -889,
+  -889,
+  -888,
+  -887,
+  -886,
+  -885,
+  -885,
+  -884,
+  -883,
+  -882,
+  -882,
+  -881,
+  -880,
+  -879,
+  -878,
+  -878,
+  -877,
+  -876,
+  -875,
+  -874,
+  -873,
+  -873,
+  -872,
+  -871,
+  -870,
+  -869,
+  -868,
+  -868,
+  -867,
+  -866,
+  -865,
+  -864,
+  -863,
+  -863,
+  -862,
+  -861,
+  -860,
+  -859,
+  -858,
+  -857,
+  -857,
+  -856,
+  -855,
+  -854,
+  -853,
+  -852,
+  -851,
+  -851,
+  -850,
+  -849,
+  -848,
+  -847,
+  -846,
+  -845,
+  -844,
+  -843,
+  -843,
+  -842,
+  -841,
+  -840,
+  -839,
+  -838,
+  -837,
+  -836,
+  -835,
+  -834,
+  -834,
+  -833,
+  -832,
+  -831,
+  -830,
+  -829,
+  -828,
+  -827,
+  -826,
+  -825,
+  -824,
+  -823,
+  -822,
+  -822,
+  -821,
+  -820,
+  -819,
+  -818,
+  -817,
+  -816,
+  -815,
+  -814,
+  -813,
+  -812,
+  -811,
+  -810,
+  -809,
+  -808,
+  -807,
+  -806,
+  -805,
+  -804,
+  -803,
+  -802,
+  -801,
+  -800,
+  -799,
+  -798,
+  -798,
+  -797,
+  -796,
+  -795,
+  -794,
+  -793,
+  -792,
+  -791,
+  -790,
+  -789,
+  -788,
+  -787,
+  -786,
+  -785,
+  -784,
+  -783,
+  -782,
+  -780,
+  -779,
+  -778,
+  -777,
+  -776,
+  -775,
+  -774,
+  -773,
+  -772,
+  -771,
+  -770,
+  -769,
+  -768,
+  -767,
+  -766,
+  -765,
+  -764,
+  -763,
+  -762,
+  -761,
+  -760,
+  -759,
+  -758,
+  -757,
+  -756,
+  -755,
+  -753,
+  -752,
+  -751,
+  -750,
+  -749,
+  -748,
+  -747,
+  -746,
+  -745,
+  -744,
+  -743,
+  -742,
+  -741,
+  -739,
+  -738,
+  -737,
+  -736,
+  -735,
+  -734,
+  -733,
+  -732,
+  -731,
+  -730,
+  -729,
+  -727,
+  -726,
+  -725,
+  -724,
+  -723,
+  -722,
+  -721,
+  -720,
+  -719,
+  -717,
+  -716,
+  -715,
+  -714,
+  -713,
+  -712,
+  -711,
+  -709,
+  -708,
+  -707,
+  -706,
+  -705,
+  -704,
+  -703,
+  -702,
+  -700,
+  -699,
+  -698,
+  -697,
+  -696,
+  -695,
+  -693,
+  -692,
+  -691,
+  -690,
+  -689,
+  -688,
+  -687,
+  -685,
+  -684,
+  -683,
+  -682,
+  -681,
+  -679,
+  -678,
+  -677,
+  -676,
+  -675,
+  -674,
+  -672,
+  -671,
+  -670,
+  -669,
+  -668,
+  -666,
+  -665,
+  -664,
+  -663,
+  -662,
+  -660,
+  -659,
+  -658,
+  -657,
+  -656,
+  -654,
+  -653,
+  -652,
+  -651,
+  -650,
+  -648,
+  -647,
+  -646,
+  -645,
+  -644,
+  -642,
+  -641,
+  -640,
+  -639,
+  -637,
+  -636,
+  -635,
+  -634,
+  -632,
+  -631,
+  -630,
+  -629,
+  -628,
+  -626,
+  -625,
+  -624,
+  -623,
+  -621,
+  -620,
+  -619,
+  -618,
+  -616,
+  -615,
+  -614,
+  -613,
+  -611,
+  -610,
+  -609,
+  -607,
+  -606,
+  -605,
+  -604,
+  -602,
+  -601,
+  -600,
+  -599,
+  -597,
+  -596,
+  -595,
+  -593,
+  -592,
+  -591,
+  -590,
+  -588,
+  -587,
+  -586,
+  -584,
+  -583,
+  -582,
+  -581,
+  -579,
+  -578,
+  -577,
+  -575,
+  -574,
+  -573,
+  -572,
+  -570,
+  -569,
+  -568,
+  -566,
+  -565,
+  -564,
+  -562,
+  -561,
+  -560,
+  -558,
+  -557,
+  -556,
+  -554,
+  -553,
+  -552,
+  -550,
+  -549,
+  -548,
+  -547,
+  -545,
+  -544,
+  -543,
+  -541,
+  -540,
+  -539,
+  -537,
+  -536,
+  -535,
+  -533,
+  -532,
+  -530,
+  -529,
+  -528,
+  -526,
+  -525,
+  -524,
+  -522,
+  -521,
+  -520,
+  -518,
+  -517,
+  -516,
+  -514,
+  -513,
+  -512,
+  -510,
+  -509,
+  -507,
+  -506,
+  -505,
+  -503,
+  -502,
+  -501,
+  -499,
+  -498,
+  -497,
+  -495,
+  -494,
+  -492,
+  -491,
+  -490,
+  -488,
+  -487,
+  -485,
+  -484,
+  -483,
+  -481,
+  -480,
+  -479,
+  -477,
+  -476,
+  -474,
+  -473,
+  -472,
+  -470,
+  -469,
+  -467,
+  -466,
+  -465,
+  -463,
+  -462,
+  -460,
+  -459,
+  -458,
+  -456,
+  -455,
+  -453,
+  -452,
+  -451,
+  -449,
+  -448,
+  -446,
+  -445,
+  -443,
+  -442,
+  -441,
+  -439,
+  -438,
+  -436,
+  -435,
+  -434,
+  -432,
+  -431,
+  -429,
+  -428,
+  -426,
+  -425,
+  -424,
+  -422,
+  -421,
+  -419,
+  -418,
+  -416,
+  -415,
+  -414,
+  -412,
+  -411,
+  -409,
+  -408,
+  -406,
+  -405,
+  -403,
+  -402,
+  -401,
+  -399,
+  -398,
+  -396,
+  -395,
+  -393,
+  -392,
+  -390,
+  -389,
+  -388,
+  -386,
+  -385,
+  -383,
+  -382,
+  -380,
+  -379,
+  -377,
+  -376,
+  -374,
+  -373,
+  -371,
+  -370,
+  -369,
+  -367,
+  -366,
+  -364,
+  -363,
+  -361,
+  -360,
+  -358,
+  -357,
+  -355,
+  -354,
+  -352,
+  -351,
+  -349,
+  -348,
+  -346,
+  -345,
+  -343,
+  -342,
+  -341,
+  -339,
+  -338,
+  -336,
+  -335,
+  -333,
+  -332,
+  -330,
+  -329,
+  -327,
+  -326,
+  -324,
+  -323,
+  -321,
+  -320,
+  -318,
+  -317,
+  -315,
+  -314,
+  -312,
+  -311,
+  -309,
+  -308,
+  -306,
+  -305,
+  -303,
+  -302,
+  -300,
+  -299,
+  -297,
+  -296,
+  -294,
+  -293,
+  -291,
+  -290,
+  -288,
+  -287,
+  -285,
+  -284,
+  -282,
+  -281,
+  -279,
+  -278,
+  -276,
+  -275,
+  -273,
+  -272,
+  -270,
+  -269,
+  -267,
+  -266,
+  -264,
+  -263,
+  -261,
+  -259,
+  -258,
+  -256,
+  -255,
+  -253,
+  -252,
+  -250,
+  -249,
+  -247,
+  -246,
+  -244,
+  -243,
+  -241,
+  -240,
+  -238,
+  -237,
+  -235,
+  -234,
+  -232,
+  -230,
+  -229,
+  -227,
+  -226,
+  -224,
+  -223,
+  -221,
+  -220,
+  -218,
+  -217,
+  -215,
+  -214,
+  -212,
+  -211,
+  -209,
+  -207,
+  -206,
+  -204,
+  -203,
+  -201,
+  -200,
+  -198,
+  -197,
+  -195,
+  -194,
+  -192,
+  -191,
+  -189,
+  -187,
+  -186,
+  -184,
+  -183,
+  -181,
+  -180,
+  -178,
+  -177,
+  -175,
+  -174,
+  -172,
+  -170,
+  -169,
+  -167,
+  -166,
+  -164,
+  -163,
+  -161,
+  -160,
+  -158,
+  -156,
+  -155,
+  -153,
+  -152,
+  -150,
+  -149,
+  -147,
+  -146,
+  -144,
+  -142,
+  -141,
+  -139,
+  -138,
+  -136,
+  -135,
+  -133,
+  -132,
+  -130,
+  -128,
+  -127,
+  -125,
+  -124,
+  -122,
+  -121,
+  -119,
+  -118,
+  -116,
+  -114,
+  -113,
+  -111,
+  -110,
+  -108,
+  -107,
+  -105,
+  -103,
+  -102,
+  -100,
+  -99,
+  -97,
+  -96,
+  -94,
+  -93,
+  -91,
+  -89,
+  -88,
+  -86,
+  -85,
+  -83,
+  -82,
+  -80,
+  -78,
+  -77,
+  -75,
+  -74,
+  -72,
+  -71,
+  -69,
+  -67,
+  -66,
+  -64,
+  -63,
+  -61,
+  -60,
+  -58,
+  -57,
+  -55,
+  -53,
+  -52,
+  -50,
+  -49,
+  -47,
+  -46,
+  -44,
+  -42,
+  -41,
+  -39,
+  -38,
+  -36,
+  -35,
+  -33,
+  -31,
+  -30,
+  -28,
+  -27,
+  -25,
+  -24,
+  -22,
+  -20,
+  -19,
+  -17,
+  -16,
+  -14,
+  -13,
+  -11,
+  -9,
+  -8,
+  -6,
+  -5,
+  -3,
+  -2,
+};
+const double INVCOSINETABLE[4096] = {  1.00000000000000000000e+00,
+  1.00000117654968234682e+00,
+  1.00000470621257209203e+00,
+  1.00001058903019801605e+00,
+  1.00001882507177564108e+00,
+  1.00002941443420945156e+00,
+  1.00004235724209600278e+00,
+  1.00005765364772747361e+00,
+  1.00007530383109544125e+00,
+  1.00009530799989643235e+00,
+  1.00011766638953769615e+00,
+  1.00014237926314475402e+00,
+  1.00016944691156806080e+00,
+  1.00019886965339122042e+00,
+  1.00023064783494120000e+00,
+  1.00026478183029721158e+00,
+  1.00030127204130203644e+00,
+  1.00034011889757334934e+00,
+  1.00038132285651637510e+00,
+  1.00042488440333654509e+00,
+  1.00047080405105370815e+00,
+  1.00051908234051700752e+00,
+  1.00056971984041997992e+00,
+  1.00062271714731787497e+00,
+  1.00067807488564342044e+00,
+  1.00073579370772569597e+00,
+  1.00079587429380922892e+00,
+  1.00085831735207242410e+00,
+  1.00092312361864910208e+00,
+  1.00099029385764892730e+00,
+  1.00105982886117939046e+00,
+  1.00113172944936956732e+00,
+  1.00120599647039276725e+00,
+  1.00128263080049118017e+00,
+  1.00136163334400118963e+00,
+  1.00144300503338001818e+00,
+  1.00152674682923148453e+00,
+  1.00161285972033486935e+00,
+  1.00170134472367244882e+00,
+  1.00179220288445969267e+00,
+  1.00188543527617479612e+00,
+  1.00198104300059043226e+00,
+  1.00207902718780417217e+00,
+  1.00217938899627356797e+00,
+  1.00228212961284657290e+00,
+  1.00238725025279840075e+00,
+  1.00249475215986572074e+00,
+  1.00260463660628262872e+00,
+  1.00271690489281706249e+00,
+  1.00283155834880965962e+00,
+  1.00294859833221128298e+00,
+  1.00306802622962232263e+00,
+  1.00318984345633377409e+00,
+  1.00331405145636787246e+00,
+  1.00344065170251894870e+00,
+  1.00356964569639850460e+00,
+  1.00370103496847629110e+00,
+  1.00383482107812693762e+00,
+  1.00397100561367347282e+00,
+  1.00410959019243484214e+00,
+  1.00425057646077275919e+00,
+  1.00439396609413877925e+00,
+  1.00453976079712403724e+00,
+  1.00468796230350876364e+00,
+  1.00483857237631202253e+00,
+  1.00499159280784478021e+00,
+  1.00514702541976030936e+00,
+  1.00530487206310903403e+00,
+  1.00546513461839137626e+00,
+  1.00562781499561326726e+00,
+  1.00579291513434232463e+00,
+  1.00596043700376447383e+00,
+  1.00613038260274034741e+00,
+  1.00630275395986612530e+00,
+  1.00647755313353104434e+00,
+  1.00665478221197912667e+00,
+  1.00683444331336957589e+00,
+  1.00701653858583894952e+00,
+  1.00720107020756532989e+00,
+  1.00738804038683138486e+00,
+  1.00757745136208964887e+00,
+  1.00776930540202802611e+00,
+  1.00796360480563795825e+00,
+  1.00816035190228037166e+00,
+  1.00835954905175584351e+00,
+  1.00856119864437343558e+00,
+  1.00876530310102174859e+00,
+  1.00897186487324019843e+00,
+  1.00918088644329206893e+00,
+  1.00939237032423667628e+00,
+  1.00960631906000575242e+00,
+  1.00982273522547738587e+00,
+  1.01004162142655262713e+00,
+  1.01026298030023342633e+00,
+  1.01048681451470079296e+00,
+  1.01071312676939339958e+00,
+  1.01094191979508885026e+00,
+  1.01117319635398450473e+00,
+  1.01140695923977985693e+00,
+  1.01164321127776046794e+00,
+  1.01188195532488078854e+00,
+  1.01212319426985097870e+00,
+  1.01236693103322261678e+00,
+  1.01261316856747640713e+00,
+  1.01286190985711010981e+00,
+  1.01311315791872824654e+00,
+  1.01336691580113269495e+00,
+  1.01362318658541417093e+00,
+  1.01388197338504415512e+00,
+  1.01414327934597037206e+00,
+  1.01440710764670871669e+00,
+  1.01467346149844139802e+00,
+  1.01494234414511264042e+00,
+  1.01521375886352638318e+00,
+  1.01548770896344642267e+00,
+  1.01576419778769500013e+00,
+  1.01604322871225494218e+00,
+  1.01632480514637135727e+00,
+  1.01660893053265599661e+00,
+  1.01689560834718983884e+00,
+  1.01718484209963078158e+00,
+  1.01747663533331866859e+00,
+  1.01777099162538431365e+00,
+  1.01806791458685785834e+00,
+  1.01836740786277846205e+00,
+  1.01866947513230665656e+00,
+  1.01897412010883625655e+00,
+  1.01928134654010693616e+00,
+  1.01959115820832102450e+00,
+  1.01990355893025719247e+00,
+  1.02021855255738902457e+00,
+  1.02053614297600314664e+00,
+  1.02085633410731735360e+00,
+  1.02117912990760362213e+00,
+  1.02150453436830734866e+00,
+  1.02183255151617280454e+00,
+  1.02216318541336548265e+00,
+  1.02249644015759888482e+00,
+  1.02283231988226108733e+00,
+  1.02317082875654219443e+00,
+  1.02351197098556423448e+00,
+  1.02385575081051105606e+00,
+  1.02420217250876133264e+00,
+  1.02455124039401956892e+00,
+  1.02490295881645288034e+00,
+  1.02525733216282421978e+00,
+  1.02561436485663159957e+00,
+  1.02597406135824464890e+00,
+  1.02633642616504472400e+00,
+  1.02670146381156590643e+00,
+  1.02706917886963733366e+00,
+  1.02743957594852619586e+00,
+  1.02781265969508295299e+00,
+  1.02818843479388810636e+00,
+  1.02856690596739874799e+00,
+  1.02894807797609844080e+00,
+  1.02933195561864754275e+00,
+  1.02971854373203397515e+00,
+  1.03010784719172776569e+00,
+  1.03049987091183470334e+00,
+  1.03089461984525332383e+00,
+  1.03129209898383056299e+00,
+  1.03169231335852273901e+00,
+  1.03209526803955431440e+00,
+  1.03250096813658043260e+00,
+  1.03290941879885012078e+00,
+  1.03332062521537104693e+00,
+  1.03373459261507494311e+00,
+  1.03415132626698702545e+00,
+  1.03457083148039297171e+00,
+  1.03499311360501167201e+00,
+  1.03541817803116686925e+00,
+  1.03584603018996035395e+00,
+  1.03627667555344804562e+00,
+  1.03671011963481674023e+00,
+  1.03714636798856241207e+00,
+  1.03758542621067073597e+00,
+  1.03802729993879849779e+00,
+  1.03847199485245722528e+00,
+  1.03891951667319704100e+00,
+  1.03936987116479473414e+00,
+  1.03982306413344094409e+00,
+  1.04027910142793067472e+00,
+  1.04073798893985358660e+00,
+  1.04119973260378895219e+00,
+  1.04166433839749927870e+00,
+  1.04213181234212703963e+00,
+  1.04260216050239318264e+00,
+  1.04307538898679741379e+00,
+  1.04355150394781981404e+00,
+  1.04403051158212378802e+00,
+  1.04451241813076212139e+00,
+  1.04499722987938392649e+00,
+  1.04548495315844292008e+00,
+  1.04597559434340858786e+00,
+  1.04646915985497912516e+00,
+  1.04696565615929415571e+00,
+  1.04746508976815322356e+00,
+  1.04796746723923184241e+00,
+  1.04847279517630198598e+00,
+  1.04898108022945479867e+00,
+  1.04949232909532241820e+00,
+  1.05000654851730579331e+00,
+  1.05052374528580050317e+00,
+  1.05104392623842701759e+00,
+  1.05156709826026228960e+00,
+  1.05209326828407245813e+00,
+  1.05262244329054954761e+00,
+  1.05315463030854705728e+00,
+  1.05368983641532198980e+00,
+  1.05422806873677332717e+00,
+  1.05476933444768850023e+00,
+  1.05531364077198674956e+00,
+  1.05586099498296825949e+00,
+  1.05641140440356373631e+00,
+  1.05696487640658576268e+00,
+  1.05752141841498326080e+00,
+  1.05808103790209839801e+00,
+  1.05864374239192393645e+00,
+  1.05920953945936435758e+00,
+  1.05977843673049876294e+00,
+  1.06035044188284643951e+00,
+  1.06092556264563242507e+00,
+  1.06150380680005929079e+00,
+  1.06208518217957692542e+00,
+  1.06266969667015875878e+00,
+  1.06325735821057643093e+00,
+  1.06384817479267912432e+00,
+  1.06444215446167600447e+00,
+  1.06503930531641732848e+00,
+  1.06563963550968265892e+00,
+  1.06624315324846752340e+00,
+  1.06684986679427584733e+00,
+  1.06745978446341127643e+00,
+  1.06807291462727449449e+00,
+  1.06868926571266076309e+00,
+  1.06930884620206034796e+00,
+  1.06993166463396249810e+00,
+  1.07055772960316053499e+00,
+  1.07118704976106116078e+00,
+  1.07181963381599421048e+00,
+  1.07245549053352751123e+00,
+  1.07309462873678262973e+00,
+  1.07373705730675350623e+00,
+  1.07438278518262841921e+00,
+  1.07503182136211461462e+00,
+  1.07568417490176471141e+00,
+  1.07633985491730732598e+00,
+  1.07699887058397880679e+00,
+  1.07766123113685940993e+00,
+  1.07832694587121169505e+00,
+  1.07899602414282047569e+00,
+  1.07966847536833876475e+00,
+  1.08034430902563216570e+00,
+  1.08102353465413103528e+00,
+  1.08170616185518242425e+00,
+  1.08239220029240557075e+00,
+  1.08308165969205072443e+00,
+  1.08377454984336130117e+00,
+  1.08447088059893914647e+00,
+  1.08517066187511135311e+00,
+  1.08587390365230240796e+00,
+  1.08658061597540789300e+00,
+  1.08729080895417218322e+00,
+  1.08800449276356903106e+00,
+  1.08872167764418481539e+00,
+  1.08944237390260667553e+00,
+  1.09016659191181219946e+00,
+  1.09089434211156288690e+00,
+  1.09162563500880183121e+00,
+  1.09236048117805406577e+00,
+  1.09309889126182935293e+00,
+  1.09384087597103096812e+00,
+  1.09458644608536515008e+00,
+  1.09533561245375632431e+00,
+  1.09608838599476343667e+00,
+  1.09684477769700317040e+00,
+  1.09760479861957271908e+00,
+  1.09836845989248033106e+00,
+  1.09913577271707540994e+00,
+  1.09990674836648616441e+00,
+  1.10068139818605836844e+00,
+  1.10145973359379856227e+00,
+  1.10224176608082147233e+00,
+  1.10302750721180076177e+00,
+  1.10381696862542422188e+00,
+  1.10461016203485207221e+00,
+  1.10540709922817970146e+00,
+  1.10620779206890418322e+00,
+  1.10701225249639589876e+00,
+  1.10782049252637126990e+00,
+  1.10863252425137326362e+00,
+  1.10944835984125367290e+00,
+  1.11026801154365961644e+00,
+  1.11109149168452558953e+00,
+  1.11191881266856862354e+00,
+  1.11274998697978744211e+00,
+  1.11358502718196783476e+00,
+  1.11442394591918980673e+00,
+  1.11526675591634094609e+00,
+  1.11611346997963378769e+00,
+  1.11696410099712695185e+00,
+  1.11781866193925205621e+00,
+  1.11867716585934418028e+00,
+  1.11953962589417765905e+00,
+  1.12040605526450565144e+00,
+  1.12127646727560525974e+00,
+  1.12215087531782686803e+00,
+  1.12302929286714880952e+00,
+  1.12391173348573603086e+00,
+  1.12479821082250452946e+00,
+  1.12568873861369023182e+00,
+  1.12658333068342297878e+00,
+  1.12748200094430450768e+00,
+  1.12838476339799420600e+00,
+  1.12929163213579752956e+00,
+  1.13020262133925952774e+00,
+  1.13111774528076569624e+00,
+  1.13203701832414549422e+00,
+  1.13296045492528363319e+00,
+  1.13388806963273514050e+00,
+  1.13481987708834597406e+00,
+  1.13575589202788007626e+00,
+  1.13669612928165109089e+00,
+  1.13764060377515940914e+00,
+  1.13858933052973632094e+00,
+  1.13954232466319194117e+00,
+  1.14049960139047090735e+00,
+  1.14146117602431163007e+00,
+  1.14242706397591353706e+00,
+  1.14339728075560964626e+00,
+  1.14437184197354335780e+00,
+  1.14535076334035434975e+00,
+  1.14633406066786780464e+00,
+  1.14732174986979229558e+00,
+  1.14831384696242100318e+00,
+  1.14931036806534225825e+00,
+  1.15031132940215385929e+00,
+  1.15131674730118671590e+00,
+  1.15232663819623026846e+00,
+  1.15334101862727078647e+00,
+  1.15435990524123077705e+00,
+  1.15538331479271771940e+00,
+  1.15641126414477946049e+00,
+  1.15744377026966516198e+00,
+  1.15848085024959512879e+00,
+  1.15952252127753574484e+00,
+  1.16056880065798240231e+00,
+  1.16161970580774909223e+00,
+  1.16267525425676576667e+00,
+  1.16373546364888258431e+00,
+  1.16480035174268081732e+00,
+  1.16586993641229264007e+00,
+  1.16694423564822713502e+00,
+  1.16802326755820429227e+00,
+  1.16910705036799700274e+00,
+  1.17019560242228015667e+00,
+  1.17128894218548773587e+00,
+  1.17238708824267789943e+00,
+  1.17349005930040561907e+00,
+  1.17459787418760508437e+00,
+  1.17571055185647654895e+00,
+  1.17682811138338605517e+00,
+  1.17795057196976937774e+00,
+  1.17907795294304706957e+00,
+  1.18021027375754616884e+00,
+  1.18134755399543189824e+00,
+  1.18248981336764713568e+00,
+  1.18363707171486098879e+00,
+  1.18478934900842602929e+00,
+  1.18594666535134440899e+00,
+  1.18710904097924307976e+00,
+  1.18827649626135833927e+00,
+  1.18944905170152970264e+00,
+  1.19062672793920198977e+00,
+  1.19180954575043851484e+00,
+  1.19299752604894204744e+00,
+  1.19419068988708731993e+00,
+  1.19538905845696152852e+00,
+  1.19659265309141482625e+00,
+  1.19780149526512280644e+00,
+  1.19901560659565586953e+00,
+  1.20023500884456146842e+00,
+  1.20145972391845501370e+00,
+  1.20268977387012165892e+00,
+  1.20392518089962852201e+00,
+  1.20516596735544778696e+00,
+  1.20641215573559001939e+00,
+  1.20766376868874836248e+00,
+  1.20892082901545494522e+00,
+  1.21018335966924550640e+00,
+  1.21145138375783889551e+00,
+  1.21272492454432478937e+00,
+  1.21400400544836406524e+00,
+  1.21528865004740138644e+00,
+  1.21657888207788889012e+00,
+  1.21787472543652008916e+00,
+  1.21917620418147976125e+00,
+  1.22048334253370138747e+00,
+  1.22179616487813968995e+00,
+  1.22311469576505493784e+00,
+  1.22443895991130879963e+00,
+  1.22576898220167462839e+00,
+  1.22710478769015818301e+00,
+  1.22844640160133367068e+00,
+  1.22979384933169133554e+00,
+  1.23114715645099859209e+00,
+  1.23250634870367448137e+00,
+  1.23387145201017811580e+00,
+  1.23524249246840978067e+00,
+  1.23661949635512846690e+00,
+  1.23800249012737806353e+00,
+  1.23939150042393486650e+00,
+  1.24078655406676263695e+00,
+  1.24218767806248675534e+00,
+  1.24359489960388081009e+00,
+  1.24500824607136850730e+00,
+  1.24642774503454067947e+00,
+  1.24785342425368739327e+00,
+  1.24928531168134515639e+00,
+  1.25072343546386011148e+00,
+  1.25216782394296632930e+00,
+  1.25361850565737942276e+00,
+  1.25507550934440881285e+00,
+  1.25653886394158309514e+00,
+  1.25800859858829316984e+00,
+  1.25948474262745246932e+00,
+  1.26096732560717250671e+00,
+  1.26245637728245796438e+00,
+  1.26395192761691554928e+00,
+  1.26545400678448372034e+00,
+  1.26696264517117662685e+00,
+  1.26847787337684980713e+00,
+  1.26999972221697943198e+00,
+  1.27152822272446419660e+00,
+  1.27306340615144186756e+00,
+  1.27460530397112670187e+00,
+  1.27615394787966596191e+00,
+  1.27770936979801374989e+00,
+  1.27927160187382571443e+00,
+  1.28084067648337329715e+00,
+  1.28241662623347685290e+00,
+  1.28399948396345875423e+00,
+  1.28558928274711981032e+00,
+  1.28718605589472989692e+00,
+  1.28878983695504722995e+00,
+  1.29040065971735207206e+00,
+  1.29201855821350553022e+00,
+  1.29364356672002833726e+00,
+  1.29527571976020183797e+00,
+  1.29691505210619140165e+00,
+  1.29856159878119159501e+00,
+  1.30021539506159422572e+00,
+  1.30187647647917859040e+00,
+  1.30354487882332747972e+00,
+  1.30522063814326272357e+00,
+  1.30690379075030738143e+00,
+  1.30859437322017058136e+00,
+  1.31029242239525856029e+00,
+  1.31199797538700724253e+00,
+  1.31371106957824301809e+00,
+  1.31543174262556572529e+00,
+  1.31716003246175983321e+00,
+  1.31889597729823093708e+00,
+  1.32063961562746579048e+00,
+  1.32239098622552342377e+00,
+  1.32415012815454913309e+00,
+  1.32591708076531866745e+00,
+  1.32769188369980617459e+00,
+  1.32947457689378589762e+00,
+  1.33126520057945540998e+00,
+  1.33306379528809237911e+00,
+  1.33487040185273908577e+00,
+  1.33668506141091358863e+00,
+  1.33850781540735574993e+00,
+  1.34033870559679813006e+00,
+  1.34217777404677041098e+00,
+  1.34402506314043446167e+00,
+  1.34588061557944937974e+00,
+  1.34774447438686872935e+00,
+  1.34961668291007086395e+00,
+  1.35149728482372055716e+00,
+  1.35338632413276327426e+00,
+  1.35528384517545452681e+00,
+  1.35718989262642009130e+00,
+  1.35910451149975397556e+00,
+  1.36102774715214724921e+00,
+  1.36295964528605617616e+00,
+  1.36490025195290143323e+00,
+  1.36684961355630640867e+00,
+  1.36880777685537124988e+00,
+  1.37077478896798310437e+00,
+  1.37275069737416455240e+00,
+  1.37473554991945978720e+00,
+  1.37672939481836031916e+00,
+  1.37873228065776620710e+00,
+  1.38074425640049081032e+00,
+  1.38276537138880328826e+00,
+  1.38479567534801240036e+00,
+  1.38683521839009071819e+00,
+  1.38888405101734058178e+00,
+  1.39094222412610291073e+00,
+  1.39300978901050864778e+00,
+  1.39508679736627128065e+00,
+  1.39717330129452776966e+00,
+  1.39926935330571811100e+00,
+  1.40137500632351641450e+00,
+  1.40349031368880150517e+00,
+  1.40561532916367815105e+00,
+  1.40775010693554381014e+00,
+  1.40989470162120200669e+00,
+  1.41204916827102588961e+00,
+  1.41421356237316819815e+00,
+  1.41638793985782318607e+00,
+  1.41857235710153761765e+00,
+  1.42076687093157261188e+00,
+  1.42297153863031655696e+00,
+  1.42518641793975242571e+00,
+  1.42741156706597638326e+00,
+  1.42964704468376946345e+00,
+  1.43189290994122631062e+00,
+  1.43414922246443699017e+00,
+  1.43641604236222630853e+00,
+  1.43869343023094797829e+00,
+  1.44098144715933984550e+00,
+  1.44328015473343396202e+00,
+  1.44558961504152772015e+00,
+  1.44790989067921471722e+00,
+  1.45024104475447823681e+00,
+  1.45258314089284246151e+00,
+  1.45493624324259074321e+00,
+  1.45730041648004471355e+00,
+  1.45967572581491000783e+00,
+  1.46206223699568438334e+00,
+  1.46446001631513511576e+00,
+  1.46686913061584256468e+00,
+  1.46928964729581101878e+00,
+  1.47172163431415126134e+00,
+  1.47416516019682997118e+00,
+  1.47662029404249373066e+00,
+  1.47908710552836275554e+00,
+  1.48156566491619900994e+00,
+  1.48405604305834981638e+00,
+  1.48655831140386385236e+00,
+  1.48907254200468708305e+00,
+  1.49159880752193463316e+00,
+  1.49413718123224126266e+00,
+  1.49668773703419222265e+00,
+  1.49925054945483648972e+00,
+  1.50182569365627993641e+00,
+  1.50441324544236398886e+00,
+  1.50701328126542777319e+00,
+  1.50962587823315752544e+00,
+  1.51225111411552348706e+00,
+  1.51488906735180295371e+00,
+  1.51753981705769636079e+00,
+  1.52020344303253285290e+00,
+  1.52288002576656933407e+00,
+  1.52556964644838277678e+00,
+  1.52827238697235934239e+00,
+  1.53098832994627853665e+00,
+  1.53371755869899817348e+00,
+  1.53646015728823570612e+00,
+  1.53921621050845591760e+00,
+  1.54198580389885564479e+00,
+  1.54476902375145863644e+00,
+  1.54756595711931277393e+00,
+  1.55037669182479587171e+00,
+  1.55320131646803183401e+00,
+  1.55603992043541650148e+00,
+  1.55889259390825829499e+00,
+  1.56175942787153010372e+00,
+  1.56464051412274107733e+00,
+  1.56753594528092365934e+00,
+  1.57044581479574318905e+00,
+  1.57337021695672518717e+00,
+  1.57630924690261209342e+00,
+  1.57926300063084079639e+00,
+  1.58223157500714917134e+00,
+  1.58521506777531362431e+00,
+  1.58821357756701653230e+00,
+  1.59122720391184890865e+00,
+  1.59425604724744629515e+00,
+  1.59730020892976720681e+00,
+  1.60035979124350657976e+00,
+  1.60343489741265554649e+00,
+  1.60652563161120398583e+00,
+  1.60963209897399184278e+00,
+  1.61275440560770633169e+00,
+  1.61589265860203545877e+00,
+  1.61904696604097297907e+00,
+  1.62221743701427922879e+00,
+  1.62540418162910560440e+00,
+  1.62860731102177513918e+00,
+  1.63182693736973316589e+00,
+  1.63506317390365984998e+00,
+  1.63831613491975702779e+00,
+  1.64158593579220557501e+00,
+  1.64487269298579841248e+00,
+  1.64817652406875247983e+00,
+  1.65149754772570189765e+00,
+  1.65483588377087631471e+00,
+  1.65819165316146310829e+00,
+  1.66156497801116698199e+00,
+  1.66495598160395519294e+00,
+  1.66836478840800706003e+00,
+  1.67179152408985776113e+00,
+  1.67523631552875107431e+00,
+  1.67869929083119284741e+00,
+  1.68218057934572429168e+00,
+  1.68568031167789667002e+00,
+  1.68919861970547713348e+00,
+  1.69273563659386683256e+00,
+  1.69629149681174662412e+00,
+  1.69986633614695326067e+00,
+  1.70346029172258783824e+00,
+  1.70707350201336005568e+00,
+  1.71070610686217472463e+00,
+  1.71435824749696363867e+00,
+  1.71803006654776524442e+00,
+  1.72172170806406121812e+00,
+  1.72543331753236617310e+00,
+  1.72916504189408648529e+00,
+  1.73291702956363979915e+00,
+  1.73668943044685142318e+00,
+  1.74048239595962583870e+00,
+  1.74429607904689687459e+00,
+  1.74813063420187120300e+00,
+  1.75198621748555449784e+00,
+  1.75586298654658312657e+00,
+  1.75976110064135116140e+00,
+  1.76368072065444891905e+00,
+  1.76762200911941125270e+00,
+  1.77158513023978891887e+00,
+  1.77557024991053724605e+00,
+  1.77957753573974164496e+00,
+  1.78360715707067618574e+00,
+  1.78765928500420301361e+00,
+  1.79173409242152192888e+00,
+  1.79583175400727346194e+00,
+  1.79995244627300565732e+00,
+  1.80409634758100345664e+00,
+  1.80826363816849799981e+00,
+  1.81245450017225273598e+00,
+  1.81666911765354144315e+00,
+  1.82090767662351771250e+00,
+  1.82517036506899299475e+00,
+  1.82945737297861854564e+00,
+  1.83376889236948903417e+00,
+  1.83810511731417292047e+00,
+  1.84246624396817115787e+00,
+  1.84685247059782509105e+00,
+  1.85126399760866711119e+00,
+  1.85570102757423716078e+00,
+  1.86016376526535931468e+00,
+  1.86465241767989975408e+00,
+  1.86916719407301079592e+00,
+  1.87370830598786164423e+00,
+  1.87827596728688184236e+00,
+  1.88287039418351631603e+00,
+  1.88749180527449778033e+00,
+  1.89214042157266093547e+00,
+  1.89681646654029667509e+00,
+  1.90152016612306051790e+00,
+  1.90625174878444592075e+00,
+  1.91101144554083690608e+00,
+  1.91579948999714355651e+00,
+  1.92061611838304213684e+00,
+  1.92546156958981962148e+00,
+  1.93033608520784616402e+00,
+  1.93523990956468194824e+00,
+  1.94017328976382774641e+00,
+  1.94513647572414183351e+00,
+  1.95012972021992725402e+00,
+  1.95515327892170764912e+00,
+  1.96020741043770296841e+00,
+  1.96529237635602105350e+00,
+  1.97040844128757841602e+00,
+  1.97555587290977041626e+00,
+  1.98073494201088884381e+00,
+  1.98594592253532797876e+00,
+  1.99118909162957091752e+00,
+  1.99646472968899391098e+00,
+  2.00177312040547938921e+00,
+  2.00711455081588230343e+00,
+  2.01248931135135133985e+00,
+  2.01789769588751921603e+00,
+  2.02334000179559314603e+00,
+  2.02881652999435813101e+00,
+  2.03432758500310839622e+00,
+  2.03987347499552873487e+00,
+  2.04545451185455240406e+00,
+  2.05107101122820356665e+00,
+  2.05672329258646069405e+00,
+  2.06241167927914270663e+00,
+  2.06813649859486003990e+00,
+  2.07389808182104307122e+00,
+  2.07969676430506611453e+00,
+  2.08553288551650206628e+00,
+  2.09140678911052413369e+00,
+  2.09731882299248617585e+00,
+  2.10326933938369275978e+00,
+  2.10925869488840511679e+00,
+  2.11528725056209410127e+00,
+  2.12135537198097745559e+00,
+  2.12746342931285514766e+00,
+  2.13361179738929518379e+00,
+  2.13980085577917567008e+00,
+  2.14603098886362619879e+00,
+  2.15230258591239742572e+00,
+  2.15861604116168814826e+00,
+  2.16497175389347074059e+00,
+  2.17137012851633004473e+00,
+  2.17781157464787433753e+00,
+  2.18429650719873125198e+00,
+  2.19082534645818860497e+00,
+  2.19739851818148279605e+00,
+  2.20401645367881293680e+00,
+  2.21067958990609270131e+00,
+  2.21738836955748253033e+00,
+  2.22414324115975725604e+00,
+  2.23094465916853446075e+00,
+  2.23779308406642574170e+00,
+  2.24468898246312864586e+00,
+  2.25163282719753476968e+00,
+  2.25862509744187756056e+00,
+  2.26566627880798820982e+00,
+  2.27275686345568095348e+00,
+  2.27989735020335171356e+00,
+  2.28708824464082161043e+00,
+  2.29433005924447508406e+00,
+  2.30162331349476856346e+00,
+  2.30896853399614387925e+00,
+  2.31636625459942413485e+00,
+  2.32381701652672845171e+00,
+  2.33132136849899174180e+00,
+  2.33887986686613746912e+00,
+  2.34649307573997178977e+00,
+  2.35416156712986213151e+00,
+  2.36188592108128103675e+00,
+  2.36966672581726500724e+00,
+  2.37750457788288782623e+00,
+  2.38540008229279143492e+00,
+  2.39335385268187739172e+00,
+  2.40136651145922819239e+00,
+  2.40943868996533039351e+00,
+  2.41757102863269990323e+00,
+  2.42576417714997916164e+00,
+  2.43401879462961368006e+00,
+  2.44233554977916877959e+00,
+  2.45071512107641309441e+00,
+  2.45915819694824389074e+00,
+  2.46766547595356477984e+00,
+  2.47623766697020153416e+00,
+  2.48487548938597901937e+00,
+  2.49357967329406804424e+00,
+  2.50235095969268384053e+00,
+  2.51119010068929604529e+00,
+  2.52009785970942878919e+00,
+  2.52907501171019788444e+00,
+  2.53812234339869302602e+00,
+  2.54724065345535022331e+00,
+  2.55643075276243258998e+00,
+  2.56569346463777270273e+00,
+  2.57502962507389598912e+00,
+  2.58444008298269478630e+00,
+  2.59392570044579251487e+00,
+  2.60348735297074274087e+00,
+  2.61312592975324298195e+00,
+  2.62284233394551424823e+00,
+  2.63263748293102528564e+00,
+  2.64251230860572050574e+00,
+  2.65246775766595499491e+00,
+  2.66250479190330979762e+00,
+  2.67262438850648198496e+00,
+  2.68282754037044668394e+00,
+  2.69311525641310023360e+00,
+  2.70348856189960384810e+00,
+  2.71394849877462052135e+00,
+  2.72449612600270629770e+00,
+  2.73513251991705663713e+00,
+  2.74585877457688187775e+00,
+  2.75667600213362318229e+00,
+  2.76758533320629718233e+00,
+  2.77858791726622600393e+00,
+  2.78968492303142445721e+00,
+  2.80087753887091883698e+00,
+  2.81216697321931663467e+00,
+  2.82355445500191670760e+00,
+  2.83504123407065211637e+00,
+  2.84662858165123999754e+00,
+  2.85831779080182135644e+00,
+  2.87011017688348557542e+00,
+  2.88200707804298961179e+00,
+  2.89400985570809554659e+00,
+  2.90611989509586621239e+00,
+  2.91833860573435721619e+00,
+  2.93066742199807617197e+00,
+  2.94310780365767188371e+00,
+  2.95566123644428602191e+00,
+  2.96832923262900294503e+00,
+  2.98111333161790836854e+00,
+  2.99401510056322051057e+00,
+  3.00703613499102306861e+00,
+  3.02017805944610318036e+00,
+  3.03344252815446679961e+00,
+  3.04683122570409015140e+00,
+  3.06034586774448991164e+00,
+  3.07398820170572095734e+00,
+  3.08776000753744961358e+00,
+  3.10166309846873877731e+00,
+  3.11569932178924968724e+00,
+  3.12987055965253224699e+00,
+  3.14417872990217350804e+00,
+  3.15862578692155615556e+00,
+  3.17321372250798594550e+00,
+  3.18794456677205939599e+00,
+  3.20282038906309196591e+00,
+  3.21784329892150333663e+00,
+  3.23301544705906440669e+00,
+  3.24833902636799232155e+00,
+  3.26381627295985987658e+00,
+  3.27944946723537711364e+00,
+  3.29524093498608339203e+00,
+  3.31119304852910900649e+00,
+  3.32730822787615743152e+00,
+  3.34358894193788103166e+00,
+  3.36003770976496962675e+00,
+  3.37665710182721223731e+00,
+  3.39344974133193533206e+00,
+  3.41041830558318359579e+00,
+  3.42756552738319086870e+00,
+  3.44489419647762140642e+00,
+  3.46240716104623702520e+00,
+  3.48010732924060395277e+00,
+  3.49799767077064194254e+00,
+  3.51608121854181288057e+00,
+  3.53436107034480562206e+00,
+  3.55284039059976608499e+00,
+  3.57152241215706744981e+00,
+  3.59041043815682936469e+00,
+  3.60950784394937018718e+00,
+  3.62881807907900189036e+00,
+  3.64834466933356837970e+00,
+  3.66809121886231936926e+00,
+  3.68806141236474349654e+00,
+  3.70825901735321439290e+00,
+  3.72868788649232918431e+00,
+  3.74935196001797699239e+00,
+  3.77025526823937218168e+00,
+  3.79140193412734882727e+00,
+  3.81279617599244291526e+00,
+  3.83444231025636028676e+00,
+  3.85634475432072543200e+00,
+  3.87850802953705731113e+00,
+  3.90093676428221058927e+00,
+  3.92363569714362059315e+00,
+  3.94660968021901670255e+00,
+  3.96986368253540256035e+00,
+  3.99340279359233640832e+00,
+  4.01723222703487348184e+00,
+  4.04135732446168827181e+00,
+  4.06578355937426305644e+00,
+  4.09051654127321295817e+00,
+  4.11556201990825876180e+00,
+  4.14092588968855590537e+00,
+  4.16661419426052592740e+00,
+  4.19263313126059955493e+00,
+  4.21898905725079753637e+00,
+  4.24568849284533911259e+00,
+  4.27273812803701158458e+00,
+  4.30014482773238881919e+00,
+  4.32791563750556473877e+00,
+  4.35605778958052347605e+00,
+  4.38457870905276525519e+00,
+  4.41348602036150516881e+00,
+  4.44278755402423985998e+00,
+  4.47249135364621341893e+00,
+  4.50260568321790533020e+00,
+  4.53313903471452661620e+00,
+  4.56410013601212938283e+00,
+  4.59549795913589864682e+00,
+  4.62734172885690941968e+00,
+  4.65964093165474402269e+00,
+  4.69240532506423235759e+00,
+  4.72564494742559215723e+00,
+  4.75937012805854475772e+00,
+  4.79359149788198912745e+00,
+  4.82832000050219889431e+00,
+  4.86356690379380740552e+00,
+  4.89934381199937085682e+00,
+  4.93566267837476058133e+00,
+  4.97253581840936931258e+00,
+  5.00997592365177446538e+00,
+  5.04799607617355139411e+00,
+  5.08660976370583561845e+00,
+  5.12583089548534598379e+00,
+  5.16567381884910048484e+00,
+  5.20615333661932933040e+00,
+  5.24728472532289291763e+00,
+  5.28908375429222221698e+00,
+  5.33156670569808088800e+00,
+  5.37475039556749933922e+00,
+  5.41865219584396573538e+00,
+  5.46329005755056407168e+00,
+  5.50868253512104644187e+00,
+  5.55484881196809698878e+00,
+  5.60180872736271595613e+00,
+  5.64958280470398932493e+00,
+  5.69819228126376042809e+00,
+  5.74765913949685547379e+00,
+  5.79800614001372416340e+00,
+  5.84925685631954639376e+00,
+  5.90143571143108403021e+00,
+  5.95456801649085942785e+00,
+  6.00868001150681418920e+00,
+  6.06379890835534407501e+00,
+  6.11995293619571967270e+00,
+  6.17717138945507837633e+00,
+  6.23548467855547272620e+00,
+  6.29492438356744798966e+00,
+  6.35552331098911693630e+00,
+  6.41731555386509011640e+00,
+  6.48033655547692077903e+00,
+  6.54462317685491790087e+00,
+  6.61021376838164531620e+00,
+  6.67714824577921639559e+00,
+  6.74546817079690264052e+00,
+  6.81521683694174207346e+00,
+  6.88643936062361117223e+00,
+  6.95918277811816210487e+00,
+  7.03349614878538442753e+00,
+  7.10943066501987175343e+00,
+  7.18703976945044153979e+00,
+  7.26637927995318122498e+00,
+  7.34750752309227550541e+00,
+  7.43048547665912462179e+00,
+  7.51537692204165086451e+00,
+  7.60224860722412909553e+00,
+  7.69117042129280914509e+00,
+  7.78221558140632030387e+00,
+  7.87546083328186519168e+00,
+  7.97098666635124608604e+00,
+  8.06887754485440567009e+00,
+  8.16922215626481929007e+00,
+  8.27211367858281931831e+00,
+  8.37765006818981916581e+00,
+  8.48593437013286511217e+00,
+  8.59707505290514895080e+00,
+  8.71118637000914297630e+00,
+  8.82838875083555585377e+00,
+  8.94880922366943565294e+00,
+  9.07258187394659820768e+00,
+  9.19984834123611427970e+00,
+  9.33075835882130988352e+00,
+  9.46547034020066213600e+00,
+  9.60415201733897738734e+00,
+  9.74698113607527893976e+00,
+  9.89414621474971056614e+00,
+  1.00458473728573238759e+01,
+  1.02022972373883842323e+01,
+  1.03637219354866569887e+01,
+  1.05303621831715528145e+01,
+  1.07024744811474388229e+01,
+  1.08803324301941213292e+01,
+  1.10642281803258466510e+01,
+  1.12544740298630525643e+01,
+  1.14514041928277521265e+01,
+  1.16553767557025320656e+01,
+  1.18667758476543490076e+01,
+  1.20860140518939900289e+01,
+  1.23135350900199505020e+01,
+  1.25498168160940846150e+01,
+  1.27953745629616904012e+01,
+  1.30507648901295958410e+01,
+  1.33165897905684751379e+01,
+  1.35935014233654349880e+01,
+  1.38822074505446444448e+01,
+  1.41834770699954422213e+01,
+  1.44981478527905771614e+01,
+  1.48271335128663288572e+01,
+  1.51714327608435262107e+01,
+  1.55321394226806734906e+01,
+  1.59104540391052466930e+01,
+  1.63076972049600321668e+01,
+  1.67253249607559943968e+01,
+  1.71649466144709030857e+01,
+  1.76283454533693451083e+01,
+  1.81175029077921543319e+01,
+  1.86346268573104083544e+01,
+  1.91821849320826700591e+01,
+  1.97629438690049070715e+01,
+  2.03800162471376999918e+01,
+  2.10369162687008746104e+01,
+  2.17376266962664850269e+01,
+  2.24866796390268568473e+01,
+  2.32892546504047004419e+01,
+  2.41512986251332186782e+01,
+  2.50796733648924963234e+01,
+  2.60823385596994157254e+01,
+  2.71685805146436045732e+01,
+  2.83493005444688890293e+01,
+  2.96373820212225247417e+01,
+  3.10481622926596223522e+01,
+  3.26000461761709061648e+01,
+  3.43153131876337056383e+01,
+  3.62211938465481892990e+01,
+  3.83513258535718009057e+01,
+  4.07477563346320792448e+01,
+  4.34637449826826056665e+01,
+  4.65677685459284163016e+01,
+  5.01493735413814007984e+01,
+  5.43279553251978839512e+01,
+  5.92663257468375732628e+01,
+  6.51924213957107525630e+01,
+  7.24354840122655758705e+01,
+  8.14893762073848222371e+01,
+  9.31301677984182845194e+01,
+  1.08651308481230117309e+02,
+  1.30381007708729015349e+02,
+  1.62975684387186817048e+02,
+  2.17300315965294032594e+02,
+  3.25949834790668489859e+02,
+  6.51898902611816538410e+02,
+  -1.00000000000000000000e+08,
+  -6.51898902523922629371e+02,
+  -3.25949834768671451002e+02,
+  -2.17300315955528077438e+02,
+  -1.62975684381693469049e+02,
+  -1.30381007705209498226e+02,
+  -1.08651308478786049250e+02,
+  -9.31301677966245478046e+01,
+  -8.14893762060115278700e+01,
+  -7.24354840111793407686e+01,
+  -6.51924213948318538314e+01,
+  -5.92663257461112138458e+01,
+  -5.43279553245875490575e+01,
+  -5.01493735408607932413e+01,
+  -4.65677685454800140974e+01,
+  -4.34637449822920061138e+01,
+  -4.07477563342884110398e+01,
+  -3.83513258532673830814e+01,
+  -3.62211938462769467151e+01,
+  -3.43153131873902665916e+01,
+  -3.26000461759509647663e+01,
+  -3.10481622924603470892e+01,
+  -2.96373820210409562037e+01,
+  -2.83493005443027712431e+01,
+  -2.71685805144908840703e+01,
+  -2.60823385595588206343e+01,
+  -2.50796733647625096353e+01,
+  -2.41512986250125543108e+01,
+  -2.32892546502925057439e+01,
+  -2.24866796389223786434e+01,
+  -2.17376266961688564550e+01,
+  -2.10369162686093496006e+01,
+  -2.03800162470519019564e+01,
+  -1.97629438689242284966e+01,
+  -1.91821849320066704081e+01,
+  -1.86346268572386151163e+01,
+  -1.81175029077243685549e+01,
+  -1.76283454533051759938e+01,
+  -1.71649466144100664167e+01,
+  -1.67253249606981775344e+01,
+  -1.63076972049051320823e+01,
+  -1.59104540390529987093e+01,
+  -1.55321394226308289177e+01,
+  -1.51714327607959731381e+01,
+  -1.48271335128209607035e+01,
+  -1.44981478527472074092e+01,
+  -1.41834770699538932348e+01,
+  -1.38822074505048895787e+01,
+  -1.35935014233273196993e+01,
+  -1.33165897905319017269e+01,
+  -1.30507648900944328574e+01,
+  -1.27953745629279307394e+01,
+  -1.25498168160616145883e+01,
+  -1.23135350899886599763e+01,
+  -1.20860140518638505824e+01,
+  -1.18667758476253268896e+01,
+  -1.16553767556745402345e+01,
+  -1.14514041928007035409e+01,
+  -1.12544740298369596587e+01,
+  -1.10642281803006312657e+01,
+  -1.08803324301697426080e+01,
+  -1.07024744811238257114e+01,
+  -1.05303621831487213001e+01,
+  -1.03637219354645466751e+01,
+  -1.02022972373669382762e+01,
+  -1.00458473728365333955e+01,
+  -9.89414621472956845594e+00,
+  -9.74698113605573368545e+00,
+  -9.60415201731998280366e+00,
+  -9.46547034018223421015e+00,
+  -9.33075835880340598294e+00,
+  -9.19984834121871308810e+00,
+  -9.07258187392965886886e+00,
+  -8.94880922365297593046e+00,
+  -8.82838875081954022050e+00,
+  -8.71118636999353590511e+00,
+  -8.59707505288995044168e+00,
+  -8.48593437011807516512e+00,
+  -8.37765006817540758277e+00,
+  -8.27211367856875590121e+00,
+  -8.16922215625112180248e+00,
+  -8.06887754484104213759e+00,
+  -7.97098666633820851501e+00,
+  -7.87546083326912782496e+00,
+  -7.78221558139389824049e+00,
+  -7.69117042128067751605e+00,
+  -7.60224860721226658455e+00,
+  -7.51537692203006102432e+00,
+  -7.43048547664780834054e+00,
+  -7.34750752308121413137e+00,
+  -7.26637927994235433005e+00,
+  -7.18703976943986244663e+00,
+  -7.10943066500952092213e+00,
+  -7.03349614877525652901e+00,
+  -6.95918277810823937557e+00,
+  -6.88643936061390693482e+00,
+  -6.81521683693223945255e+00,
+  -6.74546817078759541886e+00,
+  -6.67714824577008947415e+00,
+  -6.61021376837271201765e+00,
+  -6.54462317684616134983e+00,
+  -6.48033655546832854100e+00,
+  -6.41731555385666840863e+00,
+  -6.35552331098086664696e+00,
+  -6.29492438355935668426e+00,
+  -6.23548467854752708206e+00,
+  -6.17717138944729082795e+00,
+  -6.11995293618807689739e+00,
+  -6.06379890834784252007e+00,
+  -6.00868001149944408468e+00,
+  -5.95456801648363054369e+00,
+  -5.90143571142398482010e+00,
+  -5.84925685631256708774e+00,
+  -5.79800614000686831417e+00,
+  -5.74765913949012752227e+00,
+  -5.69819228125714882793e+00,
+  -5.64958280469748608255e+00,
+  -5.60180872735632995330e+00,
+  -5.55484881196181934371e+00,
+  -5.50868253511487449003e+00,
+  -5.46329005754448893128e+00,
+  -5.41865219583799806458e+00,
+  -5.37475039556162936805e+00,
+  -5.33156670569230062284e+00,
+  -5.28908375428653521055e+00,
+  -5.24728472531730272266e+00,
+  -5.20615333661382795327e+00,
+  -5.16567381884367904377e+00,
+  -5.12583089548001602509e+00,
+  -5.08660976370058914853e+00,
+  -5.04799607616838574842e+00,
+  -5.00997592364668253850e+00,
+  -4.97253581840436087447e+00,
+  -4.93566267836982675021e+00,
+  -4.89934381199450541544e+00,
+  -4.86356690378901390659e+00,
+  -4.82832000049748177872e+00,
+  -4.79359149787734040160e+00,
+  -4.75937012805395998072e+00,
+  -4.72564494742107754632e+00,
+  -4.69240532505978347189e+00,
+  -4.65964093165035819766e+00,
+  -4.62734172885258132624e+00,
+  -4.59549795913163627858e+00,
+  -4.56410013600792563437e+00,
+  -4.53313903471037615844e+00,
+  -4.50260568321381260404e+00,
+  -4.47249135364218108890e+00,
+  -4.44278755402026259702e+00,
+  -4.41348602035757764384e+00,
+  -4.38457870904889368546e+00,
+  -4.35605778957670342066e+00,
+  -4.32791563750179619774e+00,
+  -4.30014482772866557525e+00,
+  -4.27273812803334074317e+00,
+  -4.24568849284171534464e+00,
+  -4.21898905724721728916e+00,
+  -4.19263313125706549300e+00,
+  -4.16661419425703982711e+00,
+  -4.14092588968511421399e+00,
+  -4.11556201990485703845e+00,
+  -4.09051654126985742010e+00,
+  -4.06578355937094926276e+00,
+  -4.04135732445841533433e+00,
+  -4.01723222703163695968e+00,
+  -3.99340279358914340690e+00,
+  -3.96986368253224819469e+00,
+  -3.94660968021590052857e+00,
+  -3.92363569714053905813e+00,
+  -3.90093676427916857818e+00,
+  -3.87850802953405127127e+00,
+  -3.85634475431775181065e+00,
+  -3.83444231025342174846e+00,
+  -3.81279617598954168045e+00,
+  -3.79140193412448089916e+00,
+  -3.77025526823653400754e+00,
+  -3.74935196001517478948e+00,
+  -3.72868788648955939991e+00,
+  -3.70825901735047569474e+00,
+  -3.68806141236203277600e+00,
+  -3.66809121885964151133e+00,
+  -3.64834466933092116392e+00,
+  -3.62881807907638131994e+00,
+  -3.60950784394677848255e+00,
+  -3.59041043815426919039e+00,
+  -3.57152241215453480905e+00,
+  -3.55284039059725831322e+00,
+  -3.53436107034232804835e+00,
+  -3.51608121853936150814e+00,
+  -3.49799767076821721545e+00,
+  -3.48010732923820187423e+00,
+  -3.46240716104386336838e+00,
+  -3.44489419647527306267e+00,
+  -3.42756552738086384124e+00,
+  -3.41041830558088188141e+00,
+  -3.39344974132965981894e+00,
+  -3.37665710182496026093e+00,
+  -3.36003770976273763438e+00,
+  -3.34358894193567524056e+00,
+  -3.32730822787397384488e+00,
+  -3.31119304852694718022e+00,
+  -3.29524093498394110568e+00,
+  -3.27944946723325880811e+00,
+  -3.26381627295776244324e+00,
+  -3.24833902636591398405e+00,
+  -3.23301544705700649729e+00,
+  -3.21784329891946807578e+00,
+  -3.20282038906107668907e+00,
+  -3.18794456677006188272e+00,
+  -3.17321372250600930442e+00,
+  -3.15862578691959905441e+00,
+  -3.14417872990023550273e+00,
+  -3.12987055965060978480e+00,
+  -3.11569932178734809725e+00,
+  -3.10166309846685495089e+00,
+  -3.08776000753558177436e+00,
+  -3.07398820170387088169e+00,
+  -3.06034586774265937592e+00,
+  -3.04683122570227604697e+00,
+  -3.03344252815266823831e+00,
+  -3.02017805944432282672e+00,
+  -3.00703613498926003444e+00,
+  -2.99401510056147301952e+00,
+  -2.98111333161617508836e+00,
+  -2.96832923262728742841e+00,
+  -2.95566123644258604841e+00,
+  -2.94310780365598700925e+00,
+  -2.93066742199640462019e+00,
+  -2.91833860573270209571e+00,
+  -2.90611989509422574685e+00,
+  -2.89400985570646795964e+00,
+  -2.88200707804137712387e+00,
+  -2.87011017688188818653e+00,
+  -2.85831779080023862250e+00,
+  -2.84662858164966925401e+00,
+  -2.83504123406909691596e+00,
+  -2.82355445500037438578e+00,
+  -2.81216697321778807961e+00,
+  -2.80087753886940138415e+00,
+  -2.78968492302992165932e+00,
+  -2.77858791726473652872e+00,
+  -2.76758533320481880935e+00,
+  -2.75667600213215679972e+00,
+  -2.74585877457542970603e+00,
+  -2.73513251991561645582e+00,
+  -2.72449612600127633044e+00,
+  -2.71394849877320476494e+00,
+  -2.70348856189819919393e+00,
+  -2.69311525641170712575e+00,
+  -2.68282754036906379014e+00,
+  -2.67262438850511196975e+00,
+  -2.66250479190195088464e+00,
+  -2.65246775766460585189e+00,
+  -2.64251230860438202086e+00,
+  -2.63263748292969923526e+00,
+  -2.62284233394419885599e+00,
+  -2.61312592975193691558e+00,
+  -2.60348735296944822082e+00,
+  -2.59392570044450865296e+00,
+  -2.58444008298142069435e+00,
+  -2.57502962507263077896e+00,
+  -2.56569346463651903889e+00,
+  -2.55643075276118869610e+00,
+  -2.54724065345411476713e+00,
+  -2.53812234339746733980e+00,
+  -2.52907501170898285636e+00,
+  -2.52009785970822308698e+00,
+  -2.51119010068809878078e+00,
+  -2.50235095969149679007e+00,
+  -2.49357967329288987557e+00,
+  -2.48487548938481017657e+00,
+  -2.47623766696903979678e+00,
+  -2.46766547595241370061e+00,
+  -2.45915819694710124921e+00,
+  -2.45071512107527755830e+00,
+  -2.44233554977804212527e+00,
+  -2.43401879462849723978e+00,
+  -2.42576417714887071497e+00,
+  -2.41757102863159811790e+00,
+  -2.40943868996423793405e+00,
+  -2.40136651145814417063e+00,
+  -2.39335385268080091947e+00,
+  -2.38540008229172206811e+00,
+  -2.37750457788182645302e+00,
+  -2.36966672581621118354e+00,
+  -2.36188592108023565075e+00,
+  -2.35416156712882473911e+00,
+  -2.34649307573894105872e+00,
+  -2.33887986686511428758e+00,
+  -2.33132136849797522160e+00,
+  -2.32381701652571903693e+00,
+  -2.31636625459842182551e+00,
+  -2.30896853399515089578e+00,
+  -2.30162331349378135315e+00,
+  -2.29433005924349497917e+00,
+  -2.28708824463984861097e+00,
+  -2.27989735020238581953e+00,
+  -2.27275686345472083261e+00,
+  -2.26566627880703430620e+00,
+  -2.25862509744093031827e+00,
+  -2.25163282719659507691e+00,
+  -2.24468898246219561443e+00,
+  -2.23779308406549892752e+00,
+  -2.23094465916761430790e+00,
+  -2.22414324115884198818e+00,
+  -2.21738836955657392380e+00,
+  -2.21067958990519031204e+00,
+  -2.20401645367791854113e+00,
+  -2.19739851818059372945e+00,
+  -2.19082534645730531153e+00,
+  -2.18429650719785417579e+00,
+  -2.17781157464700170223e+00,
+  -2.17137012851546362668e+00,
+  -2.16497175389261009570e+00,
+  -2.15861604116083505289e+00,
+  -2.15230258591154921533e+00,
+  -2.14603098886278376156e+00,
+  -2.13980085577833856192e+00,
+  -2.13361179738846340470e+00,
+  -2.12746342931202825355e+00,
+  -2.12135537198015544647e+00,
+  -2.11528725056127786530e+00,
+  -2.10925869488759509807e+00,
+  -2.10326933938288762604e+00,
+  -2.09731882299168637118e+00,
+  -2.09140678910972965809e+00,
+  -2.08553288551571158749e+00,
+  -2.07969676430428096481e+00,
+  -2.07389808182026280647e+00,
+  -2.06813649859408643650e+00,
+  -2.06241167927837310003e+00,
+  -2.05672329258569597243e+00,
+  -2.05107101122744373001e+00,
+  -2.04545451185379656422e+00,
+  -2.03987347499477778001e+00,
+  -2.03432758500236232635e+00,
+  -2.02881652999361650203e+00,
+  -2.02334000179485729021e+00,
+  -2.01789769588678780110e+00,
+  -2.01248931135062480990e+00,
+  -2.00711455081516021437e+00,
+  -2.00177312040476040877e+00,
+  -1.99646472968827937144e+00,
+  -1.99118909162886126296e+00,
+  -1.98594592253462298714e+00,
+  -1.98073494201018851513e+00,
+  -1.97555587290907452847e+00,
+  -1.97040844128688674708e+00,
+  -1.96529237635533227113e+00,
+  -1.96020741043701884898e+00,
+  -1.95515327892102752649e+00,
+  -1.95012972021925268251e+00,
+  -1.94513647572347081471e+00,
+  -1.94017328976316028033e+00,
+  -1.93523990956401870100e+00,
+  -1.93033608520718691359e+00,
+  -1.92546156958916392377e+00,
+  -1.92061611838238999184e+00,
+  -1.91579948999649518626e+00,
+  -1.91101144554019342081e+00,
+  -1.90625174878380598820e+00,
+  -1.90152016612242413807e+00,
+  -1.89681646653966429206e+00,
+  -1.89214042157203188310e+00,
+  -1.88749180527387205863e+00,
+  -1.88287039418289436910e+00,
+  -1.87827596728626500244e+00,
+  -1.87370830598724769089e+00,
+  -1.86916719407240017325e+00,
+  -1.86465241767929290617e+00,
+  -1.86016376526475490927e+00,
+  -1.85570102757363653012e+00,
+  -1.85126399760806981121e+00,
+  -1.84685247059723200991e+00,
+  -1.84246624396758207354e+00,
+  -1.83810511731358672272e+00,
+  -1.83376889236890616708e+00,
+  -1.82945737297803856514e+00,
+  -1.82517036506841590082e+00,
+  -1.82090767662294372720e+00,
+  -1.81666911765297056647e+00,
+  -1.81245450017168630019e+00,
+  -1.80826363816793467265e+00,
+  -1.80409634758044323810e+00,
+  -1.79995244627244810331e+00,
+  -1.79583175400671901656e+00,
+  -1.79173409242097014804e+00,
+  -1.78765928500365456344e+00,
+  -1.78360715707013195441e+00,
+  -1.77957753573920007817e+00,
+  -1.77557024990999812175e+00,
+  -1.77158513023925290319e+00,
+  -1.76762200911887834565e+00,
+  -1.76368072065391823244e+00,
+  -1.75976110064082358342e+00,
+  -1.75586298654605821312e+00,
+  -1.75198621748503335915e+00,
+  -1.74813063420135272885e+00,
+  -1.74429607904638150906e+00,
+  -1.74048239595911291566e+00,
+  -1.73668943044634116468e+00,
+  -1.73291702956313198314e+00,
+  -1.72916504189358133381e+00,
+  -1.72543331753186479638e+00,
+  -1.72172170806356228390e+00,
+  -1.71803006654726897473e+00,
+  -1.71435824749646958942e+00,
+  -1.71070610686168311787e+00,
+  -1.70707350201287089142e+00,
+  -1.70346029172210133851e+00,
+  -1.69986633614647031365e+00,
+  -1.69629149681126611959e+00,
+  -1.69273563659338877052e+00,
+  -1.68919861970500151394e+00,
+  -1.68568031167742304888e+00,
+  -1.68218057934525289099e+00,
+  -1.67869929083072455533e+00,
+  -1.67523631552828455860e+00,
+  -1.67179152408939479812e+00,
+  -1.66836478840754631747e+00,
+  -1.66495598160349667083e+00,
+  -1.66156497801071090237e+00,
+  -1.65819165316100947116e+00,
+  -1.65483588377042445394e+00,
+  -1.65149754772525247937e+00,
+  -1.64817652406830617018e+00,
+  -1.64487269298535410122e+00,
+  -1.64158593579176370625e+00,
+  -1.63831613491931737947e+00,
+  -1.63506317390322220007e+00,
+  -1.63182693736929773642e+00,
+  -1.62860731102134170811e+00,
+  -1.62540418162867505991e+00,
+  -1.62221743701385068270e+00,
+  -1.61904696604054643139e+00,
+  -1.61589265860161113153e+00,
+  -1.61275440560728422490e+00,
+  -1.60963209897357151235e+00,
+  -1.60652563161078587584e+00,
+  -1.60343489741223899081e+00,
+  -1.60035979124309313271e+00,
+  -1.59730020892935575816e+00,
+  -1.59425604724703684489e+00,
+  -1.59122720391144145680e+00,
+  -1.58821357756661107885e+00,
+  -1.58521506777490994722e+00,
+  -1.58223157500674727061e+00,
+  -1.57926300063044178223e+00,
+  -1.57630924690221485562e+00,
+  -1.57337021695632994778e+00,
+  -1.57044581479534972601e+00,
+  -1.56753594528053219470e+00,
+  -1.56464051412235116700e+00,
+  -1.56175942787114241384e+00,
+  -1.55889259390787215942e+00,
+  -1.55603992043503325249e+00,
+  -1.55320131646765013933e+00,
+  -1.55037669182441595339e+00,
+  -1.54756595711893463196e+00,
+  -1.54476902375108227083e+00,
+  -1.54198580389848083350e+00,
+  -1.53921621050808266062e+00,
+  -1.53646015728786511367e+00,
+  -1.53371755869862935739e+00,
+  -1.53098832994591149692e+00,
+  -1.52827238697199385697e+00,
+  -1.52556964644801884567e+00,
+  -1.52288002576620717932e+00,
+  -1.52020344303217247450e+00,
+  -1.51753981705733820284e+00,
+  -1.51488906735144657212e+00,
+  -1.51225111411516888182e+00,
+  -1.50962587823280447452e+00,
+  -1.50701328126507583249e+00,
+  -1.50441324544201382452e+00,
+  -1.50182569365593177046e+00,
+  -1.49925054945448965604e+00,
+  -1.49668773703384760942e+00,
+  -1.49413718123189820375e+00,
+  -1.49159880752159312856e+00,
+  -1.48907254200434713276e+00,
+  -1.48655831140352545638e+00,
+  -1.48405604305801275267e+00,
+  -1.48156566491586372258e+00,
+  -1.47908710552802968863e+00,
+  -1.47662029404216221806e+00,
+  -1.47416516019650001290e+00,
+  -1.47172163431382263532e+00,
+  -1.46928964729548372503e+00,
+  -1.46686913061551638116e+00,
+  -1.46446001631481070859e+00,
+  -1.46206223699536197458e+00,
+  -1.45967572581458915337e+00,
+  -1.45730041647972541341e+00,
+  -1.45493624324227255329e+00,
+  -1.45258314089252582590e+00,
+  -1.45024104475416315552e+00,
+  -1.44790989067890096820e+00,
+  -1.44558961504121508135e+00,
+  -1.44328015473312332162e+00,
+  -1.44098144715903075941e+00,
+  -1.43869343023064022447e+00,
+  -1.43641604236191988697e+00,
+  -1.43414922246413190088e+00,
+  -1.43189290994092277565e+00,
+  -1.42964704468346703869e+00,
+  -1.42741156706567595691e+00,
+  -1.42518641793945333163e+00,
+  -1.42297153863001857310e+00,
+  -1.42076687093127573824e+00,
+  -1.41857235710124229833e+00,
+  -1.41638793985752919902e+00,
+  -1.41421356237287532132e+00,
+  -1.41204916827073501118e+00,
+  -1.40989470162091246053e+00,
+  -1.40775010693525537420e+00,
+  -1.40561532916339082533e+00,
+  -1.40349031368851528967e+00,
+  -1.40137500632323153127e+00,
+  -1.39926935330543456004e+00,
+  -1.39717330129424532892e+00,
+  -1.39508679736599083832e+00,
+  -1.39300978901022931566e+00,
+  -1.39094222412582491089e+00,
+  -1.38888405101706369216e+00,
+  -1.38683521838981471674e+00,
+  -1.38479567534773773119e+00,
+  -1.38276537138852995135e+00,
+  -1.38074425640021902773e+00,
+  -1.37873228065749553473e+00,
+  -1.37672939481809097906e+00,
+  -1.37473554991919177937e+00,
+  -1.37275069737389743274e+00,
+  -1.37077478896771687289e+00,
+  -1.36880777685510635067e+00,
+  -1.36684961355604261968e+00,
+  -1.36490025195263942059e+00,
+  -1.36295964528579505171e+00,
+  -1.36102774715188723498e+00,
+  -1.35910451149949484950e+00,
+  -1.35718989262616229752e+00,
+  -1.35528384517519784325e+00,
+  -1.35338632413250770092e+00,
+  -1.35149728482346653813e+00,
+  -1.34961668290981795515e+00,
+  -1.34774447438661670873e+00,
+  -1.34588061557919824729e+00,
+  -1.34402506314018466149e+00,
+  -1.34217777404652172102e+00,
+  -1.34033870559655032828e+00,
+  -1.33850781540710950246e+00,
+  -1.33668506141066845139e+00,
+  -1.33487040185249483670e+00,
+  -1.33306379528784924027e+00,
+  -1.33126520057921338136e+00,
+  -1.32947457689354497923e+00,
+  -1.32769188369956614437e+00,
+  -1.32591708076507930336e+00,
+  -1.32415012815431176740e+00,
+  -1.32239098622528672422e+00,
+  -1.32063961562722997911e+00,
+  -1.31889597729799623593e+00,
+  -1.31716003246152624229e+00,
+  -1.31543174262533280050e+00,
+  -1.31371106957801098147e+00,
+  -1.31199797538677698228e+00,
+  -1.31029242239502918821e+00,
+  -1.30859437321994209746e+00,
+  -1.30690379075007978571e+00,
+  -1.30522063814303601603e+00,
+  -1.30354487882310188240e+00,
+  -1.30187647647895410330e+00,
+  -1.30021539506137084885e+00,
+  -1.29856159878096932836e+00,
+  -1.29691505210597002318e+00,
+  -1.29527571975998134768e+00,
+  -1.29364356671980873514e+00,
+  -1.29201855821328681628e+00,
+  -1.29040065971713424631e+00,
+  -1.28878983695483029237e+00,
+  -1.28718605589451429161e+00,
+  -1.28558928274690487115e+00,
+  -1.28399948396324514732e+00,
+  -1.28241662623326369008e+00,
+  -1.28084067648316102250e+00,
+  -1.27927160187361455002e+00,
+  -1.27770936979780325160e+00,
+  -1.27615394787945679589e+00,
+  -1.27460530397091842403e+00,
+  -1.27306340615123447790e+00,
+  -1.27152822272425769512e+00,
+  -1.26999972221677381867e+00,
+  -1.26847787337664463791e+00,
+  -1.26696264517097234581e+00,
+  -1.26545400678428032748e+00,
+  -1.26395192761671348869e+00,
+  -1.26245637728225679197e+00,
+  -1.26096732560697222247e+00,
+  -1.25948474262725285122e+00,
+  -1.25800859858809443992e+00,
+  -1.25653886394138525340e+00,
+  -1.25507550934421163724e+00,
+  -1.25361850565718335737e+00,
+  -1.25216782394277115209e+00,
+  -1.25072343546366582245e+00,
+  -1.24928531168115175554e+00,
+  -1.24785342425349465856e+00,
+  -1.24642774503434861089e+00,
+  -1.24500824607117732690e+00,
+  -1.24359489960369073991e+00,
+  -1.24218767806229735129e+00,
+  -1.24078655406657412108e+00,
+  -1.23939150042374701677e+00,
+  -1.23800249012719110198e+00,
+  -1.23661949635494217148e+00,
+  -1.23524249246822459547e+00,
+  -1.23387145200999315264e+00,
+  -1.23250634870349085048e+00,
+  -1.23114715645081584938e+00,
+  -1.22979384933150948100e+00,
+  -1.22844640160115248229e+00,
+  -1.22710478768997743870e+00,
+  -1.22576898220149455021e+00,
+  -1.22443895991112960964e+00,
+  -1.22311469576487685806e+00,
+  -1.22179616487796227631e+00,
+  -1.22048334253352463996e+00,
+  -1.21917620418130390192e+00,
+  -1.21787472543634489597e+00,
+  -1.21657888207771436306e+00,
+  -1.21528865004722774756e+00,
+  -1.21400400544819153659e+00,
+  -1.21272492454415292684e+00,
+  -1.21145138375766769911e+00,
+  -1.21018335966907497614e+00,
+  -1.20892082901528508110e+00,
+  -1.20766376868857916449e+00,
+  -1.20641215573542126549e+00,
+  -1.20516596735527992124e+00,
+  -1.20392518089946154447e+00,
+  -1.20268977386995556955e+00,
+  -1.20145972391828959047e+00,
+  -1.20023500884439693337e+00,
+  -1.19901560659549177856e+00,
+  -1.19780149526495915957e+00,
+  -1.19659265309125206755e+00,
+  -1.19538905845679965800e+00,
+  -1.19419068988692633759e+00,
+  -1.19299752604878150919e+00,
+  -1.19180954575027842068e+00,
+  -1.19062672793904278379e+00,
+  -1.18944905170137116279e+00,
+  -1.18827649626120046555e+00,
+  -1.18710904097908565014e+00,
+  -1.18594666535118808959e+00,
+  -1.18478934900827037602e+00,
+  -1.18363707171470600166e+00,
+  -1.18248981336749281468e+00,
+  -1.18134755399527802133e+00,
+  -1.18021027375739295806e+00,
+  -1.17907795294289452492e+00,
+  -1.17795057196961794332e+00,
+  -1.17682811138323506484e+00,
+  -1.17571055185632622475e+00,
+  -1.17459787418745542631e+00,
+  -1.17349005930025662714e+00,
+  -1.17238708824252935159e+00,
+  -1.17128894218533985416e+00,
+  -1.17019560242213316315e+00,
+  -1.16910705036785067534e+00,
+  -1.16802326755805863101e+00,
+  -1.16694423564808191784e+00,
+  -1.16586993641214808903e+00,
+  -1.16480035174253671038e+00,
+  -1.16373546364873914349e+00,
+  -1.16267525425662299199e+00,
+  -1.16161970580760720573e+00,
+  -1.16056880065784095990e+00,
+  -1.15952252127739496856e+00,
+  -1.15848085024945501864e+00,
+  -1.15744377026952549592e+00,
+  -1.15641126414464023853e+00,
+  -1.15538331479257938561e+00,
+  -1.15435990524109333144e+00,
+  -1.15334101862713378495e+00,
+  -1.15232663819609371103e+00,
+  -1.15131674730105060256e+00,
+  -1.15031132940201863413e+00,
+  -1.14931036806520747717e+00,
+  -1.14831384696228688824e+00,
+  -1.14732174986965884678e+00,
+  -1.14633406066773502197e+00,
+  -1.14535076334022201117e+00,
+  -1.14437184197341168534e+00,
+  -1.14339728075547841790e+00,
+  -1.14242706397578297484e+00,
+  -1.14146117602418151193e+00,
+  -1.14049960139034145534e+00,
+  -1.13954232466306337734e+00,
+  -1.13858933052960797916e+00,
+  -1.13764060377503195554e+00,
+  -1.13669612928152385933e+00,
+  -1.13575589202775351083e+00,
+  -1.13481987708821985272e+00,
+  -1.13388806963260946326e+00,
+  -1.13296045492515884412e+00,
+  -1.13203701832402114924e+00,
+  -1.13111774528064201739e+00,
+  -1.13020262133913651503e+00,
+  -1.12929163213567496094e+00,
+  -1.12838476339787230351e+00,
+  -1.12748200094418282724e+00,
+  -1.12658333068330174243e+00,
+  -1.12568873861357010568e+00,
+  -1.12479821082238484742e+00,
+  -1.12391173348561679290e+00,
+  -1.12302929286703001566e+00,
+  -1.12215087531770851825e+00,
+  -1.12127646727548735406e+00,
+  -1.12040605526438841189e+00,
+  -1.11953962589406108563e+00,
+  -1.11867716585922827299e+00,
+  -1.11781866193913637098e+00,
+  -1.11696410099701193275e+00,
+  -1.11611346997951921267e+00,
+  -1.11526675591622703720e+00,
+  -1.11442394591907634194e+00,
+  -1.11358502718185503610e+00,
+  -1.11274998697967508754e+00,
+  -1.11191881266845671306e+00,
+  -1.11109149168441434519e+00,
+  -1.11026801154354881618e+00,
+  -1.10944835984114331673e+00,
+  -1.10863252425126357359e+00,
+  -1.10782049252626202396e+00,
+  -1.10701225249628731895e+00,
+  -1.10620779206879604750e+00,
+  -1.10540709922807178778e+00,
+  -1.10461016203474460262e+00,
+  -1.10381696862531741843e+00,
+  -1.10302750721169440240e+00,
+  -1.10224176608071555705e+00,
+  -1.10145973359369331313e+00,
+  -1.10068139818595378543e+00,
+  -1.09990674836638202549e+00,
+  -1.09913577271697171511e+00,
+  -1.09836845989237685828e+00,
+  -1.09760479861947013447e+00,
+  -1.09684477769690080784e+00,
+  -1.09608838599466196229e+00,
+  -1.09533561245365507197e+00,
+  -1.09458644608526434183e+00,
+  -1.09384087597093060396e+00,
+  -1.09309889126172943286e+00,
+  -1.09236048117795458978e+00,
+  -1.09162563500870302136e+00,
+  -1.09089434211146429909e+00,
+  -1.09016659191171427778e+00,
+  -1.08944237390250941999e+00,
+  -1.08872167764408800394e+00,
+  -1.08800449276347244165e+00,
+  -1.08729080895407603791e+00,
+  -1.08658061597531219178e+00,
+  -1.08587390365220715083e+00,
+  -1.08517066187501676211e+00,
+  -1.08447088059884499955e+00,
+  -1.08377454984326782039e+00,
+  -1.08308165969195746570e+00,
+  -1.08239220029231275610e+00,
+  -1.08170616185509005369e+00,
+  -1.08102353465403910882e+00,
+  -1.08034430902554068332e+00,
+  -1.07966847536824772646e+00,
+  -1.07899602414273032558e+00,
+  -1.07832694587112154494e+00,
+  -1.07766123113676992595e+00,
+  -1.07699887058388954486e+00,
+  -1.07633985491721850813e+00,
+  -1.07568417490167655970e+00,
+  -1.07503182136202690700e+00,
+  -1.07438278518254115568e+00,
+  -1.07373705730666668678e+00,
+  -1.07309462873669625438e+00,
+  -1.07245549053344157997e+00,
+  -1.07181963381590850126e+00,
+  -1.07118704976097589565e+00,
+  -1.07055772960307593600e+00,
+  -1.06993166463387834320e+00,
+  -1.06930884620197663715e+00,
+  -1.06868926571257727431e+00,
+  -1.06807291462719167185e+00,
+  -1.06745978446332867584e+00,
+  -1.06684986679419369082e+00,
+  -1.06624315324838603303e+00,
+  -1.06563963550960139059e+00,
+  -1.06503930531633650425e+00,
+  -1.06444215446159562433e+00,
+  -1.06384817479259918827e+00,
+  -1.06325735821049671692e+00,
+  -1.06266969667007948885e+00,
+  -1.06208518217949832163e+00,
+  -1.06150380679998090905e+00,
+  -1.06092556264555470946e+00,
+  -1.06035044188276916799e+00,
+  -1.05977843673042193551e+00,
+  -1.05920953945928775219e+00,
+  -1.05864374239184777515e+00,
+  -1.05808103790202245875e+00,
+  -1.05752141841490798768e+00,
+  -1.05696487640651093365e+00,
+  -1.05641140440348935137e+00,
+  -1.05586099498289431864e+00,
+  -1.05531364077191325279e+00,
+  -1.05476933444761522551e+00,
+  -1.05422806873670049654e+00,
+  -1.05368983641524938122e+00,
+  -1.05315463030847511483e+00,
+  -1.05262244329047782720e+00,
+  -1.05209326828400118181e+00,
+  -1.05156709826019145737e+00,
+  -1.05104392623835662945e+00,
+  -1.05052374528573055912e+00,
+  -1.05000654851723607131e+00,
+  -1.04949232909525336233e+00,
+  -1.04898108022938596484e+00,
+  -1.04847279517623381828e+00,
+  -1.04796746723916389676e+00,
+  -1.04746508976808572200e+00,
+  -1.04696565615922709824e+00,
+  -1.04646915985491206769e+00,
+  -1.04597559434334241857e+00,
+  -1.04548495315837697284e+00,
+  -1.04499722987931842333e+00,
+  -1.04451241813069706232e+00,
+  -1.04403051158205895099e+00,
+  -1.04355150394775519906e+00,
+  -1.04307538898673346495e+00,
+  -1.04260216050232945584e+00,
+  -1.04213181234206375692e+00,
+  -1.04166433839743644008e+00,
+  -1.04119973260372677970e+00,
+  -1.04073798893979163616e+00,
+  -1.04027910142786894632e+00,
+  -1.03982306413337965978e+00,
+  -1.03936987116473367188e+00,
+  -1.03891951667313642282e+00,
+  -1.03847199485239705119e+00,
+  -1.03802729993873876779e+00,
+  -1.03758542621061122802e+00,
+  -1.03714636798850334820e+00,
+  -1.03671011963475789841e+00,
+  -1.03627667555338964789e+00,
+  -1.03584603018990240031e+00,
+  -1.03541817803110958174e+00,
+  -1.03499311360495460654e+00,
+  -1.03457083148033612829e+00,
+  -1.03415132626693062612e+00,
+  -1.03373459261501898787e+00,
+  -1.03332062521531531374e+00,
+  -1.03290941879879483167e+00,
+  -1.03250096813652558758e+00,
+  -1.03209526803949969143e+00,
+  -1.03169231335846833808e+00,
+  -1.03129209898377682819e+00,
+  -1.03089461984519981108e+00,
+  -1.03049987091178185672e+00,
+  -1.03010784719167491907e+00,
+  -1.02971854373198157262e+00,
+  -1.02933195561859558431e+00,
+  -1.02894807797604692645e+00,
+  -1.02856690596734745569e+00,
+  -1.02818843479383725814e+00,
+  -1.02781265969503232682e+00,
+  -1.02743957594847601378e+00,
+  -1.02706917886958737363e+00,
+  -1.02670146381151661252e+00,
+  -1.02633642616499565214e+00,
+  -1.02597406135819602113e+00,
+  -1.02561436485658341589e+00,
+  -1.02525733216277625814e+00,
+  -1.02490295881640514075e+00,
+  -1.02455124039397227342e+00,
+  -1.02420217250871425918e+00,
+  -1.02385575081046464874e+00,
+  -1.02351197098551804920e+00,
+  -1.02317082875649623119e+00,
+  -1.02283231988221556819e+00,
+  -1.02249644015755380977e+00,
+  -1.02216318541332062964e+00,
+  -1.02183255151612839562e+00,
+  -1.02150453436826338383e+00,
+  -1.02117912990755987934e+00,
+  -1.02085633410727405490e+00,
+  -1.02053614297596006999e+00,
+  -1.02021855255734639201e+00,
+  -1.01990355893021478195e+00,
+  -1.01959115820827905807e+00,
+  -1.01928134654006541382e+00,
+  -1.01897412010879495625e+00,
+  -1.01866947513226580035e+00,
+  -1.01836740786273782788e+00,
+  -1.01806791458681744622e+00,
+  -1.01777099162534456767e+00,
+  -1.01747663533327914465e+00,
+  -1.01718484209959147968e+00,
+  -1.01689560834715098103e+00,
+  -1.01660893053261758290e+00,
+  -1.01632480514633338764e+00,
+  -1.01604322871221697255e+00,
+  -1.01576419778765747459e+00,
+  -1.01548770896340934122e+00,
+  -1.01521375886348974582e+00,
+  -1.01494234414507622510e+00,
+  -1.01467346149840520475e+00,
+  -1.01440710764667296750e+00,
+  -1.01414327934593484493e+00,
+  -1.01388197338500929412e+00,
+  -1.01362318658537930993e+00,
+  -1.01336691580109827804e+00,
+  -1.01311315791869405167e+00,
+  -1.01286190985707635903e+00,
+  -1.01261316856744310044e+00,
+  -1.01236693103318953213e+00,
+  -1.01212319426981811610e+00,
+  -1.01188195532484837003e+00,
+  -1.01164321127772849351e+00,
+  -1.01140695923974832660e+00,
+  -1.01117319635395319644e+00,
+  -1.01094191979505776402e+00,
+  -1.01071312676936253538e+00,
+  -1.01048681451467037284e+00,
+  -1.01026298030020345031e+00,
+  -1.01004162142652287315e+00,
+  -1.00982273522544785394e+00,
+  -1.00960631905997688662e+00,
+  -1.00939237032420803253e+00,
+  -1.00918088644326364722e+00,
+  -1.00897186487321222081e+00,
+  -1.00876530310099399301e+00,
+  -1.00856119864434612410e+00,
+  -1.00835954905172875407e+00,
+  -1.00816035190225372631e+00,
+  -1.00796360480561153494e+00,
+  -1.00776930540200204689e+00,
+  -1.00757745136206389169e+00,
+  -1.00738804038680607178e+00,
+  -1.00720107020754023885e+00,
+  -1.00701653858581430256e+00,
+  -1.00683444331334515098e+00,
+  -1.00665478221195514585e+00,
+  -1.00647755313350728557e+00,
+  -1.00630275395984258857e+00,
+  -1.00613038260271725477e+00,
+  -1.00596043700374160323e+00,
+  -1.00579291513432012017e+00,
+  -1.00562781499559128484e+00,
+  -1.00546513461836961589e+00,
+  -1.00530487206308771775e+00,
+  -1.00514702541973921512e+00,
+  -1.00499159280782390802e+00,
+  -1.00483857237629159442e+00,
+  -1.00468796230348855758e+00,
+  -1.00453976079710405322e+00,
+  -1.00439396609411923933e+00,
+  -1.00425057646075366335e+00,
+  -1.00410959019241619039e+00,
+  -1.00397100561365482108e+00,
+  -1.00383482107810872996e+00,
+  -1.00370103496845852753e+00,
+  -1.00356964569638096307e+00,
+  -1.00344065170250185126e+00,
+  -1.00331405145635099707e+00,
+  -1.00318984345631734278e+00,
+  -1.00306802622960611338e+00,
+  -1.00294859833219529577e+00,
+  -1.00283155834879411650e+00,
+  -1.00271690489280174141e+00,
+  -1.00260463660626752969e+00,
+  -1.00249475215985106580e+00,
+  -1.00238725025278396785e+00,
+  -1.00228212961283236204e+00,
+  -1.00217938899625980120e+00,
+  -1.00207902718779084950e+00,
+  -1.00198104300057733163e+00,
+  -1.00188543527616213957e+00,
+  -1.00179220288444725817e+00,
+  -1.00170134472366045841e+00,
+  -1.00161285972032310099e+00,
+  -1.00152674682922016025e+00,
+  -1.00144300503336891595e+00,
+  -1.00136163334399053149e+00,
+  -1.00128263080048052203e+00,
+  -1.00120599647038255320e+00,
+  -1.00113172944935979736e+00,
+  -1.00105982886116984254e+00,
+  -1.00099029385763960143e+00,
+  -1.00092312361864022030e+00,
+  -1.00085831735206398641e+00,
+  -1.00079587429380101327e+00,
+  -1.00073579370771770236e+00,
+  -1.00067807488563587093e+00,
+  -1.00062271714731054750e+00,
+  -1.00056971984041309653e+00,
+  -1.00051908234051034619e+00,
+  -1.00047080405104726886e+00,
+  -1.00042488440333054989e+00,
+  -1.00038132285651060194e+00,
+  -1.00034011889756802027e+00,
+  -1.00030127204129692942e+00,
+  -1.00026478183029232660e+00,
+  -1.00023064783493675911e+00,
+  -1.00019886965338722362e+00,
+  -1.00016944691156428604e+00,
+  -1.00014237926314142335e+00,
+  -1.00011766638953458752e+00,
+  -1.00009530799989354577e+00,
+  -1.00007530383109299876e+00,
+  -1.00005765364772525317e+00,
+  -1.00004235724209422642e+00,
+  -1.00002941443420789724e+00,
+  -1.00001882507177430881e+00,
+  -1.00001058903019712787e+00,
+  -1.00000470621257142589e+00,
+  -1.00000117654968212477e+00,
+  -1.00000000000000000000e+00,
+  -1.00000117654968279091e+00,
+  -1.00000470621257275816e+00,
+  -1.00001058903019890423e+00,
+  -1.00001882507177675130e+00,
+  -1.00002941443421100587e+00,
+  -1.00004235724209800118e+00,
+  -1.00005765364772969406e+00,
+  -1.00007530383109810579e+00,
+  -1.00009530799989909688e+00,
+  -1.00011766638954102682e+00,
+  -1.00014237926314830673e+00,
+  -1.00016944691157183556e+00,
+  -1.00019886965339543927e+00,
+  -1.00023064783494564089e+00,
+  -1.00026478183030187452e+00,
+  -1.00030127204130714347e+00,
+  -1.00034011889757890046e+00,
+  -1.00038132285652214826e+00,
+  -1.00042488440334276234e+00,
+  -1.00047080405105992540e+00,
+  -1.00051908234052366886e+00,
+  -1.00056971984042708534e+00,
+  -1.00062271714732520245e+00,
+  -1.00067807488565096996e+00,
+  -1.00073579370773368957e+00,
+  -1.00079587429381744457e+00,
+  -1.00085831735208108384e+00,
+  -1.00092312361865798387e+00,
+  -1.00099029385765803113e+00,
+  -1.00105982886118893838e+00,
+  -1.00113172944937955933e+00,
+  -1.00120599647040298130e+00,
+  -1.00128263080050161626e+00,
+  -1.00136163334401206981e+00,
+  -1.00144300503339112041e+00,
+  -1.00152674682924303085e+00,
+  -1.00161285972034663772e+00,
+  -1.00170134472368466128e+00,
+  -1.00179220288447212717e+00,
+  -1.00188543527618767470e+00,
+  -1.00198104300060331084e+00,
+  -1.00207902718781771689e+00,
+  -1.00217938899628711269e+00,
+  -1.00228212961286056171e+00,
+  -1.00238725025281261161e+00,
+  -1.00249475215988037569e+00,
+  -1.00260463660629750571e+00,
+  -1.00271690489283238357e+00,
+  -1.00283155834882542479e+00,
+  -1.00294859833222727019e+00,
+  -1.00306802622963875393e+00,
+  -1.00318984345635042743e+00,
+  -1.00331405145638474785e+00,
+  -1.00344065170253626817e+00,
+  -1.00356964569641604612e+00,
+  -1.00370103496849427671e+00,
+  -1.00383482107814514528e+00,
+  -1.00397100561369190252e+00,
+  -1.00410959019245371593e+00,
+  -1.00425057646079185503e+00,
+  -1.00439396609415809714e+00,
+  -1.00453976079714379921e+00,
+  -1.00468796230352874765e+00,
+  -1.00483857237633245063e+00,
+  -1.00499159280786565240e+00,
+  -1.00514702541978140360e+00,
+  -1.00530487206313057236e+00,
+  -1.00546513461841313664e+00,
+  -1.00562781499563547172e+00,
+  -1.00579291513436497318e+00,
+  -1.00596043700378712238e+00,
+  -1.00613038260276344005e+00,
+  -1.00630275395988943998e+00,
+  -1.00647755313355480311e+00,
+  -1.00665478221200332953e+00,
+  -1.00683444331339377875e+00,
+  -1.00701653858586359647e+00,
+  -1.00720107020759042094e+00,
+  -1.00738804038685669795e+00,
+  -1.00757745136211518400e+00,
+  -1.00776930540205400533e+00,
+  -1.00796360480566438156e+00,
+  -1.00816035190230723906e+00,
+  -1.00835954905178293295e+00,
+  -1.00856119864440074707e+00,
+  -1.00876530310104950416e+00,
+  -1.00897186487326839810e+00,
+  -1.00918088644332026860e+00,
+  -1.00939237032426532004e+00,
+  -1.00960631906003484026e+00,
+  -1.00982273522550669576e+00,
+  -1.01004162142658238110e+00,
+  -1.01026298030026362440e+00,
+  -1.01048681451473099102e+00,
+  -1.01071312676942404174e+00,
+  -1.01094191979511993651e+00,
+  -1.01117319635401581301e+00,
+  -1.01140695923981183135e+00,
+  -1.01164321127779244236e+00,
+  -1.01188195532491320705e+00,
+  -1.01212319426988361926e+00,
+  -1.01236693103325570142e+00,
+  -1.01261316856750971382e+00,
+  -1.01286190985714386059e+00,
+  -1.01311315791876221937e+00,
+  -1.01336691580116711187e+00,
+  -1.01362318658544880989e+00,
+  -1.01388197338507946021e+00,
+  -1.01414327934600567716e+00,
+  -1.01440710764674446587e+00,
+  -1.01467346149847759129e+00,
+  -1.01494234414514905573e+00,
+  -1.01521375886356324258e+00,
+  -1.01548770896348350412e+00,
+  -1.01576419778773252567e+00,
+  -1.01604322871229268976e+00,
+  -1.01632480514640954894e+00,
+  -1.01660893053269441033e+00,
+  -1.01689560834722869664e+00,
+  -1.01718484209966986143e+00,
+  -1.01747663533335819253e+00,
+  -1.01777099162542428168e+00,
+  -1.01806791458689782637e+00,
+  -1.01836740786281887416e+00,
+  -1.01866947513234751277e+00,
+  -1.01897412010887733480e+00,
+  -1.01928134654014868055e+00,
+  -1.01959115820836299093e+00,
+  -1.01990355893029938095e+00,
+  -1.02021855255743165714e+00,
+  -1.02053614297604600125e+00,
+  -1.02085633410736087434e+00,
+  -1.02117912990764736492e+00,
+  -1.02150453436835153553e+00,
+  -1.02183255151621721346e+00,
+  -1.02216318541341033566e+00,
+  -1.02249644015764418192e+00,
+  -1.02283231988230638443e+00,
+  -1.02317082875658793562e+00,
+  -1.02351197098561041976e+00,
+  -1.02385575081055768543e+00,
+  -1.02420217250880818405e+00,
+  -1.02455124039406686443e+00,
+  -1.02490295881650039789e+00,
+  -1.02525733216287240346e+00,
+  -1.02561436485668000529e+00,
+  -1.02597406135829327667e+00,
+  -1.02633642616509379586e+00,
+  -1.02670146381161542237e+00,
+  -1.02706917886968707165e+00,
+  -1.02743957594857637794e+00,
+  -1.02781265969513335712e+00,
+  -1.02818843479393895457e+00,
+  -1.02856690596744981825e+00,
+  -1.02894807797615017719e+00,
+  -1.02933195561869927914e+00,
+  -1.02971854373208615563e+00,
+  -1.03010784719178039026e+00,
+  -1.03049987091188799404e+00,
+  -1.03089461984530661454e+00,
+  -1.03129209898388429778e+00,
+  -1.03169231335857669585e+00,
+  -1.03209526803960871533e+00,
+  -1.03250096813663527762e+00,
+  -1.03290941879890540989e+00,
+  -1.03332062521542655809e+00,
+  -1.03373459261513112040e+00,
+  -1.03415132626704320273e+00,
+  -1.03457083148044959309e+00,
+  -1.03499311360506895952e+00,
+  -1.03541817803122437880e+00,
+  -1.03584603019001830759e+00,
+  -1.03627667555350644335e+00,
+  -1.03671011963487536001e+00,
+  -1.03714636798862125389e+00,
+  -1.03758542621073002188e+00,
+  -1.03802729993885844983e+00,
+  -1.03847199485251739937e+00,
+  -1.03891951667325765918e+00,
+  -1.03936987116485579641e+00,
+  -1.03982306413350245045e+00,
+  -1.04027910142799240312e+00,
+  -1.04073798893991575909e+00,
+  -1.04119973260385156877e+00,
+  -1.04166433839756211732e+00,
+  -1.04213181234219010030e+00,
+  -1.04260216050245668740e+00,
+  -1.04307538898686136264e+00,
+  -1.04355150394788420698e+00,
+  -1.04403051158218862504e+00,
+  -1.04451241813082740251e+00,
+  -1.04499722987944942965e+00,
+  -1.04548495315850886733e+00,
+  -1.04597559434347497920e+00,
+  -1.04646915985504573854e+00,
+  -1.04696565615936143523e+00,
+  -1.04746508976822072512e+00,
+  -1.04796746723929978806e+00,
+  -1.04847279517637037571e+00,
+  -1.04898108022952341045e+00,
+  -1.04949232909539147407e+00,
+  -1.05000654851737529327e+00,
+  -1.05052374528587044722e+00,
+  -1.05104392623849740573e+00,
+  -1.05156709826033289978e+00,
+  -1.05209326828414351240e+00,
+  -1.05262244329062082393e+00,
+  -1.05315463030861922178e+00,
+  -1.05368983641539437635e+00,
+  -1.05422806873684637985e+00,
+  -1.05476933444776177495e+00,
+  -1.05531364077206024632e+00,
+  -1.05586099498304242239e+00,
+  -1.05641140440363812125e+00,
+  -1.05696487640666036967e+00,
+  -1.05752141841505853392e+00,
+  -1.05808103790217411522e+00,
+  -1.05864374239199987571e+00,
+  -1.05920953945944074093e+00,
+  -1.05977843673057581242e+00,
+  -1.06035044188292371103e+00,
+  -1.06092556264571036273e+00,
+  -1.06150380680013745049e+00,
+  -1.06208518217965552921e+00,
+  -1.06266969667023780666e+00,
+  -1.06325735821065570086e+00,
+  -1.06384817479275906038e+00,
+  -1.06444215446175616258e+00,
+  -1.06503930531649793068e+00,
+  -1.06563963550976392725e+00,
+  -1.06624315324854923581e+00,
+  -1.06684986679435800383e+00,
+  -1.06745978446349387703e+00,
+  -1.06807291462735731713e+00,
+  -1.06868926571274402981e+00,
+  -1.06930884620214405878e+00,
+  -1.06993166463404643096e+00,
+  -1.07055772960324513399e+00,
+  -1.07118704976114620386e+00,
+  -1.07181963381607969765e+00,
+  -1.07245549053361344249e+00,
+  -1.07309462873686900508e+00,
+  -1.07373705730684032567e+00,
+  -1.07438278518271568274e+00,
+  -1.07503182136220232223e+00,
+  -1.07568417490185308516e+00,
+  -1.07633985491739592177e+00,
+  -1.07699887058406806872e+00,
+  -1.07766123113694889391e+00,
+  -1.07832694587130162311e+00,
+  -1.07899602414291106989e+00,
+  -1.07966847536842958100e+00,
+  -1.08034430902572342603e+00,
+  -1.08102353465422296175e+00,
+  -1.08170616185527479480e+00,
+  -1.08239220029249816335e+00,
+  -1.08308165969214376112e+00,
+  -1.08377454984345500399e+00,
+  -1.08447088059903329338e+00,
+  -1.08517066187520594411e+00,
+  -1.08587390365239744305e+00,
+  -1.08658061597550359423e+00,
+  -1.08729080895426810649e+00,
+  -1.08800449276366539841e+00,
+  -1.08872167764428184888e+00,
+  -1.08944237390270415311e+00,
+  -1.09016659191191012113e+00,
+  -1.09089434211166147470e+00,
+  -1.09162563500890086310e+00,
+  -1.09236048117815354175e+00,
+  -1.09309889126192905096e+00,
+  -1.09384087597113111023e+00,
+  -1.09458644608546595833e+00,
+  -1.09533561245385757665e+00,
+  -1.09608838599486535514e+00,
+  -1.09684477769710553297e+00,
+  -1.09760479861967552573e+00,
+  -1.09836845989258335976e+00,
+  -1.09913577271717910477e+00,
+  -1.09990674836659030333e+00,
+  -1.10068139818616295145e+00,
+  -1.10145973359390381141e+00,
+  -1.10224176608092716556e+00,
+  -1.10302750721190712113e+00,
+  -1.10381696862553102534e+00,
+  -1.10461016203495909771e+00,
+  -1.10540709922828717104e+00,
+  -1.10620779206901254099e+00,
+  -1.10701225249650470062e+00,
+  -1.10782049252648073789e+00,
+  -1.10863252425148317570e+00,
+  -1.10944835984136402907e+00,
+  -1.11026801154377019465e+00,
+  -1.11109149168463683388e+00,
+  -1.11191881266868031197e+00,
+  -1.11274998697989979668e+00,
+  -1.11358502718208085547e+00,
+  -1.11442394591930327152e+00,
+  -1.11526675591645507701e+00,
+  -1.11611346997974814066e+00,
+  -1.11696410099724174891e+00,
+  -1.11781866193936729736e+00,
+  -1.11867716585946030960e+00,
+  -1.11953962589429423247e+00,
+  -1.12040605526462289099e+00,
+  -1.12127646727572294338e+00,
+  -1.12215087531794521780e+00,
+  -1.12302929286726738134e+00,
+  -1.12391173348585526881e+00,
+  -1.12479821082262443355e+00,
+  -1.12568873861381080204e+00,
+  -1.12658333068354377104e+00,
+  -1.12748200094442596608e+00,
+  -1.12838476339811655258e+00,
+  -1.12929163213592009818e+00,
+  -1.13020262133938276250e+00,
+  -1.13111774528088915304e+00,
+  -1.13203701832426961715e+00,
+  -1.13296045492540842226e+00,
+  -1.13388806963286037366e+00,
+  -1.13481987708847187335e+00,
+  -1.13575589202800641964e+00,
+  -1.13669612928177810041e+00,
+  -1.13764060377528708479e+00,
+  -1.13858933052986444068e+00,
+  -1.13954232466332072704e+00,
+  -1.14049960139060035935e+00,
+  -1.14146117602444152617e+00,
+  -1.14242706397604432134e+00,
+  -1.14339728075574065258e+00,
+  -1.14437184197367503025e+00,
+  -1.14535076334048668834e+00,
+  -1.14633406066800080936e+00,
+  -1.14732174986992574439e+00,
+  -1.14831384696255511813e+00,
+  -1.14931036806547703932e+00,
+  -1.15031132940228908446e+00,
+  -1.15131674730132238516e+00,
+  -1.15232663819636682589e+00,
+  -1.15334101862740801003e+00,
+  -1.15435990524136866675e+00,
+  -1.15538331479285627523e+00,
+  -1.15641126414491846042e+00,
+  -1.15744377026980482803e+00,
+  -1.15848085024973523893e+00,
+  -1.15952252127767652112e+00,
+  -1.16056880065812384473e+00,
+  -1.16161970580789120078e+00,
+  -1.16267525425690854135e+00,
+  -1.16373546364902602512e+00,
+  -1.16480035174282492427e+00,
+  -1.16586993641243696906e+00,
+  -1.16694423564837213014e+00,
+  -1.16802326755835017558e+00,
+  -1.16910705036814355218e+00,
+  -1.17019560242242737225e+00,
+  -1.17128894218563561758e+00,
+  -1.17238708824282644727e+00,
+  -1.17349005930055461100e+00,
+  -1.17459787418775452039e+00,
+  -1.17571055185662709519e+00,
+  -1.17682811138353726754e+00,
+  -1.17795057196992125625e+00,
+  -1.17907795294319961421e+00,
+  -1.18021027375769915757e+00,
+  -1.18134755399558577516e+00,
+  -1.18248981336780145668e+00,
+  -1.18363707171501597593e+00,
+  -1.18478934900858168255e+00,
+  -1.18594666535150072839e+00,
+  -1.18710904097940006530e+00,
+  -1.18827649626151621298e+00,
+  -1.18944905170168824249e+00,
+  -1.19062672793936097371e+00,
+  -1.19180954575059816491e+00,
+  -1.19299752604910258569e+00,
+  -1.19419068988724874636e+00,
+  -1.19538905845712339904e+00,
+  -1.19659265309157780699e+00,
+  -1.19780149526528645332e+00,
+  -1.19901560659581973844e+00,
+  -1.20023500884472622552e+00,
+  -1.20145972391862065898e+00,
+  -1.20268977387028797033e+00,
+  -1.20392518089979549956e+00,
+  -1.20516596735561565268e+00,
+  -1.20641215573575855124e+00,
+  -1.20766376868891778251e+00,
+  -1.20892082901562458730e+00,
+  -1.21018335966941603665e+00,
+  -1.21145138375801031394e+00,
+  -1.21272492454449687393e+00,
+  -1.21400400544853703799e+00,
+  -1.21528865004757524737e+00,
+  -1.21657888207806341718e+00,
+  -1.21787472543669506031e+00,
+  -1.21917620418165562057e+00,
+  -1.22048334253387791293e+00,
+  -1.22179616487831710359e+00,
+  -1.22311469576523301761e+00,
+  -1.22443895991148776758e+00,
+  -1.22576898220185426247e+00,
+  -1.22710478769033892732e+00,
+  -1.22844640160151485908e+00,
+  -1.22979384933187341211e+00,
+  -1.23114715645118155685e+00,
+  -1.23250634870385833430e+00,
+  -1.23387145201036241282e+00,
+  -1.23524249246859540996e+00,
+  -1.23661949635531454028e+00,
+  -1.23800249012756480305e+00,
+  -1.23939150042412249419e+00,
+  -1.24078655406695115282e+00,
+  -1.24218767806267615939e+00,
+  -1.24359489960407110232e+00,
+  -1.24500824607155968771e+00,
+  -1.24642774503473274805e+00,
+  -1.24785342425387990595e+00,
+  -1.24928531168153855724e+00,
+  -1.25072343546405440051e+00,
+  -1.25216782394316128446e+00,
+  -1.25361850565757548814e+00,
+  -1.25507550934460598846e+00,
+  -1.25653886394178115893e+00,
+  -1.25800859858849212181e+00,
+  -1.25948474262765186538e+00,
+  -1.26096732560737279094e+00,
+  -1.26245637728265913680e+00,
+  -1.26395192761711783191e+00,
+  -1.26545400678468666911e+00,
+  -1.26696264517138068584e+00,
+  -1.26847787337705475430e+00,
+  -1.26999972221718504528e+00,
+  -1.27152822272467069808e+00,
+  -1.27306340615164925723e+00,
+  -1.27460530397133520175e+00,
+  -1.27615394787987534997e+00,
+  -1.27770936979822402613e+00,
+  -1.27927160187403710090e+00,
+  -1.28084067648358534974e+00,
+  -1.28241662623368957163e+00,
+  -1.28399948396367280523e+00,
+  -1.28558928274733452746e+00,
+  -1.28718605589494572428e+00,
+  -1.28878983695526416753e+00,
+  -1.29040065971757011987e+00,
+  -1.29201855821372446620e+00,
+  -1.29364356672024771733e+00,
+  -1.29527571976042232826e+00,
+  -1.29691505210641300216e+00,
+  -1.29856159878141430575e+00,
+  -1.30021539506181782464e+00,
+  -1.30187647647940329954e+00,
+  -1.30354487882355329909e+00,
+  -1.30522063814348898703e+00,
+  -1.30690379075053453306e+00,
+  -1.30859437322039884322e+00,
+  -1.31029242239548793236e+00,
+  -1.31199797538723794688e+00,
+  -1.31371106957847461061e+00,
+  -1.31543174262579842804e+00,
+  -1.31716003246199386822e+00,
+  -1.31889597729846541618e+00,
+  -1.32063961562770137981e+00,
+  -1.32239098622575990127e+00,
+  -1.32415012815478716490e+00,
+  -1.32591708076555758744e+00,
+  -1.32769188370004620481e+00,
+  -1.32947457689402703807e+00,
+  -1.33126520057969721655e+00,
+  -1.33306379528833551795e+00,
+  -1.33487040185298311279e+00,
+  -1.33668506141115894792e+00,
+  -1.33850781540760221944e+00,
+  -1.34033870559704570979e+00,
+  -1.34217777404701932298e+00,
+  -1.34402506314068381776e+00,
+  -1.34588061557969984605e+00,
+  -1.34774447438712052794e+00,
+  -1.34961668291032399480e+00,
+  -1.35149728482397479823e+00,
+  -1.35338632413301906965e+00,
+  -1.35528384517571121037e+00,
+  -1.35718989262667788509e+00,
+  -1.35910451150001243548e+00,
+  -1.36102774715240726344e+00,
+  -1.36295964528631730062e+00,
+  -1.36490025195316366791e+00,
+  -1.36684961355657019766e+00,
+  -1.36880777685563614909e+00,
+  -1.37077478896824911381e+00,
+  -1.37275069737443122797e+00,
+  -1.37473554991972823913e+00,
+  -1.37672939481862988131e+00,
+  -1.37873228065803687947e+00,
+  -1.38074425640076259292e+00,
+  -1.38276537138907662516e+00,
+  -1.38479567534828706954e+00,
+  -1.38683521839036605350e+00,
+  -1.38888405101761724936e+00,
+  -1.39094222412638113262e+00,
+  -1.39300978901078797989e+00,
+  -1.39508679736655216708e+00,
+  -1.39717330129480976630e+00,
+  -1.39926935330600166196e+00,
+  -1.40137500632380129773e+00,
+  -1.40349031368908705453e+00,
+  -1.40561532916396525472e+00,
+  -1.40775010693583224608e+00,
+  -1.40989470162149199695e+00,
+  -1.41204916827131721213e+00,
+  -1.41421356237346085294e+00,
+  -1.41638793985811739518e+00,
+  -1.41857235710183271493e+00,
+  -1.42076687093186904143e+00,
+  -1.42297153863061431878e+00,
+  -1.42518641794005196388e+00,
+  -1.42741156706627725370e+00,
+  -1.42964704468407211024e+00,
+  -1.43189290994153028969e+00,
+  -1.43414922246474252354e+00,
+  -1.43641604236253250804e+00,
+  -1.43869343023125573211e+00,
+  -1.44098144715964937568e+00,
+  -1.44328015473374482447e+00,
+  -1.44558961504184013691e+00,
+  -1.44790989067952868830e+00,
+  -1.45024104475479376219e+00,
+  -1.45258314089315865303e+00,
+  -1.45493624324290871108e+00,
+  -1.45730041648036445778e+00,
+  -1.45967572581523130637e+00,
+  -1.46206223699600723620e+00,
+  -1.46446001631545930088e+00,
+  -1.46686913061616830412e+00,
+  -1.46928964729613786844e+00,
+  -1.47172163431447988735e+00,
+  -1.47416516019716037356e+00,
+  -1.47662029404282568734e+00,
+  -1.47908710552869626653e+00,
+  -1.48156566491653429729e+00,
+  -1.48405604305868665804e+00,
+  -1.48655831140420247038e+00,
+  -1.48907254200502681130e+00,
+  -1.49159880752227613776e+00,
+  -1.49413718123258432158e+00,
+  -1.49668773703453705792e+00,
+  -1.49925054945518310134e+00,
+  -1.50182569365662832439e+00,
+  -1.50441324544271415320e+00,
+  -1.50701328126577882571e+00,
+  -1.50962587823351079841e+00,
+  -1.51225111411587831434e+00,
+  -1.51488906735215955734e+00,
+  -1.51753981705805496283e+00,
+  -1.52020344303289300925e+00,
+  -1.52288002576693148882e+00,
+  -1.52556964644874604176e+00,
+  -1.52827238697272438372e+00,
+  -1.53098832994664557638e+00,
+  -1.53371755869936676753e+00,
+  -1.53646015728860652061e+00,
+  -1.53921621050882850845e+00,
+  -1.54198580389923023404e+00,
+  -1.54476902375183566818e+00,
+  -1.54756595711969135998e+00,
+  -1.55037669182517645616e+00,
+  -1.55320131646841441686e+00,
+  -1.55603992043579952842e+00,
+  -1.55889259390864332033e+00,
+  -1.56175942787191712746e+00,
+  -1.56464051412313009948e+00,
+  -1.56753594528131490193e+00,
+  -1.57044581479613598596e+00,
+  -1.57337021695712042657e+00,
+  -1.57630924690300977531e+00,
+  -1.57926300063124047668e+00,
+  -1.58223157500755085003e+00,
+  -1.58521506777571730140e+00,
+  -1.58821357756742265188e+00,
+  -1.59122720391225702663e+00,
+  -1.59425604724785663358e+00,
+  -1.59730020893017976569e+00,
+  -1.60035979124391936068e+00,
+  -1.60343489741307054786e+00,
+  -1.60652563161162142968e+00,
+  -1.60963209897441150709e+00,
+  -1.61275440560812821644e+00,
+  -1.61589265860245956397e+00,
+  -1.61904696604139930471e+00,
+  -1.62221743701470777488e+00,
+  -1.62540418162953659298e+00,
+  -1.62860731102220857025e+00,
+  -1.63182693737016881741e+00,
+  -1.63506317390409794399e+00,
+  -1.63831613492019756428e+00,
+  -1.64158593579264855400e+00,
+  -1.64487269298624361191e+00,
+  -1.64817652406919856745e+00,
+  -1.65149754772615042775e+00,
+  -1.65483588377132706526e+00,
+  -1.65819165316191674542e+00,
+  -1.66156497801162261752e+00,
+  -1.66495598160441349300e+00,
+  -1.66836478840846780258e+00,
+  -1.67179152409032116822e+00,
+  -1.67523631552921692389e+00,
+  -1.67869929083166158357e+00,
+  -1.68218057934619502625e+00,
+  -1.68568031167837051321e+00,
+  -1.68919861970595386325e+00,
+  -1.69273563659434600481e+00,
+  -1.69629149681222823887e+00,
+  -1.69986633614743576359e+00,
+  -1.70346029172307300570e+00,
+  -1.70707350201384810973e+00,
+  -1.71070610686266522116e+00,
+  -1.71435824749745702178e+00,
+  -1.71803006654826173616e+00,
+  -1.72172170806456037440e+00,
+  -1.72543331753286821595e+00,
+  -1.72916504189459141472e+00,
+  -1.73291702956414761516e+00,
+  -1.73668943044736256986e+00,
+  -1.74048239596013920583e+00,
+  -1.74429607904741379443e+00,
+  -1.74813063420239056533e+00,
+  -1.75198621748607474835e+00,
+  -1.75586298654710648570e+00,
+  -1.75976110064187740711e+00,
+  -1.76368072065497805134e+00,
+  -1.76762200911994415975e+00,
+  -1.77158513024032426841e+00,
+  -1.77557024991107592626e+00,
+  -1.77957753574028365584e+00,
+  -1.78360715707122152729e+00,
+  -1.78765928500475146379e+00,
+  -1.79173409242207326564e+00,
+  -1.79583175400782835140e+00,
+  -1.79995244627356343337e+00,
+  -1.80409634758156500745e+00,
+  -1.80826363816906288129e+00,
+  -1.81245450017281828359e+00,
+  -1.81666911765411009938e+00,
+  -1.82090767662409014349e+00,
+  -1.82517036506956875641e+00,
+  -1.82945737297919786002e+00,
+  -1.83376889237007212330e+00,
+  -1.83810511731475911823e+00,
+  -1.84246624396876135243e+00,
+  -1.84685247059841839423e+00,
+  -1.85126399760926418914e+00,
+  -1.85570102757483779143e+00,
+  -1.86016376526596305396e+00,
+  -1.86465241768050815629e+00,
+  -1.86916719407362252880e+00,
+  -1.87370830598847715187e+00,
+  -1.87827596728749912636e+00,
+  -1.88287039418413693070e+00,
+  -1.88749180527512194772e+00,
+  -1.89214042157328909965e+00,
+  -1.89681646654092905813e+00,
+  -1.90152016612369645365e+00,
+  -1.90625174878508585330e+00,
+  -1.91101144554148061339e+00,
+  -1.91579948999779192675e+00,
+  -1.92061611838369405980e+00,
+  -1.92546156959047576329e+00,
+  -1.93033608520850652468e+00,
+  -1.93523990956534630570e+00,
+  -1.94017328976449632272e+00,
+  -1.94513647572481462866e+00,
+  -1.95012972022060160349e+00,
+  -1.95515327892238643948e+00,
+  -1.96020741043838553352e+00,
+  -1.96529237635670805950e+00,
+  -1.97040844128827075110e+00,
+  -1.97555587291046652609e+00,
+  -1.98073494201158939454e+00,
+  -1.98594592253603252630e+00,
+  -1.99118909163028079412e+00,
+  -1.99646472968970822848e+00,
+  -2.00177312040619792555e+00,
+  -2.00711455081660661293e+00,
+  -2.01248931135208009024e+00,
+  -2.01789769588825196323e+00,
+  -2.02334000179632766958e+00,
+  -2.02881652999509798363e+00,
+  -2.03432758500385313383e+00,
+  -2.03987347499627791336e+00,
+  -2.04545451185530646754e+00,
+  -2.05107101122896295919e+00,
+  -2.05672329258722497158e+00,
+  -2.06241167927991186914e+00,
+  -2.06813649859563497557e+00,
+  -2.07389808182182333596e+00,
+  -2.07969676430585126425e+00,
+  -2.08553288551729210099e+00,
+  -2.09140678911132038564e+00,
+  -2.09731882299328731278e+00,
+  -2.10326933938449922579e+00,
+  -2.10925869488921380324e+00,
+  -2.11528725056290900497e+00,
+  -2.12135537198179724427e+00,
+  -2.12746342931368070950e+00,
+  -2.13361179739012651879e+00,
+  -2.13980085578001277824e+00,
+  -2.14603098886446908011e+00,
+  -2.15230258591324563611e+00,
+  -2.15861604116254301999e+00,
+  -2.16497175389433138548e+00,
+  -2.17137012851719690687e+00,
+  -2.17781157464874652874e+00,
+  -2.18429650719961054861e+00,
+  -2.19082534645907367477e+00,
+  -2.19739851818237408310e+00,
+  -2.20401645367970733247e+00,
+  -2.21067958990699331423e+00,
+  -2.21738836955838936049e+00,
+  -2.22414324116066985937e+00,
+  -2.23094465916945461359e+00,
+  -2.23779308406735255588e+00,
+  -2.24468898246406167729e+00,
+  -2.25163282719847401836e+00,
+  -2.25862509744282480284e+00,
+  -2.26566627880894166935e+00,
+  -2.27275686345664151844e+00,
+  -2.27989735020432027213e+00,
+  -2.28708824464179638625e+00,
+  -2.29433005924545696530e+00,
+  -2.30162331349575755013e+00,
+  -2.30896853399713641863e+00,
+  -2.31636625460042377966e+00,
+  -2.32381701652773520195e+00,
+  -2.33132136850000648565e+00,
+  -2.33887986686716020657e+00,
+  -2.34649307574100163265e+00,
+  -2.35416156713089996799e+00,
+  -2.36188592108232642275e+00,
+  -2.36966672581831883093e+00,
+  -2.37750457788394964354e+00,
+  -2.38540008229386124583e+00,
+  -2.39335385268295608441e+00,
+  -2.40136651146031487869e+00,
+  -2.40943868996642507341e+00,
+  -2.41757102863379813584e+00,
+  -2.42576417715108716422e+00,
+  -2.43401879463073012033e+00,
+  -2.44233554978029276938e+00,
+  -2.45071512107754596599e+00,
+  -2.45915819694938653228e+00,
+  -2.46766547595471630316e+00,
+  -2.47623766697136149517e+00,
+  -2.48487548938714963853e+00,
+  -2.49357967329524710109e+00,
+  -2.50235095969387222326e+00,
+  -2.51119010069049419798e+00,
+  -2.52009785971063671184e+00,
+  -2.52907501171141513296e+00,
+  -2.53812234339992048859e+00,
+  -2.54724065345658168269e+00,
+  -2.55643075276367515158e+00,
+  -2.56569346463902503430e+00,
+  -2.57502962507515853474e+00,
+  -2.58444008298396887824e+00,
+  -2.59392570044707637678e+00,
+  -2.60348735297203726091e+00,
+  -2.61312592975454771604e+00,
+  -2.62284233394683097274e+00,
+  -2.63263748293235266829e+00,
+  -2.64251230860705854653e+00,
+  -2.65246775766730458201e+00,
+  -2.66250479190467137514e+00,
+  -2.67262438850785510880e+00,
+  -2.68282754037183091000e+00,
+  -2.69311525641449112101e+00,
+  -2.70348856190100672592e+00,
+  -2.71394849877603538957e+00,
+  -2.72449612600413271224e+00,
+  -2.73513251991849637434e+00,
+  -2.74585877457833449355e+00,
+  -2.75667600213508778850e+00,
+  -2.76758533320777422304e+00,
+  -2.77858791726771769959e+00,
+  -2.78968492303292858736e+00,
+  -2.80087753887243584572e+00,
+  -2.81216697322084874244e+00,
+  -2.82355445500346169396e+00,
+  -2.83504123407221131359e+00,
+  -2.84662858165281251743e+00,
+  -2.85831779080340275812e+00,
+  -2.87011017688508074386e+00,
+  -2.88200707804459943517e+00,
+  -2.89400985570971913674e+00,
+  -2.90611989509750623384e+00,
+  -2.91833860573601233668e+00,
+  -2.93066742199974594740e+00,
+  -2.94310780365935853453e+00,
+  -2.95566123644598821585e+00,
+  -2.96832923263072068210e+00,
+  -2.98111333161964209282e+00,
+  -2.99401510056497155432e+00,
+  -3.00703613499279098775e+00,
+  -3.02017805944788708672e+00,
+  -3.03344252815626003184e+00,
+  -3.04683122570590159128e+00,
+  -3.06034586774631867101e+00,
+  -3.07398820170756748027e+00,
+  -3.08776000753931301190e+00,
+  -3.10166309847062171556e+00,
+  -3.11569932179115083315e+00,
+  -3.12987055965445160055e+00,
+  -3.14417872990411462197e+00,
+  -3.15862578692351592125e+00,
+  -3.17321372250996391884e+00,
+  -3.18794456677405779743e+00,
+  -3.20282038906511257181e+00,
+  -3.21784329892354348246e+00,
+  -3.23301544706112498062e+00,
+  -3.24833902637006399772e+00,
+  -3.26381627296195508947e+00,
+  -3.27944946723749364281e+00,
+  -3.29524093498822079340e+00,
+  -3.31119304853127083277e+00,
+  -3.32730822787834146226e+00,
+  -3.34358894194008726686e+00,
+  -3.36003770976719851049e+00,
+  -3.37665710182946732232e+00,
+  -3.39344974133421350970e+00,
+  -3.41041830558548619834e+00,
+  -3.42756552738551700799e+00,
+  -3.44489419647997552332e+00,
+  -3.46240716104861601110e+00,
+  -3.48010732924300780766e+00,
+  -3.49799767077306400509e+00,
+  -3.51608121854426114439e+00,
+  -3.53436107034728141940e+00,
+  -3.55284039060226808360e+00,
+  -3.57152241215960009058e+00,
+  -3.59041043815938998307e+00,
+  -3.60950784395195967136e+00,
+  -3.62881807908162024034e+00,
+  -3.64834466933621870410e+00,
+  -3.66809121886499900356e+00,
+  -3.68806141236745421708e+00,
+  -3.70825901735595886421e+00,
+  -3.72868788649510518596e+00,
+  -3.74935196002078541255e+00,
+  -3.77025526824221302036e+00,
+  -3.79140193413021364677e+00,
+  -3.81279617599534148553e+00,
+  -3.83444231025929260781e+00,
+  -3.85634475432369239201e+00,
+  -3.87850802954006335099e+00,
+  -3.90093676428525348854e+00,
+  -3.92363569714669946364e+00,
+  -3.94660968022213598516e+00,
+  -3.96986368253856003463e+00,
+  -3.99340279359553296246e+00,
+  -4.01723222703810911582e+00,
+  -4.04135732446496831471e+00,
+  -4.06578355937758395555e+00,
+  -4.09051654127657560167e+00,
+  -4.11556201991164982701e+00,
+  -4.14092588969199404403e+00,
+  -4.16661419426400758681e+00,
+  -4.19263313126412651144e+00,
+  -4.21898905725437067815e+00,
+  -4.24568849284896199237e+00,
+  -4.27273812804068242599e+00,
+  -4.30014482773610851041e+00,
+  -4.32791563750933772070e+00,
+  -4.35605778958434708414e+00,
+  -4.38457870905664037764e+00,
+  -4.41348602036543358196e+00,
+  -4.44278755402822600473e+00,
+  -4.47249135365025374256e+00,
+  -4.50260568322200249725e+00,
+  -4.53313903471866286310e+00,
+  -4.56410013601632869040e+00,
+  -4.59549795914015746234e+00,
+  -4.62734172886122863133e+00,
+  -4.65964093165912984773e+00,
+  -4.69240532506868124329e+00,
+  -4.72564494743010499178e+00,
+  -4.75937012806312598201e+00,
+  -4.79359149788664140601e+00,
+  -4.82832000050692045079e+00,
+  -4.86356690379860001627e+00,
+  -4.89934381200423541003e+00,
+  -4.93566267837970507060e+00,
+  -4.97253581841439018518e+00,
+  -5.00997592365687172133e+00,
+  -5.04799607617871171072e+00,
+  -5.08660976371107764749e+00,
+  -5.12583089549066972523e+00,
+  -5.16567381885450860324e+00,
+  -5.20615333662483070754e+00,
+  -5.24728472532848311261e+00,
+  -5.28908375429790478250e+00,
+  -5.33156670570385582408e+00,
+  -5.37475039557337552765e+00,
+  -5.41865219584994139979e+00,
+  -5.46329005755663921207e+00,
+  -5.50868253512723171639e+00,
+  -5.55484881197438884470e+00,
+  -5.60180872736911616983e+00,
+  -5.64958280471050056093e+00,
+  -5.69819228127036403464e+00,
+  -5.74765913950357720807e+00,
+  -5.79800614002056580176e+00,
+  -5.84925685632651148893e+00,
+  -5.90143571143818235214e+00,
+  -5.95456801649808920018e+00,
+  -6.00868001151417807648e+00,
+  -6.06379890836285184719e+00,
+  -6.11995293620337044160e+00,
+  -6.17717138946287480650e+00,
+  -6.23548467856341925852e+00,
+  -6.29492438357555705863e+00,
+  -6.35552331099738498921e+00,
+  -6.41731555387352159414e+00,
+  -6.48033655548548281899e+00,
+  -6.54462317686366290559e+00,
+  -6.61021376839056973296e+00,
+  -6.67714824578832377711e+00,
+  -6.74546817080620897400e+00,
+  -6.81521683695124469438e+00,
+  -6.88643936063331629782e+00,
+  -6.95918277812807417604e+00,
+  -7.03349614879552298419e+00,
+  -7.10943066503023146652e+00,
+  -7.18703976946103217927e+00,
+  -7.26637927996400989628e+00,
+  -7.34750752310335997208e+00,
+  -7.43048547667046310750e+00,
+  -7.51537692205325313921e+00,
+  -7.60224860723595252665e+00,
+  -7.69117042130492567509e+00,
+  -7.78221558141872904457e+00,
+  -7.87546083329457413669e+00,
+  -7.97098666636428365706e+00,
+  -8.06887754486776742624e+00,
+  -8.16922215627851855402e+00,
+  -8.27211367859686674819e+00,
+  -8.37765006820424851242e+00,
+  -8.48593437014767104642e+00,
+  -8.59707505292034745992e+00,
+  -8.71118637002475004749e+00,
+  -8.82838875085160701417e+00,
+  -8.94880922368592912619e+00,
+  -9.07258187396355353371e+00,
+  -9.19984834125349770773e+00,
+  -9.33075835883919424418e+00,
+  -9.46547034021906874557e+00,
+  -9.60415201735792933846e+00,
+  -9.74698113609482419406e+00,
+  -9.89414621476985445270e+00,
+  -1.00458473728780930401e+01,
+  -1.02022972374098088721e+01,
+  -1.03637219355087903949e+01,
+  -1.05303621831944074216e+01,
+  -1.07024744811710501580e+01,
+  -1.08803324302185551176e+01,
+  -1.10642281803511153271e+01,
+  -1.12544740298892005370e+01,
+  -1.14514041928547118943e+01,
+  -1.16553767557304954749e+01,
+  -1.18667758476833391512e+01,
+  -1.20860140519240655266e+01,
+  -1.23135350900511717498e+01,
+  -1.25498168161265564180e+01,
+  -1.27953745629954465102e+01,
+  -1.30507648901647179684e+01,
+  -1.33165897906050858523e+01,
+  -1.35935014234035893566e+01,
+  -1.38822074505844401671e+01,
+  -1.41834770700369894314e+01,
+  -1.44981478528340410605e+01,
+  -1.48271335129117911578e+01,
+  -1.51714327608911272449e+01,
+  -1.55321394227303581914e+01,
+  -1.59104540391574449387e+01,
+  -1.63076972050148718552e+01,
+  -1.67253249608136833615e+01,
+  -1.71649466145317326493e+01,
+  -1.76283454534335106700e+01,
+  -1.81175029078599365562e+01,
+  -1.86346268573821234327e+01,
+  -1.91821849321587478698e+01,
+  -1.97629438690856673588e+01,
+  -2.03800162472235939504e+01,
+  -2.10369162687924031729e+01,
+  -2.17376266963643196561e+01,
+  -2.24866796391315588721e+01,
+  -2.32892546505170159321e+01,
+  -2.41512986252534957998e+01,
+  -2.50796733650223444556e+01,
+  -2.60823385598398616025e+01,
+  -2.71685805147960053318e+01,
+  -2.83493005446350068155e+01,
+  -2.96373820214040861742e+01,
+  -3.10481622928588940624e+01,
+  -3.26000461763906059787e+01,
+  -3.43153131878774075858e+01,
+  -3.62211938468197232055e+01,
+  -3.83513258538762258354e+01,
+  -4.07477563349757545552e+01,
+  -4.34637449830740507650e+01,
+  -4.65677685463777848440e+01,
+  -5.01493735419025625788e+01,
+  -5.43279553258075722511e+01,
+  -5.92663257475631581883e+01,
+  -6.51924213965887133782e+01,
+  -7.24354840133494946031e+01,
+  -8.14893762087581450260e+01,
+  -9.31301678002120070232e+01,
+  -1.08651308483671598992e+02,
+  -1.30381007712244723962e+02,
+  -1.62975684392686076762e+02,
+  -2.17300315975070475361e+02,
+  -3.25949834812665528716e+02,
+  -6.51898902699899281288e+02,
+  1.00000000000000000000e+08,
+  6.51898902435840000180e+02,
+  3.25949834746745182201e+02,
+  2.17300315945772581472e+02,
+  1.62975684376206032766e+02,
+  1.30381007701697541279e+02,
+  1.08651308476347210785e+02,
+  9.31301677948308395116e+01,
+  8.14893762046382050812e+01,
+  7.24354840100942567460e+01,
+  6.51924213939520029726e+01,
+  5.92663257453840657263e+01,
+  5.43279553239765533590e+01,
+  5.01493735403401856843e+01,
+  4.65677685450306455550e+01,
+  4.34637449819005610152e+01,
+  4.07477563339443662471e+01,
+  3.83513258529639387007e+01,
+  3.62211938460059954537e+01,
+  3.43153131871470833403e+01,
+  3.26000461757315065370e+01,
+  3.10481622922610753790e+01,
+  2.96373820208593912184e+01,
+  2.83493005441366534569e+01,
+  2.71685805143383234395e+01,
+  2.60823385594180727765e+01,
+  2.50796733646323843914e+01,
+  2.41512986248918970489e+01,
+  2.32892546501803074932e+01,
+  2.24866796388176766186e+01,
+  2.17376266960710218257e+01,
+  2.10369162685177286676e+01,
+  2.03800162469661927389e+01,
+  1.97629438688436387395e+01,
+  1.91821849319307524695e+01,
+  1.86346268571669746450e+01,
+  1.81175029076565827779e+01,
+  1.76283454532410068794e+01,
+  1.71649466143492333003e+01,
+  1.67253249606404281735e+01,
+  1.63076972048501751544e+01,
+  1.59104540390006885531e+01,
+  1.55321394225809843448e+01,
+  1.51714327607484200655e+01,
+  1.48271335127754984029e+01,
+  1.44981478527037452864e+01,
+  1.41834770699123016158e+01,
+  1.38822074504651791216e+01,
+  1.35935014232892470432e+01,
+  1.33165897904953691722e+01,
+  1.30507648900593480334e+01,
+  1.27953745628941746304e+01,
+  1.25498168160291463380e+01,
+  1.23135350899574049777e+01,
+  1.20860140518337431104e+01,
+  1.18667758475962745734e+01,
+  1.16553767556465182054e+01,
+  1.14514041927736585080e+01,
+  1.12544740298108099097e+01,
+  1.10642281802753625897e+01,
+  1.08803324301453088196e+01,
+  1.07024744811002907596e+01,
+  1.05303621831259146546e+01,
+  1.03637219354424594542e+01,
+  1.02022972373455367290e+01,
+  1.00458473728157873239e+01,
+  9.89414621470942456938e+00,
+  9.74698113603618843115e+00,
+  9.60415201730100953625e+00,
+  9.46547034016378852073e+00,
+  9.33075835878548431879e+00,
+  9.19984834120129235657e+00,
+  9.07258187391271953004e+00,
+  8.94880922363648245721e+00,
+  8.82838875080349083646e+00,
+  8.71118636997791107035e+00,
+  8.59707505287479989420e+00,
+  8.48593437010330120529e+00,
+  8.37765006816101198694e+00,
+  8.27211367855472268218e+00,
+  8.16922215623742253854e+00,
+  8.06887754482768038145e+00,
+  7.97098666632517272035e+00,
+  7.87546083325640200457e+00,
+  7.78221558138146374262e+00,
+  7.69117042126853434070e+00,
+  7.60224860720040407358e+00,
+  7.51537692201847029594e+00,
+  7.43048547663646896666e+00,
+  7.34750752307012700015e+00,
+  7.26637927993151411243e+00,
+  7.18703976942929312344e+00,
+  7.10943066499918341350e+00,
+  7.03349614876513928863e+00,
+  6.95918277809833796255e+00,
+  6.88643936060420358558e+00,
+  6.81521683692273771982e+00,
+  6.74546817077828908538e+00,
+  6.67714824576097232267e+00,
+  6.61021376836377072550e+00,
+  6.54462317683739858154e+00,
+  6.48033655545973896750e+00,
+  6.41731555384824581267e+00,
+  6.35552331097259948223e+00,
+  6.29492438355124761529e+00,
+  6.23548467853957255613e+00,
+  6.17717138943951127317e+00,
+  6.11995293618044389206e+00,
+  6.06379890834034984692e+00,
+  6.00868001149208907918e+00,
+  5.95456801647640165953e+00,
+  5.90143571141688649817e+00,
+  5.84925685630559488715e+00,
+  5.79800614000001957038e+00,
+  5.74765913948339157713e+00,
+  5.69819228125053101053e+00,
+  5.64958280469098106380e+00,
+  5.60180872734993062778e+00,
+  5.55484881195552926414e+00,
+  5.50868253510869010370e+00,
+  5.46329005753843244264e+00,
+  5.41865219583203572284e+00,
+  5.37475039555576472594e+00,
+  5.33156670568653101583e+00,
+  5.28908375428085975045e+00,
+  5.24728472531171163951e+00,
+  5.20615333660832657614e+00,
+  5.16567381883826470812e+00,
+  5.12583089547468073732e+00,
+  5.08660976369533646135e+00,
+  5.04799607616321388548e+00,
+  5.00997592364158972345e+00,
+  4.97253581839934000186e+00,
+  4.93566267836488226095e+00,
+  4.89934381198963553317e+00,
+  4.86356690378423639487e+00,
+  4.82832000049276999221e+00,
+  4.79359149787269789300e+00,
+  4.75937012804938497368e+00,
+  4.72564494741656293542e+00,
+  4.69240532505533369800e+00,
+  4.65964093164597237262e+00,
+  4.62734172884825678551e+00,
+  4.59549795912736769310e+00,
+  4.56410013600371744502e+00,
+  4.53313903470622658887e+00,
+  4.50260568320971987788e+00,
+  4.47249135363813987709e+00,
+  4.44278755401627645227e+00,
+  4.41348602035364478979e+00,
+  4.38457870904502655662e+00,
+  4.35605778957288869435e+00,
+  4.32791563749803032124e+00,
+  4.30014482772494943674e+00,
+  4.27273812802966990176e+00,
+  4.24568849283809246486e+00,
+  4.21898905724364148284e+00,
+  4.19263313125353498378e+00,
+  4.16661419425355106227e+00,
+  4.14092588968166896990e+00,
+  4.11556201990145531511e+00,
+  4.09051654126649477661e+00,
+  4.06578355936762836365e+00,
+  4.04135732445513529143e+00,
+  4.01723222702839688480e+00,
+  3.99340279358595351411e+00,
+  3.96986368252909693766e+00,
+  3.94660968021278701912e+00,
+  3.92363569713746329626e+00,
+  3.90093676427612701119e+00,
+  3.87850802953104567550e+00,
+  3.85634475431478085383e+00,
+  3.83444231025048631878e+00,
+  3.81279617598663733702e+00,
+  3.79140193412160986242e+00,
+  3.77025526823369627749e+00,
+  3.74935196001236681340e+00,
+  3.72868788648678339825e+00,
+  3.70825901734773077933e+00,
+  3.68806141235933049316e+00,
+  3.66809121885696720611e+00,
+  3.64834466932827661267e+00,
+  3.62881807907376563449e+00,
+  3.60950784394419210699e+00,
+  3.59041043815170768383e+00,
+  3.57152241215200261237e+00,
+  3.55284039059475320599e+00,
+  3.53436107033984692194e+00,
+  3.51608121853690702707e+00,
+  3.49799767076578893565e+00,
+  3.48010732923580023979e+00,
+  3.46240716104148482657e+00,
+  3.44489419647291938986e+00,
+  3.42756552737853503743e+00,
+  3.41041830557858682837e+00,
+  3.39344974132738608219e+00,
+  3.37665710182271050499e+00,
+  3.36003770976051097108e+00,
+  3.34358894193346811718e+00,
+  3.32730822787178981415e+00,
+  3.31119304852478624213e+00,
+  3.29524093498180148387e+00,
+  3.27944946723113828213e+00,
+  3.26381627295566323355e+00,
+  3.24833902636383520246e+00,
+  3.23301544705494814380e+00,
+  3.21784329891742837404e+00,
+  3.20282038905905697135e+00,
+  3.18794456676806126083e+00,
+  3.17321372250403532789e+00,
+  3.15862578691764417371e+00,
+  3.14417872989829927377e+00,
+  3.12987055964869220759e+00,
+  3.11569932178544606316e+00,
+  3.10166309846497156855e+00,
+  3.08776000753371615559e+00,
+  3.07398820170202302648e+00,
+  3.06034586774082706384e+00,
+  3.04683122570046061028e+00,
+  3.03344252815086967701e+00,
+  3.02017805944253892036e+00,
+  3.00703613498749211530e+00,
+  2.99401510055972197577e+00,
+  2.98111333161444003181e+00,
+  2.96832923262557368815e+00,
+  2.95566123644088740718e+00,
+  2.94310780365430346706e+00,
+  2.93066742199473662112e+00,
+  2.91833860573104741931e+00,
+  2.90611989509258572539e+00,
+  2.89400985570484259313e+00,
+  2.88200707803976596821e+00,
+  2.87011017688028990946e+00,
+  2.85831779079865411219e+00,
+  2.84662858164809851047e+00,
+  2.83504123406753816283e+00,
+  2.82355445499882939941e+00,
+  2.81216697321625597183e+00,
+  2.80087753886788881630e+00,
+  2.78968492302842108188e+00,
+  2.77858791726324838578e+00,
+  2.76758533320334310091e+00,
+  2.75667600213069352577e+00,
+  2.74585877457397753432e+00,
+  2.73513251991417627451e+00,
+  2.72449612599984858363e+00,
+  2.71394849877178678810e+00,
+  2.70348856189679320750e+00,
+  2.69311525641031312972e+00,
+  2.68282754036768089634e+00,
+  2.67262438850373884591e+00,
+  2.66250479190058886303e+00,
+  2.65246775766325537660e+00,
+  2.64251230860304797687e+00,
+  2.63263748292837451714e+00,
+  2.62284233394288524011e+00,
+  2.61312592975063351375e+00,
+  2.60348735296815414486e+00,
+  2.59392570044322479106e+00,
+  2.58444008298014704650e+00,
+  2.57502962507136690107e+00,
+  2.56569346463526359869e+00,
+  2.55643075275994302586e+00,
+  2.54724065345287931095e+00,
+  2.53812234339624165358e+00,
+  2.52907501170776471966e+00,
+  2.52009785970701427615e+00,
+  2.51119010068689973991e+00,
+  2.50235095969031107188e+00,
+  2.49357967329171259507e+00,
+  2.48487548938364222195e+00,
+  2.47623766696788116803e+00,
+  2.46766547595126217729e+00,
+  2.45915819694595816358e+00,
+  2.45071512107414335446e+00,
+  2.44233554977691635912e+00,
+  2.43401879462737857907e+00,
+  2.42576417714776093604e+00,
+  2.41757102863049633257e+00,
+  2.40943868996314325415e+00,
+  2.40136651145705748434e+00,
+  2.39335385267972222678e+00,
+  2.38540008229065136902e+00,
+  2.37750457788076818844e+00,
+  2.36966672581516046847e+00,
+  2.36188592107919070884e+00,
+  2.35416156712778690263e+00,
+  2.34649307573791121584e+00,
+  2.33887986686409155013e+00,
+  2.33132136849696003367e+00,
+  2.32381701652471095443e+00,
+  2.31636625459742084843e+00,
+  2.30896853399415480368e+00,
+  2.30162331349279236647e+00,
+  2.29433005924251309793e+00,
+  2.28708824463887339107e+00,
+  2.27989735020141770505e+00,
+  2.27275686345376337627e+00,
+  2.26566627880608395529e+00,
+  2.25862509743998662870e+00,
+  2.25163282719565538414e+00,
+  2.24468898246126258300e+00,
+  2.23779308406457255742e+00,
+  2.23094465916669415506e+00,
+  2.22414324115792805259e+00,
+  2.21738836955566664955e+00,
+  2.21067958990428881094e+00,
+  2.20401645367702148093e+00,
+  2.19739851817970244241e+00,
+  2.19082534645641979765e+00,
+  2.18429650719697487915e+00,
+  2.17781157464612862285e+00,
+  2.17137012851460031726e+00,
+  2.16497175389175211535e+00,
+  2.15861604115998106934e+00,
+  2.15230258591070056085e+00,
+  2.14603098886194088024e+00,
+  2.13980085577750145376e+00,
+  2.13361179738763162561e+00,
+  2.12746342931120180353e+00,
+  2.12135537197933476961e+00,
+  2.11528725056046251751e+00,
+  2.10925869488678330299e+00,
+  2.10326933938208116004e+00,
+  2.09731882299088523425e+00,
+  2.09140678910893340614e+00,
+  2.08553288551492066460e+00,
+  2.07969676430349803553e+00,
+  2.07389808181948520627e+00,
+  2.06813649859331194492e+00,
+  2.06241167927760393752e+00,
+  2.05672329258493169490e+00,
+  2.05107101122668389337e+00,
+  2.04545451185304205666e+00,
+  2.03987347499402771334e+00,
+  2.03432758500161670057e+00,
+  2.02881652999287576122e+00,
+  2.02334000179411965803e+00,
+  2.01789769588605460982e+00,
+  2.01248931134989605951e+00,
+  2.00711455081443590487e+00,
+  2.00177312040404098425e+00,
+  1.99646472968756771849e+00,
+  1.99118909162815338476e+00,
+  1.98594592253391843961e+00,
+  1.98073494200948818644e+00,
+  1.97555587290837819658e+00,
+  1.97040844128619485609e+00,
+  1.96529237635464504308e+00,
+  1.96020741043633539569e+00,
+  1.95515327892034851409e+00,
+  1.95012972021857566851e+00,
+  1.94513647572279801956e+00,
+  1.94017328976249214811e+00,
+  1.93523990956335389946e+00,
+  1.93033608520652610885e+00,
+  1.92546156958851000240e+00,
+  1.92061611838174006728e+00,
+  1.91579948999584925851e+00,
+  1.91101144553954949146e+00,
+  1.90625174878316627769e+00,
+  1.90152016612178842436e+00,
+  1.89681646653903213107e+00,
+  1.89214042157140327483e+00,
+  1.88749180527324700307e+00,
+  1.88287039418227286625e+00,
+  1.87827596728564594208e+00,
+  1.87370830598663218325e+00,
+  1.86916719407178866241e+00,
+  1.86465241767868450395e+00,
+  1.86016376526415028181e+00,
+  1.85570102757303767582e+00,
+  1.85126399760747473167e+00,
+  1.84685247059663915081e+00,
+  1.84246624396699210102e+00,
+  1.83810511731300030291e+00,
+  1.83376889236832307795e+00,
+  1.82945737297745880667e+00,
+  1.82517036506783969507e+00,
+  1.82090767662237063007e+00,
+  1.81666911765240080001e+00,
+  1.81245450017111853214e+00,
+  1.80826363816737001322e+00,
+  1.80409634757988168730e+00,
+  1.79995244627188988318e+00,
+  1.79583175400616390505e+00,
+  1.79173409242042058764e+00,
+  1.78765928500310766758e+00,
+  1.78360715706958705695e+00,
+  1.77957753573865828933e+00,
+  1.77557024990945944154e+00,
+  1.77158513023871710956e+00,
+  1.76762200911834521655e+00,
+  1.76368072065338843402e+00,
+  1.75976110064029667157e+00,
+  1.75586298654553396581e+00,
+  1.75198621748451111024e+00,
+  1.74813063420083336652e+00,
+  1.74429607904586458922e+00,
+  1.74048239595859888240e+00,
+  1.73668943044583024005e+00,
+  1.73291702956262594348e+00,
+  1.72916504189307818073e+00,
+  1.72543331753136297557e+00,
+  1.72172170806306334967e+00,
+  1.71803006654677248299e+00,
+  1.71435824749597576222e+00,
+  1.71070610686119217725e+00,
+  1.70707350201238239329e+00,
+  1.70346029172161550491e+00,
+  1.69986633614598603437e+00,
+  1.69629149681078428280e+00,
+  1.69273563659290937622e+00,
+  1.68919861970452478417e+00,
+  1.68568031167694898365e+00,
+  1.68218057934478326665e+00,
+  1.67869929083025715144e+00,
+  1.67523631552781981924e+00,
+  1.67179152408893139103e+00,
+  1.66836478840708557492e+00,
+  1.66495598160303837076e+00,
+  1.66156497801025482275e+00,
+  1.65819165316055583403e+00,
+  1.65483588376997325931e+00,
+  1.65149754772480372722e+00,
+  1.64817652406785852826e+00,
+  1.64487269298490890179e+00,
+  1.64158593579132050522e+00,
+  1.63831613491887662093e+00,
+  1.63506317390278388402e+00,
+  1.63182693736886341718e+00,
+  1.62860731102090960931e+00,
+  1.62540418162824407133e+00,
+  1.62221743701342235866e+00,
+  1.61904696604012010575e+00,
+  1.61589265860118702633e+00,
+  1.61275440560686211811e+00,
+  1.60963209897315162600e+00,
+  1.60652563161036820993e+00,
+  1.60343489741182332331e+00,
+  1.60035979124267857543e+00,
+  1.59730020892894319928e+00,
+  1.59425604724662650646e+00,
+  1.59122720391103311677e+00,
+  1.58821357756620495927e+00,
+  1.58521506777450760239e+00,
+  1.58223157500634714623e+00,
+  1.57926300063004254604e+00,
+  1.57630924690181761783e+00,
+  1.57337021695593448634e+00,
+  1.57044581479495626297e+00,
+  1.56753594528014073006e+00,
+  1.56464051412196170077e+00,
+  1.56175942787075472395e+00,
+  1.55889259390748668999e+00,
+  1.55603992043464867123e+00,
+  1.55320131646726755648e+00,
+  1.55037669182403514689e+00,
+  1.54756595711855582387e+00,
+  1.54476902375070701545e+00,
+  1.54198580389810735447e+00,
+  1.53921621050771095796e+00,
+  1.53646015728749452123e+00,
+  1.53371755869826031926e+00,
+  1.53098832994554423514e+00,
+  1.52827238697162859360e+00,
+  1.52556964644765535866e+00,
+  1.52288002576584524661e+00,
+  1.52020344303181231815e+00,
+  1.51753981705697937876e+00,
+  1.51488906735108930235e+00,
+  1.51225111411481316637e+00,
+  1.50962587823245053542e+00,
+  1.50701328126472389179e+00,
+  1.50441324544166499244e+00,
+  1.50182569365558427066e+00,
+  1.49925054945414393259e+00,
+  1.49668773703350299620e+00,
+  1.49413718123155514483e+00,
+  1.49159880752125184600e+00,
+  1.48907254200400740451e+00,
+  1.48655831140318728245e+00,
+  1.48405604305767635509e+00,
+  1.48156566491552887932e+00,
+  1.47908710552769551150e+00,
+  1.47662029404182959524e+00,
+  1.47416516019616894440e+00,
+  1.47172163431349312113e+00,
+  1.46928964729515598719e+00,
+  1.46686913061519152990e+00,
+  1.46446001631448718960e+00,
+  1.46206223699503934377e+00,
+  1.45967572581426829892e+00,
+  1.45730041647940589122e+00,
+  1.45493624324195458541e+00,
+  1.45258314089220941234e+00,
+  1.45024104475384807422e+00,
+  1.44790989067858744122e+00,
+  1.44558961504090288663e+00,
+  1.44328015473281201508e+00,
+  1.44098144715872100718e+00,
+  1.43869343023033180451e+00,
+  1.43641604236161279928e+00,
+  1.43414922246382636750e+00,
+  1.43189290994061968476e+00,
+  1.42964704468316572417e+00,
+  1.42741156706537508647e+00,
+  1.42518641793915401550e+00,
+  1.42297153862972058924e+00,
+  1.42076687093097930870e+00,
+  1.41857235710094697900e+00,
+  1.41638793985723521196e+00,
+  1.41421356237258288857e+00,
+  1.41204916827044324457e+00,
+  1.40989470162062202618e+00,
+  1.40775010693496627212e+00,
+  1.40561532916310305552e+00,
+  1.40349031368822885213e+00,
+  1.40137500632294775826e+00,
+  1.39926935330515189726e+00,
+  1.39717330129396399840e+00,
+  1.39508679736571017393e+00,
+  1.39300978900994976151e+00,
+  1.39094222412554691104e+00,
+  1.38888405101678680253e+00,
+  1.38683521838953915939e+00,
+  1.38479567534746328406e+00,
+  1.38276537138825661444e+00,
+  1.38074425639994657899e+00,
+  1.37873228065722441826e+00,
+  1.37672939481782097282e+00,
+  1.37473554991892288335e+00,
+  1.37275069737362964695e+00,
+  1.37077478896745175163e+00,
+  1.36880777685484233963e+00,
+  1.36684961355577971887e+00,
+  1.36490025195237718592e+00,
+  1.36295964528553414929e+00,
+  1.36102774715162744279e+00,
+  1.35910451149923616754e+00,
+  1.35718989262590472578e+00,
+  1.35528384517494160377e+00,
+  1.35338632413225257167e+00,
+  1.35149728482321185297e+00,
+  1.34961668290956438021e+00,
+  1.34774447438636424401e+00,
+  1.34588061557894711484e+00,
+  1.34402506313993441722e+00,
+  1.34217777404627369719e+00,
+  1.34033870559630341468e+00,
+  1.33850781540686325499e+00,
+  1.33668506141042331414e+00,
+  1.33487040185225080968e+00,
+  1.33306379528760654551e+00,
+  1.33126520057897135274e+00,
+  1.32947457689330383879e+00,
+  1.32769188369932633620e+00,
+  1.32591708076484060541e+00,
+  1.32415012815407351354e+00,
+  1.32239098622504958058e+00,
+  1.32063961562699394570e+00,
+  1.31889597729776109070e+00,
+  1.31716003246129220727e+00,
+  1.31543174262510076389e+00,
+  1.31371106957778027713e+00,
+  1.31199797538654649998e+00,
+  1.31029242239479959409e+00,
+  1.30859437321971361357e+00,
+  1.30690379074985218999e+00,
+  1.30522063814280975258e+00,
+  1.30354487882287650713e+00,
+  1.30187647647872961620e+00,
+  1.30021539506114680584e+00,
+  1.29856159878074617353e+00,
+  1.29691505210574797857e+00,
+  1.29527571975976019125e+00,
+  1.29364356671958846690e+00,
+  1.29201855821306854644e+00,
+  1.29040065971691686464e+00,
+  1.28878983695461402093e+00,
+  1.28718605589429846425e+00,
+  1.28558928274669015401e+00,
+  1.28399948396303109632e+00,
+  1.28241662623305074931e+00,
+  1.28084067648294919195e+00,
+  1.27927160187340338560e+00,
+  1.27770936979759297536e+00,
+  1.27615394787924696374e+00,
+  1.27460530397070970210e+00,
+  1.27306340615102664415e+00,
+  1.27152822272405074955e+00,
+  1.26999972221656753923e+00,
+  1.26847787337644057892e+00,
+  1.26696264517076917500e+00,
+  1.26545400678407782280e+00,
+  1.26395192761651142810e+00,
+  1.26245637728205561956e+00,
+  1.26096732560677193824e+00,
+  1.25948474262705345517e+00,
+  1.25800859858789593204e+00,
+  1.25653886394118763370e+00,
+  1.25507550934401468368e+00,
+  1.25361850565698684790e+00,
+  1.25216782394257553079e+00,
+  1.25072343546347108934e+00,
+  1.24928531168095791060e+00,
+  1.24785342425330147975e+00,
+  1.24642774503415720844e+00,
+  1.24500824607098659058e+00,
+  1.24359489960350066973e+00,
+  1.24218767806210816929e+00,
+  1.24078655406638560521e+00,
+  1.23939150042355938908e+00,
+  1.23800249012700436246e+00,
+  1.23661949635475609810e+00,
+  1.23524249246803918822e+00,
+  1.23387145200980885562e+00,
+  1.23250634870330677550e+00,
+  1.23114715645063266258e+00,
+  1.22979384933132696034e+00,
+  1.22844640160097062775e+00,
+  1.22710478768979647235e+00,
+  1.22576898220131513817e+00,
+  1.22443895991095108577e+00,
+  1.22311469576469855625e+00,
+  1.22179616487778486267e+00,
+  1.22048334253334811450e+00,
+  1.21917620418112804259e+00,
+  1.21787472543616992482e+00,
+  1.21657888207754005805e+00,
+  1.21528865004705410868e+00,
+  1.21400400544801811975e+00,
+  1.21272492454398017614e+00,
+  1.21145138375749605864e+00,
+  1.21018335966890400179e+00,
+  1.20892082901511477289e+00,
+  1.20766376868841041059e+00,
+  1.20641215573525339977e+00,
+  1.20516596735511249960e+00,
+  1.20392518089929478897e+00,
+  1.20268977386978925814e+00,
+  1.20145972391812416724e+00,
+  1.20023500884423195423e+00,
+  1.19901560659532768760e+00,
+  1.19780149526479595679e+00,
+  1.19659265309108930886e+00,
+  1.19538905845663734340e+00,
+  1.19419068988676468912e+00,
+  1.19299752604862074890e+00,
+  1.19180954575011854857e+00,
+  1.19062672793888335576e+00,
+  1.18944905170121306703e+00,
+  1.18827649626104303593e+00,
+  1.18710904097892910869e+00,
+  1.18594666535103154814e+00,
+  1.18478934900811472275e+00,
+  1.18363707171455101452e+00,
+  1.18248981336733827163e+00,
+  1.18134755399512436647e+00,
+  1.18021027375723996933e+00,
+  1.17907795294274220232e+00,
+  1.17795057196946584277e+00,
+  1.17682811138308385246e+00,
+  1.17571055185617567851e+00,
+  1.17459787418730532416e+00,
+  1.17349005930010719112e+00,
+  1.17238708824238124784e+00,
+  1.17128894218519263859e+00,
+  1.17019560242198616962e+00,
+  1.16910705036770434795e+00,
+  1.16802326755791274771e+00,
+  1.16694423564793670067e+00,
+  1.16586993641200353800e+00,
+  1.16480035174239282547e+00,
+  1.16373546364859592472e+00,
+  1.16267525425648043935e+00,
+  1.16161970580746487514e+00,
+  1.16056880065769929544e+00,
+  1.15952252127725397024e+00,
+  1.15848085024931446441e+00,
+  1.15744377026938560782e+00,
+  1.15641126414450168269e+00,
+  1.15538331479244149591e+00,
+  1.15435990524095544174e+00,
+  1.15334101862699678342e+00,
+  1.15232663819595737564e+00,
+  1.15131674730091471126e+00,
+  1.15031132940188340896e+00,
+  1.14931036806507269610e+00,
+  1.14831384696215277330e+00,
+  1.14732174986952517592e+00,
+  1.14633406066760179520e+00,
+  1.14535076334008945054e+00,
+  1.14437184197327956880e+00,
+  1.14339728075534718954e+00,
+  1.14242706397565285670e+00,
+  1.14146117602405183789e+00,
+  1.14049960139021222538e+00,
+  1.13954232466293459147e+00,
+  1.13858933052947985942e+00,
+  1.13764060377490405784e+00,
+  1.13669612928139684982e+00,
+  1.13575589202762716745e+00,
+  1.13481987708809395343e+00,
+  1.13388806963248423010e+00,
+  1.13296045492503383301e+00,
+  1.13203701832389680426e+00,
+  1.13111774528051811650e+00,
+  1.13020262133901305823e+00,
+  1.12929163213555217027e+00,
+  1.12838476339775062307e+00,
+  1.12748200094406181293e+00,
+  1.12658333068318117220e+00,
+  1.12568873861344975751e+00,
+  1.12479821082226516538e+00,
+  1.12391173348549755495e+00,
+  1.12302929286691122179e+00,
+  1.12215087531759039052e+00,
+  1.12127646727536989246e+00,
+  1.12040605526427117233e+00,
+  1.11953962589394429017e+00,
+  1.11867716585911192162e+00,
+  1.11781866193902068574e+00,
+  1.11696410099689669160e+00,
+  1.11611346997940463766e+00,
+  1.11526675591611357241e+00,
+  1.11442394591896332123e+00,
+  1.11358502718174223745e+00,
+  1.11274998697956295501e+00,
+  1.11191881266834502462e+00,
+  1.11109149168430310084e+00,
+  1.11026801154343801592e+00,
+  1.10944835984103318260e+00,
+  1.10863252425115388355e+00,
+  1.10782049252615255597e+00,
+  1.10701225249617829505e+00,
+  1.10620779206868768973e+00,
+  1.10540709922796387410e+00,
+  1.10461016203463735508e+00,
+  1.10381696862521039293e+00,
+  1.10302750721158848712e+00,
+  1.10224176608061008587e+00,
+  1.10145973359358828603e+00,
+  1.10068139818584898038e+00,
+  1.09990674836627788657e+00,
+  1.09913577271686802028e+00,
+  1.09836845989227360754e+00,
+  1.09760479861936732782e+00,
+  1.09684477769679866732e+00,
+  1.09608838599456004381e+00,
+  1.09533561245355359759e+00,
+  1.09458644608516353358e+00,
+  1.09384087597083023979e+00,
+  1.09309889126162951278e+00,
+  1.09236048117785555789e+00,
+  1.09162563500860443355e+00,
+  1.09089434211136615538e+00,
+  1.09016659191161657816e+00,
+  1.08944237390241194241e+00,
+  1.08872167764399097045e+00,
+  1.08800449276337607429e+00,
+  1.08729080895398011464e+00,
+  1.08658061597521671260e+00,
+  1.08587390365211211574e+00,
+  1.08517066187492194906e+00,
+  1.08447088059875085264e+00,
+  1.08377454984317389552e+00,
+  1.08308165969186398492e+00,
+  1.08239220029221971942e+00,
+  1.08170616185499812723e+00,
+  1.08102353465394762644e+00,
+  1.08034430902544942299e+00,
+  1.07966847536815691022e+00,
+  1.07899602414263973138e+00,
+  1.07832694587103161687e+00,
+  1.07766123113668044198e+00,
+  1.07699887058380050497e+00,
+  1.07633985491712991234e+00,
+  1.07568417490158818595e+00,
+  1.07503182136193897733e+00,
+  1.07438278518245367010e+00,
+  1.07373705730657964530e+00,
+  1.07309462873660965698e+00,
+  1.07245549053335542666e+00,
+  1.07181963381582323613e+00,
+  1.07118704976089107461e+00,
+  1.07055772960299133700e+00,
+  1.06993166463379396625e+00,
+  1.06930884620189292633e+00,
+  1.06868926571249400759e+00,
+  1.06807291462710884922e+00,
+  1.06745978446324629729e+00,
+  1.06684986679411175636e+00,
+  1.06624315324830432061e+00,
+  1.06563963550952012227e+00,
+  1.06503930531625568001e+00,
+  1.06444215446151524418e+00,
+  1.06384817479251925221e+00,
+  1.06325735821041722495e+00,
+  1.06266969667000066302e+00,
+  1.06208518217941971784e+00,
+  1.06150380679990274935e+00,
+  1.06092556264547699385e+00,
+  1.06035044188269167442e+00,
+  1.05977843673034510807e+00,
+  1.05920953945921136885e+00,
+  1.05864374239177161385e+00,
+  1.05808103790194696359e+00,
+  1.05752141841483271456e+00,
+  1.05696487640643588257e+00,
+  1.05641140440341474438e+00,
+  1.05586099498282015574e+00,
+  1.05531364077183931194e+00,
+  1.05476933444754217284e+00,
+  1.05422806873662788796e+00,
+  1.05368983641517721672e+00,
+  1.05315463030840339442e+00,
+  1.05262244329040632884e+00,
+  1.05209326828393012754e+00,
+  1.05156709826012062514e+00,
+  1.05104392623828624131e+00,
+  1.05052374528566061507e+00,
+  1.05000654851716657134e+00,
+  1.04949232909518408441e+00,
+  1.04898108022931713101e+00,
+  1.04847279517616542854e+00,
+  1.04796746723909595111e+00,
+  1.04746508976801799840e+00,
+  1.04696565615916004077e+00,
+  1.04646915985484545430e+00,
+  1.04597559434327602723e+00,
+  1.04548495315831102559e+00,
+  1.04499722987925269813e+00,
+  1.04451241813063178121e+00,
+  1.04403051158199411397e+00,
+  1.04355150394769102817e+00,
+  1.04307538898666951610e+00,
+  1.04260216050226572904e+00,
+  1.04213181234200047420e+00,
+  1.04166433839737337941e+00,
+  1.04119973260366416312e+00,
+  1.04073798893972946367e+00,
+  1.04027910142780699587e+00,
+  1.03982306413331859751e+00,
+  1.03936987116467283165e+00,
+  1.03891951667307602669e+00,
+  1.03847199485233687710e+00,
+  1.03802729993867903779e+00,
+  1.03758542621055194211e+00,
+  1.03714636798844428434e+00,
+  1.03671011963469927863e+00,
+  1.03627667555333147220e+00,
+  1.03584603018984466871e+00,
+  1.03541817803105185014e+00,
+  1.03499311360489731904e+00,
+  1.03457083148027928488e+00,
+  1.03415132626687400474e+00,
+  1.03373459261496281059e+00,
+  1.03332062521525980259e+00,
+  1.03290941879873976461e+00,
+  1.03250096813647052052e+00,
+  1.03209526803944529050e+00,
+  1.03169231335841438124e+00,
+  1.03129209898372309340e+00,
+  1.03089461984514652038e+00,
+  1.03049987091172878806e+00,
+  1.03010784719162229450e+00,
+  1.02971854373192917009e+00,
+  1.02933195561854362587e+00,
+  1.02894807797599519006e+00,
+  1.02856690596729616338e+00,
+  1.02818843479378618788e+00,
+  1.02781265969498214474e+00,
+  1.02743957594842583170e+00,
+  1.02706917886953785768e+00,
+  1.02670146381146709658e+00,
+  1.02633642616494680233e+00,
+  1.02597406135814739336e+00,
+  1.02561436485653501016e+00,
+  1.02525733216272829651e+00,
+  1.02490295881635740116e+00,
+  1.02455124039392519997e+00,
+  1.02420217250866740777e+00,
+  1.02385575081041801937e+00,
+  1.02351197098547164188e+00,
+  1.02317082875645049000e+00,
+  1.02283231988217004904e+00,
+  1.02249644015750873471e+00,
+  1.02216318541327599867e+00,
+  1.02183255151608398670e+00,
+  1.02150453436821941899e+00,
+  1.02117912990751613656e+00,
+  1.02085633410723075620e+00,
+  1.02053614297591699334e+00,
+  1.02021855255730375944e+00,
+  1.01990355893017259348e+00,
+  1.01959115820823709164e+00,
+  1.01928134654002366943e+00,
+  1.01897412010875365596e+00,
+  1.01866947513222494415e+00,
+  1.01836740786269719372e+00,
+  1.01806791458677725615e+00,
+  1.01777099162530459964e+00,
+  1.01747663533323962071e+00,
+  1.01718484209955239983e+00,
+  1.01689560834711212323e+00,
+  1.01660893053257894714e+00,
+  1.01632480514629519597e+00,
+  1.01604322871217944702e+00,
+  1.01576419778761994905e+00,
+  1.01548770896337225977e+00,
+  1.01521375886345288642e+00,
+  1.01494234414503980979e+00,
+  1.01467346149836923352e+00,
+  1.01440710764663721832e+00,
+  1.01414327934589953983e+00,
+  1.01388197338497398903e+00,
+  1.01362318658534467097e+00,
+  1.01336691580106386112e+00,
+  1.01311315791866007885e+00,
+  1.01286190985704260825e+00,
+  1.01261316856740957171e+00,
+  1.01236693103315666953e+00,
+  1.01212319426978547554e+00,
+  1.01188195532481595151e+00,
+  1.01164321127769629705e+00,
+  1.01140695923971657422e+00,
+  1.01117319635392166610e+00,
+  1.01094191979502667778e+00,
+  1.01071312676933189323e+00,
+  1.01048681451463995273e+00,
+  1.01026298030017347429e+00,
+  1.01004162142649334122e+00,
+  1.00982273522541854405e+00,
+  1.00960631905994779878e+00,
+  1.00939237032417938877e+00,
+  1.00918088644323522551e+00,
+  1.00897186487318424319e+00,
+  1.00876530310096645948e+00,
+  1.00856119864431881261e+00,
+  1.00835954905170188667e+00,
+  1.00816035190222708096e+00,
+  1.00796360480558511163e+00,
+  1.00776930540197606767e+00,
+  1.00757745136203813452e+00,
+  1.00738804038678053665e+00,
+  1.00720107020751536986e+00,
+  1.00701653858578965561e+00,
+  1.00683444331332072608e+00,
+  1.00665478221193094299e+00,
+  1.00647755313348352679e+00,
+  1.00630275395981927389e+00,
+  1.00613038260269416213e+00,
+  1.00596043700371873264e+00,
+  1.00579291513429769367e+00,
+  1.00562781499556908038e+00,
+  1.00546513461834763348e+00,
+  1.00530487206306595738e+00,
+  1.00514702541971812089e+00,
+  1.00499159280780303583e+00,
+  1.00483857237627094428e+00,
+  1.00468796230346835152e+00,
+  1.00453976079708451330e+00,
+  1.00439396609409969940e+00,
+  1.00425057646073434547e+00,
+  1.00410959019239709455e+00,
+  1.00397100561363639137e+00,
+  1.00383482107809052231e+00,
+  1.00370103496844054192e+00,
+  1.00356964569636342155e+00,
+  1.00344065170248453178e+00,
+  1.00331405145633389964e+00,
+  1.00318984345630068944e+00,
+  1.00306802622958968207e+00,
+  1.00294859833217930856e+00,
+  1.00283155834877857338e+00,
+  1.00271690489278642033e+00,
+  1.00260463660625265270e+00,
+  1.00249475215983641085e+00,
+  1.00238725025276975700e+00,
+  1.00228212961281837323e+00,
+  1.00217938899624603444e+00,
+  1.00207902718777752682e+00,
+  1.00198104300056423099e+00,
+  1.00188543527614926099e+00,
+  1.00179220288443482367e+00,
+  1.00170134472364824596e+00,
+  1.00161285972031133262e+00,
+  1.00152674682920861393e+00,
+  1.00144300503335781372e+00,
+  1.00136163334397965130e+00,
+  1.00128263080047008593e+00,
+  1.00120599647037233915e+00,
+  1.00113172944934980535e+00,
+  1.00105982886116029462e+00,
+  1.00099029385763027555e+00,
+  1.00092312361863133852e+00,
+  1.00085831735205532667e+00,
+  1.00079587429379257557e+00,
+  1.00073579370770993080e+00,
+  1.00067807488562809937e+00,
+  1.00062271714730322003e+00,
+  1.00056971984040599111e+00,
+  1.00051908234050368485e+00,
+  1.00047080405104105161e+00,
+  1.00042488440332455468e+00,
+  1.00038132285650505082e+00,
+  1.00034011889756269120e+00,
+  1.00030127204129182239e+00,
+  1.00026478183028766367e+00,
+  1.00023064783493231822e+00,
+  1.00019886965338300477e+00,
+  1.00016944691156028924e+00,
+  1.00014237926313787064e+00,
+  1.00011766638953147890e+00,
+  1.00009530799989065919e+00,
+  1.00007530383109033423e+00,
+  1.00005765364772303272e+00,
+  1.00004235724209222802e+00,
+  1.00002941443420634293e+00,
+  1.00001882507177297654e+00,
+  1.00001058903019601765e+00,
+  1.00000470621257098180e+00,
+  1.00000117654968168068e+00,
+};
+#define THERMALRECENCY_SIZE 60
+const double THERMALRECENCY[60] = {  1.00000000000000000000e+00,
+  9.96672216054523274487e-01,
+  9.90616214681808493481e-01,
+  9.82828629635954520438e-01,
+  9.73685749353145002516e-01,
+  9.63418097794111250032e-01,
+  9.52190846893950504359e-01,
+  9.40132743444214158401e-01,
+  9.27349535694774296246e-01,
+  9.13931185271228185840e-01,
+  8.99956135355975406220e-01,
+  8.85494019453154868060e-01,
+  8.70607474358073507581e-01,
+  8.55353405851154602324e-01,
+  8.39783903441106427401e-01,
+  8.23946921081774252826e-01,
+  8.07886796729991196742e-01,
+  7.91644657897610737329e-01,
+  7.75258744694439339007e-01,
+  7.58764671977439242312e-01,
+  7.42195645789349045529e-01,
+  7.25582644968842727096e-01,
+  7.08954575869813363731e-01,
+  6.92338406069129774778e-01,
+  6.75759281476658757448e-01,
+  6.59240630200443766817e-01,
+  6.42804255740527574758e-01,
+  6.26470421504670471613e-01,
+  6.10257928202054156230e-01,
+  5.94184185338170078872e-01,
+  5.78265277778126751684e-01,
+  5.62516028147110991320e-01,
+  5.46950055681600377788e-01,
+  5.31579832022864517960e-01,
+  5.16416734347669215133e-01,
+  5.01471096154222362173e-01,
+  4.86752255959971624755e-01,
+  4.72268604118591783791e-01,
+  4.58027627923880964467e-01,
+  4.44035955136351023764e-01,
+  4.30299396042538251361e-01,
+  4.16822984136271001976e-01,
+  4.03611015494365843459e-01,
+  3.90667086905724547652e-01,
+  3.77994132801971804980e-01,
+  3.65594461029116801765e-01,
+  3.53469787492844078614e-01,
+  3.41621269704622088081e-01,
+  3.30049539251602797041e-01,
+  3.18754733210045548830e-01,
+  3.07736524519568177549e-01,
+  2.96994151333752509636e-01,
+  2.86526445361393711231e-01,
+  2.76331859211876806892e-01,
+  2.66408492757710169130e-01,
+  2.56754118527071806266e-01,
+  2.47366206139267019726e-01,
+  2.38241945796217741149e-01,
+  2.29378270843448556215e-01,
+  2.20771879414479149650e-01,
+};
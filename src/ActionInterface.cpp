@@ -67,9 +67,14 @@ void
 XCSoarInterface::ReceiveCalculated()
 {
   {
-    ScopeLock protect(device_blackboard->mutex);
+    /* this does not lock the DeviceBlackboard */
+    const DeviceBlackboard::CalculatedLease calculated(*device_blackboard);
+    if (calculated.IsDefined())
+      ReadBlackboardCalculated(*calculated);
+  }
 
-    ReadBlackboardCalculated(device_blackboard->Calculated());
+  {
+    ScopeLock protect(device_blackboard->mutex);
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
@@ -39,8 +39,12 @@ Copyright_License {
 #include "Engine/Airspace/AirspaceClass.hpp"
 #include "Util/StaticString.hxx"
 #include "Util/StringCompare.hxx"
+#include "Thread/WorkerPool.hpp"
+
+#include <algorithm>
 
 #include <tchar.h>
+#include <assert.h>
 
 enum class AirspaceFileType {
   UNKNOWN,
@@ -113,12 +117,278 @@ static constexpr AirspaceClassStringCouple airspace_tnp_type_strings[] = {
   { _T("RMZ"), RMZ },
 };
 
+static int
+ArcStepWidth(double radius)
+{
+  if (radius > 50000)
+    return 1;
+  if (radius > 25000)
+    return 2;
+  if (radius > 10000)
+    return 3;
+
+  return 5;
+}
+
+/**
+ * An arc of an airspace border, as parsed from the file.  It is
+ * converted to polygon points later by PendingAirspaces::Finish().
+ */
+struct TempArc
+{
+  /**
+   * The index in PendingAirspaces::points where this arc is
+   * inserted.
+   */
+  unsigned position;
+
+  int rotation;
+
+  GeoPoint center;
+
+  /**
+   * Is this arc specified by radius and bearings (OpenAir "DA")
+   * instead of start and end point?
+   */
+  bool bearings;
+
+  // Arc by points
+  GeoPoint start, end;
+
+  // Arc by bearings
+  double radius;
+  Angle start_bearing, end_bearing;
+
+  /**
+   * Returns the last polygon point this arc generates.
+   */
+  gcc_pure
+  GeoPoint GetLastPoint() const {
+    return bearings
+      ? FindLatitudeLongitude(center, NormaliseEnd(start_bearing,
+                                                   end_bearing),
+                              radius)
+      : end;
+  }
+
+  void AppendTo(std::vector<GeoPoint> &points) const {
+    if (bearings)
+      AppendBearings(points);
+    else
+      AppendPoints(points);
+  }
+
+private:
+  Angle NormaliseEnd(Angle start, Angle end) const {
+    if (rotation > 0) {
+      while (end < start)
+        end += Angle::FullCircle();
+    } else if (rotation < 0) {
+      while (end > start)
+        end -= Angle::FullCircle();
+    }
+
+    return end;
+  }
+
+  void AppendPoints(std::vector<GeoPoint> &points) const {
+    // Determine start bearing and radius
+    const GeoVector v = center.DistanceBearing(start);
+    Angle start_bearing = v.bearing;
+    const auto radius = v.distance;
+
+    // 5 or -5, depending on direction
+    const auto _step = ArcStepWidth(radius);
+    const auto step = Angle::Degrees(rotation * _step);
+    const auto threshold = _step * 1.5;
+
+    // Determine end bearing
+    const Angle end_bearing = NormaliseEnd(start_bearing,
+                                           center.Bearing(end));
+
+    // Add first polygon point
+    points.push_back(start);
+
+    // Add intermediate polygon points
+    while ((end_bearing - start_bearing).AbsoluteDegrees() > threshold) {
+      start_bearing += step;
+      points.push_back(FindLatitudeLongitude(center, start_bearing, radius));
+    }
+
+    // Add last polygon point
+    points.push_back(end);
+  }
+
+  void AppendBearings(std::vector<GeoPoint> &points) const {
+    // 5 or -5, depending on direction
+    const auto _step = ArcStepWidth(radius);
+    const auto step = Angle::Degrees(rotation * _step);
+    const auto threshold = _step * 1.5;
+
+    Angle start = start_bearing;
+    const Angle end = NormaliseEnd(start, end_bearing);
+
+    // Add first polygon point
+    points.push_back(FindLatitudeLongitude(center, start, radius));
+
+    // Add intermediate polygon points
+    while ((end - start).AbsoluteDegrees() > threshold) {
+      start += step;
+      points.push_back(FindLatitudeLongitude(center, start, radius));
+    }
+
+    // Add last polygon point
+    points.push_back(FindLatitudeLongitude(center, end, radius));
+  }
+};
+
+/**
+ * A complete airspace whose geometry has not been constructed yet.
+ */
+struct PendingAirspace
+{
+  tstring name;
+  tstring radio;
+  AirspaceClass type;
+  AirspaceAltitude base;
+  AirspaceAltitude top;
+  AirspaceActivity days_of_operation;
+
+  /**
+   * Is this a circle?  Otherwise, it is a polygon made of the given
+   * ranges of PendingAirspaces::points and PendingAirspaces::arcs.
+   */
+  bool circle;
+
+  // Circle
+  GeoPoint center;
+  double radius;
+
+  // Polygon
+  unsigned first_point, end_point;
+  unsigned first_arc, end_arc;
+};
+
+/**
+ * Collects the airspaces of one file while it is being parsed.
+ * Approximating arcs and constructing the #AbstractAirspace objects
+ * is the expensive part of loading an airspace file; Finish() does
+ * that in parallel after the whole file has been read.
+ */
+struct PendingAirspaces
+{
+  /**
+   * Polygon points of all airspaces.
+   */
+  std::vector<GeoPoint> points;
+
+  /**
+   * Arcs of all airspaces.
+   */
+  std::vector<TempArc> arcs;
+
+  std::vector<PendingAirspace> airspaces;
+
+  /**
+   * Construct all airspaces and add them to the database, in the
+   * order they were parsed.
+   */
+  void Finish(Airspaces &airspace_database);
+
+private:
+  /**
+   * The number of airspaces constructed by one job of the worker
+   * pool.
+   */
+  static constexpr unsigned CHUNK_SIZE = 64;
+
+  void GetPolygon(const PendingAirspace &src,
+                  std::vector<GeoPoint> &dest) const;
+
+  AbstractAirspace *Construct(PendingAirspace &src,
+                              std::vector<GeoPoint> &buffer) const;
+};
+
+void
+PendingAirspaces::GetPolygon(const PendingAirspace &src,
+                             std::vector<GeoPoint> &dest) const
+{
+  dest.clear();
+
+  auto arc = arcs.begin() + src.first_arc;
+  const auto end_arc = arcs.begin() + src.end_arc;
+
+  for (unsigned i = src.first_point;; ++i) {
+    for (; arc != end_arc && arc->position == i; ++arc)
+      arc->AppendTo(dest);
+
+    if (i == src.end_point)
+      break;
+
+    dest.push_back(points[i]);
+  }
+}
+
+AbstractAirspace *
+PendingAirspaces::Construct(PendingAirspace &src,
+                            std::vector<GeoPoint> &buffer) const
+{
+  AbstractAirspace *as;
+  if (src.circle) {
+    as = new AirspaceCircle(src.center, src.radius);
+  } else {
+    GetPolygon(src, buffer);
+    if (buffer.size() < 3)
+      return nullptr;
+
+    as = new AirspacePolygon(buffer);
+  }
+
+  as->SetProperties(std::move(src.name), src.type, src.base, src.top);
+  as->SetRadio(src.radio);
+  as->SetDays(src.days_of_operation);
+  return as;
+}
+
+void
+PendingAirspaces::Finish(Airspaces &airspace_database)
+{
+  const unsigned n = airspaces.size();
+  const unsigned n_chunks = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+  std::vector<AbstractAirspace *> result(n);
+
+  /* constructors of the airspace classes are reentrant; each chunk
+     writes to its own slice of the result vector */
+  const auto f = [this, n, &result](unsigned chunk){
+    std::vector<GeoPoint> buffer;
+    const unsigned end = std::min((chunk + 1) * CHUNK_SIZE, n);
+    for (unsigned i = chunk * CHUNK_SIZE; i < end; ++i)
+      result[i] = Construct(airspaces[i], buffer);
+  };
+
+  if (n_chunks > 1) {
+    WorkerPool pool;
+    pool.Run(n_chunks, f);
+  } else if (n_chunks > 0)
+    f(0);
+
+  for (AbstractAirspace *as : result)
+    airspace_database.Add(as);
+
+  points.clear();
+  arcs.clear();
+  airspaces.clear();
+}
+
 // this can now be called multiple times to load several airspaces.
 
 struct TempAirspaceType
 {
-  TempAirspaceType() {
-    points.reserve(256);
+  PendingAirspaces &pending;
+
+  explicit TempAirspaceType(PendingAirspaces &_pending)
+    :pending(_pending) {
     Reset();
   }
 
@@ -130,8 +400,9 @@ struct TempAirspaceType
   AirspaceAltitude top;
   AirspaceActivity days_of_operation;
 
-  // Polygon
-  std::vector<GeoPoint> points;
+  // Polygon: the ranges of PendingAirspaces::points and
+  // PendingAirspaces::arcs beginning at these indices
+  unsigned first_point, first_arc;
 
   // Circle or Arc
   GeoPoint center;
@@ -147,125 +418,121 @@ struct TempAirspaceType
     radio = _T("");
     type = OTHER;
     base = top = AirspaceAltitude();
-    points.clear();
-    center.longitude = Angle::Zero();
-    center.latitude = Angle::Zero();
-    rotation = 1;
-    radius = 0;
+    ResetTNP();
   }
 
   void
   ResetTNP()
   {
     // Preserve type, radio and days_of_operation for next airspace blocks
-    points.clear();
+    first_point = pending.points.size();
+    first_arc = pending.arcs.size();
     center.longitude = Angle::Zero();
     center.latitude = Angle::Zero();
     rotation = 1;
     radius = 0;
   }
 
-  void
-  AddPolygon(Airspaces &airspace_database)
+  bool
+  HasPoints() const
   {
-    if (points.size() < 3)
-      return;
-
-    AbstractAirspace *as = new AirspacePolygon(points);
-    as->SetProperties(std::move(name), type, base, top);
-    as->SetRadio(radio);
-    as->SetDays(days_of_operation);
-    airspace_database.Add(as);
+    return pending.points.size() > first_point ||
+      pending.arcs.size() > first_arc;
   }
 
-  void
-  AddCircle(Airspaces &airspace_database)
+  /**
+   * Returns the last polygon point.  Must not be called if
+   * HasPoints() is false.
+   */
+  gcc_pure
+  GeoPoint
+  GetLastPoint() const
   {
-    AbstractAirspace *as = new AirspaceCircle(center, radius);
-    as->SetProperties(std::move(name), type, base, top);
-    as->SetRadio(radio);
-    as->SetDays(days_of_operation);
-    airspace_database.Add(as);
+    assert(HasPoints());
+
+    if (pending.arcs.size() > first_arc &&
+        pending.arcs.back().position == pending.points.size())
+      return pending.arcs.back().GetLastPoint();
+
+    return pending.points.back();
   }
 
-  static int
-  ArcStepWidth(double radius)
+  void
+  AddPoint(const GeoPoint &point)
   {
-    if (radius > 50000)
-      return 1;
-    if (radius > 25000)
-      return 2;
-    if (radius > 10000)
-      return 3;
-
-    return 5;
+    pending.points.push_back(point);
   }
 
   void
-  AppendArc(const GeoPoint start, const GeoPoint end)
+  AddPolygon()
   {
+    /* each arc generates at least two points; whether there are
+       enough points is checked again when the arcs have been
+       approximated */
+    if (pending.points.size() - first_point +
+        2 * (pending.arcs.size() - first_arc) < 3)
+      return;
 
-    // Determine start bearing and radius
-    const GeoVector v = center.DistanceBearing(start);
-    Angle start_bearing = v.bearing;
-    const auto radius = v.distance;
-
-    // 5 or -5, depending on direction
-    const auto _step = ArcStepWidth(radius);
-    const auto step = Angle::Degrees(rotation * _step);
-    const auto threshold = _step * 1.5;
-
-    // Determine end bearing
-    Angle end_bearing = center.Bearing(end);
-
-    if (rotation > 0) {
-      while (end_bearing < start_bearing)
-        end_bearing += Angle::FullCircle();
-    } else if (rotation < 0) {
-      while (end_bearing > start_bearing)
-        end_bearing -= Angle::FullCircle();
-    }
-
-    // Add first polygon point
-    points.push_back(start);
+    PendingAirspace &as = Add();
+    as.circle = false;
+    as.first_point = first_point;
+    as.end_point = pending.points.size();
+    as.first_arc = first_arc;
+    as.end_arc = pending.arcs.size();
+  }
 
-    // Add intermediate polygon points
-    while ((end_bearing - start_bearing).AbsoluteDegrees() > threshold) {
-      start_bearing += step;
-      points.push_back(FindLatitudeLongitude(center, start_bearing, radius));
-    }
+  void
+  AddCircle()
+  {
+    PendingAirspace &as = Add();
+    as.circle = true;
+    as.center = center;
+    as.radius = radius;
+  }
 
-    // Add last polygon point
-    points.push_back(end);
+  void
+  AppendArc(const GeoPoint start, const GeoPoint end)
+  {
+    TempArc &arc = AddArc();
+    arc.bearings = false;
+    arc.start = start;
+    arc.end = end;
   }
 
   void
   AppendArc(Angle start, Angle end)
   {
-    // 5 or -5, depending on direction
-    const auto _step = ArcStepWidth(radius);
-    const auto step = Angle::Degrees(rotation * _step);
-    const auto threshold = _step * 1.5;
-
-    if (rotation > 0) {
-      while (end < start)
-        end += Angle::FullCircle();
-    } else if (rotation < 0) {
-      while (end > start)
-        end -= Angle::FullCircle();
-    }
-
-    // Add first polygon point
-    points.push_back(FindLatitudeLongitude(center, start, radius));
+    TempArc &arc = AddArc();
+    arc.bearings = true;
+    arc.radius = radius;
+    arc.start_bearing = start;
+    arc.end_bearing = end;
+  }
 
-    // Add intermediate polygon points
-    while ((end - start).AbsoluteDegrees() > threshold) {
-      start += step;
-      points.push_back(FindLatitudeLongitude(center, start, radius));
-    }
+private:
+  PendingAirspace &
+  Add()
+  {
+    pending.airspaces.emplace_back();
+    PendingAirspace &as = pending.airspaces.back();
+    as.name = std::move(name);
+    as.radio = radio;
+    as.type = type;
+    as.base = base;
+    as.top = top;
+    as.days_of_operation = days_of_operation;
+    return as;
+  }
 
-    // Add last polygon point
-    points.push_back(FindLatitudeLongitude(center, end, radius));
+  TempArc &
+  AddArc()
+  {
+    pending.arcs.emplace_back();
+    TempArc &arc = pending.arcs.back();
+    arc.position = pending.points.size();
+    arc.rotation = rotation;
+    arc.center = center;
+    return arc;
   }
 };
 
@@ -496,8 +763,7 @@ ParseType(const TCHAR *buffer)
 }
 
 static bool
-ParseLine(Airspaces &airspace_database, StringParser<TCHAR> &&input,
-          TempAirspaceType &temp_area)
+ParseLine(StringParser<TCHAR> &&input, TempAirspaceType &temp_area)
 {
   double d;
 
@@ -516,7 +782,7 @@ ParseLine(Airspaces &airspace_database, StringParser<TCHAR> &&input,
       if (!ReadCoords(input, temp_point))
         return false;
 
-      temp_area.points.push_back(temp_point);
+      temp_area.AddPoint(temp_point);
       break;
     }
 
@@ -526,7 +792,7 @@ ParseLine(Airspaces &airspace_database, StringParser<TCHAR> &&input,
         return false;
 
       temp_area.radius = Units::ToSysUnit(d, Unit::NAUTICAL_MILES);
-      temp_area.AddCircle(airspace_database);
+      temp_area.AddCircle();
       temp_area.Reset();
       break;
 
@@ -565,7 +831,7 @@ ParseLine(Airspaces &airspace_database, StringParser<TCHAR> &&input,
       if (!input.SkipWhitespace())
         break;
 
-      temp_area.AddPolygon(airspace_database);
+      temp_area.AddPolygon();
       temp_area.Reset();
 
       temp_area.type = ParseType(input.c_str());
@@ -606,15 +872,14 @@ ParseLine(Airspaces &airspace_database, StringParser<TCHAR> &&input,
 }
 
 static bool
-ParseLine(Airspaces &airspace_database, TCHAR *line,
-          TempAirspaceType &temp_area)
+ParseLine(TCHAR *line, TempAirspaceType &temp_area)
 {
   // Strip comments
   auto *comment = StringFind(line, _T('*'));
   if (comment != nullptr)
     *comment = _T('\0');
 
-  return ParseLine(airspace_database, StringParser<TCHAR>(line), temp_area);
+  return ParseLine(StringParser<TCHAR>(line), temp_area);
 }
 
 static AirspaceClass
@@ -708,12 +973,12 @@ ParseCoordsTNP(StringParser<TCHAR> &input, GeoPoint &point)
 static bool
 ParseArcTNP(StringParser<TCHAR> &input, TempAirspaceType &temp_area)
 {
-  if (temp_area.points.empty())
+  if (!temp_area.HasPoints())
     return false;
 
   // (ANTI-)CLOCKWISE RADIUS=34.95 CENTRE=N523333 E0131603 TO=N522052 E0122236
 
-  GeoPoint from = temp_area.points.back();
+  GeoPoint from = temp_area.GetLastPoint();
 
   /* skip "RADIUS=... " */
   if (!input.SkipWord())
@@ -758,8 +1023,8 @@ ParseCircleTNP(StringParser<TCHAR> &input, TempAirspaceType &temp_area)
 }
 
 static bool
-ParseLineTNP(Airspaces &airspace_database, StringParser<TCHAR> &input,
-             TempAirspaceType &temp_area, bool &ignore)
+ParseLineTNP(StringParser<TCHAR> &input, TempAirspaceType &temp_area,
+             bool &ignore)
 {
   if (input.Match('#'))
     return true;
@@ -781,12 +1046,12 @@ ParseLineTNP(Airspaces &airspace_database, StringParser<TCHAR> &input,
     if (!ParseCoordsTNP(input, temp_point))
       return false;
 
-    temp_area.points.push_back(temp_point);
+    temp_area.AddPoint(temp_point);
   } else if (input.SkipMatchIgnoreCase(_T("CIRCLE "), 7)) {
     if (!ParseCircleTNP(input, temp_area))
       return false;
 
-    temp_area.AddCircle(airspace_database);
+    temp_area.AddCircle();
     temp_area.ResetTNP();
   } else if (input.SkipMatchIgnoreCase(_T("CLOCKWISE "), 10)) {
     temp_area.rotation = 1;
@@ -797,12 +1062,12 @@ ParseLineTNP(Airspaces &airspace_database, StringParser<TCHAR> &input,
     if (!ParseArcTNP(input, temp_area))
       return false;
   } else if (input.SkipMatchIgnoreCase(_T("TITLE="), 6)) {
-    temp_area.AddPolygon(airspace_database);
+    temp_area.AddPolygon();
     temp_area.ResetTNP();
 
     temp_area.name = input.c_str();
   } else if (input.SkipMatchIgnoreCase(_T("TYPE="), 5)) {
-    temp_area.AddPolygon(airspace_database);
+    temp_area.AddPolygon();
     temp_area.ResetTNP();
 
     temp_area.type = ParseTypeTNP(input.c_str());
@@ -851,7 +1116,8 @@ AirspaceParser::Parse(TLineReader &reader, OperationEnvironment &operation)
 
   const long file_size = reader.GetSize();
 
-  TempAirspaceType temp_area;
+  PendingAirspaces pending;
+  TempAirspaceType temp_area(pending);
   AirspaceFileType filetype = AirspaceFileType::UNKNOWN;
 
   TCHAR *line;
@@ -872,15 +1138,19 @@ AirspaceParser::Parse(TLineReader &reader, OperationEnvironment &operation)
 
     // Parse the line
     if (filetype == AirspaceFileType::OPENAIR)
-      if (!ParseLine(airspaces, line, temp_area) &&
-          !ShowParseWarning(line_num, line, operation))
+      if (!ParseLine(line, temp_area) &&
+          !ShowParseWarning(line_num, line, operation)) {
+        pending.Finish(airspaces);
         return false;
+      }
 
     if (filetype == AirspaceFileType::TNP) {
       StringParser<TCHAR> input(line);
-      if (!ParseLineTNP(airspaces, input, temp_area, ignore) &&
-          !ShowParseWarning(line_num, line, operation))
+      if (!ParseLineTNP(input, temp_area, ignore) &&
+          !ShowParseWarning(line_num, line, operation)) {
+        pending.Finish(airspaces);
         return false;
+      }
     }
 
     // Update the ProgressDialog
@@ -894,7 +1164,9 @@ AirspaceParser::Parse(TLineReader &reader, OperationEnvironment &operation)
   }
 
   // Process final area (if any)
-  temp_area.AddPolygon(airspaces);
+  temp_area.AddPolygon();
+
+  pending.Finish(airspaces);
 
   return true;
 }
@@ -0,0 +1,87 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_STATE_HPP
+#define XCSOAR_AIRSPACE_STATE_HPP
+
+#include "AirspaceWarningCopy.hpp"
+#include "Engine/Airspace/AirspacesSnapshot.hpp"
+#include "Engine/Airspace/AirspaceActivity.hpp"
+#include "Engine/Airspace/AirspaceWarningConfig.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Compiler.h"
+
+#include <memory>
+
+/**
+ * An immutable copy of everything the user interface needs to know
+ * about the airspace database: the search trees and the activity and
+ * acknowledgement state of the airspaces.  It is published by
+ * #ProtectedAirspaceWarningManager and read with a
+ * ProtectedAirspaceWarningManager::StateLease, which also protects
+ * the altitudes and activity flags of the airspace objects.
+ */
+struct AirspaceState {
+  std::shared_ptr<const AirspacesSnapshot> airspaces;
+
+  /**
+   * The day of operation this state was calculated for.
+   */
+  AirspaceActivity activity;
+
+  AirspaceWarningConfig config;
+
+  AirspaceWarningCopy warnings;
+
+  /**
+   * Is the airspace active according to this state?  This is the same
+   * as AirspaceWarningManager::IsActive(), but it does not look at
+   * the mutable flags of #AbstractAirspace.
+   */
+  gcc_pure
+  bool IsActive(const AbstractAirspace &airspace) const {
+    return airspace.GetDays().Matches(activity) &&
+      config.IsClassEnabled(airspace.GetType()) &&
+      !warnings.IsAckDay(airspace);
+  }
+};
+
+/**
+ * Match only airspaces that are active according to the given
+ * #AirspaceState.  Unlike #ActiveAirspacePredicate, this does not
+ * lock for each airspace.
+ */
+class AirspaceStateActivePredicate {
+  const AirspaceState &state;
+
+public:
+  explicit AirspaceStateActivePredicate(const AirspaceState &_state)
+    :state(_state) {}
+
+  gcc_pure
+  bool operator()(const AbstractAirspace &airspace) const {
+    return state.IsActive(airspace);
+  }
+};
+
+#endif
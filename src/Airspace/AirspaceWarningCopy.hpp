@@ -34,6 +34,11 @@ class AirspaceWarningCopy
 {
 private:
   StaticArray<const AbstractAirspace *,64> ids_inside, ids_warning, ids_acked;
+
+  /**
+   * Airspaces which have been acknowledged for the whole day.
+   */
+  StaticArray<const AbstractAirspace *,64> ids_ack_day;
   StaticArray<GeoPoint,32> locations;
 
   unsigned serial;
@@ -53,6 +58,9 @@ public:
 
     if (!as.IsAckExpired())
       ids_acked.checked_append(&as.GetAirspace());
+
+    if (as.GetAckDay())
+      ids_ack_day.checked_append(&as.GetAirspace());
   }
 
   void Visit(const AirspaceWarningManager &awm) {
@@ -83,6 +91,10 @@ public:
     return as.IsActive() && Find(as, ids_inside);
   }
 
+  bool IsAckDay(const AbstractAirspace &as) const {
+    return Find(as, ids_ack_day);
+  }
+
 private:
   bool Find(const AbstractAirspace& as,
             const StaticArray<const AbstractAirspace *,64> &list) const {
@@ -24,6 +24,7 @@ Copyright_License {
 #include "NearestAirspace.hpp"
 #include "ProtectedAirspaceWarningManager.hpp"
 #include "Airspace/ActivePredicate.hpp"
+#include "Airspace/AirspaceState.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
 #include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
@@ -54,10 +55,11 @@ struct CompareNearestAirspace {
   }
 };
 
+template<typename Database>
 gcc_pure
 static NearestAirspace
 FindHorizontal(const GeoPoint &location,
-               const Airspaces &airspace_database,
+               const Database &airspace_database,
                const AirspacePredicate &predicate)
 {
   const auto &projection = airspace_database.GetProjection();
@@ -68,60 +70,89 @@ FindHorizontal(const GeoPoint &location,
                      CompareNearestAirspace());
 }
 
+template<typename Database>
 gcc_pure
-NearestAirspace
-NearestAirspace::FindHorizontal(const MoreData &basic,
-                                const ProtectedAirspaceWarningManager &airspace_warnings,
-                                const Airspaces &airspace_database)
+static NearestAirspace
+FindHorizontal(const GeoPoint &location,
+               double min_altitude, double max_altitude,
+               const Database &airspace_database,
+               const AirspacePredicate &predicate)
 {
-  if (!basic.location_available)
-    /* can't check for airspaces without a GPS fix */
-    return NearestAirspace();
+  const auto &projection = airspace_database.GetProjection();
+  return FindMinimum(airspace_database, location, 30000,
+                     min_altitude, max_altitude, predicate,
+                     [&location, &projection](const AbstractAirspace &airspace){
+                       return CalculateNearestAirspaceHorizontal(location, projection, airspace);
+                     },
+                     CompareNearestAirspace());
+}
 
+template<typename Database, typename ActivePredicate>
+gcc_pure
+static NearestAirspace
+FindHorizontal(const MoreData &basic,
+               const Database &airspace_database,
+               const ActivePredicate &active_predicate)
+{
   /* find the nearest airspace */
   //consider only active airspaces
   const auto outside_and_active =
-    MakeAndPredicate(ActiveAirspacePredicate(&airspace_warnings),
+    MakeAndPredicate(active_predicate,
                      OutsideAirspacePredicate(AGeoPoint(basic.location, 0)));
 
   //if altitude is available, filter airspaces in same height as airplane
   if (basic.NavAltitudeAvailable()) {
     /* check altitude; hard-coded margin of 50m (for now) */
+    const auto min_altitude = basic.nav_altitude - 50;
+    const auto max_altitude = basic.nav_altitude + 50;
     const auto outside_and_active_and_height =
       MakeAndPredicate(outside_and_active,
-                       AirspacePredicateHeightRange(basic.nav_altitude - 50,
-                                                    basic.nav_altitude + 50));
+                       AirspacePredicateHeightRange(min_altitude,
+                                                    max_altitude));
     const auto predicate = WrapAirspacePredicate(outside_and_active_and_height);
-    return ::FindHorizontal(basic.location, airspace_database, predicate);
+    return FindHorizontal(basic.location, min_altitude, max_altitude,
+                          airspace_database, predicate);
   } else {
     /* only filter outside and active */
     const auto predicate = WrapAirspacePredicate(outside_and_active);
-    return ::FindHorizontal(basic.location, airspace_database, predicate);
+    return FindHorizontal(basic.location, airspace_database, predicate);
   }
 }
 
 gcc_pure
 NearestAirspace
-NearestAirspace::FindVertical(const MoreData &basic,
-                      const DerivedInfo &calculated,
-                      const ProtectedAirspaceWarningManager &airspace_warnings,
-                      const Airspaces &airspace_database)
+NearestAirspace::FindHorizontal(const MoreData &basic,
+                                const ProtectedAirspaceWarningManager &airspace_warnings,
+                                const Airspaces &airspace_database)
 {
-  if (!basic.location_available ||
-      (!basic.baro_altitude_available && !basic.gps_altitude_available))
-    /* can't check for airspaces without a GPS fix and altitude
-       value */
+  if (!basic.location_available)
+    /* can't check for airspaces without a GPS fix */
     return NearestAirspace();
 
-  /* find the nearest airspace */
+  /* prefer the state published by the calculation thread, which
+     needs only one lease instead of one per airspace */
+  const ProtectedAirspaceWarningManager::StateLease state(airspace_warnings);
+  if (state.IsDefined())
+    return ::FindHorizontal(basic, *state->airspaces,
+                            AirspaceStateActivePredicate(*state));
+
+  return ::FindHorizontal(basic, airspace_database,
+                          ActiveAirspacePredicate(&airspace_warnings));
+}
 
+template<typename Database, typename ActivePredicate>
+gcc_pure
+static NearestAirspace
+FindVertical(const MoreData &basic, const DerivedInfo &calculated,
+             const Database &airspace_database,
+             const ActivePredicate &active_predicate)
+{
   AltitudeState altitude;
   altitude.altitude = basic.nav_altitude;
   altitude.altitude_agl = calculated.altitude_agl;
 
   const AbstractAirspace *nearest = nullptr;
   double nearest_delta = 100000;
-  const ActiveAirspacePredicate active_predicate(&airspace_warnings);
 
   for (const auto &i : airspace_database.QueryInside(basic.location)) {
     const AbstractAirspace &airspace = i.GetAirspace();
@@ -151,3 +182,27 @@ NearestAirspace::FindVertical(const MoreData &basic,
 
   return NearestAirspace(*nearest, nearest_delta);
 }
+
+gcc_pure
+NearestAirspace
+NearestAirspace::FindVertical(const MoreData &basic,
+                      const DerivedInfo &calculated,
+                      const ProtectedAirspaceWarningManager &airspace_warnings,
+                      const Airspaces &airspace_database)
+{
+  if (!basic.location_available ||
+      (!basic.baro_altitude_available && !basic.gps_altitude_available))
+    /* can't check for airspaces without a GPS fix and altitude
+       value */
+    return NearestAirspace();
+
+  /* find the nearest airspace */
+
+  const ProtectedAirspaceWarningManager::StateLease state(airspace_warnings);
+  if (state.IsDefined())
+    return ::FindVertical(basic, calculated, *state->airspaces,
+                          AirspaceStateActivePredicate(*state));
+
+  return ::FindVertical(basic, calculated, airspace_database,
+                        ActiveAirspacePredicate(&airspace_warnings));
+}
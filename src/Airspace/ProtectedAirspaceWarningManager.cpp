@@ -22,6 +22,38 @@
 
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
 #include "Airspace/AirspaceWarningManager.hpp"
+#include "Airspace/AirspaceState.hpp"
+
+ProtectedAirspaceWarningManager::ProtectedAirspaceWarningManager(AirspaceWarningManager &awm)
+  :Guard<AirspaceWarningManager>(awm) {}
+
+ProtectedAirspaceWarningManager::~ProtectedAirspaceWarningManager() = default;
+
+void
+ProtectedAirspaceWarningManager::Republish(const AirspaceWarningManager &awm)
+{
+  if (airspaces == nullptr)
+    /* nothing to publish yet */
+    return;
+
+  AirspaceState *new_state = new AirspaceState();
+  new_state->airspaces = airspaces;
+  new_state->activity = activity;
+  new_state->config = awm.GetConfig();
+  new_state->warnings.Visit(awm);
+
+  state.Publish(new_state);
+}
+
+void
+ProtectedAirspaceWarningManager::Publish(std::shared_ptr<const AirspacesSnapshot> _airspaces,
+                                         AirspaceActivity _activity)
+{
+  ExclusiveLease lease(*this);
+  airspaces = std::move(_airspaces);
+  activity = _activity;
+  Republish(lease);
+}
 
 const FlatProjection &
 ProtectedAirspaceWarningManager::GetProjection() const
@@ -36,6 +68,7 @@ ProtectedAirspaceWarningManager::Clear()
 {
   ExclusiveLease lease(*this);
   lease->clear();
+  Republish(lease);
 }
 
 void
@@ -43,6 +76,7 @@ ProtectedAirspaceWarningManager::AcknowledgeAll()
 {
   ExclusiveLease lease(*this);
   lease->AcknowledgeAll();
+  Republish(lease);
 }
 
 bool
@@ -65,6 +99,7 @@ ProtectedAirspaceWarningManager::AcknowledgeDay(const AbstractAirspace &airspace
 {
   ExclusiveLease lease(*this);
   lease->AcknowledgeDay(airspace, set);
+  Republish(lease);
 }
 
 void
@@ -73,6 +108,7 @@ ProtectedAirspaceWarningManager::AcknowledgeWarning(const AbstractAirspace &airs
 {
   ExclusiveLease lease(*this);
   lease->AcknowledgeWarning(airspace, set);
+  Republish(lease);
 }
 
 void
@@ -81,6 +117,7 @@ ProtectedAirspaceWarningManager::AcknowledgeInside(const AbstractAirspace &airsp
 {
   ExclusiveLease lease(*this);
   lease->AcknowledgeInside(airspace, set);
+  Republish(lease);
 }
 
 void
@@ -88,4 +125,5 @@ ProtectedAirspaceWarningManager::Acknowledge(const AbstractAirspace &airspace)
 {
   ExclusiveLease lease(*this);
   lease->Acknowledge(airspace);
+  Republish(lease);
 }
@@ -24,16 +24,64 @@
 #define XCSOAR_PROTECTED_AIRSPACE_WARNING_MANAGER_HPP
 
 #include "Thread/Guard.hpp"
+#include "Thread/RcuPointer.hpp"
+#include "Engine/Airspace/AirspaceActivity.hpp"
 #include "Compiler.h"
 
+#include <memory>
+
 class AirspaceWarningManager;
+class AirspacesSnapshot;
 class AbstractAirspace;
 class FlatProjection;
+struct AirspaceState;
 
 class ProtectedAirspaceWarningManager : public Guard<AirspaceWarningManager> {
+  /**
+   * The most recently published #AirspaceState.  Readers obtain it
+   * with a #StateLease.
+   */
+  RcuPointer<AirspaceState> state;
+
+  /* the following attributes are protected by the mutex; they are
+     remembered for republishing the state after an acknowledgement */
+
+  std::shared_ptr<const AirspacesSnapshot> airspaces;
+  AirspaceActivity activity;
+
 public:
-  ProtectedAirspaceWarningManager(AirspaceWarningManager &awm):
-    Guard<AirspaceWarningManager>(awm) {}
+  /* the constructor and the destructor are not inline because they
+     need the complete #AirspaceState definition */
+  ProtectedAirspaceWarningManager(AirspaceWarningManager &awm);
+  ~ProtectedAirspaceWarningManager();
+
+  /**
+   * Read access to the published #AirspaceState.  Check IsDefined()
+   * before using it: nothing has been published before the first
+   * calculation cycle.
+   *
+   * The search trees and the warnings in the state are immutable, but
+   * the #AbstractAirspace objects they refer to are not: their
+   * altitudes and activity flags are updated in place while the
+   * calculation thread holds the mutex.  Therefore this also holds a
+   * shared lease for as long as it exists.
+   */
+  class StateLease : Lease, public RcuPointer<AirspaceState>::ReadGuard {
+  public:
+    explicit StateLease(const ProtectedAirspaceWarningManager &awm)
+      :Lease(awm), RcuPointer<AirspaceState>::ReadGuard(awm.state) {}
+
+    using RcuPointer<AirspaceState>::ReadGuard::operator->;
+  };
+
+  /**
+   * Publish a new #AirspaceState consisting of the given snapshot,
+   * the current warnings and the given day of operation.  To be
+   * called by the calculation thread after each update; the caller
+   * must not hold a lease.
+   */
+  void Publish(std::shared_ptr<const AirspacesSnapshot> _airspaces,
+               AirspaceActivity _activity);
 
   gcc_pure
   const FlatProjection &GetProjection() const;
@@ -53,6 +101,13 @@ public:
 
   gcc_pure
   bool IsEmpty() const;
+
+private:
+  /**
+   * Publish the current warnings together with the most recent
+   * snapshot.  The caller must hold an exclusive lease.
+   */
+  void Republish(const AirspaceWarningManager &awm);
 };
 
 
@@ -62,6 +62,7 @@ Copyright_License {
 #include "IO/Async/GlobalAsioThread.hpp"
 #include "IO/Async/AsioThread.hpp"
 #include "Thread/Debug.hpp"
+#include "Thread/WorkerPool.hpp"
 
 #include "IOIOHelper.hpp"
 #include "NativeBMP085Listener.hpp"
@@ -123,6 +124,7 @@ Java_org_xcsoar_NativeView_initializeNative(JNIEnv *env, jobject obj,
   InitThreadDebug();
 
   InitialiseAsioThread();
+  WorkerPool::InitialiseShared();
 
   Java::Init(env);
   Java::Object::Initialise(env);
@@ -261,6 +263,7 @@ Java_org_xcsoar_NativeView_deinitializeNative(JNIEnv *env, jobject obj)
   NativeView::Deinitialise(env);
   Java::URL::Deinitialise(env);
 
+  WorkerPool::DeinitialiseShared();
   DeinitialiseAsioThread();
 }
 
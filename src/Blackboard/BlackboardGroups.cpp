@@ -0,0 +1,252 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "BlackboardGroups.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "Util/StaticArray.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <type_traits>
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+static_assert(std::is_trivially_copyable<MoreData>::value,
+              "MoreData cannot be copied in groups");
+static_assert(std::is_trivially_copyable<DerivedInfo>::value,
+              "DerivedInfo cannot be copied in groups");
+
+namespace {
+
+/**
+ * A range of bytes within a blackboard struct.
+ */
+struct Segment {
+  size_t offset, size;
+  unsigned group;
+};
+
+/**
+ * The segments of a blackboard struct, sorted by offset, covering
+ * the whole struct.
+ */
+typedef StaticArray<Segment, 2 * BlackboardGroups::MAX_GROUPS + 1> Layout;
+
+/**
+ * Build a #Layout from the segments of the members which have a group
+ * of their own: sort them and fill the gaps between them with group
+ * 0.
+ */
+Layout
+MakeLayout(size_t object_size, std::initializer_list<Segment> members)
+{
+  StaticArray<Segment, BlackboardGroups::MAX_GROUPS> groups;
+  for (const auto &i : members) {
+    assert(i.offset + i.size <= object_size);
+    groups.push_back(i);
+  }
+
+  std::sort(groups.begin(), groups.end(),
+            [](const Segment &a, const Segment &b){
+              return a.offset < b.offset;
+            });
+
+  Layout layout;
+  size_t position = 0;
+  for (const auto &i : groups) {
+    assert(i.offset >= position);
+
+    if (i.offset > position)
+      layout.push_back({position, i.offset - position, 0});
+
+    layout.push_back(i);
+    position = i.offset + i.size;
+  }
+
+  if (position < object_size)
+    layout.push_back({position, object_size - position, 0});
+
+  return layout;
+}
+
+}
+
+/* the blackboard structs are not standard-layout because they inherit
+   attributes from several base structs, but they have no virtual base
+   classes, so offsetof() works with all supported compilers */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+#define MEMBER_SEGMENT(type, member, group) \
+  Segment{offsetof(type, member), sizeof(type::member), group}
+
+/* these are initialised before main() and therefore before any
+   thread can use them */
+
+static const Layout more_data_layout =
+  MakeLayout(sizeof(MoreData), {
+      MEMBER_SEGMENT(MoreData, flarm, BlackboardGroups::MORE_DATA_FLARM),
+    });
+
+static const Layout derived_info_layout =
+  MakeLayout(sizeof(DerivedInfo), {
+      MEMBER_SEGMENT(DerivedInfo, climb_history,
+                     BlackboardGroups::DERIVED_CLIMB_HISTORY),
+      MEMBER_SEGMENT(DerivedInfo, wave,
+                     BlackboardGroups::DERIVED_WAVE),
+      MEMBER_SEGMENT(DerivedInfo, task_stats,
+                     BlackboardGroups::DERIVED_TASK_STATS),
+      MEMBER_SEGMENT(DerivedInfo, ordered_task_stats,
+                     BlackboardGroups::DERIVED_ORDERED_TASK_STATS),
+      MEMBER_SEGMENT(DerivedInfo, common_stats,
+                     BlackboardGroups::DERIVED_COMMON_STATS),
+      MEMBER_SEGMENT(DerivedInfo, contest_stats,
+                     BlackboardGroups::DERIVED_CONTEST_STATS),
+      MEMBER_SEGMENT(DerivedInfo, thermal_encounter_band,
+                     BlackboardGroups::DERIVED_THERMAL_ENCOUNTER_BAND),
+      MEMBER_SEGMENT(DerivedInfo, thermal_encounter_collection,
+                     BlackboardGroups::DERIVED_THERMAL_ENCOUNTER_COLLECTION),
+      MEMBER_SEGMENT(DerivedInfo, thermal_locator,
+                     BlackboardGroups::DERIVED_THERMAL_LOCATOR),
+      MEMBER_SEGMENT(DerivedInfo, trace_history,
+                     BlackboardGroups::DERIVED_TRACE_HISTORY),
+      MEMBER_SEGMENT(DerivedInfo, planned_route,
+                     BlackboardGroups::DERIVED_PLANNED_ROUTE),
+    });
+
+#undef MEMBER_SEGMENT
+#pragma GCC diagnostic pop
+
+static std::atomic<uint32_t> copied_bytes;
+
+static inline const Layout &
+GetLayout(const MoreData &)
+{
+  return more_data_layout;
+}
+
+static inline const Layout &
+GetLayout(const DerivedInfo &)
+{
+  return derived_info_layout;
+}
+
+template<typename T>
+static BlackboardGroups::Mask
+CompareT(const T &a, const T &b)
+{
+  const char *const p = (const char *)&a, *const q = (const char *)&b;
+
+  BlackboardGroups::Mask result = 0;
+  for (const auto &i : GetLayout(a))
+    if (memcmp(p + i.offset, q + i.offset, i.size) != 0)
+      result |= BlackboardGroups::ToMask(i.group);
+
+  return result;
+}
+
+template<typename T>
+static void
+CopyT(T &dest, const T &src, BlackboardGroups::Mask groups)
+{
+  char *const p = (char *)&dest;
+  const char *const q = (const char *)&src;
+
+  size_t n = 0;
+  for (const auto &i : GetLayout(dest)) {
+    if (groups & BlackboardGroups::ToMask(i.group)) {
+      memcpy(p + i.offset, q + i.offset, i.size);
+      n += i.size;
+    }
+  }
+
+  copied_bytes.fetch_add(n, std::memory_order_relaxed);
+}
+
+template<typename T>
+static BlackboardGroups::Mask
+UpdateT(T &dest, const T &src)
+{
+  char *const p = (char *)&dest;
+  const char *const q = (const char *)&src;
+
+  BlackboardGroups::Mask result = 0;
+  size_t n = 0;
+  for (const auto &i : GetLayout(dest)) {
+    if (memcmp(p + i.offset, q + i.offset, i.size) != 0) {
+      memcpy(p + i.offset, q + i.offset, i.size);
+      result |= BlackboardGroups::ToMask(i.group);
+      n += i.size;
+    }
+  }
+
+  copied_bytes.fetch_add(n, std::memory_order_relaxed);
+  return result;
+}
+
+BlackboardGroups::Mask
+BlackboardGroups::Compare(const MoreData &a, const MoreData &b)
+{
+  return CompareT(a, b);
+}
+
+BlackboardGroups::Mask
+BlackboardGroups::Compare(const DerivedInfo &a, const DerivedInfo &b)
+{
+  return CompareT(a, b);
+}
+
+void
+BlackboardGroups::Copy(MoreData &dest, const MoreData &src, Mask groups)
+{
+  CopyT(dest, src, groups);
+}
+
+void
+BlackboardGroups::Copy(DerivedInfo &dest, const DerivedInfo &src,
+                       Mask groups)
+{
+  CopyT(dest, src, groups);
+}
+
+BlackboardGroups::Mask
+BlackboardGroups::Update(MoreData &dest, const MoreData &src)
+{
+  return UpdateT(dest, src);
+}
+
+BlackboardGroups::Mask
+BlackboardGroups::Update(DerivedInfo &dest, const DerivedInfo &src)
+{
+  return UpdateT(dest, src);
+}
+
+uint32_t
+BlackboardGroups::GetCopiedBytes()
+{
+  return copied_bytes.load(std::memory_order_relaxed);
+}
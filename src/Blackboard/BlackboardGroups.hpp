@@ -0,0 +1,154 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_BLACKBOARD_GROUPS_HPP
+#define XCSOAR_BLACKBOARD_GROUPS_HPP
+
+#include "Compiler.h"
+
+#include <stdint.h>
+
+struct MoreData;
+struct DerivedInfo;
+
+/**
+ * Compare and copy the blackboard structs #MoreData and #DerivedInfo
+ * in groups of attributes.  The large attributes which change less
+ * often than the rest (e.g. FLARM traffic, the contest statistics or
+ * the thermal band) have a group of their own; all other attributes
+ * are in group 0.  This allows copying only the groups which have
+ * changed, instead of copying kilobytes on each update.
+ */
+namespace BlackboardGroups {
+  /**
+   * A bit mask of groups.
+   */
+  typedef uint32_t Mask;
+
+  static constexpr unsigned MAX_GROUPS = 16;
+  static constexpr Mask ALL = (Mask(1) << MAX_GROUPS) - 1;
+
+  enum MoreDataGroup : unsigned {
+    MORE_DATA_MISC,
+    MORE_DATA_FLARM,
+  };
+
+  enum DerivedInfoGroup : unsigned {
+    DERIVED_MISC,
+    DERIVED_CLIMB_HISTORY,
+    DERIVED_WAVE,
+    DERIVED_TASK_STATS,
+    DERIVED_ORDERED_TASK_STATS,
+    DERIVED_COMMON_STATS,
+    DERIVED_CONTEST_STATS,
+    DERIVED_THERMAL_ENCOUNTER_BAND,
+    DERIVED_THERMAL_ENCOUNTER_COLLECTION,
+    DERIVED_THERMAL_LOCATOR,
+    DERIVED_TRACE_HISTORY,
+    DERIVED_PLANNED_ROUTE,
+  };
+
+  constexpr Mask
+  ToMask(unsigned group)
+  {
+    return Mask(1) << group;
+  }
+
+  /**
+   * Determine which groups differ between the two objects.
+   */
+  gcc_pure
+  Mask Compare(const MoreData &a, const MoreData &b);
+
+  gcc_pure
+  Mask Compare(const DerivedInfo &a, const DerivedInfo &b);
+
+  /**
+   * Copy the specified groups.
+   */
+  void Copy(MoreData &dest, const MoreData &src, Mask groups);
+  void Copy(DerivedInfo &dest, const DerivedInfo &src, Mask groups);
+
+  /**
+   * Copy all groups which differ.  This is equivalent to "dest=src",
+   * but writes only what has changed.
+   *
+   * @return the groups which were copied
+   */
+  Mask Update(MoreData &dest, const MoreData &src);
+  Mask Update(DerivedInfo &dest, const DerivedInfo &src);
+
+  /**
+   * Returns the number of bytes copied by the functions above (in
+   * all threads), for instrumentation.  The counter wraps around;
+   * calculate rates from the (unsigned) difference of two values.
+   */
+  gcc_pure
+  uint32_t GetCopiedBytes();
+}
+
+/**
+ * A change serial for each group of a blackboard struct (see
+ * #BlackboardGroups).  The writer increments the serials of the
+ * groups it modifies; a reader remembers the serials of the last
+ * version it has copied, and copies only the groups which have
+ * changed since.
+ */
+class BlackboardSerials {
+  uint32_t serials[BlackboardGroups::MAX_GROUPS];
+
+public:
+  /**
+   * Initialise all serials with zero.  The writer never uses this
+   * value, i.e. a reader in this state will copy everything.
+   */
+  BlackboardSerials() {
+    Invalidate(BlackboardGroups::ALL);
+  }
+
+  void Invalidate(BlackboardGroups::Mask groups) {
+    for (unsigned i = 0; i < BlackboardGroups::MAX_GROUPS; ++i)
+      if (groups & BlackboardGroups::ToMask(i))
+        serials[i] = 0;
+  }
+
+  void Increment(BlackboardGroups::Mask groups) {
+    for (unsigned i = 0; i < BlackboardGroups::MAX_GROUPS; ++i)
+      if ((groups & BlackboardGroups::ToMask(i)) && ++serials[i] == 0)
+        serials[i] = 1;
+  }
+
+  /**
+   * Determine which groups have different serials.
+   */
+  gcc_pure
+  BlackboardGroups::Mask Compare(const BlackboardSerials &other) const {
+    BlackboardGroups::Mask result = 0;
+    for (unsigned i = 0; i < BlackboardGroups::MAX_GROUPS; ++i)
+      if (serials[i] != other.serials[i])
+        result |= BlackboardGroups::ToMask(i);
+    return result;
+  }
+};
+
+#endif
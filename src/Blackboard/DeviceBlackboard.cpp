@@ -38,6 +38,7 @@ DeviceBlackboard::DeviceBlackboard()
   // Clear the gps_info and calculated_info
   gps_info.Reset();
   calculated_info.Reset();
+  calculated_serials.Increment(BlackboardGroups::ALL);
 
   // Set GPS assumed time to system time
   gps_info.UpdateClock();
@@ -172,16 +173,33 @@ DeviceBlackboard::SetAltitude(double val)
   ScheduleMerge();
 }
 
-/**
- * Reads the given derived_info usually provided by the
- * GlideComputerBlackboard and saves it to the own Blackboard
- * @param derived_info Calculated information usually provided
- * by the GlideComputerBlackboard
- */
 void
-DeviceBlackboard::ReadBlackboard(const DerivedInfo &derived_info)
+DeviceBlackboard::PublishCalculated(const DerivedInfo &derived_info)
 {
-  calculated_info = derived_info;
+  /* nobody else modifies calculated_info, therefore it may be
+     compared without holding the lock */
+  const BlackboardGroups::Mask changed =
+    BlackboardGroups::Compare(calculated_info, derived_info);
+
+  if (changed != 0) {
+    ScopeLock protect(mutex);
+    BlackboardGroups::Copy(calculated_info, derived_info, changed);
+    calculated_serials.Increment(changed);
+  } else if (calculated_snapshot.IsDefined())
+    /* the current snapshot is up to date */
+    return;
+
+  /* update the snapshot buffer; it is a recycled older snapshot, so
+     only the groups which have changed since need to be copied */
+  VersionedDerivedInfo *snapshot = next_calculated_snapshot.release();
+  if (snapshot == nullptr)
+    snapshot = new VersionedDerivedInfo();
+
+  BlackboardGroups::Copy(snapshot->info, derived_info,
+                         snapshot->serials.Compare(calculated_serials));
+  snapshot->serials = calculated_serials;
+
+  next_calculated_snapshot.reset(calculated_snapshot.PublishAndRecycle(snapshot));
 }
 
 /**
@@ -26,11 +26,15 @@ Copyright_License {
 
 #include "Blackboard/BaseBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
+#include "Blackboard/BlackboardGroups.hpp"
+#include "Blackboard/VersionedDerivedInfo.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/RcuPointer.hpp"
 #include "Time/WrapClock.hpp"
 
+#include <memory>
 #include <cassert>
 
 class MultipleDevices;
@@ -79,6 +83,24 @@ class DeviceBlackboard
    */
   WrapClock real_clock, replay_clock;
 
+  /**
+   * The serials of the groups of #calculated_info.  Only
+   * PublishCalculated() modifies them, with the mutex locked.
+   */
+  BlackboardSerials calculated_serials;
+
+  /**
+   * A copy of #calculated_info which can be read without locking the
+   * blackboard, see #CalculatedLease.
+   */
+  RcuPointer<VersionedDerivedInfo> calculated_snapshot;
+
+  /**
+   * A replaced #calculated_snapshot which will be updated and
+   * published by the next PublishCalculated() call.
+   */
+  std::unique_ptr<VersionedDerivedInfo> next_calculated_snapshot;
+
 public:
   Mutex mutex;
 
@@ -91,9 +113,30 @@ public:
     devices = &_devices;
   }
 
-  void ReadBlackboard(const DerivedInfo &derived_info);
+  /**
+   * Copy the results of the #GlideComputer to Calculated() and to the
+   * snapshot read by #CalculatedLease.  Only the groups which have
+   * changed are copied, and the blackboard is locked only while
+   * doing that; the caller must not hold the lock.
+   *
+   * Only the calculation thread (and the initialisation code before
+   * it is started) may call this method, because it reads
+   * Calculated() without holding the lock.
+   */
+  void PublishCalculated(const DerivedInfo &derived_info);
+
   void ReadComputerSettings(const ComputerSettings &settings);
 
+  /**
+   * Read access to the most recent calculated data without locking
+   * the blackboard.  Don't keep it longer than necessary.
+   */
+  class CalculatedLease : public RcuPointer<VersionedDerivedInfo>::ReadGuard {
+  public:
+    explicit CalculatedLease(const DeviceBlackboard &blackboard)
+      :RcuPointer<VersionedDerivedInfo>::ReadGuard(blackboard.calculated_snapshot) {}
+  };
+
 protected:
   NMEAInfo &SetBasic() { return gps_info; }
   MoreData &SetMoreData() { return gps_info; }
@@ -21,17 +21,27 @@ Copyright_License {
 }
 */
 #include "InterfaceBlackboard.hpp"
+#include "VersionedDerivedInfo.hpp"
 
 void
 InterfaceBlackboard::ReadBlackboardCalculated(const DerivedInfo &derived_info)
 {
   calculated_info = derived_info;
+  calculated_serials.Invalidate(BlackboardGroups::ALL);
+}
+
+void
+InterfaceBlackboard::ReadBlackboardCalculated(const VersionedDerivedInfo &derived_info)
+{
+  BlackboardGroups::Copy(calculated_info, derived_info.info,
+                         calculated_serials.Compare(derived_info.serials));
+  calculated_serials = derived_info.serials;
 }
 
 void
 InterfaceBlackboard::ReadBlackboardBasic(const MoreData &nmea_info)
 {
-  gps_info = nmea_info;
+  BlackboardGroups::Update(gps_info, nmea_info);
 }
 
 void
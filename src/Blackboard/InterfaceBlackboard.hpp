@@ -25,14 +25,28 @@ Copyright_License {
 #define INTERFACE_BLACKBOARD_H
 
 #include "LiveBlackboard.hpp"
+#include "BlackboardGroups.hpp"
 #include "Compiler.h"
 
+struct VersionedDerivedInfo;
+
 class InterfaceBlackboard : public LiveBlackboard
 {
+  /**
+   * The serials of the #DerivedInfo groups last copied to
+   * #calculated_info.
+   */
+  BlackboardSerials calculated_serials;
+
 public:
   void ReadBlackboardBasic(const MoreData &nmea_info);
   void ReadBlackboardCalculated(const DerivedInfo &derived_info);
 
+  /**
+   * Copy the groups which have changed since the last call.
+   */
+  void ReadBlackboardCalculated(const VersionedDerivedInfo &derived_info);
+
   gcc_const
   SystemSettings &SetSystemSettings() {
     return system_settings;
@@ -50,6 +64,10 @@ public:
 
   inline void ReadCommonStats(const CommonStats &common_stats) {
     calculated_info.common_stats = common_stats;
+
+    /* the next ReadBlackboardCalculated() call shall overwrite it */
+    using namespace BlackboardGroups;
+    calculated_serials.Invalidate(ToMask(DERIVED_COMMON_STATS));
   }
 
   void ReadComputerSettings(const ComputerSettings &settings);
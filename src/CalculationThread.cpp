@@ -28,6 +28,11 @@ Copyright_License {
 #include "Components.hpp"
 #include "Hardware/CPU.hpp"
 
+#ifndef NDEBUG
+#include "Blackboard/BlackboardGroups.hpp"
+#include "LogFile.hpp"
+#endif
+
 /**
  * Constructor of the CalculationThread class
  * @param _glide_computer The GlideComputer used for the CalculationThread
@@ -36,6 +41,10 @@ CalculationThread::CalculationThread(GlideComputer &_glide_computer)
   :WorkerThread("CalcThread", 450, 100, 50),
    force(false),
    glide_computer(_glide_computer) {
+#ifndef NDEBUG
+  copy_rate_clock.Update();
+  copy_rate_bytes = BlackboardGroups::GetCopiedBytes();
+#endif
 }
 
 void
@@ -98,10 +107,7 @@ CalculationThread::Tick()
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
-  {
-    ScopeLock protect(device_blackboard->mutex);
-    device_blackboard->ReadBlackboard(glide_computer.Calculated());
-  }
+  device_blackboard->PublishCalculated(glide_computer.Calculated());
 
   // if (new GPS data)
   if (gps_updated || force)
@@ -112,6 +118,17 @@ CalculationThread::Tick()
     // do slow calculations last, to minimise latency
     glide_computer.ProcessIdle();
   }
+
+#ifndef NDEBUG
+  const int elapsed = copy_rate_clock.Elapsed();
+  if (elapsed >= 60000) {
+    const uint32_t bytes = BlackboardGroups::GetCopiedBytes();
+    LogDebug("Blackboard: %u bytes/s copied",
+             unsigned(uint64_t(bytes - copy_rate_bytes) * 1000 / elapsed));
+    copy_rate_bytes = bytes;
+    copy_rate_clock.Update();
+  }
+#endif
 }
 
 void
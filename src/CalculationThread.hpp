@@ -28,6 +28,12 @@ Copyright_License {
 #include "Thread/Mutex.hpp"
 #include "Computer/Settings.hpp"
 
+#ifndef NDEBUG
+#include "Time/PeriodClock.hpp"
+
+#include <stdint.h>
+#endif
+
 class GlideComputer;
 
 /**
@@ -56,6 +62,15 @@ class CalculationThread final : public WorkerThread {
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+#ifndef NDEBUG
+  /**
+   * For logging the number of bytes copied between the blackboards
+   * per second, see BlackboardGroups::GetCopiedBytes().
+   */
+  PeriodClock copy_rate_clock;
+  uint32_t copy_rate_bytes;
+#endif
+
 public:
   CalculationThread(GlideComputer &_glide_computer);
 
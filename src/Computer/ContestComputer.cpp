@@ -24,12 +24,83 @@ Copyright_License {
 #include "ContestComputer.hpp"
 #include "Engine/Contest/Settings.hpp"
 
+/**
+ * Copy the trace if it was modified since the last copy.
+ */
+static void
+CopyTrace(Trace &dest, const Trace &src)
+{
+  if (dest.GetAppendSerial() != src.GetAppendSerial() ||
+      dest.GetModifySerial() != src.GetModifySerial())
+    dest.CopyFrom(src);
+}
+
 ContestComputer::ContestComputer(const Trace &trace_full,
                                  const Trace &trace_triangle,
                                  const Trace &trace_sprint)
-  :contest_manager(Contest::OLC_SPRINT, trace_full, trace_triangle, trace_sprint, true)
+  :StandbyThread("Contest"),
+   live_full(trace_full),
+   live_triangle(trace_triangle),
+   live_sprint(trace_sprint),
+   next_full(0, Trace::null_time, trace_full.GetMaxSize()),
+   next_triangle(0, Trace::null_time, trace_triangle.GetMaxSize()),
+   next_sprint(0, Trace::null_time, trace_sprint.GetMaxSize()),
+   full(0, Trace::null_time, trace_full.GetMaxSize()),
+   triangle(0, Trace::null_time, trace_triangle.GetMaxSize()),
+   sprint(0, Trace::null_time, trace_sprint.GetMaxSize()),
+   contest_manager(Contest::OLC_SPRINT, full, triangle, sprint, true),
+   pool(2)
 {
   contest_manager.SetIncremental(true);
+
+  /* let each UpdateIdle() call search for up to 20 ms before checking
+     for new data */
+  contest_manager.SetTimeBudget(20000);
+  contest_manager.SetParallel([this](unsigned n,
+                                     const std::function<void(unsigned)> &f){
+      pool.Run(n, f);
+    });
+}
+
+void
+ContestComputer::Reset()
+{
+  const ScopeLock protect(mutex);
+  reset = true;
+  new_data = true;
+  stats.Reset();
+}
+
+void
+ContestComputer::UpdateSnapshot(const ContestSettings &settings)
+{
+  CopyTrace(next_full, live_full);
+  CopyTrace(next_triangle, live_triangle);
+  CopyTrace(next_sprint, live_sprint);
+
+  next_contest = settings.contest;
+  next_handicap = settings.handicap;
+  new_data = true;
+}
+
+void
+ContestComputer::ApplySnapshot()
+{
+  if (reset) {
+    reset = false;
+    contest_manager.Reset();
+  }
+
+  CopyTrace(full, next_full);
+  CopyTrace(triangle, next_triangle);
+  CopyTrace(sprint, next_sprint);
+
+  contest_manager.SetIncremental(next_incremental);
+  contest_manager.SetContest(next_contest);
+  contest_manager.SetHandicap(next_handicap);
+  contest_manager.SetPredicted(next_predicted);
+
+  new_data = false;
 }
 
 void
@@ -39,12 +110,11 @@ ContestComputer::Solve(const ContestSettings &settings,
   if (!settings.enable)
     return;
 
-  contest_manager.SetHandicap(settings.handicap);
-  contest_manager.SetContest(settings.contest);
+  const ScopeLock protect(mutex);
+  UpdateSnapshot(settings);
+  Trigger();
 
-  contest_manager.UpdateIdle();
-
-  contest_stats = contest_manager.GetStats();
+  contest_stats = stats;
 }
 
 bool
@@ -54,12 +124,49 @@ ContestComputer::SolveExhaustive(const ContestSettings &settings,
   if (!settings.enable)
     return false;
 
-  contest_manager.SetHandicap(settings.handicap);
-  contest_manager.SetContest(settings.contest);
+  bool result;
+
+  {
+    const ScopeLock protect(mutex);
 
-  bool result = contest_manager.SolveExhaustive();
+    /* cancel the thread and wait for it, so the solvers can be used
+       by this thread */
+    UpdateSnapshot(settings);
+    WaitDone();
+    ApplySnapshot();
+  }
 
-  contest_stats = contest_manager.GetStats();
+  /* the thread is idle, and only this thread can trigger it */
+  result = contest_manager.SolveExhaustive();
+
+  const ScopeLock protect(mutex);
+  stats = contest_manager.GetStats();
+  contest_stats = stats;
 
   return result;
 }
+
+void
+ContestComputer::Tick()
+{
+  SetLowPriority();
+
+  ApplySnapshot();
+
+  do {
+    {
+      const ScopeUnlock unlock(mutex);
+      contest_manager.UpdateIdle();
+    }
+
+    /* publish the results, unless they have been invalidated by
+       Reset() meanwhile */
+    if (!reset)
+      stats = contest_manager.GetStats();
+
+    /* keep optimising until there is a new snapshot which
+       invalidates the current search; the solvers continue
+       incrementally in the next run */
+  } while (!new_data && !IsStopped() && !reset &&
+           contest_manager.IsSolving());
+}
@@ -25,39 +25,129 @@ Copyright_License {
 #define XCSOAR_CONTEST_COMPUTER_HPP
 
 #include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Contest/ContestStatistics.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Thread/StandbyThread.hpp"
+#include "Thread/WorkerPool.hpp"
 
 struct ContestSettings;
-struct ContestStatistics;
-class Trace;
 
-class ContestComputer {
+/**
+ * Runs the contest solvers in a background thread, so long
+ * optimisations do not delay the #CalculationThread.  Solvers which
+ * do not depend on each other run in parallel on a #WorkerPool.
+ *
+ * The solvers work on snapshots of the traces, which are copied
+ * while the thread is not using them.  The results are published
+ * in one piece under the mutex.
+ */
+class ContestComputer final : private StandbyThread {
+  /**
+   * The traces owned by the #TraceComputer.  They may only be
+   * accessed by the #CalculationThread.
+   */
+  const Trace &live_full, &live_triangle, &live_sprint;
+
+  /**
+   * Protected by the mutex: the latest snapshot of the traces and
+   * the parameters for the next solver run.
+   */
+  Trace next_full, next_triangle, next_sprint;
+  Contest next_contest = Contest::OLC_SPRINT;
+  unsigned next_handicap = 100;
+  TracePoint next_predicted = TracePoint::Invalid();
+  bool next_incremental = true;
+
+  /**
+   * Shall the #ContestManager be reset before the next run?
+   * Protected by the mutex.
+   */
+  bool reset = false;
+
+  /**
+   * Has a new snapshot arrived since the thread copied the last one?
+   * This cancels an incomplete optimisation, which will then be
+   * continued with the new data.  Protected by the mutex.
+   */
+  bool new_data = false;
+
+  /**
+   * The snapshot the solvers are working on.  It is only accessed by
+   * the thread, or by SolveExhaustive() while the thread is idle.
+   */
+  Trace full, triangle, sprint;
+
   ContestManager contest_manager;
 
+  /**
+   * At most two solvers run in parallel (e.g. free flight and
+   * triangle): this thread and one worker.
+   */
+  WorkerPool pool;
+
+  /**
+   * The latest results.  Protected by the mutex.
+   */
+  ContestStatistics stats;
+
 public:
   ContestComputer(const Trace &trace_full,
                   const Trace &trace_triangle,
                   const Trace &trace_sprint);
 
-  void SetIncremental(bool incremental) {
-    contest_manager.SetIncremental(incremental);
+  ~ContestComputer() {
+    LockStop();
   }
 
-  void Reset() {
-    contest_manager.Reset();
+  void SetIncremental(bool incremental) {
+    const ScopeLock protect(mutex);
+    next_incremental = incremental;
   }
 
+  void Reset();
+
   /**
    * @see ContestDijkstra::SetPredicted()
    */
   void SetPredicted(const TracePoint &predicted) {
-    contest_manager.SetPredicted(predicted);
+    const ScopeLock protect(mutex);
+    next_predicted = predicted;
   }
 
+  /**
+   * Pass the current traces to the thread, and return the latest
+   * results, which may be from an older trace.
+   */
   void Solve(const ContestSettings &settings_computer,
              ContestStatistics &contest_stats);
 
+  /**
+   * Find the final solution.  This cancels the thread and runs the
+   * solvers in the calling thread.
+   */
   bool SolveExhaustive(const ContestSettings &settings_computer,
                        ContestStatistics &contest_stats);
+
+private:
+  /**
+   * Copy the live traces and the settings to the "next" attributes.
+   *
+   * Caller must lock the mutex.
+   */
+  void UpdateSnapshot(const ContestSettings &settings);
+
+  /**
+   * Copy the "next" attributes to the #ContestManager and its
+   * traces.
+   *
+   * Caller must lock the mutex, and the thread must not be using
+   * the #ContestManager.
+   */
+  void ApplySnapshot();
+
+protected:
+  /* virtual methods from class StandbyThread */
+  void Tick() override;
 };
 
 #endif
@@ -23,6 +23,7 @@ Copyright_License {
 */
 
 #include "GlideComputerBlackboard.hpp"
+#include "Blackboard/BlackboardGroups.hpp"
 
 /**
  * Resets the GlideComputerBlackboard
@@ -82,7 +83,7 @@ GlideComputerBlackboard::RestoreFinish()
 void
 GlideComputerBlackboard::ReadBlackboard(const MoreData &nmea_info)
 {
-  gps_info = nmea_info;
+  BlackboardGroups::Update(gps_info, nmea_info);
 }
 
 /**
@@ -134,6 +134,7 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
        reachabilty, so let's skip that step completely */
     calculated.terrain_base_valid = false;
     protected_route_planner.ClearReach();
+    calculated.reach_serial = route_planner.GetReachSerial().GetValue();
     return;
   }
 
@@ -151,6 +152,8 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
       calculated.terrain_base = route_planner.GetTerrainBase();
       calculated.terrain_base_valid = true;
     }
+
+    calculated.reach_serial = route_planner.GetReachSerial().GetValue();
   }
 }
 
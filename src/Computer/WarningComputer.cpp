@@ -54,10 +54,15 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
   if (dt <= 0)
     return;
 
-  airspaces.SetFlightLevels(settings_computer.pressure);
-
   AirspaceActivity day(calculated.date_time_local.day_of_week);
-  airspaces.SetActivity(day);
+
+  {
+    /* the airspace objects are shared with the published state; the
+       readers hold a shared lease while they use them */
+    ProtectedAirspaceWarningManager::ExclusiveLease lease(protected_manager);
+    airspaces.SetFlightLevels(settings_computer.pressure);
+    airspaces.SetActivity(day);
+  }
 
   if (!settings_computer.airspace.enable_warnings ||
       !basic.location_available || !basic.NavAltitudeAvailable()) {
@@ -66,22 +71,33 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
       protected_manager.Clear();
     }
 
+    protected_manager.Publish(airspaces.GetSnapshot(), day);
     return;
   }
 
   const AircraftState as = ToAircraftState(basic, calculated);
-  ProtectedAirspaceWarningManager::ExclusiveLease lease(protected_manager);
 
-  lease->SetConfig(settings_computer.airspace.warnings);
+  bool changed;
+
+  {
+    ProtectedAirspaceWarningManager::ExclusiveLease lease(protected_manager);
 
-  if (!initialised) {
-    initialised = true;
-    lease->Reset(as);
+    lease->SetConfig(settings_computer.airspace.warnings);
+
+    if (!initialised) {
+      initialised = true;
+      lease->Reset(as);
+    }
+
+    changed = lease->Update(as, settings_computer.polar.glide_polar_task,
+                            calculated.task_stats,
+                            calculated.circling,
+                            uround(dt));
   }
 
-  if (lease->Update(as, settings_computer.polar.glide_polar_task,
-                    calculated.task_stats,
-                    calculated.circling,
-                    uround(dt)))
+  /* let the user interface see the new warnings and flight levels */
+  protected_manager.Publish(airspaces.GetSnapshot(), day);
+
+  if (changed)
     result.latest.Update(basic.clock);
 }
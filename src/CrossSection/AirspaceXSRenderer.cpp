@@ -217,6 +217,8 @@ AirspaceXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
   AirspaceIntersectionVisitorSlice ivisitor(
       canvas, chart, settings, look, start, state);
 
-  // Call visitor with intersecting airspaces
-  database.VisitIntersecting(start, vec.EndPoint(start), true, ivisitor);
+  // Call visitor with intersecting airspaces within the chart's altitude range
+  database.VisitIntersecting(start, vec.EndPoint(start),
+                             chart.GetYMin(), chart.GetYMax(),
+                             true, ivisitor);
 }
@@ -727,7 +727,8 @@ DeviceDescriptor::IsAlive() const
 }
 
 bool
-DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
+DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info,
+                            bool checksum_valid)
 {
   assert(line != nullptr);
 
@@ -735,7 +736,8 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
   const ExternalSettings old_settings = info.settings;
   info.settings = settings_received;
 
-  if (device != nullptr && device->ParseNMEA(line, info)) {
+  if (device != nullptr && driver->WantsNMEASentence(line) &&
+      device->ParseNMEA(line, info)) {
     info.alive.Update(info.clock);
 
     if (!config.sync_from_device)
@@ -755,7 +757,7 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
   info.settings = old_settings;
 
   // Additional "if" to find GPS strings
-  if (parser.ParseLine(line, info)) {
+  if (checksum_valid && parser.ParseVerifiedLine(line, info)) {
     info.alive.Update(info.clock);
     return true;
   }
@@ -1139,12 +1141,12 @@ DeviceDescriptor::OnCalculatedUpdate(const MoreData &basic,
 }
 
 bool
-DeviceDescriptor::ParseLine(const char *line)
+DeviceDescriptor::ParseLine(const char *line, bool checksum_valid)
 {
   ScopeLock protect(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   basic.UpdateClock();
-  return ParseNMEA(line, basic);
+  return ParseNMEA(line, basic, checksum_valid);
 }
 
 void
@@ -1229,6 +1231,6 @@ DeviceDescriptor::LineReceived(const char *line)
   if (dispatcher != nullptr)
     dispatcher->LineReceived(line);
 
-  if (ParseLine(line))
+  if (ParseLine(line, IsLineChecksumValid()))
     device_blackboard->ScheduleMerge();
 }
@@ -457,7 +457,12 @@ public:
   bool IsAlive() const;
 
 private:
-  bool ParseNMEA(const char *line, struct NMEAInfo &info);
+  /**
+   * @param checksum_valid does the line have a valid NMEA checksum?
+   * (calculated by #PortLineSplitter)
+   */
+  bool ParseNMEA(const char *line, struct NMEAInfo &info,
+                 bool checksum_valid);
 
 public:
   void SetMonitor(DataHandler  *_monitor) {
@@ -523,7 +528,7 @@ public:
                           const DerivedInfo &calculated);
 
 private:
-  bool ParseLine(const char *line);
+  bool ParseLine(const char *line, bool checksum_valid);
 
   /* virtual methods from class Notify */
   void OnNotification() override;
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Device/Driver.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "RadioFrequency.hpp"
 #include "OS/Path.hpp"
 
@@ -129,3 +130,9 @@ AbstractDevice::DataReceived(const void *data, size_t length, NMEAInfo &info)
 {
   return false;
 }
+
+bool
+DeviceRegister::WantsNMEASentence(const char *line) const
+{
+  return sentences == nullptr || sentences->FindLine(line) >= 0;
+}
@@ -24,6 +24,8 @@ Copyright_License {
 #ifndef XCSOAR_DEVICE_DRIVER_HPP
 #define XCSOAR_DEVICE_DRIVER_HPP
 
+#include "Compiler.h"
+
 #include <stddef.h>
 #include <tchar.h>
 
@@ -40,6 +42,7 @@ class RadioFrequency;
 class OperationEnvironment;
 struct RecordedFlightInfo;
 class RecordedFlightList;
+class NMEASentenceTable;
 
 /**
  * This is the interface for a device driver.
@@ -362,6 +365,14 @@ struct DeviceRegister {
    */
   Device *(*CreateOnPort)(const DeviceConfig &config, Port &com_port);
 
+  /**
+   * The tags of the NMEA sentences handled by Device::ParseNMEA(),
+   * e.g. "$PFLAC".  If set, that method is only called for lines with
+   * one of these tags; all other lines go straight to the generic
+   * #NMEAParser.  Drivers which inspect all lines leave this nullptr.
+   */
+  const NMEASentenceTable *sentences;
+
   /**
    * Is this driver able to receive settings like MC value,
    * bugs or ballast from the device?
@@ -436,6 +447,12 @@ struct DeviceRegister {
   bool HasPassThrough() const {
     return (flags & PASS_THROUGH) != 0;
   }
+
+  /**
+   * Shall Device::ParseNMEA() be called for this line?
+   */
+  gcc_pure
+  bool WantsNMEASentence(const char *line) const;
 };
 
 #endif
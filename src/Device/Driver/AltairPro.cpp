@@ -29,6 +29,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Units/System.hpp"
 #include "Waypoint/Waypoint.hpp"
 #include "Util/TruncateString.hpp"
@@ -352,9 +353,15 @@ AltairProCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new AltairProDevice(com_port);
 }
 
+static constexpr NMEASentenceTable altair_pro_sentences{
+  "$PGRMZ",
+  "$PTFRS",
+};
+
 const struct DeviceRegister altair_pro_driver = {
   _T("Altair RU"),
   _T("Altair Recording Unit"),
   DeviceRegister::DECLARE,
   AltairProCreateOnPort,
+  &altair_pro_sentences,
 };
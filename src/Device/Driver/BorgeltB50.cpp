@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Util/Clamp.hpp"
 
 #include <math.h>
@@ -169,9 +170,14 @@ B50CreateOnPort(const DeviceConfig &config, Port &com_port)
   return new B50Device(com_port);
 }
 
+static constexpr NMEASentenceTable b50_sentences{
+  "$PBB50",
+};
+
 const struct DeviceRegister b50_driver = {
   _T("Borgelt B50"),
   _T("Borgelt B50/B800"),
   DeviceRegister::RECEIVE_SETTINGS | DeviceRegister::SEND_SETTINGS,
   B50CreateOnPort,
+  &b50_sentences,
 };
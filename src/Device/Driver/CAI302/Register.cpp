@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Device/Driver/CAI302.hpp"
 #include "Internal.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 static Device *
 CAI302CreateOnPort(const DeviceConfig &config, Port &port)
@@ -30,6 +31,15 @@ CAI302CreateOnPort(const DeviceConfig &config, Port &port)
   return new CAI302Device(config, port);
 }
 
+/**
+ * The sentences parsed by CAI302Device::ParseNMEA().
+ */
+static constexpr NMEASentenceTable cai302_sentences{
+  "$PCAIB",
+  "$PCAID",
+  "!w",
+};
+
 const struct DeviceRegister cai302_driver = {
   _T("CAI 302"),
   _T("Cambridge CAI302"),
@@ -37,4 +47,5 @@ const struct DeviceRegister cai302_driver = {
   DeviceRegister::DECLARE | DeviceRegister::LOGGER | DeviceRegister::MANAGE |
   DeviceRegister::RECEIVE_SETTINGS | DeviceRegister::SEND_SETTINGS,
   CAI302CreateOnPort,
+  &cai302_sentences,
 };
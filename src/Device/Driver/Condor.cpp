@@ -27,6 +27,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Compiler.h"
 
 class CondorDevice : public AbstractDevice {
@@ -118,9 +119,14 @@ CondorCreateOnPort(const DeviceConfig &config, gcc_unused Port &com_port)
   return new CondorDevice();
 }
 
+static constexpr NMEASentenceTable condor_sentences{
+  "$LXWP0",
+};
+
 const struct DeviceRegister condor_driver = {
   _T("Condor"),
   _T("Condor Soaring Simulator"),
   0,
   CondorCreateOnPort,
+  &condor_sentences,
 };
@@ -33,6 +33,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Checksum.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Waypoint/Waypoint.hpp"
 #include "Units/System.hpp"
 #include "Time/TimeoutClock.hpp"
@@ -364,9 +365,14 @@ EWMicroRecorderCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new EWMicroRecorderDevice(com_port);
 }
 
+static constexpr NMEASentenceTable ew_microrecorder_sentences{
+  "$PGRMZ",
+};
+
 const struct DeviceRegister ew_microrecorder_driver = {
   _T("EW MicroRecorder"),
   _T("EW microRecorder"),
   DeviceRegister::DECLARE,
   EWMicroRecorderCreateOnPort,
+  &ew_microrecorder_sentences,
 };
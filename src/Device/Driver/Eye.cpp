@@ -26,6 +26,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Units/System.hpp"
 #include "Atmosphere/Pressure.hpp"
 #include "Math/Util.hpp"
@@ -195,9 +196,15 @@ EyeCreateOnPort(gcc_unused const DeviceConfig &config, gcc_unused Port &com_port
   return new EyeDevice();
 }
 
+static constexpr NMEASentenceTable eye_sentences{
+  "$PEYA",
+  "$PEYI",
+};
+
 const struct DeviceRegister eye_driver = {
   _T("EYE"),
   _T("EYE sensor-box (experimental)"),
   0,
   EyeCreateOnPort,
+  &eye_sentences,
 };
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Device/Driver/FLARM.hpp"
 #include "Device.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 static Device *
 FlarmCreateOnPort(const DeviceConfig &config, Port &com_port)
@@ -30,8 +31,16 @@ FlarmCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new FlarmDevice(com_port);
 }
 
+/**
+ * The sentences parsed by FlarmDevice::ParseNMEA().
+ */
+static constexpr NMEASentenceTable flarm_sentences{
+  "$PFLAC",
+};
+
 const struct DeviceRegister flarm_driver = {
   _T("FLARM"), _T("FLARM"),
   DeviceRegister::DECLARE | DeviceRegister::LOGGER | DeviceRegister::MANAGE,
   FlarmCreateOnPort,
+  &flarm_sentences,
 };
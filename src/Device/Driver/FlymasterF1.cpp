@@ -27,6 +27,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 class FlymasterF1Device : public AbstractDevice {
   Port &port;
@@ -107,9 +108,14 @@ FlymasterF1CreateOnPort(const DeviceConfig &config, Port &port)
   return new FlymasterF1Device(port);
 }
 
+static constexpr NMEASentenceTable flymaster_f1_sentences{
+  "$VARIO",
+};
+
 const struct DeviceRegister flymaster_f1_driver = {
   _T("FlymasterF1"),
   _T("Flymaster F1"),
   0,
   FlymasterF1CreateOnPort,
+  &flymaster_f1_sentences,
 };
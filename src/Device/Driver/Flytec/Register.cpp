@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Device/Driver/Flytec.hpp"
 #include "Device.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 static Device *
 FlytecCreateOnPort(const DeviceConfig &config, Port &com_port)
@@ -30,8 +31,18 @@ FlytecCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new FlytecDevice(com_port);
 }
 
+/**
+ * The sentences parsed by FlytecDevice::ParseNMEA().
+ */
+static constexpr NMEASentenceTable flytec_sentences{
+  "$BRSF",
+  "$VMVABD",
+  "$FLYSEN",
+};
+
 const struct DeviceRegister flytec_driver = {
   _T("Flytec"), _T("Flytec 5030 / Brauniger"),
   0 /* DeviceRegister::LOGGER deactivated until current firmware supports this */,
   FlytecCreateOnPort,
+  &flytec_sentences,
 };
@@ -26,6 +26,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Units/System.hpp"
 
 class ILECDevice : public AbstractDevice {
@@ -106,9 +107,14 @@ ILECCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new ILECDevice();
 }
 
+static constexpr NMEASentenceTable ilec_sentences{
+  "$PILC",
+};
+
 const struct DeviceRegister ilec_driver = {
   _T("ILEC SN10"),
   _T("ILEC SN10"),
   0,
   ILECCreateOnPort,
+  &ilec_sentences,
 };
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Device/Driver/IMI.hpp"
 #include "Internal.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 static Device *
 IMICreateOnPort(const DeviceConfig &config, Port &com_port)
@@ -30,9 +31,17 @@ IMICreateOnPort(const DeviceConfig &config, Port &com_port)
   return new IMIDevice(com_port);
 }
 
+/**
+ * The sentences parsed by IMIDevice::ParseNMEA().
+ */
+static constexpr NMEASentenceTable imi_sentences{
+  "$PGRMZ",
+};
+
 const struct DeviceRegister imi_driver = {
   _T("IMI ERIXX"),
   _T("IMI ERIXX"),
   DeviceRegister::DECLARE | DeviceRegister::LOGGER,
   IMICreateOnPort,
+  &imi_sentences,
 };
@@ -32,6 +32,13 @@ Copyright_License {
 #include <atomic>
 #include <stdint.h>
 
+class NMEASentenceTable;
+
+/**
+ * The sentences handled by LXDevice::ParseNMEA().
+ */
+extern const NMEASentenceTable lx_sentences;
+
 class LXDevice: public AbstractDevice
 {
   enum class Mode : uint8_t {
@@ -25,6 +25,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Info.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Geo/SpeedVector.hpp"
 #include "Units/System.hpp"
 #include "Util/Macros.hpp"
@@ -337,6 +338,38 @@ PLXVS(NMEAInputLine &line, NMEAInfo &info)
   return true;
 }
 
+namespace {
+  /**
+   * The sentences handled by LXDevice::ParseNMEA(), in the order of
+   * #lx_sentences.
+   */
+  enum class LXSentence : int {
+    UNKNOWN = -1,
+    LXWP0,
+    LXWP1,
+    LXWP2,
+    LXWP3,
+    PLXV0,
+    PLXVC,
+    PLXVF,
+    PLXVS,
+  };
+}
+
+constexpr NMEASentenceTable lx_sentences{
+  "$LXWP0",
+  "$LXWP1",
+  "$LXWP2",
+  "$LXWP3",
+  "$PLXV0",
+  "$PLXVC",
+  "$PLXVF",
+  "$PLXVS",
+};
+
+static_assert(lx_sentences.size() == unsigned(LXSentence::PLXVS) + 1,
+              "Table does not match the enum");
+
 bool
 LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
@@ -344,13 +377,16 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
+  const StringView type(String, line.Skip());
 
-  if (StringIsEqual(type, "$LXWP0"))
+  switch (LXSentence(lx_sentences.Find(type))) {
+  case LXSentence::UNKNOWN:
+    break;
+
+  case LXSentence::LXWP0:
     return LXWP0(line, info);
 
-  if (StringIsEqual(type, "$LXWP1")) {
+  case LXSentence::LXWP1: {
     /* if in pass-through mode, assume that this line was sent by the
        secondary device */
     DeviceInfo &device_info = mode == Mode::PASS_THROUGH
@@ -384,34 +420,31 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return true;
   }
 
-  if (StringIsEqual(type, "$LXWP2"))
+  case LXSentence::LXWP2:
     return LXWP2(line, info);
 
-  if (StringIsEqual(type, "$LXWP3"))
+  case LXSentence::LXWP3:
     return LXWP3(line, info);
 
-  if (StringIsEqual(type, "$PLXV0")) {
+  case LXSentence::PLXV0:
     is_v7 = true;
     is_colibri = false;
     return PLXV0(line, v7_settings);
-  }
 
-  if (StringIsEqual(type, "$PLXVC")) {
+  case LXSentence::PLXVC:
     is_nano = true;
     is_colibri = false;
     PLXVC(line, info.device, info.secondary_device, nano_settings);
     is_forwarded_nano = info.secondary_device.product.equals("NANO") ||
                           info.secondary_device.product.equals("NANO3");
     return true;
-  }
 
-  if (StringIsEqual(type, "$PLXVF")) {
+  case LXSentence::PLXVF:
     is_v7 = true;
     is_colibri = false;
     return PLXVF(line, info);
-  }
 
-  if (StringIsEqual(type, "$PLXVS")) {
+  case LXSentence::PLXVS:
     is_v7 = true;
     is_colibri = false;
     return PLXVS(line, info);
@@ -45,4 +45,5 @@ const struct DeviceRegister lx_driver = {
   DeviceRegister::BULK_BAUD_RATE |
   DeviceRegister::RECEIVE_SETTINGS | DeviceRegister::SEND_SETTINGS,
   LXCreateOnPort,
+  &lx_sentences,
 };
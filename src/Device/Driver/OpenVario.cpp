@@ -26,6 +26,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Units/System.hpp"
 
 class OpenVarioDevice : public AbstractDevice {
@@ -114,9 +115,14 @@ OpenVarioCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new OpenVarioDevice();
 }
 
+static constexpr NMEASentenceTable open_vario_sentences{
+  "$POV",
+};
+
 const struct DeviceRegister open_vario_driver = {
   _T("OpenVario"),
   _T("OpenVario"),
   0,
   OpenVarioCreateOnPort,
+  &open_vario_sentences,
 };
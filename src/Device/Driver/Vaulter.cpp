@@ -27,6 +27,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Checksum.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 static bool
 ParsePITV3(NMEAInputLine &line, NMEAInfo &info)
@@ -179,9 +180,16 @@ VaulterCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new VaulterDevice(com_port);
 }
 
+static constexpr NMEASentenceTable vaulter_sentences{
+  "$PITV3",
+  "$PITV4",
+  "$PITV5",
+};
+
 const struct DeviceRegister vaulter_driver = {
   _T("Vaulter"),
   _T("WSI Vaulter"),
   DeviceRegister::RECEIVE_SETTINGS | DeviceRegister::SEND_SETTINGS,
   VaulterCreateOnPort,
+  &vaulter_sentences,
 };
@@ -24,6 +24,7 @@ Copyright_License {
 #include "../Volkslogger.hpp"
 #include "Internal.hpp"
 #include "Device/Config.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 static Device *
 VolksloggerCreateOnPort(const DeviceConfig &config, Port &com_port)
@@ -42,10 +43,18 @@ VolksloggerCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new VolksloggerDevice(com_port, bulkrate);
 }
 
+/**
+ * The sentences parsed by VolksloggerDevice::ParseNMEA().
+ */
+static constexpr NMEASentenceTable volkslogger_sentences{
+  "$PGCS",
+};
+
 const struct DeviceRegister volkslogger_driver = {
   _T("Volkslogger"),
   _T("Volkslogger"),
   DeviceRegister::DECLARE | DeviceRegister::LOGGER |
   DeviceRegister::BULK_BAUD_RATE,
   VolksloggerCreateOnPort,
+  &volkslogger_sentences,
 };
@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Checksum.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 #include <tchar.h>
 #include <stdio.h>
@@ -189,9 +190,15 @@ WesterboerCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new WesterboerDevice(com_port);
 }
 
+static constexpr NMEASentenceTable westerboer_sentences{
+  "$PWES0",
+  "$PWES1",
+};
+
 const struct DeviceRegister westerboer_driver = {
   _T("Westerboer VW1150"),
   _T("Westerboer VW1150"),
   DeviceRegister::RECEIVE_SETTINGS | DeviceRegister::SEND_SETTINGS,
   WesterboerCreateOnPort,
+  &westerboer_sentences,
 };
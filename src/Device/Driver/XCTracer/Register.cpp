@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "../XCTracer/Internal.hpp"
 #include "Device/Driver/XCTracer.hpp"
+#include "NMEA/SentenceTable.hpp"
 
 static Device *
 XCTracerCreateOnPort(const DeviceConfig &config, Port &com_port)
@@ -30,9 +31,18 @@ XCTracerCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new XCTracerDevice();
 }
 
+/**
+ * The sentences parsed by XCTracerDevice::ParseNMEA().
+ */
+static constexpr NMEASentenceTable xctracer_sentences{
+  "$LXWP0",
+  "$XCTRC",
+};
+
 const struct DeviceRegister xctracer_driver = {
   _T("XCTracer"),
   _T("XC-Tracer Vario"),
   0,
   XCTracerCreateOnPort,
+  &xctracer_sentences,
 };
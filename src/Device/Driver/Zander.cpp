@@ -26,6 +26,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Checksum.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Units/System.hpp"
 #include "Util/StringAPI.hxx"
 
@@ -159,9 +160,18 @@ ZanderCreateOnPort(const DeviceConfig &config, Port &com_port)
   return new ZanderDevice();
 }
 
+static constexpr NMEASentenceTable zander_sentences{
+  "$PZAN1",
+  "$PZAN2",
+  "$PZAN3",
+  "$PZAN4",
+  "$PZAN5",
+};
+
 const struct DeviceRegister zander_driver = {
   _T("Zander"),
   _T("Zander / SDI"),
   DeviceRegister::RECEIVE_SETTINGS,
   ZanderCreateOnPort,
+  &zander_sentences,
 };
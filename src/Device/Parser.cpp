@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceTable.hpp"
 #include "Units/System.hpp"
 #include "Driver/FLARM/StaticParser.hpp"
 #include "Util/CharUtil.hxx"
@@ -45,74 +46,138 @@ NMEAParser::Reset()
   last_time = 0;
 }
 
+namespace {
+  /**
+   * The sentences handled by NMEAParser::ParseLine(), in the order
+   * of #nmea_sentences.
+   */
+  enum class Sentence : int {
+    UNKNOWN = -1,
+
+    /* standard sentences; the talker id is ignored */
+    GSA,
+    GLL,
+    RMC,
+    GGA,
+    HDM,
+    MWV,
+
+    /* proprietary sentences */
+    PTAS1,
+    PFLAE,
+    PFLAV,
+    PFLAA,
+    PFLAU,
+    PGRMZ,
+  };
+}
+
+static constexpr NMEASentenceTable nmea_sentences{
+  "GSA",
+  "GLL",
+  "RMC",
+  "GGA",
+  "HDM",
+  "MWV",
+
+  "$PTAS1",
+  "$PFLAE",
+  "$PFLAV",
+  "$PFLAA",
+  "$PFLAU",
+  "$PGRMZ",
+};
+
+static_assert(nmea_sentences.size() == unsigned(Sentence::PGRMZ) + 1,
+              "Table does not match the enum");
+
+gcc_pure
+static Sentence
+FindSentence(StringView type)
+{
+  /* standard sentences are looked up without the dollar sign and the
+     two-letter talker id; proprietary ones are looked up completely
+     (their tags begin with a dollar sign, therefore the two groups
+     cannot be confused) */
+  if (type.size == 6 && IsAlphaASCII(type.data[1]) &&
+      IsAlphaASCII(type.data[2])) {
+    const int i = nmea_sentences.Find(StringView(type.data + 3, 3));
+    if (i >= 0)
+      return Sentence(i);
+  }
+
+  return Sentence(nmea_sentences.Find(type));
+}
+
 bool
 NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 {
-  assert(info.clock > 0);
-
   if (string[0] != '$')
     return false;
 
   if (!NMEAChecksum(string))
     return false;
 
+  return ParseVerifiedLine(string, info);
+}
+
+bool
+NMEAParser::ParseVerifiedLine(const char *string, NMEAInfo &info)
+{
+  assert(info.clock > 0);
+
+  if (string[0] != '$')
+    return false;
+
   NMEAInputLine line(string);
+  const StringView type(string, line.Skip());
 
-  char type[16];
-  line.Read(type, 16);
+  switch (FindSentence(type)) {
+  case Sentence::UNKNOWN:
+    break;
 
-  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    if (StringIsEqual(type + 3, "GSA"))
-      return GSA(line, info);
+  case Sentence::GSA:
+    return GSA(line, info);
 
-    if (StringIsEqual(type + 3, "GLL"))
-      return GLL(line, info);
+  case Sentence::GLL:
+    return GLL(line, info);
 
-    if (StringIsEqual(type + 3, "RMC"))
-      return RMC(line, info);
+  case Sentence::RMC:
+    return RMC(line, info);
 
-    if (StringIsEqual(type + 3, "GGA"))
-      return GGA(line, info);
+  case Sentence::GGA:
+    return GGA(line, info);
 
-    if (StringIsEqual(type + 3, "HDM"))
-      return HDM(line, info);
+  case Sentence::HDM:
+    return HDM(line, info);
 
-    if (StringIsEqual(type + 3, "MWV"))
-      return MWV(line, info);
-  }
+  case Sentence::MWV:
+    return MWV(line, info);
 
-  // if (proprietary sentence) ...
-  if (type[1] == 'P') {
+  case Sentence::PTAS1:
     // Airspeed and vario sentence
-    if (StringIsEqual(type + 1, "PTAS1"))
-      return PTAS1(line, info);
+    return PTAS1(line, info);
 
-    // FLARM sentences
-    if (StringIsEqual(type + 1, "PFLAE")) {
-      ParsePFLAE(line, info.flarm.error, info.clock);
-      return true;
-    }
+  // FLARM sentences
+  case Sentence::PFLAE:
+    ParsePFLAE(line, info.flarm.error, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAV")) {
-      ParsePFLAV(line, info.flarm.version, info.clock);
-      return true;
-    }
+  case Sentence::PFLAV:
+    ParsePFLAV(line, info.flarm.version, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAA")) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
-      return true;
-    }
+  case Sentence::PFLAA:
+    ParsePFLAA(line, info.flarm.traffic, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAU")) {
-      ParsePFLAU(line, info.flarm.status, info.clock);
-      return true;
-    }
+  case Sentence::PFLAU:
+    ParsePFLAU(line, info.flarm.status, info.clock);
+    return true;
 
+  case Sentence::PGRMZ:
     // Garmin altitude sentence
-    if (StringIsEqual(type + 1, "PGRMZ"))
-      return RMZ(line, info);
-
-    return false;
+    return RMZ(line, info);
   }
 
   return false;
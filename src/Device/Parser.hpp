@@ -63,6 +63,12 @@ public:
    */
   bool ParseLine(const char *line, NMEAInfo &info);
 
+  /**
+   * Like ParseLine(), but the caller has already verified the
+   * checksum (e.g. #PortLineSplitter while splitting the input).
+   */
+  bool ParseVerifiedLine(const char *line, NMEAInfo &info);
+
 public:
   /**
    * Calculates the checksum of the provided NMEA string and
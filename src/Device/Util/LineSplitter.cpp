@@ -22,12 +22,14 @@ Copyright_License {
 */
 
 #include "LineSplitter.hpp"
-#include "Util/TextFile.hxx"
+#include "NMEA/Checksum.hpp"
 #include "Util/StringUtil.hpp"
+#include "Compiler.h"
 
 #include <algorithm>
 
 #include <string.h>
+#include <assert.h>
 
 constexpr
 static bool
@@ -36,60 +38,116 @@ IsInsaneChar(char ch)
   return (unsigned char)ch < 0x20;
 }
 
-/**
- * Replace all control characters with a regular space character.
- */
-static void
-SanitiseLine(char *const begin, char *const end)
+PortLineSplitter::PortLineSplitter()
+  :checksum_valid(false), discarding(false)
 {
-  std::replace_if(begin, end, IsInsaneChar, ' ');
+  ResetLine();
 }
 
-void
-PortLineSplitter::DataReceived(const void *_data, size_t length)
+inline void
+PortLineSplitter::Append(const char *data, size_t size)
 {
-  assert(_data != nullptr);
-  assert(length > 0);
+  if (discarding)
+    return;
 
-  const char *data = (const char *)_data, *end = data + length;
+  const char *const end = data + size;
 
-  do {
-    /* append new data to buffer, as much as fits there */
-    auto range = buffer.Write();
-    if (range.IsEmpty()) {
-      /* overflow: reset buffer to recover quickly */
-      buffer.Clear();
-      continue;
+  while (data < end) {
+    if (length == MAX_LENGTH) {
+      /* overflow: discard the rest of the line to recover quickly */
+      ResetLine();
+      discarding = true;
+      return;
     }
 
-    size_t nbytes = std::min(size_t(range.size), size_t(end - data));
-    memcpy(range.data, data, nbytes);
-    data += nbytes;
-    buffer.Append(nbytes);
-
-    while (true) {
-      /* read data from the buffer, to see if there's a newline
-         character */
-      char *line = ReadBufferedLine(buffer);
-      if (line == nullptr)
-        /* no newline here: wait for more data */
-        break;
+    const char *const chunk_end =
+      std::min(end, data + (MAX_LENGTH - length));
+
+    /* copy, replace control characters with a regular space
+       character and calculate the checksum in one pass; the
+       attributes are copied to local variables because the compiler
+       would otherwise reload them after each (aliasing) character
+       store */
+    size_t l = length;
+    uint8_t c = checksum;
+
+    for (; data < chunk_end; ++data) {
+      char ch = *data;
+      if (gcc_unlikely(IsInsaneChar(ch))) {
+        if (ch == 0) {
+          /* if there are NUL bytes in the line, skip to after the
+             last one, to avoid conflicts with NUL terminated C
+             strings due to binary garbage */
+          ResetLine();
+          l = 0;
+          c = 0;
+          continue;
+        }
+
+        ch = ' ';
+      } else if (gcc_unlikely(ch == '*')) {
+        asterisk = l;
+        asterisk_checksum = c;
+      }
+
+      line[l++] = ch;
+      c ^= ch;
+    }
 
-      char *end = line + strlen(line);
+    length = l;
+    checksum = c;
+  }
+}
 
-      /* remove trailing whitespace, such as '\r' */
-      end = StripRight(line, end);
+inline void
+PortLineSplitter::FinishLine()
+{
+  if (discarding) {
+    /* this was the end of an overlong line; the next one can be
+       used again */
+    discarding = false;
+    ResetLine();
+    return;
+  }
+
+  /* remove trailing whitespace, such as '\r' */
+  length = StripRight(line, length);
+  line[length] = 0;
+
+  if (asterisk >= 0) {
+    /* like NMEAChecksum(), skip the dollar sign (or the exclamation
+       mark used by CAI302) at the beginning */
+    uint8_t calculated = asterisk_checksum;
+    if (asterisk > 0 && (line[0] == '$' || line[0] == '!'))
+      calculated ^= line[0];
+
+    checksum_valid = VerifyNMEAChecksum(line + asterisk + 1, calculated);
+  } else
+    checksum_valid = false;
+
+  LineReceived(line);
+
+  ResetLine();
+}
 
-      SanitiseLine(line, end);
+void
+PortLineSplitter::DataReceived(const void *_data, size_t size)
+{
+  assert(_data != nullptr);
+  assert(size > 0);
 
-      /* if there are NUL bytes in the line, skip to after the last
-         one, to avoid conflicts with NUL terminated C strings due to
-         binary garbage */
-      void *nul;
-      while ((nul = memchr(line, 0, end - line)) != nullptr)
-        line = (char *)nul + 1;
+  const char *data = (const char *)_data, *const end = data + size;
 
-      LineReceived(line);
+  while (true) {
+    const char *newline = (const char *)memchr(data, '\n', end - data);
+    if (newline == nullptr) {
+      /* no newline here: wait for more data */
+      Append(data, end - data);
+      break;
     }
-  } while (data < end);
+
+    Append(data, newline - data);
+    FinishLine();
+    data = newline + 1;
+  }
 }
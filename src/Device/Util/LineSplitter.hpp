@@ -26,15 +26,86 @@ Copyright_License {
 
 #include "IO/DataHandler.hpp"
 #include "LineHandler.hpp"
-#include "Util/StaticFifoBuffer.hxx"
 
+#include <stdint.h>
+
+/**
+ * Splits the data received from a port into lines and passes them
+ * to LineReceived().  Each byte is scanned only once: the same loop
+ * which copies it to the line buffer replaces control characters
+ * and calculates the NMEA checksum, see IsLineChecksumValid().
+ */
 class PortLineSplitter : public DataHandler, protected PortLineHandler {
-  typedef StaticFifoBuffer<char, 256u> Buffer;
+  /**
+   * The maximum length of a line.  Longer lines are discarded
+   * entirely, up to the next newline.
+   */
+  static constexpr size_t MAX_LENGTH = 255;
+
+  char line[MAX_LENGTH + 1];
+
+  /**
+   * The number of characters in #line.
+   */
+  size_t length;
+
+  /**
+   * The position of the last asterisk in #line, or -1.
+   */
+  int asterisk;
+
+  /**
+   * The XOR of all characters in #line.
+   */
+  uint8_t checksum;
+
+  /**
+   * The value of #checksum just before the last asterisk.
+   */
+  uint8_t asterisk_checksum;
 
-  Buffer buffer;
+  bool checksum_valid;
+
+  /**
+   * Has the current line exceeded #MAX_LENGTH?  Then the rest of it
+   * is ignored until the next newline.
+   */
+  bool discarding;
 
 public:
+  PortLineSplitter();
+
   virtual void DataReceived(const void *data, size_t length) override;
+
+protected:
+  /**
+   * Does the line which is currently being passed to LineReceived()
+   * have a valid NMEA checksum?  The result is the same as that of
+   * VerifyNMEAChecksum(), but it has been calculated while splitting
+   * the input.
+   */
+  bool IsLineChecksumValid() const {
+    return checksum_valid;
+  }
+
+private:
+  void ResetLine() {
+    length = 0;
+    asterisk = -1;
+    checksum = 0;
+  }
+
+  /**
+   * Append the specified characters (which don't contain a newline)
+   * to #line.
+   */
+  void Append(const char *data, size_t size);
+
+  /**
+   * A newline was received: pass the current line to
+   * LineReceived(), unless it is being discarded.
+   */
+  void FinishLine();
 };
 
 #endif
@@ -80,9 +80,9 @@ ReplayControlWidget::Prepare(ContainerWindow &parent, const PixelRect &rc)
 {
   auto *file =
     AddFile(_("File"),
-            _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea), or if blank, runs the demo."),
+            _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea or .nmea.gz), or if blank, runs the demo."),
             nullptr,
-            _T("*.nmea\0*.igc\0"),
+            _T("*.nmea\0*.nmea.gz\0*.igc\0"),
             true);
   ((FileDataField *)file->GetDataField())->Lookup(Path(replay->GetFilename()));
   file->RefreshDisplay();
@@ -37,6 +37,7 @@ enum ControlIndex {
   LoggerTimeStepCircling,
   DisableAutoLogger,
   EnableNMEALogger,
+  CompressNMEALogger,
   EnableFlightLogger,
   LoggerID,
 };
@@ -89,6 +90,12 @@ LoggerConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
              logger.enable_nmea_logger);
   SetExpertRow(EnableNMEALogger);
 
+  AddBoolean(_("Compress NMEA log"),
+             _("Compress the NMEA log files with gzip. This saves a lot of "
+               "storage space; the replay function can read compressed files."),
+             logger.compress_nmea_logger);
+  SetExpertRow(CompressNMEALogger);
+
   AddBoolean(_("Log book"), _("Logs each start and landing."),
              logger.enable_flight_logger);
   SetExpertRow(EnableFlightLogger);
@@ -122,6 +129,10 @@ LoggerConfigPanel::Save(bool &changed)
   if (logger.enable_nmea_logger)
     NMEALogger::enabled = true;
 
+  changed |= SaveValue(CompressNMEALogger, ProfileKeys::CompressNMEALogger,
+                       logger.compress_nmea_logger);
+  NMEALogger::compress = logger.compress_nmea_logger;
+
   if (SaveValue(EnableFlightLogger, ProfileKeys::EnableFlightLogger,
                 logger.enable_flight_logger)) {
     changed = true;
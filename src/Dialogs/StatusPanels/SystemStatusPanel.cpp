@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "SystemStatusPanel.hpp"
 #include "Logger/Logger.hpp"
+#include "Logger/NMEALogger.hpp"
 #include "Components.hpp"
 #include "Interface.hpp"
 #include "Language/Language.hpp"
@@ -35,6 +36,7 @@ enum Controls {
   Vario,
   FLARM,
   Logger,
+  NMEALog,
   Battery,
   Network,
 };
@@ -108,6 +110,13 @@ SystemStatusPanel::Refresh()
           ? _("On")
           : _("Off"));
 
+  if (NMEALogger::enabled) {
+    Temp.Format(_("On, %u bytes queued, %u lines dropped"),
+                NMEALogger::GetQueueDepth(), NMEALogger::GetDroppedLines());
+    SetText(NMEALog, Temp);
+  } else
+    SetText(NMEALog, _("Off"));
+
   Temp.clear();
 #ifdef HAVE_BATTERY
   if (Power::Battery::RemainingPercentValid) {
@@ -132,6 +141,7 @@ SystemStatusPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
   AddReadOnly(_("Variometer"));
   AddReadOnly(_T("FLARM"));
   AddReadOnly(_("Logger"));
+  AddReadOnly(_("NMEA logger"));
   AddReadOnly(_("Supply voltage"));
   AddReadOnly(_("Network"));
 }
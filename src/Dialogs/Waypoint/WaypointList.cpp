@@ -243,6 +243,12 @@ public:
 
 static WaypointListDialogState dialog_state;
 
+/**
+ * Remembers the previous name search, to refine it quickly while the
+ * user types.
+ */
+static WaypointNameIndex::Search name_search;
+
 static const TCHAR *
 GetDirectionData(TCHAR *buffer, size_t size, int direction_filter_index,
                  Angle heading)
@@ -286,6 +292,7 @@ FillList(WaypointList &list, const Waypoints &src,
 
   WaypointListBuilder builder(filter, location, list,
                               ordered_task, ordered_task_index);
+  builder.SetNameSearch(name_search);
   builder.Visit(src);
 
   if (filter.distance > 0 || !filter.direction.IsNegative())
@@ -340,7 +347,8 @@ static const TCHAR *
 WaypointNameAllowedCharacters(const TCHAR *prefix)
 {
   static TCHAR buffer[256];
-  return way_points.SuggestNamePrefix(prefix, buffer, ARRAY_SIZE(buffer));
+  return way_points.SuggestNameCharacters(prefix, buffer, ARRAY_SIZE(buffer),
+                                          name_search);
 }
 
 static DataField *
@@ -239,6 +239,15 @@ public:
     days_of_operation = mask;
   }
 
+  /**
+   * Returns the days on which this airspace is active.  Unlike
+   * IsActive(), this does not change after construction, and may
+   * be evaluated by any thread against its own #AirspaceActivity.
+   */
+  AirspaceActivity GetDays() const {
+    return days_of_operation;
+  }
+
   /**
    * Get type of airspace
    *
@@ -372,7 +381,7 @@ public:
 
 protected:
   /** Project border */
-  void Project(const FlatProjection &tp);
+  virtual void Project(const FlatProjection &tp);
 
 private:
   /**
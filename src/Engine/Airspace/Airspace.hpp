@@ -46,7 +46,7 @@ class FlatProjection;
  * Airspace is an envelope, containing bounding box information for
  * use with high performance search structures.
  */
-class Airspace final : public FlatBoundingBox
+class Airspace : public FlatBoundingBox
 {
   AbstractAirspace *airspace;
 
@@ -0,0 +1,135 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceAltitudeIndex.hpp"
+#include "AbstractAirspace.hpp"
+
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace bgi = boost::geometry::index;
+
+constexpr double AirspaceAltitudeIndex::MIN_ALTITUDE;
+constexpr double AirspaceAltitudeIndex::MAX_ALTITUDE;
+
+gcc_const
+static double
+Clamp(double altitude)
+{
+  return std::min(std::max(altitude, AirspaceAltitudeIndex::MIN_ALTITUDE),
+                  AirspaceAltitudeIndex::MAX_ALTITUDE);
+}
+
+gcc_pure
+static double
+GetLowerBound(const AirspaceAltitude &altitude)
+{
+  /* AGL altitudes depend on the terrain below the aircraft, see
+     AirspaceAltitude::GetAltitude() */
+  return altitude.reference == AltitudeReference::AGL
+    ? AirspaceAltitudeIndex::MIN_ALTITUDE
+    : Clamp(altitude.altitude);
+}
+
+gcc_pure
+static double
+GetUpperBound(const AirspaceAltitude &altitude)
+{
+  return altitude.reference == AltitudeReference::AGL
+    ? AirspaceAltitudeIndex::MAX_ALTITUDE
+    : Clamp(altitude.altitude);
+}
+
+gcc_pure
+static double
+GetLowerBound(const AbstractAirspace &airspace)
+{
+  /* don't rely on the top being above the base */
+  return std::min(GetLowerBound(airspace.GetBase()),
+                  GetUpperBound(airspace.GetTop()));
+}
+
+gcc_pure
+static double
+GetUpperBound(const AbstractAirspace &airspace)
+{
+  return std::max(GetUpperBound(airspace.GetTop()),
+                  GetLowerBound(airspace.GetBase()));
+}
+
+AirspaceAltitudeIndex::Item::Item(const Airspace &airspace)
+  :Airspace(airspace),
+   lower(GetLowerBound(airspace.GetAirspace())),
+   upper(GetUpperBound(airspace.GetAirspace())) {}
+
+bool
+AirspaceAltitudeIndex::Item::IsUpToDate() const
+{
+  const AbstractAirspace &airspace = GetAirspace();
+  return lower == GetLowerBound(airspace) && upper == GetUpperBound(airspace);
+}
+
+void
+AirspaceAltitudeIndex::Insert(const Airspace &airspace)
+{
+  tree.insert(Item(airspace));
+}
+
+void
+AirspaceAltitudeIndex::Assign(const std::vector<Airspace> &airspaces)
+{
+  std::vector<Item> items;
+  items.reserve(airspaces.size());
+  for (const auto &i : airspaces)
+    items.emplace_back(i);
+
+  tree = Tree(items.begin(), items.end());
+}
+
+bool
+AirspaceAltitudeIndex::IsUpToDate() const
+{
+  return std::all_of(tree.begin(), tree.end(), [](const Item &item){
+      return item.IsUpToDate();
+    });
+}
+
+unsigned
+AirspaceAltitudeIndex::Update()
+{
+  std::vector<Item> modified;
+  std::copy(tree.qbegin(bgi::satisfies([](const Item &item){
+          return !item.IsUpToDate();
+        })),
+    tree.qend(), std::back_inserter(modified));
+
+  for (const auto &item : modified) {
+    tree.remove(item);
+    tree.insert(Item(static_cast<const Airspace &>(item)));
+  }
+
+  return modified.size();
+}
@@ -0,0 +1,181 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef AIRSPACE_ALTITUDE_INDEX_HPP
+#define AIRSPACE_ALTITUDE_INDEX_HPP
+
+#include "Airspace.hpp"
+#include "Compiler.h"
+
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/range/iterator_range_core.hpp>
+
+#include <utility>
+#include <vector>
+
+/**
+ * A three-dimensional R-tree over the airspace envelopes: the flat
+ * bounding box plus the altitude range.  Queries with an altitude
+ * band skip airspaces which are entirely above or below it, without
+ * looking at them.
+ *
+ * The altitude range is conservative: altitudes referenced to the
+ * terrain (AGL) are considered unlimited, because they depend on the
+ * terrain elevation below the aircraft.  Flight levels depend on the
+ * QNH; call Update() after it has changed.
+ */
+class AirspaceAltitudeIndex {
+public:
+  /**
+   * Unlimited altitude ranges are clamped to these values [m].
+   */
+  static constexpr double MIN_ALTITUDE = -100000;
+  static constexpr double MAX_ALTITUDE = 100000;
+
+  /**
+   * An #Airspace envelope with the altitude range it had when it was
+   * inserted.
+   */
+  class Item final : public Airspace {
+    double lower, upper;
+
+  public:
+    explicit Item(const Airspace &airspace);
+
+    double GetLower() const {
+      return lower;
+    }
+
+    double GetUpper() const {
+      return upper;
+    }
+
+    /**
+     * Does the altitude range still match the airspace?
+     */
+    gcc_pure
+    bool IsUpToDate() const;
+  };
+
+private:
+  typedef boost::geometry::model::point<double, 3,
+                                        boost::geometry::cs::cartesian> Point;
+  typedef boost::geometry::model::box<Point> Box;
+
+  struct ItemIndexable {
+    typedef Box result_type;
+
+    result_type operator()(const Item &item) const {
+      return MakeBox(item, item.GetLower(), item.GetUpper());
+    }
+  };
+
+  typedef boost::geometry::index::rtree<Item,
+                                        boost::geometry::index::rstar<16>,
+                                        ItemIndexable> Tree;
+
+  Tree tree;
+
+public:
+  typedef Tree::const_query_iterator const_iterator;
+  typedef boost::iterator_range<const_iterator> const_iterator_range;
+
+  bool IsEmpty() const {
+    return tree.empty();
+  }
+
+  void Clear() {
+    tree.clear();
+  }
+
+  void Insert(const Airspace &airspace);
+
+  /**
+   * Replace the contents with the given airspaces.  The tree is
+   * bulk-loaded with the packing algorithm, which is faster than
+   * inserting them one by one.
+   */
+  void Assign(const std::vector<Airspace> &airspaces);
+
+  /**
+   * Do the altitude ranges of all items still match their airspaces?
+   */
+  gcc_pure
+  bool IsUpToDate() const;
+
+  /**
+   * Re-read the altitudes of all airspaces and re-insert the ones
+   * whose altitude range has changed.
+   *
+   * @return the number of re-inserted airspaces
+   */
+  unsigned Update();
+
+  /**
+   * Returns an empty range.
+   */
+  gcc_pure
+  const_iterator_range QueryNone() const {
+    return {tree.qend(), tree.qend()};
+  }
+
+  /**
+   * Query the airspaces whose envelope overlaps the given flat
+   * bounding box and whose altitude range overlaps the given band.
+   */
+  gcc_pure
+  const_iterator_range QueryOverlapping(const FlatBoundingBox &box,
+                                        double min_altitude,
+                                        double max_altitude) const {
+    const Box query = MakeBox(box, min_altitude, max_altitude);
+    return {tree.qbegin(boost::geometry::index::intersects(query)),
+        tree.qend()};
+  }
+
+  /**
+   * Like QueryOverlapping(), but return only the items the given
+   * predicate accepts.
+   */
+  template<typename P>
+  gcc_pure
+  const_iterator_range QueryOverlapping(const FlatBoundingBox &box,
+                                        double min_altitude,
+                                        double max_altitude,
+                                        P &&predicate) const {
+    namespace bgi = boost::geometry::index;
+    const Box query = MakeBox(box, min_altitude, max_altitude);
+    return {tree.qbegin(bgi::intersects(query) &&
+                        bgi::satisfies(std::forward<P>(predicate))),
+        tree.qend()};
+  }
+
+private:
+  static Box MakeBox(const FlatBoundingBox &box,
+                     double min_altitude, double max_altitude) {
+    return Box(Point(box.GetLeft(), box.GetBottom(), min_altitude),
+               Point(box.GetRight(), box.GetTop(), max_altitude));
+  }
+};
+
+#endif
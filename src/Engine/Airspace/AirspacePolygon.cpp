@@ -51,6 +51,8 @@ AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts,
   } else {
     is_convex = TriState::UNKNOWN;
   }
+
+  edge_index.Update(m_border);
 }
 
 const GeoPoint
@@ -79,10 +81,17 @@ AirspacePolygon::GetCenter() const
   return GeoPoint(Angle::Native(lon), Angle::Native(lat));
 }
 
+void
+AirspacePolygon::Project(const FlatProjection &projection)
+{
+  AbstractAirspace::Project(projection);
+  edge_index.UpdateFlat(m_border);
+}
+
 bool
 AirspacePolygon::Inside(const GeoPoint &loc) const
 {
-  return m_border.IsInside(loc);
+  return edge_index.IsInside(loc);
 }
 
 AirspaceIntersectionVector
@@ -94,13 +103,21 @@ AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end,
 
   AirspaceIntersectSort sorter(start, *this);
 
-  for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it) {
-
-    const FlatRay r_seg(it->GetFlatLocation(), (it + 1)->GetFlatLocation());
+  const auto f = [this, &ray, &projection, &sorter](unsigned i){
+    const FlatRay r_seg(m_border[i].GetFlatLocation(),
+                        m_border[i + 1].GetFlatLocation());
     auto t = ray.DistinctIntersection(r_seg);
     if (t >= 0)
       sorter.add(t, projection.Unproject(ray.Parametric(t)));
-  }
+  };
+
+  FlatBoundingBox ray_box(ray.point);
+  ray_box.Expand(ray.point + ray.vector);
+
+  if (!edge_index.VisitEdges(ray_box, m_border.size() - 1, f))
+    /* not projected yet: check all edges */
+    for (unsigned i = 0; i + 1 < m_border.size(); ++i)
+      f(i);
 
   return sorter.all();
 }
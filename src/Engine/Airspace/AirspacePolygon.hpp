@@ -24,6 +24,8 @@
 #define AIRSPACEPOLYGON_HPP
 
 #include "AbstractAirspace.hpp"
+#include "Geo/PolygonEdgeIndex.hpp"
+
 #include <vector>
 
 #ifdef DO_PRINT
@@ -32,6 +34,12 @@
 
 /** General polygon form airspace */
 class AirspacePolygon final : public AbstractAirspace {
+  /**
+   * Speeds up Inside() and Intersects() on polygons with many
+   * vertices.
+   */
+  PolygonEdgeIndex edge_index;
+
 public:
   /**
    * Constructor.  For testing, pts vector is a cloud of points,
@@ -54,6 +62,9 @@ public:
   GeoPoint ClosestPoint(const GeoPoint &loc,
                         const FlatProjection &projection) const override;
 
+protected:
+  void Project(const FlatProjection &projection) override;
+
 public:
 #ifdef DO_PRINT
   friend std::ostream &operator<<(std::ostream &f,
@@ -51,6 +51,13 @@ AirspaceFilterData::Match(const GeoPoint &location,
       return false;
   }
 
+  if (HasAltitudeBand() &&
+      as.GetBase().reference != AltitudeReference::AGL &&
+      as.GetTop().reference != AltitudeReference::AGL &&
+      (as.GetBase().altitude > max_altitude ||
+       as.GetTop().altitude < min_altitude))
+    return false;
+
   return true;
 }
 
@@ -103,12 +110,22 @@ FilterAirspaces(const Airspaces &airspaces, const GeoPoint &location,
                                           filter);
   AirspaceSelectInfoVector result;
 
-  auto range = filter.distance < 0
-    ? airspaces.QueryAll()
-    : airspaces.QueryWithinRange(location, filter.distance);
-  for (const auto &i : range)
-    if (predicate(i.GetAirspace()))
-      result.emplace_back(i.GetAirspace());
+  if (filter.distance >= 0 && filter.HasAltitudeBand()) {
+    /* the altitude index skips airspaces outside the band without
+       looking at them */
+    for (const auto &i : airspaces.QueryWithinRange(location, filter.distance,
+                                                    filter.min_altitude,
+                                                    filter.max_altitude))
+      if (predicate(i.GetAirspace()))
+        result.emplace_back(i.GetAirspace());
+  } else {
+    auto range = filter.distance < 0
+      ? airspaces.QueryAll()
+      : airspaces.QueryWithinRange(location, filter.distance);
+    for (const auto &i : range)
+      if (predicate(i.GetAirspace()))
+        result.emplace_back(i.GetAirspace());
+  }
 
   if (filter.direction.IsNegative() && filter.distance < 0)
     SortByName(result);
@@ -64,11 +64,25 @@ struct AirspaceFilterData {
    */
   double distance;
 
+  /**
+   * Show only airspaces whose altitude range overlaps this band [m
+   * MSL].  Airspaces referenced to the terrain always match.  An
+   * empty band (#max_altitude below #min_altitude) disables this
+   * filter.
+   */
+  double min_altitude, max_altitude;
+
   void Clear() {
     cls = AirspaceClass::AIRSPACECLASSCOUNT;
     name_prefix = nullptr;
     direction = Angle::Native(-1);
     distance = -1;
+    min_altitude = 0;
+    max_altitude = -1;
+  }
+
+  bool HasAltitudeBand() const {
+    return max_altitude >= min_altitude;
   }
 
   gcc_pure
@@ -28,12 +28,16 @@
 #include "AirspaceAircraftPerformance.hpp"
 #include "Task/Stats/TaskStats.hpp"
 
+#include <chrono>
+
 #define CRUISE_FILTER_FACT 0.5
 
 AirspaceWarningManager::AirspaceWarningManager(const AirspaceWarningConfig &_config,
                                                const Airspaces &_airspaces)
   :airspaces(_airspaces), serial(0)
 {
+  statistics.Reset();
+
   /* force filter initialisation in the first SetConfig() call */
   config.warning_time = -1;
 
@@ -132,15 +136,38 @@ AirspaceWarningManager::Update(const AircraftState& state,
     return false;
   }
 
+  const auto start_time = std::chrono::steady_clock::now();
+
   // save old state
   for (auto &w : warnings)
     w.SaveState();
 
+  // predictions from strongest to weakest alerts
+  PredictionArray predictions;
+  PredictGlide(state, glide_polar, predictions);
+  PredictFilter(state, circling, predictions);
+  PredictTask(state, glide_polar, task_stats, predictions);
+
+  /* find the candidates for all predictions (and the interior check)
+     with one query */
+  GeoPoint ends[MAX_PREDICTIONS];
+  for (unsigned i = 0; i < predictions.size(); ++i)
+    ends[i] = predictions[i].location;
+
+  /* all checks ignore airspaces above the ceiling (see
+     AirspaceIntersectionWarningVisitor::ExcludeAltitude()) */
+  const double ceiling = GetCeiling(state);
+  airspaces.QueryBatch(state.location, ends, predictions.size(),
+                       AirspaceAltitudeIndex::MIN_ALTITUDE,
+                       ceiling > 0
+                       ? ceiling
+                       : AirspaceAltitudeIndex::MAX_ALTITUDE,
+                       candidates);
+
   // check from strongest to weakest alerts
   UpdateInside(state, glide_polar);
-  UpdateGlide(state, glide_polar);
-  UpdateFilter(state, circling);
-  UpdateTask(state, glide_polar, task_stats);
+  for (unsigned i = 0; i < predictions.size(); ++i)
+    UpdatePredicted(state, predictions[i], 1u << i);
 
   // action changes
   for (auto it = warnings.begin(), end = warnings.end(); it != end;) {
@@ -158,6 +185,15 @@ AirspaceWarningManager::Update(const AircraftState& state,
   // sort by importance, most severe top
   warnings.sort();
 
+  const auto elapsed = std::chrono::steady_clock::now() - start_time;
+  const unsigned duration =
+    std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  ++statistics.n_updates;
+  statistics.n_candidates = candidates.size();
+  statistics.last_duration = duration;
+  statistics.max_duration = std::max(statistics.max_duration, duration);
+  statistics.total_duration += duration;
+
   return changed;
 }
 
@@ -270,19 +306,9 @@ private:
 };
 
 
-bool 
-AirspaceWarningManager::UpdatePredicted(const AircraftState& state, 
-                                         const GeoPoint &location_predicted,
-                                         const AirspaceAircraftPerformance &perf,
-                                         const AirspaceWarning::State warning_state,
-                                        const double max_time)
+double
+AirspaceWarningManager::GetCeiling(const AircraftState &state) const
 {
-  // this is the time limit of intrusions, beyond which we are not interested.
-  // it can be the minimum of the user set warning time, or the time of the 
-  // task segment
-
-  const auto max_time_limit = std::min(double(config.warning_time), max_time);
-
   // the ceiling is the max height for predicted intrusions, given
   // that you may be climbing.  the ceiling is nominally set at 1000m
   // above the current altitude, but the 1000m margin should be at
@@ -291,47 +317,65 @@ AirspaceWarningManager::UpdatePredicted(const AircraftState& state,
   // collected for it.  It is very unlikely users will have more than 1000m
   // in AltWarningMargin anyway.
 
-  const auto ceiling = state.altitude
+  return state.altitude
     + std::max((unsigned)1000, config.altitude_warning_margin);
+}
+
+bool 
+AirspaceWarningManager::UpdatePredicted(const AircraftState& state, 
+                                        const Prediction &prediction,
+                                        unsigned vector_mask)
+{
+  // this is the time limit of intrusions, beyond which we are not interested.
+  // it can be the minimum of the user set warning time, or the time of the 
+  // task segment
+
+  const auto max_time_limit = std::min(double(config.warning_time),
+                                       prediction.max_time);
 
-  AirspaceIntersectionWarningVisitor visitor(state, perf, 
-                                             *this, 
-                                             warning_state, max_time_limit,
-                                             ceiling);
+  AirspaceIntersectionWarningVisitor visitor(state, prediction.perf,
+                                             *this,
+                                             prediction.warning_state,
+                                             max_time_limit,
+                                             GetCeiling(state));
 
-  airspaces.VisitIntersecting(state.location, location_predicted, visitor);
+  // same as Airspaces::VisitIntersecting()
+  for (const auto &i : candidates)
+    if ((i.vectors & vector_mask) != 0 &&
+        visitor.SetIntersections(i.airspace->Intersects(state.location,
+                                                        prediction.location,
+                                                        GetProjection())))
+      visitor.Visit(i.airspace->GetAirspace());
 
   visitor.SetMode(true);
 
-  for (const auto &i : airspaces.QueryInside(state.location)) {
-    const AbstractAirspace &airspace = i.GetAirspace();
-    visitor.Visit(airspace);
-  }
+  for (const auto &i : candidates)
+    if (i.inside)
+      visitor.Visit(i.airspace->GetAirspace());
 
   return visitor.Found();
 }
 
 
-bool 
-AirspaceWarningManager::UpdateTask(const AircraftState &state,
-                                   const GlidePolar &glide_polar,
-                                   const TaskStats &task_stats)
+void
+AirspaceWarningManager::PredictTask(const AircraftState &state,
+                                    const GlidePolar &glide_polar,
+                                    const TaskStats &task_stats,
+                                    PredictionArray &predictions)
 {
   if (!glide_polar.IsValid())
-    return false;
+    return;
 
   const ElementStat &current_leg = task_stats.current_leg;
 
   if (!task_stats.task_valid || !current_leg.location_remaining.IsValid())
-    return false;
+    return;
 
   const GlideResult &solution = current_leg.solution_remaining;
   if (!solution.IsOk() || !solution.IsAchievable())
     /* glide solver failed, cannot continue */
-    return false;
+    return;
 
-  const AirspaceAircraftPerformance perf_task(glide_polar,
-                                              current_leg.solution_remaining);
   GeoPoint location_tp = current_leg.location_remaining;
   const auto time_remaining = solution.time_elapsed;
 
@@ -342,47 +386,44 @@ AirspaceWarningManager::UpdateTask(const AircraftState &state,
        the configured warning time */
     location_tp = state.location.IntermediatePoint(location_tp, max_distance);
 
-  return UpdatePredicted(state, location_tp, perf_task,
-                          AirspaceWarning::WARNING_TASK, time_remaining);
+  predictions.append({AirspaceWarning::WARNING_TASK, location_tp,
+        AirspaceAircraftPerformance(glide_polar, solution),
+        time_remaining});
 }
 
 
-bool 
-AirspaceWarningManager::UpdateFilter(const AircraftState& state, const bool circling)
+void
+AirspaceWarningManager::PredictFilter(const AircraftState& state,
+                                      const bool circling,
+                                      PredictionArray &predictions)
 {
   // update both filters even though we are using only one
   cruise_filter.Update(state);
   circling_filter.Update(state);
 
-  const GeoPoint location_predicted = circling?
-    circling_filter.GetPredictedState(prediction_time_filter).location:
-    cruise_filter.GetPredictedState(prediction_time_filter).location;
-
-  if (circling) 
-    return UpdatePredicted(state, location_predicted,
-                           AirspaceAircraftPerformance(circling_filter),
-                            AirspaceWarning::WARNING_FILTER, prediction_time_filter);
-  else
-    return UpdatePredicted(state, location_predicted,
-                           AirspaceAircraftPerformance(cruise_filter),
-                            AirspaceWarning::WARNING_FILTER, prediction_time_filter);
+  const AircraftStateFilter &filter = circling
+    ? circling_filter
+    : cruise_filter;
+
+  predictions.append({AirspaceWarning::WARNING_FILTER,
+        filter.GetPredictedState(prediction_time_filter).location,
+        AirspaceAircraftPerformance(filter),
+        prediction_time_filter});
 }
 
 
-bool 
-AirspaceWarningManager::UpdateGlide(const AircraftState &state,
-                                    const GlidePolar &glide_polar)
+void
+AirspaceWarningManager::PredictGlide(const AircraftState &state,
+                                     const GlidePolar &glide_polar,
+                                     PredictionArray &predictions) const
 {
   if (!glide_polar.IsValid())
-    return false;
-
-  const GeoPoint location_predicted = 
-    state.GetPredictedState(prediction_time_glide).location;
+    return;
 
-  const AirspaceAircraftPerformance perf_glide(glide_polar);
-  return UpdatePredicted(state, location_predicted,
-                          perf_glide,
-                          AirspaceWarning::WARNING_GLIDE, prediction_time_glide);
+  predictions.append({AirspaceWarning::WARNING_GLIDE,
+        state.GetPredictedState(prediction_time_glide).location,
+        AirspaceAircraftPerformance(glide_polar),
+        prediction_time_glide});
 }
 
 bool
@@ -394,8 +435,11 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
 
   bool found = false;
 
-  for (const auto &i : airspaces.QueryInside(state.location)) {
-    const AbstractAirspace &airspace = i.GetAirspace();
+  for (const auto &i : candidates) {
+    if (!i.inside)
+      continue;
+
+    const AbstractAirspace &airspace = i.airspace->GetAirspace();
 
     const AltitudeState &altitude = state;
     if (// ignore inactive airspaces
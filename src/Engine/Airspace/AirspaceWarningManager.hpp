@@ -24,16 +24,18 @@
 
 #include "AirspaceWarning.hpp"
 #include "AirspaceWarningConfig.hpp"
+#include "AirspaceAircraftPerformance.hpp"
+#include "Airspaces.hpp"
 #include "Util/AircraftStateFilter.hpp"
+#include "Util/TrivialArray.hxx"
 #include "Compiler.h"
 
 #include <list>
+#include <stdint.h>
 
 class TaskStats;
 class GlidePolar;
-class Airspaces;
 class FlatProjection;
-class AirspaceAircraftPerformance;
 
 /**
  * Class to detect and track airspace warnings
@@ -47,6 +49,70 @@ class AirspaceAircraftPerformance;
  *
  */
 class AirspaceWarningManager {
+public:
+  /**
+   * Diagnostic counters describing the cost of Update().
+   */
+  struct Statistics {
+    /**
+     * The number of Update() calls which ran the batch pass.
+     */
+    unsigned n_updates;
+
+    /**
+     * The number of candidate airspaces found by the last update.
+     */
+    unsigned n_candidates;
+
+    /**
+     * The duration of the last update [us].
+     */
+    unsigned last_duration;
+
+    /**
+     * The duration of the slowest update [us].
+     */
+    unsigned max_duration;
+
+    /**
+     * The sum of all update durations [us].
+     */
+    uint64_t total_duration;
+
+    void Reset() {
+      n_updates = n_candidates = 0;
+      last_duration = max_duration = 0;
+      total_duration = 0;
+    }
+  };
+
+private:
+  /**
+   * A predicted flight path vector, to be checked for airspace
+   * intrusions by UpdatePredicted().
+   */
+  struct Prediction {
+    AirspaceWarning::State warning_state;
+
+    GeoPoint location;
+
+    AirspaceAircraftPerformance perf{AirspaceAircraftPerformance::Simple()};
+
+    /**
+     * Time limit of intercept [s].
+     */
+    double max_time;
+  };
+
+  /**
+   * Task, filter and glide.
+   */
+  static constexpr unsigned MAX_PREDICTIONS = 3;
+  static_assert(MAX_PREDICTIONS <= Airspaces::MAX_BATCH_VECTORS,
+                "Too many predictions for Airspaces::QueryBatch()");
+
+  typedef TrivialArray<Prediction, MAX_PREDICTIONS> PredictionArray;
+
   AirspaceWarningConfig config;
 
   const Airspaces &airspaces;
@@ -66,6 +132,14 @@ class AirspaceWarningManager {
    */
   unsigned serial;
 
+  /**
+   * The airspaces found by the batch query in Update().  This is a
+   * member only to avoid reallocating it for each update.
+   */
+  Airspaces::BatchVector candidates;
+
+  Statistics statistics;
+
 public:
   typedef AirspaceWarningList::const_iterator const_iterator;
 
@@ -98,6 +172,10 @@ public:
     return serial;
   }
 
+  const Statistics &GetStatistics() const {
+    return statistics;
+  }
+
   /**
    * Reset warning list and filter (as in new flight)
    *
@@ -261,17 +339,45 @@ public:
   bool IsActive(const AbstractAirspace &airspace) const;
 
 private:
-  bool UpdateTask(const AircraftState &state, const GlidePolar &glide_polar,
-                  const TaskStats &task_stats);
-  bool UpdateFilter(const AircraftState& state, const bool circling);
-  bool UpdateGlide(const AircraftState& state, const GlidePolar &glide_polar);
+  /**
+   * Append the vector predicted by the task's current leg.
+   */
+  void PredictTask(const AircraftState &state, const GlidePolar &glide_polar,
+                   const TaskStats &task_stats, PredictionArray &predictions);
+
+  /**
+   * Update the state filters and append the vector they predict.
+   */
+  void PredictFilter(const AircraftState &state, const bool circling,
+                     PredictionArray &predictions);
+
+  /**
+   * Append the vector predicted by the current track and speed.
+   */
+  void PredictGlide(const AircraftState &state, const GlidePolar &glide_polar,
+                    PredictionArray &predictions) const;
+
+  /**
+   * Returns the maximum base altitude of airspaces to be checked.
+   */
+  gcc_pure
+  double GetCeiling(const AircraftState &state) const;
+
+  /**
+   * Check the airspaces in #candidates the aircraft is inside.
+   */
   bool UpdateInside(const AircraftState& state, const GlidePolar &glide_polar);
 
-  bool UpdatePredicted(const AircraftState& state, 
-                       const GeoPoint &location_predicted,
-                       const AirspaceAircraftPerformance &perf,
-                       const AirspaceWarning::State warning_state,
-                       double max_time);
+  /**
+   * Check the airspaces in #candidates for intrusions along one
+   * predicted vector.
+   *
+   * @param vector_mask the bit of this vector in
+   * Airspaces::BatchItem::vectors
+   */
+  bool UpdatePredicted(const AircraftState& state,
+                       const Prediction &prediction,
+                       unsigned vector_mask);
 };
 
 #endif
@@ -22,65 +22,48 @@
 
 #include "Airspaces.hpp"
 #include "AbstractAirspace.hpp"
-#include "AirspaceIntersectionVisitor.hpp"
 #include "Predicate/AirspacePredicate.hpp"
-#include "Navigation/Aircraft.hpp"
 
-#include <boost/geometry/geometries/linestring.hpp>
-#include <boost/geometry/algorithms/intersection.hpp>
 #include <boost/geometry/strategies/strategies.hpp>
 
-namespace bgi = boost::geometry::index;
+#include <algorithm>
+#include <atomic>
 
-Airspaces::const_iterator_range
-Airspaces::QueryWithinRange(const GeoPoint &location, double range) const
+/**
+ * Is this the only reference to the snapshot?  The fence pairs with
+ * the (releasing) decrement of the reference count by the last
+ * reader, so all of its accesses to the snapshot happen before the
+ * caller modifies it.  shared_ptr::unique() does not guarantee that.
+ */
+gcc_pure
+static bool
+IsExclusive(const std::shared_ptr<AirspacesSnapshot> &snapshot)
 {
-  if (IsEmpty())
-    // nothing to do
-    return {airspace_tree.qend(), airspace_tree.qend()};
+  if (snapshot.use_count() != 1)
+    return false;
 
-  const FlatBoundingBox box = task_projection.ProjectSquare(location, range);
-  return {airspace_tree.qbegin(bgi::intersects(box)), airspace_tree.qend()};
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
 }
 
-Airspaces::const_iterator_range
-Airspaces::QueryIntersecting(const GeoPoint &a, const GeoPoint &b) const
+AirspacesSnapshot &
+Airspaces::Modify()
 {
-  if (IsEmpty())
-    // nothing to do
-    return {airspace_tree.qend(), airspace_tree.qend()};
+  if (!IsExclusive(snapshot))
+    /* somebody else holds a reference to the current snapshot,
+       which must not be modified: copy it */
+    snapshot = std::make_shared<AirspacesSnapshot>(*snapshot);
 
-  // TODO: use StaticArray instead of std::vector
-  boost::geometry::model::linestring<FlatGeoPoint> line;
-  line.push_back(task_projection.ProjectInteger(a));
-  line.push_back(task_projection.ProjectInteger(b));
-
-  return {airspace_tree.qbegin(bgi::intersects(line)), airspace_tree.qend()};
+  return *snapshot;
 }
 
 void
-Airspaces::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
-                             bool include_inside,
-                             AirspaceIntersectionVisitor &visitor) const
+Airspaces::ResetSnapshot()
 {
-  for (const auto &i : QueryIntersecting(loc, end))
-    if (visitor.SetIntersections(i.Intersects(loc, end, task_projection)))
-      visitor.Visit(i.GetAirspace());
-
-  if (include_inside) {
-    for (const auto &i : QueryInside(loc)) {
-      if (i.IsInside(end)) {
-        /* the vector is completely inside the airspace, and thus does
-           not intersect with airspace's outline: on caller's request,
-           report an intersection */
-        AirspaceIntersectionVector v;
-        v.reserve(1);
-        v.emplace_back(loc, end);
-        visitor.SetIntersections(std::move(v));
-        visitor.Visit(i.GetAirspace());
-      }
-    }
-  }
+  if (IsExclusive(snapshot))
+    snapshot->ClearTrees();
+  else
+    snapshot = std::make_shared<AirspacesSnapshot>();
 }
 
 void
@@ -90,6 +73,14 @@ Airspaces::Optimise()
     /* avoid assertion failure in uninitialised task_projection */
     return;
 
+  if (owns_children) {
+    if (!owner)
+      owner = std::make_shared<AirspacesSnapshot::Owner>();
+
+    for (AbstractAirspace *i : tmp_as)
+      owner->Add(i);
+  }
+
   if (!owns_children || task_projection.Update()) {
     // dont update task_projection if not owner!
 
@@ -99,12 +90,31 @@ Airspaces::Optimise()
     for (const auto &i : QueryAll())
       tmp_as.push_back(&i.GetAirspace());
 
-    airspace_tree.clear();
+    ResetSnapshot();
   }
 
-  for (AbstractAirspace *i : tmp_as) {
-    Airspace as(*i, task_projection);
-    airspace_tree.insert(as);
+  AirspacesSnapshot &s = Modify();
+  s.projection = task_projection;
+  if (owns_children)
+    s.owner = owner;
+
+  if (s.airspace_tree.empty()) {
+    /* bulk-load both trees with the packing algorithm; this is a lot
+       faster than inserting the airspaces one by one, and the
+       resulting trees are better balanced */
+    AirspaceVector v;
+    v.reserve(tmp_as.size());
+    for (AbstractAirspace *i : tmp_as)
+      v.emplace_back(*i, task_projection);
+
+    s.airspace_tree = AirspaceTree(v.begin(), v.end());
+    s.altitude_index.Assign(v);
+  } else {
+    for (AbstractAirspace *i : tmp_as) {
+      Airspace as(*i, task_projection);
+      s.airspace_tree.insert(as);
+      s.altitude_index.Insert(as);
+    }
   }
 
   tmp_as.clear();
@@ -149,28 +159,11 @@ Airspaces::Clear()
     tmp_as.pop_front();
   }
 
-  // delete items in the tree
-  if (owns_children) {
-    for (const auto &i : QueryAll()) {
-      Airspace a = i;
-      a.Destroy();
-    }
-  }
-
-  // then delete the tree
-  airspace_tree.clear();
-}
-
-unsigned
-Airspaces::GetSize() const
-{
-  return airspace_tree.size();
-}
-
-bool
-Airspaces::IsEmpty() const
-{
-  return airspace_tree.empty() && tmp_as.empty();
+  /* the items in the tree are deleted together with the last
+     snapshot referring to them */
+  owner.reset();
+  ResetSnapshot();
+  snapshot->owner.reset();
 }
 
 void
@@ -181,6 +174,8 @@ Airspaces::SetFlightLevels(const AtmosphericPressure &press)
 
     for (auto &v : QueryAll())
       v.SetFlightLevel(press);
+
+    UpdateAltitudeIndex();
   }
 }
 
@@ -202,6 +197,13 @@ Airspaces::ClearClearances()
     v.ClearClearance();
 }
 
+void
+Airspaces::UpdateAltitudeIndex()
+{
+  if (!snapshot->altitude_index.IsUpToDate())
+    Modify().altitude_index.Update();
+}
+
 gcc_pure
 static bool
 AirspacePointersEquals(const Airspace &a, const Airspace &b)
@@ -222,7 +224,7 @@ inline AirspacesInterface::AirspaceVector
 Airspaces::AsVector() const
 {
   AirspaceVector v;
-  v.reserve(airspace_tree.size());
+  v.reserve(GetSize());
 
   for (const auto &i : QueryAll())
     v.push_back(i);
@@ -245,55 +247,30 @@ Airspaces::SynchroniseInRange(const Airspaces &master,
     if (condition(i.GetAirspace()))
       contents_master.push_back(i);
 
-  if (CompareAirspaceVectors(contents_master, AsVector()))
+  if (CompareAirspaceVectors(contents_master, AsVector())) {
+    /* the master may have changed the flight levels */
+    UpdateAltitudeIndex();
     return false;
+  }
 
   for (auto &i : QueryAll())
     i.ClearClearance();
-  airspace_tree.clear();
 
-  for (const auto &i : contents_master)
-    airspace_tree.insert(i);
+  ResetSnapshot();
 
-  ++serial;
+  AirspacesSnapshot &s = *snapshot;
+  s.projection = task_projection;
 
-  return true;
-}
+  /* keep the master's airspaces alive as long as a snapshot of this
+     copy refers to them */
+  s.owner = master.owner;
 
-Airspaces::const_iterator_range
-Airspaces::QueryInside(const GeoPoint &loc) const
-{
-  if (IsEmpty())
-    // nothing to do
-    return {airspace_tree.qend(), airspace_tree.qend()};
-
-  const auto flat_location = task_projection.ProjectInteger(loc);
-  const FlatBoundingBox box(flat_location, flat_location);
-
-  const auto _begin =
-    airspace_tree.qbegin(bgi::intersects(box) &&
-                         bgi::satisfies([&loc](const Airspace &as){
-                             return as.IsInside(loc);
-                           }));
-
-  return {_begin, airspace_tree.qend()};
-}
-
-Airspaces::const_iterator_range
-Airspaces::QueryInside(const AircraftState &aircraft) const
-{
-  if (IsEmpty())
-    // nothing to do
-    return {airspace_tree.qend(), airspace_tree.qend()};
-
-  const auto flat_location = task_projection.ProjectInteger(aircraft.location);
-  const FlatBoundingBox box(flat_location, flat_location);
+  for (const auto &i : contents_master) {
+    s.airspace_tree.insert(i);
+    s.altitude_index.Insert(i);
+  }
 
-  const auto _begin =
-    airspace_tree.qbegin(bgi::intersects(box) &&
-                         bgi::satisfies([&aircraft](const Airspace &as){
-                             return as.IsInside(aircraft);
-                           }));
+  ++serial;
 
-  return {_begin, airspace_tree.qend()};
+  return true;
 }
@@ -24,6 +24,7 @@
 #define XCSOAR_AIRSPACES_HPP
 
 #include "AirspacesInterface.hpp"
+#include "AirspacesSnapshot.hpp"
 #include "AirspaceActivity.hpp"
 #include "Util/Serial.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
@@ -31,6 +32,7 @@
 #include "Compiler.h"
 
 #include <deque>
+#include <memory>
 
 class RasterTerrain;
 class AirspaceIntersectionVisitor;
@@ -46,9 +48,20 @@ class Airspaces : public AirspacesInterface {
 
   const bool owns_children;
 
-  AirspaceTree airspace_tree;
   TaskProjection task_projection;
 
+  /**
+   * The search trees.  This object is shared with callers of
+   * GetSnapshot(); if it is, it gets copied before it is modified.
+   */
+  std::shared_ptr<AirspacesSnapshot> snapshot;
+
+  /**
+   * Owns the airspaces in the tree (if #owns_children).  It is
+   * shared with all snapshots referring to them.
+   */
+  std::shared_ptr<AirspacesSnapshot::Owner> owner;
+
   std::deque<AbstractAirspace *> tmp_as;
 
   /**
@@ -68,13 +81,15 @@ public:
    * @return empty Airspaces class.
    */
   Airspaces(bool _owns_children=true)
-    :qnh(AtmosphericPressure::Zero()), owns_children(_owns_children) {}
+    :qnh(AtmosphericPressure::Zero()), owns_children(_owns_children),
+     snapshot(std::make_shared<AirspacesSnapshot>()) {}
 
   Airspaces(const Airspaces &) = delete;
 
   /**
    * Destructor.
-   * This also destroys Airspace objects contained in the tree or temporary buffer
+   * This also destroys Airspace objects contained in the tree or
+   * temporary buffer, unless a snapshot still refers to them.
    */
   ~Airspaces() {
     Clear();
@@ -85,7 +100,8 @@ public:
   }
 
   /**
-   * Add airspace to the internal airspace tree.
+   * Stage an airspace for insertion into the internal airspace tree;
+   * it becomes visible after the next Optimise() call.
    * The airspace is not copied; ownership is transferred to this class if
    * m_owner is true
    *
@@ -97,6 +113,10 @@ public:
    * Re-organise the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
    * any searches, but can be done once after a batch insert/delete.
+   *
+   * If the tree is empty (or the projection has changed), it is
+   * bulk-loaded with the packing algorithm, which is faster and
+   * results in a better tree than inserting one by one.
    */
   void Optimise();
 
@@ -112,7 +132,9 @@ public:
    * @return Number of airspaces in tree
    */
   gcc_pure
-  unsigned GetSize() const;
+  unsigned GetSize() const {
+    return snapshot->GetSize();
+  }
 
   /**
    * Whether airspace store is empty
@@ -120,7 +142,9 @@ public:
    * @return True if no airspace stored
    */
   gcc_pure
-  bool IsEmpty() const;
+  bool IsEmpty() const {
+    return snapshot->IsEmpty() && tmp_as.empty();
+  }
 
   /**
    * Set terrain altitude for all AGL-referenced airspace altitudes
@@ -144,67 +168,108 @@ public:
    */
   void SetActivity(const AirspaceActivity mask);
 
-  gcc_pure
-  const_iterator_range QueryAll() const {
-    auto predicate = boost::geometry::index::satisfies([](const Airspace &){
-        return true;
-      });
-    return {airspace_tree.qbegin(predicate), airspace_tree.qend()};
+  /**
+   * Obtain a reference to the current search trees.  The snapshot
+   * will not be modified (this object copies it before the next
+   * change), and it keeps the airspaces it refers to alive.
+   *
+   * This method must be called by the thread which modifies this
+   * object (or with its lock held), but the trees of the returned
+   * snapshot may be queried by any thread without locking.  See
+   * #AirspacesSnapshot for the airspace state which is still
+   * modified in place.
+   */
+  std::shared_ptr<const AirspacesSnapshot> GetSnapshot() const {
+    return snapshot;
   }
 
   /**
-   * Query airspaces within range of location.
-   *
-   * @param loc location of origin of search
-   * @param range distance in meters of search radius
+   * Returns the current search trees without taking a reference.
+   * Unlike GetSnapshot(), the result is only valid until the next
+   * modification; like the query methods below, this is meant for
+   * the modifying thread.
    */
+  const AirspacesSnapshot &GetCurrentSnapshot() const {
+    return *snapshot;
+  }
+
+  /* the following query methods are shortcuts for querying the
+     current snapshot; see #AirspacesSnapshot */
+
+  gcc_pure
+  const_iterator_range QueryAll() const {
+    return snapshot->QueryAll();
+  }
+
   gcc_pure
   const_iterator_range QueryWithinRange(const GeoPoint &location,
-                                        double range) const;
+                                        double range) const {
+    return snapshot->QueryWithinRange(location, range);
+  }
 
-  /**
-   * Query airspaces intersecting the vector (bounding box check
-   * only).  The result is in no specific order.
-   */
   gcc_pure
   const_iterator_range QueryIntersecting(const GeoPoint &a,
-                                         const GeoPoint &b) const;
+                                         const GeoPoint &b) const {
+    return snapshot->QueryIntersecting(a, b);
+  }
+
+  gcc_pure
+  AirspaceAltitudeIndex::const_iterator_range
+  QueryWithinRange(const GeoPoint &location, double range,
+                   double min_altitude, double max_altitude) const {
+    return snapshot->QueryWithinRange(location, range,
+                                      min_altitude, max_altitude);
+  }
+
+  gcc_pure
+  AirspaceAltitudeIndex::const_iterator_range
+  QueryIntersecting(const GeoPoint &a, const GeoPoint &b,
+                    double min_altitude, double max_altitude) const {
+    return snapshot->QueryIntersecting(a, b, min_altitude, max_altitude);
+  }
 
-  /**
-   * Call visitor class on airspaces intersected by vector.
-   * Note that the visitor is not instantiated separately for each match
-   *
-   * @param loc location of origin of search
-   * @param end end of line along with to search for intersections
-   * @param include_inside visit airspaces if the vector is completely
-   * inside (i.e. no intersection with airspace outline)
-   * @param visitor visitor class to call on airspaces intersected by line
-   */
   void VisitIntersecting(const GeoPoint &location, const GeoPoint &end,
                          bool include_inside,
-                         AirspaceIntersectionVisitor &visitor) const;
+                         AirspaceIntersectionVisitor &visitor) const {
+    snapshot->VisitIntersecting(location, end, include_inside, visitor);
+  }
 
   void VisitIntersecting(const GeoPoint &location, const GeoPoint &end,
                          AirspaceIntersectionVisitor &visitor) const {
     VisitIntersecting(location, end, false, visitor);
   }
 
-  /**
-   * Query airspaces this location is inside.
-   *
-   * @param loc location of origin of search
-   */
+  void VisitIntersecting(const GeoPoint &location, const GeoPoint &end,
+                         double min_altitude, double max_altitude,
+                         bool include_inside,
+                         AirspaceIntersectionVisitor &visitor) const {
+    snapshot->VisitIntersecting(location, end, min_altitude, max_altitude,
+                                include_inside, visitor);
+  }
+
   gcc_pure
-  const_iterator_range QueryInside(const GeoPoint &location) const;
+  const_iterator_range QueryInside(const GeoPoint &location) const {
+    return snapshot->QueryInside(location);
+  }
 
-  /**
-   * Query airspaces the aircraft is inside (taking altitude into
-   * account).
-   *
-   * @param loc location of origin of search
-   */
   gcc_pure
-  const_iterator_range QueryInside(const AircraftState &aircraft) const;
+  const_iterator_range QueryInside(const AircraftState &aircraft) const {
+    return snapshot->QueryInside(aircraft);
+  }
+
+  typedef AirspacesSnapshot::BatchItem BatchItem;
+  typedef AirspacesSnapshot::BatchVector BatchVector;
+
+  static constexpr unsigned MAX_BATCH_VECTORS =
+    AirspacesSnapshot::MAX_BATCH_VECTORS;
+
+  void QueryBatch(const GeoPoint &location,
+                  const GeoPoint *ends, unsigned n_ends,
+                  double min_altitude, double max_altitude,
+                  BatchVector &dest) const {
+    snapshot->QueryBatch(location, ends, n_ends,
+                         min_altitude, max_altitude, dest);
+  }
 
   const FlatProjection &GetProjection() const {
     return task_projection;
@@ -230,6 +295,23 @@ public:
                           const AirspacePredicate &condition);
 
 private:
+  /**
+   * Returns the current snapshot for modification, copying it first
+   * if it is shared.
+   */
+  AirspacesSnapshot &Modify();
+
+  /**
+   * Replace the current snapshot with an empty one.
+   */
+  void ResetSnapshot();
+
+  /**
+   * Re-insert the airspaces whose altitude range has changed into
+   * the altitude index.
+   */
+  void UpdateAltitudeIndex();
+
   gcc_pure
   AirspaceVector AsVector() const;
 };
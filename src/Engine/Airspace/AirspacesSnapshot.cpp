@@ -0,0 +1,240 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspacesSnapshot.hpp"
+#include "AbstractAirspace.hpp"
+#include "AirspaceIntersectionVisitor.hpp"
+#include "Navigation/Aircraft.hpp"
+
+#include <boost/geometry/geometries/linestring.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <assert.h>
+
+namespace bgi = boost::geometry::index;
+
+AirspacesSnapshot::Owner::~Owner()
+{
+  for (AbstractAirspace *i : airspaces)
+    delete i;
+}
+
+AirspacesSnapshot::const_iterator_range
+AirspacesSnapshot::QueryWithinRange(const GeoPoint &location, double range) const
+{
+  if (IsEmpty())
+    // nothing to do
+    return {airspace_tree.qend(), airspace_tree.qend()};
+
+  const FlatBoundingBox box = projection.ProjectSquare(location, range);
+  return {airspace_tree.qbegin(bgi::intersects(box)), airspace_tree.qend()};
+}
+
+AirspacesSnapshot::const_iterator_range
+AirspacesSnapshot::QueryIntersecting(const GeoPoint &a, const GeoPoint &b) const
+{
+  if (IsEmpty())
+    // nothing to do
+    return {airspace_tree.qend(), airspace_tree.qend()};
+
+  // TODO: use StaticArray instead of std::vector
+  boost::geometry::model::linestring<FlatGeoPoint> line;
+  line.push_back(projection.ProjectInteger(a));
+  line.push_back(projection.ProjectInteger(b));
+
+  return {airspace_tree.qbegin(bgi::intersects(line)), airspace_tree.qend()};
+}
+
+AirspaceAltitudeIndex::const_iterator_range
+AirspacesSnapshot::QueryWithinRange(const GeoPoint &location, double range,
+                            double min_altitude, double max_altitude) const
+{
+  if (IsEmpty())
+    // nothing to do
+    return altitude_index.QueryNone();
+
+  const FlatBoundingBox box = projection.ProjectSquare(location, range);
+  return altitude_index.QueryOverlapping(box, min_altitude, max_altitude);
+}
+
+AirspaceAltitudeIndex::const_iterator_range
+AirspacesSnapshot::QueryIntersecting(const GeoPoint &a, const GeoPoint &b,
+                             double min_altitude, double max_altitude) const
+{
+  if (IsEmpty())
+    // nothing to do
+    return altitude_index.QueryNone();
+
+  boost::geometry::model::linestring<FlatGeoPoint> line;
+  line.push_back(projection.ProjectInteger(a));
+  line.push_back(projection.ProjectInteger(b));
+
+  FlatBoundingBox box(line.front(), line.front());
+  box.Expand(line.back());
+
+  /* the altitude index can only check the vector's bounding box; the
+     predicate performs the same check as QueryIntersecting() */
+  return altitude_index.QueryOverlapping(box, min_altitude, max_altitude,
+                                         [line](const Airspace &as){
+      const FlatBoundingBox &as_box = as;
+      return boost::geometry::intersects(as_box, line);
+    });
+}
+
+void
+AirspacesSnapshot::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
+                             bool include_inside,
+                             AirspaceIntersectionVisitor &visitor) const
+{
+  for (const auto &i : QueryIntersecting(loc, end))
+    if (visitor.SetIntersections(i.Intersects(loc, end, projection)))
+      visitor.Visit(i.GetAirspace());
+
+  if (include_inside) {
+    for (const auto &i : QueryInside(loc)) {
+      if (i.IsInside(end)) {
+        /* the vector is completely inside the airspace, and thus does
+           not intersect with airspace's outline: on caller's request,
+           report an intersection */
+        AirspaceIntersectionVector v;
+        v.reserve(1);
+        v.emplace_back(loc, end);
+        visitor.SetIntersections(std::move(v));
+        visitor.Visit(i.GetAirspace());
+      }
+    }
+  }
+}
+
+void
+AirspacesSnapshot::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
+                             double min_altitude, double max_altitude,
+                             bool include_inside,
+                             AirspaceIntersectionVisitor &visitor) const
+{
+  for (const auto &i : QueryIntersecting(loc, end, min_altitude, max_altitude))
+    if (visitor.SetIntersections(i.Intersects(loc, end, projection)))
+      visitor.Visit(i.GetAirspace());
+
+  if (include_inside && !IsEmpty()) {
+    const FlatBoundingBox box(projection.ProjectInteger(loc));
+    for (const auto &i : altitude_index.QueryOverlapping(box, min_altitude,
+                                                         max_altitude)) {
+      if (i.IsInside(loc) && i.IsInside(end)) {
+        /* the vector is completely inside the airspace, and thus does
+           not intersect with airspace's outline: on caller's request,
+           report an intersection */
+        AirspaceIntersectionVector v;
+        v.reserve(1);
+        v.emplace_back(loc, end);
+        visitor.SetIntersections(std::move(v));
+        visitor.Visit(i.GetAirspace());
+      }
+    }
+  }
+}
+
+AirspacesSnapshot::const_iterator_range
+AirspacesSnapshot::QueryInside(const GeoPoint &loc) const
+{
+  if (IsEmpty())
+    // nothing to do
+    return {airspace_tree.qend(), airspace_tree.qend()};
+
+  const auto flat_location = projection.ProjectInteger(loc);
+  const FlatBoundingBox box(flat_location, flat_location);
+
+  const auto _begin =
+    airspace_tree.qbegin(bgi::intersects(box) &&
+                         bgi::satisfies([&loc](const Airspace &as){
+                             return as.IsInside(loc);
+                           }));
+
+  return {_begin, airspace_tree.qend()};
+}
+
+void
+AirspacesSnapshot::QueryBatch(const GeoPoint &location,
+                      const GeoPoint *ends, unsigned n_ends,
+                      double min_altitude, double max_altitude,
+                      BatchVector &dest) const
+{
+  assert(n_ends <= MAX_BATCH_VECTORS);
+
+  dest.clear();
+
+  if (IsEmpty())
+    // nothing to do
+    return;
+
+  const auto flat_location = projection.ProjectInteger(location);
+  const FlatBoundingBox point_box(flat_location, flat_location);
+
+  FlatBoundingBox box = point_box;
+  boost::geometry::model::linestring<FlatGeoPoint> lines[MAX_BATCH_VECTORS];
+  for (unsigned n = 0; n < n_ends; ++n) {
+    const auto flat_end = projection.ProjectInteger(ends[n]);
+    box.Expand(flat_end);
+
+    lines[n].push_back(flat_location);
+    lines[n].push_back(flat_end);
+  }
+
+  for (const auto &i : altitude_index.QueryOverlapping(box, min_altitude,
+                                                       max_altitude)) {
+    const FlatBoundingBox &item_box = i;
+
+    /* these are the same checks the R-tree performs in
+       QueryIntersecting() and QueryInside() */
+    unsigned vectors = 0;
+    for (unsigned n = 0; n < n_ends; ++n)
+      if (boost::geometry::intersects(item_box, lines[n]))
+        vectors |= 1u << n;
+
+    const bool inside = boost::geometry::intersects(item_box, point_box) &&
+      i.IsInside(location);
+
+    if (vectors != 0 || inside)
+      dest.push_back({&i, vectors, inside});
+  }
+}
+
+AirspacesSnapshot::const_iterator_range
+AirspacesSnapshot::QueryInside(const AircraftState &aircraft) const
+{
+  if (IsEmpty())
+    // nothing to do
+    return {airspace_tree.qend(), airspace_tree.qend()};
+
+  const auto flat_location = projection.ProjectInteger(aircraft.location);
+  const FlatBoundingBox box(flat_location, flat_location);
+
+  const auto _begin =
+    airspace_tree.qbegin(bgi::intersects(box) &&
+                         bgi::satisfies([&aircraft](const Airspace &as){
+                             return as.IsInside(aircraft);
+                           }));
+
+  return {_begin, airspace_tree.qend()};
+}
@@ -0,0 +1,258 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACES_SNAPSHOT_HPP
+#define XCSOAR_AIRSPACES_SNAPSHOT_HPP
+
+#include "AirspacesInterface.hpp"
+#include "AirspaceAltitudeIndex.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
+#include "Compiler.h"
+
+#include <memory>
+#include <vector>
+
+struct GeoPoint;
+struct AircraftState;
+class AbstractAirspace;
+class AirspaceIntersectionVisitor;
+
+/**
+ * The search trees of an #Airspaces object.  After it has been
+ * obtained with Airspaces::GetSnapshot(), an instance is never
+ * modified again: #Airspaces copies it before the next change
+ * (copy-on-write).  A snapshot keeps the airspace objects it refers
+ * to alive, so its trees may be traversed without holding a lock
+ * while the database is being modified or reloaded.
+ *
+ * Only the trees are copied; the #AbstractAirspace objects are
+ * shared by all snapshots, and some of their state is still modified
+ * in place by the #Airspaces methods:
+ *
+ * - Optimise() re-projects the flat border points and the polygon
+ *   edge index (AbstractAirspace::Project()) with a new task
+ *   projection
+ * - SetFlightLevels() and SetGroundLevels() change the base and top
+ *   altitudes
+ * - SetActivity() changes the activity flag
+ * - the clearance border is generated on demand and cleared
+ *
+ * Readers of a snapshot which use this state (e.g. the flat
+ * geometry or the altitudes) must therefore still synchronise with
+ * the writer; only the structure of the trees is immutable.  In
+ * XCSoar, the airspace files are loaded and optimised while all other
+ * threads are suspended, and the calculation thread updates flight
+ * levels and activity while holding the lock of the
+ * #ProtectedAirspaceWarningManager, which the readers of the
+ * published #AirspaceState hold as well.
+ */
+class AirspacesSnapshot : public AirspacesInterface {
+  friend class Airspaces;
+
+public:
+  /**
+   * Owns the airspace objects which were added to an #Airspaces
+   * object, and deletes them when the last snapshot referring to
+   * them is gone.
+   */
+  class Owner {
+    std::vector<AbstractAirspace *> airspaces;
+
+  public:
+    Owner() = default;
+    Owner(const Owner &) = delete;
+    ~Owner();
+
+    void Add(AbstractAirspace *airspace) {
+      airspaces.push_back(airspace);
+    }
+  };
+
+private:
+  AirspaceTree airspace_tree;
+
+  /**
+   * A copy of #airspace_tree which is indexed by altitude as well.
+   */
+  AirspaceAltitudeIndex altitude_index;
+
+  /**
+   * The projection which was used to build the trees.
+   */
+  TaskProjection projection;
+
+  std::shared_ptr<Owner> owner;
+
+public:
+  gcc_pure
+  unsigned GetSize() const {
+    return airspace_tree.size();
+  }
+
+  gcc_pure
+  bool IsEmpty() const {
+    return airspace_tree.empty();
+  }
+
+  const FlatProjection &GetProjection() const {
+    return projection;
+  }
+
+  gcc_pure
+  const_iterator_range QueryAll() const {
+    auto predicate = boost::geometry::index::satisfies([](const Airspace &){
+        return true;
+      });
+    return {airspace_tree.qbegin(predicate), airspace_tree.qend()};
+  }
+
+  /**
+   * Query airspaces within range of location.
+   *
+   * @param loc location of origin of search
+   * @param range distance in meters of search radius
+   */
+  gcc_pure
+  const_iterator_range QueryWithinRange(const GeoPoint &location,
+                                        double range) const;
+
+  /**
+   * Query airspaces intersecting the vector (bounding box check
+   * only).  The result is in no specific order.
+   */
+  gcc_pure
+  const_iterator_range QueryIntersecting(const GeoPoint &a,
+                                         const GeoPoint &b) const;
+
+  /**
+   * Like QueryWithinRange(), but skip airspaces which are entirely
+   * above or below the given altitude band.  Altitudes relative to
+   * the terrain are not considered, so the caller still needs to
+   * check each result.
+   *
+   * @param min_altitude the lower end of the band [m MSL]
+   * @param max_altitude the upper end of the band [m MSL]
+   */
+  gcc_pure
+  AirspaceAltitudeIndex::const_iterator_range
+  QueryWithinRange(const GeoPoint &location, double range,
+                   double min_altitude, double max_altitude) const;
+
+  /**
+   * Like QueryIntersecting(), but skip airspaces which are entirely
+   * above or below the given altitude band.
+   */
+  gcc_pure
+  AirspaceAltitudeIndex::const_iterator_range
+  QueryIntersecting(const GeoPoint &a, const GeoPoint &b,
+                    double min_altitude, double max_altitude) const;
+
+  /**
+   * Call visitor class on airspaces intersected by vector.
+   * Note that the visitor is not instantiated separately for each match
+   *
+   * @param loc location of origin of search
+   * @param end end of line along with to search for intersections
+   * @param include_inside visit airspaces if the vector is completely
+   * inside (i.e. no intersection with airspace outline)
+   * @param visitor visitor class to call on airspaces intersected by line
+   */
+  void VisitIntersecting(const GeoPoint &location, const GeoPoint &end,
+                         bool include_inside,
+                         AirspaceIntersectionVisitor &visitor) const;
+
+  /**
+   * Like VisitIntersecting(), but skip airspaces which are entirely
+   * above or below the given altitude band.
+   */
+  void VisitIntersecting(const GeoPoint &location, const GeoPoint &end,
+                         double min_altitude, double max_altitude,
+                         bool include_inside,
+                         AirspaceIntersectionVisitor &visitor) const;
+
+  /**
+   * Query airspaces this location is inside.
+   *
+   * @param loc location of origin of search
+   */
+  gcc_pure
+  const_iterator_range QueryInside(const GeoPoint &location) const;
+
+  /**
+   * Query airspaces the aircraft is inside (taking altitude into
+   * account).
+   *
+   * @param loc location of origin of search
+   */
+  gcc_pure
+  const_iterator_range QueryInside(const AircraftState &aircraft) const;
+
+  /**
+   * One result of QueryBatch().
+   */
+  struct BatchItem {
+    const Airspace *airspace;
+
+    /**
+     * Bit mask of the vectors passing the bounding box check; bit n
+     * refers to the n-th end point passed to QueryBatch().
+     */
+    unsigned vectors;
+
+    /**
+     * Is the origin inside this airspace (ignoring altitude)?
+     */
+    bool inside;
+  };
+
+  typedef std::vector<BatchItem> BatchVector;
+
+  /**
+   * The maximum number of vectors for QueryBatch().
+   */
+  static constexpr unsigned MAX_BATCH_VECTORS = 8;
+
+  /**
+   * Combine QueryInside(location) and QueryIntersecting(location,
+   * ends[n]) for several vectors sharing the same origin in one
+   * R-tree traversal of their union bounding box.  Airspaces
+   * matching none of these queries are omitted.
+   *
+   * Airspaces entirely above or below the given altitude band are
+   * skipped.
+   *
+   * @param dest the vector to fill; it is cleared first
+   */
+  void QueryBatch(const GeoPoint &location,
+                  const GeoPoint *ends, unsigned n_ends,
+                  double min_altitude, double max_altitude,
+                  BatchVector &dest) const;
+
+private:
+  void ClearTrees() {
+    airspace_tree.clear();
+    altitude_index.Clear();
+  }
+};
+
+#endif
@@ -26,18 +26,21 @@ Copyright_License {
 
 #include "Airspaces.hpp"
 
-template<class Func,
+#include <utility>
+
+/**
+ * Find the minimum of the given function over the airspaces in the
+ * given range.
+ */
+template<class Range, class Func,
          typename Result=decltype(((Func *)nullptr)->operator()(*(const AbstractAirspace *)nullptr)),
          class Cmp=std::less<Result>>
 gcc_pure
 static inline Result
-FindMinimum(const Airspaces &airspaces, const GeoPoint &location, double range,
-            const AirspacePredicate &predicate,
-            Func &&func,
-            Cmp &&cmp=Cmp())
+FindMinimumIn(const Range &range, Func &&func, Cmp &&cmp=Cmp())
 {
   Result minimum;
-  for (const auto &i : airspaces.QueryWithinRange(location, range)) {
+  for (const auto &i : range) {
     const AbstractAirspace &aa = i.GetAirspace();
     Result result = func(aa);
     if (cmp(result, minimum))
@@ -47,4 +50,45 @@ FindMinimum(const Airspaces &airspaces, const GeoPoint &location, double range,
   return minimum;
 }
 
+/**
+ * @param airspaces an #Airspaces or #AirspacesSnapshot object
+ */
+template<class Database, class Func,
+         typename Result=decltype(((Func *)nullptr)->operator()(*(const AbstractAirspace *)nullptr)),
+         class Cmp=std::less<Result>>
+gcc_pure
+static inline Result
+FindMinimum(const Database &airspaces, const GeoPoint &location, double range,
+            const AirspacePredicate &predicate,
+            Func &&func,
+            Cmp &&cmp=Cmp())
+{
+  return FindMinimumIn(airspaces.QueryWithinRange(location, range),
+                       std::forward<Func>(func), std::forward<Cmp>(cmp));
+}
+
+/**
+ * Like the other FindMinimum(), but consider only airspaces whose
+ * altitude range overlaps the given band.
+ *
+ * @param airspaces an #Airspaces or #AirspacesSnapshot object
+ * @param min_altitude the lower end of the band [m MSL]
+ * @param max_altitude the upper end of the band [m MSL]
+ */
+template<class Database, class Func,
+         typename Result=decltype(((Func *)nullptr)->operator()(*(const AbstractAirspace *)nullptr)),
+         class Cmp=std::less<Result>>
+gcc_pure
+static inline Result
+FindMinimum(const Database &airspaces, const GeoPoint &location, double range,
+            double min_altitude, double max_altitude,
+            const AirspacePredicate &predicate,
+            Func &&func,
+            Cmp &&cmp=Cmp())
+{
+  return FindMinimumIn(airspaces.QueryWithinRange(location, range,
+                                                  min_altitude, max_altitude),
+                       std::forward<Func>(func), std::forward<Cmp>(cmp));
+}
+
 #endif
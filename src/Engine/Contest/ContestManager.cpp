@@ -21,6 +21,7 @@
  */
 
 #include "ContestManager.hpp"
+#include "Util/Macros.hpp"
 
 ContestManager::ContestManager(const Contest _contest,
                                const Trace &trace_full,
@@ -59,6 +60,18 @@ ContestManager::SetIncremental(bool incremental)
   net_coupe.SetIncremental(incremental);
 }
 
+void
+ContestManager::SetTimeBudget(unsigned time_budget)
+{
+  olc_sprint.SetTimeBudget(time_budget);
+  olc_classic.SetTimeBudget(time_budget);
+  dmst_quad.SetTimeBudget(time_budget);
+  xcontest_free.SetTimeBudget(time_budget);
+  dhv_xc_free.SetTimeBudget(time_budget);
+  sis_at.SetTimeBudget(time_budget);
+  net_coupe.SetTimeBudget(time_budget);
+}
+
 void
 ContestManager::SetPredicted(const TracePoint &predicted)
 {
@@ -96,11 +109,17 @@ ContestManager::SetHandicap(unsigned handicap)
 static bool
 RunContest(AbstractContest &_contest,
            ContestResult &result, ContestTraceVector &solution,
-           bool exhaustive)
+           double &score_bound,
+           bool exhaustive, bool &incomplete)
 {
   // run solver, return immediately if further processing is required
   // by subsequent calls
   SolverResult r = _contest.Solve(exhaustive);
+  if (r == SolverResult::INCOMPLETE)
+    incomplete = true;
+
+  score_bound = _contest.GetScoreBound();
+
   if (r != SolverResult::VALID)
     return false;
 
@@ -116,10 +135,57 @@ RunContest(AbstractContest &_contest,
   return true;
 }
 
+struct ContestJob {
+  AbstractContest &solver;
+  ContestResult &result;
+  ContestTraceVector &solution;
+  double &score_bound;
+  bool valid, incomplete;
+
+  ContestJob(AbstractContest &_solver,
+             ContestResult &_result, ContestTraceVector &_solution,
+             double &_score_bound)
+    :solver(_solver), result(_result), solution(_solution),
+     score_bound(_score_bound),
+     valid(false), incomplete(false) {}
+};
+
+/**
+ * Run independent solvers, in parallel if a #ParallelFunction was
+ * configured.
+ *
+ * @return true if at least one of them has found a new solution
+ */
+static bool
+RunContests(ContestJob *jobs, unsigned n, bool exhaustive,
+            const ContestManager::ParallelFunction &parallel,
+            bool &incomplete)
+{
+  const auto f = [jobs, exhaustive](unsigned i){
+    ContestJob &job = jobs[i];
+    job.valid = RunContest(job.solver, job.result, job.solution,
+                           job.score_bound, exhaustive, job.incomplete);
+  };
+
+  if (n > 1 && parallel)
+    parallel(n, f);
+  else
+    for (unsigned i = 0; i < n; ++i)
+      f(i);
+
+  bool retval = false;
+  for (unsigned i = 0; i < n; ++i) {
+    retval |= jobs[i].valid;
+    incomplete |= jobs[i].incomplete;
+  }
+
+  return retval;
+}
+
 bool
 ContestManager::UpdateIdle(bool exhaustive)
 {
-  bool retval = false;
+  bool retval = false, incomplete = false;
 
   switch (contest) {
   case Contest::NONE:
@@ -127,83 +193,111 @@ ContestManager::UpdateIdle(bool exhaustive)
 
   case Contest::OLC_SPRINT:
     retval = RunContest(olc_sprint, stats.result[0],
-                        stats.solution[0], exhaustive);
+                        stats.solution[0], stats.score_bound[0],
+                        exhaustive, incomplete);
     break;
 
   case Contest::OLC_FAI:
     retval = RunContest(olc_fai, stats.result[0],
-                        stats.solution[0], exhaustive);
+                        stats.solution[0], stats.score_bound[0],
+                        exhaustive, incomplete);
     break;
 
   case Contest::OLC_CLASSIC:
     retval = RunContest(olc_classic, stats.result[0],
-                        stats.solution[0], exhaustive);
+                        stats.solution[0], stats.score_bound[0],
+                        exhaustive, incomplete);
     break;
 
   case Contest::OLC_LEAGUE:
     retval = RunContest(olc_classic, stats.result[1],
-                        stats.solution[1], exhaustive);
+                        stats.solution[1], stats.score_bound[1],
+                        exhaustive, incomplete);
 
     olc_league.Feed(stats.solution[1]);
 
     retval |= RunContest(olc_league, stats.result[0],
-                         stats.solution[0], exhaustive);
+                         stats.solution[0], stats.score_bound[0],
+                         exhaustive, incomplete);
     break;
 
-  case Contest::OLC_PLUS:
-    retval = RunContest(olc_classic, stats.result[0],
-                        stats.solution[0], exhaustive);
+  case Contest::OLC_PLUS: {
+    ContestJob jobs[] = {
+      { olc_classic, stats.result[0], stats.solution[0],
+        stats.score_bound[0] },
+      { olc_fai, stats.result[1], stats.solution[1],
+        stats.score_bound[1] },
+    };
 
-    retval |= RunContest(olc_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunContests(jobs, ARRAY_SIZE(jobs), exhaustive, parallel,
+                         incomplete);
 
     if (retval) {
       olc_plus.Feed(stats.result[0], stats.solution[0],
                     stats.result[1], stats.solution[1]);
 
       RunContest(olc_plus, stats.result[2],
-                 stats.solution[2], exhaustive);
+                 stats.solution[2], stats.score_bound[2],
+                 exhaustive, incomplete);
     }
 
     break;
+  }
 
   case Contest::DMST:
     retval = RunContest(dmst_quad, stats.result[0],
-                        stats.solution[0], exhaustive);
+                        stats.solution[0], stats.score_bound[0],
+                        exhaustive, incomplete);
     break;
 
-  case Contest::XCONTEST:
-    retval = RunContest(xcontest_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(xcontest_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+  case Contest::XCONTEST: {
+    ContestJob jobs[] = {
+      { xcontest_free, stats.result[0], stats.solution[0],
+        stats.score_bound[0] },
+      { xcontest_triangle, stats.result[1], stats.solution[1],
+        stats.score_bound[1] },
+    };
+
+    retval = RunContests(jobs, ARRAY_SIZE(jobs), exhaustive, parallel,
+                         incomplete);
     break;
+  }
+
+  case Contest::DHV_XC: {
+    ContestJob jobs[] = {
+      { dhv_xc_free, stats.result[0], stats.solution[0],
+        stats.score_bound[0] },
+      { dhv_xc_triangle, stats.result[1], stats.solution[1],
+        stats.score_bound[1] },
+    };
 
-  case Contest::DHV_XC:
-    retval = RunContest(dhv_xc_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(dhv_xc_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunContests(jobs, ARRAY_SIZE(jobs), exhaustive, parallel,
+                         incomplete);
     break;
+  }
 
   case Contest::SIS_AT:
     retval = RunContest(sis_at, stats.result[0],
-                        stats.solution[0], exhaustive);
+                        stats.solution[0], stats.score_bound[0],
+                        exhaustive, incomplete);
     break;
 
   case Contest::NET_COUPE:
     retval = RunContest(net_coupe, stats.result[0],
-                        stats.solution[0], exhaustive);
+                        stats.solution[0], stats.score_bound[0],
+                        exhaustive, incomplete);
     break;
 
   };
 
+  solving = incomplete;
   return retval;
 }
 
 void
 ContestManager::Reset()
 {
+  solving = false;
   stats.Reset();
   olc_sprint.Reset();
   olc_fai.Reset();
@@ -36,6 +36,8 @@
 #include "Solvers/NetCoupe.hpp"
 #include "ContestStatistics.hpp"
 
+#include <functional>
+
 class Trace;
 
 /**
@@ -45,6 +47,17 @@ class ContestManager
 {
   friend class PrintHelper;
 
+public:
+  /**
+   * A function which calls the given function once for each index
+   * in the range [0, n), possibly in parallel, and returns after all
+   * calls have finished.
+   */
+  typedef std::function<void(unsigned n,
+                             const std::function<void(unsigned)> &f)> ParallelFunction;
+
+private:
+
   Contest contest;
 
   ContestStatistics stats;
@@ -62,6 +75,14 @@ class ContestManager
   OLCSISAT sis_at;
   NetCoupe net_coupe;
 
+  ParallelFunction parallel;
+
+  /**
+   * Did one of the solvers return SolverResult::INCOMPLETE in the
+   * last UpdateIdle() call?
+   */
+  bool solving;
+
 public:
   /**
    * Base constructor.
@@ -85,6 +106,21 @@ public:
 
   void SetIncremental(bool incremental);
 
+  /**
+   * @see ContestDijkstra::SetTimeBudget()
+   */
+  void SetTimeBudget(unsigned time_budget);
+
+  /**
+   * Run the solvers which do not depend on each other (e.g. the free
+   * flight and the triangle of XContest) with the given function,
+   * e.g. on a thread pool.  By default, they are run one after
+   * another.
+   */
+  void SetParallel(ParallelFunction _parallel) {
+    parallel = std::move(_parallel);
+  }
+
   /**
    * @see ContestDijkstra::SetPredicted()
    */
@@ -106,6 +142,14 @@ public:
    */
   bool UpdateIdle(bool exhaustive = false);
 
+  /**
+   * Is the optimisation still in progress, i.e. would another
+   * UpdateIdle() call continue it without new data?
+   */
+  bool IsSolving() const {
+    return solving;
+  }
+
   bool SolveExhaustive() {
     return UpdateIdle(true);
   }
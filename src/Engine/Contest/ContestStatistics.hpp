@@ -32,10 +32,19 @@ struct ContestStatistics
   ContestResult result[3];
   ContestTraceVector solution[3];
 
+  /**
+   * An upper bound for the score which each #result may reach when
+   * its solver finishes the search in progress (see
+   * AbstractContest::GetScoreBound()).  It is 0 when the search is
+   * finished, or when the solver cannot estimate a bound.
+   */
+  double score_bound[3];
+
   void Reset() {
     for (unsigned i = 0; i < 3; ++i) {
       solution[i].clear();
       result[i].Reset();
+      score_bound[i] = 0;
     }
   }
 
@@ -100,6 +100,19 @@ public:
    */
   virtual SolverResult Solve(bool exhaustive) = 0;
 
+  /**
+   * Returns an upper bound for the score which may be reached when
+   * the search in progress is finished, i.e. how far the score of
+   * GetBestResult() may still improve with the current trace.
+   *
+   * @return the bound, or 0 if no search is in progress (or if this
+   * solver cannot estimate one)
+   */
+  gcc_pure
+  virtual double GetScoreBound() const {
+    return 0;
+  }
+
 protected:
   /**
    * Perform check on whether score needs to be
@@ -25,10 +25,17 @@ Copyright_License {
 #include "../ContestResult.hpp"
 #include "Trace/Trace.hpp"
 #include "Cast.hpp"
+#include "Geo/Flat/FlatBoundingBox.hpp"
+#include "Geo/GeoBounds.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <assert.h>
 
+/* converts a weighted distance [m] to kilometers; the stage weights
+   are fifths */
+static constexpr double FIFTH = 0.0002;
+
 // set size of reserved queue elements (may differ from Dijkstra default)
 static constexpr unsigned CONTEST_QUEUE_SIZE = 5000;
 
@@ -40,7 +47,8 @@ ContestDijkstra::ContestDijkstra(const Trace &_trace,
    NavDijkstra(n_legs + 1),
    TraceManager(_trace),
    continuous(_continuous),
-   incremental(false)
+   incremental(false),
+   time_budget(0)
 {
   assert(num_stages <= MAX_STAGES);
 
@@ -126,7 +134,21 @@ ContestDijkstra::Solve(bool exhaustive)
       return SolverResult::FAILED;
   }
 
-  SolverResult result = DistanceGeneral(exhaustive ? 0 - 1 : 25);
+  SolverResult result;
+  if (exhaustive || time_budget == 0) {
+    result = DistanceGeneral(exhaustive ? 0 - 1 : 25);
+  } else {
+    /* keep stepping until the time budget is used up; the clock is
+       only checked every few steps, because it is not free */
+    const auto deadline = std::chrono::steady_clock::now() +
+      std::chrono::microseconds(time_budget);
+
+    do {
+      result = DistanceGeneral(25);
+    } while (result == SolverResult::INCOMPLETE &&
+             std::chrono::steady_clock::now() < deadline);
+  }
+
   if (result != SolverResult::INCOMPLETE) {
     if (incremental && continuous)
       /* enable the incremental solver, which considers the existing
@@ -153,6 +175,81 @@ ContestDijkstra::Reset()
   AbstractContest::Reset();
 }
 
+double
+ContestDijkstra::GetDistanceBound() const
+{
+  if (!IsSearching() || n_points == 0)
+    return 0;
+
+  /* no leg can be longer than the diagonal of the trace's bounding
+     box */
+  FlatBoundingBox box(TraceManager::GetPoint(0).GetFlatLocation());
+  for (unsigned i = 1; i < n_points; ++i)
+    box.Expand(TraceManager::GetPoint(i).GetFlatLocation());
+  if (predicted.IsDefined())
+    box.Expand(predicted.GetFlatLocation());
+
+  const unsigned max_leg =
+    box.GetLowerLeft().Distance(box.GetUpperRight()) + 1;
+
+  /* the weighted distance of the legs following each stage, assuming
+     each of them has the maximum length */
+  unsigned remaining[MAX_STAGES];
+  remaining[num_stages - 1] = 0;
+  for (unsigned i = num_stages - 1; i > 0; --i)
+    remaining[i - 1] = remaining[i] + GetStageWeight(i - 1) * max_leg;
+
+  /* each queued node carries the (negated) weighted distance of its
+     path so far; the search cannot do better than the best of these
+     paths continued with maximum length legs */
+  unsigned bound = 0;
+  dijkstra.VisitQueue([&remaining, &bound](ScanTaskPoint node,
+                                           unsigned value){
+      const unsigned stage = node.GetStageNumber();
+      const unsigned distance =
+        stage * DIJKSTRA_MINMAX_OFFSET - value + remaining[stage];
+      bound = std::max(bound, distance);
+    });
+
+  /* the projection uses the longitude scale of its center; where the
+     trace reaches closer to the equator, a flat unit is longer than
+     at the center */
+  const TaskProjection &projection = trace_master.GetProjection();
+  const GeoBounds bounds = projection.Unproject(box);
+  const Angle equator_latitude =
+    bounds.GetSouth().Native() < 0 && bounds.GetNorth().Native() > 0
+    ? Angle::Zero()
+    : std::min(bounds.GetNorth().Absolute(), bounds.GetSouth().Absolute());
+  const double x_scale = equator_latitude.cos() /
+    projection.GetCenter().latitude.cos();
+
+  return bound * std::max(x_scale, 1.) /
+    projection.ProjectRangeFloat(projection.GetCenter(), 1);
+}
+
+double
+ContestDijkstra::GetScoreBound() const
+{
+  const double weighted_distance = GetDistanceBound();
+  if (weighted_distance <= 0)
+    return 0;
+
+  /* each leg weighs at least the smallest stage weight */
+  const unsigned min_weight =
+    *std::min_element(stage_weights, stage_weights + num_stages - 1);
+
+  return std::max(GetBestResult().score,
+                  CalculateScoreBound(weighted_distance / min_weight,
+                                      weighted_distance));
+}
+
+double
+ContestDijkstra::CalculateScoreBound(gcc_unused double distance,
+                                     double weighted_distance) const
+{
+  return ApplyHandicap(weighted_distance * FIFTH);
+}
+
 bool
 ContestDijkstra::SaveSolution()
 {
@@ -188,7 +285,6 @@ ContestDijkstra::CalculateResult(const ContestTraceVector &solution) const
     previous = current;
   }
 
-  #define FIFTH 0.0002
   result.score *= FIFTH;
   result.score = ApplyHandicap(result.score);
 
@@ -61,6 +61,12 @@ class ContestDijkstra : public AbstractContest, protected NavDijkstra, public Tr
    */
   bool finished;
 
+  /**
+   * The maximum time [us] a non-exhaustive Solve() call may spend on
+   * the search.  Zero means a fixed number of steps per call.
+   */
+  unsigned time_budget;
+
   /**
    * The last solution.  Use only if Solve() has returned VALID.
    */
@@ -93,7 +99,52 @@ public:
     incremental = _incremental;
   }
 
+  /**
+   * Let each non-exhaustive Solve() call run the search until the
+   * given time has elapsed, instead of a fixed number of steps.  The
+   * search state is kept between calls, so a long search is spread
+   * over many calls without blocking the caller.
+   *
+   * @param _time_budget the budget in microseconds; 0 restores the
+   * default step limit
+   */
+  void SetTimeBudget(unsigned _time_budget) {
+    time_budget = _time_budget;
+  }
+
 protected:
+  /**
+   * Is a search in progress, i.e. has the last Solve() call returned
+   * SolverResult::INCOMPLETE?
+   */
+  gcc_pure
+  bool IsSearching() const {
+    return !finished && !dijkstra.IsEmpty();
+  }
+
+  /**
+   * Returns an upper bound for the weighted distance [m] which the
+   * search in progress can still find.  The bound is based on flat
+   * distances, corrected for the distortion of the projection.
+   *
+   * @return the bound, or 0 if no search is in progress
+   */
+  gcc_pure
+  double GetDistanceBound() const;
+
+  /**
+   * Convert an upper bound for the distance of a path to an upper
+   * bound for its score.  Implementations which override
+   * CalculateResult() must override this method accordingly.
+   *
+   * @param distance the bound for the distance [m]
+   * @param weighted_distance the bound for the distance [m] with
+   * #stage_weights applied
+   */
+  gcc_pure
+  virtual double CalculateScoreBound(double distance,
+                                     double weighted_distance) const;
+
   bool IsIncremental() const {
     return incremental;
   }
@@ -168,6 +219,7 @@ public:
   /* public virtual methods from AbstractContest */
   SolverResult Solve(bool exhaustive) override;
   void Reset() override;
+  double GetScoreBound() const override;
 
 protected:
   /* protected virtual methods from AbstractContest */
@@ -34,3 +34,10 @@ NetCoupe::CalculateResult() const
   return result;
 }
 
+double
+NetCoupe::CalculateScoreBound(double distance,
+                              gcc_unused double weighted_distance) const
+{
+  return ApplyHandicap(distance * 0.0008);
+}
+
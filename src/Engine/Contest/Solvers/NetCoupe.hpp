@@ -35,6 +35,10 @@ public:
 protected:
   /* virtual methods from class AbstractContest */
   ContestResult CalculateResult() const override;
+
+  /* virtual methods from class ContestDijkstra */
+  double CalculateScoreBound(double distance,
+                             double weighted_distance) const override;
 };
 
 #endif
@@ -71,3 +71,12 @@ OLCSISAT::CalculateResult(const ContestTraceVector &solution) const
   result.score = ApplyHandicap((V + result.distance) / 2000);
   return result;
 }
+
+double
+OLCSISAT::CalculateScoreBound(double distance,
+                              gcc_unused double weighted_distance) const
+{
+  /* the convex hull of the path is not longer than the path plus the
+     closing leg, therefore V cannot exceed the path distance */
+  return ApplyHandicap(2 * distance / 2000);
+}
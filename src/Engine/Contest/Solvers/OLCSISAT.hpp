@@ -35,6 +35,8 @@ public:
 protected:
   /* virtual methods from class ContestDijkstra */
   ContestResult CalculateResult(const ContestTraceVector &solution) const override;
+  double CalculateScoreBound(double distance,
+                             double weighted_distance) const override;
 };
 
 #endif
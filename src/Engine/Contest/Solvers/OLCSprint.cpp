@@ -112,6 +112,13 @@ OLCSprint::CalculateResult() const
   return result;
 }
 
+double
+OLCSprint::CalculateScoreBound(double distance,
+                               gcc_unused double weighted_distance) const
+{
+  return ApplyShiftedHandicap(distance / 2500.);
+}
+
 void
 OLCSprint::UpdateTrace(bool force)
 {
@@ -49,6 +49,8 @@ protected:
   /* virtual methods from ContestDijkstra */
   void UpdateTrace(bool force) override;
   void AddStartEdges() override;
+  double CalculateScoreBound(double distance,
+                             double weighted_distance) const override;
 };
 
 #endif
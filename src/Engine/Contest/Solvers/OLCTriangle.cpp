@@ -24,6 +24,12 @@
 #include "Cast.hpp"
 #include "Trace/Trace.hpp"
 #include "Util/QuadTree.hpp"
+#include "Math/FastMath.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+#include <stdlib.h>
 
 /*
  @todo potential to use 3d convex hull to speed search
@@ -81,6 +87,8 @@ OLCTriangle::Reset()
 
   closing_pairs.Clear();
   ClearTrace();
+  range_boxes.clear();
+  flat_locations.clear();
 
   ResetBranchAndBound();
   AbstractContest::Reset();
@@ -121,12 +129,14 @@ OLCTriangle::UpdateTrace(bool force)
 
     closing_pairs.Clear();
     is_closed = FindClosingPairs(0);
+    UpdateRangeBoxes();
 
    } else if (is_complete && incremental) {
     const unsigned old_size = n_points;
     if (UpdateTraceTail()) {
       is_complete = false;
       is_closed = FindClosingPairs(old_size);
+      UpdateRangeBoxes();
     }
   }
 
@@ -140,6 +150,163 @@ OLCTriangle::UpdateTrace(bool force)
   tick_iterations = n_points * n_points / 8;
 }
 
+gcc_const
+static unsigned
+FloorLog2(unsigned x)
+{
+  assert(x > 0);
+
+  return sizeof(x) * 8 - 1 - __builtin_clz(x);
+}
+
+void
+OLCTriangle::UpdateRangeBoxes()
+{
+  range_boxes.clear();
+  flat_locations.clear();
+  if (n_points == 0)
+    return;
+
+  flat_locations.reserve(n_points);
+  for (unsigned i = 0; i < n_points; ++i)
+    flat_locations.push_back(GetPoint(i).GetFlatLocation());
+
+  /* level 0: one box per point */
+  range_boxes.reserve(n_points * (FloorLog2(n_points) + 1));
+  for (const auto &location : flat_locations)
+    range_boxes.emplace_back(location);
+
+  /* level k: merge two adjacent boxes of level k-1 */
+  for (unsigned size = 2, previous = 0; size <= n_points;
+       size *= 2, previous += n_points) {
+    const unsigned half = size / 2;
+    for (unsigned i = 0; i + size <= n_points; ++i) {
+      FlatBoundingBox box = range_boxes[previous + i];
+      box.Merge(range_boxes[previous + i + half]);
+      range_boxes.push_back(box);
+    }
+
+    /* pad the level so each one is n_points long; the padding is
+       never read */
+    range_boxes.resize(previous + 2 * n_points, range_boxes.back());
+  }
+}
+
+FlatBoundingBox
+OLCTriangle::GetRangeBox(unsigned min, unsigned max) const
+{
+  assert(min < max);
+  assert(max <= n_points);
+
+  const unsigned level = FloorLog2(max - min);
+  const unsigned offset = level * n_points;
+
+  FlatBoundingBox box = range_boxes[offset + min];
+  box.Merge(range_boxes[offset + max - (1u << level)]);
+  return box;
+}
+
+/**
+ * Calculate the flat distance estimates between each point of #a and
+ * each point of #b, the same way TurnPointRange does for single point
+ * ranges.
+ */
+static void
+CalcLegDistances(const FlatGeoPoint *a, unsigned n_a,
+                 const FlatGeoPoint *b, unsigned n_b,
+                 unsigned *min, unsigned *max)
+{
+  for (unsigned i = 0; i < n_a; ++i) {
+    for (unsigned j = 0; j < n_b; ++j) {
+      const unsigned dx = abs(a[i].x - b[j].x);
+      const unsigned dy = abs(a[i].y - b[j].y);
+
+      const double square = double(dx) * dx + double(dy) * dy;
+      const unsigned distance = sqrt(square);
+      *max++ = distance;
+
+      /* ihypot() is the same unless its integer square overflows */
+      *min++ = square < 4294967296.
+        ? distance
+        : ihypot(dx, dy);
+    }
+  }
+}
+
+bool
+OLCTriangle::SolveCandidateSet(const CandidateSet &candidates,
+                               unsigned large_triangle_check,
+                               unsigned &worst_d,
+                               std::tuple<unsigned, unsigned, unsigned, unsigned> &best)
+{
+  const unsigned first1 = candidates.tp1.index_min,
+    first2 = candidates.tp2.index_min,
+    first3 = candidates.tp3.index_min;
+  const unsigned n1 = candidates.tp1.GetSize(),
+    n2 = candidates.tp2.GetSize(),
+    n3 = candidates.tp3.GetSize();
+
+  assert(n1 * n2 * n3 <= MAX_LEAF_TRIPLES);
+
+  /* each table has at most n1*n2*n3 entries */
+  leg_tables.resize(6 * MAX_LEAF_TRIPLES);
+  unsigned *const min_12 = leg_tables.data(),
+    *const max_12 = min_12 + MAX_LEAF_TRIPLES,
+    *const min_23 = max_12 + MAX_LEAF_TRIPLES,
+    *const max_23 = min_23 + MAX_LEAF_TRIPLES,
+    *const min_31 = max_23 + MAX_LEAF_TRIPLES,
+    *const max_31 = min_31 + MAX_LEAF_TRIPLES;
+
+  const FlatGeoPoint *const locations = flat_locations.data();
+  CalcLegDistances(locations + first1, n1, locations + first2, n2,
+                   min_12, max_12);
+  CalcLegDistances(locations + first2, n2, locations + first3, n3,
+                   min_23, max_23);
+  CalcLegDistances(locations + first3, n3, locations + first1, n1,
+                   min_31, max_31);
+
+  bool found = false;
+  LegBounds legs;
+
+  for (unsigned i = 0; i < n1; ++i) {
+    for (unsigned j = 0; j < n2; ++j) {
+      legs.df_12_min = min_12[i * n2 + j];
+      legs.df_12_max = max_12[i * n2 + j];
+
+      if (first1 + i >= first2 + j)
+        /* only ascending triples, see HasAscendingTriple() */
+        continue;
+
+      if (std::min(legs.df_12_max + candidates.df_23_max + candidates.df_31_max,
+                   legs.df_12_max * 4) < worst_d)
+        /* no triangle with this leg can be large enough */
+        continue;
+
+      for (unsigned k = 0; k < n3; ++k) {
+        if (first2 + j >= first3 + k)
+          continue;
+
+        legs.df_23_min = min_23[j * n3 + k];
+        legs.df_23_max = max_23[j * n3 + k];
+        legs.df_31_min = min_31[k * n1 + i];
+        legs.df_31_max = max_31[k * n1 + i];
+        legs.UpdateBounds();
+
+        if (legs.df_max >= worst_d && legs.df_min >= worst_d &&
+            legs.IsFeasible(is_fai, large_triangle_check) &&
+            legs.IsIntegral(*this, is_fai, large_triangle_check,
+                            first1 + i, first2 + j, first3 + k)) {
+          worst_d = legs.df_min;
+          best = std::make_tuple(first1 + i, first2 + j, first3 + k,
+                                 legs.df_max);
+          found = true;
+        }
+      }
+    }
+  }
+
+  return found;
+}
 
 SolverResult
 OLCTriangle::Solve(bool exhaustive)
@@ -305,6 +472,28 @@ OLCTriangle::SolveTriangle(bool exhaustive)
 }
 
 
+inline void
+OLCTriangle::PushCandidateSet(const CandidateSet &candidates)
+{
+  branch_and_bound.push_back(candidates);
+  std::push_heap(branch_and_bound.begin(), branch_and_bound.end(),
+                 CompareCandidateSets);
+}
+
+unsigned
+OLCTriangle::PruneBranchAndBound(unsigned worst_d)
+{
+  branch_and_bound.erase(std::remove_if(branch_and_bound.begin(),
+                                        branch_and_bound.end(),
+                                        [worst_d](const CandidateSet &c){
+                                          return c.df_max < worst_d;
+                                        }),
+                         branch_and_bound.end());
+  std::make_heap(branch_and_bound.begin(), branch_and_bound.end(),
+                 CompareCandidateSets);
+  return branch_and_bound.size();
+}
+
 std::tuple<unsigned, unsigned, unsigned, unsigned>
 OLCTriangle::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d, bool exhaustive)
 {
@@ -344,7 +533,7 @@ OLCTriangle::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d, boo
     CandidateSet root_candidates(*this, from, to + 1);
     if (root_candidates.IsFeasible(is_fai, large_triangle_check) &&
         root_candidates.df_max >= worst_d)
-      branch_and_bound.insert(std::pair<unsigned, CandidateSet>(root_candidates.df_max, root_candidates));
+      PushCandidateSet(root_candidates);
   }
 
   // set max_iterations only if non-exhaustive and predictive solving is enabled.
@@ -354,123 +543,111 @@ OLCTriangle::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d, boo
 
   while (!branch_and_bound.empty()) {
     /* now loop over the tree, branching each found candidate set, adding the branch if it's feasible.
-     * remove all candidate sets with d_max smaller than d_min of the largest integral candidate set
-     * always work on the node with largest d_min
+     * candidate sets with d_max smaller than d_min of the largest integral candidate set
+     * are skipped.
+     * always work on the node with largest d_max
      */
 
-    iterations++;
-
     // break loop if max_iterations or max_tree_size exceeded
-    if (iterations > max_iterations || branch_and_bound.size() > max_tree_size)
-      break;
-
-    // first clean up tree, removeing all nodes with d_max < worst_d
-    branch_and_bound.erase(branch_and_bound.begin(), branch_and_bound.lower_bound(worst_d));
-
-    // we might have cleaned up the whole tree. nothing to do then...
-    if (branch_and_bound.empty())
+    if (iterations >= max_iterations ||
+        (branch_and_bound.size() > max_tree_size &&
+         PruneBranchAndBound(worst_d) > max_tree_size))
       break;
 
-    /* get node to work on.
-     * change node selection strategy if the tree grows too big.
-     * this is a mixed depht-first/breadth-first approach, the latter
-     * beeing faster, but the first a lot more memory efficient.
-     */
-    std::multimap<unsigned, CandidateSet>::iterator node;
-
-    if (branch_and_bound.size() > n_points * 4 && iterations % 16 != 0) {
-      node = branch_and_bound.upper_bound(branch_and_bound.rbegin()->first / 2);
-      if (node == branch_and_bound.end()) --node;
-    } else {
-      node = --branch_and_bound.end();
-    }
-
-    if (node->second.df_min >= worst_d &&
-        node->second.IsIntegral(*this, is_fai, large_triangle_check)) {
-      // node is integral feasible -> a possible solution
-
-      worst_d = node->second.df_min;
-
-      tp1 = node->second.tp1.index_min;
-      tp2 = node->second.tp2.index_min;
-      tp3 = node->second.tp3.index_min;
-      best_d = node->first;
+    // get the node to work on
+    std::pop_heap(branch_and_bound.begin(), branch_and_bound.end(),
+                  CompareCandidateSets);
+    CandidateSet node = branch_and_bound.back();
+    branch_and_bound.pop_back();
+
+    if (node.df_max < worst_d)
+      /* this node has become obsolete since it was added */
+      continue;
+
+    /* work on the node, then on its better child for as long as that
+       child would be taken from the top of the heap next anyway */
+    bool dive;
+    do {
+      iterations++;
+      dive = false;
+
+      if (node.GetTripleCount() <= MAX_LEAF_TRIPLES) {
+        // small node: check all triangles at once instead of splitting it
+
+        std::tuple<unsigned, unsigned, unsigned, unsigned> triangle;
+        if (SolveCandidateSet(node, large_triangle_check,
+                              worst_d, triangle)) {
+          // found an integral feasible node -> a possible solution
+          std::tie(tp1, tp2, tp3, best_d) = triangle;
+          integral_feasible = true;
+        }
 
-      integral_feasible = true;
+        break;
+      }
 
-    } else {
       // split largest bounding box of node and create child nodes
 
-      const unsigned tp1_diag = node->second.tp1.GetDiagnoal();
-      const unsigned tp2_diag = node->second.tp2.GetDiagnoal();
-      const unsigned tp3_diag = node->second.tp3.GetDiagnoal();
-
-      const unsigned max_diag = std::max({tp1_diag, tp2_diag, tp3_diag});
+      const unsigned tp1_diag = node.tp1.GetSize() > 1
+        ? node.tp1.GetDiagnoal() + 1 : 0;
+      const unsigned tp2_diag = node.tp2.GetSize() > 1
+        ? node.tp2.GetDiagnoal() + 1 : 0;
+      const unsigned tp3_diag = node.tp3.GetSize() > 1
+        ? node.tp3.GetDiagnoal() + 1 : 0;
 
       CandidateSet left, right;
-      bool add = false;
 
-      if (tp1_diag == max_diag && node->second.tp1.GetSize() != 1) {
+      if (tp1_diag >= tp2_diag && tp1_diag >= tp3_diag) {
         // split tp1 range
-        const unsigned split = (node->second.tp1.index_min + node->second.tp1.index_max) / 2;
-
-        if (split <= node->second.tp2.index_max) {
-          add = true;
+        const unsigned split = (node.tp1.index_min + node.tp1.index_max) / 2;
 
-          left = CandidateSet(TurnPointRange(*this, node->second.tp1.index_min, split),
-                              node->second.tp2, node->second.tp3);
-
-          right = CandidateSet(TurnPointRange(*this, split, node->second.tp1.index_max),
-                               node->second.tp2, node->second.tp3);
-        }
-      } else if (tp2_diag == max_diag && node->second.tp2.GetSize() != 1) {
+        left = node.WithTP1(TurnPointRange(*this, node.tp1.index_min, split));
+        right = node.WithTP1(TurnPointRange(*this, split, node.tp1.index_max));
+      } else if (tp2_diag >= tp3_diag) {
         // split tp2 range
-        const unsigned split = (node->second.tp2.index_min + node->second.tp2.index_max) / 2;
+        const unsigned split = (node.tp2.index_min + node.tp2.index_max) / 2;
 
-        if (split <= node->second.tp3.index_max && split >= node->second.tp1.index_min) {
-          add = true;
-
-          left = CandidateSet(node->second.tp1,
-                              TurnPointRange(*this, node->second.tp2.index_min, split),
-                              node->second.tp3);
-
-          right = CandidateSet(node->second.tp1,
-                               TurnPointRange(*this, split, node->second.tp2.index_max),
-                               node->second.tp3);
-        }
-      } else if (node->second.tp3.GetSize() != 1) {
+        left = node.WithTP2(TurnPointRange(*this, node.tp2.index_min, split));
+        right = node.WithTP2(TurnPointRange(*this, split, node.tp2.index_max));
+      } else {
         // split tp3 range
-        const unsigned split = (node->second.tp3.index_min + node->second.tp3.index_max) / 2;
-
-        if (split >= node->second.tp2.index_min) {
-          add = true;
+        const unsigned split = (node.tp3.index_min + node.tp3.index_max) / 2;
 
-          left = CandidateSet(node->second.tp1, node->second.tp2,
-                              TurnPointRange(*this, node->second.tp3.index_min, split));
-
-          right = CandidateSet(node->second.tp1, node->second.tp2,
-                               TurnPointRange(*this, split, node->second.tp3.index_max));
-        }
+        left = node.WithTP3(TurnPointRange(*this, node.tp3.index_min, split));
+        right = node.WithTP3(TurnPointRange(*this, split, node.tp3.index_max));
       }
 
-      if (add) {
-        // add the new candidate set only if it it's feasible and has d_min >= worst_d
-        if (left.df_max >= worst_d &&
-            left.IsFeasible(is_fai, large_triangle_check)) {
-          branch_and_bound.insert(std::pair<unsigned, CandidateSet>(left.df_max, left));
-        }
+      // use the new candidate sets only if they're feasible and have d_max >= worst_d
+      const bool left_ok = left.df_max >= worst_d &&
+        left.HasAscendingTriple() &&
+        left.IsFeasible(is_fai, large_triangle_check);
+      const bool right_ok = right.df_max >= worst_d &&
+        right.HasAscendingTriple() &&
+        right.IsFeasible(is_fai, large_triangle_check);
+
+      if (left_ok && right_ok) {
+        if (left.df_max < right.df_max)
+          std::swap(left, right);
+
+        PushCandidateSet(right);
+      } else if (right_ok)
+        left = right;
+      else if (!left_ok)
+        continue;
 
-        if (right.df_max >= worst_d &&
-            right.IsFeasible(is_fai, large_triangle_check)) {
-          branch_and_bound.insert(std::pair<unsigned, CandidateSet>(right.df_max, right));
-        }
+      if (!branch_and_bound.empty() &&
+          branch_and_bound.front().df_max > left.df_max) {
+        PushCandidateSet(left);
+        continue;
       }
-    }
 
-    // remove current node
-    branch_and_bound.erase(node);
-  }
+      node = left;
+      dive = true;
+    } while (dive && iterations < max_iterations);
 
+    if (dive)
+      /* interrupted by max_iterations; resume with this node */
+      PushCandidateSet(node);
+  }
 
   if (branch_and_bound.empty())
     running = false;
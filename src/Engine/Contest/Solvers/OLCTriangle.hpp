@@ -29,6 +29,7 @@
 #include "Geo/Flat/FlatBoundingBox.hpp"
 
 #include <map>
+#include <vector>
 
 /**
  * Specialisation of AbstractContest for OLC Triangle (triangle) rules
@@ -140,6 +141,34 @@ private:
 
   ClosingPairs closing_pairs;
 
+  /**
+   * Bounding boxes of all trace point ranges with a power-of-two
+   * size: entry (level * n_points + i) encloses the points
+   * [i, i + 2^level).  Any range box can be obtained from two
+   * overlapping entries of this table, which saves walking the trace
+   * each time the branch and bound algorithm splits a range.
+   */
+  std::vector<FlatBoundingBox> range_boxes;
+
+  /**
+   * The flat locations of the working trace points in one contiguous
+   * array, for the leg distance tables of SolveCandidateSet().
+   */
+  std::vector<FlatGeoPoint> flat_locations;
+
+  /**
+   * Candidate sets with at most this number of point triples are not
+   * split any further; all triples are checked at once by
+   * SolveCandidateSet().
+   */
+  static constexpr unsigned MAX_LEAF_TRIPLES = 64;
+
+  /**
+   * Scratch memory for the leg distance tables of
+   * SolveCandidateSet().
+   */
+  std::vector<unsigned> leg_tables;
+
   /**
    * A bounding box around a range of trace points.
    */
@@ -173,11 +202,7 @@ private:
 
     // updates the bounding box by a given point range
     void Update(const OLCTriangle &parent, unsigned _min, unsigned _max) {
-      bounding_box = FlatBoundingBox(parent.GetPoint(_min).GetFlatLocation());
-
-      for (unsigned i = _min + 1; i < _max; ++i)
-        bounding_box.Expand(parent.GetPoint(i).GetFlatLocation());
-
+      bounding_box = parent.GetRangeBox(_min, _max);
       index_min = _min;
       index_max = _max;
     }
@@ -196,41 +221,29 @@ private:
       const unsigned d_lat = std::max(bounding_box.GetTop() - tp.bounding_box.GetBottom(),
                                       tp.bounding_box.GetTop() - bounding_box.GetBottom());
 
-      return hypot(d_lon, d_lat);
+      return sqrt(double(d_lon) * d_lon + double(d_lat) * d_lat);
     }
   };
 
   /**
-   * A set of three TurnPointRanges which form a triangle
+   * Distance estimates of the three legs of a triangle, and the
+   * bounds of the total distance derived from them.
    */
-  struct CandidateSet {
-    TurnPointRange tp1, tp2, tp3;
+  struct LegBounds {
     unsigned df_min, df_max;
     unsigned shortest_max, longest_min, longest_max;
 
-    CandidateSet() :
+    /* distance estimates of the legs 1-2, 2-3 and 3-1, kept so a
+       child set only needs to recalculate the legs touching the
+       range that was split */
+    unsigned df_12_min, df_23_min, df_31_min;
+    unsigned df_12_max, df_23_max, df_31_max;
+
+    LegBounds() :
       df_min(0), df_max(0),
       shortest_max(0), longest_min(0), longest_max(0) {}
 
-    CandidateSet(const OLCTriangle &parent, unsigned first, unsigned last)
-      :tp1(parent, first, last), tp2(tp1), tp3(tp1) {
-      UpdateDistances();
-    }
-
-    CandidateSet(TurnPointRange _tp1, TurnPointRange _tp2, TurnPointRange _tp3)
-      :tp1(_tp1), tp2(_tp2), tp3(_tp3) {
-      UpdateDistances();
-    }
-
-    void UpdateDistances() {
-      const unsigned df_12_min = tp1.GetMinDistance(tp2),
-                     df_23_min = tp2.GetMinDistance(tp3),
-                     df_31_min = tp3.GetMinDistance(tp1);
-
-      const unsigned df_12_max = tp1.GetMaxDistance(tp2),
-                     df_23_max = tp2.GetMaxDistance(tp3),
-                     df_31_max = tp3.GetMaxDistance(tp1);
-
+    void UpdateBounds() {
       shortest_max = std::min({df_12_max, df_23_max, df_31_max});
       longest_min = std::max({df_12_min, df_23_min, df_31_min});
       longest_max = std::max({df_12_max, df_23_max, df_31_max});
@@ -241,10 +254,6 @@ private:
                         shortest_max * 4);
     }
 
-    bool operator==(CandidateSet other) const {
-      return (tp1 == other.tp1 && tp2 == other.tp2 && tp3 == other.tp3);
-    }
-
     /* Calculates if this candidate set is feasible
      * (i.e. it might contain a feasible triangle).
      * Use relaxed checks to ensure distance errors due to the flat projection
@@ -270,21 +279,19 @@ private:
       return true;
     }
 
-    /* Check if the candidate set is a real fai triangle. Use fast checks on projected
-     * distances for certain checks, otherwise real distances for marginal fai triangles.
+    /* Check if the triangle with these (exact) legs between the given
+     * trace points is a real fai triangle. Use fast checks on projected
+     * distances for certain checks, otherwise real distances for marginal
+     * fai triangles.
      */
     gcc_pure
-    bool IsIntegral(OLCTriangle &parent, const bool fai,
-                    const unsigned large_triangle_check) const {
-      if (!(tp1.GetSize() == 1 && tp2.GetSize() == 1 && tp3.GetSize() == 1))
-        return false;
-
+    bool IsIntegral(const OLCTriangle &parent, const bool fai,
+                    const unsigned large_triangle_check,
+                    unsigned p1, unsigned p2, unsigned p3) const {
       if (!fai) return true;
 
       // Solution is integral, calculate rough distance for fast checks
-      const unsigned df_total = tp1.GetMaxDistance(tp2) +
-                                tp2.GetMaxDistance(tp3) +
-                                tp3.GetMaxDistance(tp1);
+      const unsigned df_total = df_12_max + df_23_max + df_31_max;
 
       // fast checks, as in IsFeasible
 
@@ -301,9 +308,9 @@ private:
         return false;
 
       // detailed checks
-      auto geo_tp1 = parent.GetPoint(tp1.index_min).GetLocation();
-      auto geo_tp2 = parent.GetPoint(tp2.index_min).GetLocation();
-      auto geo_tp3 = parent.GetPoint(tp3.index_min).GetLocation();
+      auto geo_tp1 = parent.GetPoint(p1).GetLocation();
+      auto geo_tp2 = parent.GetPoint(p2).GetLocation();
+      auto geo_tp3 = parent.GetPoint(p3).GetLocation();
 
       const unsigned d_12 = unsigned(geo_tp1.Distance(geo_tp2));
       const unsigned d_23 = unsigned(geo_tp2.Distance(geo_tp3));
@@ -329,7 +336,118 @@ private:
     }
   };
 
-  std::multimap<unsigned, CandidateSet> branch_and_bound;
+  /**
+   * A set of three TurnPointRanges which form a triangle
+   */
+  struct CandidateSet : LegBounds {
+    TurnPointRange tp1, tp2, tp3;
+
+    CandidateSet() = default;
+
+    CandidateSet(const OLCTriangle &parent, unsigned first, unsigned last)
+      :tp1(parent, first, last), tp2(tp1), tp3(tp1) {
+      UpdateDistances();
+    }
+
+    CandidateSet(TurnPointRange _tp1, TurnPointRange _tp2, TurnPointRange _tp3)
+      :tp1(_tp1), tp2(_tp2), tp3(_tp3) {
+      UpdateDistances();
+    }
+
+    // returns a copy of this set with tp1 replaced
+    gcc_pure
+    CandidateSet WithTP1(const TurnPointRange &_tp1) const {
+      CandidateSet result(*this);
+      result.tp1 = _tp1;
+      result.UpdateLeg12();
+      result.UpdateLeg31();
+      result.UpdateBounds();
+      return result;
+    }
+
+    // returns a copy of this set with tp2 replaced
+    gcc_pure
+    CandidateSet WithTP2(const TurnPointRange &_tp2) const {
+      CandidateSet result(*this);
+      result.tp2 = _tp2;
+      result.UpdateLeg12();
+      result.UpdateLeg23();
+      result.UpdateBounds();
+      return result;
+    }
+
+    // returns a copy of this set with tp3 replaced
+    gcc_pure
+    CandidateSet WithTP3(const TurnPointRange &_tp3) const {
+      CandidateSet result(*this);
+      result.tp3 = _tp3;
+      result.UpdateLeg23();
+      result.UpdateLeg31();
+      result.UpdateBounds();
+      return result;
+    }
+
+    void UpdateDistances() {
+      UpdateLeg12();
+      UpdateLeg23();
+      UpdateLeg31();
+      UpdateBounds();
+    }
+
+    void UpdateLeg12() {
+      df_12_min = tp1.GetMinDistance(tp2);
+      df_12_max = tp1.GetMaxDistance(tp2);
+    }
+
+    void UpdateLeg23() {
+      df_23_min = tp2.GetMinDistance(tp3);
+      df_23_max = tp2.GetMaxDistance(tp3);
+    }
+
+    void UpdateLeg31() {
+      df_31_min = tp3.GetMinDistance(tp1);
+      df_31_max = tp3.GetMaxDistance(tp1);
+    }
+
+    bool operator==(CandidateSet other) const {
+      return (tp1 == other.tp1 && tp2 == other.tp2 && tp3 == other.tp3);
+    }
+
+    /**
+     * Does this set contain a triple with ascending point indices?
+     * All other triples are permutations of such a triple (or have
+     * two identical points), so only these need to be searched.
+     */
+    gcc_pure
+    bool HasAscendingTriple() const {
+      const unsigned min2 = std::max(tp2.index_min, tp1.index_min + 1);
+      if (min2 >= tp2.index_max)
+        return false;
+
+      const unsigned min3 = std::max(tp3.index_min, min2 + 1);
+      return min3 < tp3.index_max;
+    }
+
+    // returns the number of point triples in this set
+    gcc_pure
+    unsigned GetTripleCount() const {
+      return tp1.GetSize() * tp2.GetSize() * tp3.GetSize();
+    }
+  };
+
+  gcc_pure
+  static bool CompareCandidateSets(const CandidateSet &a,
+                                   const CandidateSet &b) {
+    return a.df_max < b.df_max;
+  }
+
+  /**
+   * The candidate sets which have yet to be examined, a binary heap
+   * with the largest CandidateSet::df_max on top.  Sets which have
+   * become obsolete because a better solution was found are skipped
+   * when they are taken from the heap.
+   */
+  std::vector<CandidateSet> branch_and_bound;
 
 public:
   OLCTriangle(const Trace &_trace,
@@ -351,6 +469,48 @@ protected:
   void UpdateTrace(bool force) override;
   void ResetBranchAndBound();
 
+private:
+  void PushCandidateSet(const CandidateSet &candidates);
+
+  /**
+   * Remove all candidate sets which cannot contain a triangle of at
+   * least the given distance.
+   *
+   * @return the new number of candidate sets
+   */
+  unsigned PruneBranchAndBound(unsigned worst_d);
+
+protected:
+
+private:
+  /**
+   * Rebuild #range_boxes from the current working trace.
+   */
+  void UpdateRangeBoxes();
+
+  /**
+   * Returns the bounding box of the trace points [min, max).
+   */
+  gcc_pure
+  FlatBoundingBox GetRangeBox(unsigned min, unsigned max) const;
+
+  /**
+   * Check all point triples of a candidate set with at most
+   * #MAX_LEAF_TRIPLES triples, with the same bounds and checks the
+   * branch and bound algorithm applies to single point sets.  The
+   * flat leg distances are calculated once per point pair.
+   *
+   * @param worst_d the minimum distance of a solution; updated when
+   * a solution is found
+   * @param best the triangle found (three indices and its maximum
+   * distance estimate)
+   * @return true if a solution was found
+   */
+  bool SolveCandidateSet(const CandidateSet &candidates,
+                         unsigned large_triangle_check,
+                         unsigned &worst_d,
+                         std::tuple<unsigned, unsigned, unsigned, unsigned> &best);
+
 public:
   void SetMaxIterations(unsigned _max_iterations) {
     max_iterations = _max_iterations;
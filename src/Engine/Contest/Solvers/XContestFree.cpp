@@ -37,3 +37,11 @@ XContestFree::CalculateResult() const
   result.score = ApplyHandicap(result.distance * score_factor);
   return result;
 }
+
+double
+XContestFree::CalculateScoreBound(double distance,
+                                  gcc_unused double weighted_distance) const
+{
+  const auto score_factor = is_dhv ? 0.0015 : 0.0010;
+  return ApplyHandicap(distance * score_factor);
+}
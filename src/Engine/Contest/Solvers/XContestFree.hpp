@@ -38,6 +38,10 @@ public:
 protected:
   /* virtual methods from AbstractContest */
   ContestResult CalculateResult() const override;
+
+  /* virtual methods from ContestDijkstra */
+  double CalculateScoreBound(double distance,
+                             double weighted_distance) const override;
 };
 
 #endif
@@ -136,6 +136,18 @@ public:
     return q.size();
   }
 
+  /**
+   * Invoke a function for each node which is waiting in the queue,
+   * passing the node and its value.  Entries which have been
+   * superseded by a better link are skipped.
+   */
+  template<typename F>
+  void VisitQueue(F &&f) const {
+    for (const auto &i : q)
+      if (i.iterator->second.value == i.edge_value)
+        f(i.iterator->first, i.edge_value);
+  }
+
   /**
    * Hack to allow incremental / continuous runs, see
    * ContestDijkstra::AddIncrementalEdges().
@@ -86,7 +86,14 @@ AirspaceRoute::FirstIntersecting(const RouteLink &e) const
   const GeoPoint origin(projection.Unproject(e.first));
   const GeoPoint dest(projection.Unproject(e.second));
   AIV visitor(e, projection, rpolars_route);
-  m_airspaces.VisitIntersecting(origin, dest, visitor);
+
+  /* the visitor rejects airspaces which don't contain the altitude
+     of the intercept; skip those which can't possibly contain it */
+  int min_altitude, max_altitude;
+  rpolars_route.CalcIntermediateAltitudes(e, projection,
+                                          min_altitude, max_altitude);
+  m_airspaces.VisitIntersecting(origin, dest, min_altitude, max_altitude,
+                                false, visitor);
   const AIV::AIVResult res(visitor.GetNearest());
   ++count_airspace;
   return RouteAirspaceIntersection(res.first, res.second);
@@ -97,7 +104,9 @@ AirspaceRoute::InsideOthers(const AGeoPoint &origin) const
 {
   ++count_airspace;
 
-  for (const auto &i : m_airspaces.QueryWithinRange(origin, 1))
+  for (const auto &i : m_airspaces.QueryWithinRange(origin, 1,
+                                                    origin.altitude,
+                                                    origin.altitude))
     return &i.GetAirspace();
 
   return nullptr;
@@ -126,3 +126,12 @@ ReachFan::AcceptInRange(const GeoBounds &bounds,
   const FlatBoundingBox bb = projection.Project(bounds);
   root.AcceptInRange(bb, visitor);
 }
+
+void
+ReachFan::AcceptRoot(FlatTriangleFanVisitor &visitor) const
+{
+  if (root.IsEmpty() || root.IsDummy())
+    return;
+
+  visitor.VisitFan(root.GetOrigin(), root.GetHull(root.IsRoot()));
+}
@@ -61,6 +61,12 @@ public:
   void AcceptInRange(const GeoBounds &bounds,
                      FlatTriangleFanVisitor &visitor) const;
 
+  /**
+   * Visit only the root fan, whose hull is the outline of the reach
+   * before it was refined by the child fans.
+   */
+  void AcceptRoot(FlatTriangleFanVisitor &visitor) const;
+
   int GetTerrainBase() const {
     return terrain_base;
   }
@@ -37,6 +37,7 @@ RoutePlanner::ClearReach()
 {
   reach_terrain.Reset();
   reach_working.Reset();
+  ++reach_serial;
 }
 
 void
@@ -62,6 +63,7 @@ RoutePlanner::SolveReachTerrain(const AGeoPoint &origin,
   rpolars_reach.SetConfig(config, origin.altitude, h_ceiling);
   reach_polar_mode = config.reach_polar_mode;
 
+  ++reach_serial;
   return reach_terrain.Solve(origin, rpolars_reach, terrain, do_solve);
 }
 
@@ -30,6 +30,7 @@
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Geo/SearchPointVector.hpp"
 #include "ReachFan.hpp"
+#include "Util/Serial.hpp"
 
 #include <utility>
 #include <unordered_set>
@@ -148,6 +149,11 @@ private:
 
   RoutePlannerConfig::Polar reach_polar_mode;
 
+  /**
+   * Incremented each time #reach_terrain is solved or cleared.
+   */
+  Serial reach_serial;
+
   mutable unsigned long count_dij;
   mutable unsigned long count_unique;
   mutable unsigned long count_supressed;
@@ -179,6 +185,13 @@ public:
     return reach_terrain.IsEmpty();
   }
 
+  /**
+   * Allows the caller to detect changes of the terrain reach.
+   */
+  const Serial &GetReachSerial() const {
+    return reach_serial;
+  }
+
   /**
    * Delete all reach fans.
    */
@@ -231,6 +244,14 @@ public:
                      FlatTriangleFanVisitor &visitor,
                      bool working) const;
 
+  /**
+   * Visit only the root fan of the terrain reach, which contains the
+   * origin and approximates the reach boundary.
+   */
+  void AcceptTerrainReachRoot(FlatTriangleFanVisitor &visitor) const {
+    reach_terrain.AcceptRoot(visitor);
+  }
+
   /**
    * Retrieve current solution.  If solver failed previously,
    * direct flight from origin to destination is produced.
@@ -58,6 +58,24 @@ RoutePolar::Initialise(const GlideSettings &settings, const GlidePolar& polar,
   }
 }
 
+void
+RoutePolar::CalcGradientRange(double &min_gradient, double &max_gradient) const
+{
+  bool found = false;
+  min_gradient = max_gradient = 0;
+
+  for (const auto &point : points) {
+    if (!point.valid)
+      continue;
+
+    if (!found || point.gradient < min_gradient)
+      min_gradient = point.gradient;
+    if (!found || point.gradient > max_gradient)
+      max_gradient = point.gradient;
+    found = true;
+  }
+}
+
 static constexpr FlatGeoPoint index_to_point[] = {
   {128, 0},
   {126, 16},
@@ -97,6 +97,13 @@ public:
     return points[index];
   }
 
+  /**
+   * Determine the smallest and the largest glide slope gradient of
+   * all valid directions.  Both are zero if there is no valid
+   * direction.
+   */
+  void CalcGradientRange(double &min_gradient, double &max_gradient) const;
+
   /**
    * Calculate distances normalised to 128 corresponding to direction index
    *
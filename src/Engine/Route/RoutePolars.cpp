@@ -26,6 +26,10 @@
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Terrain/RasterMap.hpp"
 
+#include <algorithm>
+
+#include <math.h>
+
 #define MC_CEILING_PENALTY_FACTOR 5.0
 
 inline FlatGeoPoint
@@ -105,6 +109,31 @@ RoutePolars::CalcVHeight(const RouteLink &link) const
   return polar_glide.GetPoint(link.polar_index).gradient * link.d;
 }
 
+void
+RoutePolars::CalcIntermediateAltitudes(const RouteLink &link,
+                                       const FlatProjection &proj,
+                                       int &min_altitude,
+                                       int &max_altitude) const
+{
+  const int origin = link.first.altitude;
+
+  if (CanClimb()) {
+    min_altitude = origin;
+    max_altitude = std::max(origin, cruise_altitude);
+    return;
+  }
+
+  /* the intermediate point is rounded to the flat grid and may lie
+     slightly beyond the end of the link */
+  const auto d = link.d + 2 * proj.GetApproximateScale();
+
+  double min_gradient, max_gradient;
+  polar_glide.CalcGradientRange(min_gradient, max_gradient);
+
+  min_altitude = origin + (int)floor(std::min(min_gradient * d, 0.)) - 1;
+  max_altitude = origin + (int)ceil(std::max(max_gradient * d, 0.)) + 1;
+}
+
 bool
 RoutePolars::CheckClearance(const RouteLink &e, const RasterMap* map,
                             const FlatProjection &proj, RoutePoint& inp) const
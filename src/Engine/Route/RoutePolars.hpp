@@ -137,6 +137,20 @@ public:
    */
   double CalcVHeight(const RouteLink &link) const;
 
+  /**
+   * Calculate the altitude band containing all intermediate points
+   * GenerateIntermediate() can produce from the origin of the given
+   * link towards any point on it.
+   *
+   * @param link Link to evaluate
+   * @param proj Task projection
+   * @param min_altitude (output) lower end of the band (m)
+   * @param max_altitude (output) upper end of the band (m)
+   */
+  void CalcIntermediateAltitudes(const RouteLink &link,
+                                 const FlatProjection &proj,
+                                 int &min_altitude, int &max_altitude) const;
+
   /**
    * Generate a link from the destination imposing constraints on the origin
    * based on cruise altitude and climb limits.
@@ -75,6 +75,8 @@ TaskManager::SetOrderedTaskSettings(const OrderedTaskSettings &otb)
 TaskType
 TaskManager::SetMode(const TaskType _mode)
 {
+  ++serial;
+
   switch(_mode) {
   case TaskType::ABORT:
     active_task = abort_task;
@@ -108,8 +110,10 @@ TaskManager::SetMode(const TaskType _mode)
 void
 TaskManager::SetActiveTaskPoint(unsigned index)
 {
-  if (active_task)
+  if (active_task) {
     active_task->SetActiveTaskPoint(index);
+    ++serial;
+  }
 }
 
 unsigned
@@ -127,9 +131,10 @@ TaskManager::IncrementActiveTaskPoint(int offset)
   if (active_task) {
     unsigned i = GetActiveTaskPointIndex();
     if ((int)i+offset<0) { // prevent wrap-around
-      if (mode == TaskType::ORDERED)
+      if (mode == TaskType::ORDERED) {
         ordered_task->RotateOptionalStarts();
-      else
+        ++serial;
+      } else
         SetActiveTaskPoint(0);
     } else {
       SetActiveTaskPoint(i+offset);
@@ -276,6 +281,14 @@ TaskManager::Update(const AircraftState &state,
 
   bool retval = false;
 
+  /* remember the active task point to detect task advance and
+     changes of the abort task */
+  const unsigned old_active_index = GetActiveTaskPointIndex();
+  const TaskWaypoint *old_active = GetActiveTaskPoint();
+  const GeoPoint old_active_location = old_active != nullptr
+    ? old_active->GetLocation()
+    : GeoPoint::Invalid();
+
   if (state_last.time >= 0 && state.time >= 0 &&
       state_last.time > state.time)
     /* time warp */
@@ -312,6 +325,13 @@ TaskManager::Update(const AircraftState &state,
     // update mode task for any that have not yet run
     retval |= active_task->Update(state, state_last, glide_polar);
 
+  const TaskWaypoint *new_active = GetActiveTaskPoint();
+  if (GetActiveTaskPointIndex() != old_active_index ||
+      (new_active != nullptr) != old_active_location.IsValid() ||
+      (new_active != nullptr &&
+       new_active->GetLocation() != old_active_location))
+    ++serial;
+
   UpdateCommonStats(state);
 
   return retval;
@@ -346,6 +366,8 @@ bool
 TaskManager::DoGoto(WaypointPtr &&wp)
 {
   if (goto_task->DoGoto(std::move(wp))) {
+    /* SetMode() increments the serial, even if we were already in
+       GOTO mode */
     SetMode(TaskType::GOTO);
     return true;
   }
@@ -400,6 +422,7 @@ TaskManager::Reset()
   abort_task->Reset();
   common_stats.Reset();
   glide_polar.SetCruiseEfficiency(1);
+  ++serial;
 }
 
 unsigned
@@ -523,6 +546,7 @@ bool
 TaskManager::Commit(const OrderedTask &other)
 {
   bool retval = ordered_task->Commit(other);
+  ++serial;
 
   if (other.TaskSize()) {
     // if valid, resume the task
@@ -569,5 +593,6 @@ TaskManager::ResetTask()
   if (active_task != nullptr) {
     active_task->Reset();
     UpdateCommonStatsTask();
+    ++serial;
   }
 }
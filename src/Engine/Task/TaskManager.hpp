@@ -30,6 +30,7 @@
 #include "GlideSolvers/GlidePolar.hpp"
 #include "TaskBehaviour.hpp"
 #include "Waypoint/Ptr.hpp"
+#include "Util/Serial.hpp"
 
 class AbstractTaskFactory;
 class TaskEvents;
@@ -72,6 +73,12 @@ class TaskManager:
 
   CommonStats common_stats;
 
+  /**
+   * Incremented whenever the active task, its active task point or
+   * the ordered task may have changed.
+   */
+  Serial serial;
+
 public:
   /**
    * Constructor for task manager
@@ -312,6 +319,15 @@ public:
     return mode;
   }
 
+  /**
+   * Allows the caller to detect changes of the active task, its
+   * active task point or the ordered task, e.g. to invalidate cached
+   * task point locations.
+   */
+  const Serial &GetSerial() const {
+    return serial;
+  }
+
   /**
    * Determine if the active mode is a particular mode
    *
@@ -32,18 +32,28 @@
 #include "Util/ReservablePriorityQueue.hpp"
 #include "Util/Clamp.hpp"
 
+#include <algorithm>
+
 /** min search range in m */
 static constexpr double min_search_range = 50000;
 
 /** max search range in m */
 static constexpr double max_search_range = 100000;
 
+/**
+ * The candidate list covers this much more than the search range
+ * [m], so the aircraft can move this far before it has to be rebuilt.
+ */
+static constexpr double candidates_margin = 5000;
+
 AbortTask::AbortTask(const TaskBehaviour &_task_behaviour,
                      const Waypoints &wps)
   :UnorderedTask(TaskType::ABORT, _task_behaviour),
    waypoints(wps),
    intersection_test(NULL),
-   active_waypoint(0)
+   active_waypoint(0),
+   candidates_location(GeoPoint::Invalid()),
+   generation(0)
 {
   task_points.reserve(32);
 }
@@ -138,53 +148,90 @@ IsReachable(const GlideResult &result, bool final_glide)
 
 bool
 AbortTask::FillReachable(const AircraftState &state,
-                         AlternateList &approx_waypoints,
                          const GlidePolar &polar, bool only_airfield,
                          bool final_glide, bool safety)
 {
-  if (IsTaskFull() || approx_waypoints.empty())
+  if (IsTaskFull() || candidates.empty())
     return false;
 
-  const AGeoPoint p_start(state.location, state.altitude);
+  /* the candidates are sorted by their distance from
+     candidates_location; the distance from the aircraft is at least
+     that minus the distance the aircraft has moved since (with a
+     little tolerance for rounding errors) */
+  const double moved = state.location.Distance(candidates_location) + 1;
+  const double range = GetAbortRange(state, polar);
+
+  /* no waypoint can be reached sooner than by flying straight at the
+     polar's maximum speed with full tail wind */
+  const double max_speed =
+    polar.GetVMax() * polar.GetCruiseEfficiency() + state.wind.norm;
+
+  /* the arrival times of the best reachable waypoints found so far,
+     as many as there is room left in the task; the worst one is on
+     top */
+  const unsigned room = max_abort - task_points.size();
+  reservable_priority_queue<double, std::vector<double>,
+                            std::less<double>> best_times;
+  best_times.reserve(room + 1);
 
   bool found_final_glide = false;
   reservable_priority_queue<AlternatePoint, AlternateList, AbortRank> q;
   q.reserve(32);
 
-  for (auto v = approx_waypoints.begin(); v != approx_waypoints.end();) {
-    if (only_airfield && !v->waypoint->IsAirport()) {
-      ++v;
+  for (auto &c : candidates) {
+    const double min_distance = c.distance - moved;
+    if (min_distance > range)
+      /* this one and all following ones are out of range */
+      break;
+
+    if (best_times.size() >= room && max_speed > 0 &&
+        best_times.top() < min_distance / max_speed)
+      /* none of the remaining waypoints can be faster than the ones
+         already found, which are enough to fill the task */
+      break;
+
+    if (c.used_generation == generation ||
+        (only_airfield && !c.waypoint->IsAirport()))
       continue;
-    }
 
-    auto wp = v->waypoint;
-    UnorderedTaskPoint t(std::move(wp), task_behaviour);
-    GlideResult result =
-        TaskSolution::GlideSolutionRemaining(t, state,
-                                             task_behaviour.glide, polar);
+    if (c.solved_generation != generation) {
+      /* the solution does not depend on the pass, so calculate it
+         only once per update */
+      const Waypoint &waypoint = *c.waypoint;
+      const double elevation =
+        std::max(0., waypoint.elevation + task_behaviour.safety_height_arrival);
+      c.solution = TaskSolution::GlideSolutionRemaining(state.location,
+                                                        waypoint.location,
+                                                        elevation,
+                                                        state.altitude,
+                                                        state.wind,
+                                                        task_behaviour.glide,
+                                                        polar);
+      c.solved_generation = generation;
+    }
 
+    const GlideResult &result = c.solution;
     if (IsReachable(result, final_glide)) {
       bool intersects = false;
       const bool is_reachable_final = IsReachable(result, true);
 
       if (intersection_test && final_glide && is_reachable_final)
         intersects = intersection_test->Intersects(
-            AGeoPoint(v->waypoint->location, result.min_arrival_altitude));
+            AGeoPoint(c.waypoint->location, result.min_arrival_altitude));
 
       if (!intersects) {
-        wp = v->waypoint;
-        q.push(AlternatePoint(std::move(wp), result));
-        // remove it since it's already in the list now      
-        v = approx_waypoints.erase(v);
+        q.push(AlternatePoint(c.waypoint, result));
+        // skip it in the following passes since it's already in the list now
+        c.used_generation = generation;
+
+        best_times.push(result.time_elapsed + result.time_virtual);
+        if (best_times.size() > room)
+          best_times.pop();
 
         if (is_reachable_final)
           found_final_glide = true;
-
-        continue; // skip incrementing v since we just erased it
       }
-    } 
-
-    ++v;
+    }
   }
 
   while (!q.empty() && !IsTaskFull()) {
@@ -203,34 +250,60 @@ AbortTask::FillReachable(const AircraftState &state,
 }
 
 /**
- * Class to build vector from visited waypoints.
+ * Class to build the candidate list from visited waypoints.
  * Intended to be used temporarily.
  */
-class WaypointVisitorVector final : public WaypointVisitor
+template<typename V>
+class WaypointVisitorCandidates final : public WaypointVisitor
 {
-  AlternateList &vector;
+  V &vector;
+  const GeoPoint location;
 
 public:
-  /**
-   * Constructor
-   *
-   * @param wpv Vector to add to
-   *
-   * @return Initialised object
-   */
-  WaypointVisitorVector(AlternateList &wpv):vector(wpv) {}
+  WaypointVisitorCandidates(V &_vector, const GeoPoint &_location)
+    :vector(_vector), location(_location) {}
 
   /**
-   * Visit method, adds result to vector
+   * Visit method, adds landable waypoints to the vector
    *
    * @param wp Waypoint that is visited
    */
   void Visit(const WaypointPtr &wp) override {
     if (wp->IsLandable())
-      vector.emplace_back(wp);
+      vector.emplace_back(wp, location.Distance(wp->location));
   }
 };
 
+void
+AbortTask::UpdateCandidates(const GeoPoint &location, double range)
+{
+  if (candidates_location.IsValid() &&
+      candidates_serial == waypoints.GetSerial() &&
+      location.Distance(candidates_location) + range <= candidates_range)
+    /* the current search area is covered by the existing list */
+    return;
+
+  candidates.clear();
+  candidates_location = location;
+  candidates_range = range + candidates_margin;
+  candidates_serial = waypoints.GetSerial();
+
+  WaypointVisitorCandidates<decltype(candidates)> v(candidates, location);
+  waypoints.VisitWithinRange(location, candidates_range, v);
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate &a, const Candidate &b){
+              return a.distance < b.distance;
+            });
+}
+
+void
+AbortTask::ClearCandidates()
+{
+  candidates.clear();
+  candidates_location = GeoPoint::Invalid();
+}
+
 void 
 AbortTask::ClientUpdate(const AircraftState &state_now, bool reachable)
 {
@@ -260,30 +333,27 @@ AbortTask::UpdateSample(const AircraftState &state,
     /* can't work without a polar */
     return false;
 
-  AlternateList approx_waypoints;
-  approx_waypoints.reserve(128);
-
-  WaypointVisitorVector wvv(approx_waypoints);
-  waypoints.VisitWithinRange(state.location,
-                             GetAbortRange(state, glide_polar), wvv);
-  if (approx_waypoints.empty()) {
+  UpdateCandidates(state.location, GetAbortRange(state, glide_polar));
+  if (candidates.empty()) {
     /** @todo increase range */
     return false;
   }
 
+  ++generation;
+
   // sort by arrival time
 
   // first try with final glide only
-  reachable_landable |=  FillReachable(state, approx_waypoints, glide_polar,
+  reachable_landable |=  FillReachable(state, glide_polar,
                                        true, true, true);
-  reachable_landable |=  FillReachable(state, approx_waypoints, glide_polar,
+  reachable_landable |=  FillReachable(state, glide_polar,
                                        false, true, true);
 
   // inform clients that the landable reachable scan has been performed 
   ClientUpdate(state, true);
 
   // now try without final glide constraint and not preferring airports
-  FillReachable(state, approx_waypoints, glide_polar, false, false, false);
+  FillReachable(state, glide_polar, false, false, false);
 
   // inform clients that the landable unreachable scan has been performed 
   ClientUpdate(state, false);
@@ -312,6 +382,7 @@ void
 AbortTask::Reset()
 {
   Clear();
+  ClearCandidates();
   UnorderedTask::Reset();
 }
 
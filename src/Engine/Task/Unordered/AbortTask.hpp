@@ -25,6 +25,8 @@
 
 #include "UnorderedTask.hpp"
 #include "UnorderedTaskPoint.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Util/Serial.hpp"
 
 #include <vector>
 
@@ -32,7 +34,6 @@
 
 class Waypoints;
 class AbortIntersectionTest;
-class AlternateList;
 
 /**
  * Abort task provides automatic management of a sorted list of task points
@@ -80,6 +81,51 @@ private:
   unsigned active_waypoint;
   bool reachable_landable;
 
+  /**
+   * A landable waypoint near #candidates_location, see #candidates.
+   */
+  struct Candidate {
+    WaypointPtr waypoint;
+
+    /** distance from #candidates_location [m] */
+    double distance;
+
+    /**
+     * The glide solution calculated by the current update; valid only
+     * if #solved_generation equals #generation.
+     */
+    GlideResult solution;
+
+    /** the update which calculated #solution */
+    unsigned solved_generation;
+
+    /** the update which added this waypoint to the task */
+    unsigned used_generation;
+
+    Candidate(const WaypointPtr &_waypoint, double _distance)
+      :waypoint(_waypoint), distance(_distance),
+       solved_generation(0), used_generation(0) {}
+  };
+
+  /**
+   * The landable waypoints within #candidates_range of
+   * #candidates_location, sorted by distance.  This list survives
+   * updates; it is only rebuilt when the search range of the current
+   * location is no longer inside its area, or when the waypoints have
+   * been modified.
+   */
+  std::vector<Candidate> candidates;
+
+  GeoPoint candidates_location;
+  double candidates_range;
+  Serial candidates_serial;
+
+  /**
+   * Incremented by each UpdateSample() call; used to invalidate the
+   * per-update attributes of #candidates without visiting them.
+   */
+  unsigned generation;
+
 public:
   /** 
    * Base constructor.
@@ -155,12 +201,10 @@ protected:
                        const GlidePolar &glide_polar) const;
 
   /**
-   * Fill abort task list with candidate waypoints given a list of
-   * waypoints satisfying approximate range queries.  Can be used
-   * to add airfields only, or landpoints.
+   * Fill abort task list with waypoints from #candidates.  Can be
+   * used to add airfields only, or landpoints.
    *
    * @param state Aircraft state
-   * @param approx_waypoints List of candidate waypoints
    * @param polar Polar used for tests
    * @param only_airfield If true, only add waypoints that are airfields.
    * @param final_glide Whether solution must be glide only or climb allowed
@@ -169,10 +213,22 @@ protected:
    * @return True if a landpoint within final glide was found
    */
   bool FillReachable(const AircraftState &state,
-                     AlternateList &approx_waypoints,
                      const GlidePolar &polar, bool only_airfield,
                      bool final_glide, bool safety);
 
+private:
+  /**
+   * Rebuild #candidates if it does not cover all waypoints within
+   * the given range of the given location.
+   */
+  void UpdateCandidates(const GeoPoint &location, double range);
+
+  /**
+   * Forget #candidates, e.g. because the waypoints they refer to may
+   * be deleted.
+   */
+  void ClearCandidates();
+
 protected:
   /**
    * This is called by update_sample after the turnpoint list has 
@@ -23,41 +23,63 @@ Copyright_License {
 
 #include "Trace.hpp"
 #include "Vector.hpp"
-#include "Util/GlobalSliceAllocator.hpp"
 
 #include <algorithm>
 
 Trace::Trace(const unsigned _no_thin_time, const unsigned max_time,
              const unsigned max_size)
-  :cached_size(0),
+  :nodes(max_size + 1), heap(max_size),
    max_time(max_time),
    no_thin_time(_no_thin_time),
    max_size(max_size),
    opt_size((3 * max_size) / 4)
 {
   assert(max_size >= 4);
+
+  clear();
 }
 
 void
 Trace::clear()
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.size());
-
   average_delta_distance = 0;
   average_delta_time = 0;
 
-  delta_list.clear();
-  chronological_list.clear_and_dispose(MakeDisposer());
-  cached_size = 0;
+  /* link all items into the free list */
+  for (unsigned i = 0; i < max_size; ++i)
+    nodes[i].next = i + 1;
+  free_head = 0;
 
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.size());
+  TraceDelta &head = nodes[GetHead()];
+  head.prev = head.next = GetHead();
+
+  heap_size = 0;
+  cached_size = 0;
 
   ++modify_serial;
   ++append_serial;
 }
 
+void
+Trace::CopyFrom(const Trace &other)
+{
+  assert(other.max_size == max_size);
+
+  std::copy(other.nodes.begin(), other.nodes.end(), nodes.begin());
+  std::copy_n(other.heap.begin(), other.heap_size, heap.begin());
+  heap_size = other.heap_size;
+  free_head = other.free_head;
+  cached_size = other.cached_size;
+
+  task_projection = other.task_projection;
+
+  average_delta_time = other.average_delta_time;
+  average_delta_distance = other.average_delta_distance;
+
+  append_serial = other.append_serial;
+  modify_serial = other.modify_serial;
+}
+
 unsigned
 Trace::GetRecentTime(const unsigned t) const
 {
@@ -71,43 +93,138 @@ Trace::GetRecentTime(const unsigned t) const
   return 0;
 }
 
+unsigned
+Trace::AppendNode(const TracePoint &point)
+{
+  const unsigned i = free_head;
+  assert(i != GetHead());
+
+  TraceDelta &td = nodes[i];
+  free_head = td.next;
+
+  td.Set(point);
+
+  TraceDelta &head = nodes[GetHead()];
+  td.prev = head.prev;
+  td.next = GetHead();
+  nodes[head.prev].next = i;
+  head.prev = i;
+
+  return i;
+}
+
 void
-Trace::UpdateDelta(TraceDelta &td)
+Trace::FreeNode(unsigned i)
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.size());
+  TraceDelta &td = nodes[i];
+  assert(td.heap_index == NOT_IN_HEAP);
+
+  nodes[td.prev].next = td.next;
+  nodes[td.next].prev = td.prev;
 
-  if (&td == &chronological_list.front() ||
-      &td == &chronological_list.back())
+  td.next = free_head;
+  free_head = i;
+}
+
+void
+Trace::HeapSiftUp(unsigned position)
+{
+  while (position > 0) {
+    const unsigned parent = (position - 1) / 2;
+    if (!HeapLess(position, parent))
+      break;
+
+    HeapSwap(position, parent);
+    position = parent;
+  }
+}
+
+void
+Trace::HeapSiftDown(unsigned position)
+{
+  while (true) {
+    const unsigned left = 2 * position + 1;
+    if (left >= heap_size)
+      break;
+
+    const unsigned right = left + 1;
+    const unsigned child = right < heap_size && HeapLess(right, left)
+      ? right
+      : left;
+    if (!HeapLess(child, position))
+      break;
+
+    HeapSwap(position, child);
+    position = child;
+  }
+}
+
+void
+Trace::HeapUpdate(unsigned position)
+{
+  assert(position < heap_size);
+
+  if (position > 0 && HeapLess(position, (position - 1) / 2))
+    HeapSiftUp(position);
+  else
+    HeapSiftDown(position);
+}
+
+void
+Trace::HeapPush(unsigned i)
+{
+  assert(heap_size < max_size);
+
+  const unsigned position = heap_size++;
+  heap[position] = i;
+  nodes[i].heap_index = position;
+  HeapSiftUp(position);
+}
+
+void
+Trace::HeapRemove(unsigned i)
+{
+  const unsigned position = nodes[i].heap_index;
+  assert(position < heap_size);
+  assert(heap[position] == i);
+
+  nodes[i].heap_index = NOT_IN_HEAP;
+
+  const unsigned last = --heap_size;
+  if (position != last) {
+    heap[position] = heap[last];
+    nodes[heap[position]].heap_index = position;
+    HeapUpdate(position);
+  }
+}
+
+void
+Trace::UpdateDelta(unsigned i)
+{
+  if (i == GetFront() || i == GetBack())
     return;
 
-  const auto ci = chronological_list.iterator_to(td);
-  const TraceDelta &previous = *std::prev(ci);
-  const TraceDelta &next = *std::next(ci);
+  TraceDelta &td = nodes[i];
+  td.Update(nodes[td.prev].point, nodes[td.next].point);
 
-  delta_list.erase(delta_list.iterator_to(td));
-  td.Update(previous.point, next.point);
-  delta_list.insert(td);
+  /* the item may have been taken out of the heap by EraseDelta() */
+  if (td.heap_index != NOT_IN_HEAP)
+    HeapUpdate(td.heap_index);
 }
 
 void
-Trace::EraseInside(DeltaList::iterator it)
+Trace::EraseInside(unsigned i)
 {
   assert(cached_size > 0);
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.size());
-  assert(it != delta_list.end());
 
-  const TraceDelta &td = *it;
+  const TraceDelta &td = nodes[i];
   assert(!td.IsEdge());
 
-  const auto ci = chronological_list.iterator_to(td);
-  TraceDelta &previous = const_cast<TraceDelta &>(*std::prev(ci));
-  TraceDelta &next = const_cast<TraceDelta &>(*std::next(ci));
+  const unsigned previous = td.prev, next = td.next;
 
   // now delete the item
-  chronological_list.erase(chronological_list.iterator_to(td));
-  delta_list.erase_and_dispose(it, MakeDisposer());
+  HeapRemove(i);
+  FreeNode(i);
   --cached_size;
 
   // and update the deltas
@@ -118,8 +235,7 @@ Trace::EraseInside(DeltaList::iterator it)
 bool
 Trace::EraseDelta(const unsigned target_size, const unsigned recent)
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.size());
+  assert(cached_size == heap_size);
 
   if (size() <= 2)
     return false;
@@ -128,40 +244,46 @@ Trace::EraseDelta(const unsigned target_size, const unsigned recent)
 
   const unsigned recent_time = GetRecentTime(recent);
 
-  auto candidate = delta_list.begin();
-  while (size() > target_size) {
-    const TraceDelta &td = *candidate;
+  /* items which must not be erased are taken out of the heap, so
+     the top of the heap is always the best candidate; they are
+     parked at the end of the heap array, which is unused because
+     the heap shrinks by at least one item for each of them */
+  unsigned n_suppressed = 0;
+  while (size() > target_size && heap_size > 0) {
+    const unsigned i = heap[0];
+    const TraceDelta &td = nodes[i];
     if (!td.IsEdge() && td.point.GetTime() < recent_time) {
-      EraseInside(candidate);
-      candidate = delta_list.begin(); // find new top
+      EraseInside(i);
       modified = true;
     } else {
-      ++candidate;
       // suppressed removal, skip it.
+      HeapRemove(i);
+      heap[max_size - ++n_suppressed] = i;
     }
   }
 
+  while (n_suppressed > 0) {
+    const unsigned i = heap[max_size - n_suppressed--];
+    HeapPush(i);
+  }
+
   return modified;
 }
 
 bool
 Trace::EraseEarlierThan(const unsigned p_time)
 {
-  if (p_time == 0 || empty() || GetFront().point.GetTime() >= p_time)
+  if (p_time == 0 || empty() || front().GetTime() >= p_time)
     // there will be nothing to remove
     return false;
 
   do {
-    auto ci = chronological_list.begin();
-    TraceDelta &td = *ci;
-    chronological_list.erase(ci);
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase_and_dispose(i, MakeDisposer());
+    const unsigned i = GetFront();
+    HeapRemove(i);
+    FreeNode(i);
 
     --cached_size;
-  } while (!empty() && GetFront().point.GetTime() < p_time);
+  } while (!empty() && front().GetTime() < p_time);
 
   // need to set deltas for first point, only one of these
   // will occur (have to search for this point)
@@ -179,14 +301,10 @@ Trace::EraseLaterThan(const unsigned min_time)
   assert(min_time > 0);
   assert(!empty());
 
-  while (!empty() && GetBack().point.GetTime() > min_time) {
-    TraceDelta &td = GetBack();
-
-    chronological_list.erase(chronological_list.iterator_to(td));
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase_and_dispose(i, MakeDisposer());
+  while (!empty() && back().GetTime() > min_time) {
+    const unsigned i = GetBack();
+    HeapRemove(i);
+    FreeNode(i);
 
     --cached_size;
   }
@@ -201,21 +319,19 @@ Trace::EraseLaterThan(const unsigned min_time)
  * Update start node (and neighbour) after min time pruning
  */
 void
-Trace::EraseStart(TraceDelta &td)
+Trace::EraseStart(unsigned i)
 {
-  delta_list.erase(delta_list.iterator_to(td));
-
+  TraceDelta &td = nodes[i];
   td.elim_distance = null_delta;
   td.elim_time = null_time;
 
-  delta_list.insert(td);
+  HeapUpdate(td.heap_index);
 }
 
 void
 Trace::push_back(const TracePoint &point)
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.size());
+  assert(cached_size == heap_size);
 
   if (empty()) {
     // first point determines origin for flat projection
@@ -244,17 +360,14 @@ Trace::push_back(const TracePoint &point)
 
   assert(size() < max_size);
 
-  TraceDelta *td = allocator.allocate(1);
-  allocator.construct(td, point);
-  td->point.Project(task_projection);
-
-  delta_list.insert(*td);
-  chronological_list.push_back(*td);
+  const unsigned i = AppendNode(point);
+  nodes[i].point.Project(task_projection);
+  HeapPush(i);
 
   ++cached_size;
 
-  if (td != &chronological_list.front())
-    UpdateDelta(*std::prev(chronological_list.iterator_to(*td)));
+  if (i != GetFront())
+    UpdateDelta(nodes[i].prev);
 
   ++append_serial;
 }
@@ -266,10 +379,10 @@ Trace::CalcAverageDeltaDistance(const unsigned no_thin) const
   unsigned acc = 0;
   unsigned counter = 0;
 
-  const auto end = chronological_list.end();
-  for (auto it = chronological_list.begin();
-       it != end && it->point.GetTime() < r; ++it, ++counter)
-    acc += it->delta_distance;
+  for (unsigned i = nodes[GetHead()].next;
+       i != GetHead() && nodes[i].point.GetTime() < r;
+       i = nodes[i].next, ++counter)
+    acc += nodes[i].delta_distance;
 
   if (counter)
     return acc / counter;
@@ -284,9 +397,9 @@ Trace::CalcAverageDeltaTime(const unsigned no_thin) const
   unsigned counter = 0;
 
   /* find the last item before the "r" timestamp */
-  const auto end = chronological_list.end();
-  ChronologicalList::const_iterator it;
-  for (it = chronological_list.begin(); it != end && it->point.GetTime() < r; ++it)
+  const auto end = this->end();
+  const_iterator it;
+  for (it = begin(); it != end && it->GetTime() < r; ++it)
     ++counter;
 
   if (counter < 2)
@@ -296,7 +409,7 @@ Trace::CalcAverageDeltaTime(const unsigned no_thin) const
   --counter;
 
   unsigned start_time = front().GetTime();
-  unsigned end_time = it->point.GetTime();
+  unsigned end_time = it->GetTime();
   return (end_time - start_time) / counter;
 }
 
@@ -337,8 +450,7 @@ Trace::Thin2()
 void
 Trace::Thin()
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.size());
+  assert(cached_size == heap_size);
   assert(size() == max_size);
 
   Thin2();
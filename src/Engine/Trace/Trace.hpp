@@ -26,15 +26,13 @@ Copyright_License {
 
 #include "Point.hpp"
 #include "Util/NonCopyable.hpp"
-#include "Util/SliceAllocator.hpp"
+#include "Util/AllocatedArray.hxx"
 #include "Util/Serial.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Compiler.h"
 
-#include <boost/intrusive/list.hpp>
-#include <boost/intrusive/set.hpp>
-
 #include <algorithm>
+#include <iterator>
 
 #include <assert.h>
 #include <stdlib.h>
@@ -51,13 +49,16 @@ class TracePointerVector;
  * the candidate point removed.  In this version, time differences is also a
  * secondary factor, such that thinning attempts to remove points such that,
  * for equal distance ranking, smaller time step details are removed first.
+ *
+ * All points are stored in one array which is allocated by the
+ * constructor; the chronological order is a doubly linked list of
+ * array indices, and the thinning candidates are kept in a binary
+ * heap of array indices.  Pointers to points remain valid until the
+ * point is removed.
  */
 class Trace : private NonCopyable
 {
-  struct TraceDelta
-    : boost::intrusive::set_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>,
-      boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>> {
-
+  struct TraceDelta {
     /**
      * Function used to points for sorting by deltas.
      * Ranking is primarily by distance delta; for equal distances, rank by
@@ -90,32 +91,30 @@ class Trace : private NonCopyable
       return false;
     }
 
-    struct DeltaRankOp {
-      gcc_pure
-      bool operator()(const TraceDelta &s1, const TraceDelta &s2) const {
-        return DeltaRank(s1, s2);
-      }
-    };
-
     TracePoint point;
 
     unsigned elim_time;
     unsigned elim_distance;
     unsigned delta_distance;
 
-    explicit TraceDelta(const TracePoint &p)
-      :point(p),
-       elim_time(null_time), elim_distance(null_delta),
-       delta_distance(0) {}
-
-    TraceDelta(const TracePoint &p_last, const TracePoint &p,
-               const TracePoint &p_next)
-      :point(p),
-       elim_time(TimeMetric(p_last, p, p_next)),
-       elim_distance(DistanceMetric(p_last, p, p_next)),
-       delta_distance(p.FlatDistanceTo(p_last))
-    {
-      assert(elim_distance != null_delta);
+    /**
+     * Array indices of the chronological neighbours.  For unused
+     * items, #next links the free list.
+     */
+    unsigned prev, next;
+
+    /**
+     * The position of this item in the heap, or #NOT_IN_HEAP.
+     */
+    unsigned heap_index;
+
+    TraceDelta() = default;
+
+    void Set(const TracePoint &p) {
+      point = p;
+      elim_time = null_time;
+      elim_distance = null_delta;
+      delta_distance = 0;
     }
 
     /**
@@ -168,19 +167,26 @@ class Trace : private NonCopyable
     }
   };
 
-  /* using multiset, not because we need multiple values (we don't),
-     but to avoid set's overhead for duplicate elimination */
-  typedef boost::intrusive::multiset<TraceDelta,
-                                     boost::intrusive::compare<TraceDelta::DeltaRankOp>,
-                                     boost::intrusive::constant_time_size<false>> DeltaList;
+  static constexpr unsigned NOT_IN_HEAP = 0 - 1;
+
+  /**
+   * All items, plus one sentinel at the end which is the head of the
+   * chronological list.
+   */
+  AllocatedArray<TraceDelta> nodes;
 
-  typedef boost::intrusive::list<TraceDelta,
-                                 boost::intrusive::constant_time_size<false>> ChronologicalList;
+  /**
+   * Array indices of all items, a binary heap ordered by
+   * TraceDelta::DeltaRank(), the best thinning candidate first.
+   */
+  AllocatedArray<unsigned> heap;
+  unsigned heap_size;
 
-  SliceAllocator<TraceDelta, 128u> allocator;
+  /**
+   * The first unused item, linked by TraceDelta::next.
+   */
+  unsigned free_head;
 
-  DeltaList delta_list;
-  ChronologicalList chronological_list;
   unsigned cached_size;
 
   TaskProjection task_projection;
@@ -195,25 +201,6 @@ class Trace : private NonCopyable
 
   Serial append_serial, modify_serial;
 
-  template<typename Alloc>
-  struct Disposer {
-    Alloc &alloc;
-
-    void operator()(typename Alloc::pointer td) {
-      alloc.destroy(td);
-      alloc.deallocate(td, 1);
-    }
-  };
-
-  template<typename Alloc>
-  static Disposer<Alloc> MakeDisposer(Alloc &alloc) {
-    return {alloc};
-  }
-
-  Disposer<decltype(allocator)> MakeDisposer() {
-    return MakeDisposer(allocator);
-  }
-
 public:
   /**
    * Constructor.  Task projection is updated after first call to append().
@@ -227,10 +214,6 @@ public:
                  const unsigned max_time = null_time,
                  const unsigned max_size = 1000);
 
-  ~Trace() {
-    clear();
-  }
-
 protected:
   /**
    * Find recent time after which points should not be culled
@@ -244,25 +227,20 @@ protected:
   unsigned GetRecentTime(const unsigned t) const;
 
   /**
-   * Update delta values for specified item in the delta list and the
-   * tree.  This repositions the item after into its sorted position.
+   * Update delta values for specified item, and move it to its new
+   * position in the heap.
    *
-   * @param it Item to update
-   * @param tree Tree containing leaf
-   *
-   * @return Iterator to updated item
+   * @param i Item to update
    */
-  void UpdateDelta(TraceDelta &td);
+  void UpdateDelta(unsigned i);
 
   /**
-   * Erase a non-edge item from delta list and tree, updating
-   * deltas in the process.  This Invalidates the calling iterator.
-   *
-   * @param it Item to erase
-   * @param tree Tree to remove from
+   * Erase a non-edge item from the chronological list and the heap,
+   * updating the deltas of its neighbours in the process.
    *
+   * @param i Item to erase
    */
-  void EraseInside(DeltaList::iterator it);
+  void EraseInside(unsigned i);
 
   /**
    * Erase elements based on delta metric until the size is
@@ -273,7 +251,6 @@ protected:
    * fail to set the target size.
    *
    * @param target_size Size of desired list.
-   * @param tree Tree to remove from
    * @param recent Time window for which to not remove points
    *
    * @return True if items were erased
@@ -286,7 +263,6 @@ protected:
    * and update earliest item to become the new start
    *
    * @param p_time Time to remove
-   * @param tree Tree to remove from
    *
    * @return True if items were erased
    */
@@ -301,7 +277,7 @@ protected:
   /**
    * Update start node (and neighbour) after min time pruning
    */
-  void EraseStart(TraceDelta &td_start);
+  void EraseStart(unsigned i);
 
 public:
   /**
@@ -317,6 +293,16 @@ public:
    */
   void clear();
 
+  /**
+   * Replace the contents of this object with a copy of the other
+   * one, which must have the same #max_size.  All points are copied
+   * to the same array positions, and the serials are copied, too.
+   * Therefore, pointers obtained from this object remain valid after
+   * the next copy if the other object has only appended points in
+   * the meantime (see GetModifySerial()).
+   */
+  void CopyFrom(const Trace &other);
+
   void EraseEarlierThan(double time) {
     EraseEarlierThan((unsigned)time);
   }
@@ -400,13 +386,13 @@ public:
   const TracePoint &front() const {
     assert(!empty());
 
-    return chronological_list.front().point;
+    return nodes[GetFront()].point;
   }
 
   const TracePoint &back() const {
     assert(!empty());
 
-    return chronological_list.back().point;
+    return nodes[GetBack()].point;
   }
 
 private:
@@ -433,18 +419,61 @@ private:
    */
   void Thin();
 
-  TraceDelta &GetFront() {
+  /**
+   * The array index of the sentinel, which is the head of the
+   * chronological list.
+   */
+  unsigned GetHead() const {
+    return max_size;
+  }
+
+  unsigned GetFront() const {
     assert(!empty());
 
-    return chronological_list.front();
+    return nodes[GetHead()].next;
   }
 
-  TraceDelta &GetBack() {
+  unsigned GetBack() const {
     assert(!empty());
 
-    return chronological_list.back();
+    return nodes[GetHead()].prev;
   }
 
+  /**
+   * Take an item from the free list and append it to the
+   * chronological list.
+   */
+  unsigned AppendNode(const TracePoint &point);
+
+  /**
+   * Remove the item from the chronological list and return it to
+   * the free list.  It must have been removed from the heap already.
+   */
+  void FreeNode(unsigned i);
+
+  gcc_pure
+  bool HeapLess(unsigned a, unsigned b) const {
+    return TraceDelta::DeltaRank(nodes[heap[a]], nodes[heap[b]]);
+  }
+
+  void HeapSwap(unsigned a, unsigned b) {
+    std::swap(heap[a], heap[b]);
+    nodes[heap[a]].heap_index = a;
+    nodes[heap[b]].heap_index = b;
+  }
+
+  void HeapSiftUp(unsigned position);
+  void HeapSiftDown(unsigned position);
+
+  /**
+   * Restore the heap order after the rank of the given item has
+   * changed.
+   */
+  void HeapUpdate(unsigned position);
+
+  void HeapPush(unsigned i);
+  void HeapRemove(unsigned i);
+
   gcc_pure
   unsigned CalcAverageDeltaDistance(const unsigned no_thin) const;
 
@@ -465,15 +494,18 @@ public:
   }
 
 public:
-  class const_iterator : public ChronologicalList::const_iterator {
+  class const_iterator {
     friend class Trace;
 
-    const_iterator(ChronologicalList::const_iterator &&_iterator)
-      :ChronologicalList::const_iterator(std::move(_iterator)) {}
+    const TraceDelta *nodes;
+    unsigned index;
+
+    const_iterator(const TraceDelta *_nodes, unsigned _index)
+      :nodes(_nodes), index(_index) {}
 
   public:
-    using ChronologicalList::const_iterator::iterator_category;
-    using ChronologicalList::const_iterator::difference_type;
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef ptrdiff_t difference_type;
     typedef const TracePoint value_type;
     typedef const TracePoint *pointer;
     typedef const TracePoint &reference;
@@ -481,13 +513,41 @@ public:
     const_iterator() = default;
 
     const TracePoint &operator*() const {
-      const TraceDelta &td = ChronologicalList::const_iterator::operator*();
-      return td.point;
+      return nodes[index].point;
     }
 
     const TracePoint *operator->() const {
-      const TraceDelta &td = ChronologicalList::const_iterator::operator*();
-      return &td.point;
+      return &nodes[index].point;
+    }
+
+    const_iterator &operator++() {
+      index = nodes[index].next;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    const_iterator &operator--() {
+      index = nodes[index].prev;
+      return *this;
+    }
+
+    const_iterator operator--(int) {
+      const_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return index == other.index;
+    }
+
+    bool operator!=(const const_iterator &other) const {
+      return index != other.index;
     }
 
     const_iterator &NextSquareRange(unsigned sq_resolution,
@@ -499,19 +559,18 @@ public:
         if (*this == end)
           return *this;
 
-        const TraceDelta &td = (const TraceDelta &)**this;
-        if (td.point.FlatSquareDistanceTo(previous) >= sq_resolution)
+        if ((*this)->FlatSquareDistanceTo(previous) >= sq_resolution)
           return *this;
       }
     }
   };
 
   const_iterator begin() const {
-    return chronological_list.begin();
+    return const_iterator(nodes.begin(), nodes[GetHead()].next);
   }
 
   const_iterator end() const {
-    return chronological_list.end();
+    return const_iterator(nodes.begin(), GetHead());
   }
 
   const TaskProjection &GetProjection() const {
@@ -120,6 +120,10 @@ struct Waypoint {
 
   /** Name of waypoint */
   tstring name;
+  /* TODO: the comment and the details are parsed and copied for
+     every waypoint, even though most are never displayed; loading
+     large files would be faster if they were stored lazily */
+
   /** Additional comment text for waypoint */
   tstring comment;
   /** Airfield or additional (long) details */
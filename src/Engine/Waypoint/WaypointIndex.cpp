@@ -0,0 +1,184 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointIndex.hpp"
+#include "Waypoint.hpp"
+
+#include <assert.h>
+
+/**
+ * Calculate the position of the given point on a Hilbert curve
+ * filling a 65536x65536 grid.
+ */
+gcc_const
+static uint32_t
+HilbertIndex(unsigned x, unsigned y)
+{
+  uint32_t d = 0;
+  for (unsigned s = 1u << 15; s > 0; s >>= 1) {
+    const unsigned rx = (x & s) != 0;
+    const unsigned ry = (y & s) != 0;
+    d += s * s * ((3 * rx) ^ ry);
+
+    /* rotate the quadrant */
+    if (ry == 0) {
+      if (rx == 1) {
+        x = 0xffff - x;
+        y = 0xffff - y;
+      }
+
+      std::swap(x, y);
+    }
+  }
+
+  return d;
+}
+
+/**
+ * Scale a coordinate to the range 0..65535.
+ */
+gcc_const
+static unsigned
+ScaleToGrid(int value, int min, int max)
+{
+  if (max <= min)
+    return 0;
+
+  return unsigned(((int64_t)value - min) * 0xffff / ((int64_t)max - min));
+}
+
+void
+WaypointIndex::Build(std::vector<const WaypointPtr *> &&v)
+{
+  assert(!IsDefined());
+
+  if (v.empty())
+    return;
+
+  /* sort the points along a Hilbert curve, so neighbouring points
+     end up in the same node */
+
+  int min_x = (*v.front())->flat_location.x, max_x = min_x;
+  int min_y = (*v.front())->flat_location.y, max_y = min_y;
+  for (const WaypointPtr *i : v) {
+    const FlatGeoPoint &p = (*i)->flat_location;
+    min_x = std::min(min_x, p.x);
+    max_x = std::max(max_x, p.x);
+    min_y = std::min(min_y, p.y);
+    max_y = std::max(max_y, p.y);
+  }
+
+  std::vector<std::pair<uint32_t, const WaypointPtr *>> sorted;
+  sorted.reserve(v.size());
+  for (const WaypointPtr *i : v) {
+    const FlatGeoPoint &p = (*i)->flat_location;
+    sorted.emplace_back(HilbertIndex(ScaleToGrid(p.x, min_x, max_x),
+                                     ScaleToGrid(p.y, min_y, max_y)),
+                        i);
+  }
+
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const std::pair<uint32_t, const WaypointPtr *> &a,
+                      const std::pair<uint32_t, const WaypointPtr *> &b){
+                     return a.first < b.first;
+                   });
+
+  x.reserve(sorted.size());
+  y.reserve(sorted.size());
+  items.reserve(sorted.size());
+  for (const auto &i : sorted) {
+    const FlatGeoPoint &p = (*i.second)->flat_location;
+    x.push_back(p.x);
+    y.push_back(p.y);
+    items.push_back(i.second);
+  }
+
+  /* build the node levels bottom-up */
+
+  Level level;
+  for (unsigned begin = 0; begin < items.size(); begin += FANOUT) {
+    const unsigned end = std::min<unsigned>(begin + FANOUT, items.size());
+    int left = x[begin], right = left, top = y[begin], bottom = top;
+    for (unsigned i = begin + 1; i < end; ++i) {
+      left = std::min(left, x[i]);
+      right = std::max(right, x[i]);
+      top = std::min(top, y[i]);
+      bottom = std::max(bottom, y[i]);
+    }
+
+    level.left.push_back(left);
+    level.top.push_back(top);
+    level.right.push_back(right);
+    level.bottom.push_back(bottom);
+  }
+
+  levels.push_back(std::move(level));
+
+  while (levels.back().size() > 1) {
+    const Level &children = levels.back();
+    Level parent;
+
+    for (unsigned begin = 0; begin < children.size(); begin += FANOUT) {
+      const unsigned end = std::min(begin + FANOUT, children.size());
+      int left = children.left[begin], right = children.right[begin];
+      int top = children.top[begin], bottom = children.bottom[begin];
+      for (unsigned i = begin + 1; i < end; ++i) {
+        left = std::min(left, children.left[i]);
+        right = std::max(right, children.right[i]);
+        top = std::min(top, children.top[i]);
+        bottom = std::max(bottom, children.bottom[i]);
+      }
+
+      parent.left.push_back(left);
+      parent.top.push_back(top);
+      parent.right.push_back(right);
+      parent.bottom.push_back(bottom);
+    }
+
+    levels.push_back(std::move(parent));
+  }
+}
+
+std::pair<uint64_t, unsigned> *
+WaypointIndex::FillOrder(const Level &children, unsigned begin, unsigned end,
+                         FlatGeoPoint location,
+                         std::pair<uint64_t, unsigned> *order)
+{
+  assert(end - begin <= FANOUT);
+
+  /* insertion sort; there are at most FANOUT items */
+  std::pair<uint64_t, unsigned> *order_end = order;
+  for (unsigned i = begin; i != end; ++i) {
+    const std::pair<uint64_t, unsigned> item(children.SquareDistanceTo(i, location), i);
+
+    auto *p = order_end++;
+    while (p != order && p[-1].first > item.first) {
+      *p = p[-1];
+      --p;
+    }
+
+    *p = item;
+  }
+
+  return order_end;
+}
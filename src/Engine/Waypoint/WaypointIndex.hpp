@@ -0,0 +1,249 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_INDEX_HPP
+#define XCSOAR_WAYPOINT_INDEX_HPP
+
+#include "Ptr.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Compiler.h"
+
+#include <vector>
+#include <algorithm>
+
+#include <stdint.h>
+
+/**
+ * A read-only spatial index of the waypoints in #Waypoints, built by
+ * Waypoints::Optimise().  It is a packed R-tree: the flat coordinates
+ * are stored in separate contiguous arrays, sorted along a Hilbert
+ * curve, and grouped into nodes of #FANOUT items with a bounding box
+ * each (also in separate arrays).  Queries only read these arrays;
+ * the #Waypoint objects are dereferenced only when a predicate needs
+ * to be checked for a candidate.
+ *
+ * The index stores pointers to the #WaypointPtr instances inside the
+ * container, and must be cleared whenever the container is modified.
+ */
+class WaypointIndex {
+  static constexpr unsigned FANOUT = 16;
+
+  /**
+   * The bounding boxes of the nodes of one tree level.
+   */
+  struct Level {
+    std::vector<int> left, top, right, bottom;
+
+    unsigned size() const {
+      return left.size();
+    }
+
+    /**
+     * Calculate the minimum square distance of the given node to the
+     * specified point.  Returns 0 when the point is inside.
+     */
+    gcc_pure
+    uint64_t SquareDistanceTo(unsigned i, FlatGeoPoint p) const {
+      const int64_t dx = p.x < left[i]
+        ? (int64_t)left[i] - p.x
+        : (p.x > right[i] ? (int64_t)p.x - right[i] : 0);
+      const int64_t dy = p.y < top[i]
+        ? (int64_t)top[i] - p.y
+        : (p.y > bottom[i] ? (int64_t)p.y - bottom[i] : 0);
+      return dx * dx + dy * dy;
+    }
+  };
+
+  /* the points in Hilbert order */
+  std::vector<int> x, y;
+  std::vector<const WaypointPtr *> items;
+
+  /**
+   * The node levels, bottom-up: the nodes of levels[0] group
+   * #FANOUT points, the nodes of levels[1] group #FANOUT nodes of
+   * levels[0] etc.  The last level has only one node.
+   */
+  std::vector<Level> levels;
+
+public:
+  bool IsDefined() const {
+    return !items.empty();
+  }
+
+  void Clear() {
+    x.clear();
+    y.clear();
+    items.clear();
+    levels.clear();
+  }
+
+  /**
+   * Build the index from the given range of #WaypointPtr references.
+   * The referenced objects must remain valid until Clear() is
+   * called.
+   */
+  template<typename I>
+  void Build(I begin, I end) {
+    Clear();
+
+    std::vector<const WaypointPtr *> v;
+    for (I i = begin; i != end; ++i)
+      v.push_back(&*i);
+
+    Build(std::move(v));
+  }
+
+  /**
+   * Find the nearest waypoint within the given range which matches
+   * the predicate.
+   *
+   * @param range the range in flat units
+   * @return the #WaypointPtr or nullptr if there is none
+   */
+  template<typename P>
+  gcc_pure
+  const WaypointPtr *FindNearestIf(FlatGeoPoint location, unsigned range,
+                                   const P &predicate) const {
+    Nearest<P> nearest(location, (uint64_t)range * range, predicate);
+    if (IsDefined())
+      FindNearestIf(levels.size(), 0, nearest);
+    return nearest.result;
+  }
+
+  /**
+   * Invoke the visitor with each #WaypointPtr within the given
+   * range.
+   *
+   * @param range the range in flat units
+   */
+  template<typename V>
+  void VisitWithinRange(FlatGeoPoint location, unsigned range,
+                        V &&visitor) const {
+    if (IsDefined())
+      VisitWithinRange(levels.size(), 0, location,
+                       (uint64_t)range * range, visitor);
+  }
+
+private:
+  void Build(std::vector<const WaypointPtr *> &&v);
+
+  gcc_pure
+  uint64_t SquareDistanceTo(unsigned i, FlatGeoPoint p) const {
+    const int64_t dx = (int64_t)x[i] - p.x, dy = (int64_t)y[i] - p.y;
+    return dx * dx + dy * dy;
+  }
+
+  /**
+   * Returns the range of children of the given node.  Level 0
+   * children are points; #levels.size() denotes a virtual root
+   * node which contains all nodes of the top level.
+   */
+  void GetChildren(unsigned level, unsigned node,
+                   unsigned &begin, unsigned &end) const {
+    const unsigned n_children = level == 0
+      ? items.size()
+      : levels[level - 1].size();
+
+    if (level == levels.size()) {
+      begin = 0;
+      end = n_children;
+    } else {
+      begin = node * FANOUT;
+      end = std::min(begin + FANOUT, n_children);
+    }
+  }
+
+  template<typename P>
+  struct Nearest {
+    const FlatGeoPoint location;
+    uint64_t square_distance;
+    const P &predicate;
+    const WaypointPtr *result;
+
+    Nearest(FlatGeoPoint _location, uint64_t square_range,
+            const P &_predicate)
+      :location(_location), square_distance(square_range),
+       predicate(_predicate), result(nullptr) {}
+  };
+
+  template<typename P>
+  void FindNearestIf(unsigned level, unsigned node,
+                     Nearest<P> &nearest) const {
+    unsigned begin, end;
+    GetChildren(level, node, begin, end);
+
+    if (level == 0) {
+      for (unsigned i = begin; i != end; ++i) {
+        const uint64_t d = SquareDistanceTo(i, nearest.location);
+        if ((d < nearest.square_distance ||
+             (d == nearest.square_distance && nearest.result == nullptr)) &&
+            nearest.predicate(**items[i])) {
+          nearest.square_distance = d;
+          nearest.result = items[i];
+        }
+      }
+
+      return;
+    }
+
+    /* visit the children sorted by their distance, to shrink the
+       search radius as quickly as possible */
+    const Level &children = levels[level - 1];
+    std::pair<uint64_t, unsigned> order[FANOUT];
+    std::pair<uint64_t, unsigned> *const order_end =
+      FillOrder(children, begin, end, nearest.location, order);
+
+    for (auto *i = order; i != order_end; ++i) {
+      if (i->first > nearest.square_distance)
+        break;
+
+      FindNearestIf(level - 1, i->second, nearest);
+    }
+  }
+
+  template<typename V>
+  void VisitWithinRange(unsigned level, unsigned node,
+                        FlatGeoPoint location, uint64_t square_range,
+                        V &visitor) const {
+    unsigned begin, end;
+    GetChildren(level, node, begin, end);
+
+    if (level == 0) {
+      for (unsigned i = begin; i != end; ++i)
+        if (SquareDistanceTo(i, location) <= square_range)
+          visitor(*items[i]);
+      return;
+    }
+
+    const Level &children = levels[level - 1];
+    for (unsigned i = begin; i != end; ++i)
+      if (children.SquareDistanceTo(i, location) <= square_range)
+        VisitWithinRange(level - 1, i, location, square_range, visitor);
+  }
+
+  static std::pair<uint64_t, unsigned> *
+  FillOrder(const Level &children, unsigned begin, unsigned end,
+            FlatGeoPoint location, std::pair<uint64_t, unsigned> *order);
+};
+
+#endif
@@ -0,0 +1,463 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointNameIndex.hpp"
+#include "Waypoint.hpp"
+#include "Util/CharUtil.hxx"
+#include "Util/StringAPI.hxx"
+#include "Util/StringCompare.hxx"
+#include "Util/StringUtil.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <assert.h>
+#include <stdint.h>
+
+/**
+ * The base letters of the code points U+00C0 to U+017F (Latin-1
+ * Supplement and Latin Extended-A); '_' means the character is
+ * dropped.
+ */
+static constexpr char latin_fold[] =
+  "AAAAAAACEEEEIIIIDNOOOOO_OUUUUY_S"
+  "AAAAAAACEEEEIIIIDNOOOOO_OUUUUY_Y"
+  "AAAAAACCCCCCCCDDDDEEEEEEEEEEGGGGGGGGHHHHIIIIIIIIIIIIJJKKK"
+  "LLLLLLLLLLNNNNNNNNNOOOOOOOORRRRRRSSSSSSSSTTTTTTUUUUUUUUUUUU"
+  "WWYYYZZZZZZS";
+
+static_assert(sizeof(latin_fold) == 0x180 - 0xc0 + 1,
+              "Wrong latin_fold size");
+
+/**
+ * Convert a code point to a normalised character, or return 0 if it
+ * is to be dropped.
+ */
+gcc_const
+static TCHAR
+FoldCharacter(unsigned ch)
+{
+  if (ch < 0x80)
+    return IsAlphaNumericASCII(char(ch))
+      ? ToUpperASCII(char(ch))
+      : 0;
+
+  if (ch >= 0xc0 && ch < 0x180 && latin_fold[ch - 0xc0] != '_')
+    return latin_fold[ch - 0xc0];
+
+  return 0;
+}
+
+/**
+ * Returns the position of a normalised character in the alphabet.
+ */
+gcc_const
+static unsigned
+CharacterCode(TCHAR ch)
+{
+  return ch <= _T('9') ? ch - _T('0') : ch - _T('A') + 10;
+}
+
+gcc_const
+static TCHAR
+CodeCharacter(unsigned code)
+{
+  return code < 10 ? _T('0') + code : _T('A') + code - 10;
+}
+
+/**
+ * Compare the beginning of a name with the query.
+ */
+gcc_pure
+static int
+ComparePrefix(const TCHAR *key, const TCHAR *query, size_t length)
+{
+  for (; length > 0; --length, ++key, ++query)
+    if (*key != *query)
+      return *key < *query ? -1 : 1;
+
+  return 0;
+}
+
+gcc_pure
+static uint64_t
+CharacterMask(const TCHAR *key)
+{
+  uint64_t mask = 0;
+  for (; *key != 0; ++key)
+    mask |= uint64_t(1) << CharacterCode(*key);
+  return mask;
+}
+
+/**
+ * Invoke the function with each trigram of a normalised name.
+ */
+template<typename F>
+static void
+ForEachTrigram(const TCHAR *key, unsigned alphabet, F &&f)
+{
+  for (; key[0] != 0 && key[1] != 0 && key[2] != 0; ++key)
+    f((CharacterCode(key[0]) * alphabet +
+       CharacterCode(key[1])) * alphabet +
+      CharacterCode(key[2]));
+}
+
+/**
+ * Collect the distinct trigrams of a normalised name.
+ */
+static void
+CollectTrigrams(const TCHAR *key, unsigned alphabet,
+                std::vector<unsigned> &dest)
+{
+  dest.clear();
+  ForEachTrigram(key, alphabet, [&dest](unsigned g){
+      dest.push_back(g);
+    });
+
+  std::sort(dest.begin(), dest.end());
+  dest.erase(std::unique(dest.begin(), dest.end()), dest.end());
+}
+
+TCHAR *
+WaypointNameIndex::Normalize(TCHAR *dest, const TCHAR *src)
+{
+  TCHAR *retval = dest;
+
+  while (*src != 0) {
+#ifdef _UNICODE
+    unsigned ch = *src++;
+#else
+    unsigned ch = (unsigned char)*src++;
+    if ((ch & 0xe0) == 0xc0 && (*src & 0xc0) == 0x80)
+      /* decode a two-byte UTF-8 sequence */
+      ch = ((ch & 0x1f) << 6) | (*src++ & 0x3f);
+#endif
+
+    const TCHAR folded = FoldCharacter(ch);
+    if (folded != 0)
+      *dest++ = folded;
+  }
+
+  *dest = _T('\0');
+  return retval;
+}
+
+/**
+ * The last generation number which was assigned to a
+ * #WaypointNameIndex; shared by all instances, so a #Search object
+ * can't match an index it was not used with.
+ */
+static std::atomic<unsigned> last_generation(0);
+
+unsigned
+WaypointNameIndex::NewGeneration()
+{
+  return ++last_generation;
+}
+
+void
+WaypointNameIndex::Clear()
+{
+  keys.clear();
+  key_offsets.clear();
+  items.clear();
+  character_masks.clear();
+  gram_offsets.clear();
+  postings.clear();
+  characters[0] = _T('\0');
+  generation = NewGeneration();
+}
+
+void
+WaypointNameIndex::Build(std::vector<const WaypointPtr *> &&v)
+{
+  assert(!IsDefined());
+
+  if (v.empty())
+    return;
+
+  /* normalise all names */
+
+  size_t total_length = 0;
+  for (const WaypointPtr *i : v)
+    total_length += (*i)->name.length() + 1;
+
+  std::vector<TCHAR> tmp(total_length);
+  std::vector<std::pair<const TCHAR *, unsigned>> sorted;
+  sorted.reserve(v.size());
+
+  TCHAR *p = tmp.data();
+  for (unsigned i = 0; i < v.size(); ++i) {
+    sorted.emplace_back(p, i);
+    Normalize(p, (*v[i])->name.c_str());
+    p += StringLength(p) + 1;
+  }
+
+  /* sort them alphabetically */
+
+  std::sort(sorted.begin(), sorted.end(),
+            [&v](const std::pair<const TCHAR *, unsigned> &a,
+                 const std::pair<const TCHAR *, unsigned> &b){
+              const int cmp = _tcscmp(a.first, b.first);
+              return cmp < 0 ||
+                (cmp == 0 && (*v[a.second])->id < (*v[b.second])->id);
+            });
+
+  keys.reserve(p - tmp.data());
+  key_offsets.reserve(v.size() + 1);
+  items.reserve(v.size());
+  character_masks.reserve(v.size());
+
+  for (const auto &i : sorted) {
+    const TCHAR *key = i.first;
+    key_offsets.push_back(keys.size());
+    keys.insert(keys.end(), key, key + StringLength(key) + 1);
+    items.push_back(v[i.second]);
+    character_masks.push_back(CharacterMask(key));
+  }
+
+  key_offsets.push_back(keys.size());
+
+  /* build the trigram postings: count first, then fill; #last
+     remembers the last name which was counted for each trigram, to
+     skip duplicates within a name */
+
+  gram_offsets.assign(N_TRIGRAMS + 1, 0);
+  std::vector<unsigned> last(N_TRIGRAMS, unsigned(-1));
+  uint64_t present = 0;
+
+  for (unsigned i = 0; i < items.size(); ++i) {
+    ForEachTrigram(GetKey(i), ALPHABET, [i, &last, this](unsigned g){
+        if (last[g] != i) {
+          last[g] = i;
+          ++gram_offsets[g + 1];
+        }
+      });
+
+    present |= character_masks[i];
+  }
+
+  for (unsigned g = 1; g <= N_TRIGRAMS; ++g)
+    gram_offsets[g] += gram_offsets[g - 1];
+
+  postings.resize(gram_offsets.back());
+
+  std::fill(last.begin(), last.end(), unsigned(-1));
+  std::vector<unsigned> fill(gram_offsets.begin(), gram_offsets.end() - 1);
+  for (unsigned i = 0; i < items.size(); ++i) {
+    ForEachTrigram(GetKey(i), ALPHABET, [i, &last, &fill, this](unsigned g){
+        if (last[g] != i) {
+          last[g] = i;
+          postings[fill[g]++] = i;
+        }
+      });
+  }
+
+  TCHAR *c = characters;
+  for (unsigned code = 0; code < ALPHABET; ++code)
+    if (present & (uint64_t(1) << code))
+      *c++ = CodeCharacter(code);
+  *c = _T('\0');
+}
+
+bool
+WaypointNameIndex::IsRefinement(const Search &search,
+                                const TCHAR *query) const
+{
+  return search.generation == generation &&
+    StringStartsWith(query, search.query.c_str());
+}
+
+std::pair<unsigned, unsigned>
+WaypointNameIndex::FindPrefixRange(const TCHAR *query, size_t length) const
+{
+  unsigned begin = 0, end = items.size();
+
+  /* binary search for the first name which is not smaller */
+  for (unsigned n = end; n > 0;) {
+    const unsigned half = n / 2;
+    if (ComparePrefix(GetKey(begin + half), query, length) < 0) {
+      begin += half + 1;
+      n -= half + 1;
+    } else
+      n = half;
+  }
+
+  /* binary search for the first name which is larger */
+  unsigned last = begin;
+  for (unsigned n = end - begin; n > 0;) {
+    const unsigned half = n / 2;
+    if (ComparePrefix(GetKey(last + half), query, length) <= 0) {
+      last += half + 1;
+      n -= half + 1;
+    } else
+      n = half;
+  }
+
+  return std::make_pair(begin, last);
+}
+
+template<typename F>
+void
+WaypointNameIndex::ScanMatches(const TCHAR *query, size_t length,
+                               F &&f) const
+{
+  if (length >= 3) {
+    /* check only the names containing the rarest trigram of the
+       query */
+    std::vector<unsigned> grams;
+    CollectTrigrams(query, ALPHABET, grams);
+
+    unsigned best = grams.front();
+    for (unsigned g : grams)
+      if (gram_offsets[g + 1] - gram_offsets[g] <
+          gram_offsets[best + 1] - gram_offsets[best])
+        best = g;
+
+    for (unsigned p = gram_offsets[best]; p < gram_offsets[best + 1]; ++p)
+      if ((length == 3 || StringFind(GetKey(postings[p]), query) != nullptr) &&
+          !f(postings[p]))
+        break;
+  } else {
+    const uint64_t mask = CharacterMask(query);
+    for (unsigned i = 0; i < items.size(); ++i)
+      if ((character_masks[i] & mask) == mask &&
+          (length < 2 || StringFind(GetKey(i), query) != nullptr) &&
+          !f(i))
+        break;
+  }
+}
+
+void
+WaypointNameIndex::Update(Search &search, const TCHAR *query) const
+{
+  const size_t length = StringLength(query);
+  auto &candidates = search.candidates;
+
+  if (IsRefinement(search, query)) {
+    if (length == search.query.length())
+      /* same query as before */
+      return;
+
+    /* characters were appended: only the previous candidates can
+       match */
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [this, query](unsigned i){
+                                      return StringFind(GetKey(i),
+                                                        query) == nullptr;
+                                    }),
+                     candidates.end());
+  } else {
+    candidates.clear();
+    ScanMatches(query, length, [&candidates](unsigned i){
+        candidates.push_back(i);
+        return true;
+      });
+  }
+
+  search.generation = generation;
+  search.query = query;
+}
+
+void
+WaypointNameIndex::FindMatches(const TCHAR *query, Search &search,
+                               unsigned max_results,
+                               std::vector<const WaypointPtr *> &dest) const
+{
+  if (!IsDefined() || max_results == 0)
+    return;
+
+  TCHAR normalized[StringLength(query) + 1];
+  Normalize(normalized, query);
+  const size_t length = StringLength(normalized);
+
+  /* the names beginning with the query come first; the exact match
+     (if any) is the first of them */
+  const auto prefix = FindPrefixRange(normalized, length);
+  unsigned remaining = max_results;
+  for (unsigned i = prefix.first; i < prefix.second && remaining > 0;
+       ++i, --remaining)
+    dest.push_back(items[i]);
+
+  if (remaining == 0)
+    return;
+
+  /* followed by the other names containing the query */
+  const auto f = [this, prefix, &remaining, &dest](unsigned i){
+    if (i < prefix.first || i >= prefix.second) {
+      dest.push_back(items[i]);
+      --remaining;
+    }
+
+    return remaining > 0;
+  };
+
+  if (IsRefinement(search, normalized) || remaining >= items.size()) {
+    /* all matches are needed, or can be obtained cheaply by refining
+       the previous search */
+    Update(search, normalized);
+    for (unsigned i : search.candidates)
+      if (!f(i))
+        break;
+  } else
+    /* stop looking once enough matches have been found */
+    ScanMatches(normalized, length, f);
+}
+
+TCHAR *
+WaypointNameIndex::Suggest(const TCHAR *query, Search &search,
+                           TCHAR *dest, size_t max_length) const
+{
+  assert(max_length > 0);
+
+  if (!IsDefined())
+    return nullptr;
+
+  TCHAR normalized[StringLength(query) + 1];
+  Normalize(normalized, query);
+
+  const unsigned length = StringLength(normalized);
+  if (length == 0) {
+    CopyString(dest, characters, max_length);
+    return dest;
+  }
+
+  Update(search, normalized);
+  if (search.candidates.empty())
+    return nullptr;
+
+  bool found[ALPHABET] = {};
+  for (unsigned i : search.candidates)
+    for (const TCHAR *p = GetKey(i);
+         (p = StringFind(p, normalized)) != nullptr; ++p)
+      if (p[length] != 0)
+        found[CharacterCode(p[length])] = true;
+
+  TCHAR *p = dest, *const end = dest + max_length - 1;
+  for (unsigned code = 0; code < ALPHABET && p < end; ++code)
+    if (found[code])
+      *p++ = CodeCharacter(code);
+  *p = _T('\0');
+
+  return dest;
+}
@@ -0,0 +1,217 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_NAME_INDEX_HPP
+#define XCSOAR_WAYPOINT_NAME_INDEX_HPP
+
+#include "Ptr.hpp"
+#include "Util/tstring.hpp"
+#include "Compiler.h"
+
+#include <utility>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tchar.h>
+
+/**
+ * A read-only index for searching waypoints by a part of their name,
+ * built by Waypoints::Optimise().
+ *
+ * Names are normalised like NormalizeSearchString(), but accented
+ * Latin letters are folded to their base letter instead of being
+ * dropped.  The normalised names are stored in one contiguous
+ * buffer, sorted alphabetically, and each trigram maps to the sorted
+ * list of names containing it.
+ *
+ * The index stores pointers to the #WaypointPtr instances inside the
+ * container, and must be cleared whenever the container is modified.
+ */
+class WaypointNameIndex {
+  /**
+   * The number of distinct characters in a normalised name: digits
+   * and upper case letters.
+   */
+  static constexpr unsigned ALPHABET = 10 + 26;
+
+  static constexpr unsigned N_TRIGRAMS = ALPHABET * ALPHABET * ALPHABET;
+
+  /**
+   * The normalised names, sorted, each terminated by a null
+   * character.
+   */
+  std::vector<TCHAR> keys;
+
+  /**
+   * The position of each name in #keys, plus the end of the buffer.
+   */
+  std::vector<unsigned> key_offsets;
+
+  /**
+   * The waypoints in the order of #key_offsets.
+   */
+  std::vector<const WaypointPtr *> items;
+
+  /**
+   * The set of characters in each name (bit n is set for code n);
+   * allows rejecting most names without looking at them.
+   */
+  std::vector<uint64_t> character_masks;
+
+  /**
+   * The names containing trigram t are listed (in ascending order)
+   * in #postings[#gram_offsets[t]..#gram_offsets[t+1]].
+   */
+  std::vector<unsigned> gram_offsets, postings;
+
+  /**
+   * All characters which occur in the names, for Suggest() with an
+   * empty query.
+   */
+  TCHAR characters[ALPHABET + 1];
+
+  /**
+   * Assigned from a global counter by the constructor, Build() and
+   * Clear(), to invalidate #Search objects which were used with
+   * another index or with a previous state of this one.
+   */
+  unsigned generation = NewGeneration();
+
+public:
+  /**
+   * Remembers the result of the previous query, so appending
+   * characters to it (while the user types) only needs to check the
+   * previous candidates.
+   */
+  class Search {
+    friend class WaypointNameIndex;
+
+    unsigned generation = 0;
+    tstring query;
+
+    /**
+     * The names containing #query, in ascending order.
+     */
+    std::vector<unsigned> candidates;
+  };
+
+  WaypointNameIndex() {
+    characters[0] = _T('\0');
+  }
+
+  bool IsDefined() const {
+    return !items.empty();
+  }
+
+  void Clear();
+
+  /**
+   * Build the index from the given range of #WaypointPtr references.
+   * The referenced objects must remain valid until Clear() is
+   * called.
+   */
+  template<typename I>
+  void Build(I begin, I end) {
+    Clear();
+
+    std::vector<const WaypointPtr *> v;
+    for (I i = begin; i != end; ++i)
+      v.push_back(&*i);
+
+    Build(std::move(v));
+  }
+
+  /**
+   * Find the waypoints whose normalised name contains the normalised
+   * query, best matches first: an exact match, then the names
+   * starting with the query, then the rest, alphabetically within
+   * each group.
+   *
+   * If only a few results are requested, this stops looking after
+   * the best ones have been found.
+   *
+   * @param search the state of the previous query; it is used if the
+   * query has been extended since, and updated if all matches had to
+   * be determined
+   * @param max_results the maximum number of results
+   * @param dest the results are appended to this vector
+   */
+  void FindMatches(const TCHAR *query, Search &search, unsigned max_results,
+                   std::vector<const WaypointPtr *> &dest) const;
+
+  /**
+   * Returns the set of characters which may follow the specified
+   * query, i.e. which are found after it in at least one name.
+   *
+   * @param search the state of the previous query, which is updated
+   */
+  TCHAR *Suggest(const TCHAR *query, Search &search,
+                 TCHAR *dest, size_t max_length) const;
+
+  /**
+   * Normalise a string for this index.  The destination buffer must
+   * be as large as the source string.
+   */
+  static TCHAR *Normalize(TCHAR *dest, const TCHAR *src);
+
+private:
+  static unsigned NewGeneration();
+
+  void Build(std::vector<const WaypointPtr *> &&v);
+
+  gcc_pure
+  const TCHAR *GetKey(unsigned i) const {
+    return &keys[key_offsets[i]];
+  }
+
+  /**
+   * Can the given #Search object be reused for the specified query,
+   * because it is a continuation of the previous one?
+   */
+  gcc_pure
+  bool IsRefinement(const Search &search, const TCHAR *query) const;
+
+  /**
+   * Determine the names beginning with the given normalised query.
+   * Since the names are sorted, they form a contiguous range.
+   */
+  gcc_pure
+  std::pair<unsigned, unsigned> FindPrefixRange(const TCHAR *query,
+                                                size_t length) const;
+
+  /**
+   * Invoke the function with each name (in ascending order) which
+   * contains the given normalised query, until it returns false.
+   */
+  template<typename F>
+  void ScanMatches(const TCHAR *query, size_t length, F &&f) const;
+
+  /**
+   * Determine the names containing the given normalised query, and
+   * store them in the #Search object.
+   */
+  void Update(Search &search, const TCHAR *query) const;
+};
+
+#endif
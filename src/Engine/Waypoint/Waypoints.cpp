@@ -125,19 +125,28 @@ Waypoints::Waypoints()
 void
 Waypoints::Optimise()
 {
-  if (waypoint_tree.IsEmpty() || waypoint_tree.HaveBounds())
-    /* empty or already optimised */
+  if (waypoint_tree.IsEmpty())
     return;
 
-  task_projection.Update();
+  if (!waypoint_tree.HaveBounds()) {
+    task_projection.Update();
 
-  for (auto &i : waypoint_tree) {
-    // TODO: eliminate this const_cast hack
-    Waypoint &w = const_cast<Waypoint &>(*i);
-    w.Project(task_projection);
+    for (auto &i : waypoint_tree) {
+      // TODO: eliminate this const_cast hack
+      Waypoint &w = const_cast<Waypoint &>(*i);
+      w.Project(task_projection);
+    }
+
+    waypoint_tree.Optimise();
+    index.Clear();
+    name_index.Clear();
   }
 
-  waypoint_tree.Optimise();
+  if (!index.IsDefined())
+    index.Build(waypoint_tree.begin(), waypoint_tree.end());
+
+  if (!name_index.IsDefined())
+    name_index.Build(waypoint_tree.begin(), waypoint_tree.end());
 }
 
 void
@@ -158,6 +167,8 @@ Waypoints::Append(WaypointPtr wp)
   task_projection.Scan(w.location);
   w.id = next_id++;
 
+  index.Clear();
+  name_index.Clear();
   waypoint_tree.Add(wp);
   name_tree.Add(wp);
 
@@ -171,8 +182,16 @@ Waypoints::GetNearest(const GeoPoint &loc, double range) const
     return nullptr;
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  if (index.IsDefined()) {
+    const WaypointPtr *found =
+      index.FindNearestIf(flat_location, mrange,
+                          [](const Waypoint &){ return true; });
+    return found != nullptr ? *found : nullptr;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const auto found = waypoint_tree.FindNearest(point, mrange);
 
   if (found.first == waypoint_tree.end())
@@ -201,8 +220,15 @@ Waypoints::GetNearestIf(const GeoPoint &loc, double range,
     return nullptr;
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  if (index.IsDefined()) {
+    const WaypointPtr *found =
+      index.FindNearestIf(flat_location, mrange, predicate);
+    return found != nullptr ? *found : nullptr;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const auto found = waypoint_tree.FindNearestIf(point, mrange,
                                                  [predicate](const WaypointPtr &ptr){
                                                    return predicate(*ptr);
@@ -278,11 +304,16 @@ Waypoints::VisitWithinRange(const GeoPoint &loc, const double range,
     return; // nothing to do
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
 
   WaypointEnvelopeVisitor wve(&visitor);
 
+  if (index.IsDefined()) {
+    index.VisitWithinRange(flat_location, mrange, wve);
+    return;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
   waypoint_tree.VisitWithinRange(point, mrange, wve);
 }
 
@@ -293,12 +324,59 @@ Waypoints::VisitNamePrefix(const TCHAR *prefix,
   name_tree.VisitNormalisedPrefix(prefix, visitor);
 }
 
+void
+Waypoints::VisitNameMatches(const TCHAR *query, WaypointVisitor &visitor,
+                            WaypointNameIndex::Search &search) const
+{
+  if (!name_index.IsDefined()) {
+    VisitNamePrefix(query, visitor);
+    return;
+  }
+
+  std::vector<const WaypointPtr *> matches;
+  name_index.FindMatches(query, search, size(), matches);
+
+  for (const WaypointPtr *i : matches)
+    visitor.Visit(*i);
+}
+
+std::vector<WaypointPtr>
+Waypoints::FindNameMatches(const TCHAR *query, unsigned max_results,
+                           WaypointNameIndex::Search &search) const
+{
+  std::vector<WaypointPtr> result;
+
+  if (name_index.IsDefined()) {
+    std::vector<const WaypointPtr *> matches;
+    name_index.FindMatches(query, search, max_results, matches);
+
+    result.reserve(matches.size());
+    for (const WaypointPtr *i : matches)
+      result.push_back(*i);
+  }
+
+  return result;
+}
+
+TCHAR *
+Waypoints::SuggestNameCharacters(const TCHAR *query, TCHAR *dest,
+                                 size_t max_length,
+                                 WaypointNameIndex::Search &search) const
+{
+  if (!name_index.IsDefined())
+    return SuggestNamePrefix(query, dest, max_length);
+
+  return name_index.Suggest(query, search, dest, max_length);
+}
+
 void
 Waypoints::Clear()
 {
   ++serial;
   home = nullptr;
   name_tree.Clear();
+  index.Clear();
+  name_index.Clear();
   waypoint_tree.clear();
   next_id = 1;
 }
@@ -315,6 +393,8 @@ Waypoints::Erase(WaypointPtr &&wp)
                                        });
   assert(f.first != waypoint_tree.end());
 
+  index.Clear();
+  name_index.Clear();
   name_tree.Remove(std::move(wp));
   waypoint_tree.erase(f.first);
   ++serial;
@@ -329,6 +409,9 @@ Waypoints::EraseUserMarkers()
         if (home == wp)
           home = nullptr;
 
+        index.Clear();
+        name_index.Clear();
+
         name_tree.Remove(wp);
         ++serial;
         return true;
@@ -364,6 +447,8 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement)
                                        });
   assert(f.first != waypoint_tree.end());
 
+  index.Clear();
+  name_index.Clear();
   waypoint_tree.Replace(f.first, std::move(new_ptr));
 
   ++serial;
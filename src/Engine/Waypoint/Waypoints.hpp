@@ -26,6 +26,8 @@
 #include "Util/QuadTree.hpp"
 #include "Util/Serial.hpp"
 #include "Ptr.hpp"
+#include "WaypointIndex.hpp"
+#include "WaypointNameIndex.hpp"
 #include "Waypoint.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 
@@ -75,7 +77,22 @@ class Waypoints {
   unsigned next_id;
 
   WaypointTree waypoint_tree;
+
+  /**
+   * A compact copy of #waypoint_tree for fast spatial queries.  It is
+   * built by Optimise() and cleared by each modification; until then,
+   * queries fall back to #waypoint_tree.
+   */
+  WaypointIndex index;
+
   WaypointNameTree name_tree;
+
+  /**
+   * Searches for parts of names; built and cleared together with
+   * #index.
+   */
+  WaypointNameIndex name_index;
+
   TaskProjection task_projection;
 
   WaypointPtr home;
@@ -162,6 +179,9 @@ public:
    * Note: currently this code doesn't check for task projections
    * being modified from multiple calls to Optimise() so it should
    * only be called once (until this is fixed).
+   *
+   * This also (re)builds the #WaypointIndex used by the spatial
+   * queries.
    */
   void Optimise();
 
@@ -169,6 +189,8 @@ public:
    * Prepare and enable the next Optimise() call.
    */
   void ScheduleOptimise() {
+    index.Clear();
+    name_index.Clear();
     waypoint_tree.Flatten();
     waypoint_tree.ClearBounds();
   }
@@ -313,6 +335,36 @@ public:
     return name_tree.SuggestNormalisedPrefix(prefix, dest, max_length);
   }
 
+  /**
+   * Call visitor function on waypoints whose name contains the
+   * specified string (ignoring case, punctuation and accents), best
+   * matches first (see WaypointNameIndex::FindMatches()).  Before
+   * Optimise() has been called, this falls back to
+   * VisitNamePrefix().
+   *
+   * @param search the state of the previous search, which makes
+   * refining it (by appending characters) faster
+   */
+  void VisitNameMatches(const TCHAR *query, WaypointVisitor &visitor,
+                        WaypointNameIndex::Search &search) const;
+
+  /**
+   * Like VisitNameMatches(), but return only the best matches.
+   * Returns an empty list before Optimise() has been called.
+   */
+  std::vector<WaypointPtr> FindNameMatches(const TCHAR *query,
+                                           unsigned max_results,
+                                           WaypointNameIndex::Search &search) const;
+
+  /**
+   * Returns a set of possible characters following the specified
+   * string anywhere in a name; the counterpart of
+   * SuggestNamePrefix() for VisitNameMatches().
+   */
+  TCHAR *SuggestNameCharacters(const TCHAR *query,
+                               TCHAR *dest, size_t max_length,
+                               WaypointNameIndex::Search &search) const;
+
   /**
    * Looks up nearest waypoint to the search location.
    * Performs search according to flat-earth internal representation,
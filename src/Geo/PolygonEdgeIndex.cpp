@@ -0,0 +1,164 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "PolygonEdgeIndex.hpp"
+#include "SearchPointVector.hpp"
+
+/**
+ * The desired average number of edges per slab.
+ */
+static constexpr unsigned EDGES_PER_SLAB = 4;
+
+static constexpr unsigned MAX_SLABS = 4096;
+
+void
+PolygonEdgeIndex::Clear()
+{
+  slab_offsets.clear();
+  x0.clear();
+  y0.clear();
+  x1.clear();
+  y1.clear();
+  blocks.clear();
+}
+
+int
+PolygonEdgeIndex::GetSlab(double y) const
+{
+  const int n_slabs = slab_offsets.size() - 1;
+  const int slab = int((y - y_min) * slab_scale);
+  return std::min(std::max(slab, 0), n_slabs - 1);
+}
+
+void
+PolygonEdgeIndex::Update(const SearchPointVector &border)
+{
+  Clear();
+
+  if (border.size() < 3)
+    return;
+
+  const unsigned n_edges = border.size() - 1;
+
+  y_min = y_max = border.front().GetLocation().latitude.Native();
+  for (const auto &i : border) {
+    const double y = i.GetLocation().latitude.Native();
+    y_min = std::min(y_min, y);
+    y_max = std::max(y_max, y);
+  }
+
+  const unsigned n_slabs =
+    std::max(1u, std::min(n_edges / EDGES_PER_SLAB, MAX_SLABS));
+  slab_scale = y_max > y_min ? n_slabs / (y_max - y_min) : 0;
+
+  /* count the edges crossing each slab; horizontal edges never
+     change the winding number, and are left out */
+  slab_offsets.assign(n_slabs + 1, 0);
+  for (unsigned i = 0; i < n_edges; ++i) {
+    const double a = border[i].GetLocation().latitude.Native();
+    const double b = border[i + 1].GetLocation().latitude.Native();
+    if (a == b)
+      continue;
+
+    const int last = GetSlab(std::max(a, b));
+    for (int s = GetSlab(std::min(a, b)); s <= last; ++s)
+      ++slab_offsets[s + 1];
+  }
+
+  for (unsigned s = 0; s < n_slabs; ++s)
+    slab_offsets[s + 1] += slab_offsets[s];
+
+  const unsigned total = slab_offsets.back();
+  x0.resize(total);
+  y0.resize(total);
+  x1.resize(total);
+  y1.resize(total);
+
+  std::vector<unsigned> fill(slab_offsets.begin(), slab_offsets.end() - 1);
+  for (unsigned i = 0; i < n_edges; ++i) {
+    const double a = border[i].GetLocation().latitude.Native();
+    const double b = border[i + 1].GetLocation().latitude.Native();
+    if (a == b)
+      continue;
+
+    const int last = GetSlab(std::max(a, b));
+    for (int s = GetSlab(std::min(a, b)); s <= last; ++s) {
+      const unsigned j = fill[s]++;
+      x0[j] = border[i].GetLocation().longitude.Native();
+      y0[j] = a;
+      x1[j] = border[i + 1].GetLocation().longitude.Native();
+      y1[j] = b;
+    }
+  }
+}
+
+void
+PolygonEdgeIndex::UpdateFlat(const SearchPointVector &border)
+{
+  blocks.clear();
+
+  if (border.size() < 3)
+    return;
+
+  const unsigned n_edges = border.size() - 1;
+  blocks.reserve((n_edges + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+  for (unsigned start = 0; start < n_edges; start += BLOCK_SIZE) {
+    const unsigned end = std::min(start + BLOCK_SIZE, n_edges);
+
+    /* the block's last edge ends at point "end" */
+    FlatBoundingBox box(border[start].GetFlatLocation());
+    for (unsigned i = start + 1; i <= end; ++i)
+      box.Expand(border[i].GetFlatLocation());
+
+    blocks.push_back(box);
+  }
+}
+
+bool
+PolygonEdgeIndex::IsInside(const GeoPoint &p) const
+{
+  const double px = p.longitude.Native(), py = p.latitude.Native();
+
+  /* only edges with y_min <= py < y_max can be crossed */
+  if (slab_offsets.empty() || py < y_min || py >= y_max)
+    return false;
+
+  const unsigned slab = GetSlab(py);
+  const unsigned begin = slab_offsets[slab], end = slab_offsets[slab + 1];
+
+  /* winding number, see PolygonInterior(); this loop is written
+     without branches so it can be vectorised */
+  int wn = 0;
+  for (unsigned i = begin; i < end; ++i) {
+    const double left = (x1[i] - x0[i]) * (py - y0[i]) -
+      (px - x0[i]) * (y1[i] - y0[i]);
+
+    const bool up = (y0[i] <= py) & (y1[i] > py);
+    const bool down = (y0[i] > py) & (y1[i] <= py);
+
+    wn += int(up & (left > 0)) - int(down & (left < 0));
+  }
+
+  return wn != 0;
+}
@@ -0,0 +1,128 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_GEO_POLYGON_EDGE_INDEX_HPP
+#define XCSOAR_GEO_POLYGON_EDGE_INDEX_HPP
+
+#include "Flat/FlatBoundingBox.hpp"
+#include "Compiler.h"
+
+#include <algorithm>
+#include <vector>
+
+struct GeoPoint;
+class SearchPointVector;
+
+/**
+ * A search structure over the edges of a closed polygon (a
+ * #SearchPointVector whose last point equals the first one).
+ *
+ * For the point-in-polygon test, the edges are sorted into horizontal
+ * slabs by latitude, and each slab stores a copy of the geographic
+ * coordinates of the edges crossing it in separate arrays.  A query
+ * only looks at the edges of one slab, in a loop without branches
+ * that the compiler can vectorise.
+ *
+ * For ray intersections, the flat bounding box of each block of
+ * #BLOCK_SIZE consecutive edges is stored, so most edges can be
+ * skipped without looking at them.
+ */
+class PolygonEdgeIndex {
+  static constexpr unsigned BLOCK_SIZE = 16;
+
+  /**
+   * The latitude range [rad] covered by the slabs.
+   */
+  double y_min, y_max;
+
+  /**
+   * The number of slabs per radian of latitude.
+   */
+  double slab_scale;
+
+  /**
+   * For each slab, the index of its first edge in the coordinate
+   * arrays; the last element is the total number of edges.
+   */
+  std::vector<unsigned> slab_offsets;
+
+  /**
+   * Edge start and end points [rad], grouped by slab.
+   */
+  std::vector<double> x0, y0, x1, y1;
+
+  /**
+   * Flat bounding box of each block of #BLOCK_SIZE edges.
+   */
+  std::vector<FlatBoundingBox> blocks;
+
+public:
+  /**
+   * Build the geographic slabs from the given polygon.
+   */
+  void Update(const SearchPointVector &border);
+
+  /**
+   * Build the flat block boxes; call this after the polygon has been
+   * projected.
+   */
+  void UpdateFlat(const SearchPointVector &border);
+
+  void Clear();
+
+  /**
+   * Is the given point inside the polygon?  The result is the same
+   * as the one of SearchPointVector::IsInside().
+   */
+  gcc_pure
+  bool IsInside(const GeoPoint &p) const;
+
+  /**
+   * Invoke a function with the index of each edge (edge i connects
+   * point i and point i+1) whose block box overlaps the given box, in
+   * ascending order.  Returns false if UpdateFlat() has not been
+   * called.
+   */
+  template<typename F>
+  bool VisitEdges(const FlatBoundingBox &box, unsigned n_edges, F &&f) const {
+    if (blocks.empty())
+      return false;
+
+    for (unsigned b = 0, n = blocks.size(); b < n; ++b) {
+      if (!blocks[b].Overlaps(box))
+        continue;
+
+      const unsigned end = std::min((b + 1) * BLOCK_SIZE, n_edges);
+      for (unsigned i = b * BLOCK_SIZE; i < end; ++i)
+        f(i);
+    }
+
+    return true;
+  }
+
+private:
+  gcc_pure
+  int GetSlab(double y) const;
+};
+
+#endif
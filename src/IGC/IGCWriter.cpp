@@ -31,24 +31,15 @@ Copyright_License {
 #include <assert.h>
 
 IGCWriter::IGCWriter(Path path)
-  :file(path,
-        /* we use CREATE_VISIBLE here so the user can recover partial
-           IGC files after a crash/battery failure/etc. */
-        FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+  :output(path)
 {
   fix.Clear();
-
-  grecord.Initialize();
 }
 
 void
 IGCWriter::CommitLine(char *line)
 {
-  buffered.Write(line);
-  buffered.Write('\n');
-
-  grecord.AppendRecordToBuffer(line);
+  output.Push(line);
 }
 
 void
@@ -269,9 +260,3 @@ IGCWriter::LogFRecord(const BrokenTime &time, const int *satellite_ids)
   WriteLine(f_record);
 }
 
-void
-IGCWriter::Sign()
-{
-  grecord.FinalizeBuffer();
-  grecord.WriteTo(buffered);
-}
@@ -24,10 +24,8 @@ Copyright_License {
 #ifndef XCSOAR_IGC_WRITER_HPP
 #define XCSOAR_IGC_WRITER_HPP
 
-#include "Logger/GRecord.hpp"
+#include "IGCWriterThread.hpp"
 #include "IGCFix.hpp"
-#include "IO/FileOutputStream.hxx"
-#include "IO/BufferedOutputStream.hxx"
 
 #include <tchar.h>
 
@@ -42,10 +40,11 @@ class IGCWriter {
     MAX_IGC_BUFF = 255,
   };
 
-  FileOutputStream file;
-  BufferedOutputStream buffered;
-
-  GRecord grecord;
+  /**
+   * Writes the records to the file and calculates the G record in a
+   * separate thread.
+   */
+  IGCWriterThread output;
 
   IGCFix fix;
 
@@ -53,15 +52,36 @@ class IGCWriter {
 
 public:
   /**
-   * Create a new IGC file.  The caller must check IsOpen().
+   * Create a new IGC file.
+   *
+   * Throws std::runtime_error on error.
    */
   explicit IGCWriter(Path path);
 
+  /**
+   * Pass all records to the operating system, without waiting for
+   * completion.  The file is complete after this object has been
+   * destructed.
+   */
   void Flush() {
-    buffered.Flush();
+    output.Flush();
   }
 
-  void Sign();
+  /**
+   * Append the G record after all records which have been written so
+   * far.  Nothing may be written after this.
+   */
+  void Sign() {
+    output.Sign();
+  }
+
+  /**
+   * The largest number of bytes which have been waiting to be
+   * written because the storage medium did not keep up.
+   */
+  size_t GetMaxPending() {
+    return output.GetMaxPending();
+  }
 
 private:
   /**
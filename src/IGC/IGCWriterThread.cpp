@@ -0,0 +1,203 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IGCWriterThread.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <assert.h>
+#include <string.h>
+
+IGCWriterThread::IGCWriterThread(Path path)
+  :Thread("IGCWriter"),
+   file(path,
+        /* we use CREATE_VISIBLE here so the user can recover partial
+           IGC files after a crash/battery failure/etc. */
+        FileOutputStream::Mode::CREATE_VISIBLE),
+   buffered(file),
+   unsynced(false), failed(false),
+   flush_requested(false), sign_requested(false), stop(false),
+   max_pending(0)
+{
+  grecord.Initialize();
+
+  /* allocate both buffers now, so Push() usually doesn't allocate
+     memory */
+  front.reserve(BUFFER_SIZE);
+  back.reserve(BUFFER_SIZE);
+
+  if (!Start())
+    throw std::runtime_error("Failed to start the IGC writer thread");
+
+  SetLowPriority();
+}
+
+IGCWriterThread::~IGCWriterThread()
+{
+  {
+    const ScopeLock protect(mutex);
+    stop = true;
+    cond.signal();
+  }
+
+  Join();
+
+  try {
+    file.Commit();
+  } catch (const std::exception &e) {
+    LogError(e);
+  }
+
+  if (max_pending > BUFFER_SIZE)
+    LogFormat("IGC writer buffer has grown to %u bytes",
+              (unsigned)max_pending);
+}
+
+void
+IGCWriterThread::Push(const char *line)
+{
+  assert(strchr(line, '\n') == nullptr);
+
+  const size_t length = strlen(line);
+
+  const ScopeLock protect(mutex);
+  assert(!stop);
+
+  if (front.size() + length + 1 > front.capacity())
+    /* the storage medium has stalled for a long time; keep the
+       record anyway, it is needed for a valid G record */
+    front.reserve(std::max(2 * front.capacity(),
+                           front.size() + length + 1));
+
+  front.insert(front.end(), line, line + length);
+  front.push_back('\n');
+
+  if (front.size() > max_pending)
+    max_pending = front.size();
+
+  if (front.size() > BUFFER_SIZE / 2 && !flush_requested) {
+    /* the caller doesn't flush often enough; don't wait for the
+       buffer to overflow */
+    flush_requested = true;
+    cond.signal();
+  }
+}
+
+void
+IGCWriterThread::Flush()
+{
+  {
+    const ScopeLock protect(mutex);
+    flush_requested = true;
+  }
+
+  /* signal after unlocking, or the writer thread might preempt us
+     only to block on the mutex we're holding */
+  cond.signal();
+}
+
+void
+IGCWriterThread::Sign()
+{
+  {
+    const ScopeLock protect(mutex);
+    sign_requested = true;
+  }
+
+  cond.signal();
+}
+
+void
+IGCWriterThread::WriteBack(bool sign, bool sync)
+{
+  if (failed) {
+    back.clear();
+    return;
+  }
+
+  try {
+    char *p = back.data();
+    char *const end = p + back.size();
+
+    while (p < end) {
+      char *newline = (char *)memchr(p, '\n', end - p);
+      assert(newline != nullptr);
+
+      buffered.Write(p, newline + 1 - p);
+
+      *newline = 0;
+      grecord.AppendRecordToBuffer(p);
+
+      p = newline + 1;
+    }
+
+    if (sign) {
+      grecord.FinalizeBuffer();
+      grecord.WriteTo(buffered);
+    }
+
+    buffered.Flush();
+
+    if (!back.empty() || sign)
+      unsynced = true;
+
+    if (unsynced && (sync || sync_clock.CheckUpdate(SYNC_INTERVAL))) {
+      file.Sync();
+      unsynced = false;
+    }
+  } catch (const std::exception &e) {
+    failed = true;
+    LogError(e);
+  }
+
+  back.clear();
+}
+
+void
+IGCWriterThread::Run()
+{
+  const ScopeLock protect(mutex);
+
+  while (true) {
+    if (!flush_requested && !sign_requested && !stop)
+      /* wake up after the SYNC_INTERVAL even if nobody asked us to
+         flush, to commit data which is still not on the storage
+         medium */
+      cond.timed_wait(mutex, SYNC_INTERVAL);
+
+    front.swap(back);
+
+    const bool sign = sign_requested, stopping = stop;
+    flush_requested = sign_requested = false;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      WriteBack(sign, sign || stopping);
+    }
+
+    if (stopping)
+      break;
+  }
+}
@@ -0,0 +1,164 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_WRITER_THREAD_HPP
+#define XCSOAR_IGC_WRITER_THREAD_HPP
+
+#include "Logger/GRecord.hpp"
+#include "IO/FileOutputStream.hxx"
+#include "IO/BufferedOutputStream.hxx"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "Thread/Cond.hxx"
+#include "Time/PeriodClock.hpp"
+
+#include <vector>
+
+#include <stddef.h>
+
+class Path;
+
+/**
+ * The back end of #IGCWriter: a thread which writes IGC records to
+ * the file and feeds them into the G record digest.  This way, the
+ * thread which generates the records never waits for a slow storage
+ * medium.
+ *
+ * Records are collected in one buffer while the thread writes the
+ * other one (double buffering); the caller only holds the lock for
+ * copying a record.
+ */
+class IGCWriterThread final : Thread {
+  /**
+   * The initial capacity of each buffer [bytes].  At 10 Hz, this is
+   * enough for about three minutes of B records.  If the storage
+   * medium stalls for longer, the buffer grows: a signed flight log
+   * must not lose records.
+   */
+  static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+  /**
+   * Commit the file to the storage medium at least this often [ms],
+   * so a power failure loses only little data.  Between these, all
+   * data is passed to the kernel as soon as Flush() is called.
+   */
+  static constexpr unsigned SYNC_INTERVAL = 10000;
+
+  FileOutputStream file;
+
+  /**
+   * The following attributes are only used by the thread.
+   */
+  BufferedOutputStream buffered;
+  GRecord grecord;
+  PeriodClock sync_clock;
+
+  /**
+   * Has data been written since the last FileOutputStream::Sync()
+   * call?
+   */
+  bool unsynced;
+
+  /**
+   * Set after an I/O error; from then on, all records are
+   * discarded.
+   */
+  bool failed;
+
+  /**
+   * Protects the following attributes.  It is never held during
+   * I/O.
+   */
+  Mutex mutex;
+  Cond cond;
+
+  /**
+   * The buffer which receives new records.  The thread swaps it with
+   * #back and then writes #back without holding the lock.
+   */
+  std::vector<char> front, back;
+
+  bool flush_requested, sign_requested, stop;
+
+  /**
+   * The largest number of bytes which have been waiting in #front.
+   */
+  size_t max_pending;
+
+public:
+  /**
+   * Create the file and start the thread.
+   *
+   * Throws std::runtime_error on error.
+   */
+  explicit IGCWriterThread(Path path);
+
+  /**
+   * Write all pending records, stop the thread and close the file.
+   */
+  ~IGCWriterThread();
+
+  /**
+   * Append a record (without the line terminator) to the file.
+   * This never blocks on I/O.  If the buffer is full (because the
+   * storage medium has stalled for a very long time), it is
+   * enlarged; this is the only case where memory is allocated.
+   */
+  void Push(const char *line);
+
+  /**
+   * Ask the thread to pass all pending records to the kernel.  This
+   * does not wait for completion.
+   */
+  void Flush();
+
+  /**
+   * Ask the thread to append the G record after the pending records.
+   * No record may be pushed after this.  This does not wait for
+   * completion.
+   */
+  void Sign();
+
+  /**
+   * The largest number of bytes which have been waiting to be
+   * written.  If this exceeds #BUFFER_SIZE, the buffer had to grow.
+   */
+  size_t GetMaxPending() {
+    const ScopeLock protect(mutex);
+    return max_pending;
+  }
+
+private:
+  /**
+   * Write the records in #back and update the digest.
+   *
+   * @param sign append the G record after the records?
+   * @param sync commit the file to the storage medium now?
+   */
+  void WriteBack(bool sign, bool sync);
+
+  /* virtual methods from class Thread */
+  void Run() override;
+};
+
+#endif
@@ -58,6 +58,17 @@ public:
   long Tell() const override;
 };
 
+/**
+ * Open a text file for reading.  If its name ends with ".gz", it is
+ * decompressed on the fly (see #GunzipLineReaderA).  This function
+ * is implemented in GunzipLineReader.cpp, so only its callers need
+ * to link with zlib.
+ *
+ * Throws std::exception on error.
+ */
+std::unique_ptr<NLineReader>
+OpenFileLineReaderA(Path path);
+
 class FileLineReader : public ConvertLineReader {
 public:
   /**
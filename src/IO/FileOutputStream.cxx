@@ -102,6 +102,16 @@ FileOutputStream::Write(const void *data, size_t size)
 				      GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+	if (!FlushFileBuffers(handle))
+		throw FormatLastError("Failed to flush %s",
+				      GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
@@ -199,6 +209,21 @@ FileOutputStream::Write(const void *data, size_t size)
 				  GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+#ifdef __APPLE__
+	/* macOS doesn't declare fdatasync() */
+	const int result = fsync(fd.Get());
+#else
+	const int result = fdatasync(fd.Get());
+#endif
+	if (result < 0)
+		throw FormatErrno("Failed to flush %s", GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
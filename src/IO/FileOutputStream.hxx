@@ -109,6 +109,15 @@ public:
 	/* virtual methods from class OutputStream */
 	void Write(const void *data, size_t size) override;
 
+	/**
+	 * Wait until all data written so far has been committed to
+	 * the storage medium (fdatasync()), so it survives a power
+	 * failure.
+	 *
+	 * Throws std::exception on error.
+	 */
+	void Sync();
+
 	void Commit();
 	void Cancel();
 
@@ -0,0 +1,63 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "GunzipLineReader.hpp"
+#include "FileLineReader.hpp"
+
+char *
+GunzipLineReaderA::ReadLine()
+{
+  if (eof)
+    return nullptr;
+
+  try {
+    char *line = buffered.ReadLine();
+    if (line == nullptr)
+      eof = true;
+    return line;
+  } catch (const ZlibError &) {
+    eof = true;
+    return nullptr;
+  }
+}
+
+long
+GunzipLineReaderA::GetSize() const
+{
+  return file.GetSize();
+}
+
+long
+GunzipLineReaderA::Tell() const
+{
+  return file.GetPosition();
+}
+
+std::unique_ptr<NLineReader>
+OpenFileLineReaderA(Path path)
+{
+  if (path.MatchesExtension(_T(".gz")))
+    return std::make_unique<GunzipLineReaderA>(path);
+
+  return std::make_unique<FileLineReaderA>(path);
+}
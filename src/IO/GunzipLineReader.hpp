@@ -0,0 +1,77 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_GUNZIP_LINE_READER_HPP
+#define XCSOAR_IO_GUNZIP_LINE_READER_HPP
+
+#include "LineReader.hpp"
+#include "FileReader.hxx"
+#include "GunzipReader.hxx"
+#include "BufferedReader.hxx"
+
+/**
+ * Glue class which combines FileReader, GunzipReader and
+ * BufferedReader, and provides a public NLineReader interface for
+ * reading a gzip compressed text file.
+ */
+class GunzipLineReaderA : public NLineReader {
+  FileReader file;
+  GunzipReader gunzip;
+  BufferedReader buffered;
+
+  /**
+   * Was the end of the compressed data reached, or was it found to
+   * be corrupt?
+   */
+  bool eof;
+
+public:
+  /**
+   * Throws std::exception on error.
+   */
+  explicit GunzipLineReaderA(Path path)
+    :file(path), gunzip(file), buffered(gunzip), eof(false) {}
+
+public:
+  /* virtual methods from class NLineReader */
+
+  /**
+   * Returns nullptr at the end of the file.  A corrupt or truncated
+   * stream (e.g. a log file which was being written when the program
+   * crashed) is treated like the end of the file.
+   */
+  char *ReadLine() override;
+
+  /**
+   * Returns the size of the compressed file.
+   */
+  long GetSize() const override;
+
+  /**
+   * Returns the position within the compressed file, which is
+   * good enough for a progress indicator.
+   */
+  long Tell() const override;
+};
+
+#endif
@@ -186,7 +186,7 @@ namespace CommonInterface {
     Private::blackboard.ReadBlackboardBasic(nmea_info);
   }
 
-  static inline void ReadBlackboardCalculated(const DerivedInfo &derived_info) {
+  static inline void ReadBlackboardCalculated(const VersionedDerivedInfo &derived_info) {
     assert(InMainThread());
 
     Private::blackboard.ReadBlackboardCalculated(derived_info);
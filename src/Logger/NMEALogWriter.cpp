@@ -0,0 +1,153 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "NMEALogWriter.hpp"
+#include "IO/FileOutputStream.hxx"
+#include "IO/GzipOutputStream.hxx"
+#include "LogFile.hpp"
+
+#include <stdexcept>
+
+#include <string.h>
+
+NMEALogWriter::NMEALogWriter(Path path, bool compress)
+  :Thread("NMEALogWriter"),
+   file(new FileOutputStream(path, FileOutputStream::Mode::CREATE_VISIBLE)),
+   gzip(compress ? new GzipOutputStream(*file) : nullptr),
+   output(compress ? (OutputStream *)gzip.get() : file.get()),
+   wake(false), stop(false), failed(false),
+   dropped_lines(0), max_queue_depth(0)
+{
+  if (!Start())
+    throw std::runtime_error("Failed to start the NMEA log writer thread");
+}
+
+NMEALogWriter::~NMEALogWriter()
+{
+  {
+    const ScopeLock protect(mutex);
+    stop = true;
+    cond.signal();
+  }
+
+  Join();
+
+  try {
+    if (gzip && !failed)
+      gzip->Flush();
+
+    file->Commit();
+  } catch (const std::exception &e) {
+    LogError("Failed to finish the NMEA log", e);
+  }
+
+  LogFormat("NMEA logger: max queue depth %u bytes, %u lines dropped",
+            (unsigned)GetMaxQueueDepth(), GetDroppedLines());
+}
+
+bool
+NMEALogWriter::Push(const char *line)
+{
+  const size_t length = strlen(line);
+
+  /* this is the only producer, so the free space can only grow
+     until the line has been pushed */
+  const size_t depth = queue.GetSize();
+  if (length + 1 > queue.GetCapacity() - depth) {
+    dropped_lines.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  queue.Push({line, length});
+  queue.Push({"\n", 1});
+
+  const size_t new_depth = depth + length + 1;
+  if (new_depth > max_queue_depth.load(std::memory_order_relaxed))
+    max_queue_depth.store(new_depth, std::memory_order_relaxed);
+
+  if (depth < WAKE_THRESHOLD && new_depth >= WAKE_THRESHOLD) {
+    /* don't wait for the timer, write a large block now */
+    const ScopeLock protect(mutex);
+    wake = true;
+    cond.signal();
+  }
+
+  return true;
+}
+
+void
+NMEALogWriter::Drain()
+{
+  bool written = false;
+
+  while (true) {
+    auto r = queue.Read();
+    if (r.IsEmpty())
+      break;
+
+    if (!failed) {
+      try {
+        output->Write(r.data, r.size);
+        written = true;
+      } catch (const std::exception &e) {
+        /* give up, but keep draining the queue, so the producer
+           does not waste time on a full queue */
+        failed = true;
+        LogError("Failed to write the NMEA log", e);
+      }
+    }
+
+    queue.Consume(r.size);
+  }
+
+  if (written && gzip && !failed) {
+    try {
+      gzip->SyncFlush();
+    } catch (const std::exception &e) {
+      failed = true;
+      LogError("Failed to write the NMEA log", e);
+    }
+  }
+}
+
+void
+NMEALogWriter::Run()
+{
+  const ScopeLock protect(mutex);
+
+  while (true) {
+    if (!wake && !stop)
+      cond.timed_wait(mutex, WRITE_INTERVAL);
+
+    wake = false;
+    const bool stopping = stop;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      Drain();
+    }
+
+    if (stopping)
+      break;
+  }
+}
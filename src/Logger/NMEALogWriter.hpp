@@ -0,0 +1,149 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_LOG_WRITER_HPP
+#define XCSOAR_NMEA_LOG_WRITER_HPP
+
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "Thread/Cond.hxx"
+#include "Util/SpscFifoBuffer.hpp"
+
+#include <atomic>
+#include <memory>
+
+#include <stddef.h>
+
+class Path;
+class OutputStream;
+class FileOutputStream;
+class GzipOutputStream;
+
+/**
+ * Writes lines to a file in a separate thread, so a slow storage
+ * medium (e.g. a SD card which stalls for tens of milliseconds every
+ * now and then) never blocks the thread which receives the data.
+ *
+ * Lines are copied into a single-producer/single-consumer ring
+ * buffer, which the writer thread drains in large blocks, optionally
+ * compressing them (gzip).  The writer thread does not lock for
+ * that, but several producers must be serialised by the caller.  If
+ * the buffer is full, lines are dropped and counted.
+ */
+class NMEALogWriter final : Thread {
+  static constexpr size_t QUEUE_SIZE = 64 * 1024;
+
+  /**
+   * Wake up the writer thread as soon as the queue is filled more
+   * than this.
+   */
+  static constexpr size_t WAKE_THRESHOLD = QUEUE_SIZE / 4;
+
+  /**
+   * Write the queue contents at least this often [ms].  Compressed
+   * output is flushed at the same interval, so a log file is usable
+   * even if the program crashes.
+   */
+  static constexpr unsigned WRITE_INTERVAL = 2000;
+
+  std::unique_ptr<FileOutputStream> file;
+  std::unique_ptr<GzipOutputStream> gzip;
+  OutputStream *output;
+
+  SpscFifoBuffer<char, QUEUE_SIZE> queue;
+
+  /**
+   * Protects #wake and #stop.  It is only locked by the producer to
+   * wake up the writer thread, never while doing I/O.
+   */
+  Mutex mutex;
+  Cond cond;
+  bool wake, stop;
+
+  /**
+   * Set by the writer thread after an I/O error; from then on, the
+   * queue is discarded.
+   */
+  bool failed;
+
+  std::atomic<unsigned> dropped_lines;
+  std::atomic<size_t> max_queue_depth;
+
+public:
+  /**
+   * Create the file and start the writer thread.
+   *
+   * Throws std::exception on error.
+   *
+   * @param compress compress the file with gzip?
+   */
+  NMEALogWriter(Path path, bool compress);
+
+  /**
+   * Stop the writer thread after it has written all pending lines,
+   * and close the file.
+   */
+  ~NMEALogWriter();
+
+  /**
+   * Enqueue a line (a newline character is appended).  This never
+   * blocks.  Only one thread may call this method at a time.
+   *
+   * @return false if the queue was full and the line was dropped
+   */
+  bool Push(const char *line);
+
+  /**
+   * The number of lines which have been dropped because the queue
+   * was full.
+   */
+  unsigned GetDroppedLines() const {
+    return dropped_lines.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * The number of bytes currently waiting in the queue.
+   */
+  size_t GetQueueDepth() const {
+    return queue.GetSize();
+  }
+
+  /**
+   * The highest number of bytes which have been waiting in the
+   * queue.
+   */
+  size_t GetMaxQueueDepth() const {
+    return max_queue_depth.load(std::memory_order_relaxed);
+  }
+
+private:
+  /**
+   * Write all lines from the queue to the file.
+   */
+  void Drain();
+
+  /* virtual methods from class Thread */
+  void Run() override;
+};
+
+#endif
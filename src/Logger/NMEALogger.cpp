@@ -22,8 +22,9 @@ Copyright_License {
 */
 
 #include "Logger/NMEALogger.hpp"
-#include "IO/TextWriter.hpp"
+#include "Logger/NMEALogWriter.hpp"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "Time/BrokenDateTime.hpp"
 #include "Thread/Mutex.hpp"
 #include "OS/Path.hpp"
@@ -31,10 +32,15 @@ Copyright_License {
 
 namespace NMEALogger
 {
+  /**
+   * Protects #writer, and serialises the callers of
+   * NMEALogWriter::Push() (one thread per device).
+   */
   static Mutex mutex;
-  static TextWriter *writer;
+  static NMEALogWriter *writer;
 
   bool enabled = false;
+  bool compress = false;
 
   static bool Start();
 }
@@ -49,20 +55,22 @@ NMEALogger::Start()
   assert(dt.IsPlausible());
 
   StaticString<64> name;
-  name.Format(_T("%04u-%02u-%02u_%02u-%02u.nmea"),
+  name.Format(_T("%04u-%02u-%02u_%02u-%02u.nmea%s"),
               dt.year, dt.month, dt.day,
-              dt.hour, dt.minute);
+              dt.hour, dt.minute,
+              compress ? _T(".gz") : _T(""));
 
   const auto logs_path = MakeLocalPath(_T("logs"));
 
   const auto path = AllocatedPath::Build(logs_path, name);
-  writer = new TextWriter(path, false);
-  if (writer == nullptr)
-    return false;
 
-  if (!writer->IsOpen()) {
-    delete writer;
-    writer = nullptr;
+  try {
+    writer = new NMEALogWriter(path, compress);
+  } catch (const std::exception &e) {
+    LogError("Failed to create the NMEA log", e);
+
+    /* don't retry (and log this error) for each line */
+    enabled = false;
     return false;
   }
 
@@ -72,7 +80,23 @@ NMEALogger::Start()
 void
 NMEALogger::Shutdown()
 {
+  const ScopeLock protect(mutex);
   delete writer;
+  writer = nullptr;
+}
+
+unsigned
+NMEALogger::GetDroppedLines()
+{
+  const ScopeLock protect(mutex);
+  return writer != nullptr ? writer->GetDroppedLines() : 0;
+}
+
+unsigned
+NMEALogger::GetQueueDepth()
+{
+  const ScopeLock protect(mutex);
+  return writer != nullptr ? writer->GetQueueDepth() : 0;
 }
 
 void
@@ -83,5 +107,5 @@ NMEALogger::Log(const char *text)
 
   ScopeLock protect(mutex);
   if (Start())
-    writer->WriteLine(text);
+    writer->Push(text);
 }
@@ -28,10 +28,30 @@ namespace NMEALogger
 {
   extern bool enabled;
 
+  /**
+   * Compress new log files with gzip?  This applies to the next
+   * file which is created.
+   */
+  extern bool compress;
+
   void Shutdown();
 
   /**
-   * Logs NMEA string to log file
+   * The number of lines which were dropped because the log file
+   * could not be written fast enough.
+   */
+  unsigned GetDroppedLines();
+
+  /**
+   * The number of bytes which are waiting to be written.
+   */
+  unsigned GetQueueDepth();
+
+  /**
+   * Logs NMEA string to log file.  This never blocks on file I/O,
+   * the line is written by a separate thread.  The callers (one port
+   * thread per device) are serialised by a mutex, which is held while
+   * the line is copied into the queue.
    * @param text
    */
   void Log(const char *line);
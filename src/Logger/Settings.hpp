@@ -42,6 +42,11 @@ struct LoggerSettings {
    */
   bool enable_nmea_logger;
 
+  /**
+   * Compress the files written by the #NMEALogger with gzip?
+   */
+  bool compress_nmea_logger;
+
   /** Logger interval in cruise mode */
   uint16_t time_step_cruise;
 
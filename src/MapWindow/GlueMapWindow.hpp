@@ -33,6 +33,7 @@ Copyright_License {
 #include "Renderer/VarioBarRenderer.hpp"
 #include "Screen/Timer.hpp"
 #include "Screen/Features.hpp"
+#include "Terrain/Prefetch.hpp"
 
 #include <array>
 
@@ -66,6 +67,22 @@ class GlueMapWindow : public MapWindow {
 
   TerrainThread *terrain_thread = nullptr;
 
+  /**
+   * The locations of the active task point and the following ones,
+   * copied from the task manager when DerivedInfo::task_serial
+   * changes.  See UpdateTerrainPrefetch().
+   */
+  TerrainPrefetch prefetch_task_points;
+
+  /**
+   * A few vertices of the reach boundary, copied from the route
+   * planner when TerrainInfo::reach_serial changes.
+   */
+  TerrainPrefetch prefetch_reach_points;
+
+  unsigned prefetch_task_serial, prefetch_reach_serial;
+  bool prefetch_task_valid = false, prefetch_reach_valid = false;
+
   PeriodClock mouse_down_clock;
 
   enum DragMode {
@@ -245,6 +262,14 @@ private:
    */
   void UpdateScreenBounds();
 
+  /**
+   * Fill the #TerrainPrefetch with the locations where terrain will
+   * be needed soon: the predicted ground track, the remaining task
+   * legs and the reach boundary.  The task manager and the route
+   * planner are only locked after they have been modified.
+   */
+  void UpdateTerrainPrefetch(TerrainPrefetch &prefetch);
+
   void UpdateScreenAngle();
   void UpdateProjection();
 
@@ -25,6 +25,15 @@ Copyright_License {
 #include "Terrain/RasterTerrain.hpp"
 #include "Topography/Thread.hpp"
 #include "Terrain/Thread.hpp"
+#include "Terrain/Prefetch.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/ProtectedRoutePlanner.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Engine/Route/FlatTriangleFanTree.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Util/ConstBuffer.hxx"
 #include "Interface.hpp"
 #include "Profile/Profile.hpp"
 #include "Screen/Layout.hpp"
@@ -108,6 +117,123 @@ GlueMapWindow::PanTo(const GeoPoint &location)
   FullRedraw();
 }
 
+/**
+ * Collects a few vertices of the root reach fan, which describes the
+ * reach boundary.
+ */
+class ReachPrefetchVisitor final : public FlatTriangleFanVisitor {
+  const FlatProjection &projection;
+  TerrainPrefetch &prefetch;
+
+  /**
+   * The maximum number of vertices to add.
+   */
+  static constexpr unsigned MAX_VERTICES = 12;
+
+public:
+  ReachPrefetchVisitor(const FlatProjection &_projection,
+                       TerrainPrefetch &_prefetch)
+    :projection(_projection), prefetch(_prefetch) {}
+
+  /* virtual methods from class FlatTriangleFanVisitor */
+  void VisitFan(FlatGeoPoint origin, ConstBuffer<FlatGeoPoint> fan) override {
+    if (fan.size < 3)
+      return;
+
+    const unsigned step = (fan.size + MAX_VERTICES - 1) / MAX_VERTICES;
+    for (unsigned i = 0; i < fan.size; i += step)
+      prefetch.Add(projection.Unproject(fan[i]));
+  }
+};
+
+/**
+ * Copy the locations of the active task point and the following ones.
+ */
+static void
+CopyTaskPoints(const TaskManager &task_manager, TerrainPrefetch &dest)
+{
+  dest.Clear();
+
+  const TaskWaypoint *active = task_manager.GetActiveTaskPoint();
+  if (active == nullptr)
+    return;
+
+  dest.Add(active->GetLocation());
+
+  if (task_manager.GetMode() == TaskType::ORDERED) {
+    const OrderedTask &ordered = task_manager.GetOrderedTask();
+    for (unsigned i = task_manager.GetActiveTaskPointIndex() + 1,
+           n = ordered.TaskSize(); i < n && !dest.full(); ++i)
+      dest.Add(ordered.GetTaskPoint(i).GetLocation());
+  }
+}
+
+void
+GlueMapWindow::UpdateTerrainPrefetch(TerrainPrefetch &prefetch)
+{
+  /* the tile cache resolution is in the order of a few kilometers,
+     therefore these locations do not need to be dense */
+  constexpr double PREDICTION_DURATION = 600;
+  constexpr unsigned PREDICTION_POINTS = 10;
+  constexpr double TASK_STEP = 5000;
+
+  const NMEAInfo &basic = Basic();
+  if (!basic.location_available)
+    return;
+
+  const DerivedInfo &calculated = Calculated();
+
+  /* refresh the copies of the task points and the reach boundary
+     only after the calculation thread has modified them, to avoid
+     locking the task manager and the route planner while drawing */
+
+  if (task != nullptr &&
+      (!prefetch_task_valid ||
+       calculated.task_serial != prefetch_task_serial)) {
+    ProtectedTaskManager::Lease lease(*task);
+    CopyTaskPoints(lease, prefetch_task_points);
+    prefetch_task_serial = calculated.task_serial;
+    prefetch_task_valid = true;
+  }
+
+  if (route_planner != nullptr &&
+      (!prefetch_reach_valid ||
+       calculated.reach_serial != prefetch_reach_serial)) {
+    prefetch_reach_points.Clear();
+
+    const ProtectedRoutePlanner::Lease lease(*route_planner);
+    ReachPrefetchVisitor visitor(lease->GetTerrainReachProjection(),
+                                 prefetch_reach_points);
+    lease->AcceptTerrainReachRoot(visitor);
+
+    prefetch_reach_serial = calculated.reach_serial;
+    prefetch_reach_valid = true;
+  }
+
+  /* highest priority: where we will be in the next few minutes */
+
+  prefetch.Add(basic.location);
+  if (basic.track_available && basic.MovementDetected())
+    prefetch.AddTrack(basic.location, basic.track, basic.ground_speed,
+                      PREDICTION_DURATION, PREDICTION_POINTS);
+
+  /* the remaining task legs, beginning with the active one */
+
+  GeoPoint previous = basic.location;
+  for (const GeoPoint &location : prefetch_task_points) {
+    if (prefetch.full())
+      break;
+
+    prefetch.AddLine(previous, location, TASK_STEP);
+    previous = location;
+  }
+
+  /* the reach boundary, which is evaluated by the route planner */
+
+  for (const GeoPoint &location : prefetch_reach_points)
+    prefetch.Add(location);
+}
+
 void
 GlueMapWindow::UpdateScreenBounds()
 {
@@ -122,8 +248,11 @@ GlueMapWindow::UpdateScreenBounds()
      it's used by other calculations, therefore don't check if terrain
      display is enabled */
   if (terrain_thread != nullptr &&
-      visible_projection.IsValid())
-    terrain_thread->Trigger(visible_projection);
+      visible_projection.IsValid()) {
+    TerrainPrefetch prefetch;
+    UpdateTerrainPrefetch(prefetch);
+    terrain_thread->Trigger(visible_projection, prefetch);
+  }
 }
 
 void
@@ -66,9 +66,12 @@ void
 MapWindow::SetGlideComputer(GlideComputer *_gc)
 {
   glide_computer = _gc;
-  airspace_renderer.SetAirspaceWarnings(glide_computer != nullptr
-                                        ? &glide_computer->GetAirspaceWarnings()
-                                        : nullptr);
+  const ProtectedAirspaceWarningManager *warnings =
+    glide_computer != nullptr
+    ? &glide_computer->GetAirspaceWarnings()
+    : nullptr;
+  airspace_renderer.SetAirspaceWarnings(warnings);
+  airspace_label_renderer.SetAirspaceWarnings(warnings);
 }
 
 void
@@ -26,6 +26,7 @@ Copyright_License {
 #include "Protection.hpp"
 #include "Components.hpp"
 #include "NMEA/MoreData.hpp"
+#include "Blackboard/BlackboardGroups.hpp"
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
 
@@ -92,13 +93,13 @@ MergeThread::Tick()
 #endif
 
     /* update last_any in every iteration */
-    last_any = basic;
+    BlackboardGroups::Update(last_any, basic);
 
     /* update last_fix only when a new GPS fix was received */
     if ((basic.time_available &&
          (!last_fix.time_available || basic.time != last_fix.time)) ||
         basic.location_available != last_fix.location_available)
-      last_fix = basic;
+      BlackboardGroups::Update(last_fix, basic);
   }
 
 #ifdef HAVE_PCM_PLAYER
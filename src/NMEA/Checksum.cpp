@@ -38,16 +38,18 @@ VerifyNMEAChecksum(const char *p)
   if (asterisk == NULL)
     return false;
 
-  const char *checksum_string = asterisk + 1;
-  char *endptr;
-  unsigned long ReadCheckSum2 = strtoul(checksum_string, &endptr, 16);
-  if (endptr == checksum_string || *endptr != 0 || ReadCheckSum2 >= 0x100)
-    return false;
+  return VerifyNMEAChecksum(asterisk + 1, NMEAChecksum(p, asterisk - p));
+}
 
-  uint8_t ReadCheckSum = (unsigned char)ReadCheckSum2;
-  uint8_t CalcCheckSum = NMEAChecksum(p, asterisk - p);
+bool
+VerifyNMEAChecksum(const char *checksum_string, uint8_t calculated)
+{
+  assert(checksum_string != NULL);
 
-  return CalcCheckSum == ReadCheckSum;
+  char *endptr;
+  unsigned long ReadCheckSum = strtoul(checksum_string, &endptr, 16);
+  return endptr != checksum_string && *endptr == 0 &&
+    ReadCheckSum == calculated;
 }
 
 void
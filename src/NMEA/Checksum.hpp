@@ -87,6 +87,15 @@ gcc_pure
 bool
 VerifyNMEAChecksum(const char *p);
 
+/**
+ * Verify a checksum which was calculated by the caller (e.g. while
+ * copying the line) against the specified string, which is the part
+ * of a NMEA line after the last asterisk.
+ */
+gcc_pure
+bool
+VerifyNMEAChecksum(const char *checksum_string, uint8_t calculated);
+
 /**
  * Caclulates the checksum of the specified string, and appends it at
  * the end, preceded by an asterisk ('*').
@@ -34,6 +34,8 @@ TerrainInfo::Clear()
   altitude_agl = 0;
 
   terrain_warning_location.SetInvalid();
+
+  reach_serial = 0;
 }
 
 void
@@ -78,6 +80,7 @@ DerivedInfo::Reset()
   task_stats.reset();
   ordered_task_stats.reset();
   common_stats.Reset();
+  task_serial = 0;
   contest_stats.Reset();
 
   flight.Reset();
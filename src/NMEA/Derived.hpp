@@ -75,6 +75,12 @@ struct TerrainInfo
    */
   GeoPoint terrain_warning_location;
 
+  /**
+   * Copy of RoutePlanner::GetReachSerial(); allows the UI to detect
+   * changes of the reach without locking the route planner.
+   */
+  unsigned reach_serial;
+
   void Clear();
 
   /**
@@ -225,6 +231,12 @@ struct DerivedInfo:
 
   /** Copy of common task statistics data */
   CommonStats common_stats;
+
+  /**
+   * Copy of TaskManager::GetSerial(); allows the UI to detect task
+   * changes without locking the task manager.
+   */
+  unsigned task_serial;
   /** Copy of contest statistics data */
   ContestStatistics contest_stats;
 
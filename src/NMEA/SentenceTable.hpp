@@ -0,0 +1,203 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_SENTENCE_TABLE_HPP
+#define XCSOAR_NMEA_SENTENCE_TABLE_HPP
+
+#include "Util/StringView.hxx"
+#include "Compiler.h"
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include <stdint.h>
+
+/**
+ * Returns the tag of the given NMEA line, i.e. its first column
+ * (e.g. "$GPRMC" or "$PFLAA").
+ */
+gcc_pure
+static inline StringView
+GetNMEASentenceTag(const char *line)
+{
+  const char *end = line;
+  while (*end != 0 && *end != ',' && *end != '*')
+    ++end;
+
+  return StringView(line, end);
+}
+
+/**
+ * A perfect hash table which maps NMEA sentence tags to their
+ * position in the list passed to the constructor.
+ *
+ * Declare it "constexpr": the compiler then searches a hash seed
+ * which maps all tags to distinct slots, and a lookup costs one hash
+ * calculation and at most one string comparison, no matter how many
+ * tags there are.  A table which cannot be built (too many tags or
+ * duplicates) is rejected at compile time.
+ */
+class NMEASentenceTable {
+public:
+  static constexpr unsigned MAX_SENTENCES = 32;
+
+private:
+  /**
+   * The number of slots is a power of two, at least four times the
+   * number of tags, which makes finding a seed quick.
+   */
+  static constexpr unsigned MAX_SLOTS = 4 * MAX_SENTENCES;
+
+  static constexpr uint8_t EMPTY = 0xff;
+
+  /**
+   * After this many seeds have failed, the tags are assumed to
+   * contain duplicates.
+   */
+  static constexpr uint32_t MAX_SEED_ATTEMPTS = 4096;
+
+  const char *tags[MAX_SENTENCES];
+  uint8_t lengths[MAX_SENTENCES];
+
+  /**
+   * Maps hash values to indices in #tags, or #EMPTY.
+   */
+  uint8_t slots[MAX_SLOTS];
+
+  unsigned n_tags;
+  unsigned slot_mask;
+  uint32_t seed;
+
+public:
+  constexpr NMEASentenceTable(std::initializer_list<const char *> list)
+    :tags(), lengths(), slots(),
+     n_tags(CheckSize(list.size())),
+     slot_mask(CalculateSlotMask(list.size())),
+     seed(FindSeed(list, CalculateSlotMask(list.size()))) {
+    for (auto &i : slots)
+      i = EMPTY;
+
+    unsigned n = 0;
+    for (const char *tag : list) {
+      tags[n] = tag;
+      lengths[n] = Length(tag);
+      slots[Hash(tag, lengths[n], seed) & slot_mask] = n;
+      ++n;
+    }
+  }
+
+  constexpr unsigned size() const {
+    return n_tags;
+  }
+
+  /**
+   * Look up a tag.
+   *
+   * @return the position of the tag in the list passed to the
+   * constructor, or -1 if it is not in this table
+   */
+  gcc_pure
+  int Find(StringView tag) const {
+    const unsigned i = slots[Hash(tag.data, tag.size, seed) & slot_mask];
+    return i != EMPTY && lengths[i] == tag.size &&
+      StringIsEqual(tags[i], tag.data, tag.size)
+      ? int(i)
+      : -1;
+  }
+
+  /**
+   * Look up the tag of the given NMEA line.
+   */
+  gcc_pure
+  int FindLine(const char *line) const {
+    return Find(GetNMEASentenceTag(line));
+  }
+
+  gcc_pure
+  bool Contains(StringView tag) const {
+    return Find(tag) >= 0;
+  }
+
+private:
+  static constexpr uint32_t Hash(const char *p, size_t length,
+                                 uint32_t seed) {
+    /* FNV-1a with the seed as offset basis */
+    uint32_t hash = seed;
+    for (size_t i = 0; i < length; ++i)
+      hash = (hash ^ uint8_t(p[i])) * 0x01000193u;
+
+    /* the low bits are used as slot number; fold the better mixed
+       high bits into them */
+    return hash ^ (hash >> 16);
+  }
+
+  static constexpr uint8_t Length(const char *tag) {
+    size_t length = 0;
+    while (tag[length] != 0)
+      ++length;
+
+    return length < EMPTY
+      ? uint8_t(length)
+      : throw std::length_error("NMEA sentence tag too long");
+  }
+
+  static constexpr unsigned CheckSize(size_t size) {
+    return size <= MAX_SENTENCES
+      ? unsigned(size)
+      : throw std::length_error("Too many NMEA sentence tags");
+  }
+
+  static constexpr unsigned CalculateSlotMask(size_t size) {
+    unsigned n_slots = 4;
+    while (n_slots < 4 * size)
+      n_slots *= 2;
+
+    return n_slots - 1;
+  }
+
+  static constexpr uint32_t FindSeed(std::initializer_list<const char *> list,
+                                     unsigned mask) {
+    for (uint32_t seed = 0x811c9dc5u, end = seed + MAX_SEED_ATTEMPTS;
+         seed != end; ++seed) {
+      bool used[MAX_SLOTS] = {};
+      bool collision = false;
+
+      for (const char *tag : list) {
+        bool &slot = used[Hash(tag, Length(tag), seed) & mask];
+        if (slot) {
+          collision = true;
+          break;
+        }
+
+        slot = true;
+      }
+
+      if (!collision)
+        return seed;
+    }
+
+    throw std::invalid_argument("Duplicate NMEA sentence tags");
+  }
+};
+
+#endif
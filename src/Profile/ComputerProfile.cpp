@@ -82,6 +82,7 @@ Profile::Load(const ProfileMap &map, LoggerSettings &settings)
   map.Get(ProfileKeys::PilotName, settings.pilot_name);
   map.Get(ProfileKeys::EnableFlightLogger, settings.enable_flight_logger);
   map.Get(ProfileKeys::EnableNMEALogger, settings.enable_nmea_logger);
+  map.Get(ProfileKeys::CompressNMEALogger, settings.compress_nmea_logger);
 }
 
 void
@@ -195,6 +195,7 @@ const char AutoLogger[] = "AutoLogger";
 const char DisableAutoLogger[] = "DisableAutoLogger";
 const char EnableFlightLogger[] = "EnableFlightLogger";
 const char EnableNMEALogger[] = "EnableNMEALogger";
+const char CompressNMEALogger[] = "CompressNMEALogger";
 const char MapFile[] = "MapFile"; // pL
 const char BallastSecsToEmpty[] = "BallastSecsToEmpty";
 const char DialogFont[] = "DialogFont";
@@ -191,6 +191,7 @@ extern const char AutoLogger[];
 extern const char DisableAutoLogger[];
 extern const char EnableFlightLogger[];
 extern const char EnableNMEALogger[];
+extern const char CompressNMEALogger[];
 extern const char MapFile[];
 extern const char BallastSecsToEmpty[];
 extern const char AccelerometerZero[];
@@ -30,6 +30,7 @@ Copyright_License {
 #include "Airspace/AirspaceComputerSettings.hpp"
 #include "Airspace/AirspaceVisibility.hpp"
 #include "Airspace/AirspaceWarningCopy.hpp"
+#include "Airspace/AirspaceState.hpp"
 #include "Formatter/AirspaceFormatter.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Screen/Canvas.hpp"
@@ -69,11 +70,30 @@ AirspaceLabelRenderer::Draw(Canvas &canvas,
   if (airspaces == nullptr || airspaces->IsEmpty())
     return;
 
+  const AircraftState aircraft = ToAircraftState(basic, calculated);
+
+  if (warning_manager != nullptr) {
+    /* use the state published by the calculation thread; this saves
+       copying the warnings and locking for each airspace */
+    const ProtectedAirspaceWarningManager::StateLease state(*warning_manager);
+    if (state.IsDefined()) {
+      const AirspaceMapVisible visible(computer_settings, settings,
+                                       aircraft, state->warnings);
+
+      DrawInternal(canvas,
+#ifndef ENABLE_OPENGL
+                   stencil_canvas,
+#endif
+                   *state->airspaces, projection, settings, state->warnings,
+                   visible, computer_settings.warnings);
+      return;
+    }
+  }
+
   AirspaceWarningCopy awc;
   if (warning_manager != nullptr)
     awc.Visit(*warning_manager);
 
-  const AircraftState aircraft = ToAircraftState(basic, calculated);
   const AirspaceMapVisible visible(computer_settings, settings,
                                    aircraft, awc);
 
@@ -81,7 +101,8 @@ AirspaceLabelRenderer::Draw(Canvas &canvas,
 #ifndef ENABLE_OPENGL
                stencil_canvas,
 #endif
-               projection, settings, awc, visible, computer_settings.warnings);
+               airspaces->GetCurrentSnapshot(), projection, settings, awc,
+               visible, computer_settings.warnings);
 }
 
 void
@@ -89,6 +110,7 @@ AirspaceLabelRenderer::DrawInternal(Canvas &canvas,
 #ifndef ENABLE_OPENGL
                                     Canvas &stencil_canvas,
 #endif
+                                    const AirspacesSnapshot &database,
                                     const WindowProjection &projection,
                                     const AirspaceRendererSettings &settings,
                                     const AirspaceWarningCopy &awc,
@@ -96,8 +118,8 @@ AirspaceLabelRenderer::DrawInternal(Canvas &canvas,
                                     const AirspaceWarningConfig &config)
 {
   AirspaceLabelList labels;
-  for (const auto &i : airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
-                                                   projection.GetScreenDistanceMeters())) {
+  for (const auto &i : database.QueryWithinRange(projection.GetGeoScreenCenter(),
+                                                 projection.GetScreenDistanceMeters())) {
     const AbstractAirspace &airspace = i.GetAirspace();
     if (visible(airspace))
       labels.Add(airspace.GetCenter(), airspace.GetType(), airspace.GetBase(),
@@ -38,6 +38,7 @@ struct AirspaceComputerSettings;
 struct AirspaceRendererSettings;
 struct AirspaceWarningConfig;
 class Airspaces;
+class AirspacesSnapshot;
 class AirspacePredicate;
 class ProtectedAirspaceWarningManager;
 class AirspaceWarningCopy;
@@ -94,6 +95,7 @@ private:
 #ifndef ENABLE_OPENGL
                     Canvas &stencil_canvas,
 #endif
+                    const AirspacesSnapshot &database,
                     const WindowProjection &projection,
                     const AirspaceRendererSettings &settings,
                     const AirspaceWarningCopy &awc,
@@ -30,6 +30,7 @@ Copyright_License {
 #include "Airspace/AirspaceWarning.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
 #include "Airspace/AirspaceWarningCopy.hpp"
+#include "Airspace/AirspaceState.hpp"
 #include "Engine/Airspace/AirspaceWarningManager.hpp"
 #include "NMEA/Aircraft.hpp"
 
@@ -64,28 +65,49 @@ AirspaceRenderer::DrawIntersections(Canvas &canvas,
   }
 }
 
-void
+inline void
 AirspaceRenderer::Draw(Canvas &canvas,
 #ifndef ENABLE_OPENGL
                        Canvas &stencil_canvas,
 #endif
+                       const AirspacesSnapshot &database,
                        const WindowProjection &projection,
                        const AirspaceRendererSettings &settings,
                        const AirspaceWarningCopy &awc,
                        const AirspacePredicate &visible)
 {
-  if (airspaces == nullptr || airspaces->IsEmpty())
+  if (database.IsEmpty())
     return;
 
   DrawInternal(canvas,
 #ifndef ENABLE_OPENGL
                stencil_canvas,
 #endif
-               projection, settings, awc, visible);
+               database, projection, settings, awc, visible);
 
   intersections = awc.GetLocations();
 }
 
+void
+AirspaceRenderer::Draw(Canvas &canvas,
+#ifndef ENABLE_OPENGL
+                       Canvas &stencil_canvas,
+#endif
+                       const WindowProjection &projection,
+                       const AirspaceRendererSettings &settings,
+                       const AirspaceWarningCopy &awc,
+                       const AirspacePredicate &visible)
+{
+  if (airspaces == nullptr || airspaces->IsEmpty())
+    return;
+
+  Draw(canvas,
+#ifndef ENABLE_OPENGL
+       stencil_canvas,
+#endif
+       airspaces->GetCurrentSnapshot(), projection, settings, awc, visible);
+}
+
 void
 AirspaceRenderer::Draw(Canvas &canvas,
 #ifndef ENABLE_OPENGL
@@ -97,6 +119,21 @@ AirspaceRenderer::Draw(Canvas &canvas,
   if (airspaces == nullptr)
     return;
 
+  if (warning_manager != nullptr) {
+    /* draw from the state published by the calculation thread; this
+       saves copying the warnings and locking for each airspace */
+    const ProtectedAirspaceWarningManager::StateLease state(*warning_manager);
+    if (state.IsDefined()) {
+      Draw(canvas,
+#ifndef ENABLE_OPENGL
+           stencil_canvas,
+#endif
+           *state->airspaces, projection, settings, state->warnings,
+           AirspacePredicateTrue());
+      return;
+    }
+  }
+
   AirspaceWarningCopy awc;
   if (warning_manager != nullptr)
     awc.Visit(*warning_manager);
@@ -122,11 +159,27 @@ AirspaceRenderer::Draw(Canvas &canvas,
   if (airspaces == nullptr)
     return;
 
+  const AircraftState aircraft = ToAircraftState(basic, calculated);
+
+  if (warning_manager != nullptr) {
+    const ProtectedAirspaceWarningManager::StateLease state(*warning_manager);
+    if (state.IsDefined()) {
+      const AirspaceMapVisible visible(computer_settings, settings,
+                                       aircraft, state->warnings);
+      Draw(canvas,
+#ifndef ENABLE_OPENGL
+           stencil_canvas,
+#endif
+           *state->airspaces, projection, settings, state->warnings,
+           visible);
+      return;
+    }
+  }
+
   AirspaceWarningCopy awc;
   if (warning_manager != nullptr)
     awc.Visit(*warning_manager);
 
-  const AircraftState aircraft = ToAircraftState(basic, calculated);
   const AirspaceMapVisible visible(computer_settings, settings,
                                    aircraft, awc);
   Draw(canvas,
@@ -37,9 +37,11 @@ struct DerivedInfo;
 struct AirspaceComputerSettings;
 struct AirspaceRendererSettings;
 class Airspaces;
+class AirspacesSnapshot;
 class AirspacePredicate;
 class ProtectedAirspaceWarningManager;
 class AirspaceWarningCopy;
+struct AirspaceState;
 class Canvas;
 class WindowProjection;
 
@@ -104,6 +106,7 @@ public:
 private:
 #ifndef ENABLE_OPENGL
   bool DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
+                const AirspacesSnapshot &database,
                 const WindowProjection &projection,
                 const AirspaceRendererSettings &settings,
                 const AirspaceWarningCopy &awc,
@@ -111,12 +114,14 @@ private:
 
   void DrawFillCached(Canvas &canvas,
                       Canvas &stencil_canvas,
+                      const AirspacesSnapshot &database,
                       const WindowProjection &projection,
                       const AirspaceRendererSettings &settings,
                       const AirspaceWarningCopy &awc,
                       const AirspacePredicate &visible);
 
   void DrawOutline(Canvas &canvas,
+                   const AirspacesSnapshot &database,
                    const WindowProjection &projection,
                    const AirspaceRendererSettings &settings,
                    const AirspacePredicate &visible) const;
@@ -126,11 +131,22 @@ private:
 #ifndef ENABLE_OPENGL
                     Canvas &stencil_canvas,
 #endif
+                    const AirspacesSnapshot &database,
                     const WindowProjection &projection,
                     const AirspaceRendererSettings &settings,
                     const AirspaceWarningCopy &awc,
                     const AirspacePredicate &visible);
 
+  void Draw(Canvas &canvas,
+#ifndef ENABLE_OPENGL
+            Canvas &stencil_canvas,
+#endif
+            const AirspacesSnapshot &database,
+            const WindowProjection &projection,
+            const AirspaceRendererSettings &settings,
+            const AirspaceWarningCopy &awc,
+            const AirspacePredicate &visible);
+
 public:
   /**
    * Draw airspaces selected by the given #AirspacePredicate.
@@ -308,14 +308,15 @@ private:
 
 void
 AirspaceRenderer::DrawInternal(Canvas &canvas,
+                               const AirspacesSnapshot &database,
                                const WindowProjection &projection,
                                const AirspaceRendererSettings &settings,
                                const AirspaceWarningCopy &awc,
                                const AirspacePredicate &visible)
 {
   const auto range =
-    airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
-                                projection.GetScreenDistanceMeters());
+    database.QueryWithinRange(projection.GetGeoScreenCenter(),
+                              projection.GetScreenDistanceMeters());
 
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
@@ -212,6 +212,7 @@ public:
 
 inline bool
 AirspaceRenderer::DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
+                           const AirspacesSnapshot &database,
                            const WindowProjection &projection,
                            const AirspaceRendererSettings &settings,
                            const AirspaceWarningCopy &awc,
@@ -226,8 +227,8 @@ AirspaceRenderer::DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
   // we are using two draws so borders go on top of everything
 
   const auto range =
-    airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
-                                projection.GetScreenDistanceMeters());
+    database.QueryWithinRange(projection.GetGeoScreenCenter(),
+                              projection.GetScreenDistanceMeters());
   for (const auto &i : range) {
     const AbstractAirspace &airspace = i.GetAirspace();
     if (visible(airspace))
@@ -239,6 +240,7 @@ AirspaceRenderer::DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
 
 inline void
 AirspaceRenderer::DrawFillCached(Canvas &canvas, Canvas &stencil_canvas,
+                                 const AirspacesSnapshot &database,
                                  const WindowProjection &projection,
                                  const AirspaceRendererSettings &settings,
                                  const AirspaceWarningCopy &awc,
@@ -249,8 +251,8 @@ AirspaceRenderer::DrawFillCached(Canvas &canvas, Canvas &stencil_canvas,
     last_warning_serial = awc.GetSerial();
 
     Canvas &buffer_canvas = fill_cache.Begin(canvas, projection);
-    if (DrawFill(buffer_canvas, stencil_canvas,
-                                projection, settings, awc, visible))
+    if (DrawFill(buffer_canvas, stencil_canvas, database,
+                 projection, settings, awc, visible))
       fill_cache.Commit(canvas, projection);
     else
       fill_cache.CommitEmpty();
@@ -272,13 +274,14 @@ AirspaceRenderer::DrawFillCached(Canvas &canvas, Canvas &stencil_canvas,
 
 inline void
 AirspaceRenderer::DrawOutline(Canvas &canvas,
+                              const AirspacesSnapshot &database,
                               const WindowProjection &projection,
                               const AirspaceRendererSettings &settings,
                               const AirspacePredicate &visible) const
 {
   const auto range =
-    airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
-                                projection.GetScreenDistanceMeters());
+    database.QueryWithinRange(projection.GetGeoScreenCenter(),
+                              projection.GetScreenDistanceMeters());
 
   AirspaceOutlineRenderer outline_renderer(canvas, projection, look, settings);
   for (const auto &i : range) {
@@ -290,15 +293,17 @@ AirspaceRenderer::DrawOutline(Canvas &canvas,
 
 void
 AirspaceRenderer::DrawInternal(Canvas &canvas, Canvas &stencil_canvas,
+                               const AirspacesSnapshot &database,
                                const WindowProjection &projection,
                                const AirspaceRendererSettings &settings,
                                const AirspaceWarningCopy &awc,
                                const AirspacePredicate &visible)
 {
   if (settings.fill_mode != AirspaceRendererSettings::FillMode::NONE)
-    DrawFillCached(canvas, stencil_canvas, projection, settings, awc, visible);
+    DrawFillCached(canvas, stencil_canvas, database,
+                   projection, settings, awc, visible);
 
-  DrawOutline(canvas, projection, settings, visible);
+  DrawOutline(canvas, database, projection, settings, visible);
 }
 
 #endif /* ENABLE_OPENGL */
@@ -45,6 +45,7 @@ Copyright_License {
 #include "Renderer/MapScaleRenderer.hpp"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 #include "Computer/Settings.hpp"
+#include "Util/StringAPI.hxx"
 
 #include <algorithm>
 
@@ -239,6 +240,14 @@ FlightStatisticsRenderer::CaptionOLC(TCHAR *sTmp,
                        FormatSignedTimeHHMM((int)result_olc.time).c_str(),
                        _("Speed"),
                        FormatUserTaskSpeed(result_olc.GetSpeed()).c_str());
+
+    /* while the solver is still searching, show how far the score
+       may improve */
+    const double score_bound = derived.contest_stats.score_bound[
+      derived.contest_stats.GetBestIndex(result_index)];
+    if (score_bound > result_olc.score)
+      StringFormatUnsafe(sTmp + StringLength(sTmp), _T("%s: %.1f %s\r\n"),
+                         _("Max. score"), score_bound, _("pts"));
   }
 }
 
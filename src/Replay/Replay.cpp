@@ -76,7 +76,7 @@ Replay::Start(Path _path)
     cli = new CatmullRomInterpolator(0.98);
     cli->Reset();
   } else {
-    replay = new NmeaReplay(std::make_unique<FileLineReaderA>(path),
+    replay = new NmeaReplay(OpenFileLineReaderA(path),
                             CommonInterface::GetSystemSettings().devices[0]);
   }
 
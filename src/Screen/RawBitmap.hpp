@@ -26,6 +26,7 @@
 #include <memory>
 #endif
 
+#include <assert.h>
 #include <stdint.h>
 
 class Canvas;
@@ -161,6 +162,19 @@ public:
 #endif
   }
 
+  /**
+   * Returns a pointer to the specified row, counting from the top.
+   */
+  RawColor *GetRow(unsigned y) {
+    assert(y < height);
+
+#ifndef USE_GDI
+    return GetBuffer() + y * corrected_width;
+#else
+    return GetBuffer() + (height - 1 - y) * corrected_width;
+#endif
+  }
+
   /**
    * Returns a pointer to the row below the current one.
    */
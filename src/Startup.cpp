@@ -443,6 +443,7 @@ Startup()
 
   if (computer_settings.logger.enable_nmea_logger)
     NMEALogger::enabled = true;
+  NMEALogger::compress = computer_settings.logger.compress_nmea_logger;
 
   LogFormat("ProgramStarted");
 
@@ -57,6 +57,10 @@ public:
     return planner.IsTerrainReachEmpty();
   }
 
+  const Serial &GetReachSerial() const {
+    return planner.GetReachSerial();
+  }
+
   void ClearReach() {
     planner.ClearReach();
   }
@@ -88,6 +92,10 @@ public:
     planner.AcceptInRange(bounds, visitor, working);
   }
 
+  void AcceptTerrainReachRoot(FlatTriangleFanVisitor &visitor) const {
+    planner.AcceptTerrainReachRoot(visitor);
+  }
+
   gcc_pure
   GeoPoint Intersection(const AGeoPoint &origin,
                         const AGeoPoint &destination) const;
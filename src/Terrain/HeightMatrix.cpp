@@ -30,7 +30,11 @@ Copyright_License {
 #include "Projection/WindowProjection.hpp"
 #endif
 
+#include <algorithm>
+
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 void
 HeightMatrix::SetSize(size_t _size)
@@ -75,6 +79,72 @@ HeightMatrix::Fill(const RasterMap &map, const GeoBounds &bounds,
   }
 }
 
+void
+HeightMatrix::Scroll(const RasterMap &map, const GeoBounds &bounds,
+                     int dx, int dy, bool interpolate)
+{
+  assert(width >= 2 && height >= 2);
+  assert(unsigned(std::abs(dx)) < width);
+  assert(unsigned(std::abs(dy)) < height);
+
+  const unsigned keep_width = width - std::abs(dx);
+  const unsigned src_x = std::max(dx, 0), dest_x = std::max(-dx, 0);
+
+  /* move the rows which remain visible; the iteration direction
+     makes sure that no row gets overwritten before it is copied */
+
+  if (dy >= 0) {
+    for (unsigned y = 0; y + dy < height; ++y)
+      memmove(data.begin() + y * width + dest_x,
+              data.begin() + (y + dy) * width + src_x,
+              keep_width * sizeof(data[0]));
+  } else {
+    for (unsigned y = height - 1; y >= unsigned(-dy); --y)
+      memmove(data.begin() + y * width + dest_x,
+              data.begin() + (y + dy) * width + src_x,
+              keep_width * sizeof(data[0]));
+  }
+
+  /* scan the exposed parts; the coordinates are calculated just like
+     in Fill(), so the samples are taken at the same positions */
+
+  const Angle delta_x = bounds.GetWidth() / (width - 1);
+  const Angle delta_y = bounds.GetHeight() / height;
+
+  const unsigned row_start = dy > 0 ? height - dy : height;
+  const unsigned row_end = dy < 0 ? unsigned(-dy) : 0;
+
+  /* the column strip has at least 2 samples, because
+     RasterMap::ScanLine() needs two distinct end points; this may
+     rescan one column which was just moved */
+  unsigned column_start = 0, column_end = 0;
+  if (dx > 0) {
+    column_start = std::min(width - dx, width - 2);
+    column_end = width;
+  } else if (dx < 0) {
+    column_start = 0;
+    column_end = std::max(unsigned(-dx), 2u);
+  }
+
+  for (unsigned y = 0; y < height; ++y) {
+    const Angle latitude = bounds.GetNorth() - delta_y * y;
+    TerrainHeight *p = data.begin() + y * width;
+
+    if (y >= row_start || y < row_end) {
+      map.ScanLine(GeoPoint(bounds.GetWest(), latitude),
+                   GeoPoint(bounds.GetEast(), latitude),
+                   p, width, interpolate);
+    } else if (column_start < column_end) {
+      map.ScanLine(GeoPoint(bounds.GetWest() + delta_x * column_start,
+                            latitude),
+                   GeoPoint(bounds.GetWest() + delta_x * (column_end - 1),
+                            latitude),
+                   p + column_start, column_end - column_start,
+                   interpolate);
+    }
+  }
+}
+
 #else
 
 void
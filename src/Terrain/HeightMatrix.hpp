@@ -57,6 +57,19 @@ public:
    */
   void Fill(const RasterMap &map, const GeoBounds &bounds,
             unsigned _width, unsigned _height, bool interpolate);
+
+  /**
+   * Move the existing values by the given number of columns and
+   * rows, and copy only the newly exposed parts from the #RasterMap.
+   * The size of the matrix remains unchanged.
+   *
+   * @param bounds the new bounds; this must be the previous bounds
+   * translated by exactly #dx columns and #dy rows
+   * @param dx the number of columns the bounds have moved east
+   * @param dy the number of rows the bounds have moved south
+   */
+  void Scroll(const RasterMap &map, const GeoBounds &bounds,
+              int dx, int dy, bool interpolate);
 #else
   /**
    * @param interpolate true enables interpolation of sub-pixel values
@@ -0,0 +1,92 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_INTERPOLATE_HPP
+#define XCSOAR_TERRAIN_INTERPOLATE_HPP
+
+#include "InterpolationBatch.hpp"
+#include "Compiler.h"
+
+#include <assert.h>
+
+/**
+ * Portable (but slow) implementation of the bilinear interpolation
+ * kernel.  If one of the four pixels is "special", the top left one
+ * is returned.
+ */
+gcc_hot
+static inline void
+PortableInterpolate(const InterpolationBatch &batch,
+                    TerrainHeight *gcc_restrict dest, unsigned n)
+{
+  assert(n <= InterpolationBatch::N);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const TerrainHeight a(batch.a[i]), b(batch.b[i]),
+      c(batch.c[i]), d(batch.d[i]);
+
+    if (a.IsSpecial() || b.IsSpecial() || c.IsSpecial() || d.IsSpecial()) {
+      dest[i] = a;
+      continue;
+    }
+
+    const unsigned ix = batch.ix[i], iy = batch.iy[i];
+    const unsigned kx = 0x100 - ix, ky = 0x100 - iy;
+
+    dest[i] = TerrainHeight((a.GetValue() * kx * ky
+                             + b.GetValue() * ix * ky
+                             + c.GetValue() * kx * iy
+                             + d.GetValue() * ix * iy) >> 16);
+  }
+}
+
+#if defined(__SSE2__)
+#include "InterpolateSSE2.hpp"
+#elif defined(__ARM_NEON__)
+#include "InterpolateNEON.hpp"
+#endif
+
+/**
+ * Calculate the first #n samples of the batch, using SIMD
+ * instructions if available.
+ */
+static inline void
+Interpolate(const InterpolationBatch &batch,
+            TerrainHeight *gcc_restrict dest, unsigned n)
+{
+#if defined(__SSE2__)
+  if (n == InterpolationBatch::N) {
+    SSE2Interpolate(batch, dest);
+    return;
+  }
+#elif defined(__ARM_NEON__)
+  if (n == InterpolationBatch::N) {
+    NEONInterpolate(batch, dest);
+    return;
+  }
+#endif
+
+  PortableInterpolate(batch, dest, n);
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_INTERPOLATE_NEON_HPP
+#define XCSOAR_TERRAIN_INTERPOLATE_NEON_HPP
+
+#include "InterpolationBatch.hpp"
+#include "Compiler.h"
+
+#ifndef __ARM_NEON__
+#error ARM NEON required
+#endif
+
+#include <arm_neon.h>
+
+/**
+ * Calculate 4 lanes of the bilinear interpolation.
+ */
+gcc_always_inline
+static inline int16x4_t
+NEONInterpolate4(int16x4_t a, int16x4_t b, int16x4_t c, int16x4_t d,
+                 int16x4_t ix, int16x4_t iy)
+{
+  const int16x4_t one = vdup_n_s16(0x100);
+  const int16x4_t kx = vsub_s16(one, ix);
+  const int16x4_t ky = vsub_s16(one, iy);
+
+  const int32x4_t top = vmlal_s16(vmull_s16(a, kx), b, ix);
+  const int32x4_t bottom = vmlal_s16(vmull_s16(c, kx), d, ix);
+
+  const int32x4_t sum = vmlaq_s32(vmulq_s32(top, vmovl_s16(ky)),
+                                  bottom, vmovl_s16(iy));
+  return vmovn_s32(vshrq_n_s32(sum, 16));
+}
+
+/**
+ * Implementation of Interpolate() using ARM NEON instructions.  The
+ * results are bit-exact with PortableInterpolate().
+ */
+gcc_hot
+static inline void
+NEONInterpolate(const InterpolationBatch &batch,
+                TerrainHeight *gcc_restrict dest)
+{
+  static_assert(InterpolationBatch::N == 8, "Wrong batch size");
+
+  const int16x8_t a = vld1q_s16(batch.a);
+  const int16x8_t b = vld1q_s16(batch.b);
+  const int16x8_t c = vld1q_s16(batch.c);
+  const int16x8_t d = vld1q_s16(batch.d);
+  const int16x8_t ix = vld1q_s16(batch.ix);
+  const int16x8_t iy = vld1q_s16(batch.iy);
+
+  const int16x8_t r =
+    vcombine_s16(NEONInterpolate4(vget_low_s16(a), vget_low_s16(b),
+                                  vget_low_s16(c), vget_low_s16(d),
+                                  vget_low_s16(ix), vget_low_s16(iy)),
+                 NEONInterpolate4(vget_high_s16(a), vget_high_s16(b),
+                                  vget_high_s16(c), vget_high_s16(d),
+                                  vget_high_s16(ix), vget_high_s16(iy)));
+
+  /* if one of the four pixels is special, return the top left one */
+  const int16x8_t threshold = vdupq_n_s16(-30000);
+  const uint16x8_t special =
+    vorrq_u16(vorrq_u16(vcleq_s16(a, threshold), vcleq_s16(b, threshold)),
+              vorrq_u16(vcleq_s16(c, threshold), vcleq_s16(d, threshold)));
+
+  vst1q_s16((int16_t *)dest, vbslq_s16(special, a, r));
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_INTERPOLATE_SSE2_HPP
+#define XCSOAR_TERRAIN_INTERPOLATE_SSE2_HPP
+
+#include "InterpolationBatch.hpp"
+#include "Compiler.h"
+
+#ifndef __SSE2__
+#error SSE2 required
+#endif
+
+#include <emmintrin.h>
+
+/**
+ * Calculate "top*ky + bottom*iy" for 4 lanes.  SSE2 has no 32 bit
+ * multiplication, therefore the 32 bit operands are split into a
+ * high part (which fits into 16 bits) and an 8 bit low part, and
+ * each is multiplied with _mm_madd_epi16().
+ */
+gcc_always_inline
+static inline __m128i
+SSE2BlendVertical(__m128i top, __m128i bottom, __m128i weights)
+{
+  const __m128i low_mask = _mm_set1_epi32(0xff);
+
+  __m128i high = _mm_packs_epi32(_mm_srai_epi32(top, 8),
+                                 _mm_srai_epi32(bottom, 8));
+  __m128i low = _mm_packs_epi32(_mm_and_si128(top, low_mask),
+                                _mm_and_si128(bottom, low_mask));
+
+  /* interleave top/bottom so madd can combine them */
+  high = _mm_unpacklo_epi16(high, _mm_srli_si128(high, 8));
+  low = _mm_unpacklo_epi16(low, _mm_srli_si128(low, 8));
+
+  __m128i sum = _mm_add_epi32(_mm_slli_epi32(_mm_madd_epi16(high, weights), 8),
+                              _mm_madd_epi16(low, weights));
+  return _mm_srai_epi32(sum, 16);
+}
+
+/**
+ * Implementation of Interpolate() using Intel SSE2 instructions.
+ * The results are bit-exact with PortableInterpolate().
+ */
+gcc_hot
+static inline void
+SSE2Interpolate(const InterpolationBatch &batch,
+                TerrainHeight *gcc_restrict dest)
+{
+  static_assert(InterpolationBatch::N == 8, "Wrong batch size");
+
+  const __m128i a = _mm_load_si128((const __m128i *)batch.a);
+  const __m128i b = _mm_load_si128((const __m128i *)batch.b);
+  const __m128i c = _mm_load_si128((const __m128i *)batch.c);
+  const __m128i d = _mm_load_si128((const __m128i *)batch.d);
+  const __m128i ix = _mm_load_si128((const __m128i *)batch.ix);
+  const __m128i iy = _mm_load_si128((const __m128i *)batch.iy);
+
+  const __m128i one = _mm_set1_epi16(0x100);
+  const __m128i kx = _mm_sub_epi16(one, ix);
+  const __m128i ky = _mm_sub_epi16(one, iy);
+
+  /* horizontal: a*kx + b*ix and c*kx + d*ix, 32 bit */
+  const __m128i wx_lo = _mm_unpacklo_epi16(kx, ix);
+  const __m128i wx_hi = _mm_unpackhi_epi16(kx, ix);
+  const __m128i top_lo = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), wx_lo);
+  const __m128i top_hi = _mm_madd_epi16(_mm_unpackhi_epi16(a, b), wx_hi);
+  const __m128i bottom_lo = _mm_madd_epi16(_mm_unpacklo_epi16(c, d), wx_lo);
+  const __m128i bottom_hi = _mm_madd_epi16(_mm_unpackhi_epi16(c, d), wx_hi);
+
+  /* vertical */
+  const __m128i r_lo = SSE2BlendVertical(top_lo, bottom_lo,
+                                         _mm_unpacklo_epi16(ky, iy));
+  const __m128i r_hi = SSE2BlendVertical(top_hi, bottom_hi,
+                                         _mm_unpackhi_epi16(ky, iy));
+
+  /* the result is always within the range of the inputs, therefore
+     saturation does not happen */
+  const __m128i r = _mm_packs_epi32(r_lo, r_hi);
+
+  /* if one of the four pixels is special, return the top left one */
+  const __m128i threshold = _mm_set1_epi16(-29999);
+  const __m128i special =
+    _mm_or_si128(_mm_or_si128(_mm_cmplt_epi16(a, threshold),
+                              _mm_cmplt_epi16(b, threshold)),
+                 _mm_or_si128(_mm_cmplt_epi16(c, threshold),
+                              _mm_cmplt_epi16(d, threshold)));
+
+  const __m128i result = _mm_or_si128(_mm_and_si128(special, a),
+                                      _mm_andnot_si128(special, r));
+  _mm_storeu_si128((__m128i *)dest, result);
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_INTERPOLATION_BATCH_HPP
+#define XCSOAR_TERRAIN_INTERPOLATION_BATCH_HPP
+
+#include "Height.hpp"
+
+#include <assert.h>
+#include <stdint.h>
+
+/**
+ * A batch of samples for bilinear interpolation.  For each sample,
+ * the caller gathers the four neighbouring pixels and the fractional
+ * position (0..255) between them; Interpolate() then calculates all
+ * samples at once.
+ */
+struct InterpolationBatch {
+  static constexpr unsigned N = 8;
+
+  /**
+   * The top left, top right, bottom left and bottom right pixels.
+   */
+  alignas(16) int16_t a[N], b[N], c[N], d[N];
+
+  /**
+   * The fractional position in the range 0..255.
+   */
+  alignas(16) int16_t ix[N], iy[N];
+
+  void Set(unsigned i, const TerrainHeight *top, unsigned dx, unsigned dy,
+           unsigned _ix, unsigned _iy) {
+    assert(i < N);
+    assert(_ix < 0x100);
+    assert(_iy < 0x100);
+
+    a[i] = top->GetValue();
+    b[i] = top[dx].GetValue();
+    c[i] = top[dy].GetValue();
+    d[i] = top[dx + dy].GetValue();
+    ix[i] = _ix;
+    iy[i] = _iy;
+  }
+};
+
+#endif
@@ -23,12 +23,16 @@ Copyright_License {
 
 #include "Loader.hpp"
 #include "RasterTileCache.hpp"
+#include "RasterTileStore.hpp"
 #include "RasterProjection.hpp"
+#include "Prefetch.hpp"
 #include "ZzipStream.hpp"
 #include "WorldFile.hpp"
 #include "Operation/Operation.hpp"
 #include "OS/ConvertPathName.hpp"
 
+#include <algorithm>
+
 extern "C" {
 #include "jasper/jp2/jp2_cod.h"
 #include "jasper/jpc/jpc_dec.h"
@@ -309,14 +313,22 @@ LoadTerrainOverview(struct zzip_dir *dir,
 
 inline bool
 TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
-                           int x, int y, unsigned radius)
+                           int x, int y, unsigned radius,
+                           ConstBuffer<RasterLocation> prefetch)
 {
   assert(!scan_overview);
 
-  if (!raster_tile_cache.PollTiles(x, y, radius))
+  if (!raster_tile_cache.PollTiles(x, y, radius, prefetch))
     /* nothing to do */
     return true;
 
+  if (store != nullptr) {
+    const ScopeExclusiveLock lock(mutex);
+    if (!raster_tile_cache.PutStoredTiles(*store))
+      /* all tiles were served from the store; no need to decode */
+      return true;
+  }
+
   bool success = LoadJPG2000(dir, path);
   raster_tile_cache.FinishTileUpdate();
   return success;
@@ -325,25 +337,103 @@ TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
 bool
 UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
-                   int x, int y, unsigned radius)
+                   int x, int y, unsigned radius,
+                   const RasterTileStore *store,
+                   ConstBuffer<RasterLocation> prefetch)
 {
   if (!raster_tile_cache.IsValid())
     return false;
 
   NullOperationEnvironment env;
-  TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
-  return loader.UpdateTiles(dir, path, x, y, radius);
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, env, store);
+  return loader.UpdateTiles(dir, path, x, y, radius, prefetch);
 }
 
 bool
 UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius)
+                   const GeoPoint &location, double radius,
+                   const RasterTileStore *store,
+                   const TerrainPrefetch *prefetch)
 {
   const auto raster_location = projection.ProjectCoarse(location);
 
+  StaticArray<RasterLocation, TerrainPrefetch::MAX_LOCATIONS> prefetch_locations;
+  if (prefetch != nullptr)
+    for (const auto &i : *prefetch)
+      prefetch_locations.append(projection.ProjectCoarse(i));
+
   return UpdateTerrainTiles(dir, path, raster_tile_cache, mutex,
                             raster_location.x, raster_location.y,
-                            projection.DistancePixelsCoarse(radius));
+                            projection.DistancePixelsCoarse(radius),
+                            store,
+                            {prefetch_locations.begin(),
+                             prefetch_locations.size()});
+}
+
+inline bool
+TerrainLoader::ConvertTiles(struct zzip_dir *dir, const char *path,
+                            RasterTileStoreWriter &writer)
+{
+  assert(!scan_overview);
+
+  /**
+   * The number of tiles decoded in one pass over the JPEG2000 file;
+   * limits the amount of memory needed for the conversion.
+   */
+  constexpr unsigned BATCH_SIZE = 64;
+
+  auto &tiles = raster_tile_cache.tiles;
+  const unsigned n_tiles = tiles.GetSize();
+
+  for (unsigned start = 0; start < n_tiles; start += BATCH_SIZE) {
+    const unsigned end = std::min(start + BATCH_SIZE, n_tiles);
+
+    bool any = false;
+    for (unsigned i = start; i < end; ++i) {
+      RasterTile &tile = tiles.GetLinear(i);
+      if (tile.IsDefined()) {
+        tile.SetRequest();
+        any = true;
+      }
+    }
+
+    if (!any)
+      continue;
+
+    if (!LoadJPG2000(dir, path))
+      return false;
+
+    for (unsigned i = start; i < end; ++i) {
+      RasterTile &tile = tiles.GetLinear(i);
+      if (tile.IsEnabled() && !writer.Put(i, tile.buffer))
+        return false;
+
+      tile.ClearRequest();
+      tile.Disable();
+    }
+
+    /* LoadJPG2000() has reset the progress range */
+    env.SetProgressRange(n_tiles);
+    env.SetProgressPosition(end);
+  }
+
+  return true;
+}
+
+bool
+ConvertTerrainTiles(struct zzip_dir *dir, const char *path,
+                    RasterTileCache &raster_tile_cache,
+                    RasterTileStoreWriter &writer,
+                    OperationEnvironment &env)
+{
+  if (!raster_tile_cache.IsValid())
+    return false;
+
+  /* fake a mutex - nobody else accesses the tile cache */
+  SharedMutex mutex;
+
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
+  return loader.ConvertTiles(dir, path, writer);
 }
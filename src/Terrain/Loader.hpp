@@ -25,12 +25,17 @@ Copyright_License {
 #define XCSOAR_TERRAIN_LOADER_HPP
 
 #include "Thread/SharedMutex.hpp"
+#include "RasterLocation.hpp"
+#include "Util/ConstBuffer.hxx"
 
 struct zzip_dir;
 struct GeoPoint;
 class RasterTileCache;
+class RasterTileStore;
+class RasterTileStoreWriter;
 class RasterProjection;
 class OperationEnvironment;
+class TerrainPrefetch;
 
 class TerrainLoader {
   SharedMutex &mutex;
@@ -41,6 +46,12 @@ class TerrainLoader {
 
   OperationEnvironment &env;
 
+  /**
+   * If not nullptr, then tiles are served from this store if
+   * possible, and JPEG2000 is only decoded for tiles missing there.
+   */
+  const RasterTileStore *const store;
+
   /**
    * The number of remaining segments after the current one.
    */
@@ -49,16 +60,20 @@ class TerrainLoader {
 public:
   TerrainLoader(SharedMutex &_mutex, RasterTileCache &_rtc,
                 bool _scan_overview, bool _scan_all,
-                OperationEnvironment &_env)
+                OperationEnvironment &_env,
+                const RasterTileStore *_store=nullptr)
     :mutex(_mutex), raster_tile_cache(_rtc),
      scan_overview(_scan_overview),
      scan_tiles(!_scan_overview || _scan_all),
-     env(_env) {}
+     env(_env), store(_store) {}
 
   bool LoadOverview(struct zzip_dir *dir,
                     const char *path, const char *world_file);
   bool UpdateTiles(struct zzip_dir *dir, const char *path,
-                   int x, int y, unsigned radius);
+                   int x, int y, unsigned radius,
+                   ConstBuffer<RasterLocation> prefetch);
+  bool ConvertTiles(struct zzip_dir *dir, const char *path,
+                    RasterTileStoreWriter &writer);
 
   /* callback methods for libjasper (via jas_rtc.cpp) */
 
@@ -104,34 +119,68 @@ LoadTerrainOverview(struct zzip_dir *dir,
                              tile_cache, false, env);
 }
 
+/**
+ * @param store an optional #RasterTileStore which is preferred over
+ * decoding the JPEG2000 file
+ * @param prefetch pixel locations where tiles will be needed soon,
+ * sorted by priority
+ */
 bool
 UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
-                   int x, int y, unsigned radius);
+                   int x, int y, unsigned radius,
+                   const RasterTileStore *store=nullptr,
+                   ConstBuffer<RasterLocation> prefetch=nullptr);
 
 static inline bool
 UpdateTerrainTiles(struct zzip_dir *dir,
                    RasterTileCache &tile_cache, SharedMutex &mutex,
-                   int x, int y, unsigned radius)
+                   int x, int y, unsigned radius,
+                   const RasterTileStore *store=nullptr,
+                   ConstBuffer<RasterLocation> prefetch=nullptr)
 {
   return UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
-                            x, y, radius);
+                            x, y, radius, store, prefetch);
 }
 
 bool
 UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius);
+                   const GeoPoint &location, double radius,
+                   const RasterTileStore *store=nullptr,
+                   const TerrainPrefetch *prefetch=nullptr);
 
 static inline bool
 UpdateTerrainTiles(struct zzip_dir *dir,
                    RasterTileCache &tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius)
+                   const GeoPoint &location, double radius,
+                   const RasterTileStore *store=nullptr,
+                   const TerrainPrefetch *prefetch=nullptr)
 {
   return UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
-                            projection, location, radius);
+                            projection, location, radius, store, prefetch);
+}
+
+/**
+ * Decode all tiles of the map and write them to a #RasterTileStore.
+ * The overview must have been loaded already.  This is a very
+ * expensive operation, meant to be run offline.
+ */
+bool
+ConvertTerrainTiles(struct zzip_dir *dir, const char *path,
+                    RasterTileCache &raster_tile_cache,
+                    RasterTileStoreWriter &writer,
+                    OperationEnvironment &env);
+
+static inline bool
+ConvertTerrainTiles(struct zzip_dir *dir,
+                    RasterTileCache &tile_cache,
+                    RasterTileStoreWriter &writer,
+                    OperationEnvironment &env)
+{
+  return ConvertTerrainTiles(dir, "terrain.jp2", tile_cache, writer, env);
 }
 
 #endif
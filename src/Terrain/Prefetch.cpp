@@ -0,0 +1,58 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Prefetch.hpp"
+#include "Geo/Math.hpp"
+#include "Math/Util.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+
+void
+TerrainPrefetch::AddTrack(const GeoPoint &location, Angle track,
+                          double ground_speed, double duration, unsigned n)
+{
+  assert(n > 0);
+
+  if (!location.IsValid() || ground_speed <= 0)
+    return;
+
+  const double step = ground_speed * duration / n;
+  for (unsigned i = 1; i <= n && !full(); ++i)
+    Add(FindLatitudeLongitude(location, track, step * i));
+}
+
+void
+TerrainPrefetch::AddLine(const GeoPoint &a, const GeoPoint &b, double step)
+{
+  assert(step > 0);
+
+  if (!a.IsValid() || !b.IsValid())
+    return;
+
+  const double distance = a.DistanceS(b);
+  const unsigned n = std::max(1u, uround(distance / step));
+  for (unsigned i = 0; i <= n && !full(); ++i)
+    Add(a.Interpolate(b, double(i) / n));
+}
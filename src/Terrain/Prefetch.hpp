@@ -0,0 +1,129 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_PREFETCH_HPP
+#define XCSOAR_TERRAIN_PREFETCH_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "Util/StaticArray.hxx"
+
+/**
+ * A list of locations where fine terrain tiles will be needed soon,
+ * e.g. along the predicted ground track, the active task legs and
+ * the reach boundary.  The list is sorted by priority: the first
+ * location is the most urgent one.
+ */
+class TerrainPrefetch {
+public:
+  static constexpr unsigned MAX_LOCATIONS = 64;
+
+private:
+  StaticArray<GeoPoint, MAX_LOCATIONS> locations;
+
+public:
+  typedef const GeoPoint *const_iterator;
+
+  void Clear() {
+    locations.clear();
+  }
+
+  bool empty() const {
+    return locations.empty();
+  }
+
+  bool full() const {
+    return locations.full();
+  }
+
+  unsigned size() const {
+    return locations.size();
+  }
+
+  const_iterator begin() const {
+    return locations.begin();
+  }
+
+  const_iterator end() const {
+    return locations.end();
+  }
+
+  const GeoPoint &front() const {
+    return locations.front();
+  }
+
+  /**
+   * Append one location with a lower priority than all previous
+   * ones.  Ignored if the list is full.
+   */
+  void Add(const GeoPoint &location) {
+    if (location.IsValid() && !locations.full())
+      locations.append(location);
+  }
+
+  /**
+   * Append locations along the predicted ground track.
+   *
+   * @param duration the prediction horizon in seconds
+   * @param n the number of locations to add
+   */
+  void AddTrack(const GeoPoint &location, Angle track, double ground_speed,
+                double duration, unsigned n);
+
+  /**
+   * Append locations along a straight line, including both ends.
+   *
+   * @param step the maximum distance between two locations in meters
+   */
+  void AddLine(const GeoPoint &a, const GeoPoint &b, double step);
+};
+
+/**
+ * Counters describing how well #TerrainPrefetch keeps ahead of the
+ * aircraft.
+ */
+struct TerrainPrefetchStatistics {
+  /**
+   * The number of tiles which were already loaded when a prefetch
+   * location first referred to them.  A tile which stays in the
+   * prefetch list over several polls is counted only once.
+   */
+  unsigned hits;
+
+  /**
+   * The number of tiles which were not loaded yet when a prefetch
+   * location first referred to them.
+   */
+  unsigned misses;
+
+  /**
+   * The number of tiles which were requested because of a prefetch
+   * location.
+   */
+  unsigned requested;
+
+  void Clear() {
+    hits = misses = requested = 0;
+  }
+};
+
+#endif
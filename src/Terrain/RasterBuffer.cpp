@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Terrain/RasterBuffer.hpp"
+#include "Terrain/Interpolate.hpp"
 #include "Math/FastMath.hpp"
 
 #include <algorithm>
@@ -33,6 +34,7 @@ RasterBuffer::Resize(unsigned _width, unsigned _height)
 {
   assert(_width > 0 && _height > 0);
 
+  external = nullptr;
   data.GrowDiscard(_width, _height);
 }
 
@@ -64,6 +66,19 @@ RasterBuffer::GetInterpolated(unsigned lx, unsigned ly,
                         + tm[dx + dy].GetValue() * ix * iy) >> 16);
 }
 
+inline void
+RasterBuffer::Gather(InterpolationBatch &batch, unsigned i,
+                     unsigned lx, unsigned ly,
+                     unsigned ix, unsigned iy) const
+{
+  assert(lx < GetWidth());
+  assert(ly < GetHeight());
+
+  const unsigned int dx = (lx == GetWidth() - 1) ? 0 : 1;
+  const unsigned int dy = (ly == GetHeight() - 1) ? 0 : GetWidth();
+  batch.Set(i, GetDataAt(lx, ly), dx, dy, ix, iy);
+}
+
 TerrainHeight
 RasterBuffer::GetInterpolated(unsigned lx, unsigned ly) const
 {
@@ -146,13 +161,23 @@ RasterBuffer::ScanHorizontalLine(unsigned ax, unsigned bx, unsigned y,
     unsigned cy = y;
     const unsigned int iy = CombinedDivAndMod(cy);
 
+    InterpolationBatch batch;
+    unsigned n = 0;
+
     --size;
     for (int i = 0; (unsigned)i <= size; ++i) {
       unsigned cx = ax + (i * dx) / (int)size;
       const unsigned int ix = CombinedDivAndMod(cx);
 
-      *buffer++ = GetInterpolated(cx, cy, ix, iy);
+      Gather(batch, n, cx, cy, ix, iy);
+      if (++n == InterpolationBatch::N) {
+        Interpolate(batch, buffer, n);
+        buffer += n;
+        n = 0;
+      }
     }
+
+    Interpolate(batch, buffer, n);
   } else if (gcc_likely(dx > 0)) {
     /* no interpolation needed, forward scan */
 
@@ -216,6 +241,9 @@ RasterBuffer::ScanLine(unsigned ax, unsigned ay, unsigned bx, unsigned by,
       (unsigned)(abs(dx) + abs(dy)) < (2 * size << RasterTraits::SUBPIXEL_BITS)) {
     /* interpolate */
 
+    InterpolationBatch batch;
+    unsigned n = 0;
+
     for (int i = 0; (unsigned)i <= size; ++i) {
       unsigned cx = ax + (i * dx) / (int)size;
       unsigned cy = ay + (i * dy) / (int)size;
@@ -223,8 +251,15 @@ RasterBuffer::ScanLine(unsigned ax, unsigned ay, unsigned bx, unsigned by,
       const unsigned int ix = CombinedDivAndMod(cx);
       const unsigned int iy = CombinedDivAndMod(cy);
 
-      *buffer++ = GetInterpolated(cx, cy, ix, iy);
+      Gather(batch, n, cx, cy, ix, iy);
+      if (++n == InterpolationBatch::N) {
+        Interpolate(batch, buffer, n);
+        buffer += n;
+        n = 0;
+      }
     }
+
+    Interpolate(batch, buffer, n);
   } else {
     /* no interpolation needed */
 
@@ -263,7 +298,7 @@ TerrainHeight
 RasterBuffer::GetMaximum() const
 {
   return IsDefined()
-    ? *std::max_element(data.begin(), data.end(),
+    ? *std::max_element(GetData(), GetData() + GetWidth() * GetHeight(),
                         [](TerrainHeight a, TerrainHeight b) {
                           return a.GetValue() < b.GetValue();
                         })
@@ -29,11 +29,22 @@ Copyright_License {
 #include "Util/AllocatedGrid.hxx"
 #include "Compiler.h"
 
+#include <assert.h>
 #include <stdint.h>
 
+struct InterpolationBatch;
+
 class RasterBuffer {
   AllocatedGrid<TerrainHeight> data;
 
+  /**
+   * If not nullptr, then this buffer refers to read-only memory owned
+   * by somebody else (e.g. a #RasterTileStore mapping), and #data is
+   * not used.
+   */
+  const TerrainHeight *external = nullptr;
+  unsigned external_width, external_height;
+
 public:
   RasterBuffer() = default;
   RasterBuffer(unsigned _width, unsigned _height)
@@ -43,15 +54,22 @@ public:
   RasterBuffer &operator=(const RasterBuffer &) = delete;
 
   bool IsDefined() const {
-    return data.IsDefined();
+    return external != nullptr || data.IsDefined();
+  }
+
+  /**
+   * Does this buffer refer to memory owned by somebody else?
+   */
+  bool IsExternal() const {
+    return external != nullptr;
   }
 
   unsigned GetWidth() const {
-    return data.GetWidth();
+    return external != nullptr ? external_width : data.GetWidth();
   }
 
   unsigned GetHeight() const {
-    return data.GetHeight();
+    return external != nullptr ? external_height : data.GetHeight();
   }
 
   unsigned GetFineWidth() const {
@@ -63,23 +81,45 @@ public:
   }
 
   TerrainHeight *GetData() {
+    assert(external == nullptr);
+
     return data.begin();
   }
 
   const TerrainHeight *GetData() const {
-    return data.begin();
+    return external != nullptr ? external : data.begin();
   }
 
   const TerrainHeight *GetDataAt(unsigned x, unsigned y) const {
-    return data.GetPointerAt(x, y);
+    assert(x < GetWidth());
+    assert(y < GetHeight());
+
+    return GetData() + y * GetWidth() + x;
   }
 
   void Reset() {
+    external = nullptr;
     data.Reset();
   }
 
   void Resize(unsigned _width, unsigned _height);
 
+  /**
+   * Refer to the given read-only pixels instead of owning a copy.
+   * The caller is responsible for keeping the memory alive until
+   * Reset() or Resize() is called.
+   */
+  void SetExternal(const TerrainHeight *_external,
+                   unsigned _width, unsigned _height) {
+    assert(_external != nullptr);
+    assert(_width > 0 && _height > 0);
+
+    data.Reset();
+    external = _external;
+    external_width = _width;
+    external_height = _height;
+  }
+
   gcc_pure
   TerrainHeight GetInterpolated(unsigned lx, unsigned ly,
                                 unsigned ix, unsigned iy) const;
@@ -93,6 +133,13 @@ public:
   }
 
 protected:
+  /**
+   * Copy the four pixels surrounding the given location into the
+   * specified slot of the #InterpolationBatch.
+   */
+  void Gather(InterpolationBatch &batch, unsigned i,
+              unsigned lx, unsigned ly, unsigned ix, unsigned iy) const;
+
   /**
    * Special optimized case for ScanLine(), for NorthUp rendering.
    */
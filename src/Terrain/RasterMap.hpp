@@ -84,6 +84,22 @@ public:
     return raster_tile_cache.GetSerial();
   }
 
+  /**
+   * Has the terrain within the specified bounds been modified after
+   * GetSerial() had the specified value?  Tiles loaded or discarded
+   * outside of the bounds are ignored.
+   */
+  gcc_pure
+  bool IsModifiedSince(unsigned serial, const GeoBounds &bounds) const {
+    const auto a = projection.ProjectCoarse(bounds.GetNorthWest());
+    const auto b = projection.ProjectCoarse(bounds.GetSouthEast());
+    return raster_tile_cache.IsModifiedSince(serial, a.x, a.y, b.x, b.y);
+  }
+
+  const TerrainPrefetchStatistics &GetPrefetchStatistics() const {
+    return raster_tile_cache.GetPrefetchStatistics();
+  }
+
   const RasterProjection &GetProjection() const {
     return projection;
   }
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Terrain/RasterRenderer.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Math/FastMath.hpp"
+#include "Math/Util.hpp"
 #include "Util/Clamp.hpp"
 #include "Screen/Ramp.hpp"
 #include "Screen/Layout.hpp"
@@ -36,6 +37,9 @@ Copyright_License {
 
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 /**
  * Interpolate between x and y with i/128, i.e. i/(1 << 7).
@@ -99,7 +103,8 @@ ContourInterval(const TerrainHeight h, const unsigned contour_height_scale)
   return ContourInterval(h.GetValue(), contour_height_scale);
 }
 
-RasterRenderer::RasterRenderer()
+RasterRenderer::RasterRenderer(WorkerPool &_pool)
+  :pool(_pool)
 {
   // scale quantisation_pixels so resolution is not too high on old hardware
   // with large displays
@@ -148,8 +153,69 @@ RasterRenderer::BindAndGetTexture() const
 
 #endif
 
+#ifdef ENABLE_OPENGL
+
+bool
+RasterRenderer::ScrollMap(const RasterMap &map,
+                          const WindowProjection &projection,
+                          unsigned width, unsigned height)
+{
+  if (!bounds.IsValid() ||
+      quantisation_pixels != last_quantisation_pixels ||
+      width != height_matrix.GetWidth() ||
+      height != height_matrix.GetHeight() ||
+      width < 2 || height < 2 ||
+      fabs(projection.GetScale() - last_scale) > last_scale * 1e-6)
+    return false;
+
+  /* the grid spacing used by HeightMatrix::Fill() */
+  const Angle delta_x = bounds.GetWidth() / (width - 1);
+  const Angle delta_y = bounds.GetHeight() / height;
+
+  /* move the old bounds by whole grid cells, so the center is close
+     to the new screen center; the size remains unchanged, which
+     keeps the resolution */
+  const GeoPoint old_center = bounds.GetCenter();
+  const GeoPoint new_center = projection.GetScreenBounds().GetCenter();
+  const int dx = iround((new_center.longitude - old_center.longitude).Native()
+                        / delta_x.Native());
+  const int dy = iround((old_center.latitude - new_center.latitude).Native()
+                        / delta_y.Native());
+  if (unsigned(abs(dx)) >= width || unsigned(abs(dy)) >= height)
+    /* nothing to keep */
+    return false;
+
+  const GeoBounds new_bounds(GeoPoint(bounds.GetWest() + delta_x * dx,
+                                      bounds.GetNorth() - delta_y * dy),
+                             GeoPoint(bounds.GetEast() + delta_x * dx,
+                                      bounds.GetSouth() - delta_y * dy));
+
+  /* the moved bounds must still cover the visible part of the map,
+     and must not leave the map (a full scan would clip them) */
+  GeoBounds visible = projection.GetScreenBounds();
+  if (!visible.IntersectWith(map.GetBounds()) ||
+      !new_bounds.IsInside(visible) ||
+      !map.GetBounds().IsInside(new_bounds))
+    return false;
+
+  if (dx != 0 || dy != 0)
+    height_matrix.Scroll(map, new_bounds, dx, dy, true);
+
+  /* the image follows in the next GenerateImage() call */
+  image_dx += dx;
+  image_dy += dy;
+  if (unsigned(abs(image_dx)) >= width || unsigned(abs(image_dy)) >= height)
+    image_scrollable = false;
+
+  bounds = new_bounds;
+  return true;
+}
+
+#endif
+
 void
-RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection)
+RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection,
+                        bool incremental)
 {
   // Coordinates of the MapWindow center
   unsigned x = projection.GetScreenWidth() / 2;
@@ -186,17 +252,25 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
     quantisation_effective = 0;
 
 #ifdef ENABLE_OPENGL
-  bounds = projection.GetScreenBounds().Scale(1.5);
-  bounds.IntersectWith(map.GetBounds());
-
-  height_matrix.Fill(map, bounds,
-                     projection.GetScreenWidth() / quantisation_pixels,
-                     projection.GetScreenHeight() / quantisation_pixels,
-                     true);
+  const unsigned width = projection.GetScreenWidth() / quantisation_pixels;
+  const unsigned height = projection.GetScreenHeight() / quantisation_pixels;
+
+  if (incremental && ScrollMap(map, projection, width, height)) {
+    ++n_incremental_scans;
+  } else {
+    bounds = projection.GetScreenBounds().Scale(1.5);
+    bounds.IntersectWith(map.GetBounds());
+
+    height_matrix.Fill(map, bounds, width, height, true);
+    ++n_full_scans;
+    image_scrollable = false;
+  }
 
   last_quantisation_pixels = quantisation_pixels;
+  last_scale = projection.GetScale();
 #else
   height_matrix.Fill(map, projection, quantisation_pixels, true);
+  ++n_full_scans;
 #endif
 }
 
@@ -214,7 +288,12 @@ RasterRenderer::GenerateImage(bool do_shading,
     image = new RawBitmap(height_matrix.GetWidth(), height_matrix.GetHeight());
 
     delete[] contour_column_base;
-    contour_column_base = new unsigned char[height_matrix.GetWidth()];
+    contour_column_base = new unsigned char[height_matrix.GetWidth()
+                                            * GetMaxBands()];
+
+#ifdef ENABLE_OPENGL
+    image_scrollable = false;
+#endif
   }
 
   if (quantisation_effective == 0) {
@@ -224,33 +303,78 @@ RasterRenderer::GenerateImage(bool do_shading,
 
   const unsigned contour_height_scale = do_contour? height_scale * 2 : 16;
 
-  ContourStart(contour_height_scale);
+#ifdef ENABLE_OPENGL
+  const ImageParameters parameters{
+    do_shading, do_contour, height_scale, contrast, brightness, sunazimuth,
+    quantisation_effective, unsigned(pixel_size),
+  };
+
+  if (image_scrollable && parameters == last_image_parameters) {
+    ScrollImage(do_shading, height_scale, contrast, brightness, sunazimuth,
+                contour_height_scale);
+    image_dx = image_dy = 0;
+    ++n_incremental_images;
+    return;
+  }
+
+  last_image_parameters = parameters;
+  image_dx = image_dy = 0;
+  image_scrollable = true;
+#endif
+
+  ++n_full_images;
+
+  const unsigned n_bands =
+    Clamp(height_matrix.GetHeight() / MIN_BAND_HEIGHT, 1u, GetMaxBands());
+
+  ContourStart(contour_height_scale, do_shading, n_bands);
 
   if (do_shading)
     GenerateSlopeImage(height_scale, contrast, brightness,
-                       sunazimuth, contour_height_scale);
+                       sunazimuth, contour_height_scale, n_bands);
   else
-    GenerateUnshadedImage(height_scale, contour_height_scale);
+    GenerateUnshadedImage(height_scale, contour_height_scale, n_bands);
 
   image->SetDirty();
 }
 
 void
 RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
-                                      const unsigned contour_height_scale)
+                                      const unsigned contour_height_scale,
+                                      unsigned n_bands)
+{
+  pool.Run(n_bands, [this, height_scale, contour_height_scale,
+                     n_bands](unsigned band){
+      GenerateUnshadedImage(height_scale, contour_height_scale,
+                            0, height_matrix.GetWidth(),
+                            GetBandStart(band, n_bands),
+                            GetBandStart(band + 1, n_bands),
+                            GetContourColumnBase(band));
+    });
+}
+
+void
+RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
+                                      const unsigned contour_height_scale,
+                                      unsigned x_start, unsigned x_end,
+                                      unsigned y_start, unsigned y_end,
+                                      unsigned char *column_base)
 {
-  const auto *src = height_matrix.GetData();
   const RawColor *oColorBuf = color_table + 64 * 256;
-  RawColor *dest = image->GetTopRow();
+  RawColor *dest = image->GetRow(y_start) + x_start;
 
-  for (unsigned y = height_matrix.GetHeight(); y > 0; --y) {
+  for (unsigned y = y_start; y < y_end; ++y) {
+    const auto *src = height_matrix.GetRow(y) + x_start;
     RawColor *p = dest;
     dest = image->GetNextRow(dest);
 
-    unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+    /* continue with the contour state of the pixel left of the
+       rectangle */
+    unsigned contour_row_base =
+      ContourInterval(src[x_start > 0 ? -1 : 0], contour_height_scale);
+    unsigned char *contour_this_column_base = column_base + x_start;
 
-    for (unsigned x = height_matrix.GetWidth(); x > 0; --x) {
+    for (unsigned x = x_end - x_start; x > 0; --x) {
       const auto e = *src++;
       if (gcc_likely(!e.IsSpecial())) {
         unsigned h = std::max(0, (int)e.GetValue());
@@ -309,7 +433,10 @@ void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast,
                                    const int sx, const int sy, const int sz,
-                                   const unsigned contour_height_scale)
+                                   const unsigned contour_height_scale,
+                                   unsigned x_start, unsigned x_end,
+                                   unsigned y_start, unsigned y_end,
+                                   unsigned char *column_base)
 {
   assert(quantisation_effective > 0);
 
@@ -326,12 +453,13 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
              square will not overflow */
           8192u / (quantisation_effective * quantisation_effective));
 
-  const auto *src = height_matrix.GetData();
   const RawColor *oColorBuf = color_table + 64 * 256;
 
-  RawColor *dest = image->GetTopRow();
+  RawColor *dest = image->GetRow(y_start) + x_start;
+
+  for (unsigned y = y_start; y < y_end; ++y) {
+    const auto *src = height_matrix.GetRow(y) + x_start;
 
-  for (unsigned y = 0; y < height_matrix.GetHeight(); ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
       : height_matrix.GetHeight() - 1 - y;
@@ -346,10 +474,11 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
     RawColor *p = dest;
     dest = image->GetNextRow(dest);
 
-    unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+    unsigned contour_row_base =
+      ContourInterval(src[x_start > 0 ? -1 : 0], contour_height_scale);
+    unsigned char *contour_this_column_base = column_base + x_start;
 
-    for (unsigned x = 0; x < height_matrix.GetWidth(); ++x, ++src) {
+    for (unsigned x = x_start; x < x_end; ++x, ++src) {
       const auto e = *src;
       if (gcc_likely(!e.IsSpecial())) {
         unsigned h = std::max(0, (int)e.GetValue());
@@ -436,23 +565,145 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   }
 }
 
+/**
+ * The direction of the sun used for slope shading.
+ */
+struct SunVector {
+  int x, y, z;
+
+  SunVector(int brightness, const Angle sunazimuth) {
+    const Angle fudgeelevation = Angle::Degrees(10) +
+      Angle::Degrees(80.0 / 255.0) * brightness;
+
+    x = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
+    y = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
+    z = (int)(255 * fudgeelevation.fastsine());
+  }
+};
+
 void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast, int brightness,
                                    const Angle sunazimuth,
-                                   const unsigned contour_height_scale)
+                                   const unsigned contour_height_scale,
+                                   unsigned n_bands)
+{
+  const SunVector sun(brightness, sunazimuth);
+
+  pool.Run(n_bands, [=](unsigned band){
+      GenerateSlopeImage(height_scale, contrast,
+                         sun.x, sun.y, sun.z, contour_height_scale,
+                         0, height_matrix.GetWidth(),
+                         GetBandStart(band, n_bands),
+                         GetBandStart(band + 1, n_bands),
+                         GetContourColumnBase(band));
+    });
+}
+
+#ifdef ENABLE_OPENGL
+
+void
+RasterRenderer::GenerateRect(bool do_shading, unsigned height_scale,
+                             int contrast, int brightness,
+                             const Angle sunazimuth,
+                             const unsigned contour_height_scale,
+                             unsigned x_start, unsigned x_end,
+                             unsigned y_start, unsigned y_end)
+{
+  if (x_start >= x_end || y_start >= y_end)
+    return;
+
+  /* continue with the contour state of the row above */
+  const auto *src = height_matrix.GetRow(y_start > 0 ? y_start - 1 : 0);
+  for (unsigned x = x_start; x < x_end; ++x)
+    contour_column_base[x] = ContourInterval(src[x], contour_height_scale);
+
+  if (do_shading) {
+    const SunVector sun(brightness, sunazimuth);
+    GenerateSlopeImage(height_scale, contrast,
+                       sun.x, sun.y, sun.z, contour_height_scale,
+                       x_start, x_end, y_start, y_end,
+                       contour_column_base);
+  } else
+    GenerateUnshadedImage(height_scale, contour_height_scale,
+                          x_start, x_end, y_start, y_end,
+                          contour_column_base);
+}
+
+void
+RasterRenderer::ScrollImage(bool do_shading, unsigned height_scale,
+                            int contrast, int brightness,
+                            const Angle sunazimuth,
+                            const unsigned contour_height_scale)
 {
-  const Angle fudgeelevation = Angle::Degrees(10) +
-    Angle::Degrees(80.0 / 255.0) * brightness;
+  const int dx = image_dx, dy = image_dy;
+  if (dx == 0 && dy == 0)
+    /* nothing has moved */
+    return;
+
+  const unsigned width = height_matrix.GetWidth();
+  const unsigned height = height_matrix.GetHeight();
+
+  assert(unsigned(abs(dx)) < width);
+  assert(unsigned(abs(dy)) < height);
+
+  /* move the pixels which remain visible, just like
+     HeightMatrix::Scroll() does with the heights */
+
+  const unsigned keep_width = width - abs(dx);
+  const unsigned src_x = std::max(dx, 0), dest_x = std::max(-dx, 0);
+
+  if (dy >= 0) {
+    for (unsigned y = 0; y + dy < height; ++y)
+      memmove(image->GetRow(y) + dest_x, image->GetRow(y + dy) + src_x,
+              keep_width * sizeof(RawColor));
+  } else {
+    for (unsigned y = height - 1; y >= unsigned(-dy); --y)
+      memmove(image->GetRow(y) + dest_x, image->GetRow(y + dy) + src_x,
+              keep_width * sizeof(RawColor));
+  }
+
+  /* shade the exposed strips; the slope of a pixel depends on the
+     heights up to quantisation_effective cells away, and its contour
+     on the pixel before it, so this margin is added next to the
+     exposed strip and at the opposite edge, where the neighbours are
+     clipped now */
+
+  const unsigned margin = quantisation_effective + 1;
 
-  const int sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
-  const int sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
-  const int sz = (int)(255 * fudgeelevation.fastsine());
+  /* the strips at the top and bottom edges span the whole width */
 
-  GenerateSlopeImage(height_scale, contrast,
-                     sx, sy, sz, contour_height_scale);
+  const unsigned top = dy != 0
+    ? std::min(std::max(-dy, 0) + margin, height)
+    : 0;
+  const unsigned bottom = dy != 0
+    ? height - std::min(std::max(dy, 0) + margin, height - top)
+    : height;
+
+  GenerateRect(do_shading, height_scale, contrast, brightness, sunazimuth,
+               contour_height_scale, 0, width, 0, top);
+  GenerateRect(do_shading, height_scale, contrast, brightness, sunazimuth,
+               contour_height_scale, 0, width, bottom, height);
+
+  /* the strips at the left and right edges fill the rows in
+     between */
+
+  if (dx != 0) {
+    const unsigned left = std::min(std::max(-dx, 0) + margin, width);
+    const unsigned right =
+      width - std::min(std::max(dx, 0) + margin, width - left);
+
+    GenerateRect(do_shading, height_scale, contrast, brightness, sunazimuth,
+                 contour_height_scale, 0, left, top, bottom);
+    GenerateRect(do_shading, height_scale, contrast, brightness, sunazimuth,
+                 contour_height_scale, right, width, top, bottom);
+  }
+
+  image->SetDirty();
 }
 
+#endif
+
 void
 RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
                                   unsigned height_scale, int interp_levels)
@@ -460,6 +711,10 @@ RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
   if (color_table == nullptr)
     color_table = new RawColor[256 * 128];
 
+#ifdef ENABLE_OPENGL
+  image_scrollable = false;
+#endif
+
   for (int i = 0; i < 256; i++) {
     for (int mag = -64; mag < 64; mag++) {
       RawColor color;
@@ -487,14 +742,79 @@ RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
   }
 }
 
+bool
+RasterRenderer::HasSpecialNeighbour(unsigned x, unsigned y) const
+{
+  /* this must match the neighbour calculation in
+     GenerateSlopeImage() */
+  const unsigned width = height_matrix.GetWidth();
+  const unsigned height = height_matrix.GetHeight();
+  const unsigned q = quantisation_effective;
+
+  const unsigned row_plus_index = y < (unsigned)(int(height) - int(q))
+    ? q : height - 1 - y;
+  const unsigned row_minus_index = y >= q ? q : y;
+  const unsigned column_plus_index = x < (unsigned)(int(width) - int(q))
+    ? q : width - 1 - x;
+  const unsigned column_minus_index = x >= q ? q : x;
+
+  const auto *src = height_matrix.GetRow(y) + x;
+  return src[-int(row_minus_index * width)].IsSpecial() ||
+    src[row_plus_index * width].IsSpecial() ||
+    src[-int(column_minus_index)].IsSpecial() ||
+    src[column_plus_index].IsSpecial();
+}
+
 void
-RasterRenderer::ContourStart(const unsigned contour_height_scale)
+RasterRenderer::ContourStart(const unsigned contour_height_scale,
+                             bool do_shading, unsigned n_bands)
 {
+  const unsigned width = height_matrix.GetWidth();
+
   // initialise column to first row
   const auto *src = height_matrix.GetData();
   unsigned char *col_base = contour_column_base;
-  for (unsigned x = height_matrix.GetWidth(); x > 0; --x)
+  for (unsigned x = width; x > 0; --x)
     *col_base++ = ContourInterval(*src++, contour_height_scale);
+
+  if (n_bands == 1)
+    return;
+
+  /* each band continues with the contour state the previous band
+     has left behind, which is the contour interval of the bottom-most
+     pixel in each column which was not skipped; find it (backwards,
+     usually in the last row), or mark it with NO_CONTOUR if the whole
+     column was skipped */
+
+  constexpr unsigned char NO_CONTOUR = 0xff;
+
+  pool.Run(n_bands - 1, [=](unsigned band){
+      const unsigned y_start = GetBandStart(band, n_bands);
+      const unsigned y_end = GetBandStart(band + 1, n_bands);
+      unsigned char *last = GetContourColumnBase(band + 1);
+
+      for (unsigned x = 0; x < width; ++x) {
+        last[x] = NO_CONTOUR;
+
+        for (unsigned y = y_end; y-- > y_start;) {
+          const auto e = height_matrix.GetRow(y)[x];
+          if (!e.IsSpecial() &&
+              (!do_shading || !HasSpecialNeighbour(x, y))) {
+            last[x] = ContourInterval(e, contour_height_scale);
+            break;
+          }
+        }
+      }
+    });
+
+  for (unsigned band = 1; band < n_bands; ++band) {
+    const unsigned char *previous = GetContourColumnBase(band - 1);
+    unsigned char *current = GetContourColumnBase(band);
+
+    for (unsigned x = 0; x < width; ++x)
+      if (current[x] == NO_CONTOUR)
+        current[x] = previous[x];
+  }
 }
 
 void
@@ -25,9 +25,11 @@ Copyright_License {
 #define XCSOAR_RASTER_RENDERER_HPP
 
 #include "Terrain/HeightMatrix.hpp"
+#include "Thread/WorkerPool.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
+#include "Math/Angle.hpp"
 #endif
 
 #define NUM_COLOR_RAMP_LEVELS 13
@@ -69,11 +71,84 @@ class RasterRenderer {
    * texture has to be redrawn.
    */
   GeoBounds bounds = GeoBounds::Invalid();
+
+  /**
+   * The map scale of the last ScanMap() call.  The #HeightMatrix can
+   * only be scrolled if the scale has not changed.
+   */
+  double last_scale = 0;
+
+  /**
+   * The parameters which affect the colour of a pixel in the
+   * #RawBitmap.  If they are unchanged, the previous image can be
+   * scrolled together with the #HeightMatrix.
+   */
+  struct ImageParameters {
+    bool do_shading, do_contour;
+    unsigned height_scale;
+    int contrast, brightness;
+    Angle sunazimuth;
+    unsigned quantisation_effective, pixel_size;
+
+    bool operator==(const ImageParameters &other) const {
+      return do_shading == other.do_shading &&
+        do_contour == other.do_contour &&
+        height_scale == other.height_scale &&
+        contrast == other.contrast &&
+        brightness == other.brightness &&
+        sunazimuth == other.sunazimuth &&
+        quantisation_effective == other.quantisation_effective &&
+        pixel_size == other.pixel_size;
+    }
+  };
+
+  ImageParameters last_image_parameters;
+
+  /**
+   * The number of grid cells the #HeightMatrix has been scrolled by
+   * since the last GenerateImage() call.  Only valid if
+   * #image_scrollable is set.
+   */
+  int image_dx = 0, image_dy = 0;
+
+  /**
+   * Does the #RawBitmap show the #HeightMatrix, moved by
+   * (#image_dx, #image_dy), with #last_image_parameters?  This is
+   * cleared by a full scan and by a new color table.
+   */
+  bool image_scrollable = false;
 #endif
 
+  /**
+   * The number of ScanMap() calls which scanned the whole
+   * #HeightMatrix and which scanned only the parts exposed by
+   * scrolling.
+   */
+  unsigned n_full_scans = 0, n_incremental_scans = 0;
+
+  /**
+   * The number of GenerateImage() calls which shaded the whole
+   * #RawBitmap and which shaded only the parts exposed by scrolling.
+   */
+  unsigned n_full_images = 0, n_incremental_images = 0;
+
+  /**
+   * Bands with fewer rows are not worth the threading overhead.
+   */
+  static constexpr unsigned MIN_BAND_HEIGHT = 16;
+
   HeightMatrix height_matrix;
   RawBitmap *image = nullptr;
 
+  /**
+   * The image is generated in horizontal bands on this pool.
+   */
+  WorkerPool &pool;
+
+  /**
+   * The contour state of each column, one row of GetMaxBands()
+   * elements for each band.
+   */
   unsigned char *contour_column_base = nullptr;
 
   double pixel_size;
@@ -81,7 +156,11 @@ class RasterRenderer {
   RawColor *color_table = nullptr;
 
 public:
-  RasterRenderer();
+  /**
+   * @param pool the threads generating the image; all renderers
+   * share one pool by default
+   */
+  explicit RasterRenderer(WorkerPool &_pool=WorkerPool::GetShared());
   ~RasterRenderer();
 
   RasterRenderer(const RasterRenderer &) = delete;
@@ -129,11 +208,34 @@ public:
 
   /**
    * Scan the map and fill the height matrix.
+   *
+   * @param incremental true if the map has not changed since the
+   * last call; this allows scrolling the existing height matrix
+   * instead of scanning it again (OpenGL only)
    */
-  void ScanMap(const RasterMap &map, const WindowProjection &projection);
+  void ScanMap(const RasterMap &map, const WindowProjection &projection,
+               bool incremental=false);
+
+  unsigned GetFullScanCount() const {
+    return n_full_scans;
+  }
+
+  unsigned GetIncrementalScanCount() const {
+    return n_incremental_scans;
+  }
+
+  unsigned GetFullImageCount() const {
+    return n_full_images;
+  }
+
+  unsigned GetIncrementalImageCount() const {
+    return n_incremental_images;
+  }
 
   /**
-   * Convert the height matrix into the image.
+   * Convert the height matrix into the image.  After an incremental
+   * ScanMap() with the same parameters, the previous image is moved
+   * and only the newly exposed parts are shaded (OpenGL only).
    */
   void GenerateImage(bool do_shading,
                      unsigned height_scale, int contrast, int brightness,
@@ -152,14 +254,29 @@ protected:
    * Convert the height matrix into the image, without shading.
    */
   void GenerateUnshadedImage(unsigned height_scale,
-                             const unsigned contour_height_scale);
+                             const unsigned contour_height_scale,
+                             unsigned n_bands);
 
   /**
-   * Convert the height matrix into the image, with slope shading.
+   * Convert the rectangle [x_start, x_end) x [y_start, y_end) of the
+   * height matrix into the image, without shading.
+   */
+  void GenerateUnshadedImage(unsigned height_scale,
+                             const unsigned contour_height_scale,
+                             unsigned x_start, unsigned x_end,
+                             unsigned y_start, unsigned y_end,
+                             unsigned char *column_base);
+
+  /**
+   * Convert the rectangle [x_start, x_end) x [y_start, y_end) of the
+   * height matrix into the image, with slope shading.
    */
   void GenerateSlopeImage(unsigned height_scale, int contrast,
                           const int sx, const int sy, const int sz,
-                          const unsigned contour_height_scale);
+                          const unsigned contour_height_scale,
+                          unsigned x_start, unsigned x_end,
+                          unsigned y_start, unsigned y_end,
+                          unsigned char *column_base);
 
   /**
    * Convert the height matrix into the image, with slope shading.
@@ -167,11 +284,74 @@ protected:
   void GenerateSlopeImage(unsigned height_scale,
                           int contrast, int brightness,
                           const Angle sunazimuth,
-                          const unsigned contour_height_scale);
+                          const unsigned contour_height_scale,
+                          unsigned n_bands);
 
 private:
+#ifdef ENABLE_OPENGL
+  /**
+   * Attempt to move the existing #HeightMatrix to the new screen
+   * position, scanning only the newly exposed rows and columns.
+   * This is only possible if the map has been translated (or
+   * rotated), but not zoomed.
+   *
+   * @return false if a full scan is needed
+   */
+  bool ScrollMap(const RasterMap &map, const WindowProjection &projection,
+                 unsigned width, unsigned height);
+
+  /**
+   * Move the previous image by (#image_dx, #image_dy) and shade the
+   * newly exposed rows and columns on the calling thread.  The
+   * strips are widened by the slope step, because the pixels next to
+   * them and next to the old edges have different neighbours now.
+   *
+   * The contour state at the edge of a strip is taken from the
+   * neighbouring pixel, not from the last one which was not skipped,
+   * so a contour pixel next to water may differ from a full
+   * GenerateImage() call.
+   */
+  void ScrollImage(bool do_shading, unsigned height_scale,
+                   int contrast, int brightness, const Angle sunazimuth,
+                   const unsigned contour_height_scale);
+
+  /**
+   * Convert a rectangle of the height matrix into the image on the
+   * calling thread, starting with the contour state of the pixels
+   * above and left of it.
+   */
+  void GenerateRect(bool do_shading, unsigned height_scale,
+                    int contrast, int brightness, const Angle sunazimuth,
+                    const unsigned contour_height_scale,
+                    unsigned x_start, unsigned x_end,
+                    unsigned y_start, unsigned y_end);
+#endif
+
+  unsigned GetMaxBands() const {
+    /* more bands than threads, to balance the load */
+    return pool.GetConcurrency() > 1 ? pool.GetConcurrency() * 2 : 1;
+  }
+
+  unsigned GetBandStart(unsigned band, unsigned n_bands) const {
+    return height_matrix.GetHeight() * band / n_bands;
+  }
+
+  unsigned char *GetContourColumnBase(unsigned band) const {
+    return contour_column_base + band * height_matrix.GetWidth();
+  }
+
+  /**
+   * Is one of the pixels used for the slope of this pixel "special"?
+   */
+  gcc_pure
+  bool HasSpecialNeighbour(unsigned x, unsigned y) const;
 
-  void ContourStart(const unsigned contour_height_scale);
+  /**
+   * Initialise the contour state of each band, so the result is the
+   * same as if the whole image was generated in one pass.
+   */
+  void ContourStart(const unsigned contour_height_scale,
+                    bool do_shading, unsigned n_bands);
 };
 
 #endif
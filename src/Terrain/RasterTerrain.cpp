@@ -63,12 +63,22 @@ RasterTerrain::SaveCache(FileCache &cache, Path path) const
   return success;
 }
 
+inline void
+RasterTerrain::OpenTileStore(Path path)
+{
+  auto store = std::make_unique<RasterTileStore>(RasterTileStore::GetPath(path));
+  if (store->IsValid(path, map.GetTileCache()))
+    tile_store = std::move(store);
+}
+
 inline bool
 RasterTerrain::Load(Path path, FileCache *cache,
                     OperationEnvironment &operation)
 {
-  if (LoadCache(cache, path))
+  if (LoadCache(cache, path)) {
+    OpenTileStore(path);
     return true;
+  }
 
   if (!LoadTerrainOverview(archive.get(), map.GetTileCache(), operation))
     return false;
@@ -78,6 +88,7 @@ RasterTerrain::Load(Path path, FileCache *cache,
   if (cache != nullptr)
     SaveCache(*cache, path);
 
+  OpenTileStore(path);
   return true;
 }
 
@@ -101,13 +112,15 @@ try {
 }
 
 bool
-RasterTerrain::UpdateTiles(const GeoPoint &location, double radius)
+RasterTerrain::UpdateTiles(const GeoPoint &location, double radius,
+                           const TerrainPrefetch *prefetch)
 {
   auto &tile_cache = map.GetTileCache();
   if (!tile_cache.IsValid())
     return false;
 
   UpdateTerrainTiles(archive.get(), tile_cache, mutex,
-                     map.GetProjection(), location, radius);
+                     map.GetProjection(), location, radius,
+                     tile_store.get(), prefetch);
   return map.IsDirty();
 }
@@ -25,12 +25,15 @@ Copyright_License {
 #define XCSOAR_TERRAIN_RASTER_TERRAIN_HPP
 
 #include "RasterMap.hpp"
+#include "RasterTileStore.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "Thread/Guard.hpp"
 #include "OS/Path.hpp"
 #include "IO/ZipArchive.hpp"
 #include "Compiler.h"
 
+#include <memory>
+
 class FileCache;
 class OperationEnvironment;
 
@@ -47,6 +50,13 @@ public:
 private:
   ZipArchive archive;
 
+  /**
+   * Pre-decoded tiles next to the map file, or nullptr if there is
+   * no such file or it is stale.  Declared before #map, because the
+   * tiles refer to its memory mapping.
+   */
+  std::unique_ptr<RasterTileStore> tile_store;
+
   RasterMap map;
 
 private:
@@ -78,9 +88,17 @@ public:
   }
 
   /**
+   * @param prefetch locations where tiles will be needed soon
    * @return true if the method shall be called again
    */
-  bool UpdateTiles(const GeoPoint &location, double radius);
+  bool UpdateTiles(const GeoPoint &location, double radius,
+                   const TerrainPrefetch *prefetch=nullptr);
+
+  gcc_pure
+  TerrainPrefetchStatistics GetPrefetchStatistics() const {
+    Lease lease(*this);
+    return lease->GetPrefetchStatistics();
+  }
 
 private:
   bool LoadCache(FileCache &cache, Path path);
@@ -91,6 +109,8 @@ private:
 
   bool SaveCache(FileCache &cache, Path path) const;
 
+  void OpenTileStore(Path path);
+
   bool Load(Path path, FileCache *cache,
             OperationEnvironment &operation);
 };
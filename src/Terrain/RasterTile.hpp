@@ -48,6 +48,12 @@ public:
 
   bool request;
 
+  /**
+   * The value of RasterTileCache::serial after the data of this tile
+   * was last loaded or discarded.
+   */
+  unsigned modified_serial = 0;
+
   RasterBuffer buffer;
 
 public:
@@ -115,6 +121,15 @@ public:
 
   void CopyFrom(const struct jas_matrix &m);
 
+  /**
+   * Use pre-decoded pixels from a #RasterTileStore.  The memory is
+   * not copied; it must remain valid until Disable() is called.
+   */
+  void SetExternal(const TerrainHeight *data) {
+    if (IsDefined())
+      buffer.SetExternal(data, width, height);
+  }
+
   /**
    * Determine the non-interpolated height at the specified pixel
    * location.
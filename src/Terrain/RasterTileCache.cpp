@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "RasterTileCache.hpp"
+#include "RasterTileStore.hpp"
 #include "Math/Angle.hpp"
 #include "Math/FastMath.hpp"
 
@@ -41,32 +42,35 @@ CopyOverviewRow(TerrainHeight *gcc_restrict dest, const jas_seqent_t *gcc_restri
     *dest++ = TerrainHeight(*src);
 }
 
-void
-RasterTileCache::PutOverviewTile(unsigned index,
-                                 unsigned start_x, unsigned start_y,
-                                 unsigned end_x, unsigned end_y,
-                                 const struct jas_matrix &m)
+/**
+ * Copy a down-scaled portion of a tile to one pyramid level.
+ *
+ * @param level the map is scaled by 1/2^level
+ */
+static void
+PutLevelTile(RasterBuffer &buffer, unsigned level,
+             unsigned start_x, unsigned start_y,
+             const struct jas_matrix &m)
 {
-  tiles.GetLinear(index).Set(start_x, start_y, end_x, end_y);
-
-  const unsigned dest_pitch = overview.GetWidth();
+  const unsigned dest_pitch = buffer.GetWidth();
+  const unsigned ceil = (1u << level) - 1;
 
-  start_x = RasterTraits::ToOverview(start_x);
-  start_y = RasterTraits::ToOverview(start_y);
+  start_x >>= level;
+  start_y >>= level;
 
-  if (start_x >= overview.GetWidth() || start_y >= overview.GetHeight())
+  if (start_x >= buffer.GetWidth() || start_y >= buffer.GetHeight())
     return;
 
-  unsigned width = RasterTraits::ToOverviewCeil(m.numcols_);
-  if (start_x + width > overview.GetWidth())
-    width = overview.GetWidth() - start_x;
-  unsigned height = RasterTraits::ToOverviewCeil(m.numrows_);
-  if (start_y + height > overview.GetHeight())
-    height = overview.GetHeight() - start_y;
+  unsigned width = (m.numcols_ + ceil) >> level;
+  if (start_x + width > buffer.GetWidth())
+    width = buffer.GetWidth() - start_x;
+  unsigned height = (m.numrows_ + ceil) >> level;
+  if (start_y + height > buffer.GetHeight())
+    height = buffer.GetHeight() - start_y;
 
-  const unsigned skip = 1 << OVERVIEW_BITS;
+  const unsigned skip = 1 << level;
 
-  auto *gcc_restrict dest = overview.GetData()
+  auto *gcc_restrict dest = buffer.GetData()
     + start_y * dest_pitch + start_x;
 
   /* note: this loop rounds up */
@@ -74,6 +78,24 @@ RasterTileCache::PutOverviewTile(unsigned index,
     CopyOverviewRow(dest, m.rows_[y], width, skip);
 }
 
+void
+RasterTileCache::PutOverviewTile(unsigned index,
+                                 unsigned start_x, unsigned start_y,
+                                 unsigned end_x, unsigned end_y,
+                                 const struct jas_matrix &m)
+{
+  tiles.GetLinear(index).Set(start_x, start_y, end_x, end_y);
+  MarkOverviewModified();
+
+  PutLevelTile(overview, OVERVIEW_BITS, start_x, start_y, m);
+
+  for (unsigned level = 1; level < OVERVIEW_BITS; ++level) {
+    RasterBuffer &mipmap = mipmaps[level - 1];
+    if (mipmap.IsDefined())
+      PutLevelTile(mipmap, level, start_x, start_y, m);
+  }
+}
+
 void
 RasterTileCache::PutTileData(unsigned index,
                              const struct jas_matrix &m)
@@ -83,6 +105,31 @@ RasterTileCache::PutTileData(unsigned index,
     return;
 
   tile.CopyFrom(m);
+  MarkModified(tile);
+}
+
+bool
+RasterTileCache::PutStoredTiles(const RasterTileStore &store)
+{
+  bool remaining = false;
+
+  for (const auto i : request_tiles) {
+    RasterTile &tile = tiles.GetLinear(i);
+    if (!tile.IsRequested())
+      continue;
+
+    const TerrainHeight *data = store.GetTile(i);
+    if (data == nullptr) {
+      remaining = true;
+      continue;
+    }
+
+    tile.SetExternal(data);
+    tile.ClearRequest();
+    MarkModified(tile);
+  }
+
+  return remaining;
 }
 
 struct RTDistanceSort {
@@ -99,7 +146,8 @@ struct RTDistanceSort {
 };
 
 bool
-RasterTileCache::PollTiles(int x, int y, unsigned radius)
+RasterTileCache::PollTiles(int x, int y, unsigned radius,
+                           ConstBuffer<RasterLocation> prefetch)
 {
   /* tiles are usually 256 pixels wide; with a radius smaller than
      that, the (optimized) tile distance calculations may fail;
@@ -123,6 +171,42 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
     if (tiles.GetLinear(i).VisibilityChanged(x, y, radius))
       request_tiles.append(i);
 
+  /* add the tiles of the prefetch locations; they get the lowest
+     possible distance, so they survive the reduction below */
+
+  StaticArray<uint16_t, TerrainPrefetch::MAX_LOCATIONS> prefetch_tiles;
+  for (const auto &location : prefetch) {
+    if (!IsInside(location) || prefetch_tiles.full())
+      continue;
+
+    const unsigned i = (location.y / tile_height) * tiles.GetWidth()
+      + location.x / tile_width;
+    RasterTile &tile = tiles.GetLinear(i);
+    if (!tile.IsDefined())
+      continue;
+
+    if (tile.GetDistance() == 0)
+      /* already seen */
+      continue;
+
+    if (!last_prefetch_tiles.contains(i)) {
+      if (tile.IsEnabled())
+        ++prefetch_statistics.hits;
+      else
+        ++prefetch_statistics.misses;
+    }
+
+    if (!tile.IsEnabled() && tile.GetDistance() > (int)radius &&
+        !request_tiles.full())
+      /* not yet in the list */
+      request_tiles.append(i);
+
+    tile.distance = 0;
+    prefetch_tiles.append(i);
+  }
+
+  last_prefetch_tiles = prefetch_tiles;
+
   /* reduce if there are too many */
 
   if (request_tiles.size() > MAX_ACTIVE_TILES) {
@@ -133,20 +217,43 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
     /* dispose all tiles which are out of range */
     for (unsigned i = MAX_ACTIVE_TILES; i < request_tiles.size(); ++i) {
       RasterTile &tile = tiles.GetLinear(request_tiles[i]);
-      tile.Disable();
+      if (tile.IsEnabled()) {
+        tile.Disable();
+        MarkModified(tile);
+      }
     }
 
     request_tiles.shrink(MAX_ACTIVE_TILES);
   }
 
-  /* fill ActiveTiles and request new tiles */
-
   dirty = false;
 
+  /* request the prefetch tiles first, by priority, within their own
+     budget */
+
+  unsigned num_prefetch = 0;
+  for (const auto i : prefetch_tiles) {
+    RasterTile &tile = tiles.GetLinear(i);
+    if (tile.IsEnabled() || tile.IsRequested())
+      continue;
+
+    if (num_prefetch >= MAX_PREFETCH_ACTIVATE) {
+      /* the remaining ones will be requested in the next iteration */
+      dirty = true;
+      break;
+    }
+
+    tile.SetRequest();
+    ++num_prefetch;
+    ++prefetch_statistics.requested;
+  }
+
+  /* fill ActiveTiles and request new tiles */
+
   unsigned num_activate = 0;
   for (unsigned i = 0; i < request_tiles.size(); ++i) {
     RasterTile &tile = tiles.GetLinear(request_tiles[i]);
-    if (tile.IsEnabled())
+    if (tile.IsEnabled() || tile.IsRequested())
       continue;
 
     if (++num_activate <= MAX_ACTIVATE)
@@ -157,7 +264,7 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
       dirty = true;
   }
 
-  return num_activate > 0;
+  return num_activate > 0 || num_prefetch > 0;
 }
 
 TerrainHeight
@@ -171,9 +278,10 @@ RasterTileCache::GetHeight(unsigned px, unsigned py) const
   if (tile.IsEnabled())
     return tile.GetHeight(px, py);
 
-  // still not found, so go to overview
-  return overview.GetInterpolated(px << (RasterTraits::SUBPIXEL_BITS - RasterTraits::OVERVIEW_BITS),
-                                  py << (RasterTraits::SUBPIXEL_BITS - RasterTraits::OVERVIEW_BITS));
+  // still not found, so go to the finest pyramid level
+  const unsigned level = FindLevel(1);
+  return GetLevel(level).GetInterpolated(px << (RasterTraits::SUBPIXEL_BITS - level),
+                                         py << (RasterTraits::SUBPIXEL_BITS - level));
 }
 
 TerrainHeight
@@ -191,9 +299,9 @@ RasterTileCache::GetInterpolatedHeight(unsigned int lx, unsigned int ly) const
   if (tile.IsEnabled())
     return tile.GetInterpolatedHeight(px, py, ix, iy);
 
-  // still not found, so go to overview
-  return overview.GetInterpolated(RasterTraits::ToOverview(lx),
-                                  RasterTraits::ToOverview(ly));
+  // still not found, so go to the finest pyramid level
+  const unsigned level = FindLevel(1);
+  return GetLevel(level).GetInterpolated(lx >> level, ly >> level);
 }
 
 void
@@ -210,6 +318,23 @@ RasterTileCache::SetSize(unsigned _width, unsigned _height,
      same */
   overview.Resize(RasterTraits::ToOverviewCeil(width),
                   RasterTraits::ToOverviewCeil(height));
+
+  /* allocate the finer pyramid levels which fit into the memory
+     budget */
+  for (unsigned level = 1; level < OVERVIEW_BITS; ++level) {
+    const unsigned ceil = (1u << level) - 1;
+    const unsigned level_width = (width + ceil) >> level;
+    const unsigned level_height = (height + ceil) >> level;
+
+    RasterBuffer &mipmap = mipmaps[level - 1];
+    if (level_width * level_height <= MAX_MIPMAP_PIXELS)
+      mipmap.Resize(level_width, level_height);
+    else
+      mipmap.Reset();
+  }
+
+  MarkOverviewModified();
+
   overview_width_fine = width << RasterTraits::SUBPIXEL_BITS;
   overview_height_fine = height << RasterTraits::SUBPIXEL_BITS;
 
@@ -241,8 +366,58 @@ RasterTileCache::Reset()
 
   overview.Reset();
 
+  for (auto &mipmap : mipmaps)
+    mipmap.Reset();
+
   for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it)
     it->Disable();
+
+  last_prefetch_tiles.clear();
+  prefetch_statistics.Clear();
+
+  MarkOverviewModified();
+}
+
+bool
+RasterTileCache::IsModifiedSince(unsigned old_serial,
+                                 int x0, int y0, int x1, int y1) const
+{
+  if (overview_serial > old_serial)
+    return true;
+
+  if (x0 > x1)
+    std::swap(x0, x1);
+  if (y0 > y1)
+    std::swap(y0, y1);
+
+  if (x1 < 0 || y1 < 0 || x0 >= int(width) || y0 >= int(height))
+    /* outside of the map */
+    return false;
+
+  const unsigned column0 = std::max(x0, 0) / tile_width;
+  const unsigned row0 = std::max(y0, 0) / tile_height;
+  const unsigned column1 = std::min(std::min(unsigned(x1), width - 1) / tile_width,
+                                    tiles.GetWidth() - 1);
+  const unsigned row1 = std::min(std::min(unsigned(y1), height - 1) / tile_height,
+                                 tiles.GetHeight() - 1);
+
+  for (unsigned row = row0; row <= row1; ++row)
+    for (unsigned column = column0; column <= column1; ++column)
+      if (tiles.Get(column, row).modified_serial > old_serial)
+        return true;
+
+  return false;
+}
+
+unsigned
+RasterTileCache::GetMipmapMask() const
+{
+  unsigned mask = 0;
+  for (unsigned i = 0; i < OVERVIEW_BITS - 1; ++i)
+    if (mipmaps[i].IsDefined())
+      mask |= 1u << i;
+
+  return mask;
 }
 
 const RasterTileCache::MarkerSegmentInfo *
@@ -293,6 +468,7 @@ RasterTileCache::SaveCache(FILE *file) const
   header.tile_columns = tiles.GetWidth();
   header.tile_rows = tiles.GetHeight();
   header.num_marker_segments = segments.size();
+  header.mipmap_mask = GetMipmapMask();
   header.bounds = bounds;
 
   if (fwrite(&header, sizeof(header), 1, file) != 1 ||
@@ -318,6 +494,17 @@ RasterTileCache::SaveCache(FILE *file) const
              overview_size, file) != overview_size)
     return false;
 
+  /* save the finer pyramid levels */
+  for (const auto &mipmap : mipmaps) {
+    if (!mipmap.IsDefined())
+      continue;
+
+    size_t mipmap_size = mipmap.GetWidth() * mipmap.GetHeight();
+    if (fwrite(mipmap.GetData(), sizeof(*mipmap.GetData()),
+               mipmap_size, file) != mipmap_size)
+      return false;
+  }
+
   /* done */
   return true;
 }
@@ -346,7 +533,9 @@ RasterTileCache::LoadCache(FILE *file)
           header.tile_width, header.tile_height,
           header.tile_columns, header.tile_rows);
   bounds = header.bounds;
-  if (!bounds.IsValid())
+  if (!bounds.IsValid() ||
+      /* the pyramid was generated with a different memory budget */
+      header.mipmap_mask != GetMipmapMask())
     return false;
 
   /* load segments */
@@ -378,5 +567,16 @@ RasterTileCache::LoadCache(FILE *file)
             overview_size, file) != overview_size)
     return false;
 
+  /* load the finer pyramid levels */
+  for (auto &mipmap : mipmaps) {
+    if (!mipmap.IsDefined())
+      continue;
+
+    size_t mipmap_size = mipmap.GetWidth() * mipmap.GetHeight();
+    if (fread(mipmap.GetData(), sizeof(*mipmap.GetData()),
+              mipmap_size, file) != mipmap_size)
+      return false;
+  }
+
   return true;
 }
@@ -27,8 +27,10 @@ Copyright_License {
 #include "RasterTraits.hpp"
 #include "RasterTile.hpp"
 #include "RasterLocation.hpp"
+#include "Prefetch.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "Util/StaticArray.hxx"
+#include "Util/ConstBuffer.hxx"
 #include "Util/Serial.hpp"
 
 #include <assert.h>
@@ -39,6 +41,7 @@ Copyright_License {
 
 struct jas_matrix;
 struct GridLocation;
+class RasterTileStore;
 
 class RasterTileCache {
   static constexpr unsigned MAX_RTC_TILES = 4096;
@@ -54,6 +57,13 @@ class RasterTileCache {
   static constexpr unsigned MAX_ACTIVE_TILES = 512;
 #endif
 
+  /**
+   * The maximum number of tiles requested by prefetch locations per
+   * PollTiles() call.  This limits the I/O spent on tiles which are
+   * not visible yet.
+   */
+  static constexpr unsigned MAX_PREFETCH_ACTIVATE = 4;
+
   /**
    * The width and height of the terrain bitmap is shifted by this
    * number of bits to determine the overview size.
@@ -62,6 +72,16 @@ class RasterTileCache {
 
   static constexpr unsigned OVERVIEW_MASK = (~0u) << OVERVIEW_BITS;
 
+  /**
+   * The maximum number of pixels of a #mipmaps level.  Finer levels
+   * are not allocated, and the next coarser level is used instead.
+   */
+#if defined(ANDROID)
+  static constexpr unsigned MAX_MIPMAP_PIXELS = 1024 * 1024;
+#else
+  static constexpr unsigned MAX_MIPMAP_PIXELS = 2048 * 2048;
+#endif
+
   /**
    * Target number of steps in intersection searches; total distance
    * is shifted by this number of bits
@@ -71,6 +91,8 @@ class RasterTileCache {
 protected:
   friend struct RTDistanceSort;
   friend class TerrainLoader;
+  friend class RasterTileStore;
+  friend class RasterTileStoreWriter;
 
   struct MarkerSegmentInfo {
     static constexpr uint16_t NO_TILE = (uint16_t)-1;
@@ -101,13 +123,19 @@ protected:
   };
 
   struct CacheHeader {
-    static constexpr unsigned VERSION = 0xb;
+    static constexpr unsigned VERSION = 0xc;
 
     unsigned version;
     unsigned width, height;
     unsigned short tile_width, tile_height;
     unsigned tile_columns, tile_rows;
     unsigned num_marker_segments;
+
+    /**
+     * A bit mask of #mipmaps levels stored after the overview.
+     */
+    unsigned mipmap_mask;
+
     GeoBounds bounds;
   };
 
@@ -119,10 +147,26 @@ protected:
    */
   Serial serial;
 
+  /**
+   * The value of #serial after the overview (or the map geometry) was
+   * last modified.  See IsModifiedSince().
+   */
+  unsigned overview_serial = 0;
+
   AllocatedGrid<RasterTile> tiles;
   unsigned short tile_width, tile_height;
 
   RasterBuffer overview;
+
+  /**
+   * Down-scaled copies of the map which are finer than #overview;
+   * mipmaps[i] is scaled by 1/2^(i+1).  They are used when a fine
+   * tile is not loaded, and when the caller samples so sparsely that
+   * fine tiles would be wasted.  A level is not allocated if it would
+   * be larger than #MAX_MIPMAP_PIXELS.
+   */
+  RasterBuffer mipmaps[OVERVIEW_BITS - 1];
+
   unsigned int width, height;
   unsigned int overview_width_fine, overview_height_fine;
 
@@ -137,6 +181,15 @@ protected:
    */
   StaticArray<uint16_t, MAX_RTC_TILES> request_tiles;
 
+  /**
+   * The tiles of the prefetch locations of the previous PollTiles()
+   * call.  The statistics count a tile only when it becomes a
+   * prefetch tile, not on every call.
+   */
+  StaticArray<uint16_t, TerrainPrefetch::MAX_LOCATIONS> last_prefetch_tiles;
+
+  TerrainPrefetchStatistics prefetch_statistics;
+
 public:
   RasterTileCache() {
     Reset();
@@ -152,6 +205,36 @@ public:
   }
 
 protected:
+  /**
+   * Find the finest allocated pyramid level which is not finer than
+   * the given one.  #OVERVIEW_BITS refers to #overview, which is
+   * always available.
+   *
+   * @param level the desired level (1..#OVERVIEW_BITS); the map is
+   * scaled by 1/2^level
+   */
+  gcc_pure
+  unsigned FindLevel(unsigned level) const {
+    assert(level > 0);
+
+    for (; level < OVERVIEW_BITS; ++level)
+      if (mipmaps[level - 1].IsDefined())
+        return level;
+
+    return OVERVIEW_BITS;
+  }
+
+  const RasterBuffer &GetLevel(unsigned level) const {
+    assert(level > 0 && level <= OVERVIEW_BITS);
+
+    return level < OVERVIEW_BITS ? mipmaps[level - 1] : overview;
+  }
+
+  void ScanLevelLine(unsigned level,
+                     RasterLocation start, RasterLocation end,
+                     TerrainHeight *buffer, unsigned size,
+                     bool interpolate) const;
+
   void ScanTileLine(GridLocation start, GridLocation end,
                     TerrainHeight *buffer, unsigned size,
                     bool interpolate) const;
@@ -180,7 +263,9 @@ public:
 
   /**
    * Scan a straight line and fill the buffer with the specified
-   * number of samples along the line.
+   * number of samples along the line.  If two samples are at least
+   * two pixels apart, the matching pyramid level is used instead of
+   * the fine tiles.
    *
    * @param start the sub-pixel start location
    * @param end the sub-pixel end location
@@ -206,6 +291,16 @@ public:
                const int height_floor) const;
 
 private:
+  void MarkModified(RasterTile &tile) {
+    ++serial;
+    tile.modified_serial = serial.GetValue();
+  }
+
+  void MarkOverviewModified() {
+    ++serial;
+    overview_serial = serial.GetValue();
+  }
+
   /**
    * Get field (not interpolated) directly, without bringing tiles to front.
    * @param px X position/256
@@ -217,6 +312,12 @@ private:
   gcc_pure
   std::pair<TerrainHeight, bool> GetFieldDirect(unsigned px, unsigned py) const;
 
+  /**
+   * Returns a bit mask of the allocated #mipmaps levels.
+   */
+  gcc_pure
+  unsigned GetMipmapMask() const;
+
 public:
   bool SaveCache(FILE *file) const;
   bool LoadCache(FILE *file);
@@ -238,6 +339,15 @@ public:
     return serial;
   }
 
+  /**
+   * Has the terrain within the specified rectangle (raster pixels)
+   * been modified after #serial had the specified value?  Unlike
+   * comparing GetSerial(), this ignores tiles outside the rectangle.
+   */
+  gcc_pure
+  bool IsModifiedSince(unsigned old_serial,
+                       int x0, int y0, int x1, int y1) const;
+
   void Reset();
 
   const GeoBounds &GetBounds() const {
@@ -274,10 +384,31 @@ public:
                        unsigned end_x, unsigned end_y,
                        const struct jas_matrix &m);
 
-  bool PollTiles(int x, int y, unsigned radius);
+  /**
+   * Determine which tiles shall be loaded and mark them as
+   * "requested".
+   *
+   * @param x, y the pixel location of the view center
+   * @param radius the view radius in pixels
+   * @param prefetch pixel locations where tiles will be needed soon,
+   * sorted by priority; up to #MAX_PREFETCH_ACTIVATE of their tiles
+   * are requested per call, in addition to the view's tiles
+   * @return true if at least one tile was requested
+   */
+  bool PollTiles(int x, int y, unsigned radius,
+                 ConstBuffer<RasterLocation> prefetch=nullptr);
 
   void PutTileData(unsigned index, const struct jas_matrix &m);
 
+  /**
+   * Serve the requested tiles which are available in the given store
+   * directly from its memory mapping, and clear their request flag.
+   *
+   * @return true if there are still requested tiles which need to be
+   * decoded
+   */
+  bool PutStoredTiles(const RasterTileStore &store);
+
   void FinishTileUpdate();
 
 public:
@@ -292,6 +423,10 @@ public:
     return p.x < width && p.y < height;
   }
 
+  const TerrainPrefetchStatistics &GetPrefetchStatistics() const {
+    return prefetch_statistics;
+  }
+
   unsigned int GetWidth() const { return width; }
   unsigned int GetHeight() const { return height; }
 
@@ -0,0 +1,199 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RasterTileStore.hpp"
+#include "RasterTileCache.hpp"
+#include "OS/FileUtil.hpp"
+
+#include <string.h>
+#include <tchar.h>
+
+AllocatedPath
+RasterTileStore::GetPath(Path map_path)
+{
+  return map_path + _T(".tiles");
+}
+
+bool
+RasterTileStore::IsValid(Path source_path,
+                         const RasterTileCache &rtc) const
+{
+  if (mapping.error() || mapping.size() < sizeof(Header))
+    return false;
+
+  const Header &header = GetHeader();
+  if (header.magic != Header::MAGIC ||
+      header.version != Header::VERSION ||
+      header.source_mtime != File::GetLastModification(source_path) ||
+      header.source_size != File::GetSize(source_path) ||
+      header.width != rtc.width || header.height != rtc.height ||
+      header.tile_width != rtc.tile_width ||
+      header.tile_height != rtc.tile_height ||
+      header.tile_columns != rtc.tiles.GetWidth() ||
+      header.tile_rows != rtc.tiles.GetHeight())
+    return false;
+
+  const unsigned n_tiles = rtc.tiles.GetSize();
+  if (mapping.size() < sizeof(Header) + n_tiles * sizeof(TileInfo))
+    return false;
+
+  const TileInfo *infos = GetTileInfos();
+  for (unsigned i = 0; i < n_tiles; ++i) {
+    const TileInfo &info = infos[i];
+    if (info.offset == 0)
+      continue;
+
+    const RasterTile &tile = rtc.tiles.GetLinear(i);
+    if (info.offset % ALIGNMENT != 0 ||
+        info.width != tile.width || info.height != tile.height ||
+        info.offset + uint64_t(info.width) * info.height * sizeof(TerrainHeight) > mapping.size())
+      return false;
+  }
+
+  return true;
+}
+
+const TerrainHeight *
+RasterTileStore::GetTile(unsigned index) const
+{
+  const TileInfo &info = GetTileInfos()[index];
+  if (info.offset == 0)
+    return nullptr;
+
+  return (const TerrainHeight *)mapping.at(info.offset);
+}
+
+RasterTileStoreWriter::RasterTileStoreWriter(Path _path)
+  :path(_path), tmp_path(_path + _T(".tmp")) {}
+
+RasterTileStoreWriter::~RasterTileStoreWriter()
+{
+  if (file != nullptr)
+    Cancel();
+}
+
+void
+RasterTileStoreWriter::Cancel()
+{
+  assert(file != nullptr);
+
+  fclose(file);
+  file = nullptr;
+  File::Delete(tmp_path);
+}
+
+bool
+RasterTileStoreWriter::Create(Path source_path, const RasterTileCache &rtc)
+{
+  assert(file == nullptr);
+
+  if (!rtc.IsValid())
+    return false;
+
+  /* zero-fill all implicit padding bytes */
+  memset(&header, 0, sizeof(header));
+
+  header.magic = RasterTileStore::Header::MAGIC;
+  header.version = RasterTileStore::Header::VERSION;
+  header.source_mtime = File::GetLastModification(source_path);
+  header.source_size = File::GetSize(source_path);
+  header.width = rtc.width;
+  header.height = rtc.height;
+  header.tile_width = rtc.tile_width;
+  header.tile_height = rtc.tile_height;
+  header.tile_columns = rtc.tiles.GetWidth();
+  header.tile_rows = rtc.tiles.GetHeight();
+
+  tiles.ResizeDiscard(rtc.tiles.GetSize());
+  memset(tiles.begin(), 0, tiles.size() * sizeof(*tiles.begin()));
+
+  File::Delete(tmp_path);
+  file = _tfopen(tmp_path.c_str(), _T("wb"));
+  if (file == nullptr)
+    return false;
+
+  /* reserve space for the header and the tile table; they are
+     rewritten by Commit() */
+  if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+      fwrite(tiles.begin(), sizeof(*tiles.begin()), tiles.size(),
+             file) != tiles.size()) {
+    Cancel();
+    return false;
+  }
+
+  return true;
+}
+
+bool
+RasterTileStoreWriter::Put(unsigned index, const RasterBuffer &buffer)
+{
+  assert(file != nullptr);
+  assert(index < tiles.size());
+  assert(buffer.IsDefined());
+
+  long position = ftell(file);
+  if (position < 0)
+    return false;
+
+  /* pad to the next page boundary */
+  static constexpr char zero[RasterTileStore::ALIGNMENT] = {};
+  const size_t padding = (RasterTileStore::ALIGNMENT -
+                          position % RasterTileStore::ALIGNMENT) %
+    RasterTileStore::ALIGNMENT;
+  if (padding > 0 && fwrite(zero, 1, padding, file) != padding)
+    return false;
+
+  const size_t n = buffer.GetWidth() * buffer.GetHeight();
+  if (fwrite(buffer.GetData(), sizeof(*buffer.GetData()), n, file) != n)
+    return false;
+
+  auto &info = tiles[index];
+  info.offset = position + padding;
+  info.width = buffer.GetWidth();
+  info.height = buffer.GetHeight();
+  return true;
+}
+
+bool
+RasterTileStoreWriter::Commit()
+{
+  assert(file != nullptr);
+
+  if (fseek(file, 0, SEEK_SET) != 0 ||
+      fwrite(&header, sizeof(header), 1, file) != 1 ||
+      fwrite(tiles.begin(), sizeof(*tiles.begin()), tiles.size(),
+             file) != tiles.size()) {
+    Cancel();
+    return false;
+  }
+
+  bool success = fclose(file) == 0;
+  file = nullptr;
+
+  if (!success || !File::Replace(tmp_path, path)) {
+    File::Delete(tmp_path);
+    return false;
+  }
+
+  return true;
+}
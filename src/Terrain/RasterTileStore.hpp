@@ -0,0 +1,164 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_RASTER_TILE_STORE_HPP
+#define XCSOAR_TERRAIN_RASTER_TILE_STORE_HPP
+
+#include "Height.hpp"
+#include "OS/FileMapping.hpp"
+#include "OS/Path.hpp"
+#include "Util/AllocatedArray.hxx"
+#include "Compiler.h"
+
+#include <stdio.h>
+#include <stdint.h>
+
+class RasterTileCache;
+class RasterBuffer;
+
+/**
+ * A file which contains all tiles of a terrain map in decoded form.
+ * It lives next to the map file and is generated offline (see
+ * LoadTerrain).  Each tile is stored at a page-aligned offset in the
+ * native #TerrainHeight layout, so #RasterTileCache can use it
+ * directly from the memory mapping, without decoding JPEG2000 and
+ * without copying it to the heap.
+ */
+class RasterTileStore {
+public:
+  /**
+   * Tile data is aligned to this number of bytes within the file.
+   */
+  static constexpr unsigned ALIGNMENT = 4096;
+
+  struct Header {
+    static constexpr uint32_t MAGIC = 0x58435453;
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic, version;
+
+    /**
+     * Modification time and size of the map file this store was
+     * generated from; used to detect stale stores.
+     */
+    uint64_t source_mtime, source_size;
+
+    uint32_t width, height;
+    uint32_t tile_width, tile_height;
+    uint32_t tile_columns, tile_rows;
+  };
+
+  struct TileInfo {
+    /**
+     * The position of the tile data within the file.  0 means this
+     * tile is not available.
+     */
+    uint64_t offset;
+
+    uint32_t width, height;
+  };
+
+private:
+  FileMapping mapping;
+
+public:
+  explicit RasterTileStore(Path path)
+    :mapping(path) {}
+
+  RasterTileStore(const RasterTileStore &) = delete;
+  RasterTileStore &operator=(const RasterTileStore &) = delete;
+
+  /**
+   * Returns the default store path for the given map file.
+   */
+  gcc_pure
+  static AllocatedPath GetPath(Path map_path);
+
+  /**
+   * Check whether this store is usable: the file must be
+   * well-formed, it must have been generated from the current
+   * version of the map file, and its geometry must match the given
+   * tile cache.
+   */
+  gcc_pure
+  bool IsValid(Path source_path, const RasterTileCache &rtc) const;
+
+  /**
+   * Returns the decoded pixels of the specified tile, or nullptr if
+   * the tile is not available.  Must only be called after
+   * IsValid() has returned true.
+   */
+  gcc_pure
+  const TerrainHeight *GetTile(unsigned index) const;
+
+private:
+  const Header &GetHeader() const {
+    return *(const Header *)mapping.data();
+  }
+
+  const TileInfo *GetTileInfos() const {
+    return (const TileInfo *)mapping.at(sizeof(Header));
+  }
+};
+
+/**
+ * Generates a #RasterTileStore file.  Call Put() for each tile, and
+ * Commit() at the end.  The file is written to a temporary path and
+ * renamed only after it is complete, so a store being mapped by a
+ * running instance is never modified.
+ */
+class RasterTileStoreWriter {
+  const AllocatedPath path, tmp_path;
+
+  FILE *file = nullptr;
+
+  RasterTileStore::Header header;
+  AllocatedArray<RasterTileStore::TileInfo> tiles;
+
+public:
+  explicit RasterTileStoreWriter(Path _path);
+  ~RasterTileStoreWriter();
+
+  RasterTileStoreWriter(const RasterTileStoreWriter &) = delete;
+  RasterTileStoreWriter &operator=(const RasterTileStoreWriter &) = delete;
+
+  /**
+   * Create the temporary file and reserve space for the tile table.
+   */
+  bool Create(Path source_path, const RasterTileCache &rtc);
+
+  /**
+   * Append the decoded pixels of a tile.
+   */
+  bool Put(unsigned index, const RasterBuffer &buffer);
+
+  /**
+   * Write the tile table and move the file to its final location.
+   */
+  bool Commit();
+
+private:
+  void Cancel();
+};
+
+#endif
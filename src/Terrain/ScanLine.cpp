@@ -24,6 +24,8 @@ Copyright_License {
 #include "Terrain/RasterTileCache.hpp"
 #include "Terrain/RasterLocation.hpp"
 
+#include <algorithm>
+
 #include <stdlib.h>
 
 struct GridLocation : public RasterLocation {
@@ -259,6 +261,21 @@ NextGridIntersection(const GridRay &ray,
     ? h : v;
 }
 
+void
+RasterTileCache::ScanLevelLine(unsigned level,
+                               RasterLocation start, RasterLocation end,
+                               TerrainHeight *buffer, unsigned size,
+                               bool interpolate) const
+{
+  level = FindLevel(level);
+
+  /* need range checking in the pyramid buffer because its size may
+     be rounded, and then the "fine" location may exceed its bounds */
+  GetLevel(level).ScanLineChecked(start.x >> level, start.y >> level,
+                                  end.x >> level, end.y >> level,
+                                  buffer, size, interpolate);
+}
+
 inline void
 RasterTileCache::ScanTileLine(GridLocation start, GridLocation end,
                               TerrainHeight *buffer, unsigned size,
@@ -302,14 +319,32 @@ RasterTileCache::ScanTileLine(GridLocation start, GridLocation end,
                   buffer + start.index, end.index - start.index,
                   interpolate);
   else
-    /* need range checking in the overview buffer because its size may
-       be rounded down, and then the "fine" location may exceed its
-       bounds */
-    overview.ScanLineChecked(start.x >> OVERVIEW_BITS,
-                             start.y >> OVERVIEW_BITS,
-                             end.x >> OVERVIEW_BITS, end.y >> OVERVIEW_BITS,
-                             buffer + start.index, end.index - start.index,
-                             interpolate);
+    ScanLevelLine(1, start, end,
+                  buffer + start.index, end.index - start.index,
+                  interpolate);
+}
+
+/**
+ * Determine the pyramid level which matches the distance between two
+ * samples, i.e. the largest level whose pixels are not larger than
+ * one sample step.  Returns 0 if the fine tiles should be used.
+ */
+gcc_const
+static unsigned
+CalcScanLevel(RasterLocation start, RasterLocation end, unsigned size)
+{
+  assert(size >= 2);
+
+  const unsigned dx = abs((int)end.x - (int)start.x);
+  const unsigned dy = abs((int)end.y - (int)start.y);
+  const unsigned step = std::max(dx, dy) / (size - 1);
+
+  unsigned level = 0;
+  while (level < RasterTraits::OVERVIEW_BITS &&
+         step >= (2u << (level + RasterTraits::SUBPIXEL_BITS)))
+    ++level;
+
+  return level;
 }
 
 void
@@ -324,6 +359,13 @@ RasterTileCache::ScanLine(const RasterLocation _start,
   assert(_end.y < GetFineHeight());
   assert(size >= 2);
 
+  const unsigned level = CalcScanLevel(_start, _end, size);
+  if (level > 0) {
+    /* samples are too sparse to benefit from fine tiles */
+    ScanLevelLine(level, _start, _end, buffer, size, interpolate);
+    return;
+  }
+
   const GridRay ray(GetFineTileWidth(), GetFineTileHeight(),
                     _start, _end, size);
   assert(ray.size == size);
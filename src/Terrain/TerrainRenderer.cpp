@@ -27,6 +27,7 @@ Copyright_License {
 #include "Screen/RawBitmap.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Util/Macros.hpp"
+#include "LogFile.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Texture.hpp"
@@ -321,24 +322,44 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
   GeoBounds new_bounds = map_projection.GetScreenBounds();
   assert(new_bounds.IsValid());
 
+  /* only tiles within the previously rendered area matter; tiles
+     being loaded or discarded elsewhere do not invalidate it */
+  bool terrain_modified;
+  unsigned new_serial;
+
   {
     RasterTerrain::Lease map(terrain);
     if (!new_bounds.IntersectWith(map->GetBounds()))
       /* map is outside of visible screen area */
       return false;
+
+    terrain_modified = !old_bounds.IsValid() ||
+      map->IsModifiedSince(terrain_serial, old_bounds);
+    new_serial = map->GetSerial().GetValue();
   }
 
   if (old_bounds.IsValid() && old_bounds.IsInside(new_bounds) &&
       !IsLargeSizeDifference(old_bounds, new_bounds) &&
-      terrain_serial == terrain.GetSerial() &&
+      !terrain_modified &&
       sunazimuth.CompareRoughly(last_sun_azimuth) &&
       !raster_renderer.UpdateQuantisation())
     /* no change since previous frame */
     return true;
 
 #else
-  if (compare_projection.Compare(map_projection) &&
-      terrain_serial == terrain.GetSerial() &&
+  const bool same_projection = compare_projection.Compare(map_projection);
+
+  bool terrain_modified;
+  unsigned new_serial;
+
+  {
+    RasterTerrain::Lease map(terrain);
+    terrain_modified = !same_projection ||
+      map->IsModifiedSince(terrain_serial, map_projection.GetScreenBounds());
+    new_serial = map->GetSerial().GetValue();
+  }
+
+  if (same_projection && !terrain_modified &&
       sunazimuth.CompareRoughly(last_sun_azimuth))
     /* no change since previous frame */
     return true;
@@ -346,7 +367,10 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
   compare_projection = CompareProjection(map_projection);
 #endif
 
-  terrain_serial = terrain.GetSerial();
+  /* if the terrain has not changed, the old height matrix may be
+     reused partially */
+  const bool same_terrain = !terrain_modified;
+  terrain_serial = new_serial;
 
   last_sun_azimuth = sunazimuth;
 
@@ -368,9 +392,17 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
 
   {
     RasterTerrain::Lease map(terrain);
-    raster_renderer.ScanMap(map, map_projection);
+    raster_renderer.ScanMap(map, map_projection, same_terrain);
   }
 
+  if (statistics_clock.CheckUpdate(10 * 60 * 1000))
+    LogFormat("Terrain renderer: %u full scans, %u incremental scans, "
+              "%u full images, %u incremental images",
+              raster_renderer.GetFullScanCount(),
+              raster_renderer.GetIncrementalScanCount(),
+              raster_renderer.GetFullImageCount(),
+              raster_renderer.GetIncrementalImageCount());
+
   raster_renderer.GenerateImage(do_shading, height_scale,
                                 settings.contrast, settings.brightness,
                                 sunazimuth,
@@ -25,7 +25,7 @@ Copyright_License {
 #define XCSOAR_TERRAIN_RENDERER_HPP
 
 #include "RasterRenderer.hpp"
-#include "Util/Serial.hpp"
+#include "Time/PeriodClock.hpp"
 #include "Terrain/TerrainSettings.hpp"
 
 #ifndef ENABLE_OPENGL
@@ -40,7 +40,16 @@ struct ColorRamp;
 class TerrainRenderer {
   const RasterTerrain &terrain;
 
-  Serial terrain_serial;
+  /**
+   * The value of RasterMap::GetSerial() when the terrain was last
+   * scanned.
+   */
+  unsigned terrain_serial = 0;
+
+  /**
+   * Limits the rate of the RasterRenderer statistics log messages.
+   */
+  PeriodClock statistics_clock;
 
 protected:
   struct TerrainRendererSettings settings;
@@ -82,6 +91,10 @@ public:
     settings = _settings;
   }
 
+  const RasterRenderer &GetRasterRenderer() const {
+    return raster_renderer;
+  }
+
   /**
    * @return true if an image has been renderered and Draw() may be
    * called
@@ -25,6 +25,7 @@ Copyright_License {
 #include "RasterTerrain.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Thread/Util.hpp"
+#include "LogFile.hpp"
 
 TerrainThread::TerrainThread(RasterTerrain &_terrain,
                              std::function<void()> &&_callback)
@@ -33,6 +34,13 @@ TerrainThread::TerrainThread(RasterTerrain &_terrain,
 
 void
 TerrainThread::Trigger(const WindowProjection &projection)
+{
+  Trigger(projection, TerrainPrefetch());
+}
+
+void
+TerrainThread::Trigger(const WindowProjection &projection,
+                       const TerrainPrefetch &prefetch)
 {
   assert(projection.IsValid());
 
@@ -41,11 +49,15 @@ TerrainThread::Trigger(const WindowProjection &projection)
   GeoPoint center = projection.GetGeoScreenCenter();
   auto radius = projection.GetScreenWidthMeters() / 2;
   if (last_center.IsValid() && last_radius >= radius &&
-      last_center.DistanceS(center) < 1000)
+      last_center.DistanceS(center) < 1000 &&
+      (prefetch.empty() ||
+       (last_prefetch.IsValid() &&
+        last_prefetch.DistanceS(prefetch.front()) < 1000)))
     return;
 
   next_center = center;
   next_radius = radius;
+  next_prefetch = prefetch;
   StandbyThread::Trigger();
 }
 
@@ -58,14 +70,26 @@ TerrainThread::Tick()
   while (next_center.IsValid() && again && !IsStopped()) {
     const GeoPoint center = next_center;
     const auto radius = next_radius;
+    const TerrainPrefetch prefetch = next_prefetch;
 
     {
       const ScopeUnlock unlock(mutex);
-      again = terrain.UpdateTiles(center, radius);
+      again = terrain.UpdateTiles(center, radius, &prefetch);
     }
 
     last_center = center;
     last_radius = radius;
+    last_prefetch = prefetch.empty()
+      ? GeoPoint::Invalid()
+      : prefetch.front();
+  }
+
+  if (statistics_clock.CheckUpdate(10 * 60 * 1000)) {
+    const ScopeUnlock unlock(mutex);
+    const auto s = terrain.GetPrefetchStatistics();
+    if (s.hits > 0 || s.misses > 0)
+      LogFormat("Terrain prefetch: %u hits, %u misses, %u tiles requested",
+                s.hits, s.misses, s.requested);
   }
 
   /* notify the client */
@@ -25,7 +25,9 @@ Copyright_License {
 #define XCSOAR_TERRAIN_THREAD_HPP
 
 #include "Thread/StandbyThread.hpp"
+#include "Prefetch.hpp"
 #include "Geo/GeoPoint.hpp"
+#include "Time/PeriodClock.hpp"
 
 #include <functional>
 
@@ -46,6 +48,19 @@ class TerrainThread final : private StandbyThread {
   GeoPoint next_center;
   double next_radius;
 
+  /**
+   * The first location of the last prefetch list which was passed
+   * to RasterTerrain::UpdateTiles().
+   */
+  GeoPoint last_prefetch = GeoPoint::Invalid();
+
+  TerrainPrefetch next_prefetch;
+
+  /**
+   * Limits the rate of the #TerrainPrefetchStatistics log messages.
+   */
+  PeriodClock statistics_clock;
+
 public:
   TerrainThread(RasterTerrain &_terrain, std::function<void()> &&_callback);
 
@@ -53,6 +68,14 @@ public:
 
   void Trigger(const WindowProjection &projection);
 
+  /**
+   * Like Trigger(const WindowProjection &), but additionally load
+   * the tiles around the given locations (e.g. the predicted track
+   * and the remaining task legs) in the background.
+   */
+  void Trigger(const WindowProjection &projection,
+               const TerrainPrefetch &prefetch);
+
 private:
   /* virtual methods from class StandbyThread*/
   void Tick() override;
@@ -0,0 +1,281 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_RCU_POINTER_HPP
+#define XCSOAR_THREAD_RCU_POINTER_HPP
+
+#include "Thread/Mutex.hpp"
+#include "Compiler.h"
+
+#include <atomic>
+#include <vector>
+#include <thread>
+
+#include <assert.h>
+#include <stdint.h>
+
+/**
+ * A pointer to an immutable object which is replaced by writers and
+ * read by any number of threads without blocking (read-copy-update).
+ *
+ * A reader announces the epoch it has seen in one of a fixed number of
+ * slots while it holds a #ReadGuard.  A writer swaps the pointer,
+ * advances the epoch and retires the old object; it is deleted by a
+ * later Publish() or Collect() call as soon as no slot refers to an
+ * older epoch.  Writers are serialised by a mutex which readers never
+ * touch.
+ */
+template<typename T>
+class RcuPointer {
+  /**
+   * The maximum number of concurrent readers.  A reader which finds
+   * all slots occupied spins until one becomes free.
+   */
+  static constexpr unsigned MAX_READERS = 16;
+
+  /**
+   * A slot value which means "no reader".
+   */
+  static constexpr uint64_t IDLE = 0;
+
+  std::atomic<const T *> current;
+
+  std::atomic<uint64_t> epoch;
+
+  /**
+   * The epoch announced by each reader, or #IDLE.  This is mutable
+   * because readers only have a const reference.
+   */
+  mutable std::atomic<uint64_t> readers[MAX_READERS];
+
+  struct Retired {
+    const T *value;
+
+    /**
+     * The epoch which was started when this object was replaced.
+     * Readers which have announced this epoch (or a newer one) cannot
+     * see it.
+     */
+    uint64_t epoch;
+  };
+
+  /**
+   * Protects #retired and serialises writers.
+   */
+  Mutex mutex;
+
+  std::vector<Retired> retired;
+
+public:
+  RcuPointer():current(nullptr), epoch(1) {
+    for (auto &i : readers)
+      i.store(IDLE, std::memory_order_relaxed);
+  }
+
+  RcuPointer(const RcuPointer &) = delete;
+  RcuPointer &operator=(const RcuPointer &) = delete;
+
+  /**
+   * The caller must ensure that there are no readers left.
+   */
+  ~RcuPointer() {
+#ifndef NDEBUG
+    for (const auto &i : readers)
+      assert(i.load() == IDLE);
+#endif
+
+    delete current.load();
+
+    for (const auto &i : retired)
+      delete i.value;
+  }
+
+  /**
+   * Read access to the current object.  The object remains valid
+   * until this guard is destroyed, even if a writer replaces it in the
+   * meantime.  Holding a guard does not block writers, but it delays
+   * the deletion of replaced objects; don't keep it longer than
+   * necessary.
+   */
+  class ReadGuard {
+    const RcuPointer &pointer;
+    unsigned slot;
+    const T *value;
+
+  public:
+    explicit ReadGuard(const RcuPointer &_pointer)
+      :pointer(_pointer), slot(pointer.Enter()),
+       value(pointer.current.load()) {}
+
+    ~ReadGuard() {
+      pointer.Leave(slot);
+    }
+
+    ReadGuard(const ReadGuard &) = delete;
+    ReadGuard &operator=(const ReadGuard &) = delete;
+
+    /**
+     * Has an object been published yet?
+     */
+    bool IsDefined() const {
+      return value != nullptr;
+    }
+
+    const T *get() const {
+      return value;
+    }
+
+    const T &operator*() const {
+      assert(value != nullptr);
+      return *value;
+    }
+
+    const T *operator->() const {
+      assert(value != nullptr);
+      return value;
+    }
+  };
+
+  /**
+   * Has an object been published yet?
+   */
+  gcc_pure
+  bool IsDefined() const {
+    return current.load() != nullptr;
+  }
+
+  /**
+   * Replace the current object.  Ownership of the new object is
+   * transferred to this class; the old one is deleted when the last
+   * reader which might see it is gone.
+   */
+  void Publish(const T *value) {
+    const ScopeLock protect(mutex);
+
+    const T *old = current.exchange(value);
+    const uint64_t new_epoch = epoch.fetch_add(1) + 1;
+
+    if (old != nullptr)
+      retired.push_back({old, new_epoch});
+
+    CollectLocked();
+  }
+
+  /**
+   * Like Publish(), but instead of deleting the most recently
+   * replaced object when no reader can see it any more, return it to
+   * the caller, who may modify it and pass it to the next call.  This
+   * saves an allocation, and the object may be updated incrementally.
+   * All objects passed to this method must have been allocated
+   * non-const.
+   *
+   * @return the recycled object (owned by the caller) or nullptr
+   */
+  T *PublishAndRecycle(const T *value) {
+    const ScopeLock protect(mutex);
+
+    const T *old = current.exchange(value);
+    const uint64_t new_epoch = epoch.fetch_add(1) + 1;
+
+    if (old != nullptr)
+      retired.push_back({old, new_epoch});
+
+    const T *recycled = nullptr;
+    if (!retired.empty() &&
+        retired.back().epoch <= GetOldestReaderEpoch()) {
+      recycled = retired.back().value;
+      retired.pop_back();
+    }
+
+    CollectLocked();
+    return const_cast<T *>(recycled);
+  }
+
+  /**
+   * Delete replaced objects which can no longer be seen by any
+   * reader.
+   *
+   * @return the number of objects which are still waiting for readers
+   */
+  unsigned Collect() {
+    const ScopeLock protect(mutex);
+    CollectLocked();
+    return retired.size();
+  }
+
+private:
+  unsigned Enter() const {
+    while (true) {
+      const uint64_t e = epoch.load();
+
+      for (unsigned i = 0; i < MAX_READERS; ++i) {
+        uint64_t expected = IDLE;
+        if (readers[i].compare_exchange_strong(expected, e))
+          return i;
+      }
+
+      /* all slots are occupied; this should never happen with the
+         small number of threads XCSoar has */
+      std::this_thread::yield();
+    }
+  }
+
+  void Leave(unsigned slot) const {
+    readers[slot].store(IDLE);
+  }
+
+  /**
+   * Returns the oldest epoch announced by a reader, or the current
+   * epoch if there is no reader.
+   */
+  gcc_pure
+  uint64_t GetOldestReaderEpoch() const {
+    uint64_t oldest = epoch.load();
+    for (const auto &i : readers) {
+      const uint64_t e = i.load();
+      if (e != IDLE && e < oldest)
+        oldest = e;
+    }
+
+    return oldest;
+  }
+
+  void CollectLocked() {
+    if (retired.empty())
+      return;
+
+    const uint64_t oldest = GetOldestReaderEpoch();
+
+    auto i = retired.begin();
+    for (auto j = retired.begin(); j != retired.end(); ++j) {
+      if (j->epoch <= oldest)
+        delete j->value;
+      else
+        *i++ = *j;
+    }
+
+    retired.erase(i, retired.end());
+  }
+};
+
+#endif
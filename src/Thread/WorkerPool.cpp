@@ -0,0 +1,168 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/WorkerPool.hpp"
+#include "Util/Clamp.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include <assert.h>
+
+unsigned
+WorkerPool::GetDefaultConcurrency()
+{
+  const unsigned n = std::thread::hardware_concurrency();
+  return Clamp(n, 1u, MAX_WORKERS + 1);
+}
+
+static WorkerPool *shared_pool;
+
+void
+WorkerPool::InitialiseShared()
+{
+  assert(shared_pool == nullptr);
+
+  shared_pool = new WorkerPool();
+}
+
+void
+WorkerPool::DeinitialiseShared()
+{
+  assert(shared_pool != nullptr);
+
+  delete shared_pool;
+  shared_pool = nullptr;
+}
+
+WorkerPool &
+WorkerPool::GetShared()
+{
+  assert(shared_pool != nullptr);
+
+  return *shared_pool;
+}
+
+WorkerPool::WorkerPool(unsigned concurrency)
+  :n_workers(std::min(std::max(concurrency, 1u) - 1, unsigned(MAX_WORKERS))) {}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    const ScopeLock protect(mutex);
+    stop = true;
+    work_cond.broadcast();
+  }
+
+  for (unsigned i = 0; i < n_running; ++i)
+    workers[i]->Join();
+}
+
+void
+WorkerPool::Launch()
+{
+  assert(!launched);
+  launched = true;
+
+  for (unsigned i = 0; i < n_workers; ++i) {
+    workers[i].reset(new Worker(*this));
+    if (!workers[i]->Start()) {
+      /* continue with the threads we have; the calling thread does
+         the rest */
+      workers[i].reset();
+      break;
+    }
+
+    ++n_running;
+  }
+}
+
+void
+WorkerPool::RunParts()
+{
+  assert(function != nullptr);
+
+  const auto &f = *function;
+  while (next_part < n_parts) {
+    const unsigned i = next_part++;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      f(i);
+    }
+
+    if (++n_done == n_parts)
+      done_cond.broadcast();
+  }
+}
+
+void
+WorkerPool::Run(unsigned n, const std::function<void(unsigned)> &f)
+{
+  if (n_workers == 0 || n <= 1) {
+    for (unsigned i = 0; i < n; ++i)
+      f(i);
+    return;
+  }
+
+  const ScopeLock protect(mutex);
+
+  if (function != nullptr) {
+    /* the pool is busy with the job of another thread; don't wait
+       for it */
+    const ScopeUnlock unlock(mutex);
+    for (unsigned i = 0; i < n; ++i)
+      f(i);
+    return;
+  }
+
+  if (!launched)
+    /* the new threads block on the mutex until we wait for the
+       job */
+    Launch();
+
+  function = &f;
+  n_parts = n;
+  next_part = n_done = 0;
+  work_cond.broadcast();
+
+  RunParts();
+
+  while (n_done < n_parts)
+    done_cond.wait(mutex);
+
+  function = nullptr;
+}
+
+void
+WorkerPool::WorkerRun()
+{
+  const ScopeLock protect(mutex);
+
+  while (!stop) {
+    if (function != nullptr && next_part < n_parts)
+      RunParts();
+    else
+      work_cond.wait(mutex);
+  }
+}
@@ -0,0 +1,177 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_WORKER_POOL_HPP
+#define XCSOAR_THREAD_WORKER_POOL_HPP
+
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "Cond.hxx"
+
+#include <functional>
+#include <memory>
+
+/**
+ * A small fixed pool of threads which runs the parts of a job in
+ * parallel.  The calling thread works on the job, too, and
+ * Run() returns only after all parts have been finished.
+ *
+ * The threads are launched on the first Run() call.  Run() may be
+ * called by several threads; while the pool is busy, other callers
+ * do their job alone.
+ */
+class WorkerPool {
+  static constexpr unsigned MAX_WORKERS = 7;
+
+  class Worker final : public Thread {
+    WorkerPool &pool;
+
+  public:
+    Worker(WorkerPool &_pool):Thread("Worker"), pool(_pool) {}
+
+  protected:
+    /* virtual methods from class Thread */
+    void Run() override {
+      pool.WorkerRun();
+    }
+  };
+
+  /**
+   * The number of threads which will be launched (excluding the
+   * calling thread).
+   */
+  const unsigned n_workers;
+
+  std::unique_ptr<Worker> workers[MAX_WORKERS];
+
+  /**
+   * The number of threads which have been launched.
+   */
+  unsigned n_running = 0;
+
+  bool launched = false;
+
+  Mutex mutex;
+
+  /**
+   * Wakes up the workers when a new job is available or when they
+   * shall stop.
+   */
+  Cond work_cond;
+
+  /**
+   * Signalled when the last part of the job is finished.
+   */
+  Cond done_cond;
+
+  /**
+   * The current job, or nullptr if idle.
+   */
+  const std::function<void(unsigned)> *function = nullptr;
+
+  unsigned n_parts, next_part, n_done;
+
+  bool stop = false;
+
+public:
+  /**
+   * @param concurrency the maximum number of threads working on one
+   * job, including the calling thread; 1 disables parallelism
+   */
+  explicit WorkerPool(unsigned concurrency=GetDefaultConcurrency());
+
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /**
+   * Returns the number of processor cores, but at most the number of
+   * threads this class supports.
+   */
+  gcc_pure
+  static unsigned GetDefaultConcurrency();
+
+  /**
+   * Create the process-wide pool returned by GetShared(), with the
+   * default concurrency.  Call this at startup, before any other
+   * thread is launched.
+   */
+  static void InitialiseShared();
+
+  /**
+   * Stop the threads of the process-wide pool and delete it.  Call
+   * this at shutdown, after all users are gone.
+   */
+  static void DeinitialiseShared();
+
+  /**
+   * Returns the process-wide pool created by InitialiseShared().
+   * Use it for jobs which run often (e.g. rendering), instead of
+   * creating more threads for each user.
+   */
+  gcc_pure
+  static WorkerPool &GetShared();
+
+  /**
+   * The number of threads working on one job, including the calling
+   * thread.
+   */
+  unsigned GetConcurrency() const {
+    return n_workers + 1;
+  }
+
+  /**
+   * Call the function once for each part number (0 to n-1) and wait
+   * for completion.  The order in which the parts are run is
+   * undefined, and they may run concurrently.
+   *
+   * If the pool is already working on a job of another thread, all
+   * parts are run in the calling thread.
+   */
+  void Run(unsigned n, const std::function<void(unsigned)> &f);
+
+private:
+  void Launch();
+
+  /**
+   * Run parts of the current job until all have been assigned.
+   * Caller must lock the mutex.
+   */
+  void RunParts();
+
+  void WorkerRun();
+};
+
+class ScopeGlobalWorkerPool {
+public:
+  ScopeGlobalWorkerPool() {
+    WorkerPool::InitialiseShared();
+  }
+
+  ~ScopeGlobalWorkerPool() {
+    WorkerPool::DeinitialiseShared();
+  }
+};
+
+#endif
@@ -52,6 +52,17 @@ public:
     this->c.clear();
   }
 
+  /**
+   * Iterate over all queued elements, in no particular order.
+   */
+  typename Container::const_iterator begin() const {
+    return this->c.begin();
+  }
+
+  typename Container::const_iterator end() const {
+    return this->c.end();
+  }
+
 #if defined(_GLIBCXX_DEBUG) && defined(__GLIBCXX__) && __GLIBCXX__ == 20130322
   using std::priority_queue<T, Container, Compare>::size;
 
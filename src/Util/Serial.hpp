@@ -47,6 +47,14 @@ public:
   bool operator!=(const Serial other) const {
     return value != other.value;
   }
+
+  /**
+   * Returns the raw value, which may be passed to another thread in
+   * a trivial struct.
+   */
+  unsigned GetValue() const {
+    return value;
+  }
 };
 
 #endif
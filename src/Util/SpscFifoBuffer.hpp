@@ -0,0 +1,153 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_UTIL_SPSC_FIFO_BUFFER_HPP
+#define XCSOAR_UTIL_SPSC_FIFO_BUFFER_HPP
+
+#include "WritableBuffer.hxx"
+#include "ConstBuffer.hxx"
+
+#include <atomic>
+#include <algorithm>
+
+#include <assert.h>
+#include <stddef.h>
+
+/**
+ * A lock-free first-in-first-out ring buffer for exactly one producer
+ * thread and one consumer thread.  The producer appends with Write()
+ * / Append() or Push(); the consumer reads with Read() / Consume().
+ * Neither side ever blocks or takes a lock.
+ *
+ * @param size the capacity; must be a power of two
+ */
+template<class T, size_t size>
+class SpscFifoBuffer {
+  static_assert(size > 0 && (size & (size - 1)) == 0,
+                "Size must be a power of two");
+
+public:
+  typedef size_t size_type;
+  typedef WritableBuffer<T> Range;
+
+private:
+  /**
+   * The number of items ever consumed and appended.  These counters
+   * only grow (and wrap around); the index into #data is obtained by
+   * masking.  #head is written only by the consumer, #tail only by
+   * the producer.
+   */
+  std::atomic<size_type> head, tail;
+
+  T data[size];
+
+public:
+  SpscFifoBuffer():head(0), tail(0) {}
+
+  SpscFifoBuffer(const SpscFifoBuffer &) = delete;
+  SpscFifoBuffer &operator=(const SpscFifoBuffer &) = delete;
+
+  static constexpr size_type GetCapacity() {
+    return size;
+  }
+
+  /**
+   * Returns the number of items in the buffer.  This may be called
+   * by any thread, but the result may be outdated already.
+   */
+  size_type GetSize() const {
+    return tail.load(std::memory_order_acquire) -
+      head.load(std::memory_order_acquire);
+  }
+
+  bool IsEmpty() const {
+    return GetSize() == 0;
+  }
+
+  /**
+   * Producer: returns the contiguous free space at the tail.  It may
+   * be smaller than the total free space, because it ends at the end
+   * of the internal array.  When you are finished, call Append().
+   */
+  Range Write() {
+    const size_type t = tail.load(std::memory_order_relaxed);
+    const size_type h = head.load(std::memory_order_acquire);
+    const size_type i = t & (size - 1);
+    return Range(data + i, std::min(size - (t - h), size - i));
+  }
+
+  /**
+   * Producer: publish items written to the buffer returned by
+   * Write().
+   */
+  void Append(size_type n) {
+    const size_type t = tail.load(std::memory_order_relaxed);
+    assert(n <= size - (t - head.load(std::memory_order_relaxed)));
+    tail.store(t + n, std::memory_order_release);
+  }
+
+  /**
+   * Producer: copy all of the given items into the buffer, wrapping
+   * around at the end of the internal array if necessary.
+   *
+   * @return false if there was not enough room (nothing was copied)
+   */
+  bool Push(ConstBuffer<T> src) {
+    const size_type t = tail.load(std::memory_order_relaxed);
+    const size_type h = head.load(std::memory_order_acquire);
+    if (src.size > size - (t - h))
+      return false;
+
+    const size_type i = t & (size - 1);
+    const size_type first = std::min(src.size, size - i);
+    std::copy_n(src.data, first, data + i);
+    std::copy_n(src.data + first, src.size - first, data);
+
+    tail.store(t + src.size, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumer: returns the contiguous readable items at the head.  It
+   * may be fewer than GetSize(), because it ends at the end of the
+   * internal array; call again after Consume() to get the rest.
+   */
+  Range Read() {
+    const size_type h = head.load(std::memory_order_relaxed);
+    const size_type t = tail.load(std::memory_order_acquire);
+    const size_type i = h & (size - 1);
+    return Range(data + i, std::min(t - h, size - i));
+  }
+
+  /**
+   * Consumer: marks items returned by Read() as consumed, which
+   * makes room for the producer.
+   */
+  void Consume(size_type n) {
+    const size_type h = head.load(std::memory_order_relaxed);
+    assert(n <= tail.load(std::memory_order_relaxed) - h);
+    head.store(h + n, std::memory_order_release);
+  }
+};
+
+#endif
@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "WaypointFilter.hpp"
 #include "Waypoint/Waypoint.hpp"
+#include "Waypoint/WaypointNameIndex.hpp"
+#include "Util/StringAPI.hxx"
 #include "Engine/Task/Shapes/FAITrianglePointValidator.hpp"
 
 inline bool
@@ -104,7 +106,14 @@ WaypointFilter::CompareDirection(const Waypoint &waypoint,
 inline bool
 WaypointFilter::CompareName(const Waypoint &waypoint, const TCHAR *name)
 {
-  return StringIsEqualIgnoreCase(waypoint.name.c_str(), name, _tcslen(name));
+  /* match anywhere in the name, like Waypoints::VisitNameMatches() */
+  TCHAR normalized_name[waypoint.name.length() + 1];
+  WaypointNameIndex::Normalize(normalized_name, waypoint.name.c_str());
+
+  TCHAR normalized[_tcslen(name) + 1];
+  WaypointNameIndex::Normalize(normalized, name);
+
+  return StringFind(normalized_name, normalized) != nullptr;
 }
 
 inline bool
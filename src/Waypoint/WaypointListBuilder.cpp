@@ -29,6 +29,8 @@ Copyright_License {
 void WaypointListBuilder::Visit(const Waypoints &waypoints) {
   if (filter.distance > 0)
     waypoints.VisitWithinRange(location, filter.distance, *this);
+  else if (name_search != nullptr && !filter.name.empty())
+    waypoints.VisitNameMatches(filter.name, *this, *name_search);
   else
     waypoints.VisitNamePrefix(filter.name, *this);
 }
@@ -27,6 +27,7 @@ Copyright_License {
 #include "Geo/GeoPoint.hpp"
 #include "Engine/Task/Shapes/FAITrianglePointValidator.hpp"
 #include "Engine/Waypoint/WaypointVisitor.hpp"
+#include "Engine/Waypoint/WaypointNameIndex.hpp"
 
 struct WaypointFilter;
 class WaypointList;
@@ -38,6 +39,8 @@ class WaypointListBuilder final : public WaypointVisitor {
   WaypointList &list;
   const FAITrianglePointValidator triangle_validator;
 
+  WaypointNameIndex::Search *name_search = nullptr;
+
 public:
   WaypointListBuilder(const WaypointFilter &_filter,
                       GeoPoint _location, WaypointList &_list,
@@ -45,6 +48,15 @@ public:
     :filter(_filter), location(_location), list(_list),
      triangle_validator(ordered_task, ordered_task_index) {}
 
+  /**
+   * Match the name filter anywhere in the name, best matches first
+   * (see Waypoints::VisitNameMatches()), instead of only at the
+   * beginning.
+   */
+  void SetNameSearch(WaypointNameIndex::Search &_search) {
+    name_search = &_search;
+  }
+
   void Visit(const Waypoints &waypoints);
 
   /* virtual methods from class WaypointVisitor */
@@ -22,8 +22,78 @@ Copyright_License {
 */
 
 #include "WaypointReaderBase.hpp"
+#include "Waypoint/Waypoints.hpp"
 #include "Operation/Operation.hpp"
 #include "IO/LineReader.hpp"
+#include "Thread/WorkerPool.hpp"
+#include "Util/StringAPI.hxx"
+
+#include <algorithm>
+#include <memory>
+
+/**
+ * The number of lines parsed by one thread in one piece.
+ */
+static constexpr unsigned CHUNK_LINES = 1024;
+
+/**
+ * The maximum number of chunks read into memory at a time.
+ */
+static constexpr unsigned MAX_CHUNKS = 32;
+
+/**
+ * Stores a number of lines in one contiguous buffer, so they can be
+ * handed to other threads.
+ */
+class WaypointReaderBase::LineBuffer {
+  std::vector<TCHAR> text;
+  std::vector<size_t> start;
+
+public:
+  void Clear() {
+    text.clear();
+    start.clear();
+  }
+
+  unsigned size() const {
+    return start.size();
+  }
+
+  void Append(const TCHAR *line) {
+    start.push_back(text.size());
+    text.insert(text.end(), line, line + StringLength(line) + 1);
+  }
+
+  const TCHAR *operator[](unsigned i) const {
+    return &text[start[i]];
+  }
+
+  /**
+   * Read up to the given number of lines.
+   *
+   * @return false if the end of the file has been reached
+   */
+  bool Read(TLineReader &reader, unsigned max_lines) {
+    while (size() < max_lines) {
+      const TCHAR *line = reader.ReadLine();
+      if (line == nullptr)
+        return false;
+
+      Append(line);
+    }
+
+    return true;
+  }
+};
+
+inline void
+WaypointReaderBase::ParseLines(const LineBuffer &lines,
+                               unsigned begin, unsigned end,
+                               std::vector<Waypoint> &waypoints)
+{
+  for (unsigned i = begin; i < end && !IsFinished(); ++i)
+    ParseLine(lines[i], waypoints);
+}
 
 void
 WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
@@ -32,13 +102,56 @@ WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
   const long filesize = std::max(reader.GetSize(), 1l);
   operation.SetProgressRange(100);
 
-  // Read through the lines of the file
-  TCHAR *line;
-  for (unsigned i = 0; (line = reader.ReadLine()) != nullptr; i++) {
-    // and parse them
-    ParseLine(line, way_points);
+  LineBuffer lines;
+  std::vector<Waypoint> waypoints;
+
+  /* parse the first chunk in this thread, to let this object see the
+     header */
+  bool more = lines.Read(reader, CHUNK_LINES);
+  ParseLines(lines, 0, lines.size(), waypoints);
+
+  for (auto &i : waypoints)
+    way_points.Append(std::move(i));
+
+  operation.SetProgressPosition(reader.Tell() * 100 / filesize);
+
+  if (!more || IsFinished())
+    return;
+
+  /* parse the rest in parallel, with a copy of this object per
+     chunk; while the shared pool is busy (e.g. rendering terrain),
+     this thread parses all chunks alone */
+
+  WorkerPool &pool = WorkerPool::GetShared();
+  std::vector<std::unique_ptr<WaypointReaderBase>> clones(MAX_CHUNKS);
+  std::vector<std::vector<Waypoint>> results(MAX_CHUNKS);
+
+  while (more) {
+    lines.Clear();
+    more = lines.Read(reader, CHUNK_LINES * MAX_CHUNKS);
+
+    const unsigned n_chunks = (lines.size() + CHUNK_LINES - 1) / CHUNK_LINES;
+    for (unsigned i = 0; i < n_chunks; ++i)
+      clones[i].reset(Clone());
+
+    pool.Run(n_chunks, [this, &lines, &clones, &results](unsigned chunk){
+        const unsigned begin = chunk * CHUNK_LINES;
+        const unsigned end = std::min(begin + CHUNK_LINES, lines.size());
+        auto &dest = results[chunk];
+        dest.clear();
+        clones[chunk]->ParseLines(lines, begin, end, dest);
+      });
+
+    /* merge in file order; stop at the chunk which has seen the end
+       of the waypoint section */
+    for (unsigned i = 0; i < n_chunks; ++i) {
+      for (auto &j : results[i])
+        way_points.Append(std::move(j));
+
+      if (clones[i]->IsFinished())
+        return;
+    }
 
-    if ((i & 0x3f) == 0)
-      operation.SetProgressPosition(reader.Tell() * 100 / filesize);
+    operation.SetProgressPosition(reader.Tell() * 100 / filesize);
   }
 }
@@ -27,6 +27,8 @@ Copyright_License {
 
 #include "Factory.hpp"
 
+#include <vector>
+
 #include <tchar.h>
 
 class Waypoints;
@@ -47,6 +49,12 @@ public:
 
   /**
    * Parses a waypoint file into the given waypoint list
+   *
+   * The first lines (which may contain a header) are parsed by this
+   * object.  The rest of a large file is split into chunks of lines
+   * which are parsed in parallel by copies of this object (see
+   * Clone()).
+   *
    * @param way_points The waypoint list to fill
    * @return True if the waypoint file parsing was okay, False otherwise
    */
@@ -54,15 +62,35 @@ public:
              OperationEnvironment &operation);
 
 protected:
+  /**
+   * Create a copy of this object, including the state obtained from
+   * the lines parsed so far.
+   */
+  virtual WaypointReaderBase *Clone() const = 0;
+
+  /**
+   * Has this object seen the end of the waypoint section, i.e. will
+   * it ignore all following lines?
+   */
+  virtual bool IsFinished() const {
+    return false;
+  }
+
   /**
    * Parse a file line
    * @param line The line to parse
-   * @param linenum The line number in the file
-   * @param way_points The waypoint list to fill
+   * @param waypoints The list to append the new waypoint to
    * @return True if the line was parsed correctly or ignored, False if
    * parsing error occured
    */
-  virtual bool ParseLine(const TCHAR* line, Waypoints &way_points) = 0;
+  virtual bool ParseLine(const TCHAR* line,
+                         std::vector<Waypoint> &waypoints) = 0;
+
+private:
+  class LineBuffer;
+
+  void ParseLines(const LineBuffer &lines, unsigned begin, unsigned end,
+                  std::vector<Waypoint> &waypoints);
 };
 
 #endif
@@ -67,7 +67,8 @@ ParseString(const TCHAR *src, tstring &dest)
 }
 
 bool
-WaypointReaderOzi::ParseLine(const TCHAR *line, Waypoints &way_points)
+WaypointReaderOzi::ParseLine(const TCHAR *line,
+                             std::vector<Waypoint> &way_points)
 {
   if (line[0] == '\0')
     return true;
@@ -121,7 +122,7 @@ WaypointReaderOzi::ParseLine(const TCHAR *line, Waypoints &way_points)
   // Description
   ParseString(params[10], new_waypoint.comment);
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.push_back(std::move(new_waypoint));
   return true;
 }
 
@@ -38,7 +38,12 @@ public:
 
 protected:
   /* virtual methods from class WaypointReaderBase */
-  bool ParseLine(const TCHAR *line, Waypoints &way_points) override;
+  WaypointReaderBase *Clone() const override {
+    return new WaypointReaderOzi(*this);
+  }
+
+  bool ParseLine(const TCHAR *line,
+                 std::vector<Waypoint> &waypoints) override;
 };
 
 #endif
@@ -147,7 +147,8 @@ ParseFlagsFromDescription(const TCHAR* src, Waypoint &dest)
 }
 
 bool
-WaypointReaderZander::ParseLine(const TCHAR* line, Waypoints &way_points)
+WaypointReaderZander::ParseLine(const TCHAR* line,
+                                std::vector<Waypoint> &way_points)
 {
   // If (end-of-file or comment)
   if (line[0] == '\0' || line[0] == '*')
@@ -193,6 +194,6 @@ WaypointReaderZander::ParseLine(const TCHAR* line, Waypoints &way_points)
     if (len < 36 || !ParseFlagsFromDescription(line + 35, new_waypoint))
       new_waypoint.flags.turn_point = true;
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.push_back(std::move(new_waypoint));
   return true;
 }
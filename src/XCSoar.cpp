@@ -46,6 +46,7 @@ Copyright_License {
 #include "Audio/GlobalVolumeController.hpp"
 #include "OS/Args.hpp"
 #include "IO/Async/GlobalAsioThread.hpp"
+#include "Thread/WorkerPool.hpp"
 
 #ifndef NDEBUG
 #include "Thread/Thread.hpp"
@@ -111,6 +112,7 @@ Main()
   InitLanguage();
 
   ScopeGlobalAsioThread global_asio_thread;
+  ScopeGlobalWorkerPool global_worker_pool;
 
   ScopeGlobalPCMMixer global_pcm_mixer;
   ScopeGlobalPCMResourcePlayer global_pcm_resouce_player;
@@ -0,0 +1,241 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Run random Inside() and Intersects() queries on the airspaces
+ * generated by harness_airspace plus a number of polygons with many
+ * vertices, verify the results against a plain walk over all edges,
+ * and compare the speed of both.
+ */
+
+#include "harness_airspace.hpp"
+#include "Engine/Airspace/AirspaceIntersectSort.hpp"
+#include "Engine/Airspace/AirspaceIntersectionVector.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/Flat/FlatRay.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_AIRSPACES = 2000;
+static constexpr unsigned N_LARGE_POLYGONS = 50;
+static constexpr unsigned N_QUERIES = 20000;
+
+typedef std::chrono::steady_clock Clock;
+
+static const GeoPoint center(Angle::Degrees(7.7), Angle::Degrees(51.05));
+
+static double
+RandomDegrees(double range)
+{
+  return (rand() % 100000) * range / 100000 - range / 2;
+}
+
+static GeoPoint
+RandomLocation()
+{
+  return GeoPoint(center.longitude + Angle::Degrees(RandomDegrees(1.4)),
+                  center.latitude + Angle::Degrees(RandomDegrees(1.4)));
+}
+
+/**
+ * Create a star shaped (not convex) polygon with the given number of
+ * vertices.
+ */
+static AirspacePolygon *
+CreateLargePolygon(unsigned n)
+{
+  const GeoPoint c = RandomLocation();
+  const double radius = 0.05 + RandomDegrees(0.2) + 0.1;
+
+  std::vector<GeoPoint> pts;
+  pts.reserve(n);
+  for (unsigned i = 0; i < n; ++i) {
+    const Angle a = Angle::FullCircle() * i / n;
+    const double r = radius * (0.6 + (rand() % 400) / 1000.);
+    pts.emplace_back(c.longitude + Angle::Degrees(r * a.cos()),
+                     c.latitude + Angle::Degrees(r * a.sin() * 0.6));
+  }
+
+  return new AirspacePolygon(pts);
+}
+
+/**
+ * The intersection test without an edge index.
+ */
+static AirspaceIntersectionVector
+ReferenceIntersects(const AbstractAirspace &as,
+                    const GeoPoint &start, const GeoPoint &end,
+                    const FlatProjection &projection)
+{
+  const FlatRay ray(projection.ProjectInteger(start),
+                    projection.ProjectInteger(end));
+
+  AirspaceIntersectSort sorter(start, as);
+
+  const SearchPointVector &border = as.GetPoints();
+  for (auto it = border.begin(); it + 1 != border.end(); ++it) {
+    const FlatRay r_seg(it->GetFlatLocation(), (it + 1)->GetFlatLocation());
+    auto t = ray.DistinctIntersection(r_seg);
+    if (t >= 0)
+      sorter.add(t, projection.Unproject(ray.Parametric(t)));
+  }
+
+  return sorter.all();
+}
+
+static bool
+IsSame(const AirspaceIntersectionVector &a,
+       const AirspaceIntersectionVector &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned i = 0; i < a.size(); ++i)
+    if (a[i].first != b[i].first || a[i].second != b[i].second)
+      return false;
+
+  return true;
+}
+
+struct Query {
+  GeoPoint a, b;
+  std::vector<const AbstractAirspace *> candidates;
+};
+
+template<typename F>
+static double
+Time(F &&f)
+{
+  const auto start = Clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int
+main(int argc, char **argv)
+{
+  srand(0);
+
+  Airspaces airspaces;
+  setup_airspaces(airspaces, center, N_AIRSPACES);
+
+  unsigned n_vertices = 0;
+  for (unsigned i = 0; i < N_LARGE_POLYGONS; ++i) {
+    AirspacePolygon *as = CreateLargePolygon(200 + rand() % 4000);
+    n_vertices += as->GetPoints().size();
+    airspaces.Add(as);
+  }
+
+  airspaces.Optimise();
+
+  const FlatProjection &projection = airspaces.GetProjection();
+
+  /* collect the polygons the R-tree returns for each query, like
+     AirspaceWarningManager does */
+  std::vector<Query> inside_queries(N_QUERIES), intersect_queries(N_QUERIES);
+  for (auto &q : inside_queries) {
+    q.a = RandomLocation();
+    for (const auto &i : airspaces.QueryWithinRange(q.a, 1))
+      if (i.GetAirspace().GetShape() == AbstractAirspace::Shape::POLYGON)
+        q.candidates.push_back(&i.GetAirspace());
+  }
+
+  for (auto &q : intersect_queries) {
+    q.a = RandomLocation();
+    q.b = q.a + GeoPoint(Angle::Degrees(RandomDegrees(0.3)),
+                         Angle::Degrees(RandomDegrees(0.2)));
+    for (const auto &i : airspaces.QueryIntersecting(q.a, q.b))
+      if (i.GetAirspace().GetShape() == AbstractAirspace::Shape::POLYGON)
+        q.candidates.push_back(&i.GetAirspace());
+  }
+
+  printf("%u airspaces, %u large polygons with %u vertices\n",
+         (unsigned)airspaces.GetSize(), N_LARGE_POLYGONS, n_vertices);
+
+  /* verify */
+
+  unsigned n_inside = 0, n_intersections = 0, n_errors = 0;
+  for (const auto &q : inside_queries) {
+    for (const auto *as : q.candidates) {
+      const bool inside = as->Inside(q.a);
+      if (inside != as->GetPoints().IsInside(q.a))
+        ++n_errors;
+      if (inside)
+        ++n_inside;
+    }
+  }
+
+  for (const auto &q : intersect_queries) {
+    for (const auto *as : q.candidates) {
+      const auto v = as->Intersects(q.a, q.b, projection);
+      if (!IsSame(v, ReferenceIntersects(*as, q.a, q.b, projection)))
+        ++n_errors;
+      n_intersections += v.size();
+    }
+  }
+
+  printf("%u inside, %u intersections, %u errors\n",
+         n_inside, n_intersections, n_errors);
+
+  /* measure */
+
+  unsigned sum = 0;
+
+  const double inside_reference = Time([&](){
+      for (const auto &q : inside_queries)
+        for (const auto *as : q.candidates)
+          sum += as->GetPoints().IsInside(q.a);
+    });
+
+  const double inside_indexed = Time([&](){
+      for (const auto &q : inside_queries)
+        for (const auto *as : q.candidates)
+          sum += as->Inside(q.a);
+    });
+
+  const double intersects_reference = Time([&](){
+      for (const auto &q : intersect_queries)
+        for (const auto *as : q.candidates)
+          sum += ReferenceIntersects(*as, q.a, q.b, projection).size();
+    });
+
+  const double intersects_indexed = Time([&](){
+      for (const auto &q : intersect_queries)
+        for (const auto *as : q.candidates)
+          sum += as->Intersects(q.a, q.b, projection).size();
+    });
+
+  printf("Inside:     %8.2f ms -> %8.2f ms\n", inside_reference, inside_indexed);
+  printf("Intersects: %8.2f ms -> %8.2f ms\n",
+         intersects_reference, intersects_indexed);
+
+  /* prevent gcc from optimizing the loops away */
+  if (sum == 0)
+    printf("\n");
+
+  return n_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * A stress test for #IGCWriter: log 10 Hz fixes (plus F records and
+ * events) for many hours of simulated time, and report the latency
+ * seen by the caller.  The simulated clock runs SPEEDUP times faster
+ * than the real one (0 means as fast as possible).  Run it on the
+ * storage medium to be tested, e.g. a SD card.
+ */
+
+#include "IGC/IGCWriter.hpp"
+#include "IGC/IGCFix.hpp"
+#include "Logger/GRecord.hpp"
+#include "NMEA/GPSState.hpp"
+#include "Time/BrokenDateTime.hpp"
+#include "OS/Args.hpp"
+#include "OS/Path.hpp"
+#include "Util/PrintException.hxx"
+
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef std::chrono::steady_clock Clock;
+
+struct LatencyStatistics {
+  const char *name;
+
+  unsigned n = 0;
+  double total = 0, worst = 0;
+
+  /** the number of calls which took longer than 1 ms */
+  unsigned n_slow = 0;
+
+  explicit LatencyStatistics(const char *_name):name(_name) {}
+
+  void Add(Clock::time_point start) {
+    const double us =
+      std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    ++n;
+    total += us;
+    worst = std::max(worst, us);
+    if (us > 1000)
+      ++n_slow;
+  }
+
+  void Print() const {
+    if (n == 0)
+      return;
+
+    printf("%-10s %8u calls, average %7.2f us, worst %9.1f us, %u over 1 ms\n",
+           name, n, total / n, worst, n_slow);
+  }
+};
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.igc [HOURS [SPEEDUP]]");
+  const auto path = args.ExpectNextPath();
+  const unsigned hours = args.IsEmpty()
+    ? 12
+    : strtoul(args.GetNext(), nullptr, 10);
+  const unsigned speedup = args.IsEmpty()
+    ? 1000
+    : strtoul(args.GetNext(), nullptr, 10);
+  args.ExpectEnd();
+
+  /* 10 Hz */
+  const unsigned n_fixes = hours * 3600 * 10;
+
+  LatencyStatistics point("B record"), frecord("F record"),
+    event("event"), stop("stop");
+
+  {
+    IGCWriter writer(path);
+
+    const BrokenDateTime start_time(2016, 7, 15, 8, 0, 0);
+    writer.WriteHeader(start_time, _T("Manfred Mustermann"), _T("Ventus"),
+                       _T("D-1234"), _T("MM"), "FOO", _T("Stress"), false);
+
+    IGCFix fix;
+    fix.Clear();
+    fix.gps_valid = true;
+    fix.gps_altitude = 1000;
+    fix.pressure_altitude = 1000;
+
+    int satellite_ids[GPSState::MAXSATELLITES];
+    std::fill_n(satellite_ids, GPSState::MAXSATELLITES, 0);
+    for (unsigned i = 0; i < 8; ++i)
+      satellite_ids[i] = i * 3 + 1;
+
+    const auto start_clock = Clock::now();
+
+    for (unsigned i = 0; i < n_fixes; ++i) {
+      const unsigned seconds = i / 10;
+
+      if (speedup > 0 && i % 10 == 0)
+        /* wait for the simulated clock once per simulated second */
+        std::this_thread::sleep_until(start_clock +
+                                      std::chrono::microseconds(seconds * 1000000ull / speedup));
+      fix.time = BrokenTime::FromSecondOfDayChecked(8 * 3600 + seconds);
+      fix.location = GeoPoint(Angle::Degrees(7 + (i % 36000) / 36000.),
+                              Angle::Degrees(51 + (i % 7200) / 72000.));
+      fix.gps_altitude = 1000 + (i % 2000);
+      fix.pressure_altitude = fix.gps_altitude - 30;
+
+      if (i % 3000 == 0) {
+        /* an F record every 5 minutes */
+        const auto start = Clock::now();
+        writer.LogFRecord(fix.time, satellite_ids);
+        frecord.Add(start);
+      }
+
+      const auto start = Clock::now();
+      if (i % 18000 == 0) {
+        /* an event (which includes a B record) every 30 minutes */
+        writer.LogEvent(fix, 10, 8, "PEV");
+        event.Add(start);
+      } else {
+        writer.LogPoint(fix, 10, 8);
+        point.Add(start);
+      }
+    }
+
+    const auto start = Clock::now();
+    writer.Flush();
+    writer.Sign();
+    stop.Add(start);
+
+    printf("at most %u bytes were pending\n",
+           (unsigned)writer.GetMaxPending());
+
+    /* the destructor waits until everything has been written */
+  }
+
+  printf("%u fixes (%u hours at 10 Hz, speedup %u)\n",
+         n_fixes, hours, speedup);
+  point.Print();
+  frecord.Print();
+  event.Print();
+  stop.Print();
+
+  GRecord grecord;
+  grecord.Initialize();
+  grecord.VerifyGRecordInFile(path);
+  printf("G record verified\n");
+
+  return EXIT_SUCCESS;
+} catch (const std::exception &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the throughput of the NMEA dispatch: feed all lines read
+ * from stdin (the same input as for FeedNMEA) to the given driver and
+ * to #NMEAParser, just like #DeviceDescriptor does.
+ */
+
+#include "NMEA/Info.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Driver.hpp"
+#include "Device/Register.hpp"
+#include "Device/Parser.hpp"
+#include "Device/Config.hpp"
+#include "OS/Args.hpp"
+#include "Util/StringUtil.hpp"
+#include "Util/ConvertString.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef std::chrono::steady_clock Clock;
+
+static double
+ElapsedNanoseconds(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+ * @param filter call Device::ParseNMEA() only for the sentences the
+ * driver has registered (like #DeviceDescriptor); if false, call it
+ * for all lines
+ * @return the number of lines which were parsed successfully
+ */
+static unsigned
+Run(const DeviceRegister &driver, Device *device,
+    const std::vector<std::string> &lines, unsigned iterations,
+    bool filter)
+{
+  NMEAParser parser;
+
+  NMEAInfo data;
+  data.Reset();
+
+  unsigned n_parsed = 0;
+
+  const auto start = Clock::now();
+
+  for (unsigned iteration = 0; iteration < iterations; ++iteration) {
+    for (const auto &i : lines) {
+      const char *line = i.c_str();
+
+      data.clock += 0.001;
+
+      if ((device != nullptr &&
+           (!filter || driver.WantsNMEASentence(line)) &&
+           device->ParseNMEA(line, data)) ||
+          parser.ParseLine(line, data))
+        ++n_parsed;
+    }
+  }
+
+  const double elapsed = ElapsedNanoseconds(start);
+  const unsigned n_lines = iterations * lines.size();
+  printf("%s: %.1f ns per line, %.0f lines/s\n",
+         filter ? "registered sentences" : "all lines",
+         elapsed / n_lines, n_lines * 1e9 / elapsed);
+
+  return n_parsed;
+}
+
+int main(int argc, char **argv)
+{
+  NarrowString<1024> usage;
+  usage = "DRIVER [ITERATIONS] <NMEA\n\n"
+          "Where DRIVER is one of:";
+  {
+    const DeviceRegister *driver;
+    for (unsigned i = 0; (driver = GetDriverByIndex(i)) != nullptr; ++i) {
+      WideToUTF8Converter driver_name(driver->name);
+      usage.AppendFormat("\n\t%s", (const char *)driver_name);
+    }
+  }
+
+  Args args(argc, argv, usage);
+  tstring driver_name = args.ExpectNextT();
+  const unsigned iterations = args.IsEmpty()
+    ? 100
+    : strtoul(args.GetNext(), nullptr, 10);
+  args.ExpectEnd();
+
+  const DeviceRegister *driver = FindDriverByName(driver_name.c_str());
+  if (driver == nullptr) {
+    _ftprintf(stderr, _T("No such driver: %s\n"), driver_name.c_str());
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> lines;
+
+  char buffer[1024];
+  while (fgets(buffer, sizeof(buffer), stdin) != nullptr) {
+    StripRight(buffer);
+    if (*buffer != 0)
+      lines.emplace_back(buffer);
+  }
+
+  if (lines.empty() || iterations == 0) {
+    fprintf(stderr, "No input\n");
+    return EXIT_FAILURE;
+  }
+
+  DeviceConfig config;
+  config.Clear();
+
+  NullPort port;
+  Device *device = driver->CreateOnPort != nullptr
+    ? driver->CreateOnPort(config, port)
+    : nullptr;
+
+  const unsigned n_parsed = Run(*driver, device, lines, iterations, true);
+  if (Run(*driver, device, lines, iterations, false) != n_parsed)
+    fprintf(stderr, "Warning: the sentence filter has changed the result\n");
+
+  delete device;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the time of an exhaustive triangle search on a flight, for
+ * each of the solvers derived from #OLCTriangle.
+ */
+
+#include "Contest/Solvers/OLCFAI.hpp"
+#include "Contest/Solvers/XContestTriangle.hpp"
+#include "Contest/ContestResult.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "OS/Args.hpp"
+#include "DebugReplay.hpp"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_ITERATIONS = 5;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @return the average duration of one exhaustive search in
+ * milliseconds
+ */
+static double
+Run(AbstractContest &solver, ContestResult &result)
+{
+  const auto start = Clock::now();
+
+  for (unsigned i = 0; i < N_ITERATIONS; ++i) {
+    solver.Reset();
+    solver.Solve(true);
+  }
+
+  const double elapsed =
+    std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  result = solver.GetBestResult();
+  return elapsed / N_ITERATIONS;
+}
+
+static void
+Run(const char *name, AbstractContest &solver)
+{
+  ContestResult result;
+  const double ms = Run(solver, result);
+  printf("%s: %.0f ms, score %.2f, distance %.3f km\n",
+         name, ms, result.score, result.distance / 1000);
+}
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "[DRIVER] FILE");
+  DebugReplay *replay = CreateDebugReplay(args);
+  if (replay == NULL)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  /* the same triangle trace as in RunOLCAnalysis */
+  Trace trace(0, Trace::null_time, 1024);
+
+  bool released = false;
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    if (!released && replay->Calculated().flight.release_time >= 0) {
+      released = true;
+      trace.EraseEarlierThan(replay->Calculated().flight.release_time);
+    }
+
+    trace.push_back(TracePoint(basic));
+  }
+
+  delete replay;
+
+  printf("%u trace points\n", trace.size());
+  if (trace.size() < 3)
+    return EXIT_FAILURE;
+
+  OLCFAI olc_fai(trace, false);
+  Run("OLC FAI", olc_fai);
+
+  XContestTriangle xcontest(trace, false, false);
+  Run("XContest triangle", xcontest);
+
+  XContestTriangle dhv_xc(trace, false, true);
+  Run("DHV-XC triangle", dhv_xc);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Render a fixed projection of a terrain file N times, serially and
+ * on the RasterRenderer worker pool, and report the time per frame.
+ */
+
+/* the RawBitmap needs an OpenGL context */
+#define ENABLE_MAIN_WINDOW
+#define ENABLE_CMDLINE
+#define USAGE "PATH [N]"
+
+#include "Main.hpp"
+#include "Terrain/RasterRenderer.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Screen/RawBitmap.hpp"
+#include "Screen/Ramp.hpp"
+#include "IO/ZipArchive.hpp"
+#include "OS/Path.hpp"
+#include "Operation/Operation.hpp"
+
+#include <chrono>
+
+#include <string.h>
+
+static AllocatedPath map_path = nullptr;
+static unsigned n_frames = 100;
+
+static constexpr ColorRamp ramp[NUM_COLOR_RAMP_LEVELS] = {
+  {0,           {0x70, 0xc0, 0xa7}},
+  {250,         {0xca, 0xe7, 0xb9}},
+  {500,         {0xf4, 0xea, 0xaf}},
+  {750,         {0xdc, 0xb2, 0x82}},
+  {1000,        {0xca, 0x8e, 0x72}},
+  {1250,        {0xde, 0xc8, 0xbd}},
+  {1500,        {0xe3, 0xe4, 0xe9}},
+  {1750,        {0xdb, 0xd9, 0xef}},
+  {2000,        {0xce, 0xcd, 0xf5}},
+  {2250,        {0xc2, 0xc1, 0xfa}},
+  {2500,        {0xb7, 0xb9, 0xff}},
+  {5000,        {0xff, 0xff, 0xff}},
+  {6000,        {0xff, 0xff, 0xff}},
+};
+
+static void
+ParseCommandLine(Args &args)
+{
+  map_path = args.ExpectNextPath();
+
+  if (!args.IsEmpty()) {
+    const char *s = args.GetNext();
+    char *endptr;
+    n_frames = ParseUnsigned(s, &endptr);
+    if (endptr == s || *endptr != 0 || n_frames == 0)
+      args.UsageError();
+  }
+}
+
+/**
+ * Render the projection #n_frames times and return the time per
+ * frame in milliseconds.
+ */
+static double
+Render(RasterRenderer &renderer, const RasterMap &map,
+       const WindowProjection &projection)
+{
+  renderer.PrepareColorTable(ramp, true, 4, 5);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned i = 0; i < n_frames; ++i) {
+    renderer.ScanMap(map, projection);
+    renderer.GenerateImage(true, 4, 64, 128, Angle::Degrees(45), true);
+  }
+
+  const std::chrono::duration<double, std::milli> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count() / n_frames;
+}
+
+static void
+Main()
+{
+  ScopeGlobalWorkerPool global_worker_pool;
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+
+  NullOperationEnvironment operation;
+  if (!LoadTerrainOverview(archive.get(), map.GetTileCache(),
+                           operation)) {
+    fprintf(stderr, "failed to load map\n");
+    return;
+  }
+
+  map.UpdateProjection();
+
+  const double radius = 20000;
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), radius);
+  } while (map.IsDirty());
+
+  const PixelSize size = main_window.GetSize();
+
+  WindowProjection projection;
+  projection.SetScreenSize(size);
+  projection.SetScaleFromRadius(radius);
+  projection.SetGeoLocation(map.GetMapCenter());
+  projection.SetScreenOrigin(size.cx / 2, size.cy / 2);
+  projection.UpdateScreenBounds();
+
+  WorkerPool serial_pool(1);
+  RasterRenderer serial(serial_pool);
+  RasterRenderer parallel;
+
+  const double serial_ms = Render(serial, map, projection);
+  const double parallel_ms = Render(parallel, map, projection);
+
+  printf("%ux%u, %u frames\n", serial.GetWidth(), serial.GetHeight(),
+         n_frames);
+  printf("serial: %.2f ms per frame\n", serial_ms);
+  printf("parallel (%u threads): %.2f ms per frame (%.1fx)\n",
+         WorkerPool::GetDefaultConcurrency(), parallel_ms,
+         serial_ms / parallel_ms);
+
+  const RawBitmap &a = serial.GetImage(), &b = parallel.GetImage();
+  if (memcmp(a.GetBuffer(), b.GetBuffer(),
+             sizeof(*a.GetBuffer()) * a.GetCorrectedWidth()
+             * serial.GetHeight()) != 0)
+    fprintf(stderr, "parallel image differs from serial image\n");
+}
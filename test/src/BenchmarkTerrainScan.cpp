@@ -0,0 +1,191 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the speed of RasterMap::ScanLine() with interpolation, and
+ * compare the SIMD interpolation kernel with the portable one.
+ */
+
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Terrain/Interpolate.hpp"
+#include "Geo/Math.hpp"
+#include "OS/Args.hpp"
+#include "IO/ZipArchive.hpp"
+#include "Operation/Operation.hpp"
+#include "Util/PrintException.hxx"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_LINES = 360;
+static constexpr unsigned N_SAMPLES = 1024;
+static constexpr unsigned N_ITERATIONS = 50;
+static constexpr unsigned N_BATCHES = 1024;
+static constexpr unsigned N_KERNEL_ITERATIONS = 5000;
+
+typedef std::chrono::steady_clock Clock;
+
+static double
+ElapsedNanoseconds(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+ * Scan a "reach fan" of lines around the map center, which is the
+ * same access pattern as the route planner and the glide range
+ * renderer.
+ */
+static long
+BenchmarkScanLine(const RasterMap &map, double radius)
+{
+  static TerrainHeight buffer[N_SAMPLES];
+
+  const GeoPoint center = map.GetMapCenter();
+
+  long sum = 0;
+  const auto start = Clock::now();
+
+  for (unsigned iteration = 0; iteration < N_ITERATIONS; ++iteration) {
+    for (unsigned i = 0; i < N_LINES; ++i) {
+      const GeoPoint end =
+        FindLatitudeLongitude(center, Angle::FullCircle() * i / N_LINES,
+                              radius);
+      map.ScanLine(center, end, buffer, N_SAMPLES, true);
+
+      /* prevent gcc from optimizing this loop away */
+      sum += buffer[N_SAMPLES / 2].GetValue();
+    }
+  }
+
+  const double elapsed = ElapsedNanoseconds(start);
+  printf("ScanLine: %.2f ns per sample\n",
+         elapsed / (N_ITERATIONS * N_LINES * N_SAMPLES));
+  return sum;
+}
+
+static void
+FillBatches(InterpolationBatch *batches, const RasterMap &map, double radius)
+{
+  /* feed real terrain values to the kernels */
+  static TerrainHeight heights[N_SAMPLES + 1];
+
+  const GeoPoint center = map.GetMapCenter();
+  map.ScanLine(center, FindLatitudeLongitude(center, Angle::Degrees(45),
+                                             radius),
+               heights, N_SAMPLES + 1, false);
+
+  unsigned x = 0, y = 0;
+  for (unsigned i = 0; i < N_BATCHES; ++i) {
+    for (unsigned j = 0; j < InterpolationBatch::N; ++j) {
+      x = (x * 1103515245 + 12345) & 0x7fffffff;
+      y = (y * 1103515245 + 54321) & 0x7fffffff;
+
+      batches[i].Set(j, heights + x % (N_SAMPLES - 1), 1, 2,
+                     x & 0xff, y & 0xff);
+    }
+  }
+}
+
+static bool
+BenchmarkKernels(const RasterMap &map, double radius)
+{
+  static InterpolationBatch batches[N_BATCHES];
+  static TerrainHeight portable[N_BATCHES * InterpolationBatch::N];
+  static TerrainHeight optimised[N_BATCHES * InterpolationBatch::N];
+
+  FillBatches(batches, map, radius);
+
+  auto start = Clock::now();
+  for (unsigned iteration = 0; iteration < N_KERNEL_ITERATIONS; ++iteration)
+    for (unsigned i = 0; i < N_BATCHES; ++i)
+      PortableInterpolate(batches[i], portable + i * InterpolationBatch::N,
+                          InterpolationBatch::N);
+  const double portable_elapsed = ElapsedNanoseconds(start);
+
+  start = Clock::now();
+  for (unsigned iteration = 0; iteration < N_KERNEL_ITERATIONS; ++iteration)
+    for (unsigned i = 0; i < N_BATCHES; ++i)
+      Interpolate(batches[i], optimised + i * InterpolationBatch::N,
+                  InterpolationBatch::N);
+  const double optimised_elapsed = ElapsedNanoseconds(start);
+
+  constexpr double n_samples =
+    double(N_KERNEL_ITERATIONS) * N_BATCHES * InterpolationBatch::N;
+  printf("portable kernel: %.3f ns per sample\n",
+         portable_elapsed / n_samples);
+  printf("optimised kernel: %.3f ns per sample (%.1fx)\n",
+         optimised_elapsed / n_samples,
+         portable_elapsed / optimised_elapsed);
+
+  for (unsigned i = 0; i < N_BATCHES * InterpolationBatch::N; ++i) {
+    if (portable[i].GetValue() != optimised[i].GetValue()) {
+      fprintf(stderr, "kernel mismatch at sample %u: %d != %d\n", i,
+              portable[i].GetValue(), optimised[i].GetValue());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto map_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+
+  NullOperationEnvironment operation;
+  if (!LoadTerrainOverview(archive.get(), map.GetTileCache(),
+                           operation)) {
+    fprintf(stderr, "failed to load map\n");
+    return EXIT_FAILURE;
+  }
+
+  map.UpdateProjection();
+
+  const double radius = 20000;
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), radius);
+  } while (map.IsDirty());
+
+  if (!BenchmarkKernels(map, radius))
+    return EXIT_FAILURE;
+
+  BenchmarkScanLine(map, radius);
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
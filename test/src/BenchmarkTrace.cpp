@@ -0,0 +1,133 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Feed the fixes of a flight through #Trace with the configurations
+ * used by TraceComputer, and report the time and a checksum of the
+ * resulting trace.  Run it with builds of different #Trace
+ * implementations to compare their speed; the checksums must match
+ * if they thin the trace in the same way.
+ */
+
+#include "OS/Args.hpp"
+#include "DebugReplay.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Vector.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_ITERATIONS = 20;
+
+typedef std::chrono::steady_clock Clock;
+
+struct TraceConfig {
+  const char *name;
+  unsigned no_thin_time, max_time, max_size;
+};
+
+/* the configurations used by TraceComputer */
+static constexpr TraceConfig configs[] = {
+  { "full", 120, Trace::null_time, 1024 },
+  { "contest", 0, Trace::null_time, 256 },
+  { "sprint", 0, 9000, 128 },
+};
+
+static double
+Feed(const std::vector<TracePoint> &fixes, const TraceConfig &config)
+{
+  unsigned sum = 0;
+  const auto start = Clock::now();
+
+  for (unsigned i = 0; i < N_ITERATIONS; ++i) {
+    Trace trace(config.no_thin_time, config.max_time, config.max_size);
+    for (const auto &fix : fixes)
+      trace.push_back(fix);
+
+    /* prevent gcc from optimizing this loop away */
+    sum += trace.size();
+  }
+
+  const double elapsed =
+    std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  return sum > 0 ? elapsed / N_ITERATIONS : 0;
+}
+
+/**
+ * Calculate a checksum of the times of the points which remain in
+ * the trace after feeding all fixes.
+ */
+static unsigned
+Checksum(const std::vector<TracePoint> &fixes, const TraceConfig &config,
+         unsigned &n_points)
+{
+  Trace trace(config.no_thin_time, config.max_time, config.max_size);
+  for (const auto &fix : fixes)
+    trace.push_back(fix);
+
+  TracePointVector v;
+  trace.GetPoints(v);
+  n_points = v.size();
+
+  unsigned checksum = 0;
+  for (const auto &i : v)
+    checksum = checksum * 31 + i.GetTime();
+  return checksum;
+}
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "[DRIVER] FILE");
+  DebugReplay *replay = CreateDebugReplay(args);
+  if (replay == NULL)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  std::vector<TracePoint> fixes;
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (basic.time_available && basic.location_available &&
+        basic.NavAltitudeAvailable())
+      fixes.push_back(TracePoint(basic));
+  }
+
+  delete replay;
+
+  printf("%u fixes\n", unsigned(fixes.size()));
+  if (fixes.empty())
+    return EXIT_FAILURE;
+
+  for (const auto &config : configs) {
+    unsigned n_points;
+    const unsigned checksum = Checksum(fixes, config, n_points);
+    const double us = Feed(fixes, config);
+    printf("%s: %.0f us, %u points, checksum %08x\n",
+           config.name, us, n_points, checksum);
+  }
+
+  return EXIT_SUCCESS;
+}
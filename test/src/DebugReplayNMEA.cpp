@@ -32,7 +32,7 @@ Copyright_License {
 static DeviceConfig config;
 static NullPort port;
 
-DebugReplayNMEA::DebugReplayNMEA(FileLineReaderA *_reader,
+DebugReplayNMEA::DebugReplayNMEA(NLineReader *_reader,
                                  const DeviceRegister *driver)
   :DebugReplayFile(_reader),
    device(driver->CreateOnPort != NULL
@@ -51,7 +51,7 @@ DebugReplayNMEA::Create(Path input_file, const tstring &driver_name)
     return nullptr;
   }
 
-  FileLineReaderA *reader = new FileLineReaderA(input_file);
+  NLineReader *reader = OpenFileLineReaderA(input_file).release();
   return new DebugReplayNMEA(reader, driver);
 }
 
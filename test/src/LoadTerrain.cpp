@@ -24,9 +24,13 @@ Copyright_License {
 /*
  * This program loads the terrain from a map file and exits.  Useful
  * for valgrind and profiling.
+ *
+ * With "--convert", it decodes all tiles and writes them to a
+ * RasterTileStore file next to the map file.
  */
 
 #include "Terrain/RasterTileCache.hpp"
+#include "Terrain/RasterTileStore.hpp"
 #include "Terrain/Loader.hpp"
 #include "OS/Args.hpp"
 #include "OS/ConvertPathName.hpp"
@@ -40,7 +44,15 @@ Copyright_License {
 
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "PATH");
+  Args args(argc, argv, "[--convert] PATH");
+
+  bool convert = false;
+  const char *a = args.PeekNext();
+  if (a != nullptr && strcmp(a, "--convert") == 0) {
+    args.Skip();
+    convert = true;
+  }
+
   const auto map_path = args.ExpectNextPath();
   args.ExpectEnd();
 
@@ -60,10 +72,29 @@ try {
          (double)bounds.GetEast().Degrees(),
          (double)bounds.GetSouth().Degrees());
 
+  const auto store_path = RasterTileStore::GetPath(map_path);
+
+  if (convert) {
+    RasterTileStoreWriter writer(store_path);
+    if (!writer.Create(map_path, rtc) ||
+        !ConvertTerrainTiles(archive.get(), rtc, writer, operation) ||
+        !writer.Commit()) {
+      fprintf(stderr, "Conversion failed\n");
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  RasterTileStore store(store_path);
+  const bool use_store = store.IsValid(map_path, rtc);
+  printf("tile store: %s\n", use_store ? "yes" : "no");
+
   SharedMutex mutex;
   do {
     UpdateTerrainTiles(archive.get(), rtc, mutex,
-                       rtc.GetWidth() / 2, rtc.GetHeight() / 2, 1000);
+                       rtc.GetWidth() / 2, rtc.GetHeight() / 2, 1000,
+                       use_store ? &store : nullptr);
   } while (rtc.IsDirty());
 
   return EXIT_SUCCESS;
@@ -28,6 +28,7 @@ Copyright_License {
 #include "OS/ConvertPathName.hpp"
 #include "OS/Args.hpp"
 #include "Operation/Operation.hpp"
+#include "Thread/WorkerPool.hpp"
 
 #include <stdint.h>
 #include <stdio.h>
@@ -163,6 +164,8 @@ int main(int argc, char **argv)
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
+  ScopeGlobalWorkerPool global_worker_pool;
+
   Waypoints waypoints;
   if (!LoadWaypoints(path, waypoints))
     return EXIT_FAILURE;
@@ -21,6 +21,13 @@ Copyright_License {
 }
 */
 
+/*
+ * This program parses an airspace file and exits.
+ *
+ * With "--bench", it prints how long parsing and building the search
+ * tree took.
+ */
+
 #include "Airspace/AirspaceParser.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "OS/Args.hpp"
@@ -28,15 +35,36 @@ Copyright_License {
 #include "Operation/Operation.hpp"
 #include "Util/PrintException.hxx"
 
+#include <chrono>
+
 #include <stdio.h>
+#include <string.h>
 #include <tchar.h>
 
+typedef std::chrono::steady_clock Clock;
+
+static double
+ToMilliseconds(Clock::duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "PATH");
+  Args args(argc, argv, "[--bench] PATH");
+
+  bool bench = false;
+  const char *a = args.PeekNext();
+  if (a != nullptr && strcmp(a, "--bench") == 0) {
+    args.Skip();
+    bench = true;
+  }
+
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
+  const auto start = Clock::now();
+
   FileLineReader reader(path, Charset::AUTO);
 
   Airspaces airspaces;
@@ -48,8 +76,19 @@ try {
     return 1;
   }
 
+  const auto parsed = Clock::now();
+
   airspaces.Optimise();
 
+  const auto optimised = Clock::now();
+
+  if (bench) {
+    printf("airspaces: %u\n", airspaces.GetSize());
+    printf("parse:     %8.2f ms\n", ToMilliseconds(parsed - start));
+    printf("optimise:  %8.2f ms\n", ToMilliseconds(optimised - parsed));
+    printf("total:     %8.2f ms\n", ToMilliseconds(optimised - start));
+  }
+
   printf("OK\n");
 
   return EXIT_SUCCESS;
@@ -47,6 +47,7 @@ Copyright_License {
 #include "IO/LineReader.hpp"
 #include "Operation/Operation.hpp"
 #include "Thread/Debug.hpp"
+#include "Thread/WorkerPool.hpp"
 
 void
 DeviceBlackboard::SetStartupLocation(const GeoPoint &loc, const double alt) {}
@@ -175,6 +176,8 @@ GenerateBlackboard(MapWindow &map, const ComputerSettings &settings_computer,
 void
 Main()
 {
+  ScopeGlobalWorkerPool global_worker_pool;
+
   ComputerSettings settings_computer;
   settings_computer.SetDefaults();
   Profile::Load(Profile::map, settings_computer);
@@ -26,11 +26,24 @@ Copyright_License {
 #include "Waypoint/Waypoints.hpp"
 #include "Engine/Waypoint/WaypointVisitor.hpp"
 #include "OS/Args.hpp"
+#include "OS/FileUtil.hpp"
 #include "Operation/Operation.hpp"
+#include "Thread/WorkerPool.hpp"
+
+#include <chrono>
 
 #include <stdio.h>
+#include <string.h>
 #include <tchar.h>
 
+typedef std::chrono::steady_clock Clock;
+
+static double
+ToSeconds(Clock::duration d)
+{
+  return std::chrono::duration<double>(d).count();
+}
+
 class DumpVisitor : public WaypointVisitor {
 public:
   void Visit(const WaypointPtr &p) override {
@@ -44,10 +57,22 @@ public:
 
 int main(int argc, char **argv)
 {
-  Args args(argc, argv, "PATH\n");
+  Args args(argc, argv, "[--bench] PATH\n");
+
+  bool bench = false;
+  const char *a = args.PeekNext();
+  if (a != nullptr && strcmp(a, "--bench") == 0) {
+    args.Skip();
+    bench = true;
+  }
+
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
+  ScopeGlobalWorkerPool global_worker_pool;
+
+  const auto start = Clock::now();
+
   Waypoints way_points;
 
   NullOperationEnvironment operation;
@@ -58,7 +83,22 @@ int main(int argc, char **argv)
     return EXIT_FAILURE;
   }
 
+  const auto parsed = Clock::now();
+
   way_points.Optimise();
+
+  const auto optimised = Clock::now();
+
+  if (bench) {
+    const double parse_s = ToSeconds(parsed - start);
+    const double mb = File::GetSize(path) / (1024. * 1024.);
+    printf("waypoints: %u\n", way_points.size());
+    printf("parse:     %8.2f ms (%.1f MB/s, %.0f waypoints/s)\n",
+           parse_s * 1000, mb / parse_s, way_points.size() / parse_s);
+    printf("optimise:  %8.2f ms\n", ToSeconds(optimised - parsed) * 1000);
+    return EXIT_SUCCESS;
+  }
+
   printf("Size %d\n", way_points.size());
 
   DumpVisitor visitor;
@@ -0,0 +1,113 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Blackboard/BlackboardGroups.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "TestUtil.hpp"
+
+using namespace BlackboardGroups;
+
+/* static, because they are too large for some stacks; this also
+   initialises them with zero bytes */
+static MoreData basic1, basic2;
+static DerivedInfo calculated1, calculated2;
+
+static void
+TestMoreData()
+{
+  ok1(Compare(basic1, basic2) == 0);
+
+  basic2.nav_altitude = 1234;
+  ok1(Compare(basic1, basic2) == ToMask(MORE_DATA_MISC));
+
+  basic2.flarm.status.rx = 3;
+  ok1(Compare(basic1, basic2) ==
+      (ToMask(MORE_DATA_MISC) | ToMask(MORE_DATA_FLARM)));
+
+  Copy(basic1, basic2, ToMask(MORE_DATA_FLARM));
+  ok1(basic1.flarm.status.rx == 3);
+  ok1(basic1.nav_altitude == 0);
+  ok1(Compare(basic1, basic2) == ToMask(MORE_DATA_MISC));
+
+  ok1(Update(basic1, basic2) == ToMask(MORE_DATA_MISC));
+  ok1(basic1.nav_altitude == 1234);
+  ok1(Update(basic1, basic2) == 0);
+}
+
+static void
+TestDerivedInfo()
+{
+  ok1(Compare(calculated1, calculated2) == 0);
+
+  calculated2.V_stf = 42;
+  calculated2.common_stats.landable_reachable = true;
+  ok1(Compare(calculated1, calculated2) ==
+      (ToMask(DERIVED_MISC) | ToMask(DERIVED_COMMON_STATS)));
+
+  calculated2.auto_zoom_distance = 5000;
+  calculated2.contest_stats.result[0].score = 100;
+  const Mask changed = Compare(calculated1, calculated2);
+  ok1(changed == (ToMask(DERIVED_MISC) | ToMask(DERIVED_COMMON_STATS) |
+                  ToMask(DERIVED_CONTEST_STATS)));
+
+  const uint32_t copied_before = GetCopiedBytes();
+  Copy(calculated1, calculated2, changed);
+  ok1(Compare(calculated1, calculated2) == 0);
+  ok1(calculated1.contest_stats.result[0].score == 100);
+
+  /* the large groups which were not modified have not been copied */
+  ok1(GetCopiedBytes() - copied_before <
+      sizeof(calculated1) - sizeof(calculated1.trace_history) -
+      sizeof(calculated1.thermal_encounter_band));
+}
+
+static void
+TestSerials()
+{
+  BlackboardSerials writer, reader;
+  writer.Increment(ALL);
+  ok1(reader.Compare(writer) == ALL);
+
+  reader = writer;
+  ok1(reader.Compare(writer) == 0);
+
+  writer.Increment(ToMask(DERIVED_TRACE_HISTORY));
+  ok1(reader.Compare(writer) == ToMask(DERIVED_TRACE_HISTORY));
+
+  reader = writer;
+  reader.Invalidate(ToMask(DERIVED_COMMON_STATS));
+  ok1(writer.Compare(reader) == ToMask(DERIVED_COMMON_STATS));
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(19);
+
+  TestMoreData();
+  TestDerivedInfo();
+  TestSerials();
+
+  return exit_status();
+}
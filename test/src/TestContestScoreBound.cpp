@@ -0,0 +1,147 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Check the score bound which the Dijkstra based contest solvers
+ * publish while a search is in progress (see
+ * ContestStatistics::score_bound).
+ */
+
+#include "Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "DebugReplayIGC.hpp"
+#include "OS/Path.hpp"
+#include "Util/Macros.hpp"
+#include "Util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+struct ContestSlot {
+  Contest contest;
+
+  /**
+   * The index of the Dijkstra result in #ContestStatistics.
+   */
+  unsigned index;
+};
+
+static constexpr ContestSlot contests[] = {
+  { Contest::OLC_CLASSIC, 0 },
+  { Contest::OLC_LEAGUE, 1 },
+  { Contest::DMST, 0 },
+  { Contest::XCONTEST, 0 },
+  { Contest::DHV_XC, 0 },
+  { Contest::SIS_AT, 0 },
+  { Contest::NET_COUPE, 0 },
+};
+
+static Trace full_trace(0, Trace::null_time, 512);
+static Trace triangle_trace(0, Trace::null_time, 1024);
+static Trace sprint_trace(0, 9000, 128);
+
+/**
+ * Load the flight into the traces, the same way as RunOLCAnalysis.
+ */
+static bool
+LoadFlight(Path path)
+{
+  DebugReplay *replay = DebugReplayIGC::Create(path);
+  if (replay == nullptr)
+    return false;
+
+  bool released = false;
+
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    if (!released && replay->Calculated().flight.release_time >= 0) {
+      released = true;
+
+      const double release_time = replay->Calculated().flight.release_time;
+      triangle_trace.EraseEarlierThan(release_time);
+      full_trace.EraseEarlierThan(release_time);
+      sprint_trace.EraseEarlierThan(release_time);
+    }
+
+    const TracePoint point(basic);
+    triangle_trace.push_back(point);
+    full_trace.push_back(point);
+    sprint_trace.push_back(point);
+  }
+
+  delete replay;
+  return !full_trace.empty();
+}
+
+static void
+TestContest(const ContestSlot &slot)
+{
+  ContestManager manager(slot.contest,
+                         full_trace, triangle_trace, sprint_trace);
+
+  /* collect the bounds published during the search, which is split
+     into many small steps */
+  double min_bound = -1;
+  unsigned n_steps = 0;
+  do {
+    manager.UpdateIdle();
+    ++n_steps;
+
+    const double bound = manager.GetStats().score_bound[slot.index];
+    if (bound > 0 && (min_bound < 0 || bound < min_bound))
+      min_bound = bound;
+  } while (manager.IsSolving() && n_steps < 1000000);
+
+  const ContestStatistics &stats = manager.GetStats();
+  const double score = stats.result[slot.index].score;
+
+  ok1(!manager.IsSolving());
+  ok1(score > 0);
+
+  /* there must have been a search in progress, and its bounds must
+     not be exceeded by the final score */
+  ok1(min_bound > 0);
+  if (!ok1(min_bound >= score))
+    diag("contest %u: bound %.3f score %.3f",
+         unsigned(slot.contest), min_bound, score);
+
+  /* no bound after the search has finished */
+  ok1(stats.score_bound[slot.index] == 0);
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(1 + 5 * ARRAY_SIZE(contests));
+
+  ok(LoadFlight(Path(_T("test/data/0asljd01.igc"))), "load flight", 0);
+
+  for (const auto &slot : contests)
+    TestContest(slot);
+
+  return exit_status();
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Device/Util/LineSplitter.hpp"
+#include "NMEA/Checksum.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <vector>
+
+#include <string.h>
+
+class TestSplitter : public PortLineSplitter {
+public:
+  std::vector<std::string> lines;
+  std::vector<bool> checksums;
+
+  void Feed(const char *data) {
+    DataReceived(data, strlen(data));
+  }
+
+  /**
+   * Feed the string in chunks of the given size.
+   */
+  void Feed(const char *data, size_t chunk_size) {
+    for (size_t length = strlen(data); length > 0;) {
+      const size_t n = std::min(length, chunk_size);
+      DataReceived(data, n);
+      data += n;
+      length -= n;
+    }
+  }
+
+  void Clear() {
+    lines.clear();
+    checksums.clear();
+  }
+
+protected:
+  void LineReceived(const char *line) override {
+    lines.emplace_back(line);
+    checksums.push_back(IsLineChecksumValid());
+
+    /* must be consistent with the classic implementation */
+    ok1(IsLineChecksumValid() == VerifyNMEAChecksum(line));
+  }
+};
+
+static constexpr char input[] =
+  "$GPRMC,082310,A,5103.5403,N,00741.5742,E,055.3,022.4,230610,000.0,E*7C\r\n"
+  "$PFLAU,3,1,2,1,0,-30,0,-300,1500*57\r\n"
+  "$PFLAU,3,1,2,1,0,-30,0,-300,1500*00\r\n"
+  "PRS 00017CBA\n"
+  "!w,1,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0*68\r\n"
+  "\r\n";
+
+static void
+TestChunks(size_t chunk_size)
+{
+  TestSplitter splitter;
+  splitter.Feed(input, chunk_size);
+
+  ok1(splitter.lines.size() == 6);
+  ok1(splitter.lines[0] ==
+      "$GPRMC,082310,A,5103.5403,N,00741.5742,E,055.3,022.4,230610,000.0,E*7C");
+  ok1(splitter.checksums[0]);
+  ok1(splitter.lines[1] == "$PFLAU,3,1,2,1,0,-30,0,-300,1500*57");
+  ok1(splitter.checksums[1]);
+  ok1(!splitter.checksums[2]);
+  ok1(splitter.lines[3] == "PRS 00017CBA");
+  ok1(!splitter.checksums[3]);
+  ok1(splitter.lines[5].empty());
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(4 * (6 + 9) + (2 + 3) + (1 + 2) + 3 * (1 + 2));
+
+  TestChunks(sizeof(input));
+  TestChunks(1);
+  TestChunks(7);
+  TestChunks(64);
+
+  TestSplitter splitter;
+
+  /* control characters are replaced, trailing whitespace is
+     removed */
+  splitter.Feed("$PFLAU,3,1\t,2*72 \t\r\n$PFLAU,3,1 ,2*72\n");
+  ok1(splitter.lines.size() == 2);
+  ok1(splitter.lines[0] == "$PFLAU,3,1 ,2*72");
+  ok1(splitter.lines[0] == splitter.lines[1]);
+  splitter.Clear();
+
+  /* skip to after the last NUL byte */
+  splitter.DataReceived("garbage\0$PFLAU,3,1 ,2*72\n", 25);
+  ok1(splitter.lines.size() == 1);
+  ok1(splitter.lines[0] == "$PFLAU,3,1 ,2*72");
+  splitter.Clear();
+
+  /* overlong lines are discarded entirely */
+  std::string overlong(1000, 'x');
+  overlong += "\n$PFLAU,3,1 ,2*72\n";
+  splitter.Feed(overlong.c_str());
+  ok1(splitter.lines.size() == 1);
+  ok1(splitter.lines[0] == "$PFLAU,3,1 ,2*72");
+  splitter.Clear();
+
+  splitter.Feed(overlong.c_str(), 7);
+  ok1(splitter.lines.size() == 1);
+  ok1(splitter.lines[0] == "$PFLAU,3,1 ,2*72");
+  splitter.Clear();
+
+  /* a line of the maximum length is still accepted */
+  std::string longest(255, 'x');
+  longest += '\n';
+  splitter.Feed(longest.c_str());
+  ok1(splitter.lines.size() == 1);
+  ok1(splitter.lines[0].length() == 255);
+
+  return exit_status();
+}
@@ -0,0 +1,134 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/NMEALogWriter.hpp"
+#include "IO/FileLineReader.hpp"
+#include "IO/FileReader.hxx"
+#include "IO/FileOutputStream.hxx"
+#include "OS/FileUtil.hpp"
+#include "OS/Path.hpp"
+#include "TestUtil.hpp"
+#include "Util/PrintException.hxx"
+
+#include <string>
+
+#include <stdio.h>
+#include <string.h>
+
+static constexpr unsigned N_LINES = 2000;
+
+static void
+FormatLine(char *buffer, size_t size, unsigned i)
+{
+  snprintf(buffer, size, "$PTEST,%u,%u*00", i, i * 7919);
+}
+
+static void
+Write(Path path, bool compress)
+{
+  File::Delete(path);
+
+  NMEALogWriter writer(path, compress);
+
+  /* this fits into the queue, so nothing must be dropped, even if
+     the writer thread is very slow */
+  bool success = true;
+  for (unsigned i = 0; i < N_LINES; ++i) {
+    char line[64];
+    FormatLine(line, sizeof(line), i);
+    success &= writer.Push(line);
+  }
+
+  ok1(success);
+
+  /* this can never fit */
+  const std::string huge(128 * 1024, 'x');
+  ok1(!writer.Push(huge.c_str()));
+  ok1(writer.GetDroppedLines() == 1);
+  ok1(writer.GetMaxQueueDepth() <= 64 * 1024);
+}
+
+static unsigned
+Read(Path path)
+{
+  auto reader = OpenFileLineReaderA(path);
+
+  unsigned n = 0;
+  const char *line;
+  while ((line = reader->ReadLine()) != nullptr) {
+    char expected[64];
+    FormatLine(expected, sizeof(expected), n);
+    if (strcmp(line, expected) != 0)
+      break;
+
+    ++n;
+  }
+
+  return n;
+}
+
+static void
+TestRoundTrip(Path path, bool compress)
+{
+  Write(path, compress);
+  ok1(Read(path) == N_LINES);
+}
+
+static void
+TestTruncated(Path path)
+{
+  const Path truncated(_T("output/test/truncated.nmea.gz"));
+  File::Delete(truncated);
+
+  /* a log file which was being written when the program crashed */
+  FileReader in(path);
+  const size_t size = in.GetSize();
+  ok1(size > 0);
+
+  std::string data(size / 2, 0);
+  ok1(in.Read(&data[0], data.size()) == data.size());
+
+  FileOutputStream out(truncated);
+  out.Write(data.data(), data.size());
+  out.Commit();
+
+  /* this must not throw, and the lines which were read must be
+     intact */
+  ok1(Read(truncated) < N_LINES);
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(2 * 5 + 3);
+
+  TestRoundTrip(Path(_T("output/test/test.nmea")), false);
+
+  const Path gz(_T("output/test/test.nmea.gz"));
+  TestRoundTrip(gz, true);
+  TestTruncated(gz);
+
+  return exit_status();
+} catch (const std::exception &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,91 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "NMEA/SentenceTable.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+static constexpr NMEASentenceTable empty_table{};
+
+static constexpr NMEASentenceTable small_table{
+  "$PFLAU",
+};
+
+static constexpr NMEASentenceTable table{
+  "GSA", "GLL", "RMC", "GGA", "HDM", "MWV",
+  "$PTAS1", "$PFLAE", "$PFLAV", "$PFLAA", "$PFLAU", "$PGRMZ",
+  "$LXWP0", "$LXWP1", "$LXWP2", "$LXWP3",
+  "$PLXV0", "$PLXVC", "$PLXVF", "$PLXVS",
+  "$PDSWC", "$PDAAV", "$PDVSC", "$PDVDV", "$PDVDS", "$PDVVT", "$PDVSD",
+  "$PDTSM", "$XCTRC", "$POV", "!w", "$PCAIB",
+};
+
+static_assert(table.size() == NMEASentenceTable::MAX_SENTENCES, "");
+
+static void
+TestGetTag()
+{
+  ok1(GetNMEASentenceTag("$PFLAU,3,1,2,1,0*4D").Equals("$PFLAU"));
+  ok1(GetNMEASentenceTag("$PFLAU*4D").Equals("$PFLAU"));
+  ok1(GetNMEASentenceTag("$PFLAU").Equals("$PFLAU"));
+  ok1(GetNMEASentenceTag(",foo").IsEmpty());
+  ok1(GetNMEASentenceTag("").IsEmpty());
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(15);
+
+  TestGetTag();
+
+  ok1(empty_table.size() == 0);
+  ok1(empty_table.Find("$GPRMC") == -1);
+
+  ok1(small_table.Find("$PFLAU") == 0);
+  ok1(small_table.Find("$PFLAA") == -1);
+
+  /* all tags are found at their position */
+  bool all_found = true;
+  const char *const tags[] = {
+    "GSA", "GLL", "RMC", "GGA", "HDM", "MWV",
+    "$PTAS1", "$PFLAE", "$PFLAV", "$PFLAA", "$PFLAU", "$PGRMZ",
+    "$LXWP0", "$LXWP1", "$LXWP2", "$LXWP3",
+    "$PLXV0", "$PLXVC", "$PLXVF", "$PLXVS",
+    "$PDSWC", "$PDAAV", "$PDVSC", "$PDVDV", "$PDVDS", "$PDVVT", "$PDVSD",
+    "$PDTSM", "$XCTRC", "$POV", "!w", "$PCAIB",
+  };
+  for (unsigned i = 0; i < ARRAY_SIZE(tags); ++i)
+    if (table.Find(tags[i]) != int(i))
+      all_found = false;
+  ok1(all_found);
+
+  /* prefixes, extensions and other sentences are not */
+  ok1(table.Find("$PFLA") == -1);
+  ok1(table.Find("$PFLAAX") == -1);
+  ok1(table.Find("$GPRMC") == -1);
+  ok1(table.Find("") == -1);
+
+  ok1(table.FindLine("$PFLAA,0,-1234,1234,220,2,DD8F12,180,,30,-1.4,1*21") ==
+      int(9));
+
+  return exit_status();
+}
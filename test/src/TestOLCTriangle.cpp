@@ -0,0 +1,156 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Regression test for the OLCTriangle solver: replay the test flights
+ * and compare the scores of an exhaustive triangle search with
+ * reference values.
+ */
+
+#include "Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "DebugReplayIGC.hpp"
+#include "OS/Path.hpp"
+#include "Util/Macros.hpp"
+#include "Util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+struct ContestReference {
+  Contest contest;
+
+  /**
+   * The index of the triangle result in #ContestStatistics.
+   */
+  unsigned index;
+
+  double score, distance;
+};
+
+struct FlightReference {
+  const TCHAR *path;
+
+  ContestReference contests[3];
+};
+
+/* reference values obtained from the solver before the range bounding
+   box table was introduced */
+static constexpr FlightReference flights[] = {
+  { _T("test/data/01lz1hq1.igc"), {
+      { Contest::OLC_FAI, 0, 11.766593, 39221.975036 },
+      { Contest::XCONTEST, 1, 50.600425, 36143.160553 },
+      { Contest::DHV_XC, 1, 72.286321, 36143.160553 },
+    } },
+  { _T("test/data/0asljd01.igc"), {
+      { Contest::OLC_FAI, 0, 69.066373, 230221.242936 },
+      { Contest::XCONTEST, 1, 317.800669, 227000.477949 },
+      { Contest::DHV_XC, 1, 454.000956, 227000.477949 },
+    } },
+  { _T("test/data/9crx3101.igc"), {
+      { Contest::OLC_FAI, 0, 3.676028, 12253.426136 },
+      { Contest::XCONTEST, 1, 0, 0 },
+      { Contest::DHV_XC, 1, 0, 0 },
+    } },
+  { _T("test/data/apf-bug554.igc"), {
+      { Contest::OLC_FAI, 0, 32.437271, 108124.237107 },
+      { Contest::XCONTEST, 1, 150.619254, 107585.181131 },
+      { Contest::DHV_XC, 1, 215.170362, 107585.181131 },
+    } },
+};
+
+/**
+ * Load the flight into the traces, the same way as RunOLCAnalysis.
+ */
+static bool
+LoadFlight(Path path, Trace &full_trace, Trace &triangle_trace,
+           Trace &sprint_trace)
+{
+  DebugReplay *replay = DebugReplayIGC::Create(path);
+  if (replay == nullptr)
+    return false;
+
+  bool released = false;
+
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    if (!released && replay->Calculated().flight.release_time >= 0) {
+      released = true;
+
+      const double release_time = replay->Calculated().flight.release_time;
+      triangle_trace.EraseEarlierThan(release_time);
+      full_trace.EraseEarlierThan(release_time);
+      sprint_trace.EraseEarlierThan(release_time);
+    }
+
+    const TracePoint point(basic);
+    triangle_trace.push_back(point);
+    full_trace.push_back(point);
+    sprint_trace.push_back(point);
+  }
+
+  delete replay;
+  return !triangle_trace.empty();
+}
+
+static void
+TestFlight(const FlightReference &flight)
+{
+  Trace full_trace(0, Trace::null_time, 512);
+  Trace triangle_trace(0, Trace::null_time, 1024);
+  Trace sprint_trace(0, 9000, 128);
+
+  const Path path(flight.path);
+  ok(LoadFlight(path, full_trace, triangle_trace, sprint_trace),
+     "load flight", 0);
+
+  for (const auto &reference : flight.contests) {
+    ContestManager manager(reference.contest,
+                           full_trace, triangle_trace, sprint_trace);
+    manager.SolveExhaustive();
+
+    const ContestResult &result =
+      manager.GetStats().GetResult(reference.index);
+    const bool score_ok = ok1(equals(result.score, reference.score));
+    const bool distance_ok = ok1(equals(result.distance, reference.distance));
+    if (!score_ok || !distance_ok)
+      diag("%s contest %u: score %.6f distance %.6f",
+           path.ToUTF8().c_str(), unsigned(reference.contest),
+           result.score, result.distance);
+  }
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(ARRAY_SIZE(flights) * (1 + 2 * ARRAY_SIZE(flights[0].contests)));
+
+  for (const auto &flight : flights)
+    TestFlight(flight);
+
+  return exit_status();
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
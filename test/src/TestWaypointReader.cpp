@@ -31,6 +31,7 @@
 #include "Util/StringAPI.hxx"
 #include "Util/ExtractParameters.hpp"
 #include "Operation/Operation.hpp"
+#include "Thread/WorkerPool.hpp"
 
 #include <vector>
 
@@ -535,6 +536,8 @@ CreateOriginalWaypoints()
 
 int main(int argc, char **argv)
 {
+  ScopeGlobalWorkerPool global_worker_pool;
+
   wp_vector org_wp = CreateOriginalWaypoints();
 
   plan_tests(360);
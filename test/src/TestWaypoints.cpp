@@ -23,9 +23,11 @@
 #include "Waypoint/WaypointVisitor.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "Geo/GeoVector.hpp"
+#include "Util/StringAPI.hxx"
 #include "test_debug.hpp"
 
 #include <functional>
+#include <algorithm>
 
 #include <stdio.h>
 #include <tchar.h>
@@ -154,6 +156,58 @@ TestNamePrefixVisitor(const Waypoints &waypoints)
   TestNamePrefixVisitor(waypoints, _T("Field"), 51 - 8);
 }
 
+static unsigned
+CountNameMatches(const Waypoints &waypoints, const TCHAR *query,
+                 WaypointNameIndex::Search &search)
+{
+  WaypointPredicateCounter::Predicate predicate =
+    [](const Waypoint &){ return true; };
+  WaypointPredicateCounter counter(predicate);
+  waypoints.VisitNameMatches(query, counter, search);
+  return counter.GetCounter();
+}
+
+static void
+TestNameMatches(const Waypoints &waypoints)
+{
+  WaypointNameIndex::Search search;
+  ok1(CountNameMatches(waypoints, _T("field"), search) == 22 + 51 - 8);
+  ok1(CountNameMatches(waypoints, _T("Foo"), search) == 0);
+
+  /* refine the previous query, then go back to a shorter one */
+  ok1(CountNameMatches(waypoints, _T("field"), search) == 22 + 51 - 8);
+  ok1(CountNameMatches(waypoints, _T("field 4"), search) == 5);
+  ok1(CountNameMatches(waypoints, _T("ield"), search) == 22 + 51 - 8);
+
+  /* exact match first, then the names beginning with the query */
+  const auto result = waypoints.FindNameMatches(_T("Field #4"), 3, search);
+  ok1(result.size() == 3 &&
+      result[0]->name == _T("Field #4") &&
+      result[1]->name == _T("Field #40") &&
+      result[2]->name == _T("Field #46"));
+
+  TCHAR buffer[64];
+  const TCHAR *suggest = waypoints.SuggestNameCharacters(_T("field4"), buffer,
+                                                         64, search);
+  ok1(suggest != nullptr && StringIsEqual(suggest, _T("0369")));
+  ok1(waypoints.SuggestNameCharacters(_T("Foo"), buffer, 64,
+                                      search) == nullptr);
+
+  /* accents are folded */
+  Waypoints accented;
+  Waypoint waypoint(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.05)));
+  waypoint.name = _T("Z\u00fcrich-Kloten");
+  accented.Append(std::move(waypoint));
+  accented.Optimise();
+
+  ok1(accented.FindNameMatches(_T("zur"), 10, search).size() == 1);
+  ok1(accented.FindNameMatches(_T("z\u00dcRICH KLOTEN"), 10, search).size() == 1);
+
+  /* a search must not be reused with another index */
+  ok1(CountNameMatches(waypoints, _T("field"), search) == 22 + 51 - 8);
+  ok1(accented.FindNameMatches(_T("field 4"), 10, search).empty());
+}
+
 class CloserThan
 {
   double distance;
@@ -234,6 +288,33 @@ TestGetNearest(const Waypoints &waypoints, const GeoPoint &center)
   ok1(waypoint->original_id == 6);
 }
 
+/**
+ * Compare GetNearest() with a linear search at many locations.
+ */
+static void
+TestGetNearestMany(const Waypoints &waypoints, const GeoPoint &center)
+{
+  unsigned n_failed = 0;
+
+  for (unsigned i = 0; i < 200; ++i) {
+    const GeoPoint location =
+      GeoVector(i * 797 % 160000, Angle::Degrees(i * 37)).EndPoint(center);
+
+    double min_distance = 1e9;
+    for (const auto &wp : waypoints)
+      min_distance = std::min(min_distance, location.Distance(wp->location));
+
+    const auto nearest = waypoints.GetNearest(location, 200000);
+    /* allow a small error because GetNearest() works on the flat
+       projection */
+    if (nearest == nullptr ||
+        location.Distance(nearest->location) > min_distance * 1.01 + 10)
+      ++n_failed;
+  }
+
+  ok1(n_failed == 0);
+}
+
 static void
 TestIterator(const Waypoints &waypoints)
 {
@@ -256,7 +337,16 @@ TestCopy(Waypoints& waypoints)
   unsigned size_old = waypoints.size();
   Waypoint wp_copy = *wp;
   wp_copy.id = waypoints.size() + 1;
-  waypoints.Append(std::move(wp_copy));
+  const auto appended = waypoints.Append(std::move(wp_copy));
+
+  /* must be found before Optimise() has rebuilt the index */
+  const auto found = waypoints.GetNearestIf(appended->location, 100,
+                                            [](const Waypoint &w){
+                                              return w.id == 152;
+                                            });
+  if (found != appended)
+    return false;
+
   waypoints.Optimise();
   unsigned size_new = waypoints.size();
   return (size_new == size_old + 1);
@@ -301,7 +391,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(65);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -315,8 +405,10 @@ main(int argc, char** argv)
 
   TestLookups(waypoints, center);
   TestNamePrefixVisitor(waypoints);
+  TestNameMatches(waypoints);
   TestRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
+  TestGetNearestMany(waypoints, center);
   TestIterator(waypoints);
 
   ok(TestCopy(waypoints), "waypoint copy", 0);
@@ -236,8 +236,18 @@ run_flight(TestFlightComponents components, TaskManager &task_manager,
   if (verbose)
     PrintDistanceCounts();
 
-  if (airspace_warnings)
+  if (airspace_warnings) {
+    if (verbose > 1) {
+      const auto &statistics = airspace_warnings->GetStatistics();
+      if (statistics.n_updates > 0)
+        printf("# airspace warning updates %u, mean %u us, max %u us\n",
+               statistics.n_updates,
+               unsigned(statistics.total_duration / statistics.n_updates),
+               statistics.max_duration);
+    }
+
     delete airspace_warnings;
+  }
 
   result.result = true;
   return result;
@@ -22,6 +22,9 @@
 
 #include "harness_flight.hpp"
 #include "test_debug.hpp"
+#include "Airspace/AbstractAirspace.hpp"
+
+#include <set>
 
 static bool
 test_airspace(const unsigned n_airspaces)
@@ -34,6 +37,85 @@ test_airspace(const unsigned n_airspaces)
   return fine;
 }
 
+/**
+ * Does the airspace overlap the altitude band?  Altitudes referenced
+ * to the terrain are unknown here and don't limit the airspace.
+ */
+static bool
+OverlapsBand(const AbstractAirspace &as, double min_altitude,
+             double max_altitude)
+{
+  const AirspaceAltitude &base = as.GetBase(), &top = as.GetTop();
+  return (base.reference == AltitudeReference::AGL ||
+          base.altitude <= max_altitude) &&
+    (top.reference == AltitudeReference::AGL ||
+     top.altitude >= min_altitude);
+}
+
+template<typename Range>
+static std::set<const AbstractAirspace *>
+Collect(const Range &range)
+{
+  std::set<const AbstractAirspace *> result;
+  for (const auto &i : range)
+    result.insert(&i.GetAirspace());
+  return result;
+}
+
+template<typename Range>
+static std::set<const AbstractAirspace *>
+CollectInBand(const Range &range, double min_altitude, double max_altitude)
+{
+  std::set<const AbstractAirspace *> result;
+  for (const auto &i : range)
+    if (OverlapsBand(i.GetAirspace(), min_altitude, max_altitude))
+      result.insert(&i.GetAirspace());
+  return result;
+}
+
+/**
+ * Check that the altitude band queries return the same airspaces as
+ * the two-dimensional queries filtered by altitude.
+ */
+static bool
+test_altitude_band(const Airspaces &airspaces)
+{
+  static constexpr struct {
+    double min, max;
+  } bands[] = {
+    { -500, -100 },
+    { 0, 500 },
+    { 1000, 1000 },
+    { 1500, 2500 },
+    { 3000, 7000 },
+    { 8000, 10000 },
+  };
+
+  const GeoPoint center(Angle::Zero(), Angle::Zero());
+
+  for (const auto &band : bands) {
+    for (unsigned j = 0; j < 20; ++j) {
+      const GeoPoint a(center.longitude + Angle::Degrees((rand() % 1200 - 600) / 1000.),
+                       center.latitude + Angle::Degrees((rand() % 1200 - 600) / 1000.));
+      const GeoPoint b(center.longitude + Angle::Degrees((rand() % 1200 - 600) / 1000.),
+                       center.latitude + Angle::Degrees((rand() % 1200 - 600) / 1000.));
+      const double range = 1000 + rand() % 40000;
+
+      if (Collect(airspaces.QueryWithinRange(a, range, band.min, band.max)) !=
+          CollectInBand(airspaces.QueryWithinRange(a, range),
+                        band.min, band.max))
+        return false;
+
+      if (Collect(airspaces.QueryIntersecting(a, b, band.min, band.max)) !=
+          CollectInBand(airspaces.QueryIntersecting(a, b),
+                        band.min, band.max))
+        return false;
+    }
+  }
+
+  return true;
+}
+
 int main(int argc, char** argv) 
 {
   // default arguments
@@ -43,11 +125,33 @@ int main(int argc, char** argv)
     return 0;
   }
 
-  plan_tests(3);
+  plan_tests(4);
 
   ok(test_airspace(20),"airspace 20",0);
   ok(test_airspace(100),"airspace 100",0);
   
+  {
+    Airspaces airspaces;
+    setup_airspaces(airspaces, GeoPoint(Angle::Zero(), Angle::Zero()), 100);
+
+    /* add a few airspaces referenced to the terrain */
+    for (unsigned i = 0; i < 4; ++i) {
+      AirspaceAltitude base, top;
+      base.reference = AltitudeReference::AGL;
+      base.altitude_above_terrain = 300;
+      top.altitude = 1000 + 1000 * i;
+      top.reference = AltitudeReference::MSL;
+      AbstractAirspace *as =
+        new AirspaceCircle(GeoPoint(Angle::Degrees(0.1 * i), Angle::Zero()),
+                           5000);
+      as->SetProperties(_T("agl"), AirspaceClass::CLASSD, base, top);
+      airspaces.Add(as);
+    }
+    airspaces.Optimise();
+
+    ok(test_altitude_band(airspaces),"airspace altitude band",0);
+  }
+
   Airspaces airspaces;
   setup_airspaces(airspaces, GeoPoint(Angle::Zero(), Angle::Zero()), 20);
   ok(test_airspace_extra(airspaces),"airspace extra",0);
@@ -34,12 +34,23 @@
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Geo/SpeedVector.hpp"
 #include "Operation/Operation.hpp"
+#include "Util/ConstBuffer.hxx"
 #include "OS/FileUtil.hpp"
 
 #include <zzip/zzip.h>
 
 #include <string.h>
 
+class CountFansVisitor final : public FlatTriangleFanVisitor {
+public:
+  unsigned n_fans = 0, n_vertices = 0;
+
+  void VisitFan(FlatGeoPoint origin, ConstBuffer<FlatGeoPoint> fan) override {
+    ++n_fans;
+    n_vertices += fan.size;
+  }
+};
+
 static void
 test_reach(const RasterMap &map, double mwind, double mc, double height_min_working)
 {
@@ -61,8 +72,16 @@ test_reach(const RasterMap &map, double mwind, double mc, double height_min_work
   int horigin = map.GetHeight(origin).GetValueOr0() + 1000;
   AGeoPoint aorigin(origin, horigin);
 
+  const Serial old_serial = route.GetReachSerial();
   retval = route.SolveReachTerrain(aorigin, config, INT_MAX);
   ok(retval, "reach terrain", 0);
+  ok(route.GetReachSerial() != old_serial, "reach serial", 0);
+
+  {
+    CountFansVisitor visitor;
+    route.AcceptTerrainReachRoot(visitor);
+    ok(visitor.n_fans == 1 && visitor.n_vertices >= 3, "reach root", 0);
+  }
   PrintHelper::print_reach_terrain_tree(route);
 
   retval = route.SolveReachWorking(aorigin, config, INT_MAX);
@@ -135,7 +154,7 @@ int main(int argc, char** argv) {
   } while (map.IsDirty());
   zzip_dir_close(dir);
 
-  plan_tests(8);
+  plan_tests(16);
   test_reach(map, 0, 0.1, 0);
   test_reach(map, 0, 0.1, 750);
   test_reach(map, 0, 0.1, 500);